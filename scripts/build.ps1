@@ -63,6 +63,12 @@ This script provides helpers for building msquic.
 .PARAMETER UseIoUring
     Enables io_uring support (Linux-only).
 
+.PARAMETER UseXdp
+    Enables the AF_XDP raw datapath (Linux-only).
+
+.PARAMETER UseSimDatapath
+    Replaces the socket datapath with the in-process simulated network (Linux-only).
+
 .PARAMETER Generator
     Specifies a specific cmake generator (Only supported on unix)
 
@@ -183,6 +189,12 @@ param (
     [Parameter(Mandatory = $false)]
     [switch]$UseIoUring = $false,
 
+    [Parameter(Mandatory = $false)]
+    [switch]$UseXdp = $false,
+
+    [Parameter(Mandatory = $false)]
+    [switch]$UseSimDatapath = $false,
+
     [Parameter(Mandatory = $false)]
     [string]$Generator = "",
 
@@ -487,6 +499,12 @@ function CMake-Generate {
     if ($UseIoUring) {
         $Arguments += " -DQUIC_LINUX_IOURING_ENABLED=on"
     }
+    if ($UseXdp) {
+        $Arguments += " -DQUIC_LINUX_XDP_ENABLED=on"
+    }
+    if ($UseSimDatapath) {
+        $Arguments += " -DQUIC_LINUX_SIM_DATAPATH=on"
+    }
     if ($Platform -eq "uwp") {
         $Arguments += " -DCMAKE_SYSTEM_NAME=WindowsStore -DCMAKE_SYSTEM_VERSION=10.0 -DQUIC_UWP_BUILD=on"
     }
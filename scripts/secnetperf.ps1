@@ -214,6 +214,10 @@ if ($isWindows) {
 
 # Test all supported scenarios.
 $allScenarios = @("upload", "download", "hps", "rps", "rps-multi", "latency")
+if (!$isWindows) {
+    # Same as "latency", but with kernel busy polling (epoll) or SQPOLL (io_uring).
+    $allScenarios += "latency-busypoll"
+}
 
 $hasFailures = $false
 
@@ -280,6 +284,18 @@ foreach ($scenario in $allScenarios) {
     }
 }
 
+# Summarize the effect of busy polling on the latency percentiles.
+foreach ($transport in @("quic", "tcp")) {
+    $base = $json["latency-$transport"]
+    $busy = $json["latency-busypoll-$transport"]
+    if ($null -eq $base -or $null -eq $busy -or $base.Length -lt 9 -or $busy.Length -lt 9) { continue }
+    # Each run reports 0th, 50th, 90th, 99th, 99.9th, 99.99th, 99.999th, 99.9999th and RPS.
+    foreach ($p in @(@("P50", 1), @("P99", 3), @("P99.9", 4))) {
+        $delta = [int]$busy[$p[1]] - [int]$base[$p[1]]
+        Write-Host "latency-busypoll-$transport $($p[0]): $($busy[$p[1]]) us (delta $delta us)"
+    }
+}
+
 Write-Host "Tests complete!"
 
 } catch {
@@ -326,6 +326,9 @@ QuicAckTrackerAckFrameEncode(
         QuicSendUpdateAckState(&Builder->Connection->Send);
     }
 
+    QuicPerfCounterIncrement(
+        Builder->Connection->Partition, QUIC_PERF_COUNTER_ACK_FRAMES_SENT);
+
     Tracker->AlreadyWrittenAckFrame = TRUE;
     Tracker->LargestPacketNumberAcknowledged =
         Builder->Metadata->Frames[Builder->Metadata->FrameCount].ACK.LargestAckedPacketNumber =
@@ -7,6 +7,12 @@ Abstract:
 
     Bottleneck Bandwidth and RTT (BBR) congestion control.
 
+    The BBRv3 variant additionally bounds bytes in flight based on loss and
+    ECN (InflightHi/InflightLo), and replaces the fixed PROBE_BW gain cycle
+    with the DOWN/CRUISE/REFILL/UP cycle, which probes for bandwidth less
+    often and backs off when probing causes excessive loss. This makes it
+    fairer to loss based flows and keeps loss low on shallow buffers.
+
 --*/
 
 #include "precomp.h"
@@ -36,6 +42,21 @@ typedef enum RECOVERY_STATE {
 
 } RECOVERY_STATE;
 
+//
+// The phases of the BBRv3 PROBE_BW cycle.
+//
+typedef enum BBR3_PROBE_BW_PHASE {
+
+    BBR3_PROBE_BW_DOWN,     // Drain the queue built while probing
+
+    BBR3_PROBE_BW_CRUISE,   // Cruise with headroom below InflightHi
+
+    BBR3_PROBE_BW_REFILL,   // Refill the pipe for a round before probing
+
+    BBR3_PROBE_BW_UP        // Probe for bandwidth and raise InflightHi
+
+} BBR3_PROBE_BW_PHASE;
+
 //
 // Bandwidth is measured as (bytes / BW_UNIT) per second
 //
@@ -109,6 +130,74 @@ const uint32_t kBbrMaxBandwidthFilterLen = 10;
 
 const uint32_t kBbrMaxAckHeightFilterLen = 10;
 
+//
+// BBRv3 gains
+//
+const uint32_t kBbr3StartupPacingGain = GAIN_UNIT * 277 / 100; // 4*ln(2)
+
+const uint32_t kBbr3StartupCwndGain = GAIN_UNIT * 2;
+
+const uint32_t kBbr3DrainGain = GAIN_UNIT * 35 / 100;
+
+const uint32_t kBbr3ProbeDownGain = GAIN_UNIT * 90 / 100;
+
+const uint32_t kBbr3ProbeUpGain = GAIN_UNIT * 5 / 4;
+
+const uint32_t kBbr3ProbeUpCwndGain = GAIN_UNIT * 9 / 4;
+
+//
+// BBRv3 keeps half of the estimated BDP in flight during PROBE_RTT
+//
+const uint32_t kBbr3ProbeRttCwndGain = GAIN_UNIT / 2;
+
+//
+// Multiplicative decrease applied to the inflight bounds
+//
+const uint32_t kBbr3Beta = GAIN_UNIT * 7 / 10;
+
+//
+// The fraction of lost bytes and CE marked packets tolerated while probing
+//
+const uint32_t kBbr3LossThresh = GAIN_UNIT * 2 / 100;
+
+//
+// The number of loss events in a round needed (besides kBbr3LossThresh) to
+// end STARTUP, so a single burst overflowing the queue doesn't end it early
+//
+const uint32_t kBbr3StartupFullLossCount = 6;
+
+const uint32_t kBbr3EcnThresh = GAIN_UNIT / 2;
+
+//
+// InflightLo is reduced by EcnAlpha * kBbr3EcnFactor in rounds with CE marks
+//
+const uint32_t kBbr3EcnFactor = GAIN_UNIT / 3;
+
+//
+// Gain of the moving average of the CE marked fraction, as a shift (1/16)
+//
+const uint32_t kBbr3EcnAlphaGainShift = 4;
+
+//
+// Headroom left below InflightHi while cruising, for other flows to grow into
+//
+const uint32_t kBbr3InflightHeadroom = GAIN_UNIT * 15 / 100;
+
+//
+// BBRv3 enters ProbeRtt twice as often, with a smaller window reduction
+//
+const uint32_t kBbr3ProbeRttIntervalInUs = S_TO_US(5);
+
+//
+// Bandwidth probing starts randomly 2 to 3 seconds into the PROBE_BW cycle,
+// or after at most kBbr3MaxProbeRounds round trips
+//
+const uint32_t kBbr3ProbeWaitBaseInUs = S_TO_US(2);
+
+const uint32_t kBbr3ProbeWaitRandInUs = S_TO_US(1);
+
+const uint32_t kBbr3MaxProbeRounds = 63;
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 BbrBandwidthFilterOnPacketAcked(
@@ -225,6 +314,13 @@ BbrCongestionControlGetCongestionWindow(
     uint32_t MinCongestionWindow = kMinCwndInMss * DatagramPayloadLength;
 
     if (Bbr->BbrState == BBR_STATE_PROBE_RTT) {
+        if (Bbr->IsVersion3 && Bbr->MinRttTimestampValid) {
+            uint64_t ProbeRttCwnd =
+                BbrCongestionControlGetBandwidth(Cc) * Bbr->MinRtt / kMicroSecsInSec / BW_UNIT *
+                kBbr3ProbeRttCwndGain / GAIN_UNIT;
+            ProbeRttCwnd = CXPLAT_MIN(ProbeRttCwnd, Bbr->CongestionWindow);
+            return (uint32_t)CXPLAT_MAX(ProbeRttCwnd, MinCongestionWindow);
+        }
         return MinCongestionWindow;
     }
 
@@ -235,6 +331,42 @@ BbrCongestionControlGetCongestionWindow(
     return Bbr->CongestionWindow;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwDown(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
+
+    Bbr->BbrState = BBR_STATE_PROBE_BW;
+    Bbr->ProbeBwPhase = BBR3_PROBE_BW_DOWN;
+    Bbr->PacingGain = kBbr3ProbeDownGain;
+    Bbr->CwndGain = kCwndGain;
+    Bbr->InflightTooHigh = FALSE;
+
+    //
+    // Schedule the next bandwidth probe at a randomized point in time, so
+    // that competing BBR flows don't probe in lockstep.
+    //
+    uint32_t RandomValue = 0;
+    CxPlatRandom(sizeof(uint32_t), &RandomValue);
+    Bbr->ProbeWaitTime = kBbr3ProbeWaitBaseInUs + RandomValue % kBbr3ProbeWaitRandInUs;
+    Bbr->RoundsSinceProbe = 0;
+    Bbr->CycleStart = TimeNow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwCruise(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    Cc->Bbr.ProbeBwPhase = BBR3_PROBE_BW_CRUISE;
+    Cc->Bbr.PacingGain = GAIN_UNIT;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 BbrCongestionControlTransitToProbeBw(
@@ -244,6 +376,11 @@ BbrCongestionControlTransitToProbeBw(
 {
     QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
 
+    if (Bbr->IsVersion3) {
+        Bbr3CongestionControlStartProbeBwDown(Cc, CongestionEventTime);
+        return;
+    }
+
     Bbr->BbrState = BBR_STATE_PROBE_BW;
     Bbr->CwndGain = kCwndGain;
 
@@ -263,8 +400,8 @@ BbrCongestionControlTransitToStartup(
     )
 {
     Cc->Bbr.BbrState = BBR_STATE_STARTUP;
-    Cc->Bbr.PacingGain = kHighGain;
-    Cc->Bbr.CwndGain = kHighGain;
+    Cc->Bbr.PacingGain = Cc->Bbr.IsVersion3 ? kBbr3StartupPacingGain : kHighGain;
+    Cc->Bbr.CwndGain = Cc->Bbr.IsVersion3 ? kBbr3StartupCwndGain : kHighGain;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -297,6 +434,17 @@ QuicConnLogBbr(
         Bbr->MinRtt,
         BbrCongestionControlGetBandwidth(Cc) / BW_UNIT,
         BbrCongestionControlIsAppLimited(Cc));
+
+    if (Bbr->IsVersion3) {
+        QuicTraceLogConnVerbose(
+            Bbr3State,
+            Connection,
+            "BBRv3: Phase=%u InflightHi=%u InflightLo=%u EcnAlpha=%u",
+            Bbr->ProbeBwPhase,
+            Bbr->InflightHi,
+            Bbr->InflightLo,
+            Bbr->EcnAlpha);
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -543,8 +691,19 @@ BbrCongestionControlHandleAckInProbeRtt(
             Bbr->MinRttTimestamp = AckTime;
             Bbr->MinRttTimestampValid = TRUE;
 
+            if (Bbr->IsVersion3) {
+                Bbr->InflightLo = UINT32_MAX;
+            }
+
             if (Bbr->BtlbwFound) {
                 BbrCongestionControlTransitToProbeBw(Cc, AckTime);
+                if (Bbr->IsVersion3) {
+                    //
+                    // Bytes in flight is below the BDP after ProbeRtt, so
+                    // skip draining, but keep the probe schedule from DOWN.
+                    //
+                    Bbr3CongestionControlStartProbeBwCruise(Cc);
+                }
             } else {
                 BbrCongestionControlTransitToStartup(Cc);
             }
@@ -613,6 +772,377 @@ BbrCongestionControlGetTargetCwnd(
     return (uint32_t)TargetCwnd;
 }
 
+//
+// InflightHi less some headroom, for other flows to grow into while cruising.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetInflightWithHeadroom(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    if (Bbr->InflightHi == UINT32_MAX) {
+        return UINT32_MAX;
+    }
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    uint32_t Headroom = CXPLAT_MAX(
+        (uint32_t)((uint64_t)Bbr->InflightHi * kBbr3InflightHeadroom / GAIN_UNIT),
+        (uint32_t)DatagramPayloadLength);
+    uint32_t InflightWithHeadroom =
+        Bbr->InflightHi > Headroom ? Bbr->InflightHi - Headroom : 0;
+
+    return CXPLAT_MAX(InflightWithHeadroom, kMinCwndInMss * DatagramPayloadLength);
+}
+
+//
+// Limits the congestion window to the inflight bounds of the current phase.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlBoundCongestionWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    uint32_t Cap = UINT32_MAX;
+    if (Bbr->BbrState == BBR_STATE_PROBE_BW) {
+        Cap = Bbr->ProbeBwPhase == BBR3_PROBE_BW_CRUISE ?
+            Bbr3CongestionControlGetInflightWithHeadroom(Cc) : Bbr->InflightHi;
+    }
+    Cap = CXPLAT_MIN(Cap, Bbr->InflightLo);
+    Cap = CXPLAT_MAX(Cap, kMinCwndInMss * DatagramPayloadLength);
+
+    Bbr->CongestionWindow = CXPLAT_MIN(Bbr->CongestionWindow, Cap);
+}
+
+//
+// Doubles the growth of InflightHi each round while probing UP.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlRaiseInflightHiSlope(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    uint32_t GrowthThisRound = 1u << Bbr->ProbeUpRounds; // datagrams
+    Bbr->ProbeUpRounds = CXPLAT_MIN(Bbr->ProbeUpRounds + 1, 30);
+    Bbr->ProbeUpCount = CXPLAT_MAX(
+        Bbr->CongestionWindow / GrowthThisRound, (uint32_t)DatagramPayloadLength);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlProbeInflightHiUpward(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t PrevInflightBytes,
+    _In_ uint32_t BytesAcked
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    //
+    // Only raise the bound if it is what limits us.
+    //
+    if (Bbr->InflightHi == UINT32_MAX ||
+        Bbr->CongestionWindow < Bbr->InflightHi ||
+        PrevInflightBytes + DatagramPayloadLength < Bbr->CongestionWindow) {
+        return;
+    }
+
+    Bbr->ProbeUpAcked += BytesAcked;
+    if (Bbr->ProbeUpAcked >= Bbr->ProbeUpCount) {
+        uint32_t Delta = Bbr->ProbeUpAcked / Bbr->ProbeUpCount;
+        Bbr->ProbeUpAcked -= Delta * Bbr->ProbeUpCount;
+        uint64_t InflightHi = (uint64_t)Bbr->InflightHi + (uint64_t)Delta * DatagramPayloadLength;
+        Bbr->InflightHi = (uint32_t)CXPLAT_MIN(InflightHi, UINT32_MAX - 1);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwRefill(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    Bbr->InflightLo = UINT32_MAX;
+    Bbr->ProbeUpRounds = 0;
+    Bbr->ProbeUpAcked = 0;
+    Bbr->ProbeBwPhase = BBR3_PROBE_BW_REFILL;
+    Bbr->PacingGain = GAIN_UNIT;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwUp(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    Bbr->ProbeBwPhase = BBR3_PROBE_BW_UP;
+    Bbr->PacingGain = kBbr3ProbeUpGain;
+    Bbr->CwndGain = kBbr3ProbeUpCwndGain;
+    Bbr->CycleStart = TimeNow;
+    Bbr3CongestionControlRaiseInflightHiSlope(Cc);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlIsTimeToProbe(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    if (CxPlatTimeDiff64(Bbr->CycleStart, TimeNow) >= Bbr->ProbeWaitTime) {
+        return TRUE;
+    }
+
+    //
+    // Probe at least as often as Reno would grow the window by the same
+    // amount (one datagram per round).
+    //
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    uint32_t RenoRounds = CXPLAT_MIN(
+        BbrCongestionControlGetTargetCwnd(Cc, GAIN_UNIT) / DatagramPayloadLength,
+        kBbr3MaxProbeRounds);
+    return Bbr->RoundsSinceProbe >= RenoRounds;
+}
+
+//
+// Sets InflightHi after loss or ECN showed that probing went too far.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlHandleInflightTooHigh(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t Inflight
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    if (!BbrCongestionControlIsAppLimited(Cc)) {
+        uint32_t Floor = (uint32_t)
+            ((uint64_t)BbrCongestionControlGetTargetCwnd(Cc, GAIN_UNIT) * kBbr3Beta / GAIN_UNIT);
+        Bbr->InflightHi = CXPLAT_MAX(Inflight, Floor);
+        Bbr->InflightHi = CXPLAT_MAX(Bbr->InflightHi, kMinCwndInMss * DatagramPayloadLength);
+    }
+    Bbr->InflightTooHigh = TRUE;
+}
+
+//
+// Reduces InflightLo after a round with loss or ECN marks while not probing.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlAdaptLowerBounds(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    if (Bbr->InflightLo == UINT32_MAX) {
+        Bbr->InflightLo = Bbr->CongestionWindow;
+    }
+
+    uint32_t InflightLo = Bbr->InflightLo;
+    if (Bbr->EcnInRound) {
+        InflightLo -= (uint32_t)
+            ((uint64_t)Bbr->InflightLo * Bbr->EcnAlpha / GAIN_UNIT * kBbr3EcnFactor / GAIN_UNIT);
+    }
+    if (Bbr->LossInRound) {
+        InflightLo = CXPLAT_MIN(InflightLo, CXPLAT_MAX(
+            Bbr->InflightLatest,
+            (uint32_t)((uint64_t)Bbr->InflightLo * kBbr3Beta / GAIN_UNIT)));
+    }
+
+    Bbr->InflightLo = CXPLAT_MAX(InflightLo, kMinCwndInMss * DatagramPayloadLength);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlIsProbingBandwidth(
+    _In_ const QUIC_CONGESTION_CONTROL_BBR* Bbr
+    )
+{
+    return
+        Bbr->BbrState == BBR_STATE_STARTUP ||
+        (Bbr->BbrState == BBR_STATE_PROBE_BW &&
+         (Bbr->ProbeBwPhase == BBR3_PROBE_BW_REFILL ||
+          Bbr->ProbeBwPhase == BBR3_PROBE_BW_UP));
+}
+
+//
+// Processes the congestion signals of the round trip that just ended.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlOnRoundEnd(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    uint32_t CeRatio = 0;
+    if (Bbr->PacketsAckedInRound != 0) {
+        CeRatio =
+            CXPLAT_MIN(Bbr->CePacketsInRound, Bbr->PacketsAckedInRound) * GAIN_UNIT /
+            Bbr->PacketsAckedInRound;
+        Bbr->EcnAlpha =
+            ((Bbr->EcnAlpha << kBbr3EcnAlphaGainShift) - Bbr->EcnAlpha + CeRatio) >>
+                kBbr3EcnAlphaGainShift;
+    }
+    Bbr->InflightLatest = Bbr->BytesAckedInRound;
+
+    if (Bbr3CongestionControlIsProbingBandwidth(Bbr)) {
+        if (Bbr->EcnInRound && CeRatio > kBbr3EcnThresh && !Bbr->InflightTooHigh) {
+            Bbr3CongestionControlHandleInflightTooHigh(Cc, Bbr->InflightLatest);
+        }
+    } else if (Bbr->LossInRound || Bbr->EcnInRound) {
+        Bbr3CongestionControlAdaptLowerBounds(Cc);
+    }
+
+    Bbr->LossInRound = FALSE;
+    Bbr->EcnInRound = FALSE;
+    Bbr->BytesAckedInRound = 0;
+    Bbr->BytesLostInRound = 0;
+    Bbr->LossEventsInRound = 0;
+    Bbr->PacketsAckedInRound = 0;
+    Bbr->CePacketsInRound = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlUpdateProbeBwPhase(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent,
+    _In_ BOOLEAN NewRoundTrip,
+    _In_ uint32_t PrevInflightBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    if (NewRoundTrip) {
+        Bbr->RoundsSinceProbe++;
+    }
+
+    switch (Bbr->ProbeBwPhase) {
+    case BBR3_PROBE_BW_DOWN:
+        if (Bbr3CongestionControlIsTimeToProbe(Cc, AckEvent->TimeNow)) {
+            Bbr3CongestionControlStartProbeBwRefill(Cc);
+        } else if (
+            Bbr->BytesInFlight <= Bbr3CongestionControlGetInflightWithHeadroom(Cc) &&
+            Bbr->BytesInFlight <= BbrCongestionControlGetTargetCwnd(Cc, GAIN_UNIT)) {
+            Bbr3CongestionControlStartProbeBwCruise(Cc);
+        }
+        break;
+
+    case BBR3_PROBE_BW_CRUISE:
+        if (Bbr3CongestionControlIsTimeToProbe(Cc, AckEvent->TimeNow)) {
+            Bbr3CongestionControlStartProbeBwRefill(Cc);
+        }
+        break;
+
+    case BBR3_PROBE_BW_REFILL:
+        if (NewRoundTrip) {
+            Bbr3CongestionControlStartProbeBwUp(Cc, AckEvent->TimeNow);
+        }
+        break;
+
+    case BBR3_PROBE_BW_UP:
+        if (CxPlatTimeDiff64(Bbr->CycleStart, AckEvent->TimeNow) > Bbr->MinRtt &&
+            PrevInflightBytes >= BbrCongestionControlGetTargetCwnd(Cc, kBbr3ProbeUpGain)) {
+            Bbr3CongestionControlStartProbeBwDown(Cc, AckEvent->TimeNow);
+        } else {
+            if (NewRoundTrip) {
+                Bbr3CongestionControlRaiseInflightHiSlope(Cc);
+            }
+            Bbr3CongestionControlProbeInflightHiUpward(
+                Cc, PrevInflightBytes, AckEvent->NumRetransmittableBytes);
+        }
+        break;
+    }
+}
+
+//
+// The BBRv3 part of ACK processing: per round congestion signal accounting,
+// reacting to too much loss/ECN while probing and the PROBE_BW cycle.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent,
+    _In_ BOOLEAN NewRoundTrip,
+    _In_ uint32_t PrevInflightBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    Bbr->BytesAckedInRound += AckEvent->NumRetransmittableBytes;
+    for (const QUIC_SENT_PACKET_METADATA* Packet = AckEvent->AckedPackets;
+        Packet != NULL;
+        Packet = Packet->Next) {
+        Bbr->PacketsAckedInRound++;
+    }
+
+    if (NewRoundTrip) {
+        Bbr3CongestionControlOnRoundEnd(Cc);
+    }
+
+    if (Bbr->InflightTooHigh) {
+        if (Bbr->BbrState == BBR_STATE_STARTUP) {
+            Bbr->BtlbwFound = TRUE;
+            Bbr->InflightTooHigh = FALSE;
+        } else if (
+            Bbr->BbrState == BBR_STATE_PROBE_BW &&
+            Bbr3CongestionControlIsProbingBandwidth(Bbr)) {
+            Bbr3CongestionControlStartProbeBwDown(Cc, AckEvent->TimeNow);
+        } else {
+            Bbr->InflightTooHigh = FALSE;
+        }
+    }
+
+    if (Bbr->BbrState == BBR_STATE_PROBE_BW) {
+        Bbr3CongestionControlUpdateProbeBwPhase(Cc, AckEvent, NewRoundTrip, PrevInflightBytes);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint32_t
 BbrCongestionControlGetSendAllowance(
@@ -695,8 +1225,8 @@ BbrCongestionControlTransitToDrain(
     )
 {
     Cc->Bbr.BbrState = BBR_STATE_DRAIN;
-    Cc->Bbr.PacingGain = kDrainGain;
-    Cc->Bbr.CwndGain = kHighGain;
+    Cc->Bbr.PacingGain = Cc->Bbr.IsVersion3 ? kBbr3DrainGain : kDrainGain;
+    Cc->Bbr.CwndGain = Cc->Bbr.IsVersion3 ? kBbr3StartupCwndGain : kHighGain;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -764,6 +1294,10 @@ BbrCongestionControlUpdateCongestionWindow(
 
     Bbr->CongestionWindow = CXPLAT_MAX(CongestionWindow, MinCongestionWindow);
 
+    if (Bbr->IsVersion3) {
+        Bbr3CongestionControlBoundCongestionWindow(Cc);
+    }
+
     QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
 }
 
@@ -795,8 +1329,10 @@ BbrCongestionControlOnDataAcknowledged(
     Bbr->BytesInFlight -= AckEvent->NumRetransmittableBytes;
 
     if (AckEvent->MinRttValid) {
+        const uint64_t MinRttExpiration =
+            Bbr->IsVersion3 ? kBbr3ProbeRttIntervalInUs : kBbrMinRttExpirationInMicroSecs;
         Bbr->RttSampleExpired = Bbr->MinRttTimestampValid ?
-           CxPlatTimeAtOrBefore64(Bbr->MinRttTimestamp + kBbrMinRttExpirationInMicroSecs, AckEvent->TimeNow) :
+           CxPlatTimeAtOrBefore64(Bbr->MinRttTimestamp + MinRttExpiration, AckEvent->TimeNow) :
            FALSE;
         if (Bbr->RttSampleExpired || Bbr->MinRtt > AckEvent->MinRtt) {
             Bbr->MinRtt = AckEvent->MinRtt;
@@ -836,7 +1372,9 @@ BbrCongestionControlOnDataAcknowledged(
 
     BbrCongestionControlUpdateAckAggregation(Cc, AckEvent);
 
-    if (Bbr->BbrState == BBR_STATE_PROBE_BW) {
+    if (Bbr->IsVersion3) {
+        Bbr3CongestionControlOnDataAcknowledged(Cc, AckEvent, NewRoundTrip, PrevInflightBytes);
+    } else if (Bbr->BbrState == BBR_STATE_PROBE_BW) {
         BOOLEAN ShouldAdvancePacingGainCycle = CxPlatTimeDiff64(AckEvent->TimeNow, Bbr->CycleStart) > Bbr->MinRtt;
 
         if (Bbr->PacingGain > GAIN_UNIT && !AckEvent->HasLoss &&
@@ -930,6 +1468,25 @@ BbrCongestionControlOnDataLost(
     Bbr->EndOfRecoveryValid = TRUE;
     Bbr->EndOfRecovery = LossEvent->LargestSentPacketNumber;
 
+    if (Bbr->IsVersion3) {
+        Bbr->LossInRound = TRUE;
+        Bbr->BytesLostInRound += LossEvent->NumRetransmittableBytes;
+        Bbr->LossEventsInRound++;
+
+        //
+        // While probing, more than kBbr3LossThresh of the bytes in flight
+        // lost means we went above what the path (buffer) tolerates.
+        //
+        if (Bbr3CongestionControlIsProbingBandwidth(Bbr) &&
+            !Bbr->InflightTooHigh &&
+            (Bbr->BbrState != BBR_STATE_STARTUP ||
+                Bbr->LossEventsInRound >= kBbr3StartupFullLossCount) &&
+            (uint64_t)Bbr->BytesLostInRound * GAIN_UNIT >
+                (uint64_t)Bbr->BytesInFlight * kBbr3LossThresh) {
+            Bbr3CongestionControlHandleInflightTooHigh(Cc, Bbr->BytesInFlight);
+        }
+    }
+
     CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= LossEvent->NumRetransmittableBytes);
     Bbr->BytesInFlight -= LossEvent->NumRetransmittableBytes;
 
@@ -965,6 +1522,35 @@ BbrCongestionControlOnDataLost(
     QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    CXPLAT_DBG_ASSERT(Bbr->IsVersion3);
+
+    //
+    // BBRv3 reacts to the fraction of CE marked packets once per round (see
+    // Bbr3CongestionControlOnRoundEnd), so only count them here.
+    //
+    Bbr->CePacketsInRound += EcnEvent->NumCePackets;
+    if (!Bbr->EcnInRound) {
+        Bbr->EcnInRound = TRUE;
+        QuicTraceEvent(
+            ConnCongestionV2,
+            "[conn][%p] Congestion event: IsEcn=%hu",
+            Connection,
+            TRUE);
+        Connection->Stats.Send.CongestionCount++;
+        Connection->Stats.Send.EcnCongestionCount++;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 BbrCongestionControlOnSpuriousCongestionEvent(
@@ -975,6 +1561,47 @@ BbrCongestionControlOnSpuriousCongestionEvent(
     return FALSE;
 }
 
+//
+// Careful resume only touches the window while still in STARTUP. Once the
+// bottleneck bandwidth is found the model derived window takes over again.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlSetCarefulResumeWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow,
+    _In_ BOOLEAN IsRetreat
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = BbrCongestionControlCanSend(Cc);
+
+    if (!IsRetreat) {
+        if (Bbr->BbrState != BBR_STATE_STARTUP || Bbr->BtlbwFound ||
+            CongestionWindow <= Bbr->CongestionWindow) {
+            return FALSE;
+        }
+        Bbr->CongestionWindow = CongestionWindow;
+        Bbr->BytesInFlightMax =
+            CXPLAT_MAX(Bbr->BytesInFlightMax, CongestionWindow / 2);
+
+    } else {
+        const uint32_t MinCongestionWindow =
+            kMinCwndInMss * QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+        CongestionWindow = CXPLAT_MAX(CongestionWindow, MinCongestionWindow);
+        if (CongestionWindow >= Bbr->CongestionWindow) {
+            return FALSE;
+        }
+        Bbr->CongestionWindow = CongestionWindow;
+        Bbr->RecoveryWindow = CXPLAT_MIN(Bbr->RecoveryWindow, CongestionWindow);
+    }
+
+    BOOLEAN Result = BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogBbr(Connection);
+    return Result;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 BbrCongestionControlSetAppLimited(
@@ -994,6 +1621,36 @@ BbrCongestionControlSetAppLimited(
     Bbr->BandwidthFilter.AppLimitedExitTarget = LargestSentPacketNumber;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlResetState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    BbrCongestionControlTransitToStartup(Cc);
+
+    Bbr->LossInRound = FALSE;
+    Bbr->EcnInRound = FALSE;
+    Bbr->InflightTooHigh = FALSE;
+    Bbr->InflightHi = UINT32_MAX;
+    Bbr->InflightLo = UINT32_MAX;
+    Bbr->InflightLatest = 0;
+    Bbr->BytesAckedInRound = 0;
+    Bbr->BytesLostInRound = 0;
+    Bbr->LossEventsInRound = 0;
+    Bbr->PacketsAckedInRound = 0;
+    Bbr->CePacketsInRound = 0;
+    Bbr->EcnAlpha = GAIN_UNIT;
+    Bbr->ProbeBwPhase = BBR3_PROBE_BW_DOWN;
+    Bbr->ProbeWaitTime = 0;
+    Bbr->RoundsSinceProbe = 0;
+    Bbr->ProbeUpRounds = 0;
+    Bbr->ProbeUpCount = UINT32_MAX;
+    Bbr->ProbeUpAcked = 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 BbrCongestionControlReset(
@@ -1059,6 +1716,10 @@ BbrCongestionControlReset(
     Bbr->BandwidthFilter.AppLimited = FALSE;
     Bbr->BandwidthFilter.AppLimitedExitTarget = 0;
 
+    if (Bbr->IsVersion3) {
+        Bbr3CongestionControlResetState(Cc);
+    }
+
     BbrCongestionControlLogOutFlowStatus(Cc);
     QuicConnLogBbr(Connection);
 }
@@ -1082,7 +1743,8 @@ static const QUIC_CONGESTION_CONTROL QuicCongestionControlBbr = {
     .QuicCongestionControlGetBytesInFlightMax = BbrCongestionControlGetBytesInFlightMax,
     .QuicCongestionControlIsAppLimited = BbrCongestionControlIsAppLimited,
     .QuicCongestionControlSetAppLimited = BbrCongestionControlSetAppLimited,
-    .QuicCongestionControlGetNetworkStatistics = BbrCongestionControlGetNetworkStatistics
+    .QuicCongestionControlGetNetworkStatistics = BbrCongestionControlGetNetworkStatistics,
+    .QuicCongestionControlSetCarefulResumeWindow = BbrCongestionControlSetCarefulResumeWindow
 };
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -1159,3 +1821,20 @@ BbrCongestionControlInitialize(
     QuicConnLogOutFlowStats(Connection);
     QuicConnLogBbr(Connection);
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    BbrCongestionControlInitialize(Cc, Settings);
+
+    Cc->Name = "BBRv3";
+    Cc->QuicCongestionControlOnEcn = BbrCongestionControlOnEcn;
+    Cc->Bbr.IsVersion3 = TRUE;
+    Bbr3CongestionControlResetState(Cc);
+
+    QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
+}
@@ -83,6 +83,24 @@ typedef struct QUIC_CONGESTION_CONTROL_BBR {
     //
     BOOLEAN MinRttTimestampValid: 1;
 
+    //
+    // If TRUE, run the BBRv3 variant of the state machine: loss and ECN aware
+    // inflight bounds and the DOWN/CRUISE/REFILL/UP bandwidth probing cycle.
+    //
+    BOOLEAN IsVersion3 : 1;
+
+    //
+    // BBRv3: TRUE if loss or ECN-CE marks were seen in the current round trip.
+    //
+    BOOLEAN LossInRound : 1;
+    BOOLEAN EcnInRound : 1;
+
+    //
+    // BBRv3: TRUE if loss or ECN while probing showed that bytes in flight
+    // went above what the path tolerates. Handled on the next ACK.
+    //
+    BOOLEAN InflightTooHigh : 1;
+
     //
     // The size of the initial congestion window in packets
     //
@@ -217,6 +235,62 @@ typedef struct QUIC_CONGESTION_CONTROL_BBR {
     //
     BBR_BANDWIDTH_FILTER BandwidthFilter;
 
+    //
+    // BBRv3: the long term upper bound on bytes in flight, learned from loss
+    // or ECN beyond what the path tolerates while probing. UINT32_MAX if no
+    // bound has been learned.
+    //
+    uint32_t InflightHi; // bytes
+
+    //
+    // BBRv3: the short term lower bound on bytes in flight, reduced on loss or
+    // ECN in a round and cleared when probing for bandwidth again. UINT32_MAX
+    // if not set.
+    //
+    uint32_t InflightLo; // bytes
+
+    //
+    // BBRv3: the bytes delivered in the last round trip.
+    //
+    uint32_t InflightLatest; // bytes
+
+    //
+    // BBRv3: per round trip delivery, loss and ECN accounting.
+    //
+    uint32_t BytesAckedInRound;
+    uint32_t BytesLostInRound;
+    uint32_t LossEventsInRound;
+    uint32_t PacketsAckedInRound;
+    uint32_t CePacketsInRound;
+
+    //
+    // BBRv3: moving average of the fraction of CE marked packets per round,
+    // scaled by GAIN_UNIT.
+    //
+    uint32_t EcnAlpha;
+
+    //
+    // BBRv3: current phase of the PROBE_BW cycle.
+    //
+    uint32_t ProbeBwPhase;
+
+    //
+    // BBRv3: time to wait after the start of a PROBE_BW cycle before probing
+    // for bandwidth, and the number of round trips since then. Probing also
+    // starts after the number of rounds Reno would take to probe the same
+    // window, so BBR doesn't probe less often than Reno/CUBIC flows.
+    //
+    uint64_t ProbeWaitTime; // microseconds
+    uint32_t RoundsSinceProbe;
+
+    //
+    // BBRv3: InflightHi growth while probing UP. The growth per round doubles
+    // each round, like slow start.
+    //
+    uint32_t ProbeUpRounds;
+    uint32_t ProbeUpCount; // bytes acked per datagram of growth
+    uint32_t ProbeUpAcked; // bytes
+
 } QUIC_CONGESTION_CONTROL_BBR;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -226,6 +300,13 @@ BbrCongestionControlInitialize(
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
+
 #if defined(__cplusplus)
 }
 #endif
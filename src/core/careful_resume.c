@@ -0,0 +1,643 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Careful resume (draft-ietf-tsvwg-careful-resume).
+
+    When a connection finishes, the RTT and the congestion window it achieved
+    are remembered in the registration, per remote IP address (and server name
+    for clients). A later connection to the same destination looks that state
+    up and goes through these phases:
+
+    Reconnaissance - The connection starts with the normal initial window. Once
+        the handshake completes, the current RTT is compared to the saved one.
+        If it is not within [Saved / 2, Saved * 10] the path is assumed to have
+        changed and the saved state is dropped.
+
+    Unvalidated - The congestion window jumps to half the saved window. Every
+        packet sent until the first of them is acknowledged is "unvalidated".
+
+    Validating - Waits for the last unvalidated packet to be acknowledged,
+        after which the congestion controller just carries on (Normal).
+
+    Safe Retreat - Any loss of an unvalidated packet means the saved window was
+        too much for the path. The window drops to half of what is known to
+        have been delivered and slow start is exited.
+
+    Servers can also carry the state in resumption tickets, which is used when
+    the cache doesn't have an entry for the client.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "careful_resume.c.clog.h"
+#endif
+
+//
+// Hashes the IP address (not the port) and server name of a destination.
+//
+static
+QUIC_NO_SANITIZE("unsigned-integer-overflow")
+uint32_t
+QuicCarefulResumeHash(
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_opt_(ServerNameLength)
+        const char* ServerName
+    )
+{
+    QUIC_ADDR Address = *RemoteAddress;
+    QuicAddrSetPort(&Address, 0);
+    uint32_t Hash = QuicAddrHash(&Address);
+    if (ServerNameLength != 0) {
+        Hash = ((Hash << 5) - Hash) + CxPlatHashSimple(ServerNameLength, (const uint8_t*)ServerName);
+    }
+    return Hash;
+}
+
+static
+BOOLEAN
+QuicCarefulResumeCacheEntryMatches(
+    _In_ const QUIC_CAREFUL_RESUME_CACHE_ENTRY* Entry,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_opt_(ServerNameLength)
+        const char* ServerName
+    )
+{
+    return
+        QuicAddrGetFamily(&Entry->RemoteAddress) == QuicAddrGetFamily(RemoteAddress) &&
+        QuicAddrCompareIp(&Entry->RemoteAddress, RemoteAddress) &&
+        Entry->ServerNameLength == ServerNameLength &&
+        (ServerNameLength == 0 ||
+         memcmp(Entry->ServerName, ServerName, ServerNameLength) == 0);
+}
+
+//
+// Returns the entry for the destination, if any. Must be called with the
+// cache lock held.
+//
+static
+QUIC_CAREFUL_RESUME_CACHE_ENTRY*
+QuicCarefulResumeCacheFind(
+    _In_ QUIC_CAREFUL_RESUME_CACHE* Cache,
+    _In_ uint32_t Hash,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_opt_(ServerNameLength)
+        const char* ServerName
+    )
+{
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* TableEntry =
+        CxPlatHashtableLookup(&Cache->Table, Hash, &Context);
+    while (TableEntry != NULL) {
+        QUIC_CAREFUL_RESUME_CACHE_ENTRY* Entry =
+            CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_CAREFUL_RESUME_CACHE_ENTRY, TableEntry);
+        if (QuicCarefulResumeCacheEntryMatches(
+                Entry, RemoteAddress, ServerNameLength, ServerName)) {
+            return Entry;
+        }
+        TableEntry = CxPlatHashtableLookupNext(&Cache->Table, &Context);
+    }
+    return NULL;
+}
+
+static
+void
+QuicCarefulResumeCacheRemove(
+    _In_ QUIC_CAREFUL_RESUME_CACHE* Cache,
+    _In_ QUIC_CAREFUL_RESUME_CACHE_ENTRY* Entry
+    )
+{
+    CxPlatHashtableRemove(&Cache->Table, &Entry->TableEntry, NULL);
+    CxPlatListEntryRemove(&Entry->LruLink);
+    Cache->EntryCount--;
+    CXPLAT_FREE(Entry, QUIC_POOL_CAREFUL_RESUME_ENTRY);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicCarefulResumeCacheInitialize(
+    _Out_ QUIC_CAREFUL_RESUME_CACHE* Cache
+    )
+{
+    //
+    // The cache may be uninitialized even if this fails.
+    //
+    CxPlatZeroMemory(Cache, sizeof(*Cache));
+    CxPlatDispatchLockInitialize(&Cache->Lock);
+    CxPlatListInitializeHead(&Cache->LruList);
+    return CxPlatHashtableInitializeEx(&Cache->Table, CXPLAT_HASH_MIN_SIZE);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCarefulResumeCacheUninitialize(
+    _Inout_ QUIC_CAREFUL_RESUME_CACHE* Cache
+    )
+{
+    while (!CxPlatListIsEmpty(&Cache->LruList)) {
+        QuicCarefulResumeCacheRemove(
+            Cache,
+            CXPLAT_CONTAINING_RECORD(
+                Cache->LruList.Flink, QUIC_CAREFUL_RESUME_CACHE_ENTRY, LruLink));
+    }
+    CXPLAT_DBG_ASSERT(Cache->EntryCount == 0);
+    CxPlatHashtableUninitialize(&Cache->Table);
+    CxPlatDispatchLockUninitialize(&Cache->Lock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicCarefulResumeCacheLookup(
+    _In_ QUIC_CAREFUL_RESUME_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_opt_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint64_t TimeNow,
+    _Out_ QUIC_CAREFUL_RESUME_SAVED_STATE* State
+    )
+{
+    BOOLEAN Found = FALSE;
+    const uint32_t Hash =
+        QuicCarefulResumeHash(RemoteAddress, ServerNameLength, ServerName);
+
+    CxPlatDispatchLockAcquire(&Cache->Lock);
+    QUIC_CAREFUL_RESUME_CACHE_ENTRY* Entry =
+        QuicCarefulResumeCacheFind(
+            Cache, Hash, RemoteAddress, ServerNameLength, ServerName);
+    if (Entry != NULL) {
+        if (CxPlatTimeDiff64(Entry->TimeSaved, TimeNow) >= QUIC_CAREFUL_RESUME_LIFETIME_US) {
+            QuicCarefulResumeCacheRemove(Cache, Entry);
+        } else {
+            *State = Entry->State;
+            Found = TRUE;
+        }
+    }
+    CxPlatDispatchLockRelease(&Cache->Lock);
+
+    return Found;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCarefulResumeCacheSave(
+    _In_ QUIC_CAREFUL_RESUME_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_opt_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint64_t TimeNow,
+    _In_ const QUIC_CAREFUL_RESUME_SAVED_STATE* State
+    )
+{
+    const uint32_t Hash =
+        QuicCarefulResumeHash(RemoteAddress, ServerNameLength, ServerName);
+
+    CxPlatDispatchLockAcquire(&Cache->Lock);
+
+    QUIC_CAREFUL_RESUME_CACHE_ENTRY* Entry =
+        QuicCarefulResumeCacheFind(
+            Cache, Hash, RemoteAddress, ServerNameLength, ServerName);
+    if (Entry != NULL) {
+        //
+        // Refresh the existing entry and move it to the most recent end.
+        //
+        CxPlatListEntryRemove(&Entry->LruLink);
+
+    } else {
+        if (Cache->EntryCount >= QUIC_CAREFUL_RESUME_MAX_CACHE_ENTRIES) {
+            QuicCarefulResumeCacheRemove(
+                Cache,
+                CXPLAT_CONTAINING_RECORD(
+                    Cache->LruList.Flink, QUIC_CAREFUL_RESUME_CACHE_ENTRY, LruLink));
+        }
+
+        Entry =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_CAREFUL_RESUME_CACHE_ENTRY) + ServerNameLength,
+                QUIC_POOL_CAREFUL_RESUME_ENTRY);
+        if (Entry == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "careful resume cache entry",
+                sizeof(QUIC_CAREFUL_RESUME_CACHE_ENTRY) + ServerNameLength);
+            goto Exit;
+        }
+
+        Entry->RemoteAddress = *RemoteAddress;
+        QuicAddrSetPort(&Entry->RemoteAddress, 0);
+        Entry->ServerNameLength = ServerNameLength;
+        if (ServerNameLength != 0) {
+            CxPlatCopyMemory(Entry->ServerName, ServerName, ServerNameLength);
+        }
+        CxPlatHashtableInsert(&Cache->Table, &Entry->TableEntry, Hash, NULL);
+        Cache->EntryCount++;
+    }
+
+    Entry->TimeSaved = TimeNow;
+    Entry->State = *State;
+    CxPlatListInsertTail(&Cache->LruList, &Entry->LruLink);
+
+Exit:
+
+    CxPlatDispatchLockRelease(&Cache->Lock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCarefulResumeInitialize(
+    _Out_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_opt_ const QUIC_CAREFUL_RESUME_SAVED_STATE* Saved
+    )
+{
+    CxPlatZeroMemory(CarefulResume, sizeof(*CarefulResume));
+    if (Saved != NULL && Saved->CongestionWindow != 0 && Saved->SmoothedRtt != 0) {
+        CarefulResume->Saved = *Saved;
+        CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_RECONNAISSANCE;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicCarefulResumeOnRttConfirmed(
+    _Inout_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_ uint64_t SmoothedRtt,
+    _In_ uint32_t CongestionWindow,
+    _In_ uint64_t NextPacketNumber
+    )
+{
+    CXPLAT_DBG_ASSERT(CarefulResume->Phase == QUIC_CAREFUL_RESUME_PHASE_RECONNAISSANCE);
+
+    const uint64_t SavedRtt = CarefulResume->Saved.SmoothedRtt;
+    const uint32_t JumpWindow = CarefulResume->Saved.CongestionWindow / 2;
+    if (SmoothedRtt < SavedRtt / QUIC_CAREFUL_RESUME_RTT_LOW_DIVISOR ||
+        SmoothedRtt > SavedRtt * QUIC_CAREFUL_RESUME_RTT_HIGH_MULTIPLIER ||
+        JumpWindow <= CongestionWindow) {
+        CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_NORMAL;
+        return 0;
+    }
+
+    CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED;
+    CarefulResume->FirstUnvalidatedPacketNumber = NextPacketNumber;
+    CarefulResume->LastUnvalidatedPacketNumber = NextPacketNumber;
+    CarefulResume->PipeSize = CongestionWindow;
+    return JumpWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCarefulResumeOnAck(
+    _Inout_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_ uint64_t LargestAck,
+    _In_ uint32_t AckedBytes,
+    _In_ uint64_t NextPacketNumber
+    )
+{
+    switch (CarefulResume->Phase) {
+    case QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED:
+        CarefulResume->PipeSize += AckedBytes;
+        if (LargestAck >= CarefulResume->FirstUnvalidatedPacketNumber) {
+            //
+            // A round trip has passed since the jump. Everything sent until
+            // now was sent with the unvalidated window.
+            //
+            CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_VALIDATING;
+            CarefulResume->LastUnvalidatedPacketNumber =
+                CXPLAT_MAX(NextPacketNumber, 1) - 1;
+        }
+        break;
+
+    case QUIC_CAREFUL_RESUME_PHASE_VALIDATING:
+        CarefulResume->PipeSize += AckedBytes;
+        if (LargestAck >= CarefulResume->LastUnvalidatedPacketNumber) {
+            CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_NORMAL;
+        }
+        break;
+
+    case QUIC_CAREFUL_RESUME_PHASE_SAFE_RETREAT:
+        if (LargestAck >= CarefulResume->LastUnvalidatedPacketNumber) {
+            CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_NORMAL;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicCarefulResumeOnLoss(
+    _Inout_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_ uint64_t LargestLostPacketNumber,
+    _In_ uint64_t NextPacketNumber
+    )
+{
+    switch (CarefulResume->Phase) {
+    case QUIC_CAREFUL_RESUME_PHASE_RECONNAISSANCE:
+        //
+        // Loss before the jump; the saved window is clearly not available.
+        //
+        CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_NORMAL;
+        return 0;
+
+    case QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED:
+    case QUIC_CAREFUL_RESUME_PHASE_VALIDATING:
+        if (LargestLostPacketNumber < CarefulResume->FirstUnvalidatedPacketNumber) {
+            return 0; // Left to the congestion controller.
+        }
+        if (CarefulResume->Phase == QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED) {
+            CarefulResume->LastUnvalidatedPacketNumber =
+                CXPLAT_MAX(NextPacketNumber, 1) - 1;
+        }
+        CarefulResume->Phase = QUIC_CAREFUL_RESUME_PHASE_SAFE_RETREAT;
+        return CXPLAT_MAX(CarefulResume->PipeSize / 2, 1);
+
+    default:
+        return 0;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnCarefulResumeStart(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QuicCarefulResumeInitialize(&Connection->CarefulResume, NULL);
+
+    if (!Connection->Settings.CarefulResumeEnabled ||
+        Connection->Registration == NULL ||
+        !QuicCongestionControlSupportsCarefulResume(&Connection->CongestionControl)) {
+        return;
+    }
+
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const char* ServerName =
+        QuicConnIsClient(Connection) ? Connection->RemoteServerName : NULL;
+    const uint16_t ServerNameLength =
+        ServerName == NULL ? 0 : (uint16_t)strnlen(ServerName, QUIC_MAX_SNI_LENGTH);
+
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved;
+    if (!QuicAddrIsWildCard(&Path->Route.RemoteAddress) &&
+        QuicCarefulResumeCacheLookup(
+            &Connection->Registration->CarefulResumeCache,
+            &Path->Route.RemoteAddress,
+            ServerNameLength,
+            ServerName,
+            CxPlatTimeUs64(),
+            &Saved) &&
+        Saved.Algorithm == Connection->Settings.CongestionControlAlgorithm) {
+
+        QuicCarefulResumeInitialize(&Connection->CarefulResume, &Saved);
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CC_CACHE_HIT);
+        QuicTraceLogConnInfo(
+            CarefulResumeCacheHit,
+            Connection,
+            "Careful resume state found: SRtt=%llu CWnd=%u",
+            Saved.SmoothedRtt,
+            Saved.CongestionWindow);
+
+    } else {
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CC_CACHE_MISS);
+    }
+}
+
+//
+// Returns the state worth remembering about the connection's path, if any.
+//
+static
+_Success_(return != FALSE)
+BOOLEAN
+QuicConnCarefulResumeGetSavedState(
+    _In_ const QUIC_CONNECTION* Connection,
+    _Out_ QUIC_CAREFUL_RESUME_SAVED_STATE* Saved
+    )
+{
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL* Cc = &Connection->CongestionControl;
+
+    if (!Connection->Settings.CarefulResumeEnabled ||
+        !Connection->State.Connected ||
+        !Path->GotFirstRttSample ||
+        QuicAddrIsWildCard(&Path->Route.RemoteAddress) ||
+        !QuicCongestionControlSupportsCarefulResume(Cc)) {
+        return FALSE;
+    }
+
+    const uint32_t CongestionWindow =
+        CXPLAT_MIN(
+            QuicCongestionControlGetCongestionWindow(Cc),
+            QuicCongestionControlGetBytesInFlightMax(Cc));
+    const uint32_t InitialWindow =
+        Connection->Settings.InitialWindowPackets *
+        QuicPathGetDatagramPayloadSize(Path);
+    if (CongestionWindow <= InitialWindow) {
+        return FALSE; // Nothing to gain.
+    }
+
+    Saved->SmoothedRtt = Path->SmoothedRtt;
+    Saved->MinRtt = Path->MinRtt;
+    Saved->CongestionWindow = CongestionWindow;
+    Saved->Algorithm = Connection->Settings.CongestionControlAlgorithm;
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnCarefulResumeSave(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved;
+    if (Connection->Registration == NULL ||
+        !QuicConnCarefulResumeGetSavedState(Connection, &Saved)) {
+        return;
+    }
+
+    const char* ServerName =
+        QuicConnIsClient(Connection) ? Connection->RemoteServerName : NULL;
+    QuicCarefulResumeCacheSave(
+        &Connection->Registration->CarefulResumeCache,
+        &Connection->Paths[0].Route.RemoteAddress,
+        ServerName == NULL ? 0 : (uint16_t)strnlen(ServerName, QUIC_MAX_SNI_LENGTH),
+        ServerName,
+        CxPlatTimeUs64(),
+        &Saved);
+
+    QuicTraceLogConnVerbose(
+        CarefulResumeSaved,
+        Connection,
+        "Careful resume state saved: SRtt=%llu CWnd=%u",
+        Saved.SmoothedRtt,
+        Saved.CongestionWindow);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicConnCarefulResumeGetTicketState(
+    _In_ const QUIC_CONNECTION* Connection,
+    _Out_ QUIC_CONN_CAREFUL_RESUME_STATE* TicketState
+    )
+{
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved;
+    if (Connection->Settings.CongestionControlAlgorithm >= QUIC_CONGESTION_CONTROL_ALGORITHM_MAX ||
+        !QuicConnCarefulResumeGetSavedState(Connection, &Saved)) {
+        return FALSE;
+    }
+
+    CxPlatZeroMemory(TicketState, sizeof(*TicketState));
+    TicketState->SmoothedRtt = Saved.SmoothedRtt;
+    TicketState->MinRtt = Saved.MinRtt;
+    TicketState->RemoteEndpoint = Connection->Paths[0].Route.RemoteAddress;
+    TicketState->Expiration =
+        MS_TO_US((uint64_t)CxPlatTimeEpochMs64()) + QUIC_CAREFUL_RESUME_LIFETIME_US;
+    TicketState->Algorithm = (QUIC_CONGESTION_CONTROL_ALGORITHM)Saved.Algorithm;
+    TicketState->CongestionWindow = Saved.CongestionWindow;
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnCarefulResumeOnTicketState(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_CONN_CAREFUL_RESUME_STATE* TicketState
+    )
+{
+    const QUIC_ADDR* RemoteAddress = &Connection->Paths[0].Route.RemoteAddress;
+
+    if (!Connection->Settings.CarefulResumeEnabled ||
+        Connection->CarefulResume.Phase != QUIC_CAREFUL_RESUME_PHASE_NONE ||
+        !QuicCongestionControlSupportsCarefulResume(&Connection->CongestionControl) ||
+        TicketState->Expiration <= MS_TO_US((uint64_t)CxPlatTimeEpochMs64()) ||
+        (uint16_t)TicketState->Algorithm != Connection->Settings.CongestionControlAlgorithm ||
+        QuicAddrGetFamily(&TicketState->RemoteEndpoint) != QuicAddrGetFamily(RemoteAddress) ||
+        !QuicAddrCompareIp(&TicketState->RemoteEndpoint, RemoteAddress)) {
+        return;
+    }
+
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved = {
+        .SmoothedRtt = TicketState->SmoothedRtt,
+        .MinRtt = TicketState->MinRtt,
+        .CongestionWindow = TicketState->CongestionWindow,
+        .Algorithm = (uint16_t)TicketState->Algorithm
+    };
+    QuicCarefulResumeInitialize(&Connection->CarefulResume, &Saved);
+
+    QuicTraceLogConnInfo(
+        CarefulResumeTicketState,
+        Connection,
+        "Careful resume state from ticket: SRtt=%llu CWnd=%u",
+        Saved.SmoothedRtt,
+        Saved.CongestionWindow);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicConnCarefulResumeOnAck(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t LargestAck,
+    _In_ uint32_t AckedBytes
+    )
+{
+    QUIC_CAREFUL_RESUME* CarefulResume = &Connection->CarefulResume;
+    QUIC_CONGESTION_CONTROL* Cc = &Connection->CongestionControl;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    switch (CarefulResume->Phase) {
+    case QUIC_CAREFUL_RESUME_PHASE_NONE:
+    case QUIC_CAREFUL_RESUME_PHASE_NORMAL:
+        return FALSE;
+
+    case QUIC_CAREFUL_RESUME_PHASE_RECONNAISSANCE: {
+        if (!Connection->State.Connected || !Path->GotFirstRttSample) {
+            return FALSE;
+        }
+        const uint32_t JumpWindow =
+            QuicCarefulResumeOnRttConfirmed(
+                CarefulResume,
+                Path->SmoothedRtt,
+                QuicCongestionControlGetCongestionWindow(Cc),
+                Connection->Send.NextPacketNumber);
+        if (JumpWindow == 0) {
+            QuicTraceLogConnInfo(
+                CarefulResumeAbandoned,
+                Connection,
+                "Careful resume not used: SRtt=%llu SavedSRtt=%llu",
+                Path->SmoothedRtt,
+                CarefulResume->Saved.SmoothedRtt);
+            return FALSE;
+        }
+        QuicTraceLogConnInfo(
+            CarefulResumeJump,
+            Connection,
+            "Careful resume jump: CWnd=%u",
+            JumpWindow);
+        return QuicCongestionControlSetCarefulResumeWindow(Cc, JumpWindow, FALSE);
+    }
+
+    default:
+        QuicCarefulResumeOnAck(
+            CarefulResume, LargestAck, AckedBytes, Connection->Send.NextPacketNumber);
+        if (CarefulResume->Phase == QUIC_CAREFUL_RESUME_PHASE_NORMAL) {
+            QuicTraceLogConnInfo(
+                CarefulResumeComplete,
+                Connection,
+                "Careful resume complete: PipeSize=%u",
+                CarefulResume->PipeSize);
+        }
+        return FALSE;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnCarefulResumeOnLoss(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t LargestLostPacketNumber
+    )
+{
+    if (Connection->CarefulResume.Phase == QUIC_CAREFUL_RESUME_PHASE_NONE) {
+        return;
+    }
+
+    const uint32_t RetreatWindow =
+        QuicCarefulResumeOnLoss(
+            &Connection->CarefulResume,
+            LargestLostPacketNumber,
+            Connection->Send.NextPacketNumber);
+    if (RetreatWindow != 0) {
+        QuicTraceLogConnInfo(
+            CarefulResumeRetreat,
+            Connection,
+            "Careful resume safe retreat: CWnd=%u",
+            RetreatWindow);
+        (void)QuicCongestionControlSetCarefulResumeWindow(
+            &Connection->CongestionControl, RetreatWindow, TRUE);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnCarefulResumeOnPathChanged(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    //
+    // The saved state describes the old path only.
+    //
+    if (Connection->CarefulResume.Phase != QUIC_CAREFUL_RESUME_PHASE_NONE) {
+        Connection->CarefulResume.Phase = QUIC_CAREFUL_RESUME_PHASE_NORMAL;
+    }
+}
@@ -0,0 +1,273 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Careful resume: reuse the congestion state of a previous connection to the
+    same destination to ramp up a new connection faster, without flooding a
+    path that has changed since (draft-ietf-tsvwg-careful-resume).
+
+--*/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+struct QUIC_CONN_CAREFUL_RESUME_V1;
+
+//
+// Congestion state observed at the end of a previous connection.
+//
+typedef struct QUIC_CAREFUL_RESUME_SAVED_STATE {
+
+    uint64_t SmoothedRtt;   // microseconds
+    uint64_t MinRtt;        // microseconds
+
+    //
+    // Bytes the path is known to have carried, i.e. the congestion window
+    // bounded by the largest amount of bytes that were actually in flight.
+    //
+    uint32_t CongestionWindow;
+
+    //
+    // QUIC_CONGESTION_CONTROL_ALGORITHM the state was measured with.
+    //
+    uint16_t Algorithm;
+
+} QUIC_CAREFUL_RESUME_SAVED_STATE;
+
+typedef struct QUIC_CAREFUL_RESUME_CACHE_ENTRY {
+
+    //
+    // Link in the cache's hash table.
+    //
+    CXPLAT_HASHTABLE_ENTRY TableEntry;
+
+    //
+    // Link in the cache's least recently used list.
+    //
+    CXPLAT_LIST_ENTRY LruLink;
+
+    //
+    // Remote IP address (the port is ignored).
+    //
+    QUIC_ADDR RemoteAddress;
+
+    //
+    // Time the entry was saved, from CxPlatTimeUs64.
+    //
+    uint64_t TimeSaved;
+
+    QUIC_CAREFUL_RESUME_SAVED_STATE State;
+
+    //
+    // Server name the client connected to. Empty on the server side.
+    //
+    uint16_t ServerNameLength;
+    _Field_size_(ServerNameLength)
+    char ServerName[0];
+
+} QUIC_CAREFUL_RESUME_CACHE_ENTRY;
+
+//
+// Per registration cache of congestion state, keyed by the remote IP address
+// and (for clients) the server name.
+//
+typedef struct QUIC_CAREFUL_RESUME_CACHE {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    CXPLAT_HASHTABLE Table;
+
+    //
+    // Entries ordered from least (head) to most (tail) recently saved.
+    //
+    CXPLAT_LIST_ENTRY LruList;
+
+    uint32_t EntryCount;
+
+} QUIC_CAREFUL_RESUME_CACHE;
+
+typedef enum QUIC_CAREFUL_RESUME_PHASE {
+    QUIC_CAREFUL_RESUME_PHASE_NONE,             // No saved state to use.
+    QUIC_CAREFUL_RESUME_PHASE_RECONNAISSANCE,   // Waiting to confirm the RTT.
+    QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED,      // Sending with the jumped window.
+    QUIC_CAREFUL_RESUME_PHASE_VALIDATING,       // Waiting for the jumped flight to be acknowledged.
+    QUIC_CAREFUL_RESUME_PHASE_SAFE_RETREAT,     // The jumped flight saw loss.
+    QUIC_CAREFUL_RESUME_PHASE_NORMAL,           // Done, the congestion controller owns the window.
+} QUIC_CAREFUL_RESUME_PHASE;
+
+//
+// Per connection careful resume state machine.
+//
+typedef struct QUIC_CAREFUL_RESUME {
+
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved;
+
+    //
+    // First and last packet numbers sent with the jumped window.
+    //
+    uint64_t FirstUnvalidatedPacketNumber;
+    uint64_t LastUnvalidatedPacketNumber;
+
+    //
+    // Bytes known to have been delivered since the jump.
+    //
+    uint32_t PipeSize;
+
+    uint8_t Phase; // QUIC_CAREFUL_RESUME_PHASE
+
+} QUIC_CAREFUL_RESUME;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicCarefulResumeCacheInitialize(
+    _Out_ QUIC_CAREFUL_RESUME_CACHE* Cache
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCarefulResumeCacheUninitialize(
+    _Inout_ QUIC_CAREFUL_RESUME_CACHE* Cache
+    );
+
+//
+// Looks up unexpired state for the destination.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicCarefulResumeCacheLookup(
+    _In_ QUIC_CAREFUL_RESUME_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_opt_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint64_t TimeNow,
+    _Out_ QUIC_CAREFUL_RESUME_SAVED_STATE* State
+    );
+
+//
+// Saves (or replaces) the state for the destination, evicting the least
+// recently saved entry if the cache is full.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCarefulResumeCacheSave(
+    _In_ QUIC_CAREFUL_RESUME_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_opt_(ServerNameLength)
+        const char* ServerName,
+    _In_ uint64_t TimeNow,
+    _In_ const QUIC_CAREFUL_RESUME_SAVED_STATE* State
+    );
+
+//
+// Arms the state machine with saved state.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCarefulResumeInitialize(
+    _Out_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_opt_ const QUIC_CAREFUL_RESUME_SAVED_STATE* Saved
+    );
+
+//
+// Called with the RTT while in the reconnaissance phase. Returns the window to
+// jump to, or 0 if the path doesn't look like the saved one.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicCarefulResumeOnRttConfirmed(
+    _Inout_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_ uint64_t SmoothedRtt,
+    _In_ uint32_t CongestionWindow,
+    _In_ uint64_t NextPacketNumber
+    );
+
+//
+// Tracks the acknowledgement of the jumped flight.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCarefulResumeOnAck(
+    _Inout_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_ uint64_t LargestAck,
+    _In_ uint32_t AckedBytes,
+    _In_ uint64_t NextPacketNumber
+    );
+
+//
+// Called on loss. Returns the window to retreat to, or 0 if no retreat is
+// needed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicCarefulResumeOnLoss(
+    _Inout_ QUIC_CAREFUL_RESUME* CarefulResume,
+    _In_ uint64_t LargestLostPacketNumber,
+    _In_ uint64_t NextPacketNumber
+    );
+
+//
+// Connection glue.
+//
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnCarefulResumeStart(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnCarefulResumeSave(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicConnCarefulResumeGetTicketState(
+    _In_ const QUIC_CONNECTION* Connection,
+    _Out_ struct QUIC_CONN_CAREFUL_RESUME_V1* TicketState
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnCarefulResumeOnTicketState(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const struct QUIC_CONN_CAREFUL_RESUME_V1* TicketState
+    );
+
+//
+// Returns TRUE if the connection became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicConnCarefulResumeOnAck(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t LargestAck,
+    _In_ uint32_t AckedBytes
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnCarefulResumeOnLoss(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t LargestLostPacketNumber
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnCarefulResumeOnPathChanged(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+#if defined(__cplusplus)
+}
+#endif
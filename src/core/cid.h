@@ -163,9 +163,20 @@ typedef struct QUIC_CID_LIST_ENTRY {
 #define QUIC_CID_VALIDATE_NULL(Conn, Cid) UNREFERENCED_PARAMETER(Cid)
 #endif
 
+//
+// Link in one of the lookup's hash chains. Receive-side readers follow Next
+// without holding any lock, so it is only updated with release semantics.
+//
+typedef struct QUIC_LOOKUP_LINK {
+
+    struct QUIC_LOOKUP_LINK* Next;
+    uint32_t Hash;
+
+} QUIC_LOOKUP_LINK;
+
 typedef struct QUIC_CID_HASH_ENTRY {
 
-    CXPLAT_HASHTABLE_ENTRY Entry;
+    QUIC_LOOKUP_LINK Entry;
     CXPLAT_SLIST_ENTRY Link;
     QUIC_CONNECTION* Connection;
     QUIC_CID CID;
@@ -17,6 +17,27 @@ Abstract:
 #include "congestion_control.c.clog.h"
 #endif
 
+//
+// The library's own algorithms, indexed by QUIC_CONGESTION_CONTROL_ALGORITHM.
+// Application provided algorithms are looked up in MsQuicLib's provider table
+// instead (see QuicLibraryGetCongestionControlProvider).
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_CONGESTION_CONTROL_INITIALIZE)(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
+
+static QUIC_CONGESTION_CONTROL_INITIALIZE* const
+QuicCongestionControlBuiltInAlgorithms[QUIC_CONGESTION_CONTROL_ALGORITHM_MAX] = {
+    CubicCongestionControlInitialize,   // QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC
+    BbrCongestionControlInitialize,     // QUIC_CONGESTION_CONTROL_ALGORITHM_BBR
+    DctcpCongestionControlInitialize,   // QUIC_CONGESTION_CONTROL_ALGORITHM_DCTCP
+    Bbr3CongestionControlInitialize,    // QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3
+};
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicCongestionControlInitialize(
@@ -24,21 +45,24 @@ QuicCongestionControlInitialize(
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     )
 {
-    CXPLAT_DBG_ASSERT(Settings->CongestionControlAlgorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_MAX);
-
-    switch (Settings->CongestionControlAlgorithm) {
-    default:
-        QuicTraceLogConnWarning(
-            InvalidCongestionControlAlgorithm,
-            QuicCongestionControlGetConnection(Cc),
-            "Unknown congestion control algorithm: %hu, fallback to Cubic",
-            Settings->CongestionControlAlgorithm);
-        __fallthrough;
-    case QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC:
-        CubicCongestionControlInitialize(Cc, Settings);
-        break;
-    case QUIC_CONGESTION_CONTROL_ALGORITHM_BBR:
-        BbrCongestionControlInitialize(Cc, Settings);
-        break;
+    const uint16_t Algorithm = Settings->CongestionControlAlgorithm;
+
+    if (Algorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_MAX) {
+        QuicCongestionControlBuiltInAlgorithms[Algorithm](Cc, Settings);
+        return;
     }
+
+    const QUIC_CONGESTION_CONTROL_PROVIDER* Provider =
+        QuicLibraryGetCongestionControlProvider(Algorithm);
+    if (Provider != NULL) {
+        CustomCongestionControlInitialize(Cc, Settings, Provider);
+        return;
+    }
+
+    QuicTraceLogConnWarning(
+        InvalidCongestionControlAlgorithm,
+        QuicCongestionControlGetConnection(Cc),
+        "Unknown congestion control algorithm: %hu, fallback to Cubic",
+        Algorithm);
+    CubicCongestionControlInitialize(Cc, Settings);
 }
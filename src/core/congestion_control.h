@@ -7,6 +7,12 @@
 
 #include "bbr.h"
 #include "cubic.h"
+#include "dctcp.h"
+#include "custom_cc.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
 
 typedef struct QUIC_ACK_EVENT {
 
@@ -73,6 +79,11 @@ typedef struct QUIC_ECN_EVENT {
 
     uint64_t LargestSentPacketNumber;
 
+    //
+    // The number of packets newly reported as CE marked by the peer.
+    //
+    uint32_t NumCePackets;
+
 } QUIC_ECN_EVENT;
 
 typedef struct QUIC_CONGESTION_CONTROL {
@@ -161,12 +172,25 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _Out_ struct QUIC_NETWORK_STATISTICS* NetworkStatistics
         );
 
+    //
+    // Optional. Raises the window to a value remembered from an earlier
+    // connection (careful resume), or lowers it again if that turned out
+    // to be too much for the path.
+    //
+    BOOLEAN (*QuicCongestionControlSetCarefulResumeWindow)(
+        _In_ struct QUIC_CONGESTION_CONTROL* Cc,
+        _In_ uint32_t CongestionWindow,
+        _In_ BOOLEAN IsRetreat
+        );
+
     //
     // Algorithm specific state.
     //
     union {
         QUIC_CONGESTION_CONTROL_CUBIC Cubic;
         QUIC_CONGESTION_CONTROL_BBR Bbr;
+        QUIC_CONGESTION_CONTROL_DCTCP Dctcp;
+        QUIC_CONGESTION_CONTROL_CUSTOM Custom;
     };
 
 } QUIC_CONGESTION_CONTROL;
@@ -340,6 +364,40 @@ QuicCongestionControlOnEcn(
     }
 }
 
+//
+// Returns TRUE if the algorithm can take a congestion window from the careful
+// resume logic.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+BOOLEAN
+QuicCongestionControlSupportsCarefulResume(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->QuicCongestionControlSetCarefulResumeWindow != NULL;
+}
+
+//
+// Jumps the congestion window up to CongestionWindow or, on retreat, caps it
+// to CongestionWindow and leaves slow start. Returns TRUE if we became
+// unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+BOOLEAN
+QuicCongestionControlSetCarefulResumeWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow,
+    _In_ BOOLEAN IsRetreat
+    )
+{
+    if (Cc->QuicCongestionControlSetCarefulResumeWindow) {
+        return Cc->QuicCongestionControlSetCarefulResumeWindow(Cc, CongestionWindow, IsRetreat);
+    }
+    return FALSE;
+}
+
 //
 // Called when all recently considered lost data was actually acknowledged.
 //
@@ -412,3 +470,7 @@ QuicCongestionControlSetAppLimited(
 {
     Cc->QuicCongestionControlSetAppLimited(Cc);
 }
+
+#if defined(__cplusplus)
+}
+#endif
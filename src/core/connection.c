@@ -1389,6 +1389,12 @@ QuicConnOnShutdownComplete(
         Connection,
         Connection->State.ShutdownCompleteTimedOut);
 
+    //
+    // Remember the path's congestion state for the next connection to the
+    // same peer.
+    //
+    QuicConnCarefulResumeSave(Connection);
+
     //
     // Clean up any pending state that is irrelevant now.
     //
@@ -2083,6 +2089,7 @@ QuicConnSendResumptionTicket(
     uint8_t* TicketBuffer = NULL;
     uint32_t TicketLength = 0;
     uint8_t AlpnLength = Connection->Crypto.TlsState.NegotiatedAlpn[0];
+    QUIC_CONN_CAREFUL_RESUME_STATE CarefulResumeState;
 
     if (Connection->HandshakeTP == NULL) {
         Status = QUIC_STATUS_OUT_OF_MEMORY;
@@ -2096,7 +2103,8 @@ QuicConnSendResumptionTicket(
             AppDataLength,
             AppResumptionData,
             Connection->HandshakeTP,
-            NULL,    // No Careful Resumption data
+            QuicConnCarefulResumeGetTicketState(Connection, &CarefulResumeState) ?
+                &CarefulResumeState : NULL,
             AlpnLength,
             Connection->Crypto.TlsState.NegotiatedAlpn + 1,
             &TicketBuffer,
@@ -2125,7 +2133,8 @@ QuicConnRecvResumptionTicket(
     _In_ QUIC_CONNECTION* Connection,
     _In_ uint32_t TicketLength,
     _In_reads_(TicketLength)
-        const uint8_t* Ticket
+        const uint8_t* Ticket,
+    _In_opt_ const CXPLAT_TLS_TICKET_INFO* TicketInfo
     )
 {
     BOOLEAN ResumptionAccepted = FALSE;
@@ -2155,6 +2164,7 @@ QuicConnRecvResumptionTicket(
 
         const uint8_t* AppData = NULL;
         uint32_t AppDataLength = 0;
+        QUIC_CONN_CAREFUL_RESUME_STATE CarefulResumeState = {0};
 
         QUIC_STATUS Status =
             QuicCryptoDecodeServerTicket(
@@ -2164,7 +2174,7 @@ QuicConnRecvResumptionTicket(
                 Connection->Configuration->AlpnList,
                 Connection->Configuration->AlpnListLength,
                 &ResumedTP,
-                NULL,    // No Careful Resumption data
+                Connection->Settings.CarefulResumeEnabled ? &CarefulResumeState : NULL,
                 &AppData,
                 &AppDataLength);
         if (QUIC_FAILED(Status)) {
@@ -2225,6 +2235,10 @@ QuicConnRecvResumptionTicket(
             Connection->Crypto.TicketValidationPending = FALSE;
         }
 
+        if (ResumptionAccepted && Connection->Settings.CarefulResumeEnabled) {
+            QuicConnCarefulResumeOnTicketState(Connection, &CarefulResumeState);
+        }
+
     } else {
 
         const uint8_t* ClientTicket = NULL;
@@ -2242,6 +2256,9 @@ QuicConnRecvResumptionTicket(
                 &ClientTicket,
                 &ClientTicketLength))) {
 
+            QuicConnTicketCacheSave(
+                Connection, ClientTicketLength, ClientTicket, TicketInfo);
+
             QUIC_CONNECTION_EVENT Event;
             Event.Type = QUIC_CONNECTION_EVENT_RESUMPTION_TICKET_RECEIVED;
             Event.RESUMPTION_TICKET_RECEIVED.ResumptionTicketLength = ClientTicketLength;
@@ -2518,19 +2535,33 @@ QuicConnSetConfiguration(
             &Configuration->Settings);
     }
 
+    //
+    // The remote address (and server name) are known by now, so look up any
+    // congestion state saved by a previous connection to the same peer.
+    //
+    QuicConnCarefulResumeStart(Connection);
+
     if (QuicConnIsClient(Connection)) {
 
         if (Connection->Stats.QuicVersion == 0) {
             //
             // Only initialize the version if not already done (by the
-            // application layer).
+            // application layer). Without a ticket from the application, one
+            // from the ticket cache provides the version.
             //
-            Connection->Stats.QuicVersion = QUIC_VERSION_LATEST;
+            const BOOLEAN ResumedFromCache = QuicConnTicketCacheResume(Connection);
+            if (!ResumedFromCache) {
+                Connection->Stats.QuicVersion = QUIC_VERSION_LATEST;
+            }
             QuicConnOnQuicVersionSet(Connection);
             Status = QuicCryptoOnVersionChange(&Connection->Crypto);
             if (QUIC_FAILED(Status)) {
                 goto Error;
             }
+            if (ResumedFromCache) {
+                Status = QuicConnProcessPeerTransportParameters(Connection, TRUE);
+                CXPLAT_DBG_ASSERT(QUIC_SUCCEEDED(Status));
+            }
         }
 
         CXPLAT_DBG_ASSERT(!CxPlatListIsEmpty(&Connection->DestCids));
@@ -4631,6 +4662,7 @@ QuicConnRecvFrames(
             }
 
             Connection->Stats.Recv.ValidAckFrames++;
+            QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_ACK_FRAMES_RECV);
             Packet->HasNonProbingFrame = TRUE;
             break;
         }
@@ -6371,6 +6403,59 @@ QuicConnUpdatePeerPacketTolerance(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdateAckFrequency(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow
+    )
+{
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    if (!Connection->Settings.AdaptiveAckFrequencyEnabled ||
+        !(Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_MIN_ACK_DELAY) ||
+        !Connection->State.HandshakeConfirmed ||
+        !Path->GotFirstRttSample) {
+        return;
+    }
+
+    //
+    // Never ask for more delay than the peer advertised, since that is what
+    // our PTO accounts for.
+    //
+    uint64_t RequestedMaxAckDelayUs;
+    const uint8_t PacketTolerance =
+        QuicConnComputeAckFrequency(
+            QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl),
+            QuicPathGetDatagramPayloadSize(Path),
+            Path->SmoothedRtt,
+            CXPLAT_MAX(
+                Connection->PeerTransportParams.MinAckDelay,
+                MS_TO_US((uint64_t)MsQuicLib.TimerResolutionMs)),
+            MS_TO_US(Connection->PeerTransportParams.MaxAckDelay),
+            &RequestedMaxAckDelayUs);
+
+    //
+    // Only update for a change of at least a quarter, so that the window moving
+    // around doesn't turn into a stream of ACK_FREQUENCY frames. More frequent
+    // ACKs (e.g. after loss) are asked for right away, less frequent ones at
+    // most once per RTT.
+    //
+    const uint8_t Current = Connection->PeerPacketTolerance;
+    if (PacketTolerance > Current) {
+        if (PacketTolerance - Current < Current / 4 ||
+            CxPlatTimeDiff64(Connection->AckFrequencyUpdateTime, TimeNow) < Path->SmoothedRtt) {
+            return;
+        }
+    } else if (Current - PacketTolerance < Current / 4 ||
+               PacketTolerance == Current) {
+        return;
+    }
+
+    Connection->AckFrequencyUpdateTime = TimeNow;
+    Connection->PeerMaxAckDelayUs = RequestedMaxAckDelayUs;
+    QuicConnUpdatePeerPacketTolerance(Connection, PacketTolerance);
+}
+
 #define QUIC_CONN_BAD_START_STATE(CONN) (CONN->State.Started || CONN->State.ClosedLocally)
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -6648,8 +6733,7 @@ QuicConnParamSet(
             break;
         }
 
-        Connection->State.UseRoundRobinStreamScheduling =
-            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        QuicSendSetStreamSchedulingScheme(&Connection->Send, Scheme);
 
         QuicTraceLogConnInfo(
             UpdateStreamSchedulingScheme,
@@ -7454,8 +7538,7 @@ QuicConnParamGet(
 
         *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
         *(QUIC_STREAM_SCHEDULING_SCHEME*)Buffer =
-            Connection->State.UseRoundRobinStreamScheduling ?
-                QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN : QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+            (QUIC_STREAM_SCHEDULING_SCHEME)Connection->Send.StreamSchedulingScheme;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
@@ -8,6 +8,10 @@
 #include "connection.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_LISTENER QUIC_LISTENER;
 
 //
@@ -136,12 +140,6 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN TestTransportParameterSet : 1;
 
-        //
-        // Indicates the connection is using the round robin stream scheduling
-        // scheme.
-        //
-        BOOLEAN UseRoundRobinStreamScheduling : 1;
-
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -498,6 +496,18 @@ typedef struct QUIC_CONNECTION {
     //
     uint64_t SendAckFreqSeqNum;
 
+    //
+    // The max ACK delay (in microseconds) we want the peer to use, or 0 to ask
+    // for our own ACK delay. Requires the ACK_FREQUENCY extension/frame.
+    //
+    uint64_t PeerMaxAckDelayUs;
+
+    //
+    // The last time the ACK frequency requested from the peer was updated to
+    // follow the congestion window.
+    //
+    uint64_t AckFrequencyUpdateTime;
+
     //
     // The next ACK frequency sequence number we expect to receive.
     //
@@ -628,6 +638,12 @@ typedef struct QUIC_CONNECTION {
     //
     QUIC_CONGESTION_CONTROL CongestionControl;
 
+    //
+    // Careful resume state, for reusing a previous connection's congestion
+    // window.
+    //
+    QUIC_CAREFUL_RESUME CarefulResume;
+
     //
     // Manages all the information for outstanding sent packets.
     //
@@ -1692,6 +1708,53 @@ QuicConnUpdatePeerPacketTolerance(
     _In_ uint8_t NewPacketTolerance
     );
 
+//
+// Computes the ACK frequency to request from the peer, so that it acknowledges
+// about a quarter of the congestion window at a time, waiting at most a
+// quarter of the RTT. Returns the packet tolerance.
+//
+QUIC_INLINE
+uint8_t
+QuicConnComputeAckFrequency(
+    _In_ uint32_t CongestionWindow,
+    _In_ uint16_t DatagramPayloadSize,
+    _In_ uint64_t SmoothedRtt,
+    _In_ uint64_t MinAckDelayUs,
+    _In_ uint64_t MaxAckDelayUs,
+    _Out_ uint64_t* RequestedMaxAckDelayUs
+    )
+{
+    uint32_t PacketTolerance =
+        CongestionWindow / QUIC_ACK_FREQUENCY_CWND_DIVISOR / DatagramPayloadSize;
+    if (PacketTolerance < QUIC_MIN_ACK_SEND_NUMBER) {
+        PacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
+    } else if (PacketTolerance > UINT8_MAX) {
+        PacketTolerance = UINT8_MAX;
+    }
+
+    uint64_t AckDelay = SmoothedRtt / QUIC_ACK_FREQUENCY_RTT_DIVISOR;
+    if (AckDelay > MaxAckDelayUs) {
+        AckDelay = MaxAckDelayUs;
+    }
+    if (AckDelay < MinAckDelayUs) {
+        AckDelay = MinAckDelayUs; // The peer must accept anything above its min_ack_delay.
+    }
+    *RequestedMaxAckDelayUs = AckDelay;
+
+    return (uint8_t)PacketTolerance;
+}
+
+//
+// Updates the ACK frequency requested from the peer to follow the congestion
+// window, if enabled.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdateAckFrequency(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow
+    );
+
 //
 // Sets a connection parameter.
 //
@@ -1779,3 +1842,7 @@ QuicMtuDiscoveryCheckSearchCompleteTimeout(
         }
     }
 }
+
+#if defined(__cplusplus)
+}
+#endif
@@ -3008,7 +3008,12 @@ QuicCryptoDecodeClientTicket(
             "Client Ticket version failed to decode");
         goto Error;
     }
-    if (TicketVersion != CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION) {
+    if (TicketVersion < CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_MIN_VERSION ||
+        TicketVersion > CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION) {
+        //
+        // Older versions only differ in the TLS session encoding, which the
+        // TLS provider still reads.
+        //
         QuicTraceEvent(
             ConnError,
             "[conn][%p] ERROR, %s.",
@@ -822,6 +822,61 @@ CubicCongestionControlOnSpuriousCongestionEvent(
     return Result;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CubicCongestionControlSetCarefulResumeWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow,
+    _In_ BOOLEAN IsRetreat
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = CubicCongestionControlCanSend(Cc);
+
+    if (!IsRetreat) {
+        //
+        // Only jump while still in slow start. BytesInFlightMax is raised too
+        // so the window isn't immediately clamped back by the app-limited
+        // check in the ACK path.
+        //
+        if (Cubic->HasHadCongestionEvent ||
+            CongestionWindow <= Cubic->CongestionWindow) {
+            return FALSE;
+        }
+        Cubic->CongestionWindow = CongestionWindow;
+        Cubic->BytesInFlightMax =
+            CXPLAT_MAX(Cubic->BytesInFlightMax, CongestionWindow / 2);
+
+    } else {
+        //
+        // The resumed window caused loss. Fall back to what was actually
+        // delivered and continue in congestion avoidance from there.
+        //
+        const uint32_t MinCongestionWindow =
+            QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+            QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS;
+        CongestionWindow = CXPLAT_MAX(CongestionWindow, MinCongestionWindow);
+        if (CongestionWindow >= Cubic->CongestionWindow) {
+            return FALSE;
+        }
+        Cubic->WindowPrior =
+        Cubic->WindowMax =
+        Cubic->WindowLastMax =
+        Cubic->SlowStartThreshold =
+        Cubic->AimdWindow =
+        Cubic->CongestionWindow =
+            CongestionWindow;
+        Cubic->KCubic = 0;
+        Cubic->TimeOfCongAvoidStart = CxPlatTimeUs64();
+        CubicCongestionHyStartChangeState(Cc, HYSTART_DONE);
+    }
+
+    BOOLEAN Result = CubicCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogCubic(Connection);
+    return Result;
+}
+
 void
 CubicCongestionControlLogOutFlowStatus(
     _In_ const QUIC_CONGESTION_CONTROL* Cc
@@ -907,7 +962,8 @@ static const QUIC_CONGESTION_CONTROL QuicCongestionControlCubic = {
     .QuicCongestionControlIsAppLimited = CubicCongestionControlIsAppLimited,
     .QuicCongestionControlSetAppLimited = CubicCongestionControlSetAppLimited,
     .QuicCongestionControlGetCongestionWindow = CubicCongestionControlGetCongestionWindow,
-    .QuicCongestionControlGetNetworkStatistics = CubicCongestionControlGetNetworkStatistics
+    .QuicCongestionControlGetNetworkStatistics = CubicCongestionControlGetNetworkStatistics,
+    .QuicCongestionControlSetCarefulResumeWindow = CubicCongestionControlSetCarefulResumeWindow
 };
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -0,0 +1,488 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Adapts an application provided congestion control algorithm (registered
+    via QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER) to the internal
+    congestion control interface.
+
+    The provider only owns the congestion window (and optionally pacing). The
+    bookkeeping every algorithm needs, i.e. bytes in flight, exemptions, the
+    connection's congestion blocked state and statistics, is done here.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "custom_cc.c.clog.h"
+#endif
+
+#include "custom_cc.h"
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlGetPathInfo(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc,
+    _Out_ QUIC_CONGESTION_CONTROL_PATH_INFO* PathInfo
+    )
+{
+    const QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    PathInfo->SmoothedRtt = Path->GotFirstRttSample ? Path->SmoothedRtt : 0;
+    PathInfo->MinRtt = Path->GotFirstRttSample ? Path->MinRtt : UINT64_MAX;
+    PathInfo->InitialWindowPackets = Custom->InitialWindowPackets;
+    PathInfo->SendIdleTimeoutMs = Custom->SendIdleTimeoutMs;
+    PathInfo->BytesInFlight = Custom->BytesInFlight;
+    PathInfo->DatagramPayloadLength = QuicPathGetDatagramPayloadSize(Path);
+    PathInfo->GotFirstRttSample = Path->GotFirstRttSample;
+    PathInfo->PacingEnabled = Connection->Settings.PacingEnabled;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CustomCongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.Provider->GetCongestionWindow(Cc->Custom.State);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    return
+        Custom->Exemptions > 0 ||
+        Custom->BytesInFlight < CustomCongestionControlGetCongestionWindow(Cc);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Custom.Exemptions = NumPackets;
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    if (PreviousCanSendState != CustomCongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    if (FullReset) {
+        Custom->BytesInFlight = 0;
+    }
+
+    QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+    CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+    CxPlatZeroMemory(Custom->State, sizeof(Custom->State));
+    Custom->Provider->Initialize(Custom->State, &PathInfo);
+    Custom->BytesInFlightMax = CustomCongestionControlGetCongestionWindow(Cc) / 2;
+
+    QuicConnLogOutFlowStats(QuicCongestionControlGetConnection(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CustomCongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    const uint32_t CongestionWindow = CustomCongestionControlGetCongestionWindow(Cc);
+    if (Custom->BytesInFlight >= CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        return 0;
+    }
+
+    uint32_t SendAllowance = CongestionWindow - Custom->BytesInFlight;
+    if (Custom->Provider->GetSendAllowance != NULL) {
+        QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+        CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+        const uint32_t ProviderAllowance =
+            Custom->Provider->GetSendAllowance(
+                Custom->State,
+                &PathInfo,
+                TimeSinceLastSend,
+                TimeSinceLastSendValid);
+        if (ProviderAllowance < SendAllowance) {
+            SendAllowance = ProviderAllowance;
+        }
+    }
+    return SendAllowance;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CustomCongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    Custom->BytesInFlight += NumRetransmittableBytes;
+    if (Custom->BytesInFlightMax < Custom->BytesInFlight) {
+        Custom->BytesInFlightMax = Custom->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (Custom->Exemptions > 0) {
+        --Custom->Exemptions;
+    }
+
+    if (Custom->Provider->OnDataSent != NULL) {
+        QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+        CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+        Custom->Provider->OnDataSent(Custom->State, &PathInfo, NumRetransmittableBytes);
+    }
+
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= NumRetransmittableBytes);
+    Custom->BytesInFlight -= NumRetransmittableBytes;
+
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= AckEvent->NumRetransmittableBytes);
+    Custom->BytesInFlight -= AckEvent->NumRetransmittableBytes;
+
+    QUIC_CONGESTION_CONTROL_ACK_EVENT Event;
+    Event.TimeNow = AckEvent->TimeNow;
+    Event.LargestAck = AckEvent->LargestAck;
+    Event.LargestSentPacketNumber = AckEvent->LargestSentPacketNumber;
+    Event.NumTotalAckedRetransmittableBytes = AckEvent->NumTotalAckedRetransmittableBytes;
+    Event.SmoothedRtt = AckEvent->SmoothedRtt;
+    Event.MinRtt = AckEvent->MinRtt;
+    Event.OneWayDelay = AckEvent->OneWayDelay;
+    Event.AdjustedAckTime = AckEvent->AdjustedAckTime;
+    Event.NumRetransmittableBytes = AckEvent->NumRetransmittableBytes;
+    Event.IsImplicit = AckEvent->IsImplicit;
+    Event.HasLoss = AckEvent->HasLoss;
+    Event.IsLargestAckedPacketAppLimited = AckEvent->IsLargestAckedPacketAppLimited;
+    Event.MinRttValid = AckEvent->MinRttValid;
+
+    QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+    CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+    Custom->Provider->OnDataAcknowledged(Custom->State, &PathInfo, &Event);
+
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+//
+// Updates the connection's congestion statistics if the provider reduced its
+// window in response to a congestion signal.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlOnCongestionSignal(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t PreviousCongestionWindow,
+    _In_ BOOLEAN Ecn
+    )
+{
+    if (CustomCongestionControlGetCongestionWindow(Cc) >= PreviousCongestionWindow) {
+        return;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicTraceEvent(
+        ConnCongestionV2,
+        "[conn][%p] Congestion event: IsEcn=%hu",
+        Connection,
+        Ecn);
+    Connection->Stats.Send.CongestionCount++;
+    if (Ecn) {
+        Connection->Stats.Send.EcnCongestionCount++;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+    const uint32_t PreviousCongestionWindow = CustomCongestionControlGetCongestionWindow(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Custom->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    if (LossEvent->PersistentCongestion) {
+        QuicTraceEvent(
+            ConnPersistentCongestion,
+            "[conn][%p] Persistent congestion event",
+            Connection);
+        Connection->Stats.Send.PersistentCongestionCount++;
+        Connection->Paths[0].Route.State = RouteSuspected; // used only for RAW datapath
+    }
+
+    QUIC_CONGESTION_CONTROL_LOSS_EVENT Event;
+    Event.LargestPacketNumberLost = LossEvent->LargestPacketNumberLost;
+    Event.LargestSentPacketNumber = LossEvent->LargestSentPacketNumber;
+    Event.NumRetransmittableBytes = LossEvent->NumRetransmittableBytes;
+    Event.PersistentCongestion = LossEvent->PersistentCongestion;
+
+    QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+    CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+    Custom->Provider->OnDataLost(Custom->State, &PathInfo, &Event);
+
+    CustomCongestionControlOnCongestionSignal(Cc, PreviousCongestionWindow, FALSE);
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    if (Custom->Provider->OnEcn == NULL) {
+        return;
+    }
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+    const uint32_t PreviousCongestionWindow = CustomCongestionControlGetCongestionWindow(Cc);
+
+    QUIC_CONGESTION_CONTROL_ECN_EVENT Event;
+    Event.LargestPacketNumberAcked = EcnEvent->LargestPacketNumberAcked;
+    Event.LargestSentPacketNumber = EcnEvent->LargestSentPacketNumber;
+    Event.NumCePackets = EcnEvent->NumCePackets;
+
+    QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+    CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+    Custom->Provider->OnEcn(Custom->State, &PathInfo, &Event);
+
+    CustomCongestionControlOnCongestionSignal(Cc, PreviousCongestionWindow, TRUE);
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    if (Custom->Provider->OnSpuriousCongestionEvent == NULL) {
+        return FALSE;
+    }
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+    CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+    if (!Custom->Provider->OnSpuriousCongestionEvent(Custom->State, &PathInfo)) {
+        return FALSE;
+    }
+
+    QuicTraceEvent(
+        ConnSpuriousCongestion,
+        "[conn][%p] Spurious congestion event",
+        QuicCongestionControlGetConnection(Cc));
+
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+void
+CustomCongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    QuicTraceEvent(
+        ConnOutFlowStatsV2,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u CWnd=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%llu 1Way=%llu",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Custom->BytesInFlight,
+        CustomCongestionControlGetCongestionWindow(Cc),
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0,
+        Path->OneWayDelay);
+}
+
+uint32_t
+CustomCongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+CustomCongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.Exemptions;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlIsAppLimited(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlSetAppLimited(
+    _In_ struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlGetNetworkStatistics(
+    _In_ const QUIC_CONNECTION* const Connection,
+    _In_ const QUIC_CONGESTION_CONTROL* const Cc,
+    _Out_ QUIC_NETWORK_STATISTICS* NetworkStatistics
+    )
+{
+    const QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const uint32_t CongestionWindow = CustomCongestionControlGetCongestionWindow(Cc);
+
+    NetworkStatistics->BytesInFlight = Custom->BytesInFlight;
+    NetworkStatistics->PostedBytes = Connection->SendBuffer.PostedBytes;
+    NetworkStatistics->IdealBytes = Connection->SendBuffer.IdealBytes;
+    NetworkStatistics->SmoothedRTT = Path->SmoothedRtt;
+    NetworkStatistics->CongestionWindow = CongestionWindow;
+    NetworkStatistics->Bandwidth = Path->SmoothedRtt == 0 ? 0 : CongestionWindow / Path->SmoothedRtt;
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlCustom = {
+    .QuicCongestionControlCanSend = CustomCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = CustomCongestionControlSetExemption,
+    .QuicCongestionControlReset = CustomCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = CustomCongestionControlGetSendAllowance,
+    .QuicCongestionControlOnDataSent = CustomCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = CustomCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = CustomCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = CustomCongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = CustomCongestionControlOnEcn,
+    .QuicCongestionControlOnSpuriousCongestionEvent = CustomCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = CustomCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = CustomCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = CustomCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = CustomCongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = CustomCongestionControlSetAppLimited,
+    .QuicCongestionControlGetCongestionWindow = CustomCongestionControlGetCongestionWindow,
+    .QuicCongestionControlGetNetworkStatistics = CustomCongestionControlGetNetworkStatistics
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings,
+    _In_ const QUIC_CONGESTION_CONTROL_PROVIDER* Provider
+    )
+{
+    *Cc = QuicCongestionControlCustom;
+    Cc->Name = Provider->Name;
+
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    Custom->Provider = Provider;
+    Custom->InitialWindowPackets = Settings->InitialWindowPackets;
+    Custom->SendIdleTimeoutMs = Settings->SendIdleTimeoutMs;
+
+    QUIC_CONGESTION_CONTROL_PATH_INFO PathInfo;
+    CustomCongestionControlGetPathInfo(Cc, &PathInfo);
+    Provider->Initialize(Custom->State, &PathInfo);
+    Custom->BytesInFlightMax = CustomCongestionControlGetCongestionWindow(Cc) / 2;
+
+    QuicConnLogOutFlowStats(QuicCongestionControlGetConnection(Cc));
+}
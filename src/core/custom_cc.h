@@ -0,0 +1,60 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// State for a congestion control algorithm provided by the application via
+// QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER.
+//
+typedef struct QUIC_CONGESTION_CONTROL_CUSTOM {
+
+    //
+    // The registered provider. Points into the library's provider table.
+    //
+    const QUIC_CONGESTION_CONTROL_PROVIDER* Provider;
+
+    uint32_t InitialWindowPackets;
+    uint32_t SendIdleTimeoutMs;
+
+    //
+    // The number of bytes considered to be still in the network.
+    //
+    uint32_t BytesInFlight;
+
+    //
+    // The largest BytesInFlight value seen so far.
+    //
+    uint32_t BytesInFlightMax;
+
+    //
+    // Number of packets that can be sent regardless of the congestion window.
+    //
+    uint8_t Exemptions;
+
+    //
+    // The provider's per-connection state.
+    //
+    uint64_t State[QUIC_CONGESTION_CONTROL_PROVIDER_MAX_STATE_SIZE / sizeof(uint64_t)];
+
+} QUIC_CONGESTION_CONTROL_CUSTOM;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings,
+    _In_ const QUIC_CONGESTION_CONTROL_PROVIDER* Provider
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,774 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    A congestion control algorithm for low latency (datacenter) networks. It
+    reacts in proportion to the extent of congestion instead of treating every
+    congestion signal as loss:
+
+    - ECN: the window is reduced by Alpha / 2, where Alpha is a moving average
+      of the fraction of CE marked packets (DCTCP, RFC 8257).
+
+    - Delay: for paths without ECN marking, the window is reduced in
+      proportion to how far the measured delay exceeds a target queueing delay
+      above the base delay (as in Swift). The one-way delay of the send path is
+      used if the peer supports it, as it is not affected by reverse path
+      queueing.
+
+    Window growth and the reaction to loss are the same as NewReno.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "dctcp.c.clog.h"
+#endif
+
+#include "dctcp.h"
+
+//
+// Gain of the moving average of the CE marked fraction, as a shift (g = 1/16).
+//
+#define DCTCP_ALPHA_GAIN_SHIFT 4
+
+//
+// The queueing delay target is a quarter of the base delay, but at least this
+// many microseconds, so that RTT measurement noise doesn't cause reductions.
+//
+#define DCTCP_MIN_TARGET_QUEUE_DELAY_US 100
+
+//
+// Window reduction for delay above target: Beta * (Delay - Target) / Delay,
+// up to MaxReduction. Scaled by QUIC_DCTCP_ALPHA_SCALE.
+//
+#define DCTCP_DELAY_BETA          (QUIC_DCTCP_ALPHA_SCALE * 8 / 10)
+#define DCTCP_DELAY_MAX_REDUCTION (QUIC_DCTCP_ALPHA_SCALE / 2)
+
+//
+// Window reduction on packet loss. Scaled by QUIC_DCTCP_ALPHA_SCALE.
+//
+#define DCTCP_LOSS_REDUCTION (QUIC_DCTCP_ALPHA_SCALE / 2)
+
+typedef enum DCTCP_CONGESTION_SIGNAL {
+    DCTCP_CONGESTION_SIGNAL_LOSS,
+    DCTCP_CONGESTION_SIGNAL_ECN,
+    DCTCP_CONGESTION_SIGNAL_DELAY
+} DCTCP_CONGESTION_SIGNAL;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnLogDctcp(
+    _In_ const QUIC_CONNECTION* const Connection
+    )
+{
+    const QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Connection->CongestionControl.Dctcp;
+
+    QuicTraceLogConnVerbose(
+        DctcpState,
+        Connection,
+        "DCTCP: Alpha=%u SlowStartThreshold=%u CongestionWindow=%u BaseDelay=%llu",
+        Dctcp->Alpha,
+        Dctcp->SlowStartThreshold,
+        Dctcp->CongestionWindow,
+        Dctcp->BaseDelay);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+    return Dctcp->BytesInFlight < Dctcp->CongestionWindow || Dctcp->Exemptions > 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Dctcp.Exemptions = NumPackets;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    Dctcp->SlowStartThreshold = UINT32_MAX;
+    Dctcp->IsInRecovery = FALSE;
+    Dctcp->HasHadCongestionEvent = FALSE;
+    Dctcp->IsInPersistentCongestion = FALSE;
+    Dctcp->CongestionWindow = DatagramPayloadLength * Dctcp->InitialWindowPackets;
+    Dctcp->BytesInFlightMax = Dctcp->CongestionWindow / 2;
+    Dctcp->LastSendAllowance = 0;
+    Dctcp->AimdAccumulator = 0;
+
+    //
+    // Start out assuming full congestion, so the first CE mark halves the
+    // window like any other congestion signal (RFC 8257, Section 3.3).
+    //
+    Dctcp->Alpha = QUIC_DCTCP_ALPHA_SCALE;
+    Dctcp->AlphaWindowEnd = Connection->Send.NextPacketNumber;
+    Dctcp->AckedPacketsInWindow = 0;
+    Dctcp->CePacketsInWindow = 0;
+
+    //
+    // The base delay of a new path is unknown.
+    //
+    Dctcp->BaseDelayValid = FALSE;
+    Dctcp->BaseDelay = 0;
+
+    if (FullReset) {
+        Dctcp->BytesInFlight = 0;
+    }
+
+    QuicConnLogOutFlowStats(Connection);
+    QuicConnLogDctcp(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+DctcpCongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    uint32_t SendAllowance;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (Dctcp->BytesInFlight >= Dctcp->CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        SendAllowance = 0;
+
+    } else if (
+        !TimeSinceLastSendValid ||
+        !Connection->Settings.PacingEnabled ||
+        !Connection->Paths[0].GotFirstRttSample ||
+        Connection->Paths[0].SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        //
+        // We're not in the necessary state to pace.
+        //
+        SendAllowance = Dctcp->CongestionWindow - Dctcp->BytesInFlight;
+
+    } else {
+        //
+        // We are pacing, so split the predicted window of the next round trip
+        // (double in slow start, 25% more otherwise) over the RTT.
+        //
+        uint64_t EstimatedWnd;
+        if (Dctcp->CongestionWindow < Dctcp->SlowStartThreshold) {
+            EstimatedWnd = (uint64_t)Dctcp->CongestionWindow << 1;
+            if (EstimatedWnd > Dctcp->SlowStartThreshold) {
+                EstimatedWnd = Dctcp->SlowStartThreshold;
+            }
+        } else {
+            EstimatedWnd = Dctcp->CongestionWindow + (Dctcp->CongestionWindow >> 2); // CongestionWindow * 1.25
+        }
+
+        SendAllowance =
+            Dctcp->LastSendAllowance +
+            (uint32_t)((EstimatedWnd * TimeSinceLastSend) / Connection->Paths[0].SmoothedRtt);
+        if (SendAllowance < Dctcp->LastSendAllowance || // Overflow case
+            SendAllowance > (Dctcp->CongestionWindow - Dctcp->BytesInFlight)) {
+            SendAllowance = Dctcp->CongestionWindow - Dctcp->BytesInFlight;
+        }
+
+        Dctcp->LastSendAllowance = SendAllowance;
+    }
+    return SendAllowance;
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    if (PreviousCanSendState != DctcpCongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+//
+// Reduces the congestion window by Reduction (scaled by QUIC_DCTCP_ALPHA_SCALE)
+// and enters recovery.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlOnCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t Reduction,
+    _In_ BOOLEAN IsPersistentCongestion,
+    _In_ DCTCP_CONGESTION_SIGNAL Signal
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint32_t MinimumWindow =
+        (uint32_t)QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+        QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS;
+    QuicTraceEvent(
+        ConnCongestionV2,
+        "[conn][%p] Congestion event: IsEcn=%hu",
+        Connection,
+        Signal == DCTCP_CONGESTION_SIGNAL_ECN);
+    Connection->Stats.Send.CongestionCount++;
+
+    Dctcp->IsInRecovery = TRUE;
+    Dctcp->HasHadCongestionEvent = TRUE;
+
+    Dctcp->PrevSlowStartThreshold = Dctcp->SlowStartThreshold;
+    Dctcp->PrevCongestionWindow = Dctcp->CongestionWindow;
+
+    CXPLAT_DBG_ASSERT(Reduction <= QUIC_DCTCP_ALPHA_SCALE);
+    const uint32_t ReducedWindow =
+        CXPLAT_MAX(
+            MinimumWindow,
+            (uint32_t)(Dctcp->CongestionWindow -
+                (uint64_t)Dctcp->CongestionWindow * Reduction / QUIC_DCTCP_ALPHA_SCALE));
+
+    if (IsPersistentCongestion && !Dctcp->IsInPersistentCongestion) {
+        QuicTraceEvent(
+            ConnPersistentCongestion,
+            "[conn][%p] Persistent congestion event",
+            Connection);
+        Connection->Stats.Send.PersistentCongestionCount++;
+
+        Connection->Paths[0].Route.State = RouteSuspected; // used only for RAW datapath
+
+        Dctcp->IsInPersistentCongestion = TRUE;
+        Dctcp->SlowStartThreshold = ReducedWindow;
+        Dctcp->CongestionWindow = MinimumWindow;
+    } else {
+        Dctcp->SlowStartThreshold = Dctcp->CongestionWindow = ReducedWindow;
+    }
+    Dctcp->AimdAccumulator = 0;
+
+    //
+    // Only a loss can turn out to be spurious. ECN marks and delay are
+    // measured, so a later spurious loss mustn't undo their reductions.
+    //
+    if (Signal != DCTCP_CONGESTION_SIGNAL_LOSS) {
+        Dctcp->PrevSlowStartThreshold = Dctcp->SlowStartThreshold;
+        Dctcp->PrevCongestionWindow = Dctcp->CongestionWindow;
+    }
+}
+
+//
+// Folds the CE marked fraction of the observation window that just ended into
+// Alpha: Alpha = (1 - g) * Alpha + g * F.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlUpdateAlpha(
+    _In_ QUIC_CONGESTION_CONTROL_DCTCP* Dctcp
+    )
+{
+    if (Dctcp->AckedPacketsInWindow == 0) {
+        return;
+    }
+
+    const uint32_t CePackets =
+        CXPLAT_MIN(Dctcp->CePacketsInWindow, Dctcp->AckedPacketsInWindow);
+    const uint32_t Fraction =
+        (uint32_t)((uint64_t)CePackets * QUIC_DCTCP_ALPHA_SCALE / Dctcp->AckedPacketsInWindow);
+    Dctcp->Alpha =
+        ((Dctcp->Alpha << DCTCP_ALPHA_GAIN_SHIFT) - Dctcp->Alpha + Fraction) >>
+            DCTCP_ALPHA_GAIN_SHIFT;
+
+    Dctcp->AckedPacketsInWindow = 0;
+    Dctcp->CePacketsInWindow = 0;
+}
+
+//
+// Returns TRUE if the window was reduced because the delay is above target.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlOnDelaySample(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    uint64_t Delay;
+    if (AckEvent->OneWayDelay != 0) {
+        Delay = AckEvent->OneWayDelay;
+    } else if (AckEvent->MinRttValid) {
+        Delay = AckEvent->MinRtt;
+    } else {
+        return FALSE;
+    }
+
+    if (!Dctcp->BaseDelayValid || Delay < Dctcp->BaseDelay) {
+        Dctcp->BaseDelay = Delay;
+        Dctcp->BaseDelayValid = TRUE;
+        return FALSE;
+    }
+
+    const uint64_t Target =
+        Dctcp->BaseDelay +
+        CXPLAT_MAX(DCTCP_MIN_TARGET_QUEUE_DELAY_US, Dctcp->BaseDelay >> 2);
+    if (Delay <= Target) {
+        return FALSE;
+    }
+
+    const uint32_t Reduction =
+        (uint32_t)CXPLAT_MIN(
+            DCTCP_DELAY_MAX_REDUCTION,
+            DCTCP_DELAY_BETA * (Delay - Target) / Delay);
+
+    Dctcp->RecoverySentPacketNumber = AckEvent->LargestSentPacketNumber;
+    DctcpCongestionControlOnCongestionEvent(
+        Cc, Reduction, FALSE, DCTCP_CONGESTION_SIGNAL_DELAY);
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+DctcpCongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    BOOLEAN PreviousCanSendState = QuicCongestionControlCanSend(Cc);
+
+    Dctcp->BytesInFlight += NumRetransmittableBytes;
+    if (Dctcp->BytesInFlightMax < Dctcp->BytesInFlight) {
+        Dctcp->BytesInFlightMax = Dctcp->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (NumRetransmittableBytes > Dctcp->LastSendAllowance) {
+        Dctcp->LastSendAllowance = 0;
+    } else {
+        Dctcp->LastSendAllowance -= NumRetransmittableBytes;
+    }
+
+    if (Dctcp->Exemptions > 0) {
+        --Dctcp->Exemptions;
+    }
+
+    DctcpCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    BOOLEAN PreviousCanSendState = DctcpCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Dctcp->BytesInFlight >= NumRetransmittableBytes);
+    Dctcp->BytesInFlight -= NumRetransmittableBytes;
+
+    return DctcpCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlGetNetworkStatistics(
+    _In_ const QUIC_CONNECTION* const Connection,
+    _In_ const QUIC_CONGESTION_CONTROL* const Cc,
+    _Out_ QUIC_NETWORK_STATISTICS* NetworkStatistics
+    )
+{
+    const QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    NetworkStatistics->BytesInFlight = Dctcp->BytesInFlight;
+    NetworkStatistics->PostedBytes = Connection->SendBuffer.PostedBytes;
+    NetworkStatistics->IdealBytes = Connection->SendBuffer.IdealBytes;
+    NetworkStatistics->SmoothedRTT = Path->SmoothedRtt;
+    NetworkStatistics->CongestionWindow = Dctcp->CongestionWindow;
+    NetworkStatistics->Bandwidth = Path->SmoothedRtt == 0 ? 0 : Dctcp->CongestionWindow / Path->SmoothedRtt;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = DctcpCongestionControlCanSend(Cc);
+    uint32_t BytesAcked = AckEvent->NumRetransmittableBytes;
+
+    CXPLAT_DBG_ASSERT(Dctcp->BytesInFlight >= BytesAcked);
+    Dctcp->BytesInFlight -= BytesAcked;
+
+    if (!AckEvent->IsImplicit) {
+        //
+        // The peer's CE counts cover all ECT marked packets, including the
+        // ones that don't count towards bytes in flight, so count all of them.
+        //
+        for (const QUIC_SENT_PACKET_METADATA* Packet = AckEvent->AckedPackets;
+            Packet != NULL;
+            Packet = Packet->Next) {
+            Dctcp->AckedPacketsInWindow++;
+        }
+        if (AckEvent->LargestAck >= Dctcp->AlphaWindowEnd) {
+            DctcpCongestionControlUpdateAlpha(Dctcp);
+            Dctcp->AlphaWindowEnd = Connection->Send.NextPacketNumber;
+        }
+    }
+
+    if (Dctcp->IsInRecovery) {
+        if (AckEvent->LargestAck > Dctcp->RecoverySentPacketNumber) {
+            QuicTraceEvent(
+                ConnRecoveryExit,
+                "[conn][%p] Recovery complete",
+                Connection);
+            Dctcp->IsInRecovery = FALSE;
+            Dctcp->IsInPersistentCongestion = FALSE;
+        }
+        goto Exit;
+    } else if (BytesAcked == 0) {
+        goto Exit;
+    }
+
+    if (DctcpCongestionControlOnDelaySample(Cc, AckEvent)) {
+        goto Exit;
+    }
+
+    if (Dctcp->CongestionWindow < Dctcp->SlowStartThreshold) {
+
+        //
+        // Slow Start
+        //
+
+        Dctcp->CongestionWindow += BytesAcked;
+        BytesAcked = 0;
+        if (Dctcp->CongestionWindow >= Dctcp->SlowStartThreshold) {
+            //
+            // Treat the bytes that took the window past SlowStartThreshold as
+            // if they were acknowledged during Congestion Avoidance below.
+            //
+            BytesAcked = Dctcp->CongestionWindow - Dctcp->SlowStartThreshold;
+            Dctcp->CongestionWindow = Dctcp->SlowStartThreshold;
+        }
+    }
+
+    if (BytesAcked > 0) {
+
+        //
+        // Congestion Avoidance: grow by one datagram per window of ACKed bytes.
+        //
+
+        Dctcp->AimdAccumulator += BytesAcked;
+        if (Dctcp->AimdAccumulator >= Dctcp->CongestionWindow) {
+            Dctcp->AimdAccumulator -= Dctcp->CongestionWindow;
+            Dctcp->CongestionWindow +=
+                QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+        }
+    }
+
+    //
+    // Limit the growth of the window based on the number of bytes we
+    // actually manage to put on the wire (see cubic.c).
+    //
+    if (Dctcp->CongestionWindow > 2 * Dctcp->BytesInFlightMax) {
+        Dctcp->CongestionWindow = 2 * Dctcp->BytesInFlightMax;
+    }
+
+Exit:
+
+    if (Connection->Settings.NetStatsEventEnabled) {
+        QUIC_CONNECTION_EVENT Event;
+        Event.Type = QUIC_CONNECTION_EVENT_NETWORK_STATISTICS;
+        DctcpCongestionControlGetNetworkStatistics(
+            Connection, Cc, &Event.NETWORK_STATISTICS);
+
+        QuicTraceLogConnVerbose(
+           IndicateDataAcked,
+           Connection,
+           "Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]",
+           Event.NETWORK_STATISTICS.BytesInFlight,
+           Event.NETWORK_STATISTICS.PostedBytes,
+           Event.NETWORK_STATISTICS.IdealBytes,
+           Event.NETWORK_STATISTICS.SmoothedRTT,
+           Event.NETWORK_STATISTICS.CongestionWindow,
+           Event.NETWORK_STATISTICS.Bandwidth);
+        QuicConnIndicateEvent(Connection, &Event);
+    }
+
+    return DctcpCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    BOOLEAN PreviousCanSendState = DctcpCongestionControlCanSend(Cc);
+
+    if (!Dctcp->HasHadCongestionEvent ||
+        LossEvent->LargestPacketNumberLost > Dctcp->RecoverySentPacketNumber) {
+
+        Dctcp->RecoverySentPacketNumber = LossEvent->LargestSentPacketNumber;
+        DctcpCongestionControlOnCongestionEvent(
+            Cc,
+            DCTCP_LOSS_REDUCTION,
+            LossEvent->PersistentCongestion,
+            DCTCP_CONGESTION_SIGNAL_LOSS);
+    }
+
+    CXPLAT_DBG_ASSERT(Dctcp->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Dctcp->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    DctcpCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogDctcp(QuicCongestionControlGetConnection(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    BOOLEAN PreviousCanSendState = DctcpCongestionControlCanSend(Cc);
+
+    Dctcp->CePacketsInWindow += EcnEvent->NumCePackets;
+
+    //
+    // React at most once per window, by the estimated extent of congestion.
+    //
+    if (!Dctcp->HasHadCongestionEvent ||
+        EcnEvent->LargestPacketNumberAcked > Dctcp->RecoverySentPacketNumber) {
+
+        Dctcp->RecoverySentPacketNumber = EcnEvent->LargestSentPacketNumber;
+        QuicCongestionControlGetConnection(Cc)->Stats.Send.EcnCongestionCount++;
+        DctcpCongestionControlOnCongestionEvent(
+            Cc,
+            Dctcp->Alpha / 2,
+            FALSE,
+            DCTCP_CONGESTION_SIGNAL_ECN);
+    }
+
+    DctcpCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogDctcp(QuicCongestionControlGetConnection(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    if (!Dctcp->IsInRecovery) {
+        return FALSE;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = QuicCongestionControlCanSend(Cc);
+
+    QuicTraceEvent(
+        ConnSpuriousCongestion,
+        "[conn][%p] Spurious congestion event",
+        Connection);
+
+    Dctcp->SlowStartThreshold = Dctcp->PrevSlowStartThreshold;
+    Dctcp->CongestionWindow = Dctcp->PrevCongestionWindow;
+
+    Dctcp->IsInRecovery = FALSE;
+    Dctcp->HasHadCongestionEvent = FALSE;
+
+    BOOLEAN Result = DctcpCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogDctcp(Connection);
+    return Result;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlSetCarefulResumeWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow,
+    _In_ BOOLEAN IsRetreat
+    )
+{
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = DctcpCongestionControlCanSend(Cc);
+
+    if (!IsRetreat) {
+        if (Dctcp->HasHadCongestionEvent ||
+            CongestionWindow <= Dctcp->CongestionWindow) {
+            return FALSE;
+        }
+        Dctcp->CongestionWindow = CongestionWindow;
+        Dctcp->BytesInFlightMax =
+            CXPLAT_MAX(Dctcp->BytesInFlightMax, CongestionWindow / 2);
+
+    } else {
+        const uint32_t MinimumWindow =
+            (uint32_t)QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+            QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS;
+        CongestionWindow = CXPLAT_MAX(CongestionWindow, MinimumWindow);
+        if (CongestionWindow >= Dctcp->CongestionWindow) {
+            return FALSE;
+        }
+        Dctcp->SlowStartThreshold = Dctcp->CongestionWindow = CongestionWindow;
+        Dctcp->AimdAccumulator = 0;
+    }
+
+    BOOLEAN Result = DctcpCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogDctcp(Connection);
+    return Result;
+}
+
+void
+DctcpCongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+
+    QuicTraceEvent(
+        ConnOutFlowStatsV2,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u CWnd=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%llu 1Way=%llu",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Dctcp->BytesInFlight,
+        Dctcp->CongestionWindow,
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0,
+        Path->OneWayDelay);
+}
+
+uint32_t
+DctcpCongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Dctcp.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+DctcpCongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Dctcp.Exemptions;
+}
+
+uint32_t
+DctcpCongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Dctcp.CongestionWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+DctcpCongestionControlIsAppLimited(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlSetAppLimited(
+    _In_ struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlDctcp = {
+    .Name = "DCTCP",
+    .QuicCongestionControlCanSend = DctcpCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = DctcpCongestionControlSetExemption,
+    .QuicCongestionControlReset = DctcpCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = DctcpCongestionControlGetSendAllowance,
+    .QuicCongestionControlOnDataSent = DctcpCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = DctcpCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = DctcpCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = DctcpCongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = DctcpCongestionControlOnEcn,
+    .QuicCongestionControlOnSpuriousCongestionEvent = DctcpCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = DctcpCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = DctcpCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = DctcpCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = DctcpCongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = DctcpCongestionControlSetAppLimited,
+    .QuicCongestionControlGetCongestionWindow = DctcpCongestionControlGetCongestionWindow,
+    .QuicCongestionControlGetNetworkStatistics = DctcpCongestionControlGetNetworkStatistics,
+    .QuicCongestionControlSetCarefulResumeWindow = DctcpCongestionControlSetCarefulResumeWindow
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    *Cc = QuicCongestionControlDctcp;
+
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp = &Cc->Dctcp;
+    Dctcp->InitialWindowPackets = Settings->InitialWindowPackets;
+
+    DctcpCongestionControlReset(Cc, TRUE);
+}
@@ -0,0 +1,107 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Fixed point scale of the DCTCP congestion estimate (Alpha).
+//
+#define QUIC_DCTCP_ALPHA_SCALE 1024
+
+typedef struct QUIC_CONGESTION_CONTROL_DCTCP {
+
+    //
+    // TRUE if we have had at least one congestion event.
+    // If TRUE, RecoverySentPacketNumber is valid.
+    //
+    BOOLEAN HasHadCongestionEvent : 1;
+
+    //
+    // This flag indicates a congestion event occurred and CC is attempting
+    // to recover from it. Further congestion signals for packets sent before
+    // the event are ignored, so the window is reduced at most once per RTT.
+    //
+    BOOLEAN IsInRecovery : 1;
+
+    //
+    // This flag indicates a persistent congestion event occurred and CC is
+    // attempting to recover from it.
+    //
+    BOOLEAN IsInPersistentCongestion : 1;
+
+    //
+    // TRUE if BaseDelay holds a delay sample.
+    //
+    BOOLEAN BaseDelayValid : 1;
+
+    //
+    // The size of the initial congestion window, in packets.
+    //
+    uint32_t InitialWindowPackets;
+
+    uint32_t CongestionWindow; // bytes
+    uint32_t PrevCongestionWindow; // bytes
+    uint32_t SlowStartThreshold; // bytes
+    uint32_t PrevSlowStartThreshold; // bytes
+    uint32_t AimdAccumulator; // bytes
+
+    //
+    // The number of bytes considered to be still in the network.
+    //
+    uint32_t BytesInFlight;
+    uint32_t BytesInFlightMax;
+
+    //
+    // The leftover send allowance from a previous send. Only used when pacing.
+    //
+    uint32_t LastSendAllowance; // bytes
+
+    //
+    // A count of packets which can be sent ignoring CongestionWindow.
+    //
+    uint8_t Exemptions;
+
+    //
+    // The estimated fraction of packets that are CE marked (RFC 8257 'alpha'),
+    // scaled by QUIC_DCTCP_ALPHA_SCALE. Updated once per observation window,
+    // which ends when a packet sent after the window started is acknowledged.
+    //
+    uint32_t Alpha;
+    uint64_t AlphaWindowEnd; // Packet Number
+    uint32_t AckedPacketsInWindow;
+    uint32_t CePacketsInWindow;
+
+    //
+    // The smallest delay seen on the path: the one-way delay of the send path
+    // if the peer supports it, otherwise the RTT. Queueing delay is measured
+    // relative to it.
+    //
+    uint64_t BaseDelay; // microseconds
+
+    //
+    // This variable tracks the largest packet that was outstanding at the time
+    // the last congestion event occurred. An ACK for any packet number greater
+    // than this indicates recovery is over.
+    //
+    uint64_t RecoverySentPacketNumber;
+
+} QUIC_CONGESTION_CONTROL_DCTCP;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+DctcpCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
+
+#if defined(__cplusplus)
+}
+#endif
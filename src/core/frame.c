@@ -261,58 +261,26 @@ QuicAckFrameEncode(
 #define QUIC_MAX_NUMBER_ACK_BLOCKS 0x10000
 
 //
-// Decodes the ACK_FRAME (has packet numbers from largest to smallest) to a
-// QUIC_RANGE format (smallest to largest).
+// Decodes the ACK blocks (from largest to smallest) after the first one into
+// the range, in descending order.
 //
 _Success_(return != FALSE)
+static
 BOOLEAN
-QuicAckFrameDecode(
-    _In_ QUIC_FRAME_TYPE FrameType,
+QuicAckBlocksDecode(
+    _In_ const QUIC_ACK_EX* Frame,
     _In_ uint16_t BufferLength,
     _In_reads_bytes_(BufferLength)
         const uint8_t * const Buffer,
     _Inout_ uint16_t* Offset,
     _Out_ BOOLEAN* InvalidFrame,
-    _Inout_ QUIC_RANGE* AckRanges, // Pre-Initialized by caller
-    _When_(FrameType == QUIC_FRAME_ACK_1, _Out_)
-        QUIC_ACK_ECN_EX* Ecn,
-    _Out_ uint64_t* AckDelay
+    _Inout_ QUIC_RANGE* AckRanges
     )
 {
-    *InvalidFrame = FALSE;
-    CXPLAT_DBG_ASSERT(AckRanges->SubRanges); // Should be pre-initialized.
-
-    //
-    // Decode the ACK frame header.
-    //
-    QUIC_ACK_EX Frame;
-    if (!QuicAckHeaderDecode(BufferLength, Buffer, Offset, &Frame)) {
-        *InvalidFrame = TRUE;
-        return FALSE;
-    }
-
-    //
-    // Insert the largest/first block into the range.
-    //
-
-    uint64_t Largest = Frame.LargestAcknowledged;
-    uint64_t Count = Frame.FirstAckBlock + 1;
+    uint64_t Largest = Frame->LargestAcknowledged;
+    uint64_t Count = Frame->FirstAckBlock + 1;
 
-    BOOLEAN DontCare;
-    if (!QuicRangeAddRange(AckRanges, Largest + 1 - Count, Count, &DontCare)) {
-        return FALSE;
-    }
-
-    if (Frame.AdditionalAckBlockCount >= QUIC_MAX_NUMBER_ACK_BLOCKS) {
-        *InvalidFrame = TRUE;
-        return FALSE;
-    }
-
-    //
-    // Insert all the rest of the blocks (if any) into the range.
-    //
-
-    for (uint32_t i = 0; i < (uint32_t)Frame.AdditionalAckBlockCount; i++) {
+    for (uint32_t i = 0; i < (uint32_t)Frame->AdditionalAckBlockCount; i++) {
 
         if (Count > Largest) {
             *InvalidFrame = TRUE;
@@ -334,24 +302,87 @@ QuicAckFrameDecode(
 
         Largest -= (Block.Gap + 1);
         Count = Block.AckBlock + 1;
-    
+
         if (Count > Largest + 1) {
             *InvalidFrame = TRUE;
             return FALSE;
         }
 
         //
-        // N.B. The efficiency here isn't great because we are always inserting
-        // values less than the current minimum, which requires a complete
-        // memmove of the current array. A circular buffer that allows both
-        // forward and backward growth would fix this.
+        // N.B. The gap always leaves at least one packet number out, so each
+        // block is strictly below (and not adjacent to) the previous one.
         //
-
-        if (!QuicRangeAddRange(AckRanges, Largest - Count + 1, Count, &DontCare)) {
+        if (!QuicRangeAddRangeDescending(AckRanges, Largest - Count + 1, Count)) {
             return FALSE;
         }
     }
 
+    return TRUE;
+}
+
+//
+// Decodes the ACK_FRAME (has packet numbers from largest to smallest) to a
+// QUIC_RANGE format (smallest to largest).
+//
+_Success_(return != FALSE)
+BOOLEAN
+QuicAckFrameDecode(
+    _In_ QUIC_FRAME_TYPE FrameType,
+    _In_ uint16_t BufferLength,
+    _In_reads_bytes_(BufferLength)
+        const uint8_t * const Buffer,
+    _Inout_ uint16_t* Offset,
+    _Out_ BOOLEAN* InvalidFrame,
+    _Inout_ QUIC_RANGE* AckRanges, // Pre-Initialized by caller
+    _When_(FrameType == QUIC_FRAME_ACK_1, _Out_)
+        QUIC_ACK_ECN_EX* Ecn,
+    _Out_ uint64_t* AckDelay
+    )
+{
+    *InvalidFrame = FALSE;
+    CXPLAT_DBG_ASSERT(AckRanges->SubRanges); // Should be pre-initialized.
+    CXPLAT_DBG_ASSERT(QuicRangeSize(AckRanges) == 0); // Should be empty.
+
+    //
+    // Decode the ACK frame header.
+    //
+    QUIC_ACK_EX Frame;
+    if (!QuicAckHeaderDecode(BufferLength, Buffer, Offset, &Frame)) {
+        *InvalidFrame = TRUE;
+        return FALSE;
+    }
+
+    if (Frame.AdditionalAckBlockCount >= QUIC_MAX_NUMBER_ACK_BLOCKS) {
+        *InvalidFrame = TRUE;
+        return FALSE;
+    }
+
+    //
+    // Insert the largest/first block and then all the rest of the blocks (if
+    // any) into the range. The frame has them from largest to smallest, so
+    // they are appended in reverse order and then flipped once, instead of
+    // moving the whole array to insert each one at the front.
+    //
+    if (!QuicRangeAddRangeDescending(
+            AckRanges,
+            Frame.LargestAcknowledged - Frame.FirstAckBlock,
+            Frame.FirstAckBlock + 1)) {
+        return FALSE;
+    }
+
+    BOOLEAN Result =
+        QuicAckBlocksDecode(
+            &Frame,
+            BufferLength,
+            Buffer,
+            Offset,
+            InvalidFrame,
+            AckRanges);
+    QuicRangeEndDescending(AckRanges);
+    if (!Result) {
+        return FALSE;
+    }
+
     *AckDelay = Frame.AckDelay;
 
     if (FrameType == QUIC_FRAME_ACK_1) {
@@ -73,6 +73,7 @@ MsQuicLibraryLoad(
         MsQuicLib.Version[2] = VER_PATCH;
         MsQuicLib.Version[3] = VER_BUILD_ID;
         MsQuicLib.GitHash = VER_GIT_HASH_STR;
+        MsQuicLib.SendZeroCopyThreshold = QUIC_DEFAULT_SEND_ZERO_COPY_THRESHOLD;
     }
 }
 
@@ -765,6 +766,10 @@ MsQuicLibraryUninitialize(
         MsQuicLib.XdpMapConfigCount = 0;
     }
 
+    CxPlatZeroMemory(
+        MsQuicLib.CongestionControlProviders,
+        sizeof(MsQuicLib.CongestionControlProviders));
+
 #ifndef _KERNEL_MODE
     CxPlatWorkerPoolDelete(MsQuicLib.WorkerPool, CXPLAT_WORKER_POOL_REF_LIBRARY);
     MsQuicLib.WorkerPool = NULL;
@@ -900,6 +905,7 @@ QuicLibraryLazyInitialize(
     if (QUIC_FAILED(Status)) {
         goto Exit;
     }
+    MsQuicLib.StatelessResetSipHash = MsQuicLib.Settings.StatelessResetSipHashEnabled;
 
 #ifndef _KERNEL_MODE
     if (MsQuicLib.WorkerPool == NULL) {
@@ -915,6 +921,8 @@ QuicLibraryLazyInitialize(
 
     CXPLAT_DATAPATH_INIT_CONFIG InitConfig = {0};
     InitConfig.EnableDscpOnRecv = MsQuicLib.EnableDscpOnRecv;
+    InitConfig.EnableSendZeroCopy = MsQuicLib.EnableSendZeroCopy;
+    InitConfig.SendZeroCopyThreshold = MsQuicLib.SendZeroCopyThreshold;
     InitConfig.XdpMapConfigs = MsQuicLib.XdpMapConfigs;
     InitConfig.XdpMapConfigCount = MsQuicLib.XdpMapConfigCount;
 
@@ -1418,6 +1426,66 @@ QuicLibrarySetGlobalParam(
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_ENABLED: {
+
+        if (BufferLength != sizeof(BOOLEAN)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (MsQuicLib.LazyInitComplete) {
+            //
+            // The send buffers are registered when the datapath is created.
+            //
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        MsQuicLib.EnableSendZeroCopy = *(BOOLEAN*)Buffer;
+
+        QuicTraceLogInfo(
+            LibrarySendZeroCopyEnabledSet,
+            "[ lib] Setting send zero copy = %u", MsQuicLib.EnableSendZeroCopy);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_THRESHOLD: {
+
+        if (BufferLength != sizeof(uint32_t)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (MsQuicLib.LazyInitComplete) {
+            //
+            // The datapath reads the threshold when it is created.
+            //
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        MsQuicLib.SendZeroCopyThreshold = *(uint32_t*)Buffer;
+
+        QuicTraceLogInfo(
+            LibrarySendZeroCopyThresholdSet,
+            "[ lib] Setting send zero copy threshold = %u", MsQuicLib.SendZeroCopyThreshold);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
     case QUIC_PARAM_GLOBAL_VERSION_NEGOTIATION_ENABLED:
 
         if (Buffer == NULL ||
@@ -1531,6 +1599,51 @@ QuicLibrarySetGlobalParam(
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER: {
+        if (BufferLength != sizeof(QUIC_CONGESTION_CONTROL_PROVIDER) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_CONGESTION_CONTROL_PROVIDER* Provider =
+            (const QUIC_CONGESTION_CONTROL_PROVIDER*)Buffer;
+        if (Provider->Algorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START ||
+            Provider->Algorithm >= QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START +
+                QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_COUNT ||
+            Provider->StateSize > QUIC_CONGESTION_CONTROL_PROVIDER_MAX_STATE_SIZE ||
+            Provider->Name == NULL ||
+            Provider->Initialize == NULL ||
+            Provider->GetCongestionWindow == NULL ||
+            Provider->OnDataAcknowledged == NULL ||
+            Provider->OnDataLost == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        CxPlatLockAcquire(&MsQuicLib.Lock);
+
+        //
+        // Only allowed before any connection can exist, as connections read
+        // the provider table without a lock.
+        //
+        if (MsQuicLib.LazyInitComplete) {
+            CxPlatLockRelease(&MsQuicLib.Lock);
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        MsQuicLib.CongestionControlProviders[
+            Provider->Algorithm - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START] = *Provider;
+        CxPlatLockRelease(&MsQuicLib.Lock);
+
+        QuicTraceLogInfo(
+            LibraryCongestionControlProviderSet,
+            "[ lib] Registered congestion control provider %hu (%s)",
+            Provider->Algorithm,
+            Provider->Name);
+        break;
+    }
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -2852,6 +2965,10 @@ CXPLAT_STATIC_ASSERT(
     CXPLAT_HASH_SHA256_SIZE >= QUIC_STATELESS_RESET_TOKEN_LENGTH,
     "Stateless reset token must be shorter than hash size used");
 
+CXPLAT_STATIC_ASSERT(
+    QUIC_STATELESS_RESET_TOKEN_LENGTH == 16,
+    "Stateless reset token must be the SipHash-128 output size");
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicLibraryGenerateStatelessResetToken(
@@ -2862,6 +2979,18 @@ QuicLibraryGenerateStatelessResetToken(
         uint8_t* ResetToken
     )
 {
+    if (MsQuicLib.StatelessResetSipHash) {
+        //
+        // The SipHash key is only read, so any number of threads can generate
+        // tokens at once without taking the lock.
+        //
+        uint64_t SipKey[2];
+        QuicPartitionGetStatelessResetSipKey(Partition, SipKey);
+        QuicSipHash128(SipKey, CID, MsQuicLib.CidTotalLength, ResetToken);
+        CxPlatSecureZeroMemory(SipKey, sizeof(SipKey));
+        return QUIC_STATUS_SUCCESS;
+    }
+
     uint8_t HashOutput[CXPLAT_HASH_SHA256_SIZE];
     CxPlatLockAcquire(&Partition->ResetTokenLock);
     QUIC_STATUS Status =
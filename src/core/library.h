@@ -91,6 +91,24 @@ typedef struct QUIC_LIBRARY {
     //
     BOOLEAN EnableDscpOnRecv : 1;
 
+    //
+    // Whether the datapath will be initialized with support for zero-copy
+    // sends.
+    //
+    BOOLEAN EnableSendZeroCopy : 1;
+
+    //
+    // The minimum size (in bytes) of a send for the datapath to use zero-copy.
+    //
+    uint32_t SendZeroCopyThreshold;
+
+    //
+    // Whether stateless reset tokens are generated with SipHash. Latched from
+    // the StatelessResetSipHashEnabled setting at lazy initialization, so
+    // that every token for the library's lifetime uses the same PRF.
+    //
+    BOOLEAN StatelessResetSipHash : 1;
+
 #ifdef CxPlatVerifierEnabled
     //
     // The app or driver verifier is globally enabled.
@@ -211,6 +229,16 @@ typedef struct QUIC_LIBRARY {
     const CXPLAT_XDP_MAP_CONFIG* XdpMapConfigs;
     uint32_t XdpMapConfigCount;
 
+    //
+    // Application provided congestion control algorithms, indexed by
+    // Algorithm - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START. Unused slots
+    // have a NULL Initialize callback.
+    // Set via QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER before any
+    // registration, so connections read them without any lock.
+    //
+    QUIC_CONGESTION_CONTROL_PROVIDER
+        CongestionControlProviders[QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_COUNT];
+
     //
     // Datapath instance for the library.
     //
@@ -654,6 +682,27 @@ QuicLibrarySetRetryKeyConfig(
     _In_ const QUIC_STATELESS_RETRY_CONFIG* Config
     );
 
+//
+// Returns the application provided congestion control algorithm registered
+// with the given identifier, if any.
+//
+QUIC_INLINE
+const QUIC_CONGESTION_CONTROL_PROVIDER*
+QuicLibraryGetCongestionControlProvider(
+    _In_ uint16_t Algorithm
+    )
+{
+    if (Algorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START ||
+        Algorithm >= QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START +
+            QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_COUNT) {
+        return NULL;
+    }
+    const QUIC_CONGESTION_CONTROL_PROVIDER* Provider =
+        &MsQuicLib.CongestionControlProviders[
+            Algorithm - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START];
+    return Provider->Initialize != NULL ? Provider : NULL;
+}
+
 #if DEBUG
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -16,19 +16,641 @@ Abstract:
 
 typedef struct QUIC_CACHEALIGN QUIC_PARTITIONED_HASHTABLE {
 
-    CXPLAT_DISPATCH_RW_LOCK RwLock;
-    CXPLAT_HASHTABLE Table;
+    QUIC_LOOKUP_TABLE Table;
 
 } QUIC_PARTITIONED_HASHTABLE;
 
+//
+// The bucket array of a lookup table. The mask lives with the heads so a
+// reader always indexes an array with its own mask.
+//
+typedef struct QUIC_LOOKUP_BUCKETS {
+
+    uint32_t Mask;
+    QUIC_LOOKUP_LINK* Heads[0];
+
+} QUIC_LOOKUP_BUCKETS;
+
+//
+// Open addressing tables keep their entries in groups of slots. Each group has
+// a control word with one byte per slot: QUIC_LOOKUP_CTRL_EMPTY,
+// QUIC_LOOKUP_CTRL_DELETED, or the low 7 bits of the hash of the slot's entry.
+// The rest of the hash picks the first group to probe. The control bytes are
+// only ever handled as a whole word (slot i is bits 8*i to 8*i+7), so a group
+// is matched with a few integer operations on any CPU.
+//
+#define QUIC_LOOKUP_GROUP_SLOTS         8
+#define QUIC_LOOKUP_CTRL_EMPTY          0x80ull
+#define QUIC_LOOKUP_CTRL_DELETED        0xFEull
+#define QUIC_LOOKUP_CTRL_LSBS           0x0101010101010101ull
+#define QUIC_LOOKUP_CTRL_MSBS           0x8080808080808080ull
+
+typedef struct QUIC_LOOKUP_GROUP {
+
+    int64_t Control;
+    QUIC_LOOKUP_LINK* Slots[QUIC_LOOKUP_GROUP_SLOTS];
+
+} QUIC_LOOKUP_GROUP;
+
+typedef struct QUIC_LOOKUP_GROUPS {
+
+    uint32_t Mask;
+    QUIC_LOOKUP_GROUP Groups[0];
+
+} QUIC_LOOKUP_GROUPS;
+
+//
+// Position in a probe of an open addressing table for a hash.
+//
+typedef struct QUIC_LOOKUP_PROBE {
+
+    QUIC_LOOKUP_GROUPS* Groups;
+    uint32_t Hash;
+    uint32_t Group;
+    uint32_t Step;
+    uint64_t Control;
+    uint64_t Matches;
+
+} QUIC_LOOKUP_PROBE;
+
+//
+// Number of readers in each epoch parity, per processor.
+//
+typedef struct QUIC_CACHEALIGN QUIC_LOOKUP_READER {
+
+    long Count[2];
+
+} QUIC_LOOKUP_READER;
+
+//
+// Enters a read-side section on the lookup's hash tables. Nothing reachable
+// from them at this point is freed until the matching QuicLookupReadEnd.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+long*
+QuicLookupReadBegin(
+    _In_ QUIC_LOOKUP* Lookup
+    )
+{
+    QUIC_LOOKUP_READER* Reader =
+        &Lookup->Readers[CxPlatProcCurrentNumber() % CxPlatProcCount()];
+    long* Count;
+
+    while (TRUE) {
+        const long Epoch = QuicReadLongAcquire(&Lookup->Epoch);
+        Count = &Reader->Count[Epoch & 1];
+        InterlockedIncrement(Count);
+        if (QuicReadLongAcquire(&Lookup->Epoch) == Epoch) {
+            break;
+        }
+        //
+        // A writer advanced the epoch in between and may already be past
+        // this slot. Count this reader under the new epoch instead.
+        //
+        InterlockedDecrement(Count);
+    }
+
+    return Count;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicLookupReadEnd(
+    _In_ long* Count
+    )
+{
+    InterlockedDecrement(Count);
+}
+
+//
+// Waits for all readers that might still reach an entry unlinked before this
+// call to leave their read-side sections. Requires the RwLock to be held
+// exclusively, and no move in progress: readers that miss during a move retry
+// without leaving their read-side section until it ends.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupSynchronize(
+    _In_ QUIC_LOOKUP* Lookup
+    )
+{
+    CXPLAT_DBG_ASSERT((Lookup->MoveSequence & 1) == 0);
+    if (Lookup->Readers == NULL) {
+        return; // Never had hash tables, so all readers take the RwLock.
+    }
+
+    const long Parity = (InterlockedIncrement(&Lookup->Epoch) - 1) & 1;
+    for (uint32_t i = 0; i < CxPlatProcCount(); i++) {
+        while (QuicReadLongAcquire(&Lookup->Readers[i].Count[Parity]) != 0) {
+            CxPlatSchedulerYield();
+        }
+    }
+}
+
+//
+// Returns the control word with the high bit set in the byte of each slot
+// whose control byte is Byte. May also flag a slot just above a real match,
+// so every candidate must still be checked against its entry.
+//
+QUIC_INLINE
+uint64_t
+QuicLookupCtrlMatch(
+    _In_ uint64_t Control,
+    _In_ uint64_t Byte
+    )
+{
+    const uint64_t Diff = Control ^ (QUIC_LOOKUP_CTRL_LSBS * Byte);
+    return (Diff - QUIC_LOOKUP_CTRL_LSBS) & ~Diff & QUIC_LOOKUP_CTRL_MSBS;
+}
+
+QUIC_INLINE
+uint64_t
+QuicLookupCtrlMatchEmpty(
+    _In_ uint64_t Control
+    )
+{
+    //
+    // Only EMPTY has the high bit set and bit 1 clear.
+    //
+    return Control & ~(Control << 6) & QUIC_LOOKUP_CTRL_MSBS;
+}
+
+QUIC_INLINE
+uint64_t
+QuicLookupCtrlMatchFree(
+    _In_ uint64_t Control
+    )
+{
+    return Control & QUIC_LOOKUP_CTRL_MSBS; // EMPTY or DELETED
+}
+
+//
+// Returns the slot index of the lowest match.
+//
+QUIC_INLINE
+uint32_t
+QuicLookupCtrlFirst(
+    _In_ uint64_t Matches
+    )
+{
+    CXPLAT_DBG_ASSERT(Matches != 0);
+    const uint64_t Lowest = (Matches & (0 - Matches)) >> 7; // 1 << (8 * Index)
+    return (uint32_t)((Lowest * 0x0001020304050607ull) >> 56);
+}
+
+QUIC_INLINE
+uint64_t
+QuicLookupCtrlByte(
+    _In_ uint64_t Control,
+    _In_ uint32_t Index
+    )
+{
+    return (Control >> (8 * Index)) & 0xFF;
+}
+
+QUIC_INLINE
+uint64_t
+QuicLookupCtrlSetByte(
+    _In_ uint64_t Control,
+    _In_ uint32_t Index,
+    _In_ uint64_t Byte
+    )
+{
+    return (Control & ~(0xFFull << (8 * Index))) | (Byte << (8 * Index));
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
-QuicLookupInsertLocalCid(
+QuicLookupTableInitialize(
+    _Out_ QUIC_LOOKUP_TABLE* Table,
+    _In_ uint32_t BucketCount,
+    _In_ BOOLEAN OpenAddressing
+    )
+{
+    CXPLAT_DBG_ASSERT((BucketCount & (BucketCount - 1)) == 0);
+
+    Table->OpenAddressing = OpenAddressing;
+    Table->NumEntries = 0;
+    Table->Tombstones = 0;
+
+    if (OpenAddressing) {
+        CXPLAT_DBG_ASSERT(BucketCount >= QUIC_LOOKUP_GROUP_SLOTS);
+        const uint32_t GroupCount = BucketCount / QUIC_LOOKUP_GROUP_SLOTS;
+        QUIC_LOOKUP_GROUPS* Groups =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_LOOKUP_GROUPS) + GroupCount * sizeof(QUIC_LOOKUP_GROUP),
+                QUIC_POOL_LOOKUP_BUCKETS);
+        if (Groups == NULL) {
+            return FALSE;
+        }
+
+        Groups->Mask = GroupCount - 1;
+        CxPlatZeroMemory(Groups->Groups, GroupCount * sizeof(QUIC_LOOKUP_GROUP));
+        for (uint32_t i = 0; i < GroupCount; i++) {
+            Groups->Groups[i].Control =
+                (int64_t)(QUIC_LOOKUP_CTRL_LSBS * QUIC_LOOKUP_CTRL_EMPTY);
+        }
+        QuicWritePtrRelease((void**)&Table->Groups, Groups);
+
+        return TRUE;
+    }
+
+    QUIC_LOOKUP_BUCKETS* Buckets =
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_LOOKUP_BUCKETS) + BucketCount * sizeof(QUIC_LOOKUP_LINK*),
+            QUIC_POOL_LOOKUP_BUCKETS);
+    if (Buckets == NULL) {
+        return FALSE;
+    }
+
+    Buckets->Mask = BucketCount - 1;
+    CxPlatZeroMemory(Buckets->Heads, BucketCount * sizeof(QUIC_LOOKUP_LINK*));
+    QuicWritePtrRelease((void**)&Table->Buckets, Buckets);
+
+    return TRUE;
+}
+
+//
+// Frees the table's buckets, once no reader can be looking at them.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupTableUninitialize(
     _In_ QUIC_LOOKUP* Lookup,
-    _In_ uint32_t Hash,
-    _In_ QUIC_CID_HASH_ENTRY* SourceCid,
-    _In_ BOOLEAN UpdateRefCount
-    );
+    _Inout_ QUIC_LOOKUP_TABLE* Table
+    )
+{
+    CXPLAT_DBG_ASSERT(Table->NumEntries == 0);
+    void* Buckets = Table->Buckets; // Or Groups
+    QuicWritePtrRelease((void**)&Table->Buckets, NULL);
+    QuicLookupSynchronize(Lookup);
+    CXPLAT_FREE(Buckets, QUIC_POOL_LOOKUP_BUCKETS);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicLookupLinkPush(
+    _Inout_ QUIC_LOOKUP_LINK** Head,
+    _In_ QUIC_LOOKUP_LINK* Link
+    )
+{
+    QuicWritePtrRelease((void**)&Link->Next, *Head);
+    QuicWritePtrRelease((void**)Head, Link);
+}
+
+//
+// Doubles the number of buckets. Entries change chains while this runs, so
+// it is bracketed by MoveSequence updates (unless the caller already is).
+// Failing to grow only makes the chains longer. Requires the RwLock to be
+// held exclusively.
+//
+// The only caller already in a move is QuicLookupRebalance, which only inserts
+// into tables it hasn't published yet. No reader can have their old buckets,
+// so they are freed right away. Synchronizing there would deadlock with the
+// readers retrying misses until the move ends.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupTableGrow(
+    _In_ QUIC_LOOKUP* Lookup,
+    _Inout_ QUIC_LOOKUP_TABLE* Table
+    )
+{
+    QUIC_LOOKUP_BUCKETS* OldBuckets = Table->Buckets;
+    QUIC_LOOKUP_TABLE NewTable;
+    if (!QuicLookupTableInitialize(&NewTable, (OldBuckets->Mask + 1) * 2, FALSE)) {
+        return;
+    }
+
+    const BOOLEAN Nested = (Lookup->MoveSequence & 1) != 0;
+    if (!Nested) {
+        InterlockedIncrement(&Lookup->MoveSequence);
+    }
+
+    for (uint32_t i = 0; i <= OldBuckets->Mask; i++) {
+        QUIC_LOOKUP_LINK* Link = OldBuckets->Heads[i];
+        while (Link != NULL) {
+            QUIC_LOOKUP_LINK* Next = Link->Next;
+            QuicLookupLinkPush(
+                &NewTable.Buckets->Heads[Link->Hash & NewTable.Buckets->Mask],
+                Link);
+            Link = Next;
+        }
+    }
+    QuicWritePtrRelease((void**)&Table->Buckets, NewTable.Buckets);
+
+    if (!Nested) {
+        InterlockedIncrement(&Lookup->MoveSequence);
+        QuicLookupSynchronize(Lookup);
+    }
+
+    CXPLAT_FREE(OldBuckets, QUIC_POOL_LOOKUP_BUCKETS);
+}
+
+//
+// Puts the entry in the first free slot of its probe sequence. Returns TRUE if
+// that slot held a tombstone. There must be a free slot.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupGroupsPlace(
+    _Inout_ QUIC_LOOKUP_GROUPS* Groups,
+    _In_ QUIC_LOOKUP_LINK* Link
+    )
+{
+    uint32_t Index = (Link->Hash >> 7) & Groups->Mask;
+    for (uint32_t Step = 1; Step <= Groups->Mask + 1; Step++) {
+        QUIC_LOOKUP_GROUP* Group = &Groups->Groups[Index];
+        const uint64_t Control = (uint64_t)Group->Control;
+        const uint64_t Free = QuicLookupCtrlMatchFree(Control);
+        if (Free != 0) {
+            const uint32_t Slot = QuicLookupCtrlFirst(Free);
+            const BOOLEAN WasDeleted =
+                QuicLookupCtrlByte(Control, Slot) == QUIC_LOOKUP_CTRL_DELETED;
+
+            //
+            // The slot must be visible before the control byte that leads
+            // readers to it.
+            //
+            QuicWritePtrRelease((void**)&Group->Slots[Slot], Link);
+            QuicWriteLong64Release(
+                &Group->Control,
+                (int64_t)QuicLookupCtrlSetByte(Control, Slot, Link->Hash & 0x7F));
+            return WasDeleted;
+        }
+        Index = (Index + Step) & Groups->Mask;
+    }
+
+    CXPLAT_FRE_ASSERT(FALSE);
+    return FALSE;
+}
+
+//
+// Moves the entries to a new group array, sized for a load of at most 7/16,
+// which also clears all tombstones. Entries never move within a published
+// array, so readers can keep using the old one until they are done with it.
+// Requires the RwLock to be held exclusively. Like QuicLookupTableGrow, it
+// doesn't synchronize inside a move, where the table isn't published yet.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupGroupsRehash(
+    _In_ QUIC_LOOKUP* Lookup,
+    _Inout_ QUIC_LOOKUP_TABLE* Table
+    )
+{
+    QUIC_LOOKUP_GROUPS* OldGroups = Table->Groups;
+    uint32_t SlotCount = CXPLAT_HASH_MIN_SIZE;
+    while ((Table->NumEntries + 1) * 16 > SlotCount * 7) {
+        SlotCount *= 2;
+    }
+
+    QUIC_LOOKUP_TABLE NewTable;
+    if (!QuicLookupTableInitialize(&NewTable, SlotCount, TRUE)) {
+        return;
+    }
+
+    for (uint32_t i = 0; i <= OldGroups->Mask; i++) {
+        const QUIC_LOOKUP_GROUP* Group = &OldGroups->Groups[i];
+        for (uint32_t Slot = 0; Slot < QUIC_LOOKUP_GROUP_SLOTS; Slot++) {
+            if (Group->Slots[Slot] != NULL) {
+                (void)QuicLookupGroupsPlace(NewTable.Groups, Group->Slots[Slot]);
+            }
+        }
+    }
+    QuicWritePtrRelease((void**)&Table->Groups, NewTable.Groups);
+    Table->Tombstones = 0;
+
+    if ((Lookup->MoveSequence & 1) == 0) {
+        QuicLookupSynchronize(Lookup);
+    }
+    CXPLAT_FREE(OldGroups, QUIC_POOL_LOOKUP_BUCKETS);
+}
+
+//
+// Requires the RwLock to be held exclusively. Only fails for open addressing
+// tables that are full and can't grow.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupTableInsert(
+    _In_ QUIC_LOOKUP* Lookup,
+    _Inout_ QUIC_LOOKUP_TABLE* Table,
+    _Inout_ QUIC_LOOKUP_LINK* Link,
+    _In_ uint32_t Hash
+    )
+{
+    Link->Hash = Hash;
+
+    if (Table->OpenAddressing) {
+        //
+        // Keep at least 1/8 of the slots empty, so misses end quickly.
+        //
+        uint32_t SlotCount = (Table->Groups->Mask + 1) * QUIC_LOOKUP_GROUP_SLOTS;
+        if ((Table->NumEntries + Table->Tombstones + 1) * 8 > SlotCount * 7) {
+            QuicLookupGroupsRehash(Lookup, Table);
+            SlotCount = (Table->Groups->Mask + 1) * QUIC_LOOKUP_GROUP_SLOTS;
+            if (Table->NumEntries == SlotCount) {
+                return FALSE;
+            }
+        }
+        if (QuicLookupGroupsPlace(Table->Groups, Link)) {
+            Table->Tombstones--;
+        }
+        Table->NumEntries++;
+        return TRUE;
+    }
+
+    if (Table->NumEntries > Table->Buckets->Mask) {
+        QuicLookupTableGrow(Lookup, Table);
+    }
+
+    QuicLookupLinkPush(&Table->Buckets->Heads[Hash & Table->Buckets->Mask], Link);
+    Table->NumEntries++;
+    return TRUE;
+}
+
+//
+// Unlinks the entry, leaving its Next intact for any reader still on it.
+// Requires the RwLock to be held exclusively.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupTableRemove(
+    _Inout_ QUIC_LOOKUP_TABLE* Table,
+    _In_ QUIC_LOOKUP_LINK* Link
+    )
+{
+    CXPLAT_DBG_ASSERT(Table->NumEntries != 0);
+
+    if (Table->OpenAddressing) {
+        QUIC_LOOKUP_GROUPS* Groups = Table->Groups;
+        uint32_t Index = (Link->Hash >> 7) & Groups->Mask;
+        for (uint32_t Step = 1; Step <= Groups->Mask + 1; Step++) {
+            QUIC_LOOKUP_GROUP* Group = &Groups->Groups[Index];
+            const uint64_t Control = (uint64_t)Group->Control;
+            uint64_t Matches = QuicLookupCtrlMatch(Control, Link->Hash & 0x7F);
+            while (Matches != 0) {
+                const uint32_t Slot = QuicLookupCtrlFirst(Matches);
+                Matches &= Matches - 1;
+                if (Group->Slots[Slot] != Link) {
+                    continue;
+                }
+
+                //
+                // A group that still has an empty slot never filled up, so
+                // no probe has gone on past it and the slot can be empty
+                // again. Otherwise it must stay in the probe sequence.
+                //
+                uint64_t Byte = QUIC_LOOKUP_CTRL_EMPTY;
+                if (QuicLookupCtrlMatchEmpty(Control) == 0) {
+                    Byte = QUIC_LOOKUP_CTRL_DELETED;
+                    Table->Tombstones++;
+                }
+                QuicWriteLong64Release(
+                    &Group->Control,
+                    (int64_t)QuicLookupCtrlSetByte(Control, Slot, Byte));
+                QuicWritePtrRelease((void**)&Group->Slots[Slot], NULL);
+                Table->NumEntries--;
+                return;
+            }
+            CXPLAT_DBG_ASSERT(QuicLookupCtrlMatchEmpty(Control) == 0);
+            Index = (Index + Step) & Groups->Mask;
+        }
+        CXPLAT_DBG_ASSERT(FALSE);
+        return;
+    }
+
+    QUIC_LOOKUP_LINK** Prev = &Table->Buckets->Heads[Link->Hash & Table->Buckets->Mask];
+    while (*Prev != Link) {
+        CXPLAT_DBG_ASSERT(*Prev != NULL);
+        Prev = &(*Prev)->Next;
+    }
+    QuicWritePtrRelease((void**)Prev, Link->Next);
+    Table->NumEntries--;
+}
+
+//
+// Returns the first entry in the table with the given hash, or NULL. Safe to
+// call without locks inside a read-side section.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+QUIC_LOOKUP_LINK*
+QuicLookupTableNext(
+    _In_opt_ QUIC_LOOKUP_LINK* Link,
+    _In_ uint32_t Hash
+    )
+{
+    while (Link != NULL && Link->Hash != Hash) {
+        Link = QuicReadPtrAcquire((void**)&Link->Next);
+    }
+    return Link;
+}
+
+//
+// Returns the next entry of the probe with the probe's hash, or NULL. Safe to
+// call without locks inside a read-side section.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+QUIC_LOOKUP_LINK*
+QuicLookupProbeNext(
+    _Inout_ QUIC_LOOKUP_PROBE* Probe
+    )
+{
+    while (TRUE) {
+        while (Probe->Matches != 0) {
+            const uint32_t Slot = QuicLookupCtrlFirst(Probe->Matches);
+            Probe->Matches &= Probe->Matches - 1;
+            QUIC_LOOKUP_LINK* Link =
+                QuicReadPtrAcquire(
+                    (void**)&Probe->Groups->Groups[Probe->Group].Slots[Slot]);
+            if (Link != NULL && Link->Hash == Probe->Hash) {
+                return Link;
+            }
+        }
+
+        //
+        // The entry would have been put in this group if it had room, or in
+        // an earlier one.
+        //
+        if (QuicLookupCtrlMatchEmpty(Probe->Control) != 0 ||
+            Probe->Step == Probe->Groups->Mask) {
+            return NULL;
+        }
+
+        Probe->Step++;
+        Probe->Group = (Probe->Group + Probe->Step) & Probe->Groups->Mask;
+        Probe->Control =
+            (uint64_t)QuicReadLong64Acquire(
+                &Probe->Groups->Groups[Probe->Group].Control);
+        Probe->Matches = QuicLookupCtrlMatch(Probe->Control, Probe->Hash & 0x7F);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+QUIC_LOOKUP_LINK*
+QuicLookupProbeFirst(
+    _Out_ QUIC_LOOKUP_PROBE* Probe,
+    _In_ QUIC_LOOKUP_TABLE* Table,
+    _In_ uint32_t Hash
+    )
+{
+    Probe->Groups = QuicReadPtrAcquire((void**)&Table->Groups);
+    if (Probe->Groups == NULL) {
+        return NULL;
+    }
+    Probe->Hash = Hash;
+    Probe->Group = (Hash >> 7) & Probe->Groups->Mask;
+    Probe->Step = 0;
+    Probe->Control =
+        (uint64_t)QuicReadLong64Acquire(&Probe->Groups->Groups[Probe->Group].Control);
+    Probe->Matches = QuicLookupCtrlMatch(Probe->Control, Hash & 0x7F);
+    return QuicLookupProbeNext(Probe);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+QUIC_LOOKUP_LINK*
+QuicLookupTableFirst(
+    _In_ QUIC_LOOKUP_TABLE* Table,
+    _In_ uint32_t Hash
+    )
+{
+    QUIC_LOOKUP_BUCKETS* Buckets = QuicReadPtrAcquire((void**)&Table->Buckets);
+    if (Buckets == NULL) {
+        return NULL;
+    }
+    return
+        QuicLookupTableNext(
+            QuicReadPtrAcquire((void**)&Buckets->Heads[Hash & Buckets->Mask]),
+            Hash);
+}
+
+//
+// Returns the partition's table for the given (server generated) CID.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+QUIC_LOOKUP_TABLE*
+QuicLookupGetTable(
+    _In_ QUIC_PARTITIONED_HASHTABLE* Tables,
+    _In_range_(>, 0) uint16_t PartitionCount,
+    _In_ const uint8_t* const CID
+    )
+{
+    CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
+    uint16_t PartitionIndex;
+    CxPlatCopyMemory(&PartitionIndex, CID + MsQuicLib.CidServerIdLength, 2);
+    PartitionIndex &= MsQuicLib.PartitionMask;
+    PartitionIndex %= PartitionCount;
+    return &Tables[PartitionIndex].Table;
+}
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
@@ -38,6 +660,20 @@ QuicLookupInitialize(
 {
     CxPlatZeroMemory(Lookup, sizeof(QUIC_LOOKUP));
     CxPlatDispatchRwLockInitialize(&Lookup->RwLock);
+    Lookup->OpenAddressing = MsQuicLib.Settings.OpenAddressingLookupEnabled;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupFreeHashTable(
+    _In_ _Post_invalid_ QUIC_PARTITIONED_HASHTABLE* Tables,
+    _In_ uint16_t PartitionCount
+    )
+{
+    for (uint16_t i = 0; i < PartitionCount; i++) {
+        CXPLAT_FREE(Tables[i].Table.Buckets, QUIC_POOL_LOOKUP_BUCKETS);
+    }
+    CXPLAT_FREE(Tables, QUIC_POOL_LOOKUP_HASHTABLE);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -52,68 +688,53 @@ QuicLookupUninitialize(
         CXPLAT_DBG_ASSERT(Lookup->SINGLE.Connection == NULL);
     } else {
         CXPLAT_DBG_ASSERT(Lookup->HASH.Tables != NULL);
+#if DEBUG
         for (uint16_t i = 0; i < Lookup->PartitionCount; i++) {
-            QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[i];
-            CXPLAT_DBG_ASSERT(Table->Table.NumEntries == 0);
-#pragma warning(push)
-#pragma warning(disable:6001)
-            CxPlatHashtableUninitialize(&Table->Table);
-#pragma warning(pop)
-            CxPlatDispatchRwLockUninitialize(&Table->RwLock);
+            CXPLAT_DBG_ASSERT(Lookup->HASH.Tables[i].Table.NumEntries == 0);
         }
-        CXPLAT_FREE(Lookup->HASH.Tables, QUIC_POOL_LOOKUP_HASHTABLE);
+#endif
+        QuicLookupFreeHashTable(Lookup->HASH.Tables, Lookup->PartitionCount);
     }
 
     if (Lookup->MaximizePartitioning) {
-        CXPLAT_DBG_ASSERT(Lookup->RemoteHashTable.NumEntries == 0);
-        CxPlatHashtableUninitialize(&Lookup->RemoteHashTable);
+        QuicLookupTableUninitialize(Lookup, &Lookup->RemoteHashTable);
+    }
+
+    if (Lookup->Readers != NULL) {
+        CXPLAT_FREE(Lookup->Readers, QUIC_POOL_LOOKUP_READERS);
     }
 
     CxPlatDispatchRwLockUninitialize(&Lookup->RwLock);
 }
 
 //
-// Allocates and initializes a new partitioned hash table.
+// Allocates and initializes a new set of partitioned hash tables.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
-BOOLEAN
+QUIC_PARTITIONED_HASHTABLE*
 QuicLookupCreateHashTable(
-    _In_ QUIC_LOOKUP* Lookup,
-    _In_range_(>, 0) uint16_t PartitionCount
+    _In_range_(>, 0) uint16_t PartitionCount,
+    _In_ BOOLEAN OpenAddressing
     )
 {
-    CXPLAT_DBG_ASSERT(Lookup->LookupTable == NULL);
     CXPLAT_FRE_ASSERT(PartitionCount > 0);
 
-    Lookup->HASH.Tables =
+    QUIC_PARTITIONED_HASHTABLE* Tables =
         CXPLAT_ALLOC_NONPAGED(
             sizeof(QUIC_PARTITIONED_HASHTABLE) * PartitionCount,
             QUIC_POOL_LOOKUP_HASHTABLE);
 
-    if (Lookup->HASH.Tables != NULL) {
-
-        uint16_t Cleanup = 0;
-        uint8_t Failed = FALSE;
+    if (Tables != NULL) {
         for (uint16_t i = 0; i < PartitionCount; i++) {
-            if (!CxPlatHashtableInitializeEx(&Lookup->HASH.Tables[i].Table, CXPLAT_HASH_MIN_SIZE)) {
-                Cleanup = i;
-                Failed = TRUE;
-                break;
-            }
-            CxPlatDispatchRwLockInitialize(&Lookup->HASH.Tables[i].RwLock);
-        }
-        if (Failed) {
-            for (uint16_t i = 0; i < Cleanup; i++) {
-                CxPlatHashtableUninitialize(&Lookup->HASH.Tables[i].Table);
+            if (!QuicLookupTableInitialize(
+                    &Tables[i].Table, CXPLAT_HASH_MIN_SIZE, OpenAddressing)) {
+                QuicLookupFreeHashTable(Tables, i);
+                return NULL;
             }
-            CXPLAT_FREE(Lookup->HASH.Tables, QUIC_POOL_LOOKUP_HASHTABLE);
-            Lookup->HASH.Tables = NULL;
-        } else {
-            Lookup->PartitionCount = PartitionCount;
         }
     }
 
-    return Lookup->HASH.Tables != NULL;
+    return Tables;
 }
 
 //
@@ -154,41 +775,61 @@ QuicLookupRebalance(
 
         uint16_t PreviousPartitionCount = Lookup->PartitionCount;
         void* PreviousLookup = Lookup->LookupTable;
-        Lookup->LookupTable = NULL;
 
         CXPLAT_DBG_ASSERT(PartitionCount != 0);
 
-        if (!QuicLookupCreateHashTable(Lookup, PartitionCount)) {
-            Lookup->LookupTable = PreviousLookup;
+        if (Lookup->Readers == NULL) {
+            Lookup->Readers =
+                CXPLAT_ALLOC_NONPAGED(
+                    sizeof(QUIC_LOOKUP_READER) * CxPlatProcCount(),
+                    QUIC_POOL_LOOKUP_READERS);
+            if (Lookup->Readers == NULL) {
+                return FALSE;
+            }
+            CxPlatZeroMemory(
+                Lookup->Readers,
+                sizeof(QUIC_LOOKUP_READER) * CxPlatProcCount());
+        }
+
+        QUIC_PARTITIONED_HASHTABLE* Tables =
+            QuicLookupCreateHashTable(PartitionCount, Lookup->OpenAddressing);
+        if (Tables == NULL) {
             return FALSE;
         }
 
         //
-        // Move the CIDs to the new table.
+        // Move the CIDs to the new tables, then publish them. Readers may
+        // still be walking the old chains while the CIDs move, so any miss in
+        // the meantime is retried.
         //
 
+        InterlockedIncrement(&Lookup->MoveSequence);
+        BOOLEAN Moved = TRUE;
+
         if (PreviousPartitionCount == 0) {
 
             //
             // Only a single connection before. Enumerate all CIDs on the
-            // connection and reinsert them into the new table(s).
+            // connection and insert them into the new table(s).
             //
 
             if (PreviousLookup != NULL) {
                 CXPLAT_SLIST_ENTRY* Entry =
                     ((QUIC_CONNECTION*)PreviousLookup)->SourceCids.Next;
 
-                while (Entry != NULL) {
+                while (Moved && Entry != NULL) {
                     QUIC_CID_HASH_ENTRY *CID =
                         CXPLAT_CONTAINING_RECORD(
                             Entry,
                             QUIC_CID_HASH_ENTRY,
                             Link);
-                    (void)QuicLookupInsertLocalCid(
-                        Lookup,
-                        CxPlatHashSimple(CID->CID.Length, CID->CID.Data),
-                        CID,
-                        FALSE);
+                    Moved =
+                        QuicLookupTableInsert(
+                            Lookup,
+                            QuicLookupGetTable(Tables, PartitionCount, CID->CID.Data),
+                            &CID->Entry,
+                            CxPlatHashSimple(CID->CID.Length, CID->CID.Data));
+                    CID->CID.IsInLookupTable = TRUE;
                     Entry = Entry->Next;
                 }
             }
@@ -196,43 +837,81 @@ QuicLookupRebalance(
         } else {
 
             //
-            // Changes the number of partitioned tables. Remove all the CIDs
-            // from the old tables and insert them into the new tables.
+            // Changes the number of partitioned tables. Move all the CIDs
+            // from the old tables into the new tables.
             //
 
             QUIC_PARTITIONED_HASHTABLE* PreviousTable = PreviousLookup;
-            for (uint16_t i = 0; i < PreviousPartitionCount; i++) {
-                CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-#pragma warning(push)
-#pragma warning(disable:6001)
-                CxPlatHashtableEnumerateBegin(&PreviousTable[i].Table, &Enumerator);
-#pragma warning(pop)
-                while (TRUE) {
-                    CXPLAT_HASHTABLE_ENTRY* Entry =
-                        CxPlatHashtableEnumerateNext(&PreviousTable[i].Table, &Enumerator);
-                    if (Entry == NULL) {
-                        CxPlatHashtableEnumerateEnd(&PreviousTable[i].Table, &Enumerator);
-                        break;
+            for (uint16_t i = 0; Moved && i < PreviousPartitionCount; i++) {
+                if (PreviousTable[i].Table.OpenAddressing) {
+                    //
+                    // The old groups are left as they are, so readers still
+                    // find every CID there until the new tables are published.
+                    //
+                    QUIC_LOOKUP_GROUPS* Groups = PreviousTable[i].Table.Groups;
+                    for (uint32_t j = 0; Moved && j <= Groups->Mask; j++) {
+                        for (uint32_t k = 0; Moved && k < QUIC_LOOKUP_GROUP_SLOTS; k++) {
+                            QUIC_LOOKUP_LINK* Link = Groups->Groups[j].Slots[k];
+                            if (Link != NULL) {
+                                QUIC_CID_HASH_ENTRY *CID =
+                                    CXPLAT_CONTAINING_RECORD(
+                                        Link,
+                                        QUIC_CID_HASH_ENTRY,
+                                        Entry);
+                                Moved =
+                                    QuicLookupTableInsert(
+                                        Lookup,
+                                        QuicLookupGetTable(Tables, PartitionCount, CID->CID.Data),
+                                        Link,
+                                        Link->Hash);
+                            }
+                        }
                     }
-                    CxPlatHashtableRemove(&PreviousTable[i].Table, Entry, NULL);
+                    continue;
+                }
 
-                    QUIC_CID_HASH_ENTRY *CID =
-                        CXPLAT_CONTAINING_RECORD(
-                            Entry,
-                            QUIC_CID_HASH_ENTRY,
-                            Entry);
-                    (void)QuicLookupInsertLocalCid(
-                        Lookup,
-                        CxPlatHashSimple(CID->CID.Length, CID->CID.Data),
-                        CID,
-                        FALSE);
+                QUIC_LOOKUP_BUCKETS* Buckets = PreviousTable[i].Table.Buckets;
+                for (uint32_t j = 0; j <= Buckets->Mask; j++) {
+                    QUIC_LOOKUP_LINK* Link = Buckets->Heads[j];
+                    while (Link != NULL) {
+                        QUIC_LOOKUP_LINK* Next = Link->Next;
+                        QUIC_CID_HASH_ENTRY *CID =
+                            CXPLAT_CONTAINING_RECORD(
+                                Link,
+                                QUIC_CID_HASH_ENTRY,
+                                Entry);
+                        (void)QuicLookupTableInsert( // Chaining can't fail.
+                            Lookup,
+                            QuicLookupGetTable(Tables, PartitionCount, CID->CID.Data),
+                            Link,
+                            Link->Hash);
+                        Link = Next;
+                    }
                 }
-#pragma warning(push)
-#pragma warning(disable:6001)
-                CxPlatHashtableUninitialize(&PreviousTable[i].Table);
-#pragma warning(pop)
             }
-            CXPLAT_FREE(PreviousTable, QUIC_POOL_LOOKUP_HASHTABLE);
+        }
+
+        if (!Moved) {
+            //
+            // Only open addressing tables can fail an insert, and those
+            // leave the previous lookup as it was.
+            //
+            InterlockedIncrement(&Lookup->MoveSequence);
+            QuicLookupFreeHashTable(Tables, PartitionCount);
+            return FALSE;
+        }
+
+        //
+        // Readers load the count before the tables, so the tables must be
+        // visible first.
+        //
+        QuicWritePtrRelease((void**)&Lookup->HASH.Tables, Tables);
+        QuicWriteUShortRelease(&Lookup->PartitionCount, PartitionCount);
+        InterlockedIncrement(&Lookup->MoveSequence);
+
+        if (PreviousPartitionCount != 0) {
+            QuicLookupSynchronize(Lookup);
+            QuicLookupFreeHashTable(PreviousLookup, PreviousPartitionCount);
         }
     }
 
@@ -251,13 +930,13 @@ QuicLookupMaximizePartitioning(
 
     if (!Lookup->MaximizePartitioning) {
         Result =
-            CxPlatHashtableInitializeEx(
-                &Lookup->RemoteHashTable, CXPLAT_HASH_MIN_SIZE);
+            QuicLookupTableInitialize(
+                &Lookup->RemoteHashTable, CXPLAT_HASH_MIN_SIZE, FALSE);
         if (Result) {
             Lookup->MaximizePartitioning = TRUE;
             Result = QuicLookupRebalance(Lookup, NULL);
             if (!Result) {
-                CxPlatHashtableUninitialize(&Lookup->RemoteHashTable);
+                QuicLookupTableUninitialize(Lookup, &Lookup->RemoteHashTable);
                 Lookup->MaximizePartitioning = FALSE;
             }
         }
@@ -305,16 +984,33 @@ QuicCidMatchConnection(
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_CONNECTION*
 QuicHashLookupConnection(
-    _In_ CXPLAT_HASHTABLE* Table,
+    _In_ QUIC_LOOKUP_TABLE* Table,
     _In_reads_(Length)
         const uint8_t* const DestCid,
     _In_ uint8_t Length,
     _In_ uint32_t Hash
     )
 {
-    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
-    CXPLAT_HASHTABLE_ENTRY* TableEntry =
-        CxPlatHashtableLookup(Table, Hash, &Context);
+    if (Table->OpenAddressing) {
+        QUIC_LOOKUP_PROBE Probe;
+        QUIC_LOOKUP_LINK* TableEntry = QuicLookupProbeFirst(&Probe, Table, Hash);
+
+        while (TableEntry != NULL) {
+            QUIC_CID_HASH_ENTRY* CIDEntry =
+                CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_CID_HASH_ENTRY, Entry);
+
+            if (CIDEntry->CID.Length == Length &&
+                memcmp(DestCid, CIDEntry->CID.Data, Length) == 0) {
+                return CIDEntry->Connection;
+            }
+
+            TableEntry = QuicLookupProbeNext(&Probe);
+        }
+
+        return NULL;
+    }
+
+    QUIC_LOOKUP_LINK* TableEntry = QuicLookupTableFirst(Table, Hash);
 
     while (TableEntry != NULL) {
         QUIC_CID_HASH_ENTRY* CIDEntry =
@@ -325,12 +1021,18 @@ QuicHashLookupConnection(
             return CIDEntry->Connection;
         }
 
-        TableEntry = CxPlatHashtableLookupNext(Table, &Context);
+        TableEntry =
+            QuicLookupTableNext(
+                QuicReadPtrAcquire((void**)&TableEntry->Next), Hash);
     }
 
     return NULL;
 }
 
+//
+// Requires Lookup->RwLock to be held or, once the lookup has hash tables, a
+// read-side section.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_CONNECTION*
 QuicLookupFindConnectionByLocalCidInternal(
@@ -343,7 +1045,7 @@ QuicLookupFindConnectionByLocalCidInternal(
 {
     QUIC_CONNECTION* Connection = NULL;
 
-    if (Lookup->PartitionCount == 0) {
+    if (QuicReadUShortAcquire(&Lookup->PartitionCount) == 0) {
         //
         // Only a single connection is on this binding. Validate that the
         // destination connection ID matches that connection.
@@ -360,23 +1062,23 @@ QuicLookupFindConnectionByLocalCidInternal(
         //
         // Use the destination connection ID to get the index into the
         // partitioned hash table array, and look up the connection in that
-        // hash table.
+        // hash table. A miss while CIDs were moving between chains is retried.
         //
-        CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
-        uint16_t PartitionIndex;
-        CxPlatCopyMemory(&PartitionIndex, CID + MsQuicLib.CidServerIdLength, 2);
-        PartitionIndex &= MsQuicLib.PartitionMask;
-        PartitionIndex %= Lookup->PartitionCount;
-        QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
-
-        CxPlatDispatchRwLockAcquireShared(&Table->RwLock, PrevIrql);
-        Connection =
-            QuicHashLookupConnection(
-                &Table->Table,
-                CID,
-                CIDLen,
-                Hash);
-        CxPlatDispatchRwLockReleaseShared(&Table->RwLock, PrevIrql);
+        long MoveSequence;
+        do {
+            MoveSequence = QuicReadLongAcquire(&Lookup->MoveSequence);
+            uint16_t PartitionCount = QuicReadUShortAcquire(&Lookup->PartitionCount);
+            QUIC_PARTITIONED_HASHTABLE* Tables =
+                QuicReadPtrAcquire((void**)&Lookup->HASH.Tables);
+            Connection =
+                QuicHashLookupConnection(
+                    QuicLookupGetTable(Tables, PartitionCount, CID),
+                    CID,
+                    CIDLen,
+                    Hash);
+        } while (Connection == NULL &&
+                 ((MoveSequence & 1) ||
+                  MoveSequence != QuicReadLongAcquire(&Lookup->MoveSequence)));
     }
 
 #if QUIC_DEBUG_HASHTABLE_LOOKUP
@@ -400,7 +1102,7 @@ QuicLookupFindConnectionByLocalCidInternal(
 }
 
 //
-// Requires Lookup->RwLock to be held (shared).
+// Requires Lookup->RwLock to be held exclusively or a read-side section.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_CONNECTION*
@@ -413,30 +1115,36 @@ QuicLookupFindConnectionByRemoteHashInternal(
     _In_ uint32_t Hash
     )
 {
-    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
-    CXPLAT_HASHTABLE_ENTRY* TableEntry =
-        CxPlatHashtableLookup(&Lookup->RemoteHashTable, Hash, &Context);
-
-    while (TableEntry != NULL) {
-        QUIC_REMOTE_HASH_ENTRY* Entry =
-            CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_REMOTE_HASH_ENTRY, Entry);
-
-        if (QuicAddrCompare(RemoteAddress, &Entry->RemoteAddress) &&
-            RemoteCidLength == Entry->RemoteCidLength &&
-            memcmp(RemoteCid, Entry->RemoteCid, RemoteCidLength) == 0) {
+    long MoveSequence;
+    do {
+        MoveSequence = QuicReadLongAcquire(&Lookup->MoveSequence);
+        QUIC_LOOKUP_LINK* TableEntry =
+            QuicLookupTableFirst(&Lookup->RemoteHashTable, Hash);
+
+        while (TableEntry != NULL) {
+            QUIC_REMOTE_HASH_ENTRY* Entry =
+                CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_REMOTE_HASH_ENTRY, Entry);
+
+            if (QuicAddrCompare(RemoteAddress, &Entry->RemoteAddress) &&
+                RemoteCidLength == Entry->RemoteCidLength &&
+                memcmp(RemoteCid, Entry->RemoteCid, RemoteCidLength) == 0) {
 #if QUIC_DEBUG_HASHTABLE_LOOKUP
-            QuicTraceLogVerbose(
-                LookupRemoteHashFound,
-                "[look][%p] Lookup RemoteHash=%u found %p",
-                Lookup,
-                Hash,
-                Entry->Connection);
+                QuicTraceLogVerbose(
+                    LookupRemoteHashFound,
+                    "[look][%p] Lookup RemoteHash=%u found %p",
+                    Lookup,
+                    Hash,
+                    Entry->Connection);
 #endif
-            return Entry->Connection;
-        }
+                return Entry->Connection;
+            }
 
-        TableEntry = CxPlatHashtableLookupNext(&Lookup->RemoteHashTable, &Context);
-    }
+            TableEntry =
+                QuicLookupTableNext(
+                    QuicReadPtrAcquire((void**)&TableEntry->Next), Hash);
+        }
+    } while ((MoveSequence & 1) ||
+             MoveSequence != QuicReadLongAcquire(&Lookup->MoveSequence));
 
 #if QUIC_DEBUG_HASHTABLE_LOOKUP
     QuicTraceLogVerbose(
@@ -480,20 +1188,14 @@ QuicLookupInsertLocalCid(
         //
         // Insert the source connection ID into the hash table.
         //
-        CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
-        uint16_t PartitionIndex;
-        CxPlatCopyMemory(&PartitionIndex, SourceCid->CID.Data + MsQuicLib.CidServerIdLength, 2);
-        PartitionIndex &= MsQuicLib.PartitionMask;
-        PartitionIndex %= Lookup->PartitionCount;
-        QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
-
-        CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock, PrevIrql);
-        CxPlatHashtableInsert(
-            &Table->Table,
-            &SourceCid->Entry,
-            Hash,
-            NULL);
-        CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock, PrevIrql);
+        if (!QuicLookupTableInsert(
+                Lookup,
+                QuicLookupGetTable(
+                    Lookup->HASH.Tables, Lookup->PartitionCount, SourceCid->CID.Data),
+                &SourceCid->Entry,
+                Hash)) {
+            return FALSE;
+        }
     }
 
     if (UpdateRefCount) {
@@ -547,11 +1249,11 @@ QuicLookupInsertRemoteHash(
         RemoteCid,
         RemoteCidLength);
 
-    CxPlatHashtableInsert(
+    (void)QuicLookupTableInsert( // Chained, so can't fail.
+        Lookup,
         &Lookup->RemoteHashTable,
         &Entry->Entry,
-        Hash,
-        NULL);
+        Hash);
 
     Connection->RemoteHashEntry = Entry;
 
@@ -575,7 +1277,8 @@ QuicLookupInsertRemoteHash(
 
 //
 // Removes a source connection ID from the lookup table. Requires the
-// Lookup->RwLock to be exlusively held.
+// Lookup->RwLock to be exlusively held. The entry may not be freed, nor its
+// connection reference released, before QuicLookupSynchronize.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
@@ -611,15 +1314,10 @@ QuicLookupRemoveLocalCidInt(
         //
         // Remove the source connection ID from the multi-hash table.
         //
-        CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
-        uint16_t PartitionIndex;
-        CxPlatCopyMemory(&PartitionIndex, SourceCid->CID.Data + MsQuicLib.CidServerIdLength, 2);
-        PartitionIndex &= MsQuicLib.PartitionMask;
-        PartitionIndex %= Lookup->PartitionCount;
-        QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
-        CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock, PrevIrql);
-        CxPlatHashtableRemove(&Table->Table, &SourceCid->Entry, NULL);
-        CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock, PrevIrql);
+        QuicLookupTableRemove(
+            QuicLookupGetTable(
+                Lookup->HASH.Tables, Lookup->PartitionCount, SourceCid->CID.Data),
+            &SourceCid->Entry);
     }
 }
 
@@ -633,21 +1331,45 @@ QuicLookupFindConnectionByLocalCid(
     )
 {
     uint32_t Hash = CxPlatHashSimple(CIDLen, CID);
+    QUIC_CONNECTION* ExistingConnection;
 
-    CxPlatDispatchRwLockAcquireShared(&Lookup->RwLock, PrevIrql);
+    if (QuicReadUShortAcquire(&Lookup->PartitionCount) != 0) {
+        //
+        // The hash tables are read without any lock. The connection can't be
+        // freed before the reference is taken, because the lookup's own
+        // reference isn't released until this reader is done.
+        //
+        long* Reader = QuicLookupReadBegin(Lookup);
 
-    QUIC_CONNECTION* ExistingConnection =
-        QuicLookupFindConnectionByLocalCidInternal(
-            Lookup,
-            CID,
-            CIDLen,
-            Hash);
+        ExistingConnection =
+            QuicLookupFindConnectionByLocalCidInternal(
+                Lookup,
+                CID,
+                CIDLen,
+                Hash);
 
-    if (ExistingConnection != NULL) {
-        QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
-    }
+        if (ExistingConnection != NULL) {
+            QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
+        }
 
-    CxPlatDispatchRwLockReleaseShared(&Lookup->RwLock, PrevIrql);
+        QuicLookupReadEnd(Reader);
+
+    } else {
+        CxPlatDispatchRwLockAcquireShared(&Lookup->RwLock, PrevIrql);
+
+        ExistingConnection =
+            QuicLookupFindConnectionByLocalCidInternal(
+                Lookup,
+                CID,
+                CIDLen,
+                Hash);
+
+        if (ExistingConnection != NULL) {
+            QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
+        }
+
+        CxPlatDispatchRwLockReleaseShared(&Lookup->RwLock, PrevIrql);
+    }
 
     return ExistingConnection;
 }
@@ -664,10 +1386,14 @@ QuicLookupFindConnectionByRemoteHash(
 {
     uint32_t Hash = QuicPacketHash(RemoteAddress, RemoteCidLength, RemoteCid);
 
-    CxPlatDispatchRwLockAcquireShared(&Lookup->RwLock, PrevIrql);
+    //
+    // Remote hashes are only tracked with maximized partitioning, which
+    // always has hash tables. Until then, the remote hash table is empty.
+    //
+    QUIC_CONNECTION* ExistingConnection = NULL;
+    if (QuicReadUShortAcquire(&Lookup->PartitionCount) != 0) {
+        long* Reader = QuicLookupReadBegin(Lookup);
 
-    QUIC_CONNECTION* ExistingConnection;
-    if (Lookup->MaximizePartitioning) {
         ExistingConnection =
             QuicLookupFindConnectionByRemoteHashInternal(
                 Lookup,
@@ -680,12 +1406,9 @@ QuicLookupFindConnectionByRemoteHash(
             QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
         }
 
-    } else {
-        ExistingConnection = NULL;
+        QuicLookupReadEnd(Reader);
     }
 
-    CxPlatDispatchRwLockReleaseShared(&Lookup->RwLock, PrevIrql);
-
     return ExistingConnection;
 }
 
@@ -830,6 +1553,7 @@ QuicLookupRemoveLocalCid(
     QuicLookupRemoveLocalCidInt(Lookup, SourceCid);
     SourceCid->CID.IsInLookupTable = FALSE;
     *Entry = (*Entry)->Next;
+    QuicLookupSynchronize(Lookup);
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
     QuicConnRelease(SourceCid->Connection, QUIC_CONN_REF_LOOKUP_TABLE);
 }
@@ -848,11 +1572,9 @@ QuicLookupRemoveRemoteHash(
 
     CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock, PrevIrql);
     CXPLAT_DBG_ASSERT(Connection->RemoteHashEntry != NULL);
-    CxPlatHashtableRemove(
-        &Lookup->RemoteHashTable,
-        &RemoteHashEntry->Entry,
-        NULL);
+    QuicLookupTableRemove(&Lookup->RemoteHashTable, &RemoteHashEntry->Entry);
     Connection->RemoteHashEntry = NULL;
+    QuicLookupSynchronize(Lookup);
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
 
     CXPLAT_FREE(RemoteHashEntry, QUIC_POOL_REMOTE_HASH);
@@ -869,10 +1591,12 @@ QuicLookupRemoveLocalCids(
     uint8_t ReleaseRefCount = 0;
 
     CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock, PrevIrql);
-    while (Connection->SourceCids.Next != NULL) {
+    for (CXPLAT_SLIST_ENTRY* Entry = Connection->SourceCids.Next;
+        Entry != NULL;
+        Entry = Entry->Next) {
         QUIC_CID_HASH_ENTRY *CID =
             CXPLAT_CONTAINING_RECORD(
-                CxPlatListPopEntry(&Connection->SourceCids),
+                Entry,
                 QUIC_CID_HASH_ENTRY,
                 Link);
         if (CID->CID.IsInLookupTable) {
@@ -880,7 +1604,15 @@ QuicLookupRemoveLocalCids(
             CID->CID.IsInLookupTable = FALSE;
             ReleaseRefCount++;
         }
-        CXPLAT_FREE(CID, QUIC_POOL_CIDHASH);
+    }
+    QuicLookupSynchronize(Lookup);
+    while (Connection->SourceCids.Next != NULL) {
+        CXPLAT_FREE(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListPopEntry(&Connection->SourceCids),
+                QUIC_CID_HASH_ENTRY,
+                Link),
+            QUIC_POOL_CIDHASH);
     }
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
 
@@ -899,6 +1631,7 @@ QuicLookupMoveLocalConnectionIDs(
     )
 {
     CXPLAT_SLIST_ENTRY* Entry = Connection->SourceCids.Next;
+    uint8_t ReleaseRefCount = 0;
 
     CxPlatDispatchRwLockAcquireExclusive(&LookupSrc->RwLock, PrevIrql1);
     while (Entry != NULL) {
@@ -909,12 +1642,23 @@ QuicLookupMoveLocalConnectionIDs(
                 Link);
         if (CID->CID.IsInLookupTable) {
             QuicLookupRemoveLocalCidInt(LookupSrc, CID);
-            QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+            ReleaseRefCount++;
         }
         Entry = Entry->Next;
     }
+
+    //
+    // No reader of the source lookup may still be on the CIDs when they are
+    // linked into the destination's chains.
+    //
+    QuicLookupSynchronize(LookupSrc);
     CxPlatDispatchRwLockReleaseExclusive(&LookupSrc->RwLock, PrevIrql1);
 
+    for (uint8_t i = 0; i < ReleaseRefCount; i++) {
+#pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
+        QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+    }
+
     CxPlatDispatchRwLockAcquireExclusive(&LookupDest->RwLock, PrevIrql2);
 #pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
     Entry = Connection->SourceCids.Next;
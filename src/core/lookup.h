@@ -5,11 +5,39 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_PARTITIONED_HASHTABLE QUIC_PARTITIONED_HASHTABLE;
+typedef struct QUIC_LOOKUP_BUCKETS QUIC_LOOKUP_BUCKETS;
+typedef struct QUIC_LOOKUP_GROUPS QUIC_LOOKUP_GROUPS;
+typedef struct QUIC_LOOKUP_READER QUIC_LOOKUP_READER;
+
+//
+// Hash table that the receive path reads without locks. Writers are
+// serialized by the lookup's RwLock and never free anything a reader might
+// still be looking at until the lookup's readers have moved past it.
+//
+// Entries are either chained off a bucket array or, with OpenAddressing, kept
+// in groups of slots that are probed by comparing a byte of each entry's hash
+// stored inline, so most misses never touch an entry.
+//
+typedef struct QUIC_LOOKUP_TABLE {
+
+    BOOLEAN OpenAddressing;
+    uint32_t NumEntries;
+    uint32_t Tombstones; // Removed slots not yet reclaimed (OpenAddressing).
+    union {
+        QUIC_LOOKUP_BUCKETS* Buckets;
+        QUIC_LOOKUP_GROUPS* Groups;
+    };
+
+} QUIC_LOOKUP_TABLE;
 
 typedef struct QUIC_REMOTE_HASH_ENTRY {
 
-    CXPLAT_HASHTABLE_ENTRY Entry;
+    QUIC_LOOKUP_LINK Entry;
     QUIC_CONNECTION* Connection;
     QUIC_ADDR RemoteAddress;
     uint8_t RemoteCidLength;
@@ -28,16 +56,37 @@ typedef struct QUIC_LOOKUP {
     //
     BOOLEAN MaximizePartitioning;
 
+    //
+    // Use open addressing instead of chaining for the local CID hash tables.
+    // Fixed when the lookup is initialized.
+    //
+    BOOLEAN OpenAddressing;
+
     //
     // Number of connection IDs in the lookup.
     //
     uint32_t CidCount;
 
     //
-    // Lock for accessing the lookup data.
+    // Lock for modifying the lookup data. Readers only take it while a single
+    // connection is bound; the hash tables are read under the reader epoch.
     //
     CXPLAT_DISPATCH_RW_LOCK RwLock;
 
+    //
+    // Reader epoch. Readers count themselves in the per-processor Readers
+    // slot for the current epoch's parity; writers advance the epoch and wait
+    // for the previous parity to drain before freeing removed entries.
+    //
+    long Epoch;
+    QUIC_LOOKUP_READER* Readers;
+
+    //
+    // Odd while entries are being moved between hash chains (table growth or
+    // repartitioning), so a reader can tell a miss might not be real.
+    //
+    long MoveSequence;
+
     //
     // The number of partitions used for lookup tables. Value of 0 (default)
     // indicates only a single connection (may be NULL) is bound.
@@ -67,7 +116,7 @@ typedef struct QUIC_LOOKUP {
     //
     // Remote Hash lookup.
     //
-    CXPLAT_HASHTABLE RemoteHashTable;
+    QUIC_LOOKUP_TABLE RemoteHashTable;
 
 } QUIC_LOOKUP;
 
@@ -200,3 +249,7 @@ QuicLookupMoveLocalConnectionIDs(
     _In_ QUIC_LOOKUP* LookupDest,
     _In_ QUIC_CONNECTION* Connection
     );
+
+#if defined(__cplusplus)
+}
+#endif
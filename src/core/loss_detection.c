@@ -95,23 +95,29 @@ QuicLossValidate(
     )
 {
     uint32_t AckElicitingPackets = 0;
-    QUIC_SENT_PACKET_METADATA** Tail = &LossDetection->SentPackets;
-    while (*Tail) {
-        CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
-        if ((*Tail)->Flags.IsAckEliciting) {
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->SentPackets); i++) {
+        const QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(&LossDetection->SentPackets, i);
+        CXPLAT_DBG_ASSERT(!Packet->Flags.Freed);
+        CXPLAT_DBG_ASSERT(
+            i == 0 ||
+            QuicSentPacketRingGet(&LossDetection->SentPackets, i - 1)->PacketNumber <
+                Packet->PacketNumber);
+        if (Packet->Flags.IsAckEliciting) {
             AckElicitingPackets++;
         }
-        Tail = &((*Tail)->Next);
     }
-    CXPLAT_DBG_ASSERT(Tail == LossDetection->SentPacketsTail);
     CXPLAT_DBG_ASSERT(LossDetection->PacketsInFlight == AckElicitingPackets);
 
-    Tail = &LossDetection->LostPackets;
-    while (*Tail) {
-        CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
-        Tail = &((*Tail)->Next);
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->LostPackets); i++) {
+        const QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(&LossDetection->LostPackets, i);
+        CXPLAT_DBG_ASSERT(!Packet->Flags.Freed);
+        CXPLAT_DBG_ASSERT(
+            i == 0 ||
+            QuicSentPacketRingGet(&LossDetection->LostPackets, i - 1)->PacketNumber <
+                Packet->PacketNumber);
     }
-    CXPLAT_DBG_ASSERT(Tail == LossDetection->LostPacketsTail);
 }
 #else
 #define QuicLossValidate(LossDetection)
@@ -123,10 +129,8 @@ QuicLossDetectionInitialize(
     _Inout_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    LossDetection->SentPackets = NULL;
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-    LossDetection->LostPackets = NULL;
-    LossDetection->LostPacketsTail = &LossDetection->LostPackets;
+    QuicSentPacketRingInitialize(&LossDetection->SentPackets);
+    QuicSentPacketRingInitialize(&LossDetection->LostPackets);
     QuicLossDetectionInitializeInternalState(LossDetection);
 }
 
@@ -138,9 +142,9 @@ QuicLossDetectionUninitialize(
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->SentPackets); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(&LossDetection->SentPackets, i);
 
         if (Packet->Flags.IsAckEliciting) {
             QuicTraceLogVerbose(
@@ -153,9 +157,13 @@ QuicLossDetectionUninitialize(
 
         QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
     }
-    while (LossDetection->LostPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
-        LossDetection->LostPackets = LossDetection->LostPackets->Next;
+    QuicSentPacketRingRemove(
+        &LossDetection->SentPackets, 0, QuicSentPacketRingSize(&LossDetection->SentPackets));
+    QuicSentPacketRingUninitialize(&LossDetection->SentPackets);
+
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->LostPackets); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(&LossDetection->LostPackets, i);
 
         QuicTraceLogVerbose(
             PacketTxLostDiscarded,
@@ -165,6 +173,9 @@ QuicLossDetectionUninitialize(
 
         QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
     }
+    QuicSentPacketRingRemove(
+        &LossDetection->LostPackets, 0, QuicSentPacketRingSize(&LossDetection->LostPackets));
+    QuicSentPacketRingUninitialize(&LossDetection->LostPackets);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -186,19 +197,19 @@ QuicLossDetectionReset(
     // Throw away any outstanding packets.
     //
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
-        QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->SentPackets); i++) {
+        QuicLossDetectionRetransmitFrames(
+            LossDetection, QuicSentPacketRingGet(&LossDetection->SentPackets, i), TRUE);
     }
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
+    QuicSentPacketRingRemove(
+        &LossDetection->SentPackets, 0, QuicSentPacketRingSize(&LossDetection->SentPackets));
 
-    while (LossDetection->LostPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
-        LossDetection->LostPackets = LossDetection->LostPackets->Next;
-        QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->LostPackets); i++) {
+        QuicLossDetectionRetransmitFrames(
+            LossDetection, QuicSentPacketRingGet(&LossDetection->LostPackets, i), TRUE);
     }
-    LossDetection->LostPacketsTail = &LossDetection->LostPackets;
+    QuicSentPacketRingRemove(
+        &LossDetection->LostPackets, 0, QuicSentPacketRingSize(&LossDetection->LostPackets));
 
     QuicLossValidate(LossDetection);
 }
@@ -214,11 +225,14 @@ QuicLossDetectionOldestOutstandingPacket(
     _In_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-    while (Packet != NULL && !Packet->Flags.IsAckEliciting) {
-        Packet = Packet->Next;
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->SentPackets); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(&LossDetection->SentPackets, i);
+        if (Packet->Flags.IsAckEliciting) {
+            return Packet;
+        }
     }
-    return Packet;
+    return NULL;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -425,8 +439,15 @@ QuicLossDetectionOnPacketSent(
     // Add to the outstanding-packet queue.
     //
     SentPacket->Next = NULL;
-    *LossDetection->SentPacketsTail = SentPacket;
-    LossDetection->SentPacketsTail = &SentPacket->Next;
+    if (!QuicSentPacketRingInsert(&LossDetection->SentPackets, SentPacket)) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Sent packet ring",
+            (uint64_t)LossDetection->SentPackets.AllocLength * 2 * sizeof(QUIC_SENT_PACKET_METADATA*));
+        QuicLossDetectionRetransmitFrames(LossDetection, SentPacket, TRUE);
+        return;
+    }
 
     CXPLAT_DBG_ASSERT(
         SentPacket->Flags.KeyType != QUIC_PACKET_KEY_0_RTT ||
@@ -916,9 +937,9 @@ QuicLossDetectionDetectAndHandleLostPackets(
     uint32_t LostRetransmittableBytes = 0;
     QUIC_SENT_PACKET_METADATA* Packet;
 
-    if (LossDetection->LostPackets != NULL) {
+    if (QuicSentPacketRingSize(&LossDetection->LostPackets) != 0) {
         //
-        // Clean out any packets in the LostPackets list that we are pretty
+        // Clean out any packets in the LostPackets set that we are pretty
         // confident will never be acknowledged.
         //
         uint64_t TwoPto =
@@ -926,7 +947,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 LossDetection,
                 &Connection->Paths[0], // TODO - Is this right?
                 2);
-        while ((Packet = LossDetection->LostPackets) != NULL &&
+        while ((Packet = QuicSentPacketRingFirst(&LossDetection->LostPackets)) != NULL &&
                 Packet->PacketNumber < LossDetection->LargestAck &&
                 CxPlatTimeDiff64(Packet->SentTime, TimeNow) > TwoPto) {
             QuicTraceLogVerbose(
@@ -934,17 +955,14 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 "[%c][TX][%llu] Forgetting",
                 PtkConnPre(Connection),
                 Packet->PacketNumber);
-            LossDetection->LostPackets = Packet->Next;
+            QuicSentPacketRingRemove(&LossDetection->LostPackets, 0, 1);
             QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, TRUE);
         }
-        if (LossDetection->LostPackets == NULL) {
-            LossDetection->LostPacketsTail = &LossDetection->LostPackets;
-        }
 
         QuicLossValidate(LossDetection);
     }
 
-    if (LossDetection->SentPackets != NULL) {
+    if (QuicSentPacketRingSize(&LossDetection->SentPackets) != 0) {
         //
         // Remove "suspect" packets inferred lost from out-of-order ACKs.
         // The spec has:
@@ -957,9 +975,9 @@ QuicLossDetectionDetectAndHandleLostPackets(
         uint64_t Rtt = CXPLAT_MAX(Path->SmoothedRtt, Path->LatestRttSample);
         uint64_t TimeReorderThreshold = QUIC_TIME_REORDER_THRESHOLD(Rtt);
         uint64_t LargestLostPacketNumber = 0;
-        QUIC_SENT_PACKET_METADATA* PrevPacket = NULL;
-        Packet = LossDetection->SentPackets;
-        while (Packet != NULL) {
+        uint32_t i = 0;
+        while (i < QuicSentPacketRingSize(&LossDetection->SentPackets)) {
+            Packet = QuicSentPacketRingGet(&LossDetection->SentPackets, i);
 
             BOOLEAN NonretransmittableHandshakePacket =
                 !Packet->Flags.IsAckEliciting &&
@@ -968,8 +986,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 QuicKeyTypeToEncryptLevel(Packet->Flags.KeyType);
 
             if (EncryptLevel > LossDetection->LargestAckEncryptLevel) {
-                PrevPacket = Packet;
-                Packet = Packet->Next;
+                i++;
                 continue;
             }
 
@@ -1020,22 +1037,20 @@ QuicLossDetectionDetectAndHandleLostPackets(
             }
 
             LargestLostPacketNumber = Packet->PacketNumber;
-            if (PrevPacket == NULL) {
-                LossDetection->SentPackets = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            } else {
-                PrevPacket->Next = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            }
+            QuicSentPacketRingRemove(&LossDetection->SentPackets, i, 1);
 
-            *LossDetection->LostPacketsTail = Packet;
-            LossDetection->LostPacketsTail = &Packet->Next;
-            Packet = Packet->Next;
-            *LossDetection->LostPacketsTail = NULL;
+            if (!QuicSentPacketRingInsert(&LossDetection->LostPackets, Packet)) {
+                //
+                // No room to remember the packet; forget it right away. This
+                // only costs the ability to detect a spurious loss.
+                //
+                QuicTraceLogVerbose(
+                    PacketTxForget,
+                    "[%c][TX][%llu] Forgetting",
+                    PtkConnPre(Connection),
+                    Packet->PacketNumber);
+                QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, TRUE);
+            }
         }
 
         QuicLossValidate(LossDetection);
@@ -1058,6 +1073,8 @@ QuicLossDetectionDetectAndHandleLostPackets(
             };
 
             QuicCongestionControlOnDataLost(&Connection->CongestionControl, &LossEvent);
+            QuicConnCarefulResumeOnLoss(Connection, LargestLostPacketNumber);
+            QuicConnUpdateAckFrequency(Connection, TimeNow);
             //
             // Send packets from any previously blocked streams.
             //
@@ -1079,8 +1096,8 @@ QuicLossDetectionDiscardPackets(
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
     QUIC_ENCRYPT_LEVEL EncryptLevel = QuicKeyTypeToEncryptLevel(KeyType);
-    QUIC_SENT_PACKET_METADATA* PrevPacket;
-    QUIC_SENT_PACKET_METADATA* Packet;
+    QUIC_SENT_PACKET_RING* Ring;
+    uint32_t Kept;
     uint32_t AckedRetransmittableBytes = 0;
     uint64_t TimeNow = CxPlatTimeUs64();
 
@@ -1090,24 +1107,12 @@ QuicLossDetectionDiscardPackets(
     // Implicitly ACK all outstanding packets.
     //
 
-    PrevPacket = NULL;
-    Packet = LossDetection->LostPackets;
-    while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
+    Ring = &LossDetection->LostPackets;
+    Kept = 0;
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(Ring); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketRingGet(Ring, i);
 
         if (Packet->Flags.KeyType == KeyType) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->LostPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->LostPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->LostPacketsTail = &LossDetection->LostPackets;
-                }
-            }
-
             QuicTraceLogVerbose(
                 PacketTxAckedImplicit,
                 "[%c][TX][%llu] ACKed (implicit)",
@@ -1124,34 +1129,20 @@ QuicLossDetectionDiscardPackets(
 
             QuicSentPacketPoolReturnPacketMetadata(Packet, Connection);
 
-            Packet = NextPacket;
-
         } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
+            QuicSentPacketRingSet(Ring, Kept++, Packet);
         }
     }
+    QuicSentPacketRingRemove(Ring, Kept, QuicSentPacketRingSize(Ring) - Kept);
 
     QuicLossValidate(LossDetection);
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
+    Ring = &LossDetection->SentPackets;
+    Kept = 0;
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(Ring); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketRingGet(Ring, i);
 
         if (Packet->Flags.KeyType == KeyType) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
-
             QuicTraceLogVerbose(
                 PacketTxAckedImplicit,
                 "[%c][TX][%llu] ACKed (implicit)",
@@ -1173,13 +1164,11 @@ QuicLossDetectionDiscardPackets(
 
             QuicSentPacketPoolReturnPacketMetadata(Packet, Connection);
 
-            Packet = NextPacket;
-
         } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
+            QuicSentPacketRingSet(Ring, Kept++, Packet);
         }
     }
+    QuicSentPacketRingRemove(Ring, Kept, QuicSentPacketRingSize(Ring) - Kept);
 
     QuicLossValidate(LossDetection);
 
@@ -1219,32 +1208,18 @@ QuicLossDetectionOnZeroRttRejected(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
-    QUIC_SENT_PACKET_METADATA* PrevPacket;
-    QUIC_SENT_PACKET_METADATA* Packet;
+    QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+    uint32_t Kept = 0;
     uint32_t CountRetransmittableBytes = 0;
 
     //
     // Marks all the packets as lost so they can be retransmitted immediately.
     //
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(Ring); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketRingGet(Ring, i);
 
         if (Packet->Flags.KeyType == QUIC_PACKET_KEY_0_RTT) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
-
             QuicTraceLogVerbose(
                 PacketTx0RttRejected,
                 "[%c][TX][%llu] Rejected",
@@ -1258,13 +1233,11 @@ QuicLossDetectionOnZeroRttRejected(
 
             QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
 
-            Packet = NextPacket;
-
         } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
+            QuicSentPacketRingSet(Ring, Kept++, Packet);
         }
     }
+    QuicSentPacketRingRemove(Ring, Kept, QuicSentPacketRingSize(Ring) - Kept);
 
     QuicLossValidate(LossDetection);
 
@@ -1307,8 +1280,6 @@ QuicLossDetectionProcessAckBlocks(
 
     *InvalidAckBlock = FALSE;
 
-    QUIC_SENT_PACKET_METADATA** LostPacketsStart = &LossDetection->LostPackets;
-    QUIC_SENT_PACKET_METADATA** SentPacketsStart = &LossDetection->SentPackets;
     QUIC_SENT_PACKET_METADATA* LargestAckedPacket = NULL;
 
     uint32_t i = 0;
@@ -1332,28 +1303,25 @@ QuicLossDetectionProcessAckBlocks(
         }
 
         //
-        // Check to see if any packets in the LostPackets list are acknowledged,
+        // Check to see if any packets in the LostPackets set are acknowledged,
         // which would mean we mistakenly classified those packets as lost.
         //
-        if (*LostPacketsStart != NULL) {
-            QUIC_SENT_PACKET_METADATA* LastLostPacket =
-                CXPLAT_CONTAINING_RECORD(
-                    LossDetection->LostPacketsTail, QUIC_SENT_PACKET_METADATA,
-                    Next);
-            if (LastLostPacket->PacketNumber < AckBlock->Low) {
-                goto CheckSentPackets;
-            }
-            while (*LostPacketsStart && (*LostPacketsStart)->PacketNumber < AckBlock->Low) {
-                LostPacketsStart = &((*LostPacketsStart)->Next);
-            }
-
-            QUIC_SENT_PACKET_METADATA** End = LostPacketsStart;
-            while (*End && (*End)->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
+        QUIC_SENT_PACKET_METADATA* LastLostPacket =
+            QuicSentPacketRingLast(&LossDetection->LostPackets);
+        if (LastLostPacket != NULL && LastLostPacket->PacketNumber >= AckBlock->Low) {
+            QUIC_SENT_PACKET_RING* Ring = &LossDetection->LostPackets;
+            uint32_t Start = QuicSentPacketRingLowerBound(Ring, AckBlock->Low);
+            uint32_t End = Start;
+            while (End < QuicSentPacketRingSize(Ring)) {
+                QUIC_SENT_PACKET_METADATA* LostPacket = QuicSentPacketRingGet(Ring, End);
+                if (LostPacket->PacketNumber > QuicRangeGetHigh(AckBlock)) {
+                    break;
+                }
                 QuicTraceLogVerbose(
                     PacketTxSpuriousLoss,
                     "[%c][TX][%llu] Spurious loss detected",
                     PtkConnPre(Connection),
-                    (*End)->PacketNumber);
+                    LostPacket->PacketNumber);
                 Connection->Stats.Send.SpuriousLostPackets++;
                 QuicPerfCounterDecrement(
                     Connection->Partition, QUIC_PERF_COUNTER_PKTS_SUSPECTED_LOST);
@@ -1362,67 +1330,63 @@ QuicLossDetectionProcessAckBlocks(
                 // because we already told the congestion control module that
                 // this packet left the network.
                 //
-                End = &((*End)->Next);
+                *AckedPacketsTail = LostPacket;
+                AckedPacketsTail = &LostPacket->Next;
+                End++;
             }
 
-            if (LostPacketsStart != End) {
-                *AckedPacketsTail = *LostPacketsStart;
-                AckedPacketsTail = End;
-                *LostPacketsStart = *End;
-                *End = NULL;
-                if (End == LossDetection->LostPacketsTail) {
-                    LossDetection->LostPacketsTail = LostPacketsStart;
-                }
+            if (Start != End) {
+                *AckedPacketsTail = NULL;
+                QuicSentPacketRingRemove(Ring, Start, End - Start);
 
                 QuicLossValidate(LossDetection);
-            }
 
-            if (LossDetection->LostPackets == NULL) {
-                //
-                // All previously considered lost packets were found to be
-                // spuriously lost. Inform congestion control.
-                //
-                if (QuicCongestionControlOnSpuriousCongestionEvent(
-                        &Connection->CongestionControl)) {
+                if (QuicSentPacketRingSize(Ring) == 0) {
                     //
-                    // We were previously blocked and are now unblocked.
+                    // All previously considered lost packets were found to be
+                    // spuriously lost. Inform congestion control.
                     //
-                    QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
+                    if (QuicCongestionControlOnSpuriousCongestionEvent(
+                            &Connection->CongestionControl)) {
+                        //
+                        // We were previously blocked and are now unblocked.
+                        //
+                        QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
+                    }
                 }
             }
         }
 
-CheckSentPackets:
         //
-        // Now find all the acknowledged packets in the SentPackets list.
+        // Now find all the acknowledged packets in the SentPackets set. Since
+        // the set is ordered by packet number, the acknowledged packets are a
+        // contiguous run starting at the first packet not below the block.
         //
-        if (*SentPacketsStart != NULL) {
-            while (*SentPacketsStart && (*SentPacketsStart)->PacketNumber < AckBlock->Low) {
-                SentPacketsStart = &((*SentPacketsStart)->Next);
-            }
-
-            QUIC_SENT_PACKET_METADATA** End = SentPacketsStart;
-            while (*End && (*End)->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
-
-                if ((*End)->Flags.IsAckEliciting) {
+        if (QuicSentPacketRingSize(&LossDetection->SentPackets) != 0) {
+            QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+            uint32_t Start = QuicSentPacketRingLowerBound(Ring, AckBlock->Low);
+            uint32_t End = Start;
+            while (End < QuicSentPacketRingSize(Ring)) {
+                QUIC_SENT_PACKET_METADATA* SentPacket = QuicSentPacketRingGet(Ring, End);
+                if (SentPacket->PacketNumber > QuicRangeGetHigh(AckBlock)) {
+                    break;
+                }
+                if (SentPacket->Flags.IsAckEliciting) {
                     LossDetection->PacketsInFlight--;
-                    AckedRetransmittableBytes += (*End)->PacketLength;
+                    AckedRetransmittableBytes += SentPacket->PacketLength;
                 }
-                LargestAckedPacket = *End;
-                End = &((*End)->Next);
+                LargestAckedPacket = SentPacket;
+                *AckedPacketsTail = SentPacket;
+                AckedPacketsTail = &SentPacket->Next;
+                End++;
             }
 
-            if (SentPacketsStart != End) {
+            if (Start != End) {
                 //
-                // Remove the ACKed packets from the outstanding packet list.
+                // Remove the ACKed packets from the outstanding packet set.
                 //
-                *AckedPacketsTail = *SentPacketsStart;
-                AckedPacketsTail = End;
-                *SentPacketsStart = *End;
-                *End = NULL;
-                if (End == LossDetection->SentPacketsTail) {
-                    LossDetection->SentPacketsTail = SentPacketsStart;
-                }
+                *AckedPacketsTail = NULL;
+                QuicSentPacketRingRemove(Ring, Start, End - Start);
 
                 QuicLossValidate(LossDetection);
             }
@@ -1544,6 +1508,7 @@ CheckSentPackets:
                     Connection->Send.NumPacketsSentWithEct < Ecn->ECT_0_Count) {
                     EcnValidated = FALSE;
                 } else {
+                    const uint64_t NewCePackets = Ecn->CE_Count - Packets->EcnCeCounter;
                     BOOLEAN NewCE = Ecn->CE_Count > Packets->EcnCeCounter;
                     Packets->EcnCeCounter = Ecn->CE_Count;
                     Packets->EcnEctCounter = Ecn->ECT_0_Count;
@@ -1561,6 +1526,7 @@ CheckSentPackets:
                         QUIC_ECN_EVENT EcnEvent = {
                             .LargestPacketNumberAcked = LargestAckedPacketNum,
                             .LargestSentPacketNumber = LossDetection->LargestSentPacketNumber,
+                            .NumCePackets = (uint32_t)NewCePackets,
                         };
                         QuicCongestionControlOnEcn(&Connection->CongestionControl, &EcnEvent);
                     }
@@ -1608,7 +1574,7 @@ CheckSentPackets:
             .SmoothedRtt = Path->SmoothedRtt,
             .MinRtt = MinRtt,
             .OneWayDelay = Path->OneWayDelay,
-            .HasLoss = (LossDetection->LostPackets != NULL),
+            .HasLoss = (QuicSentPacketRingSize(&LossDetection->LostPackets) != 0),
             .AdjustedAckTime = TimeNow - AckDelay,
             .AckedPackets = AckedPackets,
             .NumTotalAckedRetransmittableBytes = LossDetection->TotalBytesAcked,
@@ -1622,6 +1588,18 @@ CheckSentPackets:
             //
             QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
         }
+
+        if (QuicConnCarefulResumeOnAck(
+                Connection,
+                AckEvent.LargestAck,
+                AckEvent.NumRetransmittableBytes)) {
+            //
+            // The window jumped to the resumed value.
+            //
+            QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
+        }
+
+        QuicConnUpdateAckFrequency(Connection, TimeNow);
     }
 
     LossDetection->ProbeCount = 0;
@@ -1769,8 +1747,9 @@ QuicLossDetectionScheduleProbe(
     // Not enough new stream data exists to fill the probing packets. Schedule
     // retransmits if possible.
     //
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
+    for (uint32_t i = 0; i < QuicSentPacketRingSize(&LossDetection->SentPackets); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(&LossDetection->SentPackets, i);
         if (Packet->Flags.IsAckEliciting) {
             QuicTraceLogVerbose(
                 PacketTxProbeRetransmit,
@@ -1789,7 +1768,6 @@ QuicLossDetectionScheduleProbe(
                 return;
             }
         }
-        Packet = Packet->Next;
     }
 
     //
@@ -58,29 +58,27 @@ typedef struct QUIC_LOSS_DETECTION {
     uint64_t TotalBytesSentAtLastAck;
 
     //
-    // N.B.: SentPackets and LostPackets are generally kept in ascending packet
-    // number order, and packets in the LostPackets list generally have smaller
-    // numbers than those in the SentPackets list. The only case this is not
-    // true is during the handshake. Since multiple encryption levels are used
-    // in parallel, higher numbered packets in lower encryption levels can be
-    // "lost" sooner than the higher encryption levels.
+    // N.B.: SentPackets and LostPackets are each kept in ascending packet
+    // number order, and packets in LostPackets generally have smaller numbers
+    // than those in SentPackets. The only case this is not true is during the
+    // handshake. Since multiple encryption levels are used in parallel, higher
+    // numbered packets in lower encryption levels can be "lost" sooner than
+    // the higher encryption levels.
     //
 
     //
     // Outstanding packets.
     //
     uint64_t LargestSentPacketNumber;
-    QUIC_SENT_PACKET_METADATA* SentPackets;
-    QUIC_SENT_PACKET_METADATA** SentPacketsTail;
+    QUIC_SENT_PACKET_RING SentPackets;
 
     //
-    // Lost packets. The purpose of this list is to remember packets a little
+    // Lost packets. The purpose of this set is to remember packets a little
     // while after we decide they are lost, in case we were wrong and the ACK
     // comes in later than expected. For accounting purposes we don't consider
     // these packets to be in the network.
     //
-    QUIC_SENT_PACKET_METADATA* LostPackets;
-    QUIC_SENT_PACKET_METADATA** LostPacketsTail;
+    QUIC_SENT_PACKET_RING LostPackets;
 
     //
     // Number of probes sent.
@@ -33,10 +33,11 @@ QuicOperationQueueInitialize(
     _Inout_ QUIC_OPERATION_QUEUE* OperQ
     )
 {
-    OperQ->ActivelyProcessing = FALSE;
-    CxPlatDispatchLockInitialize(&OperQ->Lock);
+    OperQ->Scheduled = 0;
+    OperQ->PendingHead = NULL;
     CxPlatListInitializeHead(&OperQ->List);
-    OperQ->PriorityTail = &OperQ->List.Flink;
+    CxPlatDispatchLockInitialize(&OperQ->Lock);
+    CxPlatListInitializeHead(&OperQ->PriorityList);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -46,8 +47,9 @@ QuicOperationQueueUninitialize(
     )
 {
     UNREFERENCED_PARAMETER(OperQ);
+    CXPLAT_DBG_ASSERT(OperQ->PendingHead == NULL);
     CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&OperQ->List));
-    CXPLAT_DBG_ASSERT(OperQ->PriorityTail == &OperQ->List.Flink);
+    CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&OperQ->PriorityList));
     CxPlatDispatchLockUninitialize(&OperQ->Lock);
 }
 
@@ -140,6 +142,19 @@ QuicOperationFree(
     CxPlatPoolFree(Oper);
 }
 
+//
+// Marks the queue as scheduled. Returns TRUE if it wasn't already, in which
+// case the caller must get the queue drained.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicOperationQueueSchedule(
+    _In_ QUIC_OPERATION_QUEUE* OperQ
+    )
+{
+    return InterlockedCompareExchange(&OperQ->Scheduled, 1, 0) == 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicOperationEnqueue(
@@ -148,18 +163,23 @@ QuicOperationEnqueue(
     _In_ QUIC_OPERATION* Oper
     )
 {
-    BOOLEAN StartProcessing;
     Oper->QueueTimeUs = CxPlatTimeUs32();
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
 #if DEBUG
     CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
 #endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
-    CxPlatListInsertTail(&OperQ->List, &Oper->Link);
-    CxPlatDispatchLockRelease(&OperQ->Lock);
+    //
+    // Nodes are only ever pushed here and the consumer takes the whole stack
+    // at once, so a simple compare-exchange loop is free of ABA problems.
+    //
+    CXPLAT_LIST_ENTRY* Head;
+    do {
+        Head = (CXPLAT_LIST_ENTRY*)QuicReadPtrNoFence((void**)&OperQ->PendingHead);
+        Oper->Link.Flink = Head;
+    } while (InterlockedCompareExchangePointer(
+                (void* volatile*)&OperQ->PendingHead, &Oper->Link, Head) != Head);
     QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUED, 1);
     QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH, 1);
-    return StartProcessing;
+    return QuicOperationQueueSchedule(OperQ);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -170,19 +190,16 @@ QuicOperationEnqueuePriority(
     _In_ QUIC_OPERATION* Oper
     )
 {
-    BOOLEAN StartProcessing;
     Oper->QueueTimeUs = CxPlatTimeUs32();
     CxPlatDispatchLockAcquire(&OperQ->Lock);
 #if DEBUG
     CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
 #endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
-    CxPlatListInsertTail(*OperQ->PriorityTail, &Oper->Link);
-    OperQ->PriorityTail = &Oper->Link.Flink;
+    CxPlatListInsertTail(&OperQ->PriorityList, &Oper->Link);
     CxPlatDispatchLockRelease(&OperQ->Lock);
     QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUED, 1);
     QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH, 1);
-    return StartProcessing;
+    return QuicOperationQueueSchedule(OperQ);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -193,21 +210,50 @@ QuicOperationEnqueueFront(
     _In_ QUIC_OPERATION* Oper
     )
 {
-    BOOLEAN StartProcessing;
     Oper->QueueTimeUs = CxPlatTimeUs32();
     CxPlatDispatchLockAcquire(&OperQ->Lock);
 #if DEBUG
     CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
 #endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
-    CxPlatListInsertHead(&OperQ->List, &Oper->Link);
-    if (OperQ->PriorityTail == &OperQ->List.Flink) {
-        OperQ->PriorityTail = &Oper->Link.Flink;
-    }
+    CxPlatListInsertHead(&OperQ->PriorityList, &Oper->Link);
     CxPlatDispatchLockRelease(&OperQ->Lock);
     QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUED, 1);
     QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH, 1);
-    return StartProcessing;
+    return QuicOperationQueueSchedule(OperQ);
+}
+
+//
+// Moves everything pushed so far onto the tail of the consumer's list, oldest
+// first.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicOperationQueueTakePending(
+    _In_ QUIC_OPERATION_QUEUE* OperQ
+    )
+{
+    CXPLAT_LIST_ENTRY* Entry =
+        (CXPLAT_LIST_ENTRY*)InterlockedFetchAndClearPointer(
+            (void* volatile*)&OperQ->PendingHead);
+    CXPLAT_LIST_ENTRY* Next = &OperQ->List;
+    while (Entry != NULL) {
+        CXPLAT_LIST_ENTRY* Older = Entry->Flink;
+        CxPlatListInsertTail(Next, Entry); // i.e. insert before Next
+        Next = Entry;
+        Entry = Older;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicOperationQueueIsEmpty(
+    _In_ QUIC_OPERATION_QUEUE* OperQ
+    )
+{
+    return
+        CxPlatListIsEmpty(&OperQ->List) &&
+        QuicReadPtrNoFence((void**)&OperQ->PendingHead) == NULL &&
+        CxPlatListIsEmptyNoFence(&OperQ->PriorityList);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -217,28 +263,44 @@ QuicOperationDequeue(
     _In_ QUIC_PARTITION* Partition
     )
 {
-    QUIC_OPERATION* Oper;
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
-    if (CxPlatListIsEmpty(&OperQ->List)) {
-        OperQ->ActivelyProcessing = FALSE;
-        Oper = NULL;
-    } else {
-        OperQ->ActivelyProcessing = TRUE;
+    if (QuicOperationQueueIsEmpty(OperQ)) {
+        //
+        // Give up the queue, then look again: a producer may have queued
+        // something after the check above and, seeing the queue scheduled,
+        // left it to us. If so, take the queue back unless another producer
+        // already did (and so will get it drained).
+        //
+        InterlockedCompareExchange(&OperQ->Scheduled, 0, 1);
+        if (QuicOperationQueueIsEmpty(OperQ) || !QuicOperationQueueSchedule(OperQ)) {
+            return NULL;
+        }
+    }
+
+    QUIC_OPERATION* Oper = NULL;
+    if (!CxPlatListIsEmptyNoFence(&OperQ->PriorityList)) {
+        CxPlatDispatchLockAcquire(&OperQ->Lock);
+        if (!CxPlatListIsEmpty(&OperQ->PriorityList)) {
+            Oper =
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(&OperQ->PriorityList), QUIC_OPERATION, Link);
+        }
+        CxPlatDispatchLockRelease(&OperQ->Lock);
+    }
+
+    if (Oper == NULL) {
+        if (CxPlatListIsEmpty(&OperQ->List)) {
+            QuicOperationQueueTakePending(OperQ);
+        }
+        CXPLAT_DBG_ASSERT(!CxPlatListIsEmpty(&OperQ->List));
         Oper =
             CXPLAT_CONTAINING_RECORD(
                 CxPlatListRemoveHead(&OperQ->List), QUIC_OPERATION, Link);
+    }
 #if DEBUG
-        Oper->Link.Flink = NULL;
+    Oper->Link.Flink = NULL;
 #endif
-        if (OperQ->PriorityTail == &Oper->Link.Flink) {
-            OperQ->PriorityTail = &OperQ->List.Flink;
-        }
-    }
-    CxPlatDispatchLockRelease(&OperQ->Lock);
 
-    if (Oper != NULL) {
-        QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH, -1);
-    }
+    QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH, -1);
     return Oper;
 }
 
@@ -253,10 +315,11 @@ QuicOperationQueueClear(
     CxPlatListInitializeHead(&OldList);
 
     CxPlatDispatchLockAcquire(&OperQ->Lock);
-    OperQ->ActivelyProcessing = FALSE;
-    CxPlatListMoveItems(&OperQ->List, &OldList);
-    OperQ->PriorityTail = &OperQ->List.Flink;
+    CxPlatListMoveItems(&OperQ->PriorityList, &OldList);
     CxPlatDispatchLockRelease(&OperQ->Lock);
+    QuicOperationQueueTakePending(OperQ);
+    CxPlatListMoveItems(&OperQ->List, &OldList);
+    OperQ->Scheduled = 0;
 
     int64_t OperationsDequeued = 0;
 
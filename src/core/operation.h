@@ -9,6 +9,10 @@
 #include "operation.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_SEND_REQUEST QUIC_SEND_REQUEST;
 
 //
@@ -307,19 +311,36 @@ QuicOperLog(
 //
 // A queue of operations to be executed for a connection.
 //
+// Regular operations are pushed by producers without taking a lock, onto a
+// singly linked stack (through Link.Flink). The consumer takes the whole stack
+// at once and reverses it into a FIFO list only it touches. Priority (and
+// front) operations are rare and go to a separate, locked list that is always
+// drained first.
+//
 typedef struct QUIC_OPERATION_QUEUE {
 
     //
-    // TRUE if the queue is being drained.
+    // Non-zero from the time an operation is queued on an idle queue until
+    // the consumer finds the queue empty again. Whoever sets it is responsible
+    // for getting the queue drained.
     //
-    BOOLEAN ActivelyProcessing;
+    long Scheduled;
 
     //
-    // Queue of pending operations.
+    // Most recently pushed regular operation.
+    //
+    CXPLAT_LIST_ENTRY* volatile PendingHead;
+
+    //
+    // Regular operations in FIFO order. Only accessed by the consumer.
     //
-    CXPLAT_DISPATCH_LOCK Lock;
     CXPLAT_LIST_ENTRY List;
-    CXPLAT_LIST_ENTRY** PriorityTail; // Tail of the priority queue.
+
+    //
+    // Queue of priority operations.
+    //
+    CXPLAT_DISPATCH_LOCK Lock;
+    CXPLAT_LIST_ENTRY PriorityList;
 
 } QUIC_OPERATION_QUEUE;
 
@@ -370,10 +391,7 @@ QuicOperationHasPriority(
     _In_ QUIC_OPERATION_QUEUE* OperQ
     )
 {
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
-    BOOLEAN HasPriorityWork = (&OperQ->List.Flink != OperQ->PriorityTail);
-    CxPlatDispatchLockRelease(&OperQ->Lock);
-    return HasPriorityWork;
+    return !CxPlatListIsEmptyNoFence(&OperQ->PriorityList);
 }
 
 //
@@ -390,8 +408,7 @@ QuicOperationEnqueue(
 
 //
 // Enqueues an operation into the priority part of the queue. Returns TRUE if
-// the priority queue was previously empty and not already being processed. Note
-// that the regular queue might not have been empty.
+// the queue was previously empty and not already being processed.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
@@ -432,3 +449,7 @@ QuicOperationQueueClear(
     _In_ QUIC_OPERATION_QUEUE* OperQ,
     _In_ QUIC_PARTITION* Partition
     );
+
+#if defined(__cplusplus)
+}
+#endif
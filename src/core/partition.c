@@ -31,6 +31,21 @@ QuicPartitionInitialize(
         return Status;
     }
 
+    uint64_t SipKey[2];
+    Status =
+        QuicPartitionDeriveStatelessResetSipKey(
+            ResetHashKey,
+            ResetHashKeyLength,
+            SipKey);
+    if (QUIC_FAILED(Status)) {
+        CxPlatHashFree(Partition->ResetTokenHash);
+        Partition->ResetTokenHash = NULL;
+        return Status;
+    }
+    Partition->ResetTokenSipKey[0] = (int64_t)SipKey[0];
+    Partition->ResetTokenSipKey[1] = (int64_t)SipKey[1];
+    CxPlatSecureZeroMemory(SipKey, sizeof(SipKey));
+
     Partition->Index = Index;
     Partition->Processor = Processor;
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_CONNECTION), QUIC_POOL_CONN, &Partition->ConnectionPool);
@@ -72,6 +87,125 @@ QuicPartitionUninitialize(
     CxPlatLockUninitialize(&Partition->ResetTokenLock);
     CxPlatDispatchLockUninitialize(&Partition->StatelessRetryKeysLock);
     CxPlatHashFree(Partition->ResetTokenHash);
+    CxPlatSecureZeroMemory(Partition->ResetTokenSipKey, sizeof(Partition->ResetTokenSipKey));
+}
+
+//
+// SipHash reads and writes its words little endian, whatever the host.
+//
+QUIC_INLINE
+uint64_t
+QuicSipReadUint64(
+    _In_reads_(Length)
+        const uint8_t* Buffer,
+    _In_ uint32_t Length // At most 8
+    )
+{
+    uint64_t Value = 0;
+    for (uint32_t i = 0; i < Length; ++i) {
+        Value |= (uint64_t)Buffer[i] << (8 * i);
+    }
+    return Value;
+}
+
+QUIC_INLINE
+void
+QuicSipWriteUint64(
+    _In_ uint64_t Value,
+    _Out_writes_all_(8)
+        uint8_t* Buffer
+    )
+{
+    for (uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+        Buffer[i] = (uint8_t)(Value >> (8 * i));
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicPartitionDeriveStatelessResetSipKey(
+    _In_reads_(ResetHashKeyLength)
+        const uint8_t* const ResetHashKey,
+    _In_ uint32_t ResetHashKeyLength,
+    _Out_writes_all_(2)
+        uint64_t* SipKey
+    )
+{
+    //
+    // Use a separate key for SipHash (SP800-108 CTR-HMAC) so that tokens
+    // generated one way never reveal anything about the other.
+    //
+    uint8_t RawKey[2 * sizeof(uint64_t)];
+    QUIC_STATUS Status =
+        CxPlatKbKdfDerive(
+            ResetHashKey,
+            ResetHashKeyLength,
+            "QUIC Stateless Reset SipHash Key",
+            NULL,
+            0,
+            sizeof(RawKey),
+            RawKey);
+    if (QUIC_SUCCEEDED(Status)) {
+        SipKey[0] = QuicSipReadUint64(RawKey, sizeof(uint64_t));
+        SipKey[1] = QuicSipReadUint64(RawKey + sizeof(uint64_t), sizeof(uint64_t));
+    }
+    CxPlatSecureZeroMemory(RawKey, sizeof(RawKey));
+    return Status;
+}
+
+#define QUIC_SIP_ROTL(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+
+#define QUIC_SIP_ROUND(v0, v1, v2, v3) \
+    v0 += v1; v1 = QUIC_SIP_ROTL(v1, 13); v1 ^= v0; v0 = QUIC_SIP_ROTL(v0, 32); \
+    v2 += v3; v3 = QUIC_SIP_ROTL(v3, 16); v3 ^= v2; \
+    v0 += v3; v3 = QUIC_SIP_ROTL(v3, 21); v3 ^= v0; \
+    v2 += v1; v1 = QUIC_SIP_ROTL(v1, 17); v1 ^= v2; v2 = QUIC_SIP_ROTL(v2, 32)
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSipHash128(
+    _In_reads_(2)
+        const uint64_t* Key,
+    _In_reads_(InputLength)
+        const uint8_t* const Input,
+    _In_ uint32_t InputLength,
+    _Out_writes_all_(16)
+        uint8_t* Output
+    )
+{
+    uint64_t v0 = Key[0] ^ 0x736f6d6570736575ull;
+    uint64_t v1 = Key[1] ^ 0x646f72616e646f6dull ^ 0xee;
+    uint64_t v2 = Key[0] ^ 0x6c7967656e657261ull;
+    uint64_t v3 = Key[1] ^ 0x7465646279746573ull;
+
+    const uint32_t BlockLength = InputLength & ~(uint32_t)(sizeof(uint64_t) - 1);
+    for (uint32_t i = 0; i < BlockLength; i += sizeof(uint64_t)) {
+        const uint64_t m = QuicSipReadUint64(Input + i, sizeof(uint64_t));
+        v3 ^= m;
+        QUIC_SIP_ROUND(v0, v1, v2, v3);
+        QUIC_SIP_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    const uint64_t b =
+        ((uint64_t)InputLength << 56) |
+        QuicSipReadUint64(Input + BlockLength, InputLength - BlockLength);
+    v3 ^= b;
+    QUIC_SIP_ROUND(v0, v1, v2, v3);
+    QUIC_SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xee;
+    for (uint32_t i = 0; i < 4; ++i) {
+        QUIC_SIP_ROUND(v0, v1, v2, v3);
+    }
+    QuicSipWriteUint64(v0 ^ v1 ^ v2 ^ v3, Output);
+
+    v1 ^= 0xdd;
+    for (uint32_t i = 0; i < 4; ++i) {
+        QUIC_SIP_ROUND(v0, v1, v2, v3);
+    }
+    QuicSipWriteUint64(v0 ^ v1 ^ v2 ^ v3, Output + sizeof(uint64_t));
 }
 
 //
@@ -73,6 +73,15 @@ typedef struct QUIC_CACHEALIGN QUIC_PARTITION {
     CXPLAT_HASH* ResetTokenHash;
     CXPLAT_LOCK ResetTokenLock;
 
+    //
+    // SipHash key for generating stateless reset tokens without the lock (see
+    // StatelessResetSipHashEnabled). It is only changed under ResetTokenLock,
+    // with the sequence odd while it changes, so that readers retry instead of
+    // using a torn key.
+    //
+    long ResetTokenSipKeySequence;
+    int64_t ResetTokenSipKey[2];
+
     //
     // Two most recent keys used for generating stateless retries.
     //
@@ -143,6 +152,52 @@ QuicPartitionGetStatelessRetryKeyForTimestamp(
     _In_ int64_t Timestamp
     );
 
+//
+// Derives the SipHash key for stateless reset tokens from the reset key.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicPartitionDeriveStatelessResetSipKey(
+    _In_reads_(ResetHashKeyLength)
+        const uint8_t* const ResetHashKey,
+    _In_ uint32_t ResetHashKeyLength,
+    _Out_writes_all_(2)
+        uint64_t* SipKey
+    );
+
+//
+// SipHash-2-4 with a 128-bit output.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSipHash128(
+    _In_reads_(2)
+        const uint64_t* Key,
+    _In_reads_(InputLength)
+        const uint8_t* const Input,
+    _In_ uint32_t InputLength,
+    _Out_writes_all_(16)
+        uint8_t* Output
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicPartitionGetStatelessResetSipKey(
+    _In_ QUIC_PARTITION* Partition,
+    _Out_writes_all_(2)
+        uint64_t* SipKey
+    )
+{
+    long Sequence;
+    do {
+        Sequence = QuicReadLongAcquire(&Partition->ResetTokenSipKeySequence);
+        SipKey[0] = (uint64_t)QuicReadLong64Acquire(&Partition->ResetTokenSipKey[0]);
+        SipKey[1] = (uint64_t)QuicReadLong64Acquire(&Partition->ResetTokenSipKey[1]);
+    } while ((Sequence & 1) ||
+             QuicReadLongAcquire(&Partition->ResetTokenSipKeySequence) != Sequence);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_INLINE
 QUIC_STATUS
@@ -165,10 +220,26 @@ QuicPartitionUpdateStatelessResetKey(
         return Status;
     }
 
+    uint64_t SipKey[2];
+    Status =
+        QuicPartitionDeriveStatelessResetSipKey(
+            ResetHashKey,
+            ResetHashKeyLength,
+            SipKey);
+    if (QUIC_FAILED(Status)) {
+        CxPlatHashFree(NewResetTokenHash);
+        return Status;
+    }
+
     CxPlatLockAcquire(&Partition->ResetTokenLock);
     CxPlatHashFree(Partition->ResetTokenHash);
     Partition->ResetTokenHash = NewResetTokenHash;
+    InterlockedIncrement(&Partition->ResetTokenSipKeySequence);
+    QuicWriteLong64Release(&Partition->ResetTokenSipKey[0], (int64_t)SipKey[0]);
+    QuicWriteLong64Release(&Partition->ResetTokenSipKey[1], (int64_t)SipKey[1]);
+    InterlockedIncrement(&Partition->ResetTokenSipKeySequence);
     CxPlatLockRelease(&Partition->ResetTokenLock);
+    CxPlatSecureZeroMemory(SipKey, sizeof(SipKey));
 
     return QUIC_STATUS_SUCCESS;
 }
@@ -348,6 +348,7 @@ QuicPathSetActive(
 
     if (!UdpPortChangeOnly) {
         QuicCongestionControlReset(&Connection->CongestionControl, FALSE);
+        QuicConnCarefulResumeOnPathChanged(Connection);
     }
     CXPLAT_DBG_ASSERT(Path->DestCid != NULL);
     CXPLAT_DBG_ASSERT(!Path->DestCid->CID.Retired);
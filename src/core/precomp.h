@@ -55,6 +55,8 @@
 #include "operation.h"
 #include "binding.h"
 #include "api.h"
+#include "careful_resume.h"
+#include "ticket_cache.h"
 #include "registration.h"
 #include "configuration.h"
 #include "range.h"
@@ -167,6 +167,16 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MAX_WORKER_QUEUE_DELAY             250
 
+//
+// With worker rebalancing, a worker whose average queue delay is at least
+// QUIC_WORKER_REBALANCE_MIN_DELAY_US may move a busy connection to a worker
+// with less than 1/QUIC_WORKER_REBALANCE_SKEW of its queue delay, at most once
+// every QUIC_WORKER_REBALANCE_INTERVAL_US.
+//
+#define QUIC_WORKER_REBALANCE_MIN_DELAY_US      1000
+#define QUIC_WORKER_REBALANCE_SKEW              4
+#define QUIC_WORKER_REBALANCE_INTERVAL_US       100000 // 100 ms
+
 //
 // The maximum number of simultaneous stateless operations that can be queued on
 // a single worker.
@@ -204,6 +214,14 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_STREAM_SEND_BATCH_COUNT            8
 
+//
+// The credit a stream needs to send one packet under the weighted fair
+// scheduling scheme. A stream earns (SendPriority >> 8) + 1 credits each time
+// it comes up in the round, so a stream at the default priority sends
+// QUIC_STREAM_SEND_BATCH_COUNT packets per round.
+//
+#define QUIC_STREAM_SEND_PACKET_CREDIT          16
+
 //
 // The maximum number of received packets to batch process at a time.
 //
@@ -482,10 +500,24 @@ CXPLAT_STATIC_ASSERT(
 #define CXPLAT_TLS_RESUMPTION_TICKET_MAX_VERSION   CXPLAT_TLS_RESUMPTION_TICKET_VERSION_V2
 
 //
-// Version of the blob for client resumption tickets.
-// This needs to be incremented for each change in order or count of fields.
+// Versions of the blob for client resumption tickets. This needs to be
+// incremented for each change in order or count of fields, or in how a TLS
+// provider encodes its session.
+//   V1 - OpenSSL sessions are PEM encoded.
+//   V2 - OpenSSL sessions are DER encoded.
+//
+#define CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION_V1   1
+#define CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION_V2   2
+
+//
+// Oldest client resumption ticket version that is still accepted.
 //
-#define CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION      1
+#define CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_MIN_VERSION  CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION_V1
+
+//
+// Version of newly encoded client resumption tickets.
+//
+#define CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION      CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION_V2
 
 //
 // By default the Version Negotiation Extension is disabled.
@@ -519,6 +551,40 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DPLPMTUD_INCREMENT                     80
 
+//
+// The maximum number of destinations a registration remembers congestion
+// state for (careful resume).
+//
+#define QUIC_CAREFUL_RESUME_MAX_CACHE_ENTRIES       256
+
+//
+// How long remembered congestion state stays usable, in microseconds.
+//
+#define QUIC_CAREFUL_RESUME_LIFETIME_US             S_TO_US(3600ULL)
+
+//
+// The current RTT must be within [Saved / N, Saved * M] for the remembered
+// congestion window to be used.
+//
+#define QUIC_CAREFUL_RESUME_RTT_LOW_DIVISOR         2
+#define QUIC_CAREFUL_RESUME_RTT_HIGH_MULTIPLIER     10
+
+//
+// The most memory, in bytes, a registration's resumption ticket cache uses.
+//
+#define QUIC_TICKET_CACHE_MAX_BYTES                 (1024 * 1024)
+
+//
+// The most unused resumption tickets kept per server.
+//
+#define QUIC_TICKET_CACHE_MAX_TICKETS_PER_SERVER    4
+
+//
+// How long cached resumption tickets stay usable at most, in microseconds.
+// TLS 1.3 doesn't allow tickets to live longer than 7 days.
+//
+#define QUIC_TICKET_CACHE_MAX_LIFETIME_US           S_TO_US(7 * 24 * 3600ULL)
+
 //
 // The default congestion control algorithm
 //
@@ -564,6 +630,46 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_QTIP_ENABLED                    FALSE
 
+//
+// The default settings for seeding new connections from the congestion state
+// cache (careful resume).
+//
+#define QUIC_DEFAULT_CAREFUL_RESUME_ENABLED          FALSE
+
+//
+// With adaptive ACK frequency, the peer is asked to acknowledge every
+// 1/QUIC_ACK_FREQUENCY_CWND_DIVISOR of the congestion window, and to delay
+// acknowledgments by at most 1/QUIC_ACK_FREQUENCY_RTT_DIVISOR of the RTT.
+//
+#define QUIC_ACK_FREQUENCY_CWND_DIVISOR             4
+#define QUIC_ACK_FREQUENCY_RTT_DIVISOR              4
+
+//
+// The default settings for requesting the peer's ACK frequency based on the
+// congestion window.
+//
+#define QUIC_DEFAULT_ADAPTIVE_ACK_FREQUENCY_ENABLED  FALSE
+
+//
+// The default settings for moving busy connections off overloaded workers.
+//
+#define QUIC_DEFAULT_WORKER_REBALANCING_ENABLED      FALSE
+
+//
+// The default settings for using open addressing CID lookup tables.
+//
+#define QUIC_DEFAULT_OPEN_ADDRESSING_LOOKUP_ENABLED  FALSE
+
+//
+// The default settings for caching client resumption tickets.
+//
+#define QUIC_DEFAULT_RESUMPTION_TICKET_CACHE_ENABLED FALSE
+
+//
+// The default settings for generating stateless reset tokens with SipHash.
+//
+#define QUIC_DEFAULT_STATELESS_RESET_SIPHASH_ENABLED FALSE
+
 //
 // The default settings for allowing One-Way Delay support.
 //
@@ -579,6 +685,15 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_STREAM_MULTI_RECEIVE_ENABLED    FALSE
 
+//
+// The default minimum size (in bytes) of a send for the datapath to use
+// zero-copy, when enabled. Pinning the pages and handling the kernel's
+// completion notification replace the per-byte copy, and the Linux
+// MSG_ZEROCOPY documentation puts the break-even point around 10 KB per
+// write; here, that is a GSO send of eight or more full-sized packets.
+//
+#define QUIC_DEFAULT_SEND_ZERO_COPY_THRESHOLD        10240
+
 //
 // The number of rounds in Cubic Slow Start to sample RTT.
 //
@@ -685,6 +800,12 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_RELIABLE_RESET_ENABLED         "ReliableResetEnabled"
 #define QUIC_SETTING_XDP_ENABLED                    "XdpEnabled"
 #define QUIC_SETTING_QTIP_ENABLED                   "QTIPEnabled"
+#define QUIC_SETTING_CAREFUL_RESUME_ENABLED         "CarefulResumeEnabled"
+#define QUIC_SETTING_ADAPTIVE_ACK_FREQUENCY_ENABLED "AdaptiveAckFrequencyEnabled"
+#define QUIC_SETTING_WORKER_REBALANCING_ENABLED     "WorkerRebalancingEnabled"
+#define QUIC_SETTING_OPEN_ADDRESSING_LOOKUP_ENABLED "OpenAddressingLookupEnabled"
+#define QUIC_SETTING_RESUMPTION_TICKET_CACHE_ENABLED "ResumptionTicketCacheEnabled"
+#define QUIC_SETTING_STATELESS_RESET_SIPHASH_ENABLED "StatelessResetSipHashEnabled"
 #define QUIC_SETTING_ONE_WAY_DELAY_ENABLED          "OneWayDelayEnabled"
 #define QUIC_SETTING_NET_STATS_EVENT_ENABLED        "NetStatsEventEnabled"
 #define QUIC_SETTING_STREAM_MULTI_RECEIVE_ENABLED   "StreamMultiReceiveEnabled"
@@ -387,6 +387,57 @@ QuicRangeAddValue(
     return QuicRangeAddRange(Range, Value, 1, &DontCare) != NULL;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicRangeAddRangeDescending(
+    _Inout_ QUIC_RANGE* Range,
+    _In_ uint64_t Low,
+    _In_ uint64_t Count
+    )
+{
+    CXPLAT_DBG_ASSERT(Count > 0);
+    CXPLAT_DBG_ASSERT(
+        Range->UsedLength == 0 ||
+        Low + Count < QuicRangeGet(Range, Range->UsedLength - 1)->Low);
+
+    if (Range->UsedLength == Range->AllocLength) {
+        //
+        // Unlike QuicRangeMakeSpace, don't age out any values when the range
+        // can't grow, since the smallest values aren't at the front.
+        //
+        if (!QuicRangeGrow(Range, Range->UsedLength)) {
+            return FALSE;
+        }
+    } else {
+        Range->UsedLength++;
+    }
+
+    QUIC_SUBRANGE* Sub = QuicRangeGet(Range, Range->UsedLength - 1);
+    Sub->Low = Low;
+    Sub->Count = Count;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeEndDescending(
+    _Inout_ QUIC_RANGE* Range
+    )
+{
+    if (Range->UsedLength < 2) {
+        return;
+    }
+
+    QUIC_SUBRANGE* Front = Range->SubRanges;
+    QUIC_SUBRANGE* Back = Range->SubRanges + Range->UsedLength - 1;
+    while (Front < Back) {
+        const QUIC_SUBRANGE Temp = *Front;
+        *Front++ = *Back;
+        *Back-- = Temp;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRangeSetMin(
@@ -298,6 +298,34 @@ QuicRangeAddRange(
     _Out_ BOOLEAN* RangeUpdated
     );
 
+//
+// O(1) amortized
+// Adds a range of contiguous values below (and not adjacent to) all the values
+// in the range, for building a range from largest to smallest, as the values
+// are found in an ACK frame. The subranges are kept in reverse order, so that
+// each add is an append instead of a move of the whole array, until
+// QuicRangeEndDescending is called. No other range function may be called in
+// between. Returns FALSE on an allocation failure.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicRangeAddRangeDescending(
+    _Inout_ QUIC_RANGE* Range,
+    _In_ uint64_t Low,
+    _In_ uint64_t Count
+    );
+
+//
+// O(n)
+// Puts the subranges added by QuicRangeAddRangeDescending back in order.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeEndDescending(
+    _Inout_ QUIC_RANGE* Range
+    );
+
 //
 // Removes a number of subranges from the range. Returns TRUE if the list was
 // shrunk (reallocated) because of the removal operation.
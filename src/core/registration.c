@@ -63,6 +63,8 @@ QuicRegistrationClose(
     }
 #endif
     CxPlatRundownUninitialize(&Registration->Rundown);
+    QuicCarefulResumeCacheUninitialize(&Registration->CarefulResumeCache);
+    QuicTicketCacheUninitialize(&Registration->TicketCache);
     CxPlatDispatchLockUninitialize(&Registration->ConnectionLock);
     CxPlatLockUninitialize(&Registration->ConfigLock);
     CxPlatEventUninitialize(Registration->CloseEvent);
@@ -195,6 +197,35 @@ MsQuicRegistrationOpen(
         CxPlatCopyMemory(Registration->AppName, Config->AppName, AppNameLength + 1);
     }
 
+    //
+    // Both caches are initialized before either is checked, because the error
+    // path cleans up both.
+    //
+    const BOOLEAN CarefulResumeCacheInitialized =
+        QuicCarefulResumeCacheInitialize(&Registration->CarefulResumeCache);
+    const BOOLEAN TicketCacheInitialized =
+        QuicTicketCacheInitialize(&Registration->TicketCache, QUIC_TICKET_CACHE_MAX_BYTES);
+
+    if (!CarefulResumeCacheInitialized) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "careful resume cache",
+            sizeof(Registration->CarefulResumeCache));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
+    if (!TicketCacheInitialized) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "ticket cache",
+            sizeof(Registration->TicketCache));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
     Status =
         QuicWorkerPoolInitialize(
             Registration, Registration->ExecProfile, &Registration->WorkerPool);
@@ -261,6 +292,8 @@ Error:
         QuicLibraryUntrackDbgObject(QUIC_DBG_OBJECT_TYPE_REGISTRATION, &Registration->DbgObjectLink);
 #endif
         CxPlatRundownUninitialize(&Registration->Rundown);
+        QuicCarefulResumeCacheUninitialize(&Registration->CarefulResumeCache);
+        QuicTicketCacheUninitialize(&Registration->TicketCache);
         CxPlatDispatchLockUninitialize(&Registration->ConnectionLock);
         CxPlatLockUninitialize(&Registration->ConfigLock);
         CXPLAT_FREE(Registration, QUIC_POOL_REGISTRATION);
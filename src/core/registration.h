@@ -113,6 +113,16 @@ typedef struct QUIC_REGISTRATION {
     //
     CXPLAT_LIST_ENTRY Listeners;
 
+    //
+    // Congestion state remembered per destination, for careful resume.
+    //
+    QUIC_CAREFUL_RESUME_CACHE CarefulResumeCache;
+
+    //
+    // Resumption tickets received by client connections.
+    //
+    QUIC_TICKET_CACHE TicketCache;
+
     //
     // Rundown for all child objects.
     //
@@ -33,6 +33,8 @@ QuicSendInitialize(
     )
 {
     CxPlatListInitializeHead(&Send->SendStreams);
+    Send->PriorityBuckets = Send->PreAllocPriorityBuckets;
+    Send->PriorityBucketAllocLength = QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT;
     Send->MaxData = Settings->ConnFlowControlWindow;
     Send->SkippedPacketNumber = UINT64_MAX;
 
@@ -82,6 +84,13 @@ QuicSendUninitialize(
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+    Send->PriorityBucketCount = 0;
+
+    if (Send->PriorityBucketAllocLength != QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT) {
+        CXPLAT_FREE(Send->PriorityBuckets, QUIC_POOL_SEND_PRIORITY_BUCKETS);
+        Send->PriorityBuckets = Send->PreAllocPriorityBuckets;
+        Send->PriorityBucketAllocLength = QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -154,6 +163,239 @@ QuicSendQueueFlush(
     }
 }
 
+//
+// Returns the priority the send queue is ordered by for a stream priority.
+// Under the weighted fair scheme, the stream priority is only used as a weight
+// and all streams take turns in a single round.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+QuicSendQueuePriority(
+    _In_ const QUIC_SEND* Send,
+    _In_ uint16_t Priority
+    )
+{
+    return
+        Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR ?
+            0 : Priority;
+}
+
+//
+// O(log(n))
+// Returns the index of the first priority bucket with a priority less than or
+// equal to Priority, or PriorityBucketCount if there isn't one.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicSendPriorityBucketSearch(
+    _In_ const QUIC_SEND* Send,
+    _In_ uint16_t Priority
+    )
+{
+    uint32_t Low = 0;
+    uint32_t High = Send->PriorityBucketCount;
+    while (Low < High) {
+        uint32_t Mid = Low + (High - Low) / 2;
+        if (Send->PriorityBuckets[Mid].Priority > Priority) {
+            Low = Mid + 1;
+        } else {
+            High = Mid;
+        }
+    }
+    return Low;
+}
+
+//
+// Makes room for a new priority bucket at the given index, growing the bucket
+// array if necessary. Returns FALSE if the allocation failed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSendPriorityBucketInsert(
+    _Inout_ QUIC_SEND* Send,
+    _In_ uint32_t Index
+    )
+{
+    CXPLAT_DBG_ASSERT(Index <= Send->PriorityBucketCount);
+
+    if (Send->PriorityBucketCount == Send->PriorityBucketAllocLength) {
+        uint32_t NewAllocLength = Send->PriorityBucketAllocLength * 2;
+        QUIC_SEND_PRIORITY_BUCKET* NewBuckets =
+            CXPLAT_ALLOC_NONPAGED(
+                NewAllocLength * sizeof(QUIC_SEND_PRIORITY_BUCKET),
+                QUIC_POOL_SEND_PRIORITY_BUCKETS);
+        if (NewBuckets == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "send priority buckets",
+                NewAllocLength * sizeof(QUIC_SEND_PRIORITY_BUCKET));
+            return FALSE;
+        }
+
+        CxPlatCopyMemory(
+            NewBuckets,
+            Send->PriorityBuckets,
+            Send->PriorityBucketCount * sizeof(QUIC_SEND_PRIORITY_BUCKET));
+        if (Send->PriorityBucketAllocLength != QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT) {
+            CXPLAT_FREE(Send->PriorityBuckets, QUIC_POOL_SEND_PRIORITY_BUCKETS);
+        }
+        Send->PriorityBuckets = NewBuckets;
+        Send->PriorityBucketAllocLength = NewAllocLength;
+    }
+
+    CxPlatMoveMemory(
+        Send->PriorityBuckets + Index + 1,
+        Send->PriorityBuckets + Index,
+        (Send->PriorityBucketCount - Index) * sizeof(QUIC_SEND_PRIORITY_BUCKET));
+    Send->PriorityBucketCount++;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendInsertStream(
+    _Inout_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    CXPLAT_LIST_ENTRY* Entry;
+    const uint16_t Priority = QuicSendQueuePriority(Send, Stream->SendPriority);
+
+    if (!Send->PriorityBucketsDisabled) {
+        uint32_t Index = QuicSendPriorityBucketSearch(Send, Priority);
+        if (Index < Send->PriorityBucketCount &&
+            Send->PriorityBuckets[Index].Priority == Priority) {
+            //
+            // Queue behind the last stream of the same priority.
+            //
+            CxPlatListInsertHead(
+                &Send->PriorityBuckets[Index].LastStream->SendLink,
+                &Stream->SendLink); // Insert after LastStream
+            Send->PriorityBuckets[Index].LastStream = Stream;
+            return;
+        }
+
+        if (QuicSendPriorityBucketInsert(Send, Index)) {
+            //
+            // First stream of this priority. Queue behind the last stream of
+            // the next higher priority, if any.
+            //
+            Entry =
+                Index == 0 ?
+                    &Send->SendStreams :
+                    &Send->PriorityBuckets[Index - 1].LastStream->SendLink;
+            CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after Entry
+            Send->PriorityBuckets[Index].Priority = Priority;
+            Send->PriorityBuckets[Index].LastStream = Stream;
+            return;
+        }
+
+        //
+        // Fall back to searching the list until the queue drains.
+        //
+        Send->PriorityBucketsDisabled = TRUE;
+        Send->PriorityBucketCount = 0;
+    }
+
+    Entry = Send->SendStreams.Blink;
+    while (Entry != &Send->SendStreams) {
+        //
+        // Search back to front for the right place (based on priority) to
+        // insert the stream.
+        //
+        if (Priority <=
+            QuicSendQueuePriority(
+                Send, CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority)) {
+            break;
+        }
+        Entry = Entry->Blink;
+    }
+    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendRemoveStream(
+    _Inout_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t Priority
+    )
+{
+    if (!Send->PriorityBucketsDisabled) {
+        Priority = QuicSendQueuePriority(Send, Priority);
+        uint32_t Index = QuicSendPriorityBucketSearch(Send, Priority);
+        CXPLAT_DBG_ASSERT(Index < Send->PriorityBucketCount);
+        CXPLAT_DBG_ASSERT(Send->PriorityBuckets[Index].Priority == Priority);
+        if (Send->PriorityBuckets[Index].LastStream == Stream) {
+            CXPLAT_LIST_ENTRY* Entry = Stream->SendLink.Blink;
+            if (Entry != &Send->SendStreams &&
+                QuicSendQueuePriority(
+                    Send, CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) == Priority) {
+                Send->PriorityBuckets[Index].LastStream =
+                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+            } else {
+                //
+                // This was the only stream of this priority.
+                //
+                CxPlatMoveMemory(
+                    Send->PriorityBuckets + Index,
+                    Send->PriorityBuckets + Index + 1,
+                    (Send->PriorityBucketCount - Index - 1) * sizeof(QUIC_SEND_PRIORITY_BUCKET));
+                Send->PriorityBucketCount--;
+            }
+        }
+    }
+
+    CxPlatListEntryRemove(&Stream->SendLink);
+
+    if (Send->PriorityBucketsDisabled && CxPlatListIsEmpty(&Send->SendStreams)) {
+        Send->PriorityBucketsDisabled = FALSE;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendRotateStream(
+    _Inout_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    const uint16_t Priority = QuicSendQueuePriority(Send, Stream->SendPriority);
+
+    if (!Send->PriorityBucketsDisabled) {
+        uint32_t Index = QuicSendPriorityBucketSearch(Send, Priority);
+        CXPLAT_DBG_ASSERT(Index < Send->PriorityBucketCount);
+        QUIC_SEND_PRIORITY_BUCKET* Bucket = &Send->PriorityBuckets[Index];
+        CXPLAT_DBG_ASSERT(Bucket->Priority == Priority);
+        if (Bucket->LastStream != Stream) {
+            CxPlatListEntryRemove(&Stream->SendLink);
+            CxPlatListInsertHead(&Bucket->LastStream->SendLink, &Stream->SendLink);
+            Bucket->LastStream = Stream;
+        }
+        return;
+    }
+
+    //
+    // Start with the "next" entry in the list and keep going until the next
+    // entry's priority is less. Then move the stream before that entry.
+    //
+    CXPLAT_LIST_ENTRY* LastEntry = Stream->SendLink.Flink;
+    while (LastEntry != &Send->SendStreams) {
+        if (Priority >
+            QuicSendQueuePriority(
+                Send, CXPLAT_CONTAINING_RECORD(LastEntry, QUIC_STREAM, SendLink)->SendPriority)) {
+            break;
+        }
+        LastEntry = LastEntry->Flink;
+    }
+    if (LastEntry->Blink != &Stream->SendLink) {
+        CxPlatListEntryRemove(&Stream->SendLink);
+        CxPlatListInsertTail(LastEntry, &Stream->SendLink);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendQueueFlushForStream(
@@ -166,19 +408,8 @@ QuicSendQueueFlushForStream(
         //
         // Not previously queued, so add the stream to the end of the queue.
         //
-        CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-        while (Entry != &Send->SendStreams) {
-            //
-            // Search back to front for the right place (based on priority) to
-            // insert the stream.
-            //
-            if (Stream->SendPriority <=
-                CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-                break;
-            }
-            Entry = Entry->Blink;
-        }
-        CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+        Stream->SendCredit = 0;
+        QuicSendInsertStream(Send, Stream);
         QuicStreamAddRef(Stream, QUIC_STREAM_REF_SEND);
     }
 
@@ -204,25 +435,49 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendUpdateStreamPriority(
     _In_ QUIC_SEND* Send,
-    _In_ QUIC_STREAM* Stream
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t OldPriority
     )
 {
     CXPLAT_DBG_ASSERT(Stream->SendLink.Flink != NULL);
-    CxPlatListEntryRemove(&Stream->SendLink);
+    if (QuicSendQueuePriority(Send, OldPriority) ==
+        QuicSendQueuePriority(Send, Stream->SendPriority)) {
+        return; // Only the weight changed.
+    }
+    QuicSendRemoveStream(Send, Stream, OldPriority);
+    QuicSendInsertStream(Send, Stream);
+}
 
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-    while (Entry != &Send->SendStreams) {
-        //
-        // Search back to front for the right place (based on priority) to
-        // insert the stream.
-        //
-        if (Stream->SendPriority <=
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-            break;
-        }
-        Entry = Entry->Blink;
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    )
+{
+    const BOOLEAN WasWeightedFair =
+        Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR;
+    Send->StreamSchedulingScheme = (uint8_t)Scheme;
+    if (WasWeightedFair ==
+        (Scheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR)) {
+        return;
+    }
+
+    //
+    // Requeue all the streams, in their current order, by the new scheme's
+    // queue priority.
+    //
+    CXPLAT_LIST_ENTRY Streams;
+    CxPlatListInitializeHead(&Streams);
+    CxPlatListMoveItems(&Send->SendStreams, &Streams);
+    Send->PriorityBucketCount = 0;
+    Send->PriorityBucketsDisabled = FALSE;
+    while (!CxPlatListIsEmpty(&Streams)) {
+        QuicSendInsertStream(
+            Send,
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Streams), QUIC_STREAM, SendLink));
     }
-    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
 }
 
 #if DEBUG
@@ -288,6 +543,8 @@ QuicSendClear(
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+    Send->PriorityBucketCount = 0;
+    Send->PriorityBucketsDisabled = FALSE;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -453,8 +710,6 @@ QuicSendClearStreamSendFlag(
     _In_ uint32_t SendFlags
     )
 {
-    UNREFERENCED_PARAMETER(Send);
-
     if (Stream->SendFlags & SendFlags) {
 
         QuicTraceLogStreamVerbose(
@@ -472,7 +727,7 @@ QuicSendClearStreamSendFlag(
             //
             // Since there are no flags left, remove the stream from the queue.
             //
-            CxPlatListEntryRemove(&Stream->SendLink);
+            QuicSendRemoveStream(Send, Stream, Stream->SendPriority);
             Stream->SendLink.Flink = NULL;
             QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
         }
@@ -920,7 +1175,10 @@ QuicSendWriteFrames(
             QUIC_ACK_FREQUENCY_EX Frame;
             Frame.SequenceNumber = Connection->SendAckFreqSeqNum;
             Frame.AckElicitingThreshold = Connection->PeerPacketTolerance;
-            Frame.RequestedMaxAckDelay = MS_TO_US(QuicConnGetAckDelay(Connection));
+            Frame.RequestedMaxAckDelay =
+                Connection->PeerMaxAckDelayUs != 0 ?
+                    Connection->PeerMaxAckDelayUs :
+                    MS_TO_US(QuicConnGetAckDelay(Connection));
             Frame.ReorderingThreshold = Connection->PeerReorderingThreshold;
 
             if (QuicAckFrequencyFrameEncode(
@@ -1004,6 +1262,50 @@ QuicSendCanSendStreamNow(
     return FALSE;
 }
 
+//
+// Deficit round robin across the streams that can send now. Each time a
+// stream comes up in the round it earns credit in proportion to its priority,
+// and it is picked once it has earned at least a packet's worth. Every pass
+// over the queue adds credit to each stream that can send, so this returns
+// within QUIC_STREAM_SEND_PACKET_CREDIT passes.
+//
+_Success_(return != NULL)
+QUIC_STREAM*
+QuicSendGetNextWeightedFairStream(
+    _In_ QUIC_SEND* Send,
+    _Out_ uint32_t* PacketCount
+    )
+{
+    BOOLEAN FoundStream;
+    do {
+        FoundStream = FALSE;
+        CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
+        while (Entry != &Send->SendStreams) {
+            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+            Entry = Entry->Flink;
+
+            if (!QuicSendCanSendStreamNow(Stream)) {
+                continue;
+            }
+
+            FoundStream = TRUE;
+            Stream->SendCredit += (Stream->SendPriority >> 8) + 1;
+            if (Stream->SendCredit >= QUIC_STREAM_SEND_PACKET_CREDIT) {
+                *PacketCount = Stream->SendCredit / QUIC_STREAM_SEND_PACKET_CREDIT;
+                Stream->SendCredit %= QUIC_STREAM_SEND_PACKET_CREDIT;
+
+                //
+                // Move the stream to the end of the round.
+                //
+                QuicSendRotateStream(Send, Stream);
+                return Stream;
+            }
+        }
+    } while (FoundStream);
+
+    return NULL;
+}
+
 _Success_(return != NULL)
 QUIC_STREAM*
 QuicSendGetNextStream(
@@ -1011,8 +1313,13 @@ QuicSendGetNextStream(
     _Out_ uint32_t* PacketCount
     )
 {
-    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
-    CXPLAT_DBG_ASSERT(!QuicConnIsClosed(Connection) || CxPlatListIsEmpty(&Send->SendStreams));
+    CXPLAT_DBG_ASSERT(
+        !QuicConnIsClosed(QuicSendGetConnection(Send)) ||
+        CxPlatListIsEmpty(&Send->SendStreams));
+
+    if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
+        return QuicSendGetNextWeightedFairStream(Send, PacketCount);
+    }
 
     CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
     while (Entry != &Send->SendStreams) {
@@ -1030,25 +1337,15 @@ QuicSendGetNextStream(
         //
         if (QuicSendCanSendStreamNow(Stream)) {
 
-            if (Connection->State.UseRoundRobinStreamScheduling) {
+            if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN ||
+                (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY &&
+                 QUIC_STREAM_PRIORITY_IS_INCREMENTAL(Stream->SendPriority))) {
                 //
-                // Move the stream after any streams of the same priority. Start
-                // with the "next" entry in the list and keep going until the
-                // next entry's priority is less. Then move the stream before
-                // that entry.
+                // Move the stream after any streams of the same priority.
+                // Under the extensible priority scheme, only incremental
+                // streams share; the others are sent one at a time.
                 //
-                CXPLAT_LIST_ENTRY* LastEntry = Stream->SendLink.Flink;
-                while (LastEntry != &Send->SendStreams) {
-                    if (Stream->SendPriority >
-                        CXPLAT_CONTAINING_RECORD(LastEntry, QUIC_STREAM, SendLink)->SendPriority) {
-                        break;
-                    }
-                    LastEntry = LastEntry->Flink;
-                }
-                if (LastEntry->Blink != &Stream->SendLink) {
-                    CxPlatListEntryRemove(&Stream->SendLink);
-                    CxPlatListInsertTail(LastEntry, &Stream->SendLink);
-                }
+                QuicSendRotateStream(Send, Stream);
 
                 *PacketCount = QUIC_STREAM_SEND_BATCH_COUNT;
 
@@ -1434,7 +1731,7 @@ QuicSendFlush(
                 // If the stream no longer has anything to send, remove it from the
                 // list and release Send's reference on it.
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
+                QuicSendRemoveStream(Send, Stream, Stream->SendPriority);
                 Stream->SendLink.Flink = NULL;
                 QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
                 Stream = NULL;
@@ -1511,12 +1808,14 @@ QuicSendFlush(
         //
         QuicSendQueueFlush(&Connection->Send, REASON_SCHEDULING);
 
-        if (Builder.TotalCountDatagrams + 1 > Connection->PeerPacketTolerance) {
+        if (!Connection->Settings.AdaptiveAckFrequencyEnabled &&
+            Builder.TotalCountDatagrams + 1 > Connection->PeerPacketTolerance) {
             //
             // We're scheduling limited, so we should tell the peer to use our
             // (max) batch size + 1 as the peer tolerance as a hint that they
             // should expect more than a single batch before needing to send an
-            // acknowledgment back.
+            // acknowledgment back. With adaptive ACK frequency, the tolerance
+            // follows the congestion window instead.
             //
             QuicConnUpdatePeerPacketTolerance(Connection, Builder.TotalCountDatagrams + 1);
         }
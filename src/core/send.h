@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 #define SEND_PACKET_SHORT_HEADER_TYPE 0xff
 
 QUIC_INLINE
@@ -234,6 +238,21 @@ QUIC_INLINE BOOLEAN HasStreamDataFrames(uint32_t Flags)
          QUIC_STREAM_SEND_FLAG_FIN);
 }
 
+//
+// The number of priority buckets allocated along with the send state.
+//
+#define QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT 4
+
+//
+// Tracks the last stream queued with a given priority in the send queue.
+//
+typedef struct QUIC_SEND_PRIORITY_BUCKET {
+
+    QUIC_STREAM* LastStream;
+    uint16_t Priority;
+
+} QUIC_SEND_PRIORITY_BUCKET;
+
 typedef struct QUIC_SEND {
 
     //
@@ -262,6 +281,12 @@ typedef struct QUIC_SEND {
     //
     BOOLEAN Uninitialized : 1;
 
+    //
+    // Indicates the priority buckets failed to grow and aren't in use until
+    // the send queue is empty again.
+    //
+    BOOLEAN PriorityBucketsDisabled : 1;
+
     //
     // The next packet number to use.
     //
@@ -324,10 +349,37 @@ typedef struct QUIC_SEND {
     uint32_t SendFlags;
 
     //
-    // List of streams with data or control frames to send.
+    // The QUIC_STREAM_SCHEDULING_SCHEME used to pick the next stream to send.
+    //
+    uint8_t StreamSchedulingScheme;
+
+    //
+    // List of streams with data or control frames to send, in descending
+    // priority order (or in round order for the weighted fair scheme).
     //
     CXPLAT_LIST_ENTRY SendStreams;
 
+    //
+    // An index into SendStreams, with one bucket for each priority currently
+    // in the list, sorted by descending priority. It allows a stream to be
+    // queued behind the other streams of the same priority without searching
+    // the list.
+    //
+    _Field_size_(PriorityBucketAllocLength)
+    QUIC_SEND_PRIORITY_BUCKET* PriorityBuckets;
+
+    //
+    // The number of buckets in use and allocated in PriorityBuckets.
+    //
+    uint32_t PriorityBucketCount;
+    uint32_t PriorityBucketAllocLength;
+
+    //
+    // Buckets allocated along with the send state, for the common case of
+    // only a few different priorities.
+    //
+    QUIC_SEND_PRIORITY_BUCKET PreAllocPriorityBuckets[QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT];
+
     //
     // The current token to send with an Initial packet.
     //
@@ -422,6 +474,50 @@ QuicSendQueueFlushForStream(
     _In_ BOOLEAN DelaySend
     );
 
+//
+// Inserts the stream into the send queue, after all streams of greater or
+// equal priority.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendInsertStream(
+    _Inout_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Removes the stream (which was queued with the given priority) from the send
+// queue. The caller is responsible for resetting the stream's link.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendRemoveStream(
+    _Inout_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t Priority
+    );
+
+//
+// Moves the stream behind all the other queued streams of the same priority.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendRotateStream(
+    _Inout_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Changes the stream scheduling scheme, reordering the queued streams if the
+// new scheme orders them differently.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    );
+
 //
 // Updates the stream's order in response to a priority change.
 //
@@ -429,7 +525,8 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendUpdateStreamPriority(
     _In_ QUIC_SEND* Send,
-    _In_ QUIC_STREAM* Stream
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t OldPriority
     );
 
 //
@@ -523,3 +620,7 @@ QuicSendClearStreamSendFlag(
     _In_ QUIC_STREAM* Stream,
     _In_ uint32_t SendFlag
     );
+
+#if defined(__cplusplus)
+}
+#endif
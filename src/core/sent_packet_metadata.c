@@ -14,6 +14,10 @@ Abstract:
     contained in the packet. The allocator uses a different pool for each
     possible size.
 
+    Outstanding metadata is tracked by loss detection in a
+    QUIC_SENT_PACKET_RING, which keeps it ordered by packet number so that
+    ACK blocks can be matched with a binary search instead of a list walk.
+
 --*/
 
 #include "precomp.h"
@@ -134,3 +138,174 @@ QuicSentPacketPoolReturnPacketMetadata(
     QuicSentPacketMetadataReleaseFrames(Metadata, Connection);
     CxPlatPoolFree(Metadata);
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingInitialize(
+    _Out_ QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    Ring->Packets = Ring->PreAllocPackets;
+    Ring->Head = 0;
+    Ring->Count = 0;
+    Ring->AllocLength = QUIC_SENT_PACKET_RING_INITIAL_SIZE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingUninitialize(
+    _In_ QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    CXPLAT_DBG_ASSERT(Ring->Count == 0);
+    if (Ring->Packets != Ring->PreAllocPackets) {
+        CXPLAT_FREE(Ring->Packets, QUIC_POOL_SENT_PACKET_RING);
+        Ring->Packets = Ring->PreAllocPackets;
+        Ring->AllocLength = QUIC_SENT_PACKET_RING_INITIAL_SIZE;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketRingGrow(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    uint32_t NewAllocLength = Ring->AllocLength << 1; // Grow by a factor of 2.
+    if (NewAllocLength < Ring->AllocLength) {
+        return FALSE;
+    }
+
+    QUIC_SENT_PACKET_METADATA** NewPackets =
+        CXPLAT_ALLOC_NONPAGED(
+            NewAllocLength * sizeof(QUIC_SENT_PACKET_METADATA*),
+            QUIC_POOL_SENT_PACKET_RING);
+    if (NewPackets == NULL) {
+        return FALSE;
+    }
+
+    //
+    // Unwrap the ring into the start of the new array.
+    //
+    uint32_t FirstPart = Ring->AllocLength - Ring->Head;
+    if (FirstPart > Ring->Count) {
+        FirstPart = Ring->Count;
+    }
+    CxPlatCopyMemory(
+        NewPackets,
+        Ring->Packets + Ring->Head,
+        FirstPart * sizeof(QUIC_SENT_PACKET_METADATA*));
+    CxPlatCopyMemory(
+        NewPackets + FirstPart,
+        Ring->Packets,
+        (Ring->Count - FirstPart) * sizeof(QUIC_SENT_PACKET_METADATA*));
+
+    if (Ring->Packets != Ring->PreAllocPackets) {
+        CXPLAT_FREE(Ring->Packets, QUIC_POOL_SENT_PACKET_RING);
+    }
+    Ring->Packets = NewPackets;
+    Ring->AllocLength = NewAllocLength;
+    Ring->Head = 0;
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicSentPacketRingLowerBound(
+    _In_ const QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint64_t PacketNumber
+    )
+{
+    uint32_t Lo = 0;
+    uint32_t Hi = Ring->Count;
+    while (Lo < Hi) {
+        uint32_t Mid = Lo + (Hi - Lo) / 2;
+        if (QuicSentPacketRingGet(Ring, Mid)->PacketNumber < PacketNumber) {
+            Lo = Mid + 1;
+        } else {
+            Hi = Mid;
+        }
+    }
+    return Lo;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketRingInsert(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    if (Ring->Count == Ring->AllocLength && !QuicSentPacketRingGrow(Ring)) {
+        return FALSE;
+    }
+
+    const uint32_t Mask = Ring->AllocLength - 1;
+    QUIC_SENT_PACKET_METADATA* Last = QuicSentPacketRingLast(Ring);
+    if (Last == NULL || Last->PacketNumber < Packet->PacketNumber) {
+        //
+        // Fast path: append to the tail.
+        //
+        Ring->Packets[(Ring->Head + Ring->Count) & Mask] = Packet;
+        Ring->Count++;
+        return TRUE;
+    }
+
+    uint32_t Index = QuicSentPacketRingLowerBound(Ring, Packet->PacketNumber);
+    CXPLAT_DBG_ASSERT(
+        Index == Ring->Count ||
+        QuicSentPacketRingGet(Ring, Index)->PacketNumber != Packet->PacketNumber);
+
+    if (Index < Ring->Count - Index) {
+        //
+        // Fewer packets in front; move them down one slot.
+        //
+        Ring->Head = (Ring->Head - 1) & Mask;
+        for (uint32_t i = 0; i < Index; i++) {
+            Ring->Packets[(Ring->Head + i) & Mask] =
+                Ring->Packets[(Ring->Head + i + 1) & Mask];
+        }
+    } else {
+        for (uint32_t i = Ring->Count; i > Index; i--) {
+            Ring->Packets[(Ring->Head + i) & Mask] =
+                Ring->Packets[(Ring->Head + i - 1) & Mask];
+        }
+    }
+    Ring->Packets[(Ring->Head + Index) & Mask] = Packet;
+    Ring->Count++;
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingRemove(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint32_t Index,
+    _In_ uint32_t Count
+    )
+{
+    CXPLAT_DBG_ASSERT(Index + Count <= Ring->Count);
+    const uint32_t Mask = Ring->AllocLength - 1;
+    const uint32_t After = Ring->Count - Index - Count;
+
+    if (Index < After) {
+        //
+        // Fewer packets in front; move them up to fill the hole.
+        //
+        for (uint32_t i = Index; i > 0; i--) {
+            Ring->Packets[(Ring->Head + i - 1 + Count) & Mask] =
+                Ring->Packets[(Ring->Head + i - 1) & Mask];
+        }
+        Ring->Head = (Ring->Head + Count) & Mask;
+    } else {
+        for (uint32_t i = 0; i < After; i++) {
+            Ring->Packets[(Ring->Head + Index + i) & Mask] =
+                Ring->Packets[(Ring->Head + Index + Count + i) & Mask];
+        }
+    }
+    Ring->Count -= Count;
+}
@@ -139,6 +139,9 @@ typedef struct LAST_ACKED_PACKET_INFO {
 //
 typedef struct QUIC_SENT_PACKET_METADATA {
 
+    //
+    // Links the packets acknowledged by a single ACK frame together.
+    //
     struct QUIC_SENT_PACKET_METADATA *Next;
 
     uint64_t PacketId;
@@ -243,3 +246,167 @@ QuicSentPacketPoolReturnPacketMetadata(
     _In_ QUIC_SENT_PACKET_METADATA* Metadata,
     _In_ QUIC_CONNECTION* Connection
     );
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define QUIC_SENT_PACKET_RING_INITIAL_SIZE  8
+
+//
+// An ordered collection of sent packet metadata, stored as a ring buffer of
+// pointers sorted by ascending packet number. Since packet numbers only ever
+// increase, new packets are almost always appended to the tail, and a run of
+// acknowledged packets can be found with a binary search and removed without
+// walking the packets in front of it.
+//
+typedef struct QUIC_SENT_PACKET_RING {
+
+    //
+    // Ring buffer of packet pointers. Always a power of two in length.
+    //
+    _Field_size_(AllocLength)
+    QUIC_SENT_PACKET_METADATA** Packets;
+
+    //
+    // The physical index of the first (smallest packet number) packet.
+    //
+    uint32_t Head;
+
+    //
+    // The number of packets currently in the ring.
+    //
+    uint32_t Count;
+
+    //
+    // The number of allocated entries in the 'Packets' array.
+    //
+    uint32_t AllocLength;
+
+    //
+    // Allocates a number of entries along with the parent object.
+    //
+    QUIC_SENT_PACKET_METADATA* PreAllocPackets[QUIC_SENT_PACKET_RING_INITIAL_SIZE];
+
+} QUIC_SENT_PACKET_RING;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingInitialize(
+    _Out_ QUIC_SENT_PACKET_RING* Ring
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingUninitialize(
+    _In_ QUIC_SENT_PACKET_RING* Ring
+    );
+
+//
+// Returns the number of packets in the ring.
+//
+QUIC_INLINE
+uint32_t
+QuicSentPacketRingSize(
+    _In_ const QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    return Ring->Count;
+}
+
+//
+// Accessor function for the packet at a given (logical) index.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingGet(
+    _In_ const QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint32_t Index
+    )
+{
+    CXPLAT_DBG_ASSERT(Index < Ring->Count);
+    return Ring->Packets[(Ring->Head + Index) & (Ring->AllocLength - 1)];
+}
+
+//
+// Replaces the packet at a given (logical) index. The caller is responsible
+// for maintaining the packet number order.
+//
+QUIC_INLINE
+void
+QuicSentPacketRingSet(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint32_t Index,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    CXPLAT_DBG_ASSERT(Index < Ring->Count);
+    Ring->Packets[(Ring->Head + Index) & (Ring->AllocLength - 1)] = Packet;
+}
+
+//
+// Returns the packet with the smallest packet number, or NULL if empty.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingFirst(
+    _In_ const QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    return Ring->Count == 0 ? NULL : Ring->Packets[Ring->Head];
+}
+
+//
+// Returns the packet with the largest packet number, or NULL if empty.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingLast(
+    _In_ const QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    return
+        Ring->Count == 0 ?
+            NULL :
+            Ring->Packets[(Ring->Head + Ring->Count - 1) & (Ring->AllocLength - 1)];
+}
+
+//
+// O(log(n))
+// Returns the index of the first packet with a packet number greater than or
+// equal to PacketNumber. Returns the ring size if there is no such packet.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicSentPacketRingLowerBound(
+    _In_ const QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint64_t PacketNumber
+    );
+
+//
+// Inserts a packet in packet number order. Appending to the tail is O(1).
+// Returns FALSE if the ring needed to grow and the allocation failed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketRingInsert(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    );
+
+//
+// Removes a contiguous run of packets starting at the given index. Removal
+// from either end is O(1); otherwise the shorter side of the ring is moved.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingRemove(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint32_t Index,
+    _In_ uint32_t Count
+    );
+
+#if defined(__cplusplus)
+}
+#endif
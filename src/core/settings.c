@@ -165,6 +165,24 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.QTIPEnabled) {
         Settings->QTIPEnabled = QUIC_DEFAULT_QTIP_ENABLED;
     }
+    if (!Settings->IsSet.CarefulResumeEnabled) {
+        Settings->CarefulResumeEnabled = QUIC_DEFAULT_CAREFUL_RESUME_ENABLED;
+    }
+    if (!Settings->IsSet.AdaptiveAckFrequencyEnabled) {
+        Settings->AdaptiveAckFrequencyEnabled = QUIC_DEFAULT_ADAPTIVE_ACK_FREQUENCY_ENABLED;
+    }
+    if (!Settings->IsSet.WorkerRebalancingEnabled) {
+        Settings->WorkerRebalancingEnabled = QUIC_DEFAULT_WORKER_REBALANCING_ENABLED;
+    }
+    if (!Settings->IsSet.OpenAddressingLookupEnabled) {
+        Settings->OpenAddressingLookupEnabled = QUIC_DEFAULT_OPEN_ADDRESSING_LOOKUP_ENABLED;
+    }
+    if (!Settings->IsSet.ResumptionTicketCacheEnabled) {
+        Settings->ResumptionTicketCacheEnabled = QUIC_DEFAULT_RESUMPTION_TICKET_CACHE_ENABLED;
+    }
+    if (!Settings->IsSet.StatelessResetSipHashEnabled) {
+        Settings->StatelessResetSipHashEnabled = QUIC_DEFAULT_STATELESS_RESET_SIPHASH_ENABLED;
+    }
     if (!Settings->IsSet.OneWayDelayEnabled) {
         Settings->OneWayDelayEnabled = QUIC_DEFAULT_ONE_WAY_DELAY_ENABLED;
     }
@@ -339,6 +357,24 @@ QuicSettingsCopy(
     if (!Destination->IsSet.QTIPEnabled) {
         Destination->QTIPEnabled = Source->QTIPEnabled;
     }
+    if (!Destination->IsSet.CarefulResumeEnabled) {
+        Destination->CarefulResumeEnabled = Source->CarefulResumeEnabled;
+    }
+    if (!Destination->IsSet.AdaptiveAckFrequencyEnabled) {
+        Destination->AdaptiveAckFrequencyEnabled = Source->AdaptiveAckFrequencyEnabled;
+    }
+    if (!Destination->IsSet.WorkerRebalancingEnabled) {
+        Destination->WorkerRebalancingEnabled = Source->WorkerRebalancingEnabled;
+    }
+    if (!Destination->IsSet.OpenAddressingLookupEnabled) {
+        Destination->OpenAddressingLookupEnabled = Source->OpenAddressingLookupEnabled;
+    }
+    if (!Destination->IsSet.ResumptionTicketCacheEnabled) {
+        Destination->ResumptionTicketCacheEnabled = Source->ResumptionTicketCacheEnabled;
+    }
+    if (!Destination->IsSet.StatelessResetSipHashEnabled) {
+        Destination->StatelessResetSipHashEnabled = Source->StatelessResetSipHashEnabled;
+    }
     if (!Destination->IsSet.OneWayDelayEnabled) {
         Destination->OneWayDelayEnabled = Source->OneWayDelayEnabled;
     }
@@ -734,6 +770,36 @@ QuicSettingApply(
         Destination->IsSet.QTIPEnabled = TRUE;
     }
 
+    if (Source->IsSet.CarefulResumeEnabled && (!Destination->IsSet.CarefulResumeEnabled || OverWrite)) {
+        Destination->CarefulResumeEnabled = Source->CarefulResumeEnabled;
+        Destination->IsSet.CarefulResumeEnabled = TRUE;
+    }
+
+    if (Source->IsSet.AdaptiveAckFrequencyEnabled && (!Destination->IsSet.AdaptiveAckFrequencyEnabled || OverWrite)) {
+        Destination->AdaptiveAckFrequencyEnabled = Source->AdaptiveAckFrequencyEnabled;
+        Destination->IsSet.AdaptiveAckFrequencyEnabled = TRUE;
+    }
+
+    if (Source->IsSet.WorkerRebalancingEnabled && (!Destination->IsSet.WorkerRebalancingEnabled || OverWrite)) {
+        Destination->WorkerRebalancingEnabled = Source->WorkerRebalancingEnabled;
+        Destination->IsSet.WorkerRebalancingEnabled = TRUE;
+    }
+
+    if (Source->IsSet.OpenAddressingLookupEnabled && (!Destination->IsSet.OpenAddressingLookupEnabled || OverWrite)) {
+        Destination->OpenAddressingLookupEnabled = Source->OpenAddressingLookupEnabled;
+        Destination->IsSet.OpenAddressingLookupEnabled = TRUE;
+    }
+
+    if (Source->IsSet.ResumptionTicketCacheEnabled && (!Destination->IsSet.ResumptionTicketCacheEnabled || OverWrite)) {
+        Destination->ResumptionTicketCacheEnabled = Source->ResumptionTicketCacheEnabled;
+        Destination->IsSet.ResumptionTicketCacheEnabled = TRUE;
+    }
+
+    if (Source->IsSet.StatelessResetSipHashEnabled && (!Destination->IsSet.StatelessResetSipHashEnabled || OverWrite)) {
+        Destination->StatelessResetSipHashEnabled = Source->StatelessResetSipHashEnabled;
+        Destination->IsSet.StatelessResetSipHashEnabled = TRUE;
+    }
+
 
     if (Source->IsSet.OneWayDelayEnabled && (!Destination->IsSet.OneWayDelayEnabled || OverWrite)) {
         Destination->OneWayDelayEnabled = Source->OneWayDelayEnabled;
@@ -1407,6 +1473,66 @@ VersionSettingsFail:
             &ValueLen);
         Settings->QTIPEnabled = !!Value;
     }
+    if (!Settings->IsSet.CarefulResumeEnabled) {
+        Value = QUIC_DEFAULT_CAREFUL_RESUME_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_CAREFUL_RESUME_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->CarefulResumeEnabled = !!Value;
+    }
+    if (!Settings->IsSet.AdaptiveAckFrequencyEnabled) {
+        Value = QUIC_DEFAULT_ADAPTIVE_ACK_FREQUENCY_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ADAPTIVE_ACK_FREQUENCY_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->AdaptiveAckFrequencyEnabled = !!Value;
+    }
+    if (!Settings->IsSet.WorkerRebalancingEnabled) {
+        Value = QUIC_DEFAULT_WORKER_REBALANCING_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_WORKER_REBALANCING_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->WorkerRebalancingEnabled = !!Value;
+    }
+    if (!Settings->IsSet.OpenAddressingLookupEnabled) {
+        Value = QUIC_DEFAULT_OPEN_ADDRESSING_LOOKUP_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_OPEN_ADDRESSING_LOOKUP_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->OpenAddressingLookupEnabled = !!Value;
+    }
+    if (!Settings->IsSet.ResumptionTicketCacheEnabled) {
+        Value = QUIC_DEFAULT_RESUMPTION_TICKET_CACHE_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_RESUMPTION_TICKET_CACHE_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->ResumptionTicketCacheEnabled = !!Value;
+    }
+    if (!Settings->IsSet.StatelessResetSipHashEnabled) {
+        Value = QUIC_DEFAULT_STATELESS_RESET_SIPHASH_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_STATELESS_RESET_SIPHASH_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->StatelessResetSipHashEnabled = !!Value;
+    }
     if (!Settings->IsSet.OneWayDelayEnabled) {
         Value = QUIC_DEFAULT_ONE_WAY_DELAY_ENABLED;
         ValueLen = sizeof(Value);
@@ -1505,6 +1631,12 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingReliableResetEnabled,        "[sett] ReliableResetEnabled   = %hhu", Settings->ReliableResetEnabled);
     QuicTraceLogVerbose(SettingXdpEnabled,                  "[sett] XdpEnabled             = %hhu", Settings->XdpEnabled);
     QuicTraceLogVerbose(SettingQTIPEnabled,                 "[sett] QTIPEnabled            = %hhu", Settings->QTIPEnabled);
+    QuicTraceLogVerbose(SettingCarefulResumeEnabled,        "[sett] CarefulResumeEnabled   = %hhu", Settings->CarefulResumeEnabled);
+    QuicTraceLogVerbose(SettingAdaptiveAckFrequencyEnabled, "[sett] AdaptiveAckFreqEnabled = %hhu", Settings->AdaptiveAckFrequencyEnabled);
+    QuicTraceLogVerbose(SettingWorkerRebalancingEnabled,    "[sett] WorkerRebalanceEnabled = %hhu", Settings->WorkerRebalancingEnabled);
+    QuicTraceLogVerbose(SettingOpenAddressingLookupEnabled, "[sett] OpenAddrLookupEnabled  = %hhu", Settings->OpenAddressingLookupEnabled);
+    QuicTraceLogVerbose(SettingResumptionTicketCacheEnabled, "[sett] TicketCacheEnabled     = %hhu", Settings->ResumptionTicketCacheEnabled);
+    QuicTraceLogVerbose(SettingStatelessResetSipHashEnabled, "[sett] ResetSipHashEnabled    = %hhu", Settings->StatelessResetSipHashEnabled);
     QuicTraceLogVerbose(SettingOneWayDelayEnabled,          "[sett] OneWayDelayEnabled     = %hhu", Settings->OneWayDelayEnabled);
     QuicTraceLogVerbose(SettingNetStatsEventEnabled,        "[sett] NetStatsEventEnabled   = %hhu", Settings->NetStatsEventEnabled);
     QuicTraceLogVerbose(SettingsStreamMultiReceiveEnabled,  "[sett] StreamMultiReceiveEnabled= %hhu", Settings->StreamMultiReceiveEnabled);
@@ -1669,6 +1801,24 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.QTIPEnabled) {
         QuicTraceLogVerbose(SettingQTIPEnabled,                     "[sett] QTIPEnabled                = %hhu", Settings->QTIPEnabled);
     }
+    if (Settings->IsSet.CarefulResumeEnabled) {
+        QuicTraceLogVerbose(SettingCarefulResumeEnabled,            "[sett] CarefulResumeEnabled       = %hhu", Settings->CarefulResumeEnabled);
+    }
+    if (Settings->IsSet.AdaptiveAckFrequencyEnabled) {
+        QuicTraceLogVerbose(SettingAdaptiveAckFrequencyEnabled,     "[sett] AdaptiveAckFreqEnabled     = %hhu", Settings->AdaptiveAckFrequencyEnabled);
+    }
+    if (Settings->IsSet.WorkerRebalancingEnabled) {
+        QuicTraceLogVerbose(SettingWorkerRebalancingEnabled,        "[sett] WorkerRebalanceEnabled     = %hhu", Settings->WorkerRebalancingEnabled);
+    }
+    if (Settings->IsSet.OpenAddressingLookupEnabled) {
+        QuicTraceLogVerbose(SettingOpenAddressingLookupEnabled,     "[sett] OpenAddrLookupEnabled      = %hhu", Settings->OpenAddressingLookupEnabled);
+    }
+    if (Settings->IsSet.ResumptionTicketCacheEnabled) {
+        QuicTraceLogVerbose(SettingResumptionTicketCacheEnabled,    "[sett] TicketCacheEnabled         = %hhu", Settings->ResumptionTicketCacheEnabled);
+    }
+    if (Settings->IsSet.StatelessResetSipHashEnabled) {
+        QuicTraceLogVerbose(SettingStatelessResetSipHashEnabled,    "[sett] ResetSipHashEnabled        = %hhu", Settings->StatelessResetSipHashEnabled);
+    }
     if (Settings->IsSet.OneWayDelayEnabled) {
         QuicTraceLogVerbose(SettingOneWayDelayEnabled,              "[sett] OneWayDelayEnabled         = %hhu", Settings->OneWayDelayEnabled);
     }
@@ -1907,6 +2057,54 @@ QuicSettingsSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        CarefulResumeEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        AdaptiveAckFrequencyEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        WorkerRebalancingEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        OpenAddressingLookupEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        ResumptionTicketCacheEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        StatelessResetSipHashEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
         Flags,
         OneWayDelayEnabled,
@@ -2092,6 +2290,54 @@ QuicSettingsGetSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        CarefulResumeEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        AdaptiveAckFrequencyEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        WorkerRebalancingEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        OpenAddressingLookupEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        ResumptionTicketCacheEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        StatelessResetSipHashEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
         Flags,
         OneWayDelayEnabled,
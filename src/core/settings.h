@@ -64,7 +64,13 @@ typedef struct QUIC_SETTINGS_INTERNAL {
             uint64_t StreamMultiReceiveEnabled              : 1;
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
-            uint64_t RESERVED                               : 14;
+            uint64_t CarefulResumeEnabled                   : 1;
+            uint64_t AdaptiveAckFrequencyEnabled            : 1;
+            uint64_t WorkerRebalancingEnabled               : 1;
+            uint64_t OpenAddressingLookupEnabled            : 1;
+            uint64_t ResumptionTicketCacheEnabled           : 1;
+            uint64_t StatelessResetSipHashEnabled           : 1;
+            uint64_t RESERVED                               : 8;
         } IsSet;
     };
 
@@ -117,6 +123,12 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint8_t StreamMultiReceiveEnabled       : 1;
     uint8_t XdpEnabled                      : 1;
     uint8_t QTIPEnabled                     : 1;
+    uint8_t CarefulResumeEnabled            : 1;
+    uint8_t AdaptiveAckFrequencyEnabled     : 1;
+    uint8_t WorkerRebalancingEnabled        : 1;
+    uint8_t OpenAddressingLookupEnabled     : 1;
+    uint8_t ResumptionTicketCacheEnabled    : 1;
+    uint8_t StatelessResetSipHashEnabled    : 1;
     uint8_t MtuDiscoveryMissingProbeCount;
 } QUIC_SETTINGS_INTERNAL;
 
@@ -677,6 +677,7 @@ QuicStreamParamSet(
         }
 
         if (Stream->SendPriority != *(uint16_t*)Buffer) {
+            uint16_t OldPriority = Stream->SendPriority;
             Stream->SendPriority = *(uint16_t*)Buffer;
 
             QuicTraceLogStreamInfo(
@@ -689,7 +690,7 @@ QuicStreamParamSet(
                 //
                 // Update the stream's place in the send queue if necessary.
                 //
-                QuicSendUpdateStreamPriority(&Stream->Connection->Send, Stream);
+                QuicSendUpdateStreamPriority(&Stream->Connection->Send, Stream, OldPriority);
             }
         }
 
@@ -398,6 +398,12 @@ typedef struct QUIC_STREAM {
     //
     uint16_t SendPriority;
 
+    //
+    // Credit earned toward sending packets under the weighted fair stream
+    // scheduling scheme.
+    //
+    uint16_t SendCredit;
+
     //
     // Recv State
     //
@@ -0,0 +1,525 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Client resumption ticket cache.
+
+    When enabled, every ticket a client connection receives is saved in the
+    registration, under the server name, port and ALPN list the connection was
+    started with. A later connection started with the same ones takes a ticket
+    out of the cache and resumes with it, unless the app already set one with
+    QUIC_PARAM_CONN_RESUMPTION_TICKET.
+
+    Tickets are only used once (RFC 8446, appendix C.4), so a server keeps
+    being resumed as long as it hands out new tickets. Among the unexpired
+    tickets for a server, the newest one that allows 0-RTT is used first.
+
+    The cache holds at most QUIC_TICKET_CACHE_MAX_TICKETS_PER_SERVER tickets
+    per server and MaxSize bytes overall. Whenever a limit is hit the oldest
+    ticket of the server, or the least recently used server, is dropped.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "ticket_cache.c.clog.h"
+#endif
+
+static
+QUIC_NO_SANITIZE("unsigned-integer-overflow")
+uint32_t
+QuicTicketCacheHash(
+    _In_ const QUIC_TICKET_CACHE_KEY* Key
+    )
+{
+    uint32_t Hash =
+        CxPlatHashSimple(Key->ServerNameLength, (const uint8_t*)Key->ServerName);
+    Hash = ((Hash << 5) - Hash) + CxPlatHashSimple(Key->AlpnListLength, Key->AlpnList);
+    return ((Hash << 5) - Hash) + Key->ServerPort;
+}
+
+static
+BOOLEAN
+QuicTicketCacheEntryMatches(
+    _In_ const QUIC_TICKET_CACHE_ENTRY* Entry,
+    _In_ const QUIC_TICKET_CACHE_KEY* Key
+    )
+{
+    return
+        Entry->ServerPort == Key->ServerPort &&
+        Entry->ServerNameLength == Key->ServerNameLength &&
+        Entry->AlpnListLength == Key->AlpnListLength &&
+        memcmp(Entry->Key, Key->ServerName, Key->ServerNameLength) == 0 &&
+        memcmp(Entry->Key + Key->ServerNameLength, Key->AlpnList, Key->AlpnListLength) == 0;
+}
+
+//
+// Returns the entry for the server, if any. Must be called with the cache lock
+// held.
+//
+static
+QUIC_TICKET_CACHE_ENTRY*
+QuicTicketCacheFind(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ uint32_t Hash,
+    _In_ const QUIC_TICKET_CACHE_KEY* Key
+    )
+{
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* TableEntry =
+        CxPlatHashtableLookup(&Cache->Table, Hash, &Context);
+    while (TableEntry != NULL) {
+        QUIC_TICKET_CACHE_ENTRY* Entry =
+            CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_TICKET_CACHE_ENTRY, TableEntry);
+        if (QuicTicketCacheEntryMatches(Entry, Key)) {
+            return Entry;
+        }
+        TableEntry = CxPlatHashtableLookupNext(&Cache->Table, &Context);
+    }
+    return NULL;
+}
+
+static
+uint32_t
+QuicTicketCacheTicketSize(
+    _In_ uint32_t TicketLength
+    )
+{
+    return (uint32_t)sizeof(QUIC_TICKET_CACHE_TICKET) + TicketLength;
+}
+
+//
+// Unlinks a ticket from its entry, leaving it to the caller to free.
+//
+static
+void
+QuicTicketCacheUnlinkTicket(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ QUIC_TICKET_CACHE_ENTRY* Entry,
+    _In_ QUIC_TICKET_CACHE_TICKET* Ticket
+    )
+{
+    const uint32_t TicketSize = QuicTicketCacheTicketSize(Ticket->Length);
+    CxPlatListEntryRemove(&Ticket->Link);
+    Entry->TicketCount--;
+    Entry->Size -= TicketSize;
+    Cache->Size -= TicketSize;
+}
+
+//
+// Removes the entry along with any tickets it still has. Returns the number of
+// tickets freed.
+//
+static
+uint32_t
+QuicTicketCacheRemove(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ QUIC_TICKET_CACHE_ENTRY* Entry
+    )
+{
+    const uint32_t TicketCount = Entry->TicketCount;
+    while (!CxPlatListIsEmpty(&Entry->Tickets)) {
+        QUIC_TICKET_CACHE_TICKET* Ticket =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Entry->Tickets), QUIC_TICKET_CACHE_TICKET, Link);
+        CXPLAT_FREE(Ticket, QUIC_POOL_TICKET_CACHE);
+    }
+    CxPlatHashtableRemove(&Cache->Table, &Entry->TableEntry, NULL);
+    CxPlatListEntryRemove(&Entry->LruLink);
+    Cache->EntryCount--;
+    Cache->Size -= Entry->Size;
+    CXPLAT_FREE(Entry, QUIC_POOL_TICKET_CACHE);
+    return TicketCount;
+}
+
+//
+// Frees the entry's expired tickets and returns how many there were.
+//
+static
+uint32_t
+QuicTicketCacheDropExpired(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ QUIC_TICKET_CACHE_ENTRY* Entry,
+    _In_ uint64_t TimeNow
+    )
+{
+    uint32_t ExpiredCount = 0;
+    CXPLAT_LIST_ENTRY* Link = Entry->Tickets.Flink;
+    while (Link != &Entry->Tickets) {
+        QUIC_TICKET_CACHE_TICKET* Ticket =
+            CXPLAT_CONTAINING_RECORD(Link, QUIC_TICKET_CACHE_TICKET, Link);
+        Link = Link->Flink;
+        if (Ticket->Expiration <= TimeNow) {
+            QuicTicketCacheUnlinkTicket(Cache, Entry, Ticket);
+            CXPLAT_FREE(Ticket, QUIC_POOL_TICKET_CACHE);
+            ExpiredCount++;
+        }
+    }
+    return ExpiredCount;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicTicketCacheInitialize(
+    _Out_ QUIC_TICKET_CACHE* Cache,
+    _In_ uint64_t MaxSize
+    )
+{
+    //
+    // The cache may be uninitialized even if this fails.
+    //
+    CxPlatZeroMemory(Cache, sizeof(*Cache));
+    CxPlatDispatchLockInitialize(&Cache->Lock);
+    CxPlatListInitializeHead(&Cache->LruList);
+    Cache->MaxSize = MaxSize;
+    return CxPlatHashtableInitializeEx(&Cache->Table, CXPLAT_HASH_MIN_SIZE);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCacheUninitialize(
+    _Inout_ QUIC_TICKET_CACHE* Cache
+    )
+{
+    while (!CxPlatListIsEmpty(&Cache->LruList)) {
+        (void)QuicTicketCacheRemove(
+            Cache,
+            CXPLAT_CONTAINING_RECORD(
+                Cache->LruList.Flink, QUIC_TICKET_CACHE_ENTRY, LruLink));
+    }
+    CXPLAT_DBG_ASSERT(Cache->EntryCount == 0);
+    CXPLAT_DBG_ASSERT(Cache->Size == 0);
+    CxPlatHashtableUninitialize(&Cache->Table);
+    CxPlatDispatchLockUninitialize(&Cache->Lock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicTicketCacheSave(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_TICKET_CACHE_KEY* Key,
+    _In_ uint64_t TimeNow,
+    _In_ uint32_t Lifetime,
+    _In_ BOOLEAN EarlyDataAllowed,
+    _In_ uint32_t TicketLength,
+    _In_reads_(TicketLength)
+        const uint8_t* Ticket
+    )
+{
+    uint32_t DroppedCount = 0;
+    const uint32_t Hash = QuicTicketCacheHash(Key);
+    const uint32_t EntrySize =
+        (uint32_t)sizeof(QUIC_TICKET_CACHE_ENTRY) +
+        Key->ServerNameLength + Key->AlpnListLength;
+    const uint32_t TicketSize = QuicTicketCacheTicketSize(TicketLength);
+
+    if ((uint64_t)EntrySize + TicketSize > Cache->MaxSize) {
+        return 0; // Would never fit.
+    }
+
+    QUIC_TICKET_CACHE_TICKET* NewTicket =
+        CXPLAT_ALLOC_NONPAGED(TicketSize, QUIC_POOL_TICKET_CACHE);
+    if (NewTicket == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "ticket cache ticket",
+            TicketSize);
+        return 0;
+    }
+
+    const uint64_t LifetimeUs =
+        Lifetime == 0 ? QUIC_TICKET_CACHE_MAX_LIFETIME_US :
+            CXPLAT_MIN(S_TO_US((uint64_t)Lifetime), QUIC_TICKET_CACHE_MAX_LIFETIME_US);
+    NewTicket->Expiration = TimeNow + LifetimeUs;
+    NewTicket->EarlyDataAllowed = EarlyDataAllowed;
+    NewTicket->Length = TicketLength;
+    CxPlatCopyMemory(NewTicket->Buffer, Ticket, TicketLength);
+
+    CxPlatDispatchLockAcquire(&Cache->Lock);
+
+    QUIC_TICKET_CACHE_ENTRY* Entry = QuicTicketCacheFind(Cache, Hash, Key);
+    if (Entry != NULL) {
+        DroppedCount += QuicTicketCacheDropExpired(Cache, Entry, TimeNow);
+        if (Entry->TicketCount >= QUIC_TICKET_CACHE_MAX_TICKETS_PER_SERVER) {
+            QUIC_TICKET_CACHE_TICKET* Oldest =
+                CXPLAT_CONTAINING_RECORD(
+                    Entry->Tickets.Flink, QUIC_TICKET_CACHE_TICKET, Link);
+            QuicTicketCacheUnlinkTicket(Cache, Entry, Oldest);
+            CXPLAT_FREE(Oldest, QUIC_POOL_TICKET_CACHE);
+            DroppedCount++;
+        }
+        CxPlatListEntryRemove(&Entry->LruLink);
+
+    } else {
+        Entry = CXPLAT_ALLOC_NONPAGED(EntrySize, QUIC_POOL_TICKET_CACHE);
+        if (Entry == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "ticket cache entry",
+                EntrySize);
+            CXPLAT_FREE(NewTicket, QUIC_POOL_TICKET_CACHE);
+            goto Exit;
+        }
+
+        CxPlatListInitializeHead(&Entry->Tickets);
+        Entry->TicketCount = 0;
+        Entry->Size = EntrySize;
+        Entry->ServerPort = Key->ServerPort;
+        Entry->ServerNameLength = Key->ServerNameLength;
+        Entry->AlpnListLength = Key->AlpnListLength;
+        CxPlatCopyMemory(Entry->Key, Key->ServerName, Key->ServerNameLength);
+        CxPlatCopyMemory(
+            Entry->Key + Key->ServerNameLength, Key->AlpnList, Key->AlpnListLength);
+        CxPlatHashtableInsert(&Cache->Table, &Entry->TableEntry, Hash, NULL);
+        Cache->EntryCount++;
+        Cache->Size += EntrySize;
+    }
+
+    CxPlatListInsertTail(&Entry->Tickets, &NewTicket->Link);
+    Entry->TicketCount++;
+    Entry->Size += TicketSize;
+    Cache->Size += TicketSize;
+    CxPlatListInsertTail(&Cache->LruList, &Entry->LruLink);
+
+    //
+    // Make room, starting with the least recently used servers. The new ticket
+    // fits on its own, so this server only loses its older tickets if it is
+    // the only one left.
+    //
+    while (Cache->Size > Cache->MaxSize) {
+        QUIC_TICKET_CACHE_ENTRY* Lru =
+            CXPLAT_CONTAINING_RECORD(
+                Cache->LruList.Flink, QUIC_TICKET_CACHE_ENTRY, LruLink);
+        if (Lru != Entry) {
+            DroppedCount += QuicTicketCacheRemove(Cache, Lru);
+        } else {
+            QUIC_TICKET_CACHE_TICKET* Oldest =
+                CXPLAT_CONTAINING_RECORD(
+                    Entry->Tickets.Flink, QUIC_TICKET_CACHE_TICKET, Link);
+            CXPLAT_DBG_ASSERT(Oldest != NewTicket);
+            QuicTicketCacheUnlinkTicket(Cache, Entry, Oldest);
+            CXPLAT_FREE(Oldest, QUIC_POOL_TICKET_CACHE);
+            DroppedCount++;
+        }
+    }
+
+Exit:
+
+    CxPlatDispatchLockRelease(&Cache->Lock);
+
+    return DroppedCount;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_TICKET_CACHE_TICKET*
+QuicTicketCacheTake(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_TICKET_CACHE_KEY* Key,
+    _In_ uint64_t TimeNow,
+    _Out_ uint32_t* ExpiredCount
+    )
+{
+    QUIC_TICKET_CACHE_TICKET* Ticket = NULL;
+    const uint32_t Hash = QuicTicketCacheHash(Key);
+    *ExpiredCount = 0;
+
+    CxPlatDispatchLockAcquire(&Cache->Lock);
+
+    QUIC_TICKET_CACHE_ENTRY* Entry = QuicTicketCacheFind(Cache, Hash, Key);
+    if (Entry == NULL) {
+        goto Exit;
+    }
+
+    *ExpiredCount = QuicTicketCacheDropExpired(Cache, Entry, TimeNow);
+
+    //
+    // Newest first; fall back to the newest ticket if none allow 0-RTT.
+    //
+    for (CXPLAT_LIST_ENTRY* Link = Entry->Tickets.Blink;
+         Link != &Entry->Tickets;
+         Link = Link->Blink) {
+        QUIC_TICKET_CACHE_TICKET* Candidate =
+            CXPLAT_CONTAINING_RECORD(Link, QUIC_TICKET_CACHE_TICKET, Link);
+        if (Candidate->EarlyDataAllowed) {
+            Ticket = Candidate;
+            break;
+        }
+    }
+    if (Ticket == NULL && !CxPlatListIsEmpty(&Entry->Tickets)) {
+        Ticket =
+            CXPLAT_CONTAINING_RECORD(
+                Entry->Tickets.Blink, QUIC_TICKET_CACHE_TICKET, Link);
+    }
+
+    if (Ticket != NULL) {
+        QuicTicketCacheUnlinkTicket(Cache, Entry, Ticket);
+    }
+
+    if (Entry->TicketCount == 0) {
+        (void)QuicTicketCacheRemove(Cache, Entry);
+    } else {
+        CxPlatListEntryRemove(&Entry->LruLink);
+        CxPlatListInsertTail(&Cache->LruList, &Entry->LruLink);
+    }
+
+Exit:
+
+    CxPlatDispatchLockRelease(&Cache->Lock);
+
+    return Ticket;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTicketCacheFreeTicket(
+    _In_ QUIC_TICKET_CACHE_TICKET* Ticket
+    )
+{
+    CXPLAT_FREE(Ticket, QUIC_POOL_TICKET_CACHE);
+}
+
+//
+// Returns the key for the server the client connection was started for, if
+// the connection uses the cache.
+//
+static
+_Success_(return != FALSE)
+BOOLEAN
+QuicConnTicketCacheGetKey(
+    _In_ const QUIC_CONNECTION* Connection,
+    _Out_ QUIC_TICKET_CACHE_KEY* Key
+    )
+{
+    if (!Connection->Settings.ResumptionTicketCacheEnabled ||
+        !QuicConnIsClient(Connection) ||
+        Connection->Registration == NULL ||
+        Connection->Configuration == NULL ||
+        Connection->RemoteServerName == NULL) {
+        return FALSE;
+    }
+
+    Key->ServerName = Connection->RemoteServerName;
+    Key->ServerNameLength =
+        (uint16_t)strnlen(Connection->RemoteServerName, QUIC_MAX_SNI_LENGTH);
+    Key->AlpnList = Connection->Configuration->AlpnList;
+    Key->AlpnListLength = Connection->Configuration->AlpnListLength;
+    Key->ServerPort = QuicAddrGetPort(&Connection->Paths[0].Route.RemoteAddress);
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnTicketCacheResume(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_TICKET_CACHE_KEY Key;
+    if (!QuicConnTicketCacheGetKey(Connection, &Key)) {
+        return FALSE;
+    }
+
+    CXPLAT_DBG_ASSERT(Connection->Crypto.ResumptionTicket == NULL);
+    CXPLAT_DBG_ASSERT(Connection->Stats.QuicVersion == 0);
+
+    uint32_t ExpiredCount;
+    QUIC_TICKET_CACHE_TICKET* Ticket =
+        QuicTicketCacheTake(
+            &Connection->Registration->TicketCache,
+            &Key,
+            CxPlatTimeUs64(),
+            &ExpiredCount);
+    if (ExpiredCount != 0) {
+        QuicPerfCounterAdd(
+            Connection->Partition, QUIC_PERF_COUNTER_TICKET_CACHE_EVICT, ExpiredCount);
+    }
+    if (Ticket == NULL) {
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_TICKET_CACHE_MISS);
+        return FALSE;
+    }
+
+    //
+    // Decode into locals so nothing is left behind if the ticket turns out to
+    // be unusable, e.g. if its QUIC version is no longer supported.
+    //
+    QUIC_TRANSPORT_PARAMETERS ResumedTP;
+    CxPlatZeroMemory(&ResumedTP, sizeof(ResumedTP));
+    uint8_t* ServerTicket = NULL;
+    uint32_t ServerTicketLength = 0;
+    uint32_t QuicVersion = 0;
+    const BOOLEAN EarlyDataAllowed = Ticket->EarlyDataAllowed;
+
+    QUIC_STATUS Status =
+        QuicCryptoDecodeClientTicket(
+            Connection,
+            (uint16_t)Ticket->Length,
+            Ticket->Buffer,
+            &ResumedTP,
+            &ServerTicket,
+            &ServerTicketLength,
+            &QuicVersion);
+    QuicTicketCacheFreeTicket(Ticket);
+    if (QUIC_FAILED(Status)) {
+        QuicCryptoTlsCleanupTransportParameters(&ResumedTP);
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_TICKET_CACHE_MISS);
+        return FALSE;
+    }
+
+    Connection->PeerTransportParams = ResumedTP;
+    Connection->Crypto.ResumptionTicket = ServerTicket;
+    Connection->Crypto.ResumptionTicketLength = ServerTicketLength;
+    Connection->Stats.QuicVersion = QuicVersion;
+
+    QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_TICKET_CACHE_HIT);
+    QuicTraceLogConnInfo(
+        TicketCacheHit,
+        Connection,
+        "Resuming with a cached ticket, EarlyDataAllowed=%hhu",
+        EarlyDataAllowed);
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnTicketCacheSave(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint32_t TicketLength,
+    _In_reads_(TicketLength)
+        const uint8_t* Ticket,
+    _In_opt_ const CXPLAT_TLS_TICKET_INFO* TicketInfo
+    )
+{
+    QUIC_TICKET_CACHE_KEY Key;
+    if (!QuicConnTicketCacheGetKey(Connection, &Key)) {
+        return;
+    }
+
+    const uint32_t Lifetime = TicketInfo != NULL ? TicketInfo->Lifetime : 0;
+    const BOOLEAN EarlyDataAllowed =
+        TicketInfo != NULL && TicketInfo->EarlyDataAllowed;
+    const uint32_t DroppedCount =
+        QuicTicketCacheSave(
+            &Connection->Registration->TicketCache,
+            &Key,
+            CxPlatTimeUs64(),
+            Lifetime,
+            EarlyDataAllowed,
+            TicketLength,
+            Ticket);
+    if (DroppedCount != 0) {
+        QuicPerfCounterAdd(
+            Connection->Partition, QUIC_PERF_COUNTER_TICKET_CACHE_EVICT, DroppedCount);
+    }
+
+    QuicTraceLogConnVerbose(
+        TicketCacheSaved,
+        Connection,
+        "Resumption ticket cached, Lifetime=%u EarlyDataAllowed=%hhu",
+        Lifetime,
+        EarlyDataAllowed);
+}
@@ -0,0 +1,203 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Client resumption ticket cache, which lets a registration resume new
+    connections to servers it connected to before without the app having to
+    keep the tickets itself.
+
+--*/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Identifies the server a ticket was received from.
+//
+typedef struct QUIC_TICKET_CACHE_KEY {
+
+    _Field_size_(ServerNameLength)
+    const char* ServerName;
+
+    //
+    // TLS encoded ALPN list, as in the configuration.
+    //
+    _Field_size_(AlpnListLength)
+    const uint8_t* AlpnList;
+
+    uint16_t ServerNameLength;
+    uint16_t AlpnListLength;
+    uint16_t ServerPort; // Host byte order
+
+} QUIC_TICKET_CACHE_KEY;
+
+typedef struct QUIC_TICKET_CACHE_TICKET {
+
+    //
+    // Link in the server entry's list of tickets.
+    //
+    CXPLAT_LIST_ENTRY Link;
+
+    //
+    // Time after which the ticket can't be used, from CxPlatTimeUs64.
+    //
+    uint64_t Expiration;
+
+    //
+    // The server allows the ticket to be used for 0-RTT.
+    //
+    BOOLEAN EarlyDataAllowed;
+
+    //
+    // The encoded client ticket, as passed to QUIC_PARAM_CONN_RESUMPTION_TICKET.
+    //
+    uint32_t Length;
+    _Field_size_(Length)
+    uint8_t Buffer[0];
+
+} QUIC_TICKET_CACHE_TICKET;
+
+typedef struct QUIC_TICKET_CACHE_ENTRY {
+
+    //
+    // Link in the cache's hash table.
+    //
+    CXPLAT_HASHTABLE_ENTRY TableEntry;
+
+    //
+    // Link in the cache's least recently used list.
+    //
+    CXPLAT_LIST_ENTRY LruLink;
+
+    //
+    // Unused tickets, from oldest (head) to newest (tail).
+    //
+    CXPLAT_LIST_ENTRY Tickets;
+    uint32_t TicketCount;
+
+    //
+    // Bytes of the entry and its tickets counted against the cache's limit.
+    //
+    uint32_t Size;
+
+    uint16_t ServerPort;
+    uint16_t ServerNameLength;
+    uint16_t AlpnListLength;
+
+    //
+    // The server name followed by the ALPN list.
+    //
+    _Field_size_(ServerNameLength + AlpnListLength)
+    uint8_t Key[0];
+
+} QUIC_TICKET_CACHE_ENTRY;
+
+//
+// Per registration cache of client resumption tickets, keyed by server name,
+// port and ALPN list.
+//
+typedef struct QUIC_TICKET_CACHE {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    CXPLAT_HASHTABLE Table;
+
+    //
+    // Servers ordered from least (head) to most (tail) recently used.
+    //
+    CXPLAT_LIST_ENTRY LruList;
+
+    uint32_t EntryCount;
+
+    //
+    // Bytes used by all the entries, and the most they may use.
+    //
+    uint64_t Size;
+    uint64_t MaxSize;
+
+} QUIC_TICKET_CACHE;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicTicketCacheInitialize(
+    _Out_ QUIC_TICKET_CACHE* Cache,
+    _In_ uint64_t MaxSize
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCacheUninitialize(
+    _Inout_ QUIC_TICKET_CACHE* Cache
+    );
+
+//
+// Adds a ticket for the server, dropping its oldest tickets and the least
+// recently used servers as needed to stay within the limits. Lifetime is in
+// seconds, zero if unknown. Returns the number of tickets dropped unused.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicTicketCacheSave(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_TICKET_CACHE_KEY* Key,
+    _In_ uint64_t TimeNow,
+    _In_ uint32_t Lifetime,
+    _In_ BOOLEAN EarlyDataAllowed,
+    _In_ uint32_t TicketLength,
+    _In_reads_(TicketLength)
+        const uint8_t* Ticket
+    );
+
+//
+// Removes and returns an unexpired ticket for the server, preferring the
+// newest one that allows 0-RTT. The ticket must be freed with
+// QuicTicketCacheFreeTicket.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_TICKET_CACHE_TICKET*
+QuicTicketCacheTake(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_TICKET_CACHE_KEY* Key,
+    _In_ uint64_t TimeNow,
+    _Out_ uint32_t* ExpiredCount
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTicketCacheFreeTicket(
+    _In_ QUIC_TICKET_CACHE_TICKET* Ticket
+    );
+
+//
+// Connection glue.
+//
+
+//
+// Sets up the client to resume with a cached ticket. Returns TRUE if it did,
+// in which case the QUIC version and the peer's transport parameters have been
+// set from the ticket.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnTicketCacheResume(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnTicketCacheSave(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint32_t TicketLength,
+    _In_reads_(TicketLength)
+        const uint8_t* Ticket,
+    _In_opt_ const CXPLAT_TLS_TICKET_INFO* TicketInfo
+    );
+
+#if defined(__cplusplus)
+}
+#endif
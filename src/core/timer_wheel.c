@@ -21,28 +21,40 @@ Abstract:
         The timer wheel itself doesn't care about anything other than that value
         from the connection.
 
-        Slots - This is a very simple hash table of time slots. Each slot holds
-        all connections with a next expiration time modulo the total slot count.
+        Levels - The wheel is hierarchical. Time is measured in millisecond
+        ticks and each level has 64 slots, with each slot in level N covering
+        64^N ticks. A connection is placed in the lowest level whose span
+        covers the distance from the wheel's current tick to its expiration
+        tick. Anything further out than the top level goes in an overflow slot.
 
-        Slot Entry - Each slot is made up of a sorted, doubly-linked list of
-        connections.
+        Slot Entry - Each slot is an unsorted, doubly-linked list of
+        connections. A per-level bit mask tracks which slots might be non-empty
+        so that empty slots can be skipped without touching them.
 
         Next Expiration - Along with all the connections in the timer wheel, the
         timer wheel also explicitly keeps track of the next expiration time and
         connection for quick next delay calculations.
 
-    With these parts, the timer wheel is able to support insertion, update and
-    removal of any number of timers (and their associated connection).
+    With these parts, the timer wheel is able to support O(1) insertion, update
+    and removal of any number of timers (and their associated connection).
 
     Insertion or update consists of getting the next expiration time from the
-    connection, calculating the correct slot and then doing an insert into the
-    slot's sorted list of connections. Additionally, the next expiration is
+    connection, calculating the level and slot, and then appending the
+    connection to the slot's list. Additionally, the next expiration is
     updated if the new timer is the soonest to expire.
 
     Removal consists of removing the connection from the doubly-linked list and
     updating the timer wheel's next expiration if this connection was currently
     next to expire.
 
+    As the wheel's current tick advances, the slots of the upper levels that
+    are reached are 'cascaded' down by reinserting their connections, which
+    then land in lower levels. Each connection is moved at most once per level.
+    Only the level 0 slots hold connections expiring in a single tick, so the
+    next expiration is exact when the soonest timer is in level 0. Otherwise,
+    the start of the next upper level slot is used as a lower bound, and the
+    worker processes the cascade when that time is reached.
+
 --*/
 
 #include "precomp.h"
@@ -51,20 +63,25 @@ Abstract:
 #endif
 
 //
-// The initial count of slots in the timer wheel.
+// The total number of slots in the timer wheel, including the overflow slot.
 //
-#define QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT     32
+#define QUIC_TIMER_WHEEL_SLOT_COUNT \
+    (QUIC_TIMER_WHEEL_LEVEL_COUNT * QUIC_TIMER_WHEEL_LEVEL_SLOTS + 1)
+
+#define QUIC_TIMER_WHEEL_OVERFLOW_SLOT \
+    (QUIC_TIMER_WHEEL_LEVEL_COUNT * QUIC_TIMER_WHEEL_LEVEL_SLOTS)
 
 //
-// On average, the max number of connections per slot.
+// Helper to get the slot index (within the level) of a tick.
 //
-#define QUIC_TIMER_WHEEL_MAX_LOAD_FACTOR    32
+#define TICK_TO_SLOT_INDEX(Tick, Level) \
+    (uint32_t)(((Tick) >> ((Level) * QUIC_TIMER_WHEEL_LEVEL_BITS)) & (QUIC_TIMER_WHEEL_LEVEL_SLOTS - 1))
 
 //
-// Helper to get the slot index for a given time.
+// Helper to get the slot list head for a level and slot index.
 //
-#define TIME_TO_SLOT_INDEX(TimerWheel, TimeUs) \
-    ((US_TO_MS(TimeUs) / 1000) % (TimerWheel)->SlotCount)
+#define TIMER_WHEEL_SLOT(TimerWheel, Level, SlotIndex) \
+    (&(TimerWheel)->Slots[(Level) * QUIC_TIMER_WHEEL_LEVEL_SLOTS + (SlotIndex)])
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
@@ -75,18 +92,19 @@ QuicTimerWheelInitialize(
     TimerWheel->NextExpirationTime = UINT64_MAX;
     TimerWheel->ConnectionCount = 0;
     TimerWheel->NextConnection = NULL;
-    TimerWheel->SlotCount = QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT;
+    TimerWheel->CurrentTick = US_TO_MS(CxPlatTimeUs64());
+    CxPlatZeroMemory(TimerWheel->SlotMasks, sizeof(TimerWheel->SlotMasks));
     TimerWheel->Slots =
-        CXPLAT_ALLOC_NONPAGED(QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY), QUIC_POOL_TIMERWHEEL);
+        CXPLAT_ALLOC_NONPAGED(QUIC_TIMER_WHEEL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY), QUIC_POOL_TIMERWHEEL);
     if (TimerWheel->Slots == NULL) {
         QuicTraceEvent(
             AllocFailure,
             "Allocation of '%s' failed. (%llu bytes)", "timerwheel slots",
-            QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY));
+            QUIC_TIMER_WHEEL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY));
         return QUIC_STATUS_OUT_OF_MEMORY;
     }
 
-    for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
+    for (uint32_t i = 0; i < QUIC_TIMER_WHEEL_SLOT_COUNT; ++i) {
         CxPlatListInitializeHead(&TimerWheel->Slots[i]);
     }
 
@@ -100,7 +118,7 @@ QuicTimerWheelUninitialize(
     )
 {
     if (TimerWheel->Slots != NULL) {
-        for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
+        for (uint32_t i = 0; i < QUIC_TIMER_WHEEL_SLOT_COUNT; ++i) {
             CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[i];
             CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
             while (Entry != ListHead) {
@@ -123,88 +141,112 @@ QuicTimerWheelUninitialize(
     }
 }
 
+//
+// Returns the index of the first non-empty slot in the level, at or after
+// FirstSlotIndex, or QUIC_TIMER_WHEEL_LEVEL_SLOTS if there isn't one. Clears
+// any stale bits it finds along the way.
+//
 _IRQL_requires_max_(PASSIVE_LEVEL)
-void
-QuicTimerWheelResize(
-    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+uint32_t
+QuicTimerWheelFindSlot(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _In_ uint32_t Level,
+    _In_ uint32_t FirstSlotIndex
     )
 {
-    uint32_t NewSlotCount = TimerWheel->SlotCount * 2;
-    if (NewSlotCount <= TimerWheel->SlotCount) {
+    while (FirstSlotIndex < QUIC_TIMER_WHEEL_LEVEL_SLOTS) {
+        uint64_t Mask = TimerWheel->SlotMasks[Level] & (UINT64_MAX << FirstSlotIndex);
+        if (Mask == 0) {
+            break;
+        }
+
         //
-        // Max size has been reached.
+        // Find the index of the lowest set bit.
         //
-        return;
-    }
-
-    CXPLAT_LIST_ENTRY* NewSlots =
-        CXPLAT_ALLOC_NONPAGED(NewSlotCount * sizeof(CXPLAT_LIST_ENTRY), QUIC_POOL_TIMERWHEEL);
-    if (NewSlots == NULL) {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)", "timerwheel slots (realloc)",
-            NewSlotCount * sizeof(CXPLAT_LIST_ENTRY));
-        return;
-    }
+        Mask &= (0 - Mask);
+        uint32_t SlotIndex = 0;
+        for (uint32_t Shift = QUIC_TIMER_WHEEL_LEVEL_SLOTS / 2; Shift != 0; Shift /= 2) {
+            if (Mask >> Shift) {
+                Mask >>= Shift;
+                SlotIndex += Shift;
+            }
+        }
 
-    QuicTraceLogVerbose(
-        TimerWheelResize,
-        "[time][%p] Resizing timer wheel (new slot count = %u).",
-        TimerWheel,
-        NewSlotCount);
+        if (!CxPlatListIsEmpty(TIMER_WHEEL_SLOT(TimerWheel, Level, SlotIndex))) {
+            return SlotIndex;
+        }
 
-    for (uint32_t i = 0; i < NewSlotCount; ++i) {
-        CxPlatListInitializeHead(&NewSlots[i]);
+        TimerWheel->SlotMasks[Level] &= ~(1ull << SlotIndex);
+        FirstSlotIndex = SlotIndex + 1;
     }
+    return QUIC_TIMER_WHEEL_LEVEL_SLOTS;
+}
 
-    uint32_t OldSlotCount = TimerWheel->SlotCount;
-    CXPLAT_LIST_ENTRY* OldSlots = TimerWheel->Slots;
-
-    TimerWheel->SlotCount = NewSlotCount;
-    TimerWheel->Slots = NewSlots;
-
-    for (uint32_t i = 0; i < OldSlotCount; ++i) {
+//
+// Adds the connection to the slot for its expiration time, relative to the
+// current tick of the timer wheel.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelInsert(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    uint64_t Tick = US_TO_MS(Connection->EarliestExpirationTime);
+    if (Tick < TimerWheel->CurrentTick) {
         //
-        // Iterate through each old slot, remove all connections and add them
-        // to the new slots.
+        // Already expired timers go in the current slot.
         //
-        while (!CxPlatListIsEmpty(&OldSlots[i])) {
-            QUIC_CONNECTION* Connection =
-                CXPLAT_CONTAINING_RECORD(
-                    CxPlatListRemoveHead(&OldSlots[i]),
-                    QUIC_CONNECTION,
-                    TimerLink);
-            uint64_t ExpirationTime = Connection->EarliestExpirationTime;
-            CXPLAT_DBG_ASSERT(TimerWheel->SlotCount != 0);
-            uint32_t SlotIndex = TIME_TO_SLOT_INDEX(TimerWheel, ExpirationTime);
-
-            //
-            // Insert the connection into the slot, in the correct order. We search
-            // the slot's list in reverse order, with the assumption that most new
-            // timers will on average be later than existing ones.
-            //
-            CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[SlotIndex];
-            CXPLAT_LIST_ENTRY* Entry = ListHead->Blink;
-
-            while (Entry != ListHead) {
-                QUIC_CONNECTION* ConnectionEntry =
-                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
-                uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
+        Tick = TimerWheel->CurrentTick;
+    }
 
-                if (ExpirationTime > EntryExpirationTime) {
-                    break;
-                }
+    //
+    // The level is the highest group of bits that differ from the current
+    // tick, so that the slot is reached exactly when the current tick
+    // advances into it.
+    //
+    uint64_t Difference = Tick ^ TimerWheel->CurrentTick;
+    uint32_t Level = 0;
+    while (Level < QUIC_TIMER_WHEEL_LEVEL_COUNT &&
+           (Difference >> ((Level + 1) * QUIC_TIMER_WHEEL_LEVEL_BITS)) != 0) {
+        Level++;
+    }
 
-                Entry = Entry->Blink;
-            }
+    if (Level == QUIC_TIMER_WHEEL_LEVEL_COUNT) {
+        CxPlatListInsertTail(
+            &TimerWheel->Slots[QUIC_TIMER_WHEEL_OVERFLOW_SLOT],
+            &Connection->TimerLink);
+    } else {
+        uint32_t SlotIndex = TICK_TO_SLOT_INDEX(Tick, Level);
+        CxPlatListInsertTail(
+            TIMER_WHEEL_SLOT(TimerWheel, Level, SlotIndex),
+            &Connection->TimerLink);
+        TimerWheel->SlotMasks[Level] |= (1ull << SlotIndex);
+    }
+}
 
-            //
-            // Insert after the current entry.
-            //
-            CxPlatListInsertHead(Entry, &Connection->TimerLink);
+//
+// Finds the connection with the earliest expiration time in the list.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_CONNECTION*
+QuicTimerWheelFindEarliest(
+    _In_ CXPLAT_LIST_ENTRY* ListHead
+    )
+{
+    QUIC_CONNECTION* Earliest = NULL;
+    for (CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
+         Entry != ListHead;
+         Entry = Entry->Flink) {
+        QUIC_CONNECTION* ConnectionEntry =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+        if (Earliest == NULL ||
+            ConnectionEntry->EarliestExpirationTime < Earliest->EarliestExpirationTime) {
+            Earliest = ConnectionEntry;
         }
     }
-    CXPLAT_FREE(OldSlots, QUIC_POOL_TIMERWHEEL);
+    return Earliest;
 }
 
 //
@@ -220,26 +262,53 @@ QuicTimerWheelUpdate(
     TimerWheel->NextExpirationTime = UINT64_MAX;
     TimerWheel->NextConnection = NULL;
 
-    //
-    // Loop over the slots to find the connection with the earliest
-    // expiration time.
-    //
-    for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
-        if (!CxPlatListIsEmpty(&TimerWheel->Slots[i])) {
-            QUIC_CONNECTION* ConnectionEntry =
-                CXPLAT_CONTAINING_RECORD(
-                    TimerWheel->Slots[i].Flink,
-                    QUIC_CONNECTION,
-                    TimerLink);
-            uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
-            if (EntryExpirationTime < TimerWheel->NextExpirationTime) {
-                TimerWheel->NextExpirationTime = EntryExpirationTime;
-                TimerWheel->NextConnection = ConnectionEntry;
+    if (TimerWheel->ConnectionCount != 0) {
+        //
+        // The first non-empty slot in level 0 holds the earliest timers, but
+        // they aren't sorted, so search the slot for the earliest one.
+        //
+        uint32_t SlotIndex =
+            QuicTimerWheelFindSlot(
+                TimerWheel, 0, TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, 0));
+        if (SlotIndex != QUIC_TIMER_WHEEL_LEVEL_SLOTS) {
+            TimerWheel->NextConnection =
+                QuicTimerWheelFindEarliest(TIMER_WHEEL_SLOT(TimerWheel, 0, SlotIndex));
+            TimerWheel->NextExpirationTime =
+                TimerWheel->NextConnection->EarliestExpirationTime;
+        } else {
+            //
+            // Upper levels aren't searched. The time the next non-empty slot
+            // is reached (and cascaded) is used as a lower bound instead.
+            //
+            for (uint32_t Level = 1; Level < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++Level) {
+                uint32_t Shift = Level * QUIC_TIMER_WHEEL_LEVEL_BITS;
+                SlotIndex =
+                    QuicTimerWheelFindSlot(
+                        TimerWheel,
+                        Level,
+                        TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, Level) + 1);
+                if (SlotIndex != QUIC_TIMER_WHEEL_LEVEL_SLOTS) {
+                    uint64_t Tick =
+                        ((TimerWheel->CurrentTick >> (Shift + QUIC_TIMER_WHEEL_LEVEL_BITS))
+                            << (Shift + QUIC_TIMER_WHEEL_LEVEL_BITS)) |
+                        ((uint64_t)SlotIndex << Shift);
+                    TimerWheel->NextExpirationTime = MS_TO_US(Tick);
+                    break;
+                }
+            }
+
+            if (TimerWheel->NextExpirationTime == UINT64_MAX) {
+                TimerWheel->NextConnection =
+                    QuicTimerWheelFindEarliest(
+                        &TimerWheel->Slots[QUIC_TIMER_WHEEL_OVERFLOW_SLOT]);
+                CXPLAT_DBG_ASSERT(TimerWheel->NextConnection != NULL);
+                TimerWheel->NextExpirationTime =
+                    TimerWheel->NextConnection->EarliestExpirationTime;
             }
         }
     }
 
-    if (TimerWheel->NextConnection == NULL) {
+    if (TimerWheel->NextExpirationTime == UINT64_MAX) {
         QuicTraceLogVerbose(
             TimerWheelNextExpirationNull,
             "[time][%p] Next Expiration = {NULL}.",
@@ -275,7 +344,8 @@ QuicTimerWheelRemoveConnection(
         Connection->TimerLink.Flink = NULL;
         TimerWheel->ConnectionCount--;
 
-        if (Connection == TimerWheel->NextConnection) {
+        if (Connection == TimerWheel->NextConnection ||
+            TimerWheel->ConnectionCount == 0) {
             QuicTimerWheelUpdate(TimerWheel);
         }
 
@@ -308,13 +378,14 @@ QuicTimerWheelUpdateConnection(
                 "[time][%p] Removing Connection %p.",
                 TimerWheel,
                 Connection);
+            TimerWheel->ConnectionCount--;
 
-            if (Connection == TimerWheel->NextConnection) {
+            if (Connection == TimerWheel->NextConnection ||
+                TimerWheel->ConnectionCount == 0) {
                 QuicTimerWheelUpdate(TimerWheel);
             }
 
             QuicConnRelease(Connection, QUIC_CONN_REF_TIMER_WHEEL);
-            TimerWheel->ConnectionCount--;
             return; // Nothing else to do.
         }
 
@@ -335,33 +406,7 @@ QuicTimerWheelUpdateConnection(
 
     CXPLAT_DBG_ASSERT(ExpirationTime != UINT64_MAX);
     CXPLAT_DBG_ASSERT(!Connection->State.ShutdownComplete);
-    CXPLAT_DBG_ASSERT(TimerWheel->SlotCount != 0);
-    uint32_t SlotIndex = TIME_TO_SLOT_INDEX(TimerWheel, ExpirationTime);
-
-    //
-    // Insert the connection into the slot, in the correct order. We search
-    // the slot's list in reverse order, with the assumption that most new
-    // timers will on average be later than existing ones.
-    //
-    CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[SlotIndex];
-    CXPLAT_LIST_ENTRY* Entry = ListHead->Blink;
-
-    while (Entry != ListHead) {
-        QUIC_CONNECTION* ConnectionEntry =
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
-        uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
-
-        if (ExpirationTime > EntryExpirationTime) {
-            break;
-        }
-
-        Entry = Entry->Blink;
-    }
-
-    //
-    // Insert after the current entry.
-    //
-    CxPlatListInsertHead(Entry, &Connection->TimerLink);
+    QuicTimerWheelInsert(TimerWheel, Connection);
 
     QuicTraceLogVerbose(
         TimerWheelUpdateConnection,
@@ -384,17 +429,104 @@ QuicTimerWheelUpdateConnection(
     } else if (Connection == TimerWheel->NextConnection) {
         QuicTimerWheelUpdate(TimerWheel);
     }
+}
+
+//
+// Reinserts all the connections in the slot, relative to the current tick.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelCascade(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ CXPLAT_LIST_ENTRY* ListHead
+    )
+{
+    CXPLAT_LIST_ENTRY Cascade;
+    CxPlatListInitializeHead(&Cascade);
+    CxPlatListMoveItems(ListHead, &Cascade);
+    while (!CxPlatListIsEmpty(&Cascade)) {
+        QuicTimerWheelInsert(
+            TimerWheel,
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Cascade),
+                QUIC_CONNECTION,
+                TimerLink));
+    }
+}
+
+//
+// Moves the current tick forward to NewTick, cascading the upper level slots
+// (and overflow slot) that are reached on the way. The caller guarantees that
+// all non-empty slots before NewTick have already been processed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelAdvance(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _In_ uint64_t NewTick
+    )
+{
+    uint64_t Difference = TimerWheel->CurrentTick ^ NewTick;
+    TimerWheel->CurrentTick = NewTick;
+
+    if ((Difference >> (QUIC_TIMER_WHEEL_LEVEL_COUNT * QUIC_TIMER_WHEEL_LEVEL_BITS)) != 0) {
+        QuicTimerWheelCascade(
+            TimerWheel, &TimerWheel->Slots[QUIC_TIMER_WHEEL_OVERFLOW_SLOT]);
+    }
 
     //
-    // Resize the timer wheel if we have too many connections for the
-    // current size.
+    // Cascade from the top down, so that connections moving down multiple
+    // levels are cascaded again as needed.
     //
-    if (TimerWheel->ConnectionCount >
-        TimerWheel->SlotCount * QUIC_TIMER_WHEEL_MAX_LOAD_FACTOR) {
-        QuicTimerWheelResize(TimerWheel);
+    for (uint32_t Level = QUIC_TIMER_WHEEL_LEVEL_COUNT - 1; Level > 0; --Level) {
+        if ((Difference >> (Level * QUIC_TIMER_WHEEL_LEVEL_BITS)) != 0) {
+            uint32_t SlotIndex = TICK_TO_SLOT_INDEX(NewTick, Level);
+            if (TimerWheel->SlotMasks[Level] & (1ull << SlotIndex)) {
+                TimerWheel->SlotMasks[Level] &= ~(1ull << SlotIndex);
+                QuicTimerWheelCascade(
+                    TimerWheel, TIMER_WHEEL_SLOT(TimerWheel, Level, SlotIndex));
+            }
+        }
     }
 }
 
+//
+// Returns the next tick, after the current one, that has a non-empty slot to
+// process, or UINT64_MAX if there is none.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+QuicTimerWheelNextTick(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+    )
+{
+    //
+    // Any slot found in a lower level is always reached before the slots of
+    // the levels above it.
+    //
+    for (uint32_t Level = 0; Level < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++Level) {
+        uint32_t Shift = Level * QUIC_TIMER_WHEEL_LEVEL_BITS;
+        uint32_t SlotIndex =
+            QuicTimerWheelFindSlot(
+                TimerWheel,
+                Level,
+                TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, Level) + 1);
+        if (SlotIndex != QUIC_TIMER_WHEEL_LEVEL_SLOTS) {
+            return
+                ((TimerWheel->CurrentTick >> (Shift + QUIC_TIMER_WHEEL_LEVEL_BITS))
+                    << (Shift + QUIC_TIMER_WHEEL_LEVEL_BITS)) |
+                ((uint64_t)SlotIndex << Shift);
+        }
+    }
+
+    //
+    // Only the overflow slot is left, so skip straight to its earliest timer.
+    //
+    QUIC_CONNECTION* Earliest =
+        QuicTimerWheelFindEarliest(&TimerWheel->Slots[QUIC_TIMER_WHEEL_OVERFLOW_SLOT]);
+    return Earliest == NULL ? UINT64_MAX : US_TO_MS(Earliest->EarliestExpirationTime);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicTimerWheelGetExpired(
@@ -403,33 +535,45 @@ QuicTimerWheelGetExpired(
     _Inout_ CXPLAT_LIST_ENTRY* OutputListHead
     )
 {
+    uint64_t NowTick = US_TO_MS(TimeNow);
+    if (NowTick < TimerWheel->CurrentTick) {
+        NowTick = TimerWheel->CurrentTick;
+    }
+
+    if (TimerWheel->ConnectionCount == 0) {
+        TimerWheel->CurrentTick = NowTick;
+        return;
+    }
+
     //
-    // Iterate through every slot to find all the connections that now have
-    // expired timers.
+    // Walk forward through only the non-empty slots, up to the current time,
+    // collecting all the connections that now have expired timers.
     //
-    BOOLEAN NeedsUpdate = FALSE;
-    for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
-        CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[i];
+    for (;;) {
+        uint32_t SlotIndex = TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, 0);
+        CXPLAT_LIST_ENTRY* ListHead = TIMER_WHEEL_SLOT(TimerWheel, 0, SlotIndex);
         CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
         while (Entry != ListHead) {
             QUIC_CONNECTION* ConnectionEntry =
                 CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
-            uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
-            if (EntryExpirationTime > TimeNow) {
-                break;
-            }
             Entry = Entry->Flink;
+            if (ConnectionEntry->EarliestExpirationTime > TimeNow) {
+                continue;
+            }
             CxPlatListEntryRemove(&ConnectionEntry->TimerLink);
             CxPlatListInsertTail(OutputListHead, &ConnectionEntry->TimerLink);
-            if (ConnectionEntry == TimerWheel->NextConnection) {
-                NeedsUpdate = TRUE;
-            }
             QuicConnAddRef(ConnectionEntry, QUIC_CONN_REF_WORKER);
             QuicConnRelease(ConnectionEntry, QUIC_CONN_REF_TIMER_WHEEL);
             TimerWheel->ConnectionCount--;
         }
+
+        if (TimerWheel->CurrentTick == NowTick) {
+            break;
+        }
+
+        uint64_t NextTick = QuicTimerWheelNextTick(TimerWheel);
+        QuicTimerWheelAdvance(TimerWheel, CXPLAT_MIN(NextTick, NowTick));
     }
-    if (NeedsUpdate) {
-        QuicTimerWheelUpdate(TimerWheel);
-    }
+
+    QuicTimerWheelUpdate(TimerWheel);
 }
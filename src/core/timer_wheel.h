@@ -7,10 +7,32 @@
 
 typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// The number of bits of the tick (millisecond) value covered by each level.
+//
+#define QUIC_TIMER_WHEEL_LEVEL_BITS     6
+
+//
+// The number of slots in each level of the timer wheel.
+//
+#define QUIC_TIMER_WHEEL_LEVEL_SLOTS    (1 << QUIC_TIMER_WHEEL_LEVEL_BITS)
+
+//
+// The number of levels in the timer wheel. Timers further out than the top
+// level can represent (2^24 ms, about 4.6 hours) go in an overflow slot.
+//
+#define QUIC_TIMER_WHEEL_LEVEL_COUNT    4
+
 typedef struct QUIC_TIMER_WHEEL {
 
     //
-    // The expiration time (in us) for the next timer in the timer wheel.
+    // The expiration time (in us) for the next timer in the timer wheel. This
+    // may be a lower bound if the next timer is still in one of the upper
+    // levels of the wheel.
     //
     uint64_t NextExpirationTime;
 
@@ -20,17 +42,26 @@ typedef struct QUIC_TIMER_WHEEL {
     uint64_t ConnectionCount;
 
     //
-    // The connection with the timer that expires next.
+    // The connection with the timer that expires next. NULL if the wheel is
+    // empty or NextExpirationTime is only a lower bound.
     //
     QUIC_CONNECTION* NextConnection;
 
     //
-    // The number of slots in the Slots array.
+    // The current time (in ms) of the timer wheel. All slots before this tick
+    // have already been processed.
     //
-    uint32_t SlotCount;
+    uint64_t CurrentTick;
 
     //
-    // An array of slots in the timer wheel.
+    // Bit masks of the (possibly) non-empty slots in each level. Bits are set
+    // on insert and only cleared lazily when a slot is found to be empty.
+    //
+    uint64_t SlotMasks[QUIC_TIMER_WHEEL_LEVEL_COUNT];
+
+    //
+    // An array of QUIC_TIMER_WHEEL_LEVEL_COUNT levels, each with
+    // QUIC_TIMER_WHEEL_LEVEL_SLOTS slots, followed by the overflow slot.
     //
     CXPLAT_LIST_ENTRY* Slots;
 
@@ -85,3 +116,7 @@ QuicTimerWheelGetExpired(
     _In_ uint64_t TimeNow,
     _Inout_ CXPLAT_LIST_ENTRY* ListHead
     );
+
+#if defined(__cplusplus)
+}
+#endif
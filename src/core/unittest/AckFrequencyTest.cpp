@@ -0,0 +1,61 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the ACK frequency requested from the peer.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "AckFrequencyTest.cpp.clog.h"
+#endif
+
+#define MIN_ACK_DELAY_US 1000
+#define MAX_ACK_DELAY_US 25000
+
+TEST(AckFrequencyTest, SmallWindowUsesMinimum)
+{
+    uint64_t AckDelay;
+    ASSERT_EQ(
+        QUIC_MIN_ACK_SEND_NUMBER,
+        QuicConnComputeAckFrequency(
+            10 * 1200, 1200, 20000, MIN_ACK_DELAY_US, MAX_ACK_DELAY_US, &AckDelay));
+    ASSERT_EQ(5000ull, AckDelay);
+}
+
+TEST(AckFrequencyTest, QuarterOfWindow)
+{
+    uint64_t AckDelay;
+    ASSERT_EQ(
+        25,
+        QuicConnComputeAckFrequency(
+            100 * 1200, 1200, 20000, MIN_ACK_DELAY_US, MAX_ACK_DELAY_US, &AckDelay));
+    ASSERT_EQ(
+        50,
+        QuicConnComputeAckFrequency(
+            200 * 1200, 1200, 20000, MIN_ACK_DELAY_US, MAX_ACK_DELAY_US, &AckDelay));
+}
+
+TEST(AckFrequencyTest, LargeWindowIsCapped)
+{
+    uint64_t AckDelay;
+    ASSERT_EQ(
+        UINT8_MAX,
+        QuicConnComputeAckFrequency(
+            UINT32_MAX, 1200, 20000, MIN_ACK_DELAY_US, MAX_ACK_DELAY_US, &AckDelay));
+}
+
+TEST(AckFrequencyTest, AckDelayBounds)
+{
+    uint64_t AckDelay;
+    QuicConnComputeAckFrequency(
+        100000, 1200, 1000, MIN_ACK_DELAY_US, MAX_ACK_DELAY_US, &AckDelay);
+    ASSERT_EQ((uint64_t)MIN_ACK_DELAY_US, AckDelay);
+    QuicConnComputeAckFrequency(
+        100000, 1200, 1000000, MIN_ACK_DELAY_US, MAX_ACK_DELAY_US, &AckDelay);
+    ASSERT_EQ((uint64_t)MAX_ACK_DELAY_US, AckDelay);
+}
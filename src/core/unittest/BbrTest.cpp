@@ -16,6 +16,7 @@ Abstract:
 
 extern "C" {
 void BbrCongestionControlInitialize(QUIC_CONGESTION_CONTROL* Cc, const QUIC_SETTINGS_INTERNAL* Settings);
+void Bbr3CongestionControlInitialize(QUIC_CONGESTION_CONTROL* Cc, const QUIC_SETTINGS_INTERNAL* Settings);
 uint64_t BbrCongestionControlGetBandwidth(const QUIC_CONGESTION_CONTROL* Cc);
 uint32_t BbrCongestionControlGetTargetCwnd(QUIC_CONGESTION_CONTROL* Cc, uint32_t Gain);
 }
@@ -30,6 +31,13 @@ enum BBR_STATE {
     BBR_STATE_PROBE_RTT = 3
 };
 
+enum BBR3_PROBE_BW_PHASE {
+    BBR3_PROBE_BW_DOWN   = 0,
+    BBR3_PROBE_BW_CRUISE = 1,
+    BBR3_PROBE_BW_REFILL = 2,
+    BBR3_PROBE_BW_UP     = 3
+};
+
 enum RECOVERY_STATE {
     RECOVERY_STATE_NOT_RECOVERY = 0,
     RECOVERY_STATE_CONSERVATIVE = 1,
@@ -184,6 +192,15 @@ protected:
         Bbr = &CC->Bbr;
     }
 
+    void InitializeVersion3()
+    {
+        Settings.InitialWindowPackets = 10;
+        InitBbrMockConnection(Connection, 1280);
+        CC = &Connection.CongestionControl;
+        Bbr3CongestionControlInitialize(CC, &Settings);
+        Bbr = &CC->Bbr;
+    }
+
     //
     // Helper: Pump a bandwidth sample into the BBR filter via OnDataAcknowledged.
     // Constructs packet metadata so that BbrBandwidthFilterOnPacketAcked
@@ -2220,3 +2237,200 @@ TEST_F(BbrTest_DeepTest, SetExemption_Zero)
     CC->QuicCongestionControlSetExemption(CC, 0);
     ASSERT_EQ(CC->QuicCongestionControlGetExemptions(CC), 0u);
 }
+
+//====================================================================
+//
+//  BBRv3 tests
+//
+//  These tests validate the BBRv3 additions: the InflightHi and
+//  InflightLo bounds, the DOWN/CRUISE/REFILL/UP cycle of PROBE_BW
+//  and the reaction to loss and ECN.
+//
+//  Reference:
+//    https://datatracker.ietf.org/doc/html/draft-ietf-ccwg-bbr
+//
+//====================================================================
+
+//
+// Test: BBRv3 Initialize - Default State
+// Scenario: Initializes BBRv3. It starts in STARTUP with the v3 gains, no
+// inflight bounds and an ECN handler.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_Initialize_DefaultState)
+{
+    InitializeVersion3();
+
+    ASSERT_STREQ(CC->Name, "BBRv3");
+    ASSERT_TRUE(Bbr->IsVersion3);
+    ASSERT_NE(CC->QuicCongestionControlOnEcn, nullptr);
+    ASSERT_EQ(Bbr->BbrState, (uint32_t)BBR_STATE_STARTUP);
+    ASSERT_EQ(Bbr->PacingGain, (uint32_t)(256 * 277 / 100));
+    ASSERT_EQ(Bbr->CwndGain, (uint32_t)(256 * 2));
+    ASSERT_EQ(Bbr->InflightHi, UINT32_MAX);
+    ASSERT_EQ(Bbr->InflightLo, UINT32_MAX);
+    ASSERT_EQ(Bbr->EcnAlpha, (uint32_t)256);
+}
+
+//
+// Test: BBRv3 Reset - Clears The Inflight Bounds
+// Scenario: Sets the inflight bounds and resets. The bounds are cleared and
+// BBRv3 stays BBRv3.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_Reset_ClearsBounds)
+{
+    InitializeVersion3();
+    Bbr->InflightHi = 50000;
+    Bbr->InflightLo = 40000;
+
+    CC->QuicCongestionControlReset(CC, TRUE);
+
+    ASSERT_TRUE(Bbr->IsVersion3);
+    ASSERT_EQ(Bbr->InflightHi, UINT32_MAX);
+    ASSERT_EQ(Bbr->InflightLo, UINT32_MAX);
+    ASSERT_EQ(Bbr->BbrState, (uint32_t)BBR_STATE_STARTUP);
+}
+
+//
+// Test: BBRv3 OnEcn - Counts CE Marks Once Per Round
+// Scenario: Reports CE marks twice in the same round. Both are counted, but
+// only the first one is a congestion event.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_OnEcn_CountsCePackets)
+{
+    InitializeVersion3();
+    CC->QuicCongestionControlOnDataSent(CC, 10000);
+
+    QUIC_ECN_EVENT Ecn{};
+    Ecn.LargestPacketNumberAcked = 3;
+    Ecn.LargestSentPacketNumber = 8;
+    Ecn.NumCePackets = 3;
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    Ecn.NumCePackets = 2;
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+
+    ASSERT_TRUE(Bbr->EcnInRound);
+    ASSERT_EQ(Bbr->CePacketsInRound, 5u);
+    ASSERT_EQ(Connection.Stats.Send.CongestionCount, 1u);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 1u);
+}
+
+//
+// Test: BBRv3 STARTUP - A Single Loss Burst Doesn't End STARTUP
+// Scenario: Loses more than 2% of the bytes in flight in one loss event, then
+// in several more. STARTUP only ends once there were enough loss events in
+// the round; InflightHi is then set to at least the bytes in flight.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_Startup_LossTooHighNeedsSeveralEvents)
+{
+    InitializeVersion3();
+    CC->QuicCongestionControlOnDataSent(CC, 12000);
+
+    QUIC_LOSS_EVENT Loss = MakeBbrLossEvent(1200, 5, 10);
+    CC->QuicCongestionControlOnDataLost(CC, &Loss);
+    ASSERT_EQ(Bbr->InflightHi, UINT32_MAX);
+    ASSERT_FALSE(Bbr->InflightTooHigh);
+
+    uint32_t BytesInFlight = 0;
+    for (uint64_t i = 0; i < 5 && !Bbr->InflightTooHigh; i++) {
+        BytesInFlight = Bbr->BytesInFlight;
+        Loss = MakeBbrLossEvent(100, 6 + i, 10);
+        CC->QuicCongestionControlOnDataLost(CC, &Loss);
+    }
+    ASSERT_TRUE(Bbr->InflightTooHigh);
+    ASSERT_GE(Bbr->InflightHi, BytesInFlight);
+
+    CC->QuicCongestionControlOnDataSent(CC, 1200);
+    QUIC_ACK_EVENT Ack = MakeBbrAckEvent(1000000, 11, 12, 1200);
+    CC->QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+    ASSERT_TRUE(Bbr->BtlbwFound);
+}
+
+//
+// Test: BBRv3 PROBE_BW - Entered In The DOWN Phase
+// Scenario: Drives BBRv3 out of STARTUP. PROBE_BW starts by draining in the
+// DOWN phase, with a random wait of 2 to 3 seconds before the next probe.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_ProbeBw_StartsInDown)
+{
+    InitializeVersion3();
+    DriveToBtlbwFound();
+
+    ASSERT_EQ(Bbr->BbrState, (uint32_t)BBR_STATE_PROBE_BW);
+    ASSERT_EQ(Bbr->ProbeBwPhase, (uint32_t)BBR3_PROBE_BW_DOWN);
+    ASSERT_EQ(Bbr->PacingGain, (uint32_t)(256 * 90 / 100));
+    ASSERT_GE(Bbr->ProbeWaitTime, 2000000u);
+    ASSERT_LT(Bbr->ProbeWaitTime, 3000000u);
+}
+
+//
+// Test: BBRv3 PROBE_BW - Loss While Probing Up Sets InflightHi
+// Scenario: In the UP phase, more than 2% of the bytes in flight are lost.
+// InflightHi is set to the bytes in flight and the next ACK moves PROBE_BW
+// to the DOWN phase.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_ProbeBw_LossWhileProbingUp)
+{
+    InitializeVersion3();
+    uint64_t TimeNow = DriveToBtlbwFound();
+    ASSERT_EQ(Bbr->BbrState, (uint32_t)BBR_STATE_PROBE_BW);
+    Bbr->ProbeBwPhase = BBR3_PROBE_BW_UP;
+
+    CC->QuicCongestionControlOnDataSent(CC, 60000);
+    uint32_t BytesInFlight = Bbr->BytesInFlight;
+    QUIC_LOSS_EVENT Loss = MakeBbrLossEvent(3000, 100, 110);
+    CC->QuicCongestionControlOnDataLost(CC, &Loss);
+
+    ASSERT_TRUE(Bbr->InflightTooHigh);
+    ASSERT_EQ(Bbr->InflightHi, CXPLAT_MAX(BytesInFlight, BbrCongestionControlGetTargetCwnd(CC, 256) * 7 / 10));
+
+    QUIC_ACK_EVENT Ack = MakeBbrAckEvent(TimeNow + 1000, 101, 110, 1200);
+    CC->QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+    ASSERT_EQ(Bbr->ProbeBwPhase, (uint32_t)BBR3_PROBE_BW_DOWN);
+}
+
+//
+// Test: BBRv3 PROBE_BW - Congestion Window Bounded By InflightLo
+// Scenario: In PROBE_BW with InflightLo below the congestion window, an ACK
+// bounds the congestion window by InflightLo.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_ProbeBw_InflightLoBoundsWindow)
+{
+    InitializeVersion3();
+    uint64_t TimeNow = DriveToBtlbwFound();
+    ASSERT_EQ(Bbr->BbrState, (uint32_t)BBR_STATE_PROBE_BW);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection.Paths[0]);
+    Bbr->InflightLo = 6 * DatagramPayloadLength;
+
+    CC->QuicCongestionControlOnDataSent(CC, 1200);
+    QUIC_ACK_EVENT Ack = MakeBbrAckEvent(TimeNow + 1000, 100, 110, 1200);
+    CC->QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+
+    ASSERT_LE(CC->QuicCongestionControlGetCongestionWindow(CC), 6u * DatagramPayloadLength);
+}
+
+//
+// Test: BBRv3 GetCongestionWindow - PROBE_RTT Keeps Half The BDP
+// Scenario: Drives BBRv3 to PROBE_RTT. Instead of the minimum window of BBR,
+// the window is half the estimated BDP, but never below the minimum window.
+//
+TEST_F(BbrTest_DeepTest, Bbr3_GetCongestionWindow_ProbeRtt)
+{
+    InitializeVersion3();
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection.Paths[0]);
+    uint32_t MinCW = 4 * DatagramPayloadLength;
+
+    uint64_t TimeNow = PumpBandwidthSample(1000000, 1, 1200, 10000000, 30000);
+    Bbr->CongestionWindow = 1000000;
+    CC->QuicCongestionControlOnDataSent(CC, 1000);
+    QUIC_ACK_EVENT Ack = MakeBbrAckEvent(TimeNow + 6000000, 3, 4, 1000, 50000, 35000, TRUE);
+    CC->QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+    ASSERT_EQ(Bbr->BbrState, (uint32_t)BBR_STATE_PROBE_RTT);
+
+    uint32_t Bdp =
+        (uint32_t)(BbrCongestionControlGetBandwidth(CC) * Bbr->MinRtt / 1000000 / 8);
+    ASSERT_EQ(CC->QuicCongestionControlGetCongestionWindow(CC), CXPLAT_MAX(Bdp / 2, MinCW));
+    ASSERT_GT(CC->QuicCongestionControlGetCongestionWindow(CC), MinCW);
+}
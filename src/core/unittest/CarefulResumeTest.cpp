@@ -0,0 +1,218 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the careful resume congestion state cache and state machine.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "CarefulResumeTest.cpp.clog.h"
+#endif
+
+struct CarefulResumeCache {
+    QUIC_CAREFUL_RESUME_CACHE Cache;
+    CarefulResumeCache() {
+        EXPECT_TRUE(QuicCarefulResumeCacheInitialize(&Cache));
+    }
+    ~CarefulResumeCache() {
+        QuicCarefulResumeCacheUninitialize(&Cache);
+    }
+};
+
+static QUIC_ADDR MakeAddr(uint8_t LastByte, uint16_t Port) {
+    QUIC_ADDR Addr;
+    CxPlatZeroMemory(&Addr, sizeof(Addr));
+    QuicAddrSetFamily(&Addr, QUIC_ADDRESS_FAMILY_INET);
+    ((uint8_t*)&Addr.Ipv4.sin_addr)[0] = 10;
+    ((uint8_t*)&Addr.Ipv4.sin_addr)[3] = LastByte;
+    QuicAddrSetPort(&Addr, Port);
+    return Addr;
+}
+
+static QUIC_CAREFUL_RESUME_SAVED_STATE MakeState(uint32_t CongestionWindow) {
+    QUIC_CAREFUL_RESUME_SAVED_STATE State;
+    CxPlatZeroMemory(&State, sizeof(State));
+    State.SmoothedRtt = 50000;
+    State.MinRtt = 40000;
+    State.CongestionWindow = CongestionWindow;
+    State.Algorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
+    return State;
+}
+
+TEST(CarefulResumeTest, CacheSaveAndLookup)
+{
+    CarefulResumeCache Cache;
+    const char Name[] = "example.com";
+    QUIC_ADDR Addr = MakeAddr(1, 443);
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved = MakeState(100000);
+    QUIC_CAREFUL_RESUME_SAVED_STATE Found;
+
+    ASSERT_FALSE(QuicCarefulResumeCacheLookup(&Cache.Cache, &Addr, sizeof(Name) - 1, Name, 0, &Found));
+    QuicCarefulResumeCacheSave(&Cache.Cache, &Addr, sizeof(Name) - 1, Name, 0, &Saved);
+
+    //
+    // The port doesn't matter.
+    //
+    QUIC_ADDR OtherPort = MakeAddr(1, 8443);
+    ASSERT_TRUE(QuicCarefulResumeCacheLookup(&Cache.Cache, &OtherPort, sizeof(Name) - 1, Name, 1000, &Found));
+    ASSERT_EQ(Saved.CongestionWindow, Found.CongestionWindow);
+    ASSERT_EQ(Saved.SmoothedRtt, Found.SmoothedRtt);
+
+    //
+    // The IP and server name do.
+    //
+    QUIC_ADDR OtherIp = MakeAddr(2, 443);
+    const char OtherName[] = "example.org";
+    ASSERT_FALSE(QuicCarefulResumeCacheLookup(&Cache.Cache, &OtherIp, sizeof(Name) - 1, Name, 1000, &Found));
+    ASSERT_FALSE(QuicCarefulResumeCacheLookup(&Cache.Cache, &Addr, sizeof(OtherName) - 1, OtherName, 1000, &Found));
+    ASSERT_FALSE(QuicCarefulResumeCacheLookup(&Cache.Cache, &Addr, 0, nullptr, 1000, &Found));
+
+    //
+    // Saving again replaces the state.
+    //
+    Saved.CongestionWindow = 200000;
+    QuicCarefulResumeCacheSave(&Cache.Cache, &Addr, sizeof(Name) - 1, Name, 2000, &Saved);
+    ASSERT_EQ(1u, Cache.Cache.EntryCount);
+    ASSERT_TRUE(QuicCarefulResumeCacheLookup(&Cache.Cache, &Addr, sizeof(Name) - 1, Name, 3000, &Found));
+    ASSERT_EQ(200000u, Found.CongestionWindow);
+}
+
+TEST(CarefulResumeTest, CacheExpiry)
+{
+    CarefulResumeCache Cache;
+    QUIC_ADDR Addr = MakeAddr(1, 443);
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved = MakeState(100000);
+    QUIC_CAREFUL_RESUME_SAVED_STATE Found;
+
+    QuicCarefulResumeCacheSave(&Cache.Cache, &Addr, 0, nullptr, 1000, &Saved);
+    ASSERT_TRUE(QuicCarefulResumeCacheLookup(&Cache.Cache, &Addr, 0, nullptr, QUIC_CAREFUL_RESUME_LIFETIME_US, &Found));
+    ASSERT_FALSE(QuicCarefulResumeCacheLookup(&Cache.Cache, &Addr, 0, nullptr, 1000 + QUIC_CAREFUL_RESUME_LIFETIME_US, &Found));
+    ASSERT_EQ(0u, Cache.Cache.EntryCount);
+}
+
+TEST(CarefulResumeTest, CacheEvictsLeastRecentlySaved)
+{
+    CarefulResumeCache Cache;
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved = MakeState(100000);
+    QUIC_CAREFUL_RESUME_SAVED_STATE Found;
+
+    for (uint32_t i = 0; i < QUIC_CAREFUL_RESUME_MAX_CACHE_ENTRIES; ++i) {
+        QUIC_ADDR Addr = MakeAddr(0, 443);
+        ((uint8_t*)&Addr.Ipv4.sin_addr)[2] = (uint8_t)(i >> 8);
+        ((uint8_t*)&Addr.Ipv4.sin_addr)[3] = (uint8_t)i;
+        QuicCarefulResumeCacheSave(&Cache.Cache, &Addr, 0, nullptr, i, &Saved);
+    }
+    ASSERT_EQ((uint32_t)QUIC_CAREFUL_RESUME_MAX_CACHE_ENTRIES, Cache.Cache.EntryCount);
+
+    //
+    // Refresh the oldest entry, so the second oldest is evicted next.
+    //
+    QUIC_ADDR First = MakeAddr(0, 443);
+    QUIC_ADDR Second = MakeAddr(1, 443);
+    QuicCarefulResumeCacheSave(&Cache.Cache, &First, 0, nullptr, 1000, &Saved);
+
+    QUIC_ADDR New = MakeAddr(0, 443);
+    ((uint8_t*)&New.Ipv4.sin_addr)[1] = 1;
+    QuicCarefulResumeCacheSave(&Cache.Cache, &New, 0, nullptr, 1001, &Saved);
+
+    ASSERT_EQ((uint32_t)QUIC_CAREFUL_RESUME_MAX_CACHE_ENTRIES, Cache.Cache.EntryCount);
+    ASSERT_TRUE(QuicCarefulResumeCacheLookup(&Cache.Cache, &First, 0, nullptr, 1002, &Found));
+    ASSERT_FALSE(QuicCarefulResumeCacheLookup(&Cache.Cache, &Second, 0, nullptr, 1002, &Found));
+    ASSERT_TRUE(QuicCarefulResumeCacheLookup(&Cache.Cache, &New, 0, nullptr, 1002, &Found));
+}
+
+TEST(CarefulResumeTest, NoSavedState)
+{
+    QUIC_CAREFUL_RESUME CarefulResume;
+    QuicCarefulResumeInitialize(&CarefulResume, nullptr);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_NONE, CarefulResume.Phase);
+
+    QUIC_CAREFUL_RESUME_SAVED_STATE Empty = MakeState(0);
+    QuicCarefulResumeInitialize(&CarefulResume, &Empty);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_NONE, CarefulResume.Phase);
+}
+
+TEST(CarefulResumeTest, RttMismatchAbandons)
+{
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved = MakeState(200000);
+    QUIC_CAREFUL_RESUME CarefulResume;
+
+    QuicCarefulResumeInitialize(&CarefulResume, &Saved);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_RECONNAISSANCE, CarefulResume.Phase);
+    ASSERT_EQ(0u, QuicCarefulResumeOnRttConfirmed(&CarefulResume, Saved.SmoothedRtt / 3, 12000, 5));
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_NORMAL, CarefulResume.Phase);
+
+    QuicCarefulResumeInitialize(&CarefulResume, &Saved);
+    ASSERT_EQ(0u, QuicCarefulResumeOnRttConfirmed(&CarefulResume, Saved.SmoothedRtt * 11, 12000, 5));
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_NORMAL, CarefulResume.Phase);
+
+    //
+    // Nothing to gain if the window already is larger than the jump.
+    //
+    QuicCarefulResumeInitialize(&CarefulResume, &Saved);
+    ASSERT_EQ(0u, QuicCarefulResumeOnRttConfirmed(&CarefulResume, Saved.SmoothedRtt, 150000, 5));
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_NORMAL, CarefulResume.Phase);
+}
+
+TEST(CarefulResumeTest, JumpValidates)
+{
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved = MakeState(200000);
+    QUIC_CAREFUL_RESUME CarefulResume;
+
+    QuicCarefulResumeInitialize(&CarefulResume, &Saved);
+    ASSERT_EQ(100000u, QuicCarefulResumeOnRttConfirmed(&CarefulResume, Saved.SmoothedRtt * 2, 12000, 10));
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED, CarefulResume.Phase);
+
+    //
+    // Acks for packets sent before the jump don't end the unvalidated phase.
+    //
+    QuicCarefulResumeOnAck(&CarefulResume, 9, 1200, 40);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED, CarefulResume.Phase);
+
+    QuicCarefulResumeOnAck(&CarefulResume, 10, 1200, 80);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_VALIDATING, CarefulResume.Phase);
+    ASSERT_EQ(79u, CarefulResume.LastUnvalidatedPacketNumber);
+
+    QuicCarefulResumeOnAck(&CarefulResume, 78, 60000, 120);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_VALIDATING, CarefulResume.Phase);
+    QuicCarefulResumeOnAck(&CarefulResume, 79, 1200, 120);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_NORMAL, CarefulResume.Phase);
+    ASSERT_EQ(12000u + 1200 + 1200 + 60000 + 1200, CarefulResume.PipeSize);
+
+    //
+    // Loss after validation is left to the congestion controller.
+    //
+    ASSERT_EQ(0u, QuicCarefulResumeOnLoss(&CarefulResume, 100, 120));
+}
+
+TEST(CarefulResumeTest, LossRetreats)
+{
+    QUIC_CAREFUL_RESUME_SAVED_STATE Saved = MakeState(200000);
+    QUIC_CAREFUL_RESUME CarefulResume;
+
+    QuicCarefulResumeInitialize(&CarefulResume, &Saved);
+    ASSERT_EQ(100000u, QuicCarefulResumeOnRttConfirmed(&CarefulResume, Saved.SmoothedRtt, 12000, 10));
+    QuicCarefulResumeOnAck(&CarefulResume, 5, 8000, 50);
+
+    //
+    // Loss of a packet sent before the jump doesn't count.
+    //
+    ASSERT_EQ(0u, QuicCarefulResumeOnLoss(&CarefulResume, 9, 50));
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_UNVALIDATED, CarefulResume.Phase);
+
+    ASSERT_EQ(10000u, QuicCarefulResumeOnLoss(&CarefulResume, 12, 60));
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_SAFE_RETREAT, CarefulResume.Phase);
+    ASSERT_EQ(59u, CarefulResume.LastUnvalidatedPacketNumber);
+
+    //
+    // Only one retreat per flight.
+    //
+    ASSERT_EQ(0u, QuicCarefulResumeOnLoss(&CarefulResume, 20, 60));
+    QuicCarefulResumeOnAck(&CarefulResume, 59, 1200, 70);
+    ASSERT_EQ(QUIC_CAREFUL_RESUME_PHASE_NORMAL, CarefulResume.Phase);
+}
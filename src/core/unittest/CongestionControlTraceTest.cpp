@@ -0,0 +1,745 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Loopback harness that replays recorded ACK traces into any congestion
+    control algorithm, both the built-in ones and application providers
+    registered via QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER.
+
+    A trace is plain text, one event per line, '#' starts a comment:
+
+        <time us> S <bytes>                 Send one packet (numbered from 0).
+        <time us> A <largest pn> [<delay>]  ACK all outstanding packets up to
+                                            <largest pn>, with an ACK delay.
+        <time us> L <largest pn>            Declare all outstanding packets up
+                                            to <largest pn> lost.
+        <time us> E <largest pn>            Peer reported new ECN CE marks.
+
+    Set QUIC_CC_TRACE_FILE to replay a trace from disk instead of the built-in
+    one in the ReplayFile test.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "CongestionControlTraceTest.cpp.clog.h"
+#endif
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//
+// Recorded from a single bulk transfer over a ~40ms RTT link: slow start,
+// a loss burst, an ECN mark during recovery and congestion avoidance.
+//
+static const char RecordedTrace[] = R"(
+# time    op  args
+0         S   1200
+0         S   1200
+0         S   1200
+0         S   1200
+0         S   1200
+0         S   1200
+0         S   1200
+0         S   1200
+0         S   1200
+0         S   1200
+41000     A   3   1000
+41000     S   1200
+41000     S   1200
+41000     S   1200
+41000     S   1200
+41500     A   7   1000
+41500     S   1200
+41500     S   1200
+41500     S   1200
+41500     S   1200
+42000     A   9   500
+42000     S   1200
+42000     S   1200
+42000     S   1200
+82000     A   13  1000
+82000     S   1200
+82000     S   1200
+82000     S   1200
+82000     S   1200
+82000     S   1200
+82000     S   1200
+82000     S   1200
+82000     S   1200
+83000     A   17  1000
+83000     S   1200
+83000     S   1200
+83000     S   1200
+83000     S   1200
+83000     S   1200
+83000     S   1200
+84000     A   20  1000
+84000     S   1200
+84000     S   1200
+84000     S   1200
+84000     S   1200
+124000    L   24
+124000    A   29  1000
+124000    S   1200
+124000    S   1200
+125000    A   33  1000
+125000    S   1200
+125000    S   1200
+125000    S   1200
+126000    E   36
+126000    A   36  1000
+126000    S   1200
+126000    S   1200
+166000    A   41  1000
+166000    S   1200
+166000    S   1200
+166000    S   1200
+167000    A   44  1000
+167000    S   1200
+167000    S   1200
+167000    S   1200
+207000    A   48  1000
+207000    S   1200
+207000    S   1200
+207000    S   1200
+207000    S   1200
+208000    A   52  1000
+208000    S   1200
+208000    S   1200
+248000    A   57  1000
+)";
+
+struct CcTraceEvent {
+    uint64_t TimeUs;
+    char Op;
+    uint64_t Arg0;
+    uint64_t Arg1;
+};
+
+static bool
+ParseCcTrace(
+    std::istream& Input,
+    std::vector<CcTraceEvent>& Events
+    )
+{
+    std::string Line;
+    while (std::getline(Input, Line)) {
+        Line = Line.substr(0, Line.find('#'));
+        std::istringstream Fields(Line);
+        CcTraceEvent Event{};
+        std::string Op;
+        if (!(Fields >> Event.TimeUs)) {
+            continue; // Blank or comment line.
+        }
+        if (!(Fields >> Op) || Op.size() != 1 || !(Fields >> Event.Arg0)) {
+            return false;
+        }
+        Event.Op = Op[0];
+        if (Event.Op == 'A') {
+            Fields >> Event.Arg1; // Optional ACK delay.
+        } else if (Event.Op != 'S' && Event.Op != 'L' && Event.Op != 'E') {
+            return false;
+        }
+        if (!Events.empty() && Event.TimeUs < Events.back().TimeUs) {
+            return false;
+        }
+        Events.push_back(Event);
+    }
+    return !Events.empty();
+}
+
+static bool
+ParseCcTrace(
+    const char* Text,
+    std::vector<CcTraceEvent>& Events
+    )
+{
+    std::istringstream Input(Text);
+    return ParseCcTrace(Input, Events);
+}
+
+//
+// A minimal AIMD (Reno style) algorithm, implemented purely against the
+// public provider interface.
+//
+#define TEST_CC_ALGORITHM QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START
+
+struct TestRenoState {
+    uint32_t CongestionWindow;
+    uint32_t SlowStartThreshold;
+    uint32_t Mss;
+    uint64_t RecoverySentPacketNumber;
+    BOOLEAN IsInRecovery;
+    uint32_t InitializeCount;
+    uint32_t AckCount;
+    uint32_t LossCount;
+    uint32_t EcnCount;
+    uint32_t SentBytes;
+};
+
+static
+void
+QUIC_API
+TestRenoInitialize(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path
+    )
+{
+    auto* Reno = (TestRenoState*)State;
+    Reno->Mss = Path->DatagramPayloadLength;
+    Reno->CongestionWindow = Path->InitialWindowPackets * Reno->Mss;
+    Reno->SlowStartThreshold = UINT32_MAX;
+    Reno->InitializeCount++;
+}
+
+static
+uint32_t
+QUIC_API
+TestRenoGetCongestionWindow(
+    _In_ const void* State
+    )
+{
+    return ((const TestRenoState*)State)->CongestionWindow;
+}
+
+static
+void
+QUIC_API
+TestRenoOnDataSent(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* /* Path */,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    ((TestRenoState*)State)->SentBytes += NumRetransmittableBytes;
+}
+
+static
+void
+QUIC_API
+TestRenoOnDataAcknowledged(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* /* Path */,
+    _In_ const QUIC_CONGESTION_CONTROL_ACK_EVENT* AckEvent
+    )
+{
+    auto* Reno = (TestRenoState*)State;
+    Reno->AckCount++;
+    if (Reno->IsInRecovery) {
+        if (AckEvent->LargestAck <= Reno->RecoverySentPacketNumber) {
+            return;
+        }
+        Reno->IsInRecovery = FALSE;
+    }
+    if (Reno->CongestionWindow < Reno->SlowStartThreshold) {
+        Reno->CongestionWindow += AckEvent->NumRetransmittableBytes;
+    } else {
+        Reno->CongestionWindow +=
+            (uint32_t)((uint64_t)Reno->Mss * AckEvent->NumRetransmittableBytes /
+                Reno->CongestionWindow);
+    }
+}
+
+static
+void
+TestRenoOnCongestionEvent(
+    _Inout_ TestRenoState* Reno,
+    _In_ uint64_t LargestPacketNumber,
+    _In_ uint64_t LargestSentPacketNumber
+    )
+{
+    if (Reno->IsInRecovery && LargestPacketNumber <= Reno->RecoverySentPacketNumber) {
+        return;
+    }
+    Reno->IsInRecovery = TRUE;
+    Reno->RecoverySentPacketNumber = LargestSentPacketNumber;
+    Reno->SlowStartThreshold = CXPLAT_MAX(Reno->CongestionWindow / 2, 2 * Reno->Mss);
+    Reno->CongestionWindow = Reno->SlowStartThreshold;
+}
+
+static
+void
+QUIC_API
+TestRenoOnDataLost(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* /* Path */,
+    _In_ const QUIC_CONGESTION_CONTROL_LOSS_EVENT* LossEvent
+    )
+{
+    auto* Reno = (TestRenoState*)State;
+    Reno->LossCount++;
+    TestRenoOnCongestionEvent(
+        Reno, LossEvent->LargestPacketNumberLost, LossEvent->LargestSentPacketNumber);
+}
+
+static
+void
+QUIC_API
+TestRenoOnEcn(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* /* Path */,
+    _In_ const QUIC_CONGESTION_CONTROL_ECN_EVENT* EcnEvent
+    )
+{
+    auto* Reno = (TestRenoState*)State;
+    Reno->EcnCount++;
+    TestRenoOnCongestionEvent(
+        Reno, EcnEvent->LargestPacketNumberAcked, EcnEvent->LargestSentPacketNumber);
+}
+
+static QUIC_CONGESTION_CONTROL_PROVIDER
+MakeTestRenoProvider()
+{
+    QUIC_CONGESTION_CONTROL_PROVIDER Provider{};
+    Provider.Algorithm = TEST_CC_ALGORITHM;
+    Provider.StateSize = sizeof(TestRenoState);
+    Provider.Name = "TestReno";
+    Provider.Initialize = TestRenoInitialize;
+    Provider.GetCongestionWindow = TestRenoGetCongestionWindow;
+    Provider.OnDataSent = TestRenoOnDataSent;
+    Provider.OnDataAcknowledged = TestRenoOnDataAcknowledged;
+    Provider.OnDataLost = TestRenoOnDataLost;
+    Provider.OnEcn = TestRenoOnEcn;
+    return Provider;
+}
+
+static uint32_t
+GetBytesInFlight(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_NETWORK_STATISTICS Stats{};
+    Connection->CongestionControl.QuicCongestionControlGetNetworkStatistics(
+        Connection, &Connection->CongestionControl, &Stats);
+    return Stats.BytesInFlight;
+}
+
+struct CcTraceResult {
+    uint32_t EventCount;
+    uint32_t FinalCongestionWindow;
+    uint32_t FinalBytesInFlight;
+    uint32_t PacketsSent;
+    uint32_t PacketsAcked;
+    uint32_t PacketsLost;
+};
+
+//
+// Drives one congestion controller with a trace, doing the loss detection
+// bookkeeping (outstanding packets, RTT estimation and delivery rate info)
+// that loss_detection.c does for a real connection.
+//
+class CcTraceReplayer {
+public:
+    QUIC_CONNECTION Connection{};
+    QUIC_SETTINGS_INTERNAL Settings{};
+    QUIC_CONGESTION_CONTROL* CC{&Connection.CongestionControl};
+
+    void Initialize(uint16_t Algorithm)
+    {
+        Connection.Paths[0].Mtu = 1280;
+        Connection.Paths[0].IsActive = TRUE;
+        Connection.Send.PeerMaxData = UINT64_MAX;
+        Settings.InitialWindowPackets = 10;
+        Settings.SendIdleTimeoutMs = 1000;
+        Settings.CongestionControlAlgorithm = Algorithm;
+        QuicCongestionControlInitialize(CC, &Settings);
+    }
+
+    CcTraceResult Replay(const std::vector<CcTraceEvent>& Events)
+    {
+        CcTraceResult Result{};
+        for (const auto& Event : Events) {
+            switch (Event.Op) {
+            case 'S': OnSend(Event.TimeUs, (uint16_t)Event.Arg0); Result.PacketsSent++; break;
+            case 'A': Result.PacketsAcked += OnAck(Event.TimeUs, Event.Arg0, Event.Arg1); break;
+            case 'L': Result.PacketsLost += OnLoss(Event.Arg0); break;
+            case 'E': OnEcn(Event.Arg0); break;
+            }
+            Result.EventCount++;
+        }
+        Result.FinalCongestionWindow = QuicCongestionControlGetCongestionWindow(CC);
+        Result.FinalBytesInFlight = GetBytesInFlight(&Connection);
+        return Result;
+    }
+
+private:
+    std::map<uint64_t, QUIC_MAX_SENT_PACKET_METADATA> Outstanding;
+    uint64_t NextPacketNumber{0};
+    uint64_t TotalBytesSent{0};
+    uint64_t TotalBytesAcked{0};
+    uint64_t TotalBytesSentAtLastAck{0};
+    uint64_t TimeOfLastPacketAcked{0};
+    uint64_t TimeOfLastAckedPacketSent{0};
+    uint64_t AdjustedLastAckedTime{0};
+
+    void OnSend(uint64_t TimeUs, uint16_t Bytes)
+    {
+        QUIC_MAX_SENT_PACKET_METADATA PacketBuf{};
+        auto& Packet = PacketBuf.Metadata;
+        Packet.PacketNumber = NextPacketNumber;
+        Packet.PacketLength = Bytes;
+        Packet.SentTime = TimeUs;
+        Packet.Flags.IsAppLimited = QuicCongestionControlIsAppLimited(CC);
+        TotalBytesSent += Bytes;
+        Packet.TotalBytesSent = TotalBytesSent;
+        if (TimeOfLastPacketAcked) {
+            Packet.Flags.HasLastAckedPacketInfo = TRUE;
+            Packet.LastAckedPacketInfo.SentTime = TimeOfLastAckedPacketSent;
+            Packet.LastAckedPacketInfo.AckTime = TimeOfLastPacketAcked;
+            Packet.LastAckedPacketInfo.AdjustedAckTime = AdjustedLastAckedTime;
+            Packet.LastAckedPacketInfo.TotalBytesSent = TotalBytesSentAtLastAck;
+            Packet.LastAckedPacketInfo.TotalBytesAcked = TotalBytesAcked;
+        }
+        Outstanding[NextPacketNumber] = PacketBuf;
+
+        Connection.LossDetection.LargestSentPacketNumber = NextPacketNumber;
+        Connection.Send.NextPacketNumber = ++NextPacketNumber;
+        QuicCongestionControlOnDataSent(CC, Bytes);
+    }
+
+    uint32_t OnAck(uint64_t TimeUs, uint64_t LargestAck, uint64_t AckDelay)
+    {
+        auto End = Outstanding.upper_bound(LargestAck);
+        if (End == Outstanding.begin()) {
+            return 0;
+        }
+
+        QUIC_PATH* Path = &Connection.Paths[0];
+        auto Largest = std::prev(End);
+        uint64_t Rtt = TimeUs - Largest->second.Metadata.SentTime;
+        if (Rtt > AckDelay) {
+            Rtt -= AckDelay;
+        }
+        if (!Path->GotFirstRttSample) {
+            Path->GotFirstRttSample = TRUE;
+            Path->SmoothedRtt = Rtt;
+            Path->RttVariance = Rtt / 2;
+            Path->MinRtt = Rtt;
+        } else {
+            Path->SmoothedRtt = (7 * Path->SmoothedRtt + Rtt) / 8;
+            Path->MinRtt = CXPLAT_MIN(Path->MinRtt, Rtt);
+        }
+        Path->LatestRttSample = Rtt;
+
+        std::vector<QUIC_MAX_SENT_PACKET_METADATA> Acked;
+        for (auto It = Outstanding.begin(); It != End; ++It) {
+            Acked.push_back(It->second);
+        }
+        Outstanding.erase(Outstanding.begin(), End);
+
+        uint32_t AckedBytes = 0;
+        for (size_t i = 0; i < Acked.size(); ++i) {
+            auto& Packet = Acked[i].Metadata;
+            Packet.Next = i + 1 < Acked.size() ? &Acked[i + 1].Metadata : NULL;
+            AckedBytes += Packet.PacketLength;
+            TotalBytesAcked += Packet.PacketLength;
+            TotalBytesSentAtLastAck = Packet.TotalBytesSent;
+            TimeOfLastAckedPacketSent = Packet.SentTime;
+        }
+        TimeOfLastPacketAcked = TimeUs;
+        AdjustedLastAckedTime = TimeUs - AckDelay;
+
+        QUIC_ACK_EVENT Ack{};
+        Ack.TimeNow = TimeUs;
+        Ack.LargestAck = LargestAck;
+        Ack.LargestSentPacketNumber = Connection.LossDetection.LargestSentPacketNumber;
+        Ack.NumRetransmittableBytes = AckedBytes;
+        Ack.NumTotalAckedRetransmittableBytes = TotalBytesAcked;
+        Ack.SmoothedRtt = Path->SmoothedRtt;
+        Ack.MinRtt = Path->MinRtt;
+        Ack.MinRttValid = TRUE;
+        Ack.AdjustedAckTime = AdjustedLastAckedTime;
+        Ack.IsLargestAckedPacketAppLimited = Largest->second.Metadata.Flags.IsAppLimited;
+        Ack.AckedPackets = &Acked[0].Metadata;
+        QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+        return (uint32_t)Acked.size();
+    }
+
+    uint32_t OnLoss(uint64_t LargestLost)
+    {
+        auto End = Outstanding.upper_bound(LargestLost);
+        uint32_t LostBytes = 0, LostPackets = 0;
+        for (auto It = Outstanding.begin(); It != End; ++It) {
+            LostBytes += It->second.Metadata.PacketLength;
+            LostPackets++;
+        }
+        if (LostPackets == 0) {
+            return 0;
+        }
+        uint64_t LargestPacketNumberLost = std::prev(End)->first;
+        Outstanding.erase(Outstanding.begin(), End);
+
+        QUIC_LOSS_EVENT Loss{};
+        Loss.NumRetransmittableBytes = LostBytes;
+        Loss.LargestPacketNumberLost = LargestPacketNumberLost;
+        Loss.LargestSentPacketNumber = Connection.LossDetection.LargestSentPacketNumber;
+        QuicCongestionControlOnDataLost(CC, &Loss);
+        return LostPackets;
+    }
+
+    void OnEcn(uint64_t LargestAcked)
+    {
+        QUIC_ECN_EVENT Ecn{};
+        Ecn.LargestPacketNumberAcked = LargestAcked;
+        Ecn.LargestSentPacketNumber = Connection.LossDetection.LargestSentPacketNumber;
+        Ecn.NumCePackets = 1;
+        QuicCongestionControlOnEcn(CC, &Ecn);
+    }
+};
+
+//
+// Registers the test provider directly in the library's table for the
+// duration of a test (the SetParam path is covered separately below).
+//
+template<typename Base>
+class WithTestProvider : public Base {
+protected:
+    void SetUp() override {
+        MsQuicLib.CongestionControlProviders[TEST_CC_ALGORITHM - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START] =
+            MakeTestRenoProvider();
+    }
+    void TearDown() override {
+        CxPlatZeroMemory(
+            &MsQuicLib.CongestionControlProviders[TEST_CC_ALGORITHM - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START],
+            sizeof(QUIC_CONGESTION_CONTROL_PROVIDER));
+    }
+};
+
+class CongestionControlTraceTest : public WithTestProvider<::testing::TestWithParam<uint16_t>> {};
+class CongestionControlCustomTest : public WithTestProvider<::testing::Test> {};
+
+TEST(CongestionControlTraceParseTest, RejectsMalformedTraces)
+{
+    std::vector<CcTraceEvent> Events;
+    ASSERT_TRUE(ParseCcTrace(RecordedTrace, Events));
+    ASSERT_EQ(74u, Events.size());
+
+    const char* Malformed[] = {
+        "",                     // No events
+        "# only a comment\n",   // No events
+        "0 S\n",                // Missing argument
+        "0 X 1200\n",           // Unknown op
+        "0 SS 1200\n",          // Op too long
+        "10 S 1200\n5 S 1200\n" // Time going backwards
+    };
+    for (auto Trace : Malformed) {
+        Events.clear();
+        ASSERT_FALSE(ParseCcTrace(Trace, Events)) << Trace;
+    }
+}
+
+TEST_P(CongestionControlTraceTest, ReplayRecordedTrace)
+{
+    std::vector<CcTraceEvent> Events;
+    ASSERT_TRUE(ParseCcTrace(RecordedTrace, Events));
+
+    CcTraceReplayer Replayer;
+    Replayer.Initialize(GetParam());
+    auto Result = Replayer.Replay(Events);
+
+    ASSERT_EQ(Events.size(), Result.EventCount);
+    ASSERT_EQ(58u, Result.PacketsSent);
+    ASSERT_EQ(54u, Result.PacketsAcked);
+    ASSERT_EQ(4u, Result.PacketsLost);
+    ASSERT_EQ(0u, Result.FinalBytesInFlight);
+    ASSERT_GT(Result.FinalCongestionWindow, 0u);
+    ASSERT_EQ(1u, Replayer.Connection.Stats.Send.CongestionCount);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Algorithms,
+    CongestionControlTraceTest,
+    ::testing::Values(
+        (uint16_t)QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC,
+        (uint16_t)QUIC_CONGESTION_CONTROL_ALGORITHM_BBR,
+        (uint16_t)QUIC_CONGESTION_CONTROL_ALGORITHM_DCTCP,
+        (uint16_t)TEST_CC_ALGORITHM),
+    [](const ::testing::TestParamInfo<uint16_t>& Info) {
+        switch (Info.param) {
+        case QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC: return std::string("Cubic");
+        case QUIC_CONGESTION_CONTROL_ALGORITHM_BBR: return std::string("Bbr");
+        case QUIC_CONGESTION_CONTROL_ALGORITHM_DCTCP: return std::string("Dctcp");
+        default: return std::string("Custom");
+        }
+    });
+
+TEST_P(CongestionControlTraceTest, ReplayFile)
+{
+    const char* Path = getenv("QUIC_CC_TRACE_FILE");
+    if (Path == nullptr) {
+        GTEST_SKIP() << "QUIC_CC_TRACE_FILE not set";
+    }
+
+    std::ifstream File(Path);
+    ASSERT_TRUE(File.is_open()) << Path;
+    std::vector<CcTraceEvent> Events;
+    ASSERT_TRUE(ParseCcTrace(File, Events)) << Path;
+
+    CcTraceReplayer Replayer;
+    Replayer.Initialize(GetParam());
+    auto Result = Replayer.Replay(Events);
+
+    std::cout << Replayer.CC->Name << ": " << Result.EventCount << " events, "
+        << Result.PacketsSent << " sent, " << Result.PacketsAcked << " acked, "
+        << Result.PacketsLost << " lost, final cwnd " << Result.FinalCongestionWindow
+        << ", bytes in flight " << Result.FinalBytesInFlight << std::endl;
+}
+
+TEST_P(CongestionControlTraceTest, ReplayPerf)
+{
+    std::vector<CcTraceEvent> Trace;
+    ASSERT_TRUE(ParseCcTrace(RecordedTrace, Trace));
+
+    //
+    // Loop the recorded trace, shifting packet numbers and time so the
+    // controller sees one long transfer.
+    //
+    const uint32_t Loops = 2000;
+    const uint64_t LoopDurationUs = Trace.back().TimeUs + 40000;
+    uint64_t PacketsPerLoop = 0;
+    for (const auto& Event : Trace) {
+        PacketsPerLoop += Event.Op == 'S';
+    }
+    std::vector<CcTraceEvent> Events;
+    Events.reserve(Trace.size() * Loops);
+    for (uint32_t i = 0; i < Loops; ++i) {
+        for (auto Event : Trace) {
+            Event.TimeUs += i * LoopDurationUs;
+            if (Event.Op != 'S') {
+                Event.Arg0 += i * PacketsPerLoop;
+            }
+            Events.push_back(Event);
+        }
+    }
+
+    CcTraceReplayer Replayer;
+    Replayer.Initialize(GetParam());
+    auto Start = std::chrono::steady_clock::now();
+    auto Result = Replayer.Replay(Events);
+    auto ElapsedUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - Start).count();
+
+    ASSERT_EQ(Events.size(), Result.EventCount);
+    std::cout << Replayer.CC->Name << ": " << Result.EventCount << " events in "
+        << ElapsedUs << " us ("
+        << (uint64_t)(Result.EventCount * 1000000.0 / (ElapsedUs ? ElapsedUs : 1))
+        << " events/sec), final cwnd " << Result.FinalCongestionWindow << std::endl;
+}
+
+TEST_F(CongestionControlCustomTest, ProviderBookkeeping)
+{
+    CcTraceReplayer Replayer;
+    Replayer.Initialize(TEST_CC_ALGORITHM);
+    QUIC_CONGESTION_CONTROL* CC = Replayer.CC;
+    auto* Reno = (TestRenoState*)CC->Custom.State;
+
+    ASSERT_STREQ("TestReno", CC->Name);
+    ASSERT_EQ(1u, Reno->InitializeCount);
+    ASSERT_EQ(10u * QuicPathGetDatagramPayloadSize(&Replayer.Connection.Paths[0]),
+        QuicCongestionControlGetCongestionWindow(CC));
+
+    std::vector<CcTraceEvent> Events;
+    ASSERT_TRUE(ParseCcTrace(RecordedTrace, Events));
+    auto Result = Replayer.Replay(Events);
+
+    //
+    // The adapter tracks bytes in flight itself and passes every event on.
+    //
+    ASSERT_EQ(Result.PacketsSent * 1200u, Reno->SentBytes);
+    ASSERT_EQ(1u, Reno->LossCount);
+    ASSERT_EQ(1u, Reno->EcnCount);
+    ASSERT_EQ(0u, GetBytesInFlight(&Replayer.Connection));
+    ASSERT_EQ(Reno->CongestionWindow, Result.FinalCongestionWindow);
+    ASSERT_EQ(1u, Replayer.Connection.Stats.Send.CongestionCount);
+    ASSERT_EQ(0u, Replayer.Connection.Stats.Send.EcnCongestionCount);
+
+    //
+    // Exemptions allow sending past the window.
+    //
+    QuicCongestionControlOnDataSent(CC, Reno->CongestionWindow);
+    ASSERT_FALSE(QuicCongestionControlCanSend(CC));
+    QuicCongestionControlSetExemption(CC, 1);
+    ASSERT_TRUE(QuicCongestionControlCanSend(CC));
+    QuicCongestionControlOnDataSent(CC, 1200);
+    ASSERT_FALSE(QuicCongestionControlCanSend(CC));
+
+    //
+    // A reset zeroes and re-initializes the provider's state.
+    //
+    QuicCongestionControlReset(CC, TRUE);
+    ASSERT_EQ(1u, Reno->InitializeCount);
+    ASSERT_EQ(0u, Reno->LossCount);
+    ASSERT_EQ(0u, Reno->SentBytes);
+    ASSERT_EQ(0u, GetBytesInFlight(&Replayer.Connection));
+}
+
+TEST(CongestionControlProviderTest, UnregisteredAlgorithmFallsBackToCubic)
+{
+    CcTraceReplayer Replayer;
+    Replayer.Initialize(QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START + 1);
+    ASSERT_STREQ("Cubic", Replayer.CC->Name);
+}
+
+TEST(CongestionControlProviderTest, SetParamValidation)
+{
+    QUIC_CONGESTION_CONTROL_PROVIDER Provider = MakeTestRenoProvider();
+
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER,
+            sizeof(Provider) - 1,
+            &Provider));
+
+    auto Invalid = Provider;
+    Invalid.Algorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR;
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER, sizeof(Invalid), &Invalid));
+
+    Invalid = Provider;
+    Invalid.Algorithm =
+        QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START + QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_COUNT;
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER, sizeof(Invalid), &Invalid));
+
+    Invalid = Provider;
+    Invalid.StateSize = QUIC_CONGESTION_CONTROL_PROVIDER_MAX_STATE_SIZE + 1;
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER, sizeof(Invalid), &Invalid));
+
+    Invalid = Provider;
+    Invalid.OnDataLost = NULL;
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER, sizeof(Invalid), &Invalid));
+    ASSERT_EQ(nullptr, QuicLibraryGetCongestionControlProvider(TEST_CC_ALGORITHM));
+
+    QUIC_STATUS Status =
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER, sizeof(Provider), &Provider);
+    if (MsQuicLib.LazyInitComplete) {
+        ASSERT_EQ(QUIC_STATUS_INVALID_STATE, Status);
+        return;
+    }
+    TEST_QUIC_SUCCEEDED(Status);
+    const QUIC_CONGESTION_CONTROL_PROVIDER* Registered =
+        QuicLibraryGetCongestionControlProvider(TEST_CC_ALGORITHM);
+    ASSERT_NE(nullptr, Registered);
+    ASSERT_STREQ("TestReno", Registered->Name);
+
+    CxPlatZeroMemory(
+        &MsQuicLib.CongestionControlProviders[TEST_CC_ALGORITHM - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START],
+        sizeof(QUIC_CONGESTION_CONTROL_PROVIDER));
+}
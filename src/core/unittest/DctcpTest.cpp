@@ -0,0 +1,493 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the DCTCP (ECN fraction and delay target) congestion
+    control algorithm.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "DctcpTest.cpp.clog.h"
+#endif
+
+static void InitializeDctcpMockConnection(
+    QUIC_CONNECTION& Connection,
+    uint16_t Mtu)
+{
+    Connection.Paths[0].Mtu = Mtu;
+    Connection.Paths[0].IsActive = TRUE;
+    Connection.Send.NextPacketNumber = 0;
+    Connection.Settings.PacingEnabled = FALSE;
+    Connection.Settings.NetStatsEventEnabled = FALSE;
+    Connection.Paths[0].GotFirstRttSample = FALSE;
+    Connection.Paths[0].SmoothedRtt = 0;
+    Connection.Send.PeerMaxData = UINT64_MAX;
+}
+
+static QUIC_ACK_EVENT MakeDctcpAckEvent(
+    uint64_t TimeNow,
+    uint64_t LargestAck,
+    uint64_t LargestSentPacketNumber,
+    uint32_t BytesAcked,
+    uint64_t MinRtt = 100,
+    uint64_t OneWayDelay = 0)
+{
+    QUIC_ACK_EVENT Ack{};
+    Ack.TimeNow = TimeNow;
+    Ack.LargestAck = LargestAck;
+    Ack.LargestSentPacketNumber = LargestSentPacketNumber;
+    Ack.NumRetransmittableBytes = BytesAcked;
+    Ack.NumTotalAckedRetransmittableBytes = BytesAcked;
+    Ack.SmoothedRtt = MinRtt;
+    Ack.MinRtt = MinRtt;
+    Ack.MinRttValid = TRUE;
+    Ack.OneWayDelay = OneWayDelay;
+    Ack.AdjustedAckTime = TimeNow;
+    return Ack;
+}
+
+static QUIC_ECN_EVENT MakeDctcpEcnEvent(
+    uint64_t LargestPacketNumberAcked,
+    uint64_t LargestSentPacketNumber,
+    uint32_t NumCePackets)
+{
+    QUIC_ECN_EVENT Ecn{};
+    Ecn.LargestPacketNumberAcked = LargestPacketNumberAcked;
+    Ecn.LargestSentPacketNumber = LargestSentPacketNumber;
+    Ecn.NumCePackets = NumCePackets;
+    return Ecn;
+}
+
+class DctcpTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t kIPv6UdpOverhead = 48; // IPv6 (40) + UDP (8) header bytes
+    static constexpr uint16_t kMtu = 1280;
+    static constexpr uint32_t kMss = kMtu - kIPv6UdpOverhead;
+
+    QUIC_CONNECTION Connection{};
+    QUIC_SETTINGS_INTERNAL Settings{};
+    QUIC_CONGESTION_CONTROL_DCTCP* Dctcp;
+    QUIC_CONGESTION_CONTROL* CC;
+
+    void InitializeWithDefaults(uint32_t WindowPackets = 10)
+    {
+        Settings.InitialWindowPackets = WindowPackets;
+        Settings.SendIdleTimeoutMs = 1000;
+        Settings.CongestionControlAlgorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_DCTCP;
+        InitializeDctcpMockConnection(Connection, kMtu);
+        CC = &Connection.CongestionControl;
+        QuicCongestionControlInitialize(CC, &Settings);
+        Dctcp = &CC->Dctcp;
+    }
+
+    //
+    // Sends and ACKs NumPackets single datagram packets, each ACKed by its own
+    // ACK frame carrying the given delay sample. Returns the next packet number.
+    //
+    uint64_t SendAndAck(
+        uint64_t PacketNumber,
+        uint32_t NumPackets,
+        uint64_t MinRtt = 100,
+        uint64_t OneWayDelay = 0)
+    {
+        for (uint32_t i = 0; i < NumPackets; ++i, ++PacketNumber) {
+            QUIC_MAX_SENT_PACKET_METADATA PacketBuf{};
+            PacketBuf.Metadata.PacketNumber = PacketNumber;
+            PacketBuf.Metadata.PacketLength = (uint16_t)kMss;
+
+            Connection.Send.NextPacketNumber = PacketNumber + 1;
+            CC->QuicCongestionControlOnDataSent(CC, kMss);
+
+            QUIC_ACK_EVENT Ack = MakeDctcpAckEvent(
+                1000000 + PacketNumber * 10, PacketNumber, PacketNumber, kMss,
+                MinRtt, OneWayDelay);
+            Ack.AckedPackets = &PacketBuf.Metadata;
+            CC->QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+        }
+        return PacketNumber;
+    }
+};
+
+//
+// Test: Initialization through the algorithm setting.
+// Scenario: QuicCongestionControlInitialize with the DCTCP algorithm.
+// Assertions: DCTCP is selected with the initial window, no slow start
+// threshold and Alpha starting at 1 (RFC 8257, Section 3.3).
+//
+TEST_F(DctcpTest, InitializeComprehensive)
+{
+    InitializeWithDefaults();
+
+    ASSERT_STREQ("DCTCP", CC->Name);
+    ASSERT_NE(CC->QuicCongestionControlOnEcn, nullptr);
+    ASSERT_EQ(Dctcp->CongestionWindow, 10 * kMss);
+    ASSERT_EQ(Dctcp->BytesInFlightMax, 5 * kMss);
+    ASSERT_EQ(Dctcp->SlowStartThreshold, UINT32_MAX);
+    ASSERT_EQ(Dctcp->Alpha, (uint32_t)QUIC_DCTCP_ALPHA_SCALE);
+    ASSERT_EQ(Dctcp->BytesInFlight, 0u);
+    ASSERT_FALSE(Dctcp->HasHadCongestionEvent);
+    ASSERT_FALSE(Dctcp->IsInRecovery);
+    ASSERT_FALSE(Dctcp->BaseDelayValid);
+}
+
+//
+// Test: CanSend, exemptions and send allowance without pacing.
+//
+TEST_F(DctcpTest, CanSendAndExemptions)
+{
+    InitializeWithDefaults();
+
+    ASSERT_TRUE(QuicCongestionControlCanSend(CC));
+    ASSERT_EQ(QuicCongestionControlGetSendAllowance(CC, 0, FALSE), 10 * kMss);
+
+    CC->QuicCongestionControlOnDataSent(CC, 10 * kMss);
+    ASSERT_FALSE(QuicCongestionControlCanSend(CC));
+    ASSERT_EQ(QuicCongestionControlGetSendAllowance(CC, 0, FALSE), 0u);
+
+    QuicCongestionControlSetExemption(CC, 1);
+    ASSERT_TRUE(QuicCongestionControlCanSend(CC));
+    CC->QuicCongestionControlOnDataSent(CC, kMss);
+    ASSERT_EQ(QuicCongestionControlGetExemptions(CC), 0);
+    ASSERT_FALSE(QuicCongestionControlCanSend(CC));
+
+    ASSERT_TRUE(CC->QuicCongestionControlOnDataInvalidated(CC, 2 * kMss));
+    ASSERT_EQ(Dctcp->BytesInFlight, 9 * kMss);
+}
+
+//
+// Test: Slow start grows the window by the ACKed bytes, limited to twice the
+// largest amount of data in flight.
+//
+TEST_F(DctcpTest, SlowStartGrowth)
+{
+    InitializeWithDefaults();
+
+    CC->QuicCongestionControlOnDataSent(CC, 10 * kMss);
+    Connection.Send.NextPacketNumber = 10;
+    QUIC_ACK_EVENT Ack = MakeDctcpAckEvent(1000000, 9, 9, 10 * kMss);
+    CC->QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+
+    ASSERT_EQ(Dctcp->CongestionWindow, 20 * kMss);
+    ASSERT_EQ(Dctcp->BytesInFlight, 0u);
+
+    //
+    // A window larger than 2 * BytesInFlightMax is clamped.
+    //
+    SendAndAck(10, 20);
+    ASSERT_EQ(Dctcp->CongestionWindow, 2 * Dctcp->BytesInFlightMax);
+}
+
+//
+// Test: Congestion avoidance grows the window by one datagram per window of
+// ACKed bytes.
+//
+TEST_F(DctcpTest, CongestionAvoidanceGrowth)
+{
+    InitializeWithDefaults();
+    Dctcp->SlowStartThreshold = Dctcp->CongestionWindow;
+    Dctcp->BytesInFlightMax = Dctcp->CongestionWindow;
+
+    SendAndAck(0, 9);
+    ASSERT_EQ(Dctcp->CongestionWindow, 10 * kMss);
+    SendAndAck(9, 1);
+    ASSERT_EQ(Dctcp->CongestionWindow, 11 * kMss);
+    ASSERT_EQ(Dctcp->AimdAccumulator, 0u);
+}
+
+//
+// Test: Alpha is a moving average (g = 1/16) of the CE marked fraction,
+// updated once per observation window.
+//
+TEST_F(DctcpTest, AlphaMovingAverage)
+{
+    InitializeWithDefaults();
+
+    //
+    // A window without any marks decays Alpha by 1/16. The window ends when a
+    // packet sent after its start is ACKed.
+    //
+    uint64_t PacketNumber = SendAndAck(0, 1);
+    ASSERT_EQ(Dctcp->Alpha, (uint32_t)QUIC_DCTCP_ALPHA_SCALE * 15 / 16);
+    ASSERT_EQ(Dctcp->AlphaWindowEnd, PacketNumber);
+    ASSERT_EQ(Dctcp->AckedPacketsInWindow, 0u);
+
+    //
+    // Keep the window open while counting marks for half of the packets.
+    //
+    uint32_t Alpha = Dctcp->Alpha;
+    Dctcp->AlphaWindowEnd = PacketNumber + 3;
+    Dctcp->CePacketsInWindow = 2;
+    PacketNumber = SendAndAck(PacketNumber, 3);
+    ASSERT_EQ(Dctcp->Alpha, Alpha);
+    ASSERT_EQ(Dctcp->AckedPacketsInWindow, 3u);
+
+    PacketNumber = SendAndAck(PacketNumber, 1);
+    ASSERT_EQ(Dctcp->Alpha, (Alpha * 15 + QUIC_DCTCP_ALPHA_SCALE / 2) / 16);
+
+    //
+    // Without marks Alpha eventually reaches zero.
+    //
+    for (uint32_t i = 0; i < 200; ++i) {
+        PacketNumber = SendAndAck(PacketNumber, 1);
+    }
+    ASSERT_EQ(Dctcp->Alpha, 0u);
+}
+
+//
+// Test: ECN reduces the window by Alpha / 2, once per window.
+//
+TEST_F(DctcpTest, EcnProportionalReduction)
+{
+    InitializeWithDefaults(40);
+    Dctcp->Alpha = QUIC_DCTCP_ALPHA_SCALE / 4;
+    Connection.Send.NextPacketNumber = 20;
+
+    QUIC_ECN_EVENT Ecn = MakeDctcpEcnEvent(10, 19, 1);
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+
+    ASSERT_EQ(Dctcp->CongestionWindow, 40 * kMss - 40 * kMss / 8); // 12.5% reduction
+    ASSERT_EQ(Dctcp->SlowStartThreshold, Dctcp->CongestionWindow);
+    ASSERT_TRUE(Dctcp->IsInRecovery);
+    ASSERT_EQ(Dctcp->RecoverySentPacketNumber, 19u);
+    ASSERT_EQ(Dctcp->CePacketsInWindow, 1u);
+    ASSERT_EQ(Connection.Stats.Send.CongestionCount, 1u);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 1u);
+
+    //
+    // Marks for packets sent before the reduction only feed Alpha.
+    //
+    uint32_t Window = Dctcp->CongestionWindow;
+    Ecn = MakeDctcpEcnEvent(15, 19, 3);
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    ASSERT_EQ(Dctcp->CongestionWindow, Window);
+    ASSERT_EQ(Dctcp->CePacketsInWindow, 4u);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 1u);
+
+    //
+    // Marks after recovery reduce the window again.
+    //
+    Ecn = MakeDctcpEcnEvent(20, 25, 1);
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    ASSERT_EQ(Dctcp->CongestionWindow, Window - Window / 8);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 2u);
+}
+
+//
+// Test: With a low Alpha the reaction to ECN is much gentler than CUBIC's
+// (which treats ECN like loss), but never goes below the minimum window.
+//
+TEST_F(DctcpTest, EcnReductionBounds)
+{
+    InitializeWithDefaults(100);
+    Dctcp->Alpha = QUIC_DCTCP_ALPHA_SCALE / 64;
+
+    QUIC_ECN_EVENT Ecn = MakeDctcpEcnEvent(1, 1, 1);
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    ASSERT_EQ(Dctcp->CongestionWindow, 100 * kMss - 100 * kMss / 128);
+
+    InitializeWithDefaults(2);
+    Ecn = MakeDctcpEcnEvent(1, 1, 1);
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    ASSERT_EQ(Dctcp->CongestionWindow, QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS * kMss);
+}
+
+//
+// Test: Loss halves the window, and persistent congestion collapses it.
+//
+TEST_F(DctcpTest, LossReduction)
+{
+    InitializeWithDefaults(20);
+    CC->QuicCongestionControlOnDataSent(CC, 20 * kMss);
+
+    QUIC_LOSS_EVENT Loss{};
+    Loss.NumRetransmittableBytes = 2 * kMss;
+    Loss.LargestPacketNumberLost = 5;
+    Loss.LargestSentPacketNumber = 19;
+    CC->QuicCongestionControlOnDataLost(CC, &Loss);
+
+    ASSERT_EQ(Dctcp->CongestionWindow, 10 * kMss);
+    ASSERT_EQ(Dctcp->SlowStartThreshold, 10 * kMss);
+    ASSERT_EQ(Dctcp->BytesInFlight, 18 * kMss);
+    ASSERT_EQ(Connection.Stats.Send.CongestionCount, 1u);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 0u);
+
+    //
+    // Losses from the same window don't reduce it again.
+    //
+    Loss.LargestPacketNumberLost = 19;
+    CC->QuicCongestionControlOnDataLost(CC, &Loss);
+    ASSERT_EQ(Dctcp->CongestionWindow, 10 * kMss);
+    ASSERT_EQ(Connection.Stats.Send.CongestionCount, 1u);
+
+    Loss.LargestPacketNumberLost = 20;
+    Loss.LargestSentPacketNumber = 30;
+    Loss.PersistentCongestion = TRUE;
+    CC->QuicCongestionControlOnDataLost(CC, &Loss);
+    ASSERT_TRUE(Dctcp->IsInPersistentCongestion);
+    ASSERT_EQ(Dctcp->CongestionWindow, QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS * kMss);
+    ASSERT_EQ(Dctcp->SlowStartThreshold, 5 * kMss);
+    ASSERT_EQ(Connection.Stats.Send.PersistentCongestionCount, 1u);
+}
+
+//
+// Test: A spurious loss restores the window; ECN reductions can't be undone.
+//
+TEST_F(DctcpTest, SpuriousCongestionEvent)
+{
+    InitializeWithDefaults(20);
+    ASSERT_FALSE(CC->QuicCongestionControlOnSpuriousCongestionEvent(CC));
+
+    QUIC_LOSS_EVENT Loss{};
+    Loss.LargestPacketNumberLost = 5;
+    Loss.LargestSentPacketNumber = 19;
+    CC->QuicCongestionControlOnDataLost(CC, &Loss);
+    ASSERT_EQ(Dctcp->CongestionWindow, 10 * kMss);
+
+    CC->QuicCongestionControlOnSpuriousCongestionEvent(CC);
+    ASSERT_EQ(Dctcp->CongestionWindow, 20 * kMss);
+    ASSERT_EQ(Dctcp->SlowStartThreshold, UINT32_MAX);
+    ASSERT_FALSE(Dctcp->IsInRecovery);
+
+    Dctcp->Alpha = QUIC_DCTCP_ALPHA_SCALE / 2;
+    QUIC_ECN_EVENT Ecn = MakeDctcpEcnEvent(20, 30, 1);
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    ASSERT_EQ(Dctcp->CongestionWindow, 15 * kMss);
+    CC->QuicCongestionControlOnSpuriousCongestionEvent(CC);
+    ASSERT_EQ(Dctcp->CongestionWindow, 15 * kMss);
+}
+
+//
+// Test: Recovery ends with an ACK for a packet sent after it started, without
+// growing the window on that ACK.
+//
+TEST_F(DctcpTest, RecoveryExit)
+{
+    InitializeWithDefaults(20);
+    Dctcp->Alpha = QUIC_DCTCP_ALPHA_SCALE / 2;
+    QUIC_ECN_EVENT Ecn = MakeDctcpEcnEvent(1, 10, 1);
+    CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    uint32_t Window = Dctcp->CongestionWindow;
+    ASSERT_EQ(Window, 15 * kMss);
+
+    SendAndAck(10, 1);
+    ASSERT_TRUE(Dctcp->IsInRecovery);
+    ASSERT_EQ(Dctcp->CongestionWindow, Window);
+
+    SendAndAck(11, 1);
+    ASSERT_FALSE(Dctcp->IsInRecovery);
+    ASSERT_EQ(Dctcp->CongestionWindow, Window);
+
+    SendAndAck(12, 1);
+    ASSERT_GT(Dctcp->AimdAccumulator, 0u);
+}
+
+//
+// Test: RTT above the target queueing delay reduces the window in proportion
+// (Beta * (Delay - Target) / Delay, at most half), once per window.
+//
+TEST_F(DctcpTest, DelayTargetReduction)
+{
+    InitializeWithDefaults(20);
+    Dctcp->BytesInFlightMax = 40 * kMss;
+
+    //
+    // The first sample sets the base delay. Target = 100 + max(100, 25).
+    //
+    uint64_t PacketNumber = SendAndAck(0, 1, 100);
+    ASSERT_TRUE(Dctcp->BaseDelayValid);
+    ASSERT_EQ(Dctcp->BaseDelay, 100u);
+    ASSERT_EQ(Dctcp->CongestionWindow, 21 * kMss);
+
+    //
+    // At the target: no reduction.
+    //
+    PacketNumber = SendAndAck(PacketNumber, 1, 200);
+    ASSERT_EQ(Dctcp->CongestionWindow, 22 * kMss);
+    ASSERT_FALSE(Dctcp->HasHadCongestionEvent);
+
+    //
+    // 400us: reduction = 0.8 * 200 / 400 = 40%.
+    //
+    uint32_t Window = Dctcp->CongestionWindow;
+    PacketNumber = SendAndAck(PacketNumber, 1, 400);
+    const uint32_t Reduction = (QUIC_DCTCP_ALPHA_SCALE * 8 / 10) * 200 / 400;
+    ASSERT_EQ(Dctcp->CongestionWindow,
+        Window - (uint32_t)((uint64_t)Window * Reduction / QUIC_DCTCP_ALPHA_SCALE));
+    ASSERT_TRUE(Dctcp->IsInRecovery);
+    ASSERT_EQ(Connection.Stats.Send.CongestionCount, 1u);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 0u);
+
+    //
+    // Very high delay is capped at a 50% reduction, after recovery.
+    //
+    Window = Dctcp->CongestionWindow;
+    PacketNumber = SendAndAck(PacketNumber, 1, 100000); // Exits recovery
+    ASSERT_EQ(Dctcp->CongestionWindow, Window);
+    PacketNumber = SendAndAck(PacketNumber, 1, 100000);
+    ASSERT_EQ(Dctcp->CongestionWindow, Window - Window / 2);
+    ASSERT_EQ(Connection.Stats.Send.CongestionCount, 2u);
+}
+
+//
+// Test: The one-way delay of the send path is preferred over the RTT, so
+// queueing on the reverse path doesn't reduce the window.
+//
+TEST_F(DctcpTest, DelayTargetUsesOneWayDelay)
+{
+    InitializeWithDefaults(20);
+    Dctcp->BytesInFlightMax = 40 * kMss;
+
+    uint64_t PacketNumber = SendAndAck(0, 1, 200, 100);
+    ASSERT_EQ(Dctcp->BaseDelay, 100u);
+
+    //
+    // RTT grows (reverse path queueing) but one-way delay doesn't.
+    //
+    PacketNumber = SendAndAck(PacketNumber, 4, 5000, 110);
+    ASSERT_FALSE(Dctcp->HasHadCongestionEvent);
+
+    PacketNumber = SendAndAck(PacketNumber, 1, 200, 1000);
+    ASSERT_TRUE(Dctcp->HasHadCongestionEvent);
+}
+
+//
+// Test: Reset restores the initial state, including the base delay.
+//
+TEST_F(DctcpTest, Reset)
+{
+    InitializeWithDefaults();
+    SendAndAck(0, 3, 100);
+    Dctcp->Alpha = 0;
+    CC->QuicCongestionControlOnDataSent(CC, kMss);
+
+    QuicCongestionControlReset(CC, FALSE);
+    ASSERT_EQ(Dctcp->CongestionWindow, 10 * kMss);
+    ASSERT_EQ(Dctcp->Alpha, (uint32_t)QUIC_DCTCP_ALPHA_SCALE);
+    ASSERT_FALSE(Dctcp->BaseDelayValid);
+    ASSERT_EQ(Dctcp->BytesInFlight, kMss);
+
+    QuicCongestionControlReset(CC, TRUE);
+    ASSERT_EQ(Dctcp->BytesInFlight, 0u);
+}
+
+//
+// Test: Network statistics report the DCTCP window.
+//
+TEST_F(DctcpTest, GetNetworkStatistics)
+{
+    InitializeWithDefaults();
+    Connection.Paths[0].SmoothedRtt = 1000;
+    CC->QuicCongestionControlOnDataSent(CC, 3 * kMss);
+
+    QUIC_NETWORK_STATISTICS Stats{};
+    CC->QuicCongestionControlGetNetworkStatistics(&Connection, CC, &Stats);
+    ASSERT_EQ(Stats.BytesInFlight, 3 * kMss);
+    ASSERT_EQ(Stats.CongestionWindow, 10 * kMss);
+    ASSERT_EQ(Stats.SmoothedRTT, 1000u);
+    ASSERT_EQ(Stats.Bandwidth, 10 * kMss / 1000);
+}
@@ -200,6 +200,97 @@ TEST_P(AckFrameTest, DecodeAckFrameFail) {
     QuicRangeUninitialize(&DecodedAckBlocks);
 }
 
+TEST_P(AckFrameTest, AckFrameEncodeDecodeManyBlocks)
+{
+    const uint32_t BlockCount = 200;
+    QUIC_ACK_ECN_EX Ecn = {4, 4, 4};
+    QUIC_ACK_ECN_EX DecodedEcn;
+    QUIC_RANGE AckRange;
+    QUIC_RANGE DecodedAckRange;
+    uint8_t Buffer[2048];
+    uint16_t Offset = 0;
+    uint64_t DecodedAckDelay = 0;
+    BOOLEAN InvalidFrame = FALSE;
+    BOOLEAN Unused;
+
+    QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &AckRange);
+    QuicRangeInitialize(QUIC_MAX_RANGE_DECODE_ACKS, &DecodedAckRange);
+
+    for (uint32_t i = 0; i < BlockCount; i++) {
+        ASSERT_TRUE(QuicRangeAddRange(&AckRange, i * 100ull + (i % 7), 1 + (i % 5), &Unused) != nullptr);
+    }
+
+    ASSERT_TRUE(QuicAckFrameEncode(&AckRange, 10, (GetParam() == QUIC_FRAME_ACK ? nullptr : &Ecn), &Offset, sizeof(Buffer), Buffer));
+    uint16_t BufferLength = Offset;
+    Offset = 1;
+    ASSERT_TRUE(QuicAckFrameDecode(GetParam(), BufferLength, Buffer, &Offset, &InvalidFrame, &DecodedAckRange, &DecodedEcn, &DecodedAckDelay));
+    ASSERT_FALSE(InvalidFrame);
+    ASSERT_EQ(BufferLength, Offset);
+    ASSERT_EQ(10ull, DecodedAckDelay);
+
+    ASSERT_EQ(QuicRangeSize(&AckRange), QuicRangeSize(&DecodedAckRange));
+    for (uint32_t i = 0; i < BlockCount; i++) {
+        ASSERT_EQ(QuicRangeGet(&AckRange, i)->Low, QuicRangeGet(&DecodedAckRange, i)->Low);
+        ASSERT_EQ(QuicRangeGet(&AckRange, i)->Count, QuicRangeGet(&DecodedAckRange, i)->Count);
+    }
+
+    QuicRangeUninitialize(&AckRange);
+    QuicRangeUninitialize(&DecodedAckRange);
+}
+
+//
+// Microbenchmark of ACK frame encode and decode as a function of the number
+// of ACK blocks, e.g. under heavy reordering or loss.
+//
+TEST(FrameTest, AckFrameCostVsBlocks)
+{
+    const uint32_t BlockCounts[] = { 1, 16, 256, 4096 };
+    const uint32_t Iterations = 200;
+    uint8_t Buffer[UINT16_MAX];
+
+    for (auto BlockCount : BlockCounts) {
+        QUIC_RANGE AckRange;
+        QUIC_RANGE DecodedAckRange;
+        QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &AckRange);
+        QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &DecodedAckRange);
+
+        BOOLEAN Unused;
+        for (uint32_t i = 0; i < BlockCount; i++) {
+            ASSERT_TRUE(QuicRangeAddRange(&AckRange, i * 3ull, 2, &Unused) != nullptr);
+        }
+
+        uint16_t Offset = 0;
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t j = 0; j < Iterations; j++) {
+            Offset = 0;
+            ASSERT_TRUE(QuicAckFrameEncode(&AckRange, 0, nullptr, &Offset, sizeof(Buffer), Buffer));
+        }
+        uint64_t Encode = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        const uint16_t BufferLength = Offset;
+
+        Start = CxPlatTimeUs64();
+        for (uint32_t j = 0; j < Iterations; j++) {
+            uint64_t AckDelay;
+            BOOLEAN InvalidFrame;
+            QUIC_ACK_ECN_EX Ecn;
+            Offset = 1;
+            QuicRangeReset(&DecodedAckRange);
+            ASSERT_TRUE(QuicAckFrameDecode(QUIC_FRAME_ACK, BufferLength, Buffer, &Offset, &InvalidFrame, &DecodedAckRange, &Ecn, &AckDelay));
+        }
+        uint64_t Decode = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        ASSERT_EQ(BlockCount, QuicRangeSize(&DecodedAckRange));
+
+        printf("Blocks=%u (%u bytes): encode %llu ns, decode %llu ns\n",
+            BlockCount,
+            BufferLength,
+            (unsigned long long)(Encode * 1000 / Iterations),
+            (unsigned long long)(Decode * 1000 / Iterations));
+
+        QuicRangeUninitialize(&AckRange);
+        QuicRangeUninitialize(&DecodedAckRange);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     FrameTest,
     AckFrameTest,
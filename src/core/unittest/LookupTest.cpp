@@ -0,0 +1,610 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the connection lookup tables.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "LookupTest.cpp.clog.h"
+#endif
+
+#include <atomic>
+
+struct LookupTest : public ::testing::Test {
+    static const uint16_t PartitionCount = 4;
+    static const uint32_t CidsPerConnection = 8;
+    uint16_t PrevPartitionCount {0};
+    uint16_t PrevPartitionMask {0};
+    QUIC_LOOKUP Lookup;
+    std::vector<QUIC_CONNECTION*> Connections;
+
+    void SetUp() override {
+        PrevPartitionCount = MsQuicLib.PartitionCount;
+        PrevPartitionMask = MsQuicLib.PartitionMask;
+        MsQuicLib.PartitionCount = PartitionCount;
+        MsQuicLib.PartitionMask = PartitionCount - 1;
+        QuicLookupInitialize(&Lookup);
+    }
+
+    void TearDown() override {
+        RemoveConnections();
+        QuicLookupUninitialize(&Lookup);
+        MsQuicLib.PartitionCount = PrevPartitionCount;
+        MsQuicLib.PartitionMask = PrevPartitionMask;
+    }
+
+    void RemoveConnections() {
+        for (auto Connection : Connections) {
+            QuicLookupRemoveLocalCids(&Lookup, Connection);
+            ASSERT_EQ(1, Connection->RefCount);
+            CXPLAT_FREE(Connection, QUIC_POOL_CONN);
+        }
+        Connections.clear();
+    }
+
+    //
+    // Starts over with an empty lookup of the given type.
+    //
+    void Reset(BOOLEAN OpenAddressing) {
+        RemoveConnections();
+        QuicLookupUninitialize(&Lookup);
+        QuicLookupInitialize(&Lookup);
+        Lookup.OpenAddressing = OpenAddressing;
+    }
+
+    QUIC_CONNECTION* NewConnection() {
+        auto Connection =
+            (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONNECTION), QUIC_POOL_CONN);
+        if (Connection != nullptr) {
+            CxPlatZeroMemory(Connection, sizeof(QUIC_CONNECTION));
+            Connection->RefCount = 1;
+#if DEBUG
+            CxPlatRefInitializeMultiple(Connection->RefTypeBiasedCount, QUIC_CONN_REF_COUNT);
+#endif
+            Connections.push_back(Connection);
+        }
+        return Connection;
+    }
+
+    static void MakeCid(uint32_t Id, uint8_t* Data) {
+        CxPlatCopyMemory(Data, &Id, sizeof(Id));
+        CxPlatCopyMemory(Data + sizeof(Id), &Id, sizeof(Id));
+    }
+
+    BOOLEAN AddCid(QUIC_CONNECTION* Connection, uint32_t Id) {
+        uint8_t Data[8];
+        MakeCid(Id, Data);
+        QUIC_CID_HASH_ENTRY* Cid = QuicCidNewSource(Connection, sizeof(Data), Data);
+        if (Cid == nullptr) {
+            return FALSE;
+        }
+        CxPlatListPushEntry(&Connection->SourceCids, &Cid->Link);
+        return QuicLookupAddLocalCid(&Lookup, Cid, NULL);
+    }
+
+    //
+    // Creates connections with PerConnection CIDs each, numbered from
+    // FirstId, and returns the first one.
+    //
+    QUIC_CONNECTION** AddConnections(
+        uint32_t FirstId,
+        uint32_t CidCount,
+        uint32_t PerConnection = CidsPerConnection) {
+        size_t First = Connections.size();
+        for (uint32_t Id = FirstId; Id < FirstId + CidCount; ++Id) {
+            if ((Id - FirstId) % PerConnection == 0 && NewConnection() == nullptr) {
+                return nullptr;
+            }
+            if (!AddCid(Connections.back(), Id)) {
+                return nullptr;
+            }
+        }
+        return &Connections[First];
+    }
+
+    QUIC_CONNECTION* Find(uint32_t Id) {
+        uint8_t Data[8];
+        MakeCid(Id, Data);
+        QUIC_CONNECTION* Connection =
+            QuicLookupFindConnectionByLocalCid(&Lookup, Data, sizeof(Data));
+        if (Connection != nullptr) {
+            QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_RESULT);
+        }
+        return Connection;
+    }
+
+    void CheckRepartitioning();
+    void CheckRepartitioningWithReaders();
+};
+
+void LookupTest::CheckRepartitioning()
+{
+    QUIC_CONNECTION* First = NewConnection();
+    QUIC_CONNECTION* Second = NewConnection();
+    ASSERT_NE(nullptr, First);
+    ASSERT_NE(nullptr, Second);
+
+    ASSERT_TRUE(AddCid(First, 1));
+    ASSERT_EQ(0, Lookup.PartitionCount);
+    ASSERT_EQ(First, Find(1));
+
+    ASSERT_TRUE(AddCid(Second, 2));
+    ASSERT_EQ(1, Lookup.PartitionCount);
+    ASSERT_EQ(First, Find(1));
+    ASSERT_EQ(Second, Find(2));
+
+    ASSERT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+    ASSERT_EQ(4, Lookup.PartitionCount);
+    ASSERT_EQ(First, Find(1));
+    ASSERT_EQ(Second, Find(2));
+
+    //
+    // Enough CIDs to grow every partition's table a few times.
+    //
+    const uint32_t CidCount = 2048;
+    QUIC_CONNECTION** Added = AddConnections(100, CidCount);
+    ASSERT_NE(nullptr, Added);
+    std::vector<QUIC_CONNECTION*> Owners(Added, Added + CidCount / CidsPerConnection);
+    for (uint32_t Id = 100; Id < 100 + CidCount; ++Id) {
+        ASSERT_EQ(Owners[(Id - 100) / CidsPerConnection], Find(Id));
+    }
+    ASSERT_EQ(nullptr, Find(3));
+    ASSERT_FALSE(AddCid(First, 100));
+
+    QuicLookupRemoveLocalCids(&Lookup, Second);
+    QuicLookupRemoveLocalCids(&Lookup, Owners[0]);
+    ASSERT_EQ(nullptr, Find(2));
+    ASSERT_EQ(nullptr, Find(100));
+    ASSERT_EQ(Owners[1], Find(100 + CidsPerConnection));
+    ASSERT_EQ(First, Find(1));
+}
+
+TEST_F(LookupTest, CidsSurviveRepartitioning)
+{
+    CheckRepartitioning();
+}
+
+TEST_F(LookupTest, CidsSurviveRepartitioningOpenAddressing)
+{
+    Reset(TRUE);
+    CheckRepartitioning();
+}
+
+//
+// N threads look up CIDs the way receive threads do for every datagram.
+//
+struct LookupRun {
+    LookupTest* Test;
+    uint32_t ReaderCount;
+    uint32_t LookupsPerReader;
+    uint32_t CidCount;
+    CXPLAT_DISPATCH_RW_LOCK* OuterLock; // Stands in for the former shared lookup lock.
+    std::atomic<bool> Go {false};
+    std::atomic<uint32_t> Done {0};
+    std::atomic<uint32_t> Misses {0};
+
+    static CXPLAT_THREAD_CALLBACK(ReaderThread, Context) {
+        auto Run = (LookupRun*)Context;
+        uint32_t Misses = 0;
+        uint32_t Id = (uint32_t)CxPlatCurThreadID();
+        while (!Run->Go.load(std::memory_order_acquire)) { }
+        for (uint32_t i = 0; i < Run->LookupsPerReader; ++i) {
+            Id = Id * 1103515245 + 12345;
+            uint8_t Data[8];
+            LookupTest::MakeCid((Id >> 8) % Run->CidCount, Data);
+            QUIC_CONNECTION* Connection;
+            if (Run->OuterLock != nullptr) {
+                CxPlatDispatchRwLockAcquireShared(Run->OuterLock, PrevIrql);
+                Connection = QuicLookupFindConnectionByLocalCid(&Run->Test->Lookup, Data, sizeof(Data));
+                CxPlatDispatchRwLockReleaseShared(Run->OuterLock, PrevIrql);
+            } else {
+                Connection = QuicLookupFindConnectionByLocalCid(&Run->Test->Lookup, Data, sizeof(Data));
+            }
+            if (Connection == nullptr) {
+                ++Misses;
+            } else {
+                QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_RESULT);
+            }
+        }
+        Run->Misses.fetch_add(Misses);
+        Run->Done.fetch_add(1);
+        CXPLAT_THREAD_RETURN(0);
+    }
+
+    //
+    // Runs the readers, calling Writer on the test thread until they are all
+    // done. Returns the elapsed time in microseconds, or 0 on failure.
+    //
+    template<typename WriterT>
+    uint64_t Execute(WriterT Writer) {
+        std::vector<CXPLAT_THREAD> Threads(ReaderCount);
+        for (uint32_t i = 0; i < ReaderCount; ++i) {
+            CXPLAT_THREAD_CONFIG Config = { 0, 0, "lookup_reader", ReaderThread, this };
+            if (QUIC_FAILED(CxPlatThreadCreate(&Config, &Threads[i]))) {
+                return 0;
+            }
+        }
+
+        uint64_t Start = CxPlatTimeUs64();
+        Go.store(true, std::memory_order_release);
+        while (Done.load() != ReaderCount) {
+            Writer();
+        }
+        uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        for (auto& Thread : Threads) {
+            CxPlatThreadWait(&Thread);
+            CxPlatThreadDelete(&Thread);
+        }
+        return Elapsed == 0 ? 1 : Elapsed;
+    }
+};
+
+TEST_F(LookupTest, ReaderScaling)
+{
+    const uint32_t ReaderCounts[] = { 1, 2, 4, 8 };
+    const uint32_t LookupsPerReader = 100000;
+    const uint32_t CidCount = 1024;
+
+    ASSERT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+    ASSERT_NE(nullptr, AddConnections(0, CidCount));
+    const uint32_t ChurnCidCount = 256;
+    QUIC_CONNECTION** ChurnAdded = AddConnections(CidCount, ChurnCidCount);
+    ASSERT_NE(nullptr, ChurnAdded);
+    std::vector<QUIC_CONNECTION*> Churn(ChurnAdded, ChurnAdded + ChurnCidCount / CidsPerConnection);
+
+    CXPLAT_DISPATCH_RW_LOCK Lock;
+    CxPlatDispatchRwLockInitialize(&Lock);
+    auto Idle = [] { CxPlatSchedulerYield(); };
+
+    for (auto ReaderCount : ReaderCounts) {
+        const uint32_t Total = ReaderCount * LookupsPerReader;
+
+        LookupRun LockedRun { this, ReaderCount, LookupsPerReader, CidCount, &Lock };
+        uint64_t LockedUs = LockedRun.Execute(Idle);
+        ASSERT_NE(0ull, LockedUs);
+        ASSERT_EQ(0u, LockedRun.Misses.load());
+
+        LookupRun LockFreeRun { this, ReaderCount, LookupsPerReader, CidCount, nullptr };
+        uint64_t LockFreeUs = LockFreeRun.Execute(Idle);
+        ASSERT_NE(0ull, LockFreeUs);
+        ASSERT_EQ(0u, LockFreeRun.Misses.load());
+
+        printf("Readers=%u: %u lookups, shared lock %llu us (%llu ns/lookup), epoch %llu us (%llu ns/lookup)\n",
+            ReaderCount,
+            Total,
+            (unsigned long long)LockedUs,
+            (unsigned long long)(LockedUs * 1000 / Total),
+            (unsigned long long)LockFreeUs,
+            (unsigned long long)(LockFreeUs * 1000 / Total));
+    }
+
+    CxPlatDispatchRwLockUninitialize(&Lock);
+
+    //
+    // Readers must never miss a bound CID while other CIDs are added and
+    // removed, growing the tables and moving entries between chains.
+    //
+    uint32_t NextId = CidCount + ChurnCidCount;
+    uint32_t Batches = 0;
+    LookupRun ChurnRun { this, 4, LookupsPerReader, CidCount, nullptr };
+    uint64_t ChurnUs = ChurnRun.Execute([&] {
+        for (auto Connection : Churn) {
+            QuicLookupRemoveLocalCids(&Lookup, Connection);
+        }
+        for (uint32_t i = 0; i < ChurnCidCount; ++i) {
+            (void)AddCid(Churn[i / CidsPerConnection], NextId++);
+        }
+        ++Batches;
+    });
+    ASSERT_NE(0ull, ChurnUs);
+    ASSERT_EQ(0u, ChurnRun.Misses.load());
+    printf("Readers=4 with churn: %u lookups, %u remove/add batches of %u CIDs, %llu us\n",
+        4 * LookupsPerReader,
+        Batches,
+        ChurnCidCount,
+        (unsigned long long)ChurnUs);
+}
+
+TEST_F(LookupTest, OpenAddressingChurn)
+{
+    const uint32_t CidCount = 1024;
+    const uint32_t ChurnCidCount = 256;
+    const uint32_t LookupsPerReader = 100000;
+
+    Reset(TRUE);
+    ASSERT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+    ASSERT_NE(nullptr, AddConnections(0, CidCount));
+    QUIC_CONNECTION** ChurnAdded = AddConnections(CidCount, ChurnCidCount);
+    ASSERT_NE(nullptr, ChurnAdded);
+    std::vector<QUIC_CONNECTION*> Churn(ChurnAdded, ChurnAdded + ChurnCidCount / CidsPerConnection);
+
+    //
+    // Removed slots are reused or cleaned up by rehashing, without readers
+    // ever missing a CID that stays bound.
+    //
+    uint32_t NextId = CidCount + ChurnCidCount;
+    uint32_t Batches = 0;
+    LookupRun Run { this, 4, LookupsPerReader, CidCount, nullptr };
+    uint64_t ElapsedUs = Run.Execute([&] {
+        for (auto Connection : Churn) {
+            QuicLookupRemoveLocalCids(&Lookup, Connection);
+        }
+        for (uint32_t i = 0; i < ChurnCidCount; ++i) {
+            (void)AddCid(Churn[i / CidsPerConnection], NextId++);
+        }
+        ++Batches;
+    });
+    ASSERT_NE(0ull, ElapsedUs);
+    ASSERT_EQ(0u, Run.Misses.load());
+
+    for (uint32_t Id = 0; Id < CidCount; ++Id) {
+        ASSERT_EQ(Connections[Id / CidsPerConnection], Find(Id));
+    }
+    for (uint32_t Id = NextId - ChurnCidCount; Id < NextId; ++Id) {
+        ASSERT_NE(nullptr, Find(Id));
+    }
+    ASSERT_EQ(nullptr, Find(NextId - ChurnCidCount - 1));
+    printf("Readers=4 with churn, open addressing: %u lookups, %u remove/add batches of %u CIDs, %llu us\n",
+        4 * LookupsPerReader,
+        Batches,
+        ChurnCidCount,
+        (unsigned long long)ElapsedUs);
+}
+
+//
+// Readers look up CIDs 1 to 2 * CidCount, of which only the first half are
+// known, until told to stop.
+//
+struct RepartitionRun {
+    LookupTest* Test;
+    uint32_t CidCount;
+    std::atomic<bool> Stop {false};
+    std::atomic<uint32_t> Started {0};
+    std::atomic<uint32_t> WrongResults {0};
+
+    static CXPLAT_THREAD_CALLBACK(ReaderThread, Context) {
+        auto Run = (RepartitionRun*)Context;
+        uint32_t Id = (uint32_t)CxPlatCurThreadID();
+        Run->Started.fetch_add(1);
+        while (!Run->Stop.load(std::memory_order_acquire)) {
+            Id = Id * 1103515245 + 12345;
+            const uint32_t CidId = 1 + (Id >> 8) % (2 * Run->CidCount);
+            uint8_t Data[8];
+            LookupTest::MakeCid(CidId, Data);
+            QUIC_CONNECTION* Connection =
+                QuicLookupFindConnectionByLocalCid(&Run->Test->Lookup, Data, sizeof(Data));
+            if ((Connection != nullptr) != (CidId <= Run->CidCount)) {
+                Run->WrongResults.fetch_add(1);
+            }
+            if (Connection != nullptr) {
+                QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_RESULT);
+            }
+        }
+        CXPLAT_THREAD_RETURN(0);
+    }
+};
+
+//
+// Repartitions from one table to all of them while readers run. Every new
+// table gets far more CIDs than it starts with room for, so it grows (or
+// rehashes) in the middle of the move, while readers that miss are retrying.
+// The move must not wait for those readers, or the two wait on each other.
+//
+void LookupTest::CheckRepartitioningWithReaders()
+{
+    const uint32_t ReaderCount = 4;
+    const uint32_t CidCount = 64 * 1024;
+
+    //
+    // A second connection moves the lookup to a single table.
+    //
+    ASSERT_NE(nullptr, AddConnections(1, 2, 1));
+    ASSERT_NE(nullptr, AddConnections(3, CidCount - 2));
+    ASSERT_EQ(1, Lookup.PartitionCount);
+
+    RepartitionRun Run { this, CidCount };
+    std::vector<CXPLAT_THREAD> Threads(ReaderCount);
+    for (uint32_t i = 0; i < ReaderCount; ++i) {
+        CXPLAT_THREAD_CONFIG Config = { 0, 0, "lookup_reader", RepartitionRun::ReaderThread, &Run };
+        ASSERT_TRUE(QUIC_SUCCEEDED(CxPlatThreadCreate(&Config, &Threads[i])));
+    }
+    while (Run.Started.load() != ReaderCount) {
+        CxPlatSchedulerYield();
+    }
+
+    const BOOLEAN Result = QuicLookupMaximizePartitioning(&Lookup);
+
+    Run.Stop.store(true, std::memory_order_release);
+    for (auto& Thread : Threads) {
+        CxPlatThreadWait(&Thread);
+        CxPlatThreadDelete(&Thread);
+    }
+
+    ASSERT_TRUE(Result);
+    ASSERT_EQ(4, Lookup.PartitionCount);
+    ASSERT_EQ(0u, Run.WrongResults.load());
+    for (uint32_t Id = 1; Id <= CidCount; Id += 97) {
+        ASSERT_NE(nullptr, Find(Id));
+    }
+}
+
+TEST_F(LookupTest, RepartitionWithReaders)
+{
+    CheckRepartitioningWithReaders();
+}
+
+TEST_F(LookupTest, RepartitionWithReadersOpenAddressing)
+{
+    Reset(TRUE);
+    CheckRepartitioningWithReaders();
+}
+
+//
+// A CID in the former chained CXPLAT_HASHTABLE partitions.
+//
+struct HashtableCid {
+    CXPLAT_HASHTABLE_ENTRY Entry;
+    QUIC_CONNECTION* Connection;
+    uint8_t Length;
+    uint8_t Data[8];
+};
+
+static
+CXPLAT_HASHTABLE*
+GetHashtable(
+    CXPLAT_HASHTABLE** Tables,
+    const uint8_t* Cid
+    )
+{
+    uint16_t PartitionIndex;
+    CxPlatCopyMemory(&PartitionIndex, Cid + MsQuicLib.CidServerIdLength, 2);
+    PartitionIndex &= MsQuicLib.PartitionMask;
+    return Tables[PartitionIndex % MsQuicLib.PartitionCount];
+}
+
+static
+QUIC_CONNECTION*
+HashtableFind(
+    CXPLAT_HASHTABLE** Tables,
+    const uint8_t* Cid,
+    uint8_t Length
+    )
+{
+    CXPLAT_HASHTABLE* Table = GetHashtable(Tables, Cid);
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* Entry =
+        CxPlatHashtableLookup(Table, CxPlatHashSimple(Length, Cid), &Context);
+    while (Entry != NULL) {
+        HashtableCid* Candidate = CXPLAT_CONTAINING_RECORD(Entry, HashtableCid, Entry);
+        if (Candidate->Length == Length && memcmp(Cid, Candidate->Data, Length) == 0) {
+            return Candidate->Connection;
+        }
+        Entry = CxPlatHashtableLookupNext(Table, &Context);
+    }
+    return NULL;
+}
+
+//
+// Inserts, then looks up present and absent CIDs, in a million-CID lookup
+// with each table type.
+//
+TEST_F(LookupTest, MillionCids)
+{
+    const uint32_t CidCount = 1000000;
+    const uint32_t PerConnection = 250;
+    const uint32_t LookupCount = 1000000;
+    uint64_t InsertUs[3], HitUs[3], MissUs[3];
+    uint32_t Found;
+
+    //
+    // Random order, the same for every table type.
+    //
+    std::vector<uint32_t> Ids(LookupCount);
+    uint32_t Random = 12345;
+    for (auto& Id : Ids) {
+        Random = Random * 1103515245 + 12345;
+        Id = (Random >> 4) % CidCount;
+    }
+
+    {
+        CXPLAT_HASHTABLE* Tables[PartitionCount] = {};
+        std::vector<HashtableCid*> Cids(CidCount);
+        QUIC_CONNECTION* Connection = NewConnection();
+        ASSERT_NE(nullptr, Connection);
+        for (auto& Table : Tables) {
+            ASSERT_TRUE(CxPlatHashtableInitialize(&Table, CXPLAT_HASH_MIN_SIZE));
+        }
+
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t Id = 0; Id < CidCount; ++Id) {
+            HashtableCid* Cid =
+                (HashtableCid*)CXPLAT_ALLOC_NONPAGED(sizeof(HashtableCid), QUIC_POOL_CIDHASH);
+            ASSERT_NE(nullptr, Cid);
+            Cids[Id] = Cid;
+            Cid->Connection = Connection;
+            Cid->Length = sizeof(Cid->Data);
+            MakeCid(Id, Cid->Data);
+            ASSERT_EQ(nullptr, HashtableFind(Tables, Cid->Data, Cid->Length));
+            CxPlatHashtableInsert(
+                GetHashtable(Tables, Cid->Data),
+                &Cid->Entry,
+                CxPlatHashSimple(Cid->Length, Cid->Data),
+                NULL);
+        }
+        InsertUs[0] = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        Found = 0;
+        Start = CxPlatTimeUs64();
+        for (auto Id : Ids) {
+            uint8_t Data[8];
+            MakeCid(Id, Data);
+            Found += HashtableFind(Tables, Data, sizeof(Data)) != nullptr;
+        }
+        HitUs[0] = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        ASSERT_EQ(LookupCount, Found);
+
+        Found = 0;
+        Start = CxPlatTimeUs64();
+        for (auto Id : Ids) {
+            uint8_t Data[8];
+            MakeCid(CidCount + Id, Data);
+            Found += HashtableFind(Tables, Data, sizeof(Data)) != nullptr;
+        }
+        MissUs[0] = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        ASSERT_EQ(0u, Found);
+
+        for (auto Cid : Cids) {
+            CxPlatHashtableRemove(GetHashtable(Tables, Cid->Data), &Cid->Entry, NULL);
+            CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+        }
+        for (auto Table : Tables) {
+            CxPlatHashtableUninitialize(Table);
+        }
+    }
+
+    for (uint32_t i = 1; i <= 2; ++i) {
+        Reset(i == 2);
+        ASSERT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+
+        uint64_t Start = CxPlatTimeUs64();
+        ASSERT_NE(nullptr, AddConnections(0, CidCount, PerConnection));
+        InsertUs[i] = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        Found = 0;
+        Start = CxPlatTimeUs64();
+        for (auto Id : Ids) {
+            Found += Find(Id) != nullptr;
+        }
+        HitUs[i] = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        ASSERT_EQ(LookupCount, Found);
+
+        Found = 0;
+        Start = CxPlatTimeUs64();
+        for (auto Id : Ids) {
+            Found += Find(CidCount + Id) != nullptr;
+        }
+        MissUs[i] = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        ASSERT_EQ(0u, Found);
+    }
+
+    //
+    // Insert includes allocating the CID and the duplicate check. Lookups
+    // through QUIC_LOOKUP also take and release a connection reference.
+    //
+    const char* Names[] = { "CXPLAT_HASHTABLE", "chained", "open addressing" };
+    for (uint32_t i = 0; i < 3; ++i) {
+        printf("%u CIDs, %s: insert %llu ns, hit %llu ns, miss %llu ns\n",
+            CidCount,
+            Names[i],
+            (unsigned long long)(InsertUs[i] * 1000 / CidCount),
+            (unsigned long long)(HitUs[i] * 1000 / LookupCount),
+            (unsigned long long)(MissUs[i] * 1000 / LookupCount));
+    }
+}
@@ -0,0 +1,298 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the connection operation queue.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "OperationQueueTest.cpp.clog.h"
+#endif
+
+#include <atomic>
+
+struct OperationQueueTest : public ::testing::Test {
+    QUIC_PARTITION* Partition {nullptr};
+    QUIC_OPERATION_QUEUE OperQ;
+
+    void SetUp() override {
+        Partition = new(std::nothrow) QUIC_PARTITION;
+        ASSERT_NE(nullptr, Partition);
+        CxPlatZeroMemory(Partition, sizeof(*Partition));
+        QuicOperationQueueInitialize(&OperQ);
+    }
+
+    void TearDown() override {
+        QuicOperationQueueUninitialize(&OperQ);
+        delete Partition;
+    }
+
+    static void InitOper(QUIC_OPERATION* Oper) {
+        CxPlatZeroMemory(Oper, sizeof(*Oper));
+        Oper->Type = QUIC_OPER_TYPE_TIMER_EXPIRED;
+    }
+
+    BOOLEAN Enqueue(QUIC_OPERATION* Oper) {
+        return QuicOperationEnqueue(&OperQ, Partition, Oper);
+    }
+
+    QUIC_OPERATION* Dequeue() {
+        return QuicOperationDequeue(&OperQ, Partition);
+    }
+};
+
+TEST_F(OperationQueueTest, Fifo)
+{
+    QUIC_OPERATION Opers[4];
+    for (auto& Oper : Opers) {
+        InitOper(&Oper);
+    }
+
+    ASSERT_TRUE(Enqueue(&Opers[0]));
+    ASSERT_FALSE(Enqueue(&Opers[1]));
+    ASSERT_EQ(&Opers[0], Dequeue());
+
+    //
+    // Operations pushed while the consumer holds older ones stay behind them.
+    //
+    ASSERT_FALSE(Enqueue(&Opers[2]));
+    ASSERT_EQ(&Opers[1], Dequeue());
+    ASSERT_FALSE(Enqueue(&Opers[3]));
+    ASSERT_EQ(&Opers[2], Dequeue());
+    ASSERT_EQ(&Opers[3], Dequeue());
+    ASSERT_EQ(nullptr, Dequeue());
+
+    //
+    // Once drained, the next operation must get the queue processed again.
+    //
+    ASSERT_TRUE(Enqueue(&Opers[0]));
+    ASSERT_FALSE(Enqueue(&Opers[1]));
+    ASSERT_EQ(&Opers[0], Dequeue());
+    ASSERT_EQ(&Opers[1], Dequeue());
+    ASSERT_EQ(nullptr, Dequeue());
+    ASSERT_EQ(0, Partition->PerfCounters[QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH]);
+    ASSERT_EQ(6, Partition->PerfCounters[QUIC_PERF_COUNTER_CONN_OPER_QUEUED]);
+}
+
+TEST_F(OperationQueueTest, PriorityFirst)
+{
+    QUIC_OPERATION Regular1, Regular2, Priority1, Priority2, Front;
+    InitOper(&Regular1);
+    InitOper(&Regular2);
+    InitOper(&Priority1);
+    InitOper(&Priority2);
+    InitOper(&Front);
+
+    ASSERT_FALSE(QuicOperationHasPriority(&OperQ));
+    ASSERT_TRUE(Enqueue(&Regular1));
+    ASSERT_FALSE(QuicOperationHasPriority(&OperQ));
+    ASSERT_FALSE(QuicOperationEnqueuePriority(&OperQ, Partition, &Priority1));
+    ASSERT_FALSE(Enqueue(&Regular2));
+    ASSERT_FALSE(QuicOperationEnqueueFront(&OperQ, Partition, &Front));
+    ASSERT_FALSE(QuicOperationEnqueuePriority(&OperQ, Partition, &Priority2));
+    ASSERT_TRUE(QuicOperationHasPriority(&OperQ));
+
+    ASSERT_EQ(&Front, Dequeue());
+    ASSERT_EQ(&Priority1, Dequeue());
+    ASSERT_EQ(&Priority2, Dequeue());
+    ASSERT_FALSE(QuicOperationHasPriority(&OperQ));
+    ASSERT_EQ(&Regular1, Dequeue());
+    ASSERT_EQ(&Regular2, Dequeue());
+    ASSERT_EQ(nullptr, Dequeue());
+
+    ASSERT_TRUE(QuicOperationEnqueuePriority(&OperQ, Partition, &Priority1));
+    ASSERT_EQ(&Priority1, Dequeue());
+    ASSERT_EQ(nullptr, Dequeue());
+}
+
+//
+// The previous queue design, kept to compare against: every enqueue and
+// dequeue takes the queue's lock.
+//
+struct LockedOperationQueue {
+    CXPLAT_DISPATCH_LOCK Lock;
+    CXPLAT_LIST_ENTRY List;
+    BOOLEAN ActivelyProcessing {FALSE};
+
+    LockedOperationQueue() {
+        CxPlatDispatchLockInitialize(&Lock);
+        CxPlatListInitializeHead(&List);
+    }
+    ~LockedOperationQueue() {
+        CxPlatDispatchLockUninitialize(&Lock);
+    }
+
+    BOOLEAN Enqueue(QUIC_PARTITION* Partition, QUIC_OPERATION* Oper) {
+        Oper->QueueTimeUs = CxPlatTimeUs32();
+        CxPlatDispatchLockAcquire(&Lock);
+        BOOLEAN StartProcessing = CxPlatListIsEmpty(&List) && !ActivelyProcessing;
+        CxPlatListInsertTail(&List, &Oper->Link);
+        CxPlatDispatchLockRelease(&Lock);
+        QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUED, 1);
+        QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH, 1);
+        return StartProcessing;
+    }
+
+    QUIC_OPERATION* Dequeue(QUIC_PARTITION* Partition) {
+        QUIC_OPERATION* Oper = NULL;
+        CxPlatDispatchLockAcquire(&Lock);
+        ActivelyProcessing = !CxPlatListIsEmpty(&List);
+        if (ActivelyProcessing) {
+            Oper = CXPLAT_CONTAINING_RECORD(CxPlatListRemoveHead(&List), QUIC_OPERATION, Link);
+        }
+        CxPlatDispatchLockRelease(&Lock);
+        if (Oper != NULL) {
+            QuicPerfCounterAdd(Partition, QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH, -1);
+        }
+        return Oper;
+    }
+};
+
+//
+// N producer threads queue operations on one queue while the test thread
+// drains it, the way app threads calling StreamSend feed a connection's worker.
+//
+template<typename QueueT>
+struct ContentionRun {
+    QueueT& Queue;
+    QUIC_OPERATION* Opers;
+    uint32_t ProducerCount;
+    uint32_t OpersPerProducer;
+    std::atomic<bool> Go {false};
+    std::atomic<uint32_t> ScheduleCount {0};
+
+    struct Producer {
+        ContentionRun* Run;
+        uint32_t Index;
+    };
+
+    ContentionRun(QueueT& Queue, QUIC_OPERATION* Opers, uint32_t ProducerCount, uint32_t OpersPerProducer) :
+        Queue(Queue), Opers(Opers), ProducerCount(ProducerCount), OpersPerProducer(OpersPerProducer) { }
+
+    static CXPLAT_THREAD_CALLBACK(ProducerThread, Context) {
+        auto Prod = (Producer*)Context;
+        auto Run = Prod->Run;
+        QUIC_OPERATION* Base = Run->Opers + (size_t)Prod->Index * Run->OpersPerProducer;
+        while (!Run->Go.load(std::memory_order_acquire)) { }
+        for (uint32_t i = 0; i < Run->OpersPerProducer; ++i) {
+            if (Run->Queue.Enqueue(&Base[i])) {
+                Run->ScheduleCount.fetch_add(1);
+            }
+        }
+        CXPLAT_THREAD_RETURN(0);
+    }
+
+    //
+    // Returns the elapsed time in microseconds, or 0 on failure.
+    //
+    uint64_t Execute() {
+        const uint32_t Total = ProducerCount * OpersPerProducer;
+        for (uint32_t i = 0; i < Total; ++i) {
+            OperationQueueTest::InitOper(&Opers[i]);
+        }
+
+        std::vector<Producer> Producers(ProducerCount);
+        std::vector<CXPLAT_THREAD> Threads(ProducerCount);
+        for (uint32_t i = 0; i < ProducerCount; ++i) {
+            Producers[i] = { this, i };
+            CXPLAT_THREAD_CONFIG Config = { 0, 0, "opq_producer", ProducerThread, &Producers[i] };
+            if (QUIC_FAILED(CxPlatThreadCreate(&Config, &Threads[i]))) {
+                return 0;
+            }
+        }
+
+        //
+        // Each time a producer reports the queue must be processed, the
+        // consumer drains it until the queue reports it is empty. Operations
+        // from one producer must come out in the order they went in.
+        //
+        std::vector<uint32_t> NextExpected(ProducerCount, 0);
+        uint32_t Dequeued = 0;
+        uint32_t Drains = 0;
+        bool InOrder = true;
+        uint64_t Start = CxPlatTimeUs64();
+        Go.store(true, std::memory_order_release);
+        while (Dequeued < Total) {
+            if (ScheduleCount.load() == Drains) {
+                continue;
+            }
+            ++Drains;
+            QUIC_OPERATION* Oper;
+            while ((Oper = Queue.Dequeue()) != NULL) {
+                size_t Index = (size_t)(Oper - Opers);
+                uint32_t Prod = (uint32_t)(Index / OpersPerProducer);
+                InOrder &= NextExpected[Prod]++ == (uint32_t)(Index % OpersPerProducer);
+                ++Dequeued;
+            }
+        }
+        uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        for (auto& Thread : Threads) {
+            CxPlatThreadWait(&Thread);
+            CxPlatThreadDelete(&Thread);
+        }
+
+        //
+        // Every time the queue was handed to the consumer it was drained, and
+        // it was never handed over while already being processed.
+        //
+        if (!InOrder || Drains != ScheduleCount.load() || Queue.Dequeue() != NULL) {
+            return 0;
+        }
+        return Elapsed == 0 ? 1 : Elapsed;
+    }
+};
+
+struct LockFreeQueueAdapter {
+    QUIC_OPERATION_QUEUE* OperQ;
+    QUIC_PARTITION* Partition;
+    BOOLEAN Enqueue(QUIC_OPERATION* Oper) { return QuicOperationEnqueue(OperQ, Partition, Oper); }
+    QUIC_OPERATION* Dequeue() { return QuicOperationDequeue(OperQ, Partition); }
+};
+
+struct LockedQueueAdapter {
+    LockedOperationQueue* Queue;
+    QUIC_PARTITION* Partition;
+    BOOLEAN Enqueue(QUIC_OPERATION* Oper) { return Queue->Enqueue(Partition, Oper); }
+    QUIC_OPERATION* Dequeue() { return Queue->Dequeue(Partition); }
+};
+
+TEST_F(OperationQueueTest, ContentionCost)
+{
+    const uint32_t ProducerCounts[] = { 1, 2, 4, 8 };
+    const uint32_t OpersPerProducer = 50000;
+
+    std::vector<QUIC_OPERATION> Opers((size_t)8 * OpersPerProducer);
+    LockedOperationQueue Locked;
+    LockFreeQueueAdapter LockFreeAdapter = { &OperQ, Partition };
+    LockedQueueAdapter LockedAdapter = { &Locked, Partition };
+
+    for (auto ProducerCount : ProducerCounts) {
+        const uint32_t Total = ProducerCount * OpersPerProducer;
+
+        ContentionRun<LockedQueueAdapter> LockedRun(
+            LockedAdapter, Opers.data(), ProducerCount, OpersPerProducer);
+        uint64_t LockedUs = LockedRun.Execute();
+        ASSERT_NE(0ull, LockedUs);
+
+        ContentionRun<LockFreeQueueAdapter> LockFreeRun(
+            LockFreeAdapter, Opers.data(), ProducerCount, OpersPerProducer);
+        uint64_t LockFreeUs = LockFreeRun.Execute();
+        ASSERT_NE(0ull, LockFreeUs);
+
+        printf("Producers=%u: %u operations, locked %llu us (%llu ns/op), lock-free %llu us (%llu ns/op)\n",
+            ProducerCount,
+            Total,
+            (unsigned long long)LockedUs,
+            (unsigned long long)(LockedUs * 1000 / Total),
+            (unsigned long long)LockFreeUs,
+            (unsigned long long)(LockFreeUs * 1000 / Total));
+    }
+
+    ASSERT_EQ(0, Partition->PerfCounters[QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH]);
+}
@@ -5,7 +5,8 @@
 
 Abstract:
 
-    Unit test for the partition ID and index logic.
+    Unit test for the partition ID and index logic, and the stateless reset
+    tokens generated with the partition's keys.
 
 --*/
 
@@ -14,6 +15,9 @@ Abstract:
 #include "PartitionTest.cpp.clog.h"
 #endif
 
+#include <atomic>
+#include <vector>
+
 extern "C"
 void
 MsQuicCalculatePartitionMask(
@@ -48,3 +52,205 @@ TEST(PartitionTest, RandomPartitionId)
 
     MsQuicLib.PartitionCount = OldPartitionCount;
 }
+
+TEST(PartitionTest, SipHash128)
+{
+    //
+    // Reference vectors, with a key of 00..0F and inputs of 00, 01, ...
+    //
+    const uint64_t Key[2] = { 0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull };
+    const struct {
+        uint32_t Length;
+        uint8_t Output[16];
+    } Vectors[] = {
+        { 0, { 0xa3, 0x81, 0x7f, 0x04, 0xba, 0x25, 0xa8, 0xe6, 0x6d, 0xf6, 0x72, 0x14, 0xc7, 0x55, 0x02, 0x93 } },
+        { 1, { 0xda, 0x87, 0xc1, 0xd8, 0x6b, 0x99, 0xaf, 0x44, 0x34, 0x76, 0x59, 0x11, 0x9b, 0x22, 0xfc, 0x45 } },
+        { 8, { 0x3b, 0x62, 0xa9, 0xba, 0x62, 0x58, 0xf5, 0x61, 0x0f, 0x83, 0xe2, 0x64, 0xf3, 0x14, 0x97, 0xb4 } },
+        { 15, { 0x54, 0x93, 0xe9, 0x99, 0x33, 0xb0, 0xa8, 0x11, 0x7e, 0x08, 0xec, 0x0f, 0x97, 0xcf, 0xc3, 0xd9 } },
+        { 20, { 0x9e, 0x25, 0xfc, 0x83, 0x3f, 0x22, 0x90, 0x73, 0x3e, 0x93, 0x44, 0xa5, 0xe8, 0x38, 0x39, 0xeb } },
+    };
+
+    uint8_t Input[32];
+    for (uint8_t i = 0; i < sizeof(Input); ++i) {
+        Input[i] = i;
+    }
+
+    for (auto& Vector : Vectors) {
+        uint8_t Output[16];
+        QuicSipHash128(Key, Input, Vector.Length, Output);
+        ASSERT_EQ(0, memcmp(Vector.Output, Output, sizeof(Output))) << "Length " << Vector.Length;
+    }
+}
+
+struct ResetTokenPartition {
+    QUIC_PARTITION* Partition;
+    ResetTokenPartition(const uint8_t* Key, uint32_t KeyLength) {
+        Partition = new(std::nothrow) QUIC_PARTITION;
+        CXPLAT_FRE_ASSERT(Partition != nullptr);
+        CxPlatZeroMemory(Partition, sizeof(*Partition));
+        EXPECT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicPartitionInitialize(Partition, 0, 0, CXPLAT_HASH_SHA256, Key, KeyLength));
+    }
+    ~ResetTokenPartition() {
+        QuicPartitionUninitialize(Partition);
+        delete Partition;
+    }
+    void Generate(const uint8_t* Cid, uint8_t* Token, bool SipHash) {
+        const BOOLEAN OldSipHash = MsQuicLib.StatelessResetSipHash;
+        MsQuicLib.StatelessResetSipHash = SipHash;
+        ASSERT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicLibraryGenerateStatelessResetToken(Partition, Cid, Token));
+        MsQuicLib.StatelessResetSipHash = OldSipHash;
+    }
+};
+
+TEST(PartitionTest, StatelessResetTokens)
+{
+    uint8_t Key[QUIC_STATELESS_RESET_KEY_LENGTH];
+    CxPlatRandom(sizeof(Key), Key);
+    uint8_t OtherKey[QUIC_STATELESS_RESET_KEY_LENGTH];
+    CxPlatRandom(sizeof(OtherKey), OtherKey);
+
+    ResetTokenPartition A(Key, sizeof(Key));
+    ResetTokenPartition B(Key, sizeof(Key));
+
+    uint8_t Cid[QUIC_CID_MAX_LENGTH];
+    uint8_t OtherCid[QUIC_CID_MAX_LENGTH];
+    CxPlatRandom(sizeof(Cid), Cid);
+    CxPlatCopyMemory(OtherCid, Cid, sizeof(Cid));
+    OtherCid[MsQuicLib.CidTotalLength - 1] ^= 1;
+
+    for (bool SipHash : { false, true }) {
+        //
+        // Every partition with the same key generates the same token for a
+        // CID, and different CIDs get different tokens.
+        //
+        uint8_t TokenA[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+        uint8_t TokenB[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+        A.Generate(Cid, TokenA, SipHash);
+        B.Generate(Cid, TokenB, SipHash);
+        ASSERT_EQ(0, memcmp(TokenA, TokenB, sizeof(TokenA)));
+        B.Generate(OtherCid, TokenB, SipHash);
+        ASSERT_NE(0, memcmp(TokenA, TokenB, sizeof(TokenA)));
+
+        //
+        // A new key changes the tokens, the same way as for a partition that
+        // started with it.
+        //
+        ResetTokenPartition C(OtherKey, sizeof(OtherKey));
+        ASSERT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicPartitionUpdateStatelessResetKey(
+                B.Partition, CXPLAT_HASH_SHA256, OtherKey, sizeof(OtherKey)));
+        B.Generate(Cid, TokenB, SipHash);
+        ASSERT_NE(0, memcmp(TokenA, TokenB, sizeof(TokenA)));
+        C.Generate(Cid, TokenA, SipHash);
+        ASSERT_EQ(0, memcmp(TokenA, TokenB, sizeof(TokenA)));
+        ASSERT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicPartitionUpdateStatelessResetKey(
+                B.Partition, CXPLAT_HASH_SHA256, Key, sizeof(Key)));
+    }
+
+    //
+    // The two ways generate unrelated tokens.
+    //
+    uint8_t HmacToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+    uint8_t SipHashToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+    A.Generate(Cid, HmacToken, false);
+    A.Generate(Cid, SipHashToken, true);
+    ASSERT_NE(0, memcmp(HmacToken, SipHashToken, sizeof(HmacToken)));
+
+    //
+    // Changing the setting after initialization doesn't change the tokens.
+    //
+    const uint8_t OldSetting = MsQuicLib.Settings.StatelessResetSipHashEnabled;
+    const BOOLEAN OldSipHash = MsQuicLib.StatelessResetSipHash;
+    MsQuicLib.StatelessResetSipHash = FALSE;
+    MsQuicLib.Settings.StatelessResetSipHashEnabled = TRUE;
+    uint8_t Token[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicLibraryGenerateStatelessResetToken(A.Partition, Cid, Token));
+    MsQuicLib.Settings.StatelessResetSipHashEnabled = OldSetting;
+    MsQuicLib.StatelessResetSipHash = OldSipHash;
+    ASSERT_EQ(0, memcmp(HmacToken, Token, sizeof(Token)));
+}
+
+//
+// N threads issue new CIDs (random bytes plus the stateless reset token) from
+// the same partition, as a worker and the receive threads sharing it would.
+//
+struct CidIssueRun {
+    QUIC_PARTITION* Partition;
+    uint32_t CidsPerThread;
+    std::atomic<bool> Go {false};
+
+    static CXPLAT_THREAD_CALLBACK(IssueThread, Context) {
+        auto Run = (CidIssueRun*)Context;
+        uint8_t Cid[QUIC_CID_MAX_LENGTH];
+        uint8_t Token[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+        while (!Run->Go.load(std::memory_order_acquire)) { }
+        for (uint32_t i = 0; i < Run->CidsPerThread; ++i) {
+            CxPlatRandom(MsQuicLib.CidTotalLength, Cid);
+            CXPLAT_FRE_ASSERT(
+                QUIC_SUCCEEDED(
+                QuicLibraryGenerateStatelessResetToken(Run->Partition, Cid, Token)));
+        }
+        CXPLAT_THREAD_RETURN(0);
+    }
+
+    //
+    // Returns the elapsed time in microseconds, or 0 on failure.
+    //
+    uint64_t Execute(uint32_t ThreadCount) {
+        std::vector<CXPLAT_THREAD> Threads(ThreadCount);
+        for (uint32_t i = 0; i < ThreadCount; ++i) {
+            CXPLAT_THREAD_CONFIG Config = { 0, 0, "cid_issue", IssueThread, this };
+            if (QUIC_FAILED(CxPlatThreadCreate(&Config, &Threads[i]))) {
+                return 0;
+            }
+        }
+
+        uint64_t Start = CxPlatTimeUs64();
+        Go.store(true, std::memory_order_release);
+        for (auto& Thread : Threads) {
+            CxPlatThreadWait(&Thread);
+            CxPlatThreadDelete(&Thread);
+        }
+        uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        return Elapsed == 0 ? 1 : Elapsed;
+    }
+};
+
+TEST(PartitionTest, CidIssueRate)
+{
+    const uint32_t ThreadCounts[] = { 1, 2, 4 };
+    const uint32_t CidsPerThread = 100000;
+
+    uint8_t Key[QUIC_STATELESS_RESET_KEY_LENGTH];
+    CxPlatRandom(sizeof(Key), Key);
+    ResetTokenPartition Partition(Key, sizeof(Key));
+
+    const BOOLEAN OldSipHash = MsQuicLib.StatelessResetSipHash;
+    for (auto ThreadCount : ThreadCounts) {
+        const uint64_t Total = (uint64_t)ThreadCount * CidsPerThread;
+        uint64_t ElapsedUs[2];
+        for (uint32_t SipHash = 0; SipHash < 2; ++SipHash) {
+            MsQuicLib.StatelessResetSipHash = (BOOLEAN)SipHash;
+            CidIssueRun Run { Partition.Partition, CidsPerThread };
+            ElapsedUs[SipHash] = Run.Execute(ThreadCount);
+            ASSERT_NE(0ull, ElapsedUs[SipHash]);
+        }
+        printf("Threads=%u: %llu CIDs, HMAC-SHA256 (locked) %llu us (%llu CIDs/s), SipHash %llu us (%llu CIDs/s)\n",
+            ThreadCount,
+            (unsigned long long)Total,
+            (unsigned long long)ElapsedUs[0],
+            (unsigned long long)(Total * 1000000 / ElapsedUs[0]),
+            (unsigned long long)ElapsedUs[1],
+            (unsigned long long)(Total * 1000000 / ElapsedUs[1]));
+    }
+    MsQuicLib.StatelessResetSipHash = OldSipHash;
+}
@@ -444,6 +444,94 @@ TEST(RangeTest, HitMax)
     ASSERT_EQ(range.Max(), MaxCount*2);
 }
 
+TEST(RangeTest, AddDescending)
+{
+    SmartRange range;
+    ASSERT_TRUE(QuicRangeAddRangeDescending(&range.range, 100, 5));
+    QuicRangeEndDescending(&range.range);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)1);
+    ASSERT_EQ(range.Min(), 100ull);
+    ASSERT_EQ(range.Max(), 104ull);
+
+    range.Reset();
+    for (uint32_t i = 0; i < 100; i++) {
+        ASSERT_TRUE(QuicRangeAddRangeDescending(&range.range, 1000 - i * 10, 5));
+    }
+    QuicRangeEndDescending(&range.range);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)100);
+    ASSERT_EQ(range.Min(), 10ull);
+    ASSERT_EQ(range.Max(), 1004ull);
+    for (uint32_t i = 0; i < 100; i++) {
+        ASSERT_EQ(QuicRangeGet(&range.range, i)->Low, 10ull + i * 10);
+        ASSERT_EQ(QuicRangeGet(&range.range, i)->Count, 5ull);
+    }
+
+    //
+    // The range works normally afterwards.
+    //
+    range.Add(5, 5);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)100);
+    ASSERT_EQ(range.Min(), 5ull);
+}
+
+TEST(RangeTest, AddDescendingHitMax)
+{
+    const uint32_t MaxCount = 16;
+    SmartRange range(MaxCount * sizeof(QUIC_SUBRANGE));
+    for (uint32_t i = 0; i < MaxCount; i++) {
+        ASSERT_TRUE(QuicRangeAddRangeDescending(&range.range, 1000 - i * 2, 1));
+    }
+    //
+    // Unlike adding in order, nothing is aged out.
+    //
+    ASSERT_FALSE(QuicRangeAddRangeDescending(&range.range, 0, 1));
+    QuicRangeEndDescending(&range.range);
+    ASSERT_EQ(range.ValidCount(), MaxCount);
+    ASSERT_EQ(range.Min(), 1000ull - (MaxCount - 1) * 2);
+    ASSERT_EQ(range.Max(), 1000ull);
+}
+
+//
+// Microbenchmark of building a range from subranges in descending order, as
+// they are decoded from an ACK frame, by inserting each one at the front
+// versus appending and reversing once.
+//
+TEST(RangeTest, AddDescendingCost)
+{
+    const uint32_t SubrangeCounts[] = { 16, 256, 4096 };
+    const uint32_t Iterations = 200;
+
+    for (auto SubrangeCount : SubrangeCounts) {
+        SmartRange range;
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t j = 0; j < Iterations; j++) {
+            range.Reset();
+            for (uint32_t i = SubrangeCount; i > 0; i--) {
+                ASSERT_TRUE(range.TryAdd(i * 4ull, 2));
+            }
+        }
+        uint64_t FrontInsert = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        ASSERT_EQ(range.ValidCount(), SubrangeCount);
+
+        Start = CxPlatTimeUs64();
+        for (uint32_t j = 0; j < Iterations; j++) {
+            range.Reset();
+            for (uint32_t i = SubrangeCount; i > 0; i--) {
+                ASSERT_TRUE(QuicRangeAddRangeDescending(&range.range, i * 4ull, 2));
+            }
+            QuicRangeEndDescending(&range.range);
+        }
+        uint64_t Descending = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        ASSERT_EQ(range.ValidCount(), SubrangeCount);
+        ASSERT_EQ(range.Min(), 4ull);
+
+        printf("Subranges=%u: front insert %llu ns, descending %llu ns (per range)\n",
+            SubrangeCount,
+            (unsigned long long)(FrontInsert * 1000 / Iterations),
+            (unsigned long long)(Descending * 1000 / Iterations));
+    }
+}
+
 TEST(RangeTest, SearchZero)
 {
     SmartRange range;
@@ -0,0 +1,206 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_SENT_PACKET_RING ordered sent packet tracker.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "SentPacketRingTest.cpp.clog.h"
+#endif
+
+#include <vector>
+
+struct SmartRing {
+    QUIC_SENT_PACKET_RING Ring;
+    std::vector<QUIC_SENT_PACKET_METADATA> Packets;
+    SmartRing(uint64_t MaxPacketNumber) : Packets((size_t)MaxPacketNumber) {
+        QuicSentPacketRingInitialize(&Ring);
+        for (uint64_t i = 0; i < MaxPacketNumber; i++) {
+            Packets[(size_t)i].PacketNumber = i;
+        }
+    }
+    ~SmartRing() {
+        QuicSentPacketRingRemove(&Ring, 0, QuicSentPacketRingSize(&Ring));
+        QuicSentPacketRingUninitialize(&Ring);
+    }
+    void Insert(uint64_t PacketNumber) {
+        ASSERT_TRUE(QuicSentPacketRingInsert(&Ring, &Packets[(size_t)PacketNumber]));
+        Validate();
+    }
+    //
+    // Removes all packets in [Low, High], the same way loss detection
+    // processes an ACK block. Returns the number of packets removed.
+    //
+    uint32_t Ack(uint64_t Low, uint64_t High) {
+        uint32_t Start = QuicSentPacketRingLowerBound(&Ring, Low);
+        uint32_t End = Start;
+        while (End < QuicSentPacketRingSize(&Ring) &&
+               QuicSentPacketRingGet(&Ring, End)->PacketNumber <= High) {
+            End++;
+        }
+        QuicSentPacketRingRemove(&Ring, Start, End - Start);
+        return End - Start;
+    }
+    uint32_t Size() const {
+        return QuicSentPacketRingSize(&Ring);
+    }
+    uint64_t Get(uint32_t Index) const {
+        return QuicSentPacketRingGet(&Ring, Index)->PacketNumber;
+    }
+    void Validate() const {
+        for (uint32_t i = 1; i < Size(); i++) {
+            ASSERT_LT(Get(i - 1), Get(i));
+        }
+    }
+};
+
+TEST(SentPacketRingTest, Empty)
+{
+    SmartRing ring(1);
+    ASSERT_EQ(0u, ring.Size());
+    ASSERT_EQ(nullptr, QuicSentPacketRingFirst(&ring.Ring));
+    ASSERT_EQ(nullptr, QuicSentPacketRingLast(&ring.Ring));
+    ASSERT_EQ(0u, QuicSentPacketRingLowerBound(&ring.Ring, 0));
+}
+
+TEST(SentPacketRingTest, AppendAndGrow)
+{
+    const uint32_t Count = QUIC_SENT_PACKET_RING_INITIAL_SIZE * 16;
+    SmartRing ring(Count);
+    for (uint32_t i = 0; i < Count; i++) {
+        ring.Insert(i);
+    }
+    ASSERT_EQ(Count, ring.Size());
+    ASSERT_EQ(0ull, QuicSentPacketRingFirst(&ring.Ring)->PacketNumber);
+    ASSERT_EQ((uint64_t)Count - 1, QuicSentPacketRingLast(&ring.Ring)->PacketNumber);
+    for (uint32_t i = 0; i < Count; i++) {
+        ASSERT_EQ((uint64_t)i, ring.Get(i));
+    }
+}
+
+TEST(SentPacketRingTest, InsertOutOfOrder)
+{
+    SmartRing ring(64);
+    const uint64_t Order[] = { 10, 20, 5, 15, 30, 1, 25, 12, 40, 0, 35 };
+    for (auto PacketNumber : Order) {
+        ring.Insert(PacketNumber);
+    }
+    ASSERT_EQ((uint32_t)ARRAYSIZE(Order), ring.Size());
+    ASSERT_EQ(0ull, ring.Get(0));
+    ASSERT_EQ(40ull, ring.Get(ring.Size() - 1));
+}
+
+TEST(SentPacketRingTest, LowerBound)
+{
+    SmartRing ring(32);
+    for (uint64_t i = 0; i < 32; i += 2) {
+        ring.Insert(i);
+    }
+    ASSERT_EQ(0u, QuicSentPacketRingLowerBound(&ring.Ring, 0));
+    ASSERT_EQ(1u, QuicSentPacketRingLowerBound(&ring.Ring, 1));
+    ASSERT_EQ(1u, QuicSentPacketRingLowerBound(&ring.Ring, 2));
+    ASSERT_EQ(8u, QuicSentPacketRingLowerBound(&ring.Ring, 15));
+    ASSERT_EQ(15u, QuicSentPacketRingLowerBound(&ring.Ring, 30));
+    ASSERT_EQ(16u, QuicSentPacketRingLowerBound(&ring.Ring, 31));
+    ASSERT_EQ(16u, QuicSentPacketRingLowerBound(&ring.Ring, 100));
+}
+
+TEST(SentPacketRingTest, RemoveFrontMiddleBack)
+{
+    SmartRing ring(100);
+    for (uint64_t i = 0; i < 100; i++) {
+        ring.Insert(i);
+    }
+    ASSERT_EQ(10u, ring.Ack(0, 9));     // Front
+    ASSERT_EQ(10ull, ring.Get(0));
+    ASSERT_EQ(10u, ring.Ack(90, 120));  // Back
+    ASSERT_EQ(89ull, ring.Get(ring.Size() - 1));
+    ASSERT_EQ(5u, ring.Ack(20, 24));    // Middle, closer to the front
+    ASSERT_EQ(5u, ring.Ack(80, 84));    // Middle, closer to the back
+    ASSERT_EQ(0u, ring.Ack(20, 24));    // Already removed
+    ASSERT_EQ(70u, ring.Size());
+    ring.Validate();
+    for (uint32_t i = 0; i < ring.Size(); i++) {
+        uint64_t PacketNumber = ring.Get(i);
+        ASSERT_FALSE(PacketNumber >= 20 && PacketNumber <= 24);
+        ASSERT_FALSE(PacketNumber >= 80 && PacketNumber <= 84);
+    }
+}
+
+TEST(SentPacketRingTest, WrapAround)
+{
+    //
+    // Keep the ring at a constant size so head and tail wrap many times.
+    //
+    const uint32_t Window = QUIC_SENT_PACKET_RING_INITIAL_SIZE;
+    const uint64_t Total = 1000;
+    SmartRing ring(Total);
+    uint64_t Next = 0;
+    for (; Next < Window; Next++) {
+        ring.Insert(Next);
+    }
+    while (Next < Total) {
+        //
+        // Leave a hole at the head, ACK the second packet and send another.
+        //
+        uint64_t Second = ring.Get(1);
+        ASSERT_EQ(1u, ring.Ack(Second, Second));
+        ring.Insert(Next++);
+        if (Next % 3 == 0) {
+            ASSERT_EQ(1u, ring.Ack(ring.Get(0), ring.Get(0)));
+            ring.Insert(Next++);
+        }
+        ASSERT_EQ(Window, ring.Size());
+    }
+    ASSERT_EQ(Total - 1, ring.Get(ring.Size() - 1));
+}
+
+//
+// Microbenchmark of per-ACK cost as a function of the number of packets in
+// flight. A persistent hole at the front of the ring (a packet waiting to be
+// declared lost) is the worst case for a list that must be walked from the
+// head; with the ring the cost should stay flat as in-flight grows.
+//
+TEST(SentPacketRingTest, AckCostVsInFlight)
+{
+    const uint32_t InFlightCounts[] = { 1000, 10000, 100000 };
+    const uint32_t AckCount = 20000;
+    const uint32_t PacketsPerAck = 2;
+
+    for (auto InFlight : InFlightCounts) {
+        SmartRing ring((uint64_t)InFlight + 1 + (uint64_t)AckCount * PacketsPerAck);
+        uint64_t Next = 0;
+        for (; Next < (uint64_t)InFlight + 1; Next++) {
+            ring.Insert(Next);
+        }
+
+        uint64_t Start = CxPlatTimeUs64();
+        uint64_t LargestAcked = 0;
+        for (uint32_t i = 0; i < AckCount; i++) {
+            //
+            // Cumulative ACK of everything after the hole at packet 0.
+            //
+            LargestAcked += PacketsPerAck;
+            uint32_t Acked = ring.Ack(1, LargestAcked);
+            ASSERT_EQ(PacketsPerAck, Acked);
+            for (uint32_t j = 0; j < PacketsPerAck; j++) {
+                ASSERT_TRUE(QuicSentPacketRingInsert(&ring.Ring, &ring.Packets[(size_t)Next++]));
+            }
+        }
+        uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        ASSERT_EQ(InFlight + 1, ring.Size());
+        ASSERT_EQ(0ull, ring.Get(0));
+        printf("InFlight=%u: %u ACKs in %llu us (%llu ns/ACK)\n",
+            InFlight,
+            AckCount,
+            (unsigned long long)Elapsed,
+            (unsigned long long)(Elapsed * 1000 / AckCount));
+    }
+}
@@ -126,6 +126,12 @@ TEST(SettingsTest, TestAllSettingsFieldsSet)
     SETTINGS_FEATURE_SET_TEST(ReliableResetEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(XdpEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(QTIPEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(CarefulResumeEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(AdaptiveAckFrequencyEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(WorkerRebalancingEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(OpenAddressingLookupEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(ResumptionTicketCacheEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(StatelessResetSipHashEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(OneWayDelayEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(NetStatsEventEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(StreamMultiReceiveEnabled, QuicSettingsSettingsToInternal);
@@ -217,6 +223,12 @@ TEST(SettingsTest, TestAllSettingsFieldsGet)
     SETTINGS_FEATURE_GET_TEST(ReliableResetEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_SET_TEST(XdpEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(QTIPEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(CarefulResumeEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(AdaptiveAckFrequencyEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(WorkerRebalancingEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(OpenAddressingLookupEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(ResumptionTicketCacheEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(StatelessResetSipHashEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_GET_TEST(OneWayDelayEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(NetStatsEventEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(StreamMultiReceiveEnabled, QuicSettingsGetSettings);
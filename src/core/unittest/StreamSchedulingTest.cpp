@@ -0,0 +1,345 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the priority ordered stream send queue.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "StreamSchedulingTest.cpp.clog.h"
+#endif
+
+#include <memory>
+#include <random>
+#include <vector>
+
+//
+// Wraps a send queue and a set of bare streams, which are only used for their
+// send link and priority.
+//
+struct SmartSendQueue {
+    QUIC_SEND Send;
+    std::unique_ptr<QUIC_STREAM[]> Streams;
+    uint32_t StreamCount;
+    SmartSendQueue(uint32_t Count) :
+        Send(), Streams(new QUIC_STREAM[Count]()), StreamCount(Count) {
+        CxPlatListInitializeHead(&Send.SendStreams);
+        Send.PriorityBuckets = Send.PreAllocPriorityBuckets;
+        Send.PriorityBucketAllocLength = QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT;
+        for (uint32_t i = 0; i < Count; i++) {
+            Streams[i].SendPriority = QUIC_STREAM_PRIORITY_DEFAULT;
+        }
+    }
+    ~SmartSendQueue() {
+        for (uint32_t i = 0; i < StreamCount; i++) {
+            if (Queued(i)) {
+                Remove(i);
+            }
+        }
+        QuicSendUninitialize(&Send);
+    }
+    bool Queued(uint32_t Index) const {
+        return Streams[Index].SendLink.Flink != NULL;
+    }
+    void Insert(uint32_t Index) {
+        QuicSendInsertStream(&Send, &Streams[Index]);
+    }
+    void Insert(uint32_t Index, uint16_t Priority) {
+        Streams[Index].SendPriority = Priority;
+        Insert(Index);
+    }
+    void Remove(uint32_t Index) {
+        QuicSendRemoveStream(&Send, &Streams[Index], Streams[Index].SendPriority);
+        Streams[Index].SendLink.Flink = NULL;
+    }
+    void Rotate(uint32_t Index) {
+        QuicSendRotateStream(&Send, &Streams[Index]);
+    }
+    void SetPriority(uint32_t Index, uint16_t Priority) {
+        uint16_t OldPriority = Streams[Index].SendPriority;
+        Streams[Index].SendPriority = Priority;
+        QuicSendUpdateStreamPriority(&Send, &Streams[Index], OldPriority);
+    }
+    void SetScheme(QUIC_STREAM_SCHEDULING_SCHEME Scheme) {
+        QuicSendSetStreamSchedulingScheme(&Send, Scheme);
+    }
+    uint16_t QueuePriority(const QUIC_STREAM* Stream) const {
+        return
+            Send.StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR ?
+                0 : Stream->SendPriority;
+    }
+    uint32_t IndexOf(CXPLAT_LIST_ENTRY* Entry) const {
+        return (uint32_t)(CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink) - Streams.get());
+    }
+    //
+    // Returns the queued streams, in send order.
+    //
+    std::vector<uint32_t> Order() const {
+        std::vector<uint32_t> Result;
+        for (CXPLAT_LIST_ENTRY* Entry = Send.SendStreams.Flink;
+             Entry != &Send.SendStreams;
+             Entry = Entry->Flink) {
+            Result.push_back(IndexOf(Entry));
+        }
+        return Result;
+    }
+    //
+    // Verifies the queue is in priority order and that each bucket points to
+    // the last stream of its priority.
+    //
+    void Validate() const {
+        uint32_t Bucket = 0;
+        for (CXPLAT_LIST_ENTRY* Entry = Send.SendStreams.Flink;
+             Entry != &Send.SendStreams;
+             Entry = Entry->Flink) {
+            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+            if (Entry->Flink != &Send.SendStreams) {
+                ASSERT_GE(
+                    QueuePriority(Stream),
+                    QueuePriority(CXPLAT_CONTAINING_RECORD(Entry->Flink, QUIC_STREAM, SendLink)));
+            }
+            if (!Send.PriorityBucketsDisabled &&
+                (Entry->Flink == &Send.SendStreams ||
+                 QueuePriority(CXPLAT_CONTAINING_RECORD(Entry->Flink, QUIC_STREAM, SendLink)) != QueuePriority(Stream))) {
+                ASSERT_LT(Bucket, Send.PriorityBucketCount);
+                ASSERT_EQ(QueuePriority(Stream), Send.PriorityBuckets[Bucket].Priority);
+                ASSERT_EQ(Stream, Send.PriorityBuckets[Bucket].LastStream);
+                Bucket++;
+            }
+        }
+        if (!Send.PriorityBucketsDisabled) {
+            ASSERT_EQ(Bucket, Send.PriorityBucketCount);
+        }
+    }
+};
+
+TEST(StreamSchedulingTest, FifoWithinPriority)
+{
+    SmartSendQueue Queue(6);
+    Queue.Insert(0, 1);
+    Queue.Insert(1, 5);
+    Queue.Insert(2, 1);
+    Queue.Insert(3, 5);
+    Queue.Insert(4, 3);
+    Queue.Insert(5, 1);
+    Queue.Validate();
+    ASSERT_EQ(3u, Queue.Send.PriorityBucketCount);
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 3, 4, 0, 2, 5 }), Queue.Order());
+}
+
+TEST(StreamSchedulingTest, Remove)
+{
+    SmartSendQueue Queue(5);
+    Queue.Insert(0, 2);
+    Queue.Insert(1, 2);
+    Queue.Insert(2, 2);
+    Queue.Insert(3, 7);
+    Queue.Insert(4, 0);
+    Queue.Remove(2); // Last of its priority
+    Queue.Validate();
+    Queue.Remove(0); // First of its priority
+    Queue.Validate();
+    Queue.Remove(3); // Only one of its priority
+    Queue.Validate();
+    ASSERT_EQ(2u, Queue.Send.PriorityBucketCount);
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 4 }), Queue.Order());
+    Queue.Insert(2, 2);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 2, 4 }), Queue.Order());
+}
+
+TEST(StreamSchedulingTest, RoundRobin)
+{
+    SmartSendQueue Queue(5);
+    Queue.Insert(0, 9);
+    Queue.Insert(1, 4);
+    Queue.Insert(2, 4);
+    Queue.Insert(3, 4);
+    Queue.Insert(4, 1);
+    Queue.Rotate(1);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 2, 3, 1, 4 }), Queue.Order());
+    Queue.Rotate(2);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 3, 1, 2, 4 }), Queue.Order());
+    Queue.Rotate(2); // Already last
+    Queue.Rotate(0); // Only one of its priority
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 3, 1, 2, 4 }), Queue.Order());
+}
+
+TEST(StreamSchedulingTest, UpdatePriority)
+{
+    SmartSendQueue Queue(4);
+    Queue.Insert(0, 3);
+    Queue.Insert(1, 3);
+    Queue.Insert(2, 2);
+    Queue.Insert(3, 2);
+    Queue.SetPriority(2, 3);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 1, 2, 3 }), Queue.Order());
+    Queue.SetPriority(0, 1);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 2, 3, 0 }), Queue.Order());
+    Queue.SetPriority(3, 0xFFFF);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 3, 1, 2, 0 }), Queue.Order());
+}
+
+TEST(StreamSchedulingTest, WeightedFair)
+{
+    //
+    // Under the weighted fair scheme, priority is only a weight, so streams
+    // are queued and rotated in a single round.
+    //
+    SmartSendQueue Queue(4);
+    Queue.SetScheme(QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR);
+    Queue.Insert(0, 1);
+    Queue.Insert(1, 9);
+    Queue.Insert(2, 5);
+    Queue.Validate();
+    ASSERT_EQ(1u, Queue.Send.PriorityBucketCount);
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 1, 2 }), Queue.Order());
+    Queue.SetPriority(2, 0xFFFF);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 1, 2 }), Queue.Order());
+    Queue.Rotate(0);
+    Queue.Insert(3, 0);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 2, 0, 3 }), Queue.Order());
+}
+
+TEST(StreamSchedulingTest, ChangeScheme)
+{
+    SmartSendQueue Queue(4);
+    Queue.Insert(0, 1);
+    Queue.Insert(1, 5);
+    Queue.Insert(2, 1);
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 0, 2 }), Queue.Order());
+    Queue.SetScheme(QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 0, 2 }), Queue.Order());
+    Queue.Insert(3, 9);
+    Queue.Rotate(1);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 2, 3, 1 }), Queue.Order());
+    Queue.SetScheme(QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 3, 1, 0, 2 }), Queue.Order());
+    Queue.SetScheme(QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN);
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 3, 1, 0, 2 }), Queue.Order());
+}
+
+TEST(StreamSchedulingTest, ExtensiblePriority)
+{
+    ASSERT_EQ(
+        (uint16_t)QUIC_STREAM_PRIORITY_DEFAULT,
+        QUIC_STREAM_PRIORITY_FROM_URGENCY(3, FALSE));
+    ASSERT_FALSE(QUIC_STREAM_PRIORITY_IS_INCREMENTAL(QUIC_STREAM_PRIORITY_DEFAULT));
+
+    //
+    // More urgent streams come first and, within an urgency, non-incremental
+    // streams come before incremental ones.
+    //
+    SmartSendQueue Queue(5);
+    Queue.SetScheme(QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY);
+    Queue.Insert(0, QUIC_STREAM_PRIORITY_FROM_URGENCY(7, TRUE));
+    Queue.Insert(1, QUIC_STREAM_PRIORITY_FROM_URGENCY(3, TRUE));
+    Queue.Insert(2, QUIC_STREAM_PRIORITY_FROM_URGENCY(3, FALSE));
+    Queue.Insert(3, QUIC_STREAM_PRIORITY_FROM_URGENCY(0, FALSE));
+    Queue.Insert(4, QUIC_STREAM_PRIORITY_FROM_URGENCY(7, FALSE));
+    Queue.Validate();
+    ASSERT_EQ((std::vector<uint32_t>{ 3, 2, 1, 4, 0 }), Queue.Order());
+    for (uint16_t Urgency = 0; Urgency < 8; Urgency++) {
+        ASSERT_TRUE(QUIC_STREAM_PRIORITY_IS_INCREMENTAL(QUIC_STREAM_PRIORITY_FROM_URGENCY(Urgency, TRUE)));
+        ASSERT_FALSE(QUIC_STREAM_PRIORITY_IS_INCREMENTAL(QUIC_STREAM_PRIORITY_FROM_URGENCY(Urgency, FALSE)));
+    }
+}
+
+TEST(StreamSchedulingTest, Random)
+{
+    const uint32_t Count = 1000;
+    SmartSendQueue Queue(Count);
+    std::mt19937 Rng(11);
+    for (uint32_t i = 0; i < 20000; i++) {
+        uint32_t Index = Rng() % Count;
+        uint16_t Priority = (uint16_t)(Rng() % 64);
+        switch (Rng() % 4) {
+        case 0:
+            if (Queue.Queued(Index)) {
+                Queue.Remove(Index);
+            } else {
+                Queue.Insert(Index, Priority);
+            }
+            break;
+        case 1:
+            if (Queue.Queued(Index)) {
+                Queue.Rotate(Index);
+            }
+            break;
+        case 2:
+            if (Queue.Queued(Index)) {
+                Queue.SetPriority(Index, Priority);
+            }
+            break;
+        default:
+            if (!Queue.Queued(Index)) {
+                Queue.Insert(Index, Priority);
+            }
+            break;
+        }
+        if (i % 100 == 0) {
+            Queue.Validate();
+        }
+    }
+    Queue.Validate();
+    ASSERT_GT(Queue.Send.PriorityBucketAllocLength, (uint32_t)QUIC_SEND_PRIORITY_BUCKET_INITIAL_COUNT);
+}
+
+//
+// Microbenchmark of the per-stream scheduling cost as a function of the number
+// of streams with data queued. Each iteration does what the send path does in
+// the round robin scheme: rotate the stream at the head of the queue behind
+// the others of its priority, and occasionally finish a stream and queue a
+// new one. The cost should stay flat as the number of streams grows.
+//
+TEST(StreamSchedulingTest, ScheduleCostVsStreams)
+{
+    const uint32_t StreamCounts[] = { 1000, 10000, 100000 };
+    const uint32_t PriorityCount = 8;
+    const uint32_t OperationCount = 1000000;
+
+    for (auto Count : StreamCounts) {
+        SmartSendQueue Queue(Count + 1);
+        for (uint32_t i = 0; i < Count; i++) {
+            Queue.Insert(i, (uint16_t)(i % PriorityCount));
+        }
+
+        uint32_t Spare = Count;
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < OperationCount; i++) {
+            uint32_t Head = Queue.IndexOf(Queue.Send.SendStreams.Flink);
+            if (i % 16 == 0) {
+                Queue.Remove(Head);
+                Queue.Insert(Spare, (uint16_t)(i % PriorityCount));
+                Spare = Head;
+            } else {
+                Queue.Rotate(Head);
+            }
+        }
+        uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        Queue.Validate();
+        printf("Streams=%u: %u operations in %llu us (%llu ns/operation)\n",
+            Count,
+            OperationCount,
+            (unsigned long long)Elapsed,
+            (unsigned long long)(Elapsed * 1000 / OperationCount));
+    }
+}
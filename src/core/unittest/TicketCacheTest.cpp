@@ -0,0 +1,200 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the client resumption ticket cache.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "TicketCacheTest.cpp.clog.h"
+#endif
+
+struct TicketCache {
+    QUIC_TICKET_CACHE Cache;
+    TicketCache(uint64_t MaxSize = QUIC_TICKET_CACHE_MAX_BYTES) {
+        EXPECT_TRUE(QuicTicketCacheInitialize(&Cache, MaxSize));
+    }
+    ~TicketCache() {
+        QuicTicketCacheUninitialize(&Cache);
+    }
+    uint32_t Save(const QUIC_TICKET_CACHE_KEY& Key, uint8_t Id, uint64_t TimeNow = 0, uint32_t Lifetime = 0, BOOLEAN EarlyDataAllowed = FALSE, uint32_t Length = 64) {
+        uint8_t Ticket[1024];
+        CXPLAT_FRE_ASSERT(Length <= sizeof(Ticket));
+        memset(Ticket, Id, Length);
+        return QuicTicketCacheSave(&Cache, &Key, TimeNow, Lifetime, EarlyDataAllowed, Length, Ticket);
+    }
+    //
+    // Returns the ID of the ticket taken, or 0 if there wasn't one.
+    //
+    uint8_t Take(const QUIC_TICKET_CACHE_KEY& Key, uint64_t TimeNow = 0, uint32_t* ExpiredCount = nullptr) {
+        uint32_t Expired;
+        QUIC_TICKET_CACHE_TICKET* Ticket = QuicTicketCacheTake(&Cache, &Key, TimeNow, &Expired);
+        if (ExpiredCount != nullptr) {
+            *ExpiredCount = Expired;
+        }
+        if (Ticket == nullptr) {
+            return 0;
+        }
+        uint8_t Id = Ticket->Buffer[0];
+        QuicTicketCacheFreeTicket(Ticket);
+        return Id;
+    }
+};
+
+static const uint8_t Alpn[] = { 2, 'h', '3' };
+static const uint8_t OtherAlpn[] = { 4, 'h', '3', '-', 'x' };
+
+static QUIC_TICKET_CACHE_KEY MakeKey(const char* ServerName, uint16_t Port = 443, const uint8_t* AlpnList = Alpn, uint16_t AlpnListLength = sizeof(Alpn)) {
+    QUIC_TICKET_CACHE_KEY Key;
+    Key.ServerName = ServerName;
+    Key.ServerNameLength = (uint16_t)strlen(ServerName);
+    Key.AlpnList = AlpnList;
+    Key.AlpnListLength = AlpnListLength;
+    Key.ServerPort = Port;
+    return Key;
+}
+
+TEST(TicketCacheTest, SaveAndTake)
+{
+    TicketCache Cache;
+    QUIC_TICKET_CACHE_KEY Key = MakeKey("example.com");
+
+    ASSERT_EQ(0, Cache.Take(Key));
+    ASSERT_EQ(0u, Cache.Save(Key, 1));
+
+    //
+    // The server name, port and ALPNs all have to match.
+    //
+    ASSERT_EQ(0, Cache.Take(MakeKey("example.org")));
+    ASSERT_EQ(0, Cache.Take(MakeKey("example.com", 8443)));
+    ASSERT_EQ(0, Cache.Take(MakeKey("example.com", 443, OtherAlpn, sizeof(OtherAlpn))));
+
+    //
+    // Tickets are only used once.
+    //
+    ASSERT_EQ(1, Cache.Take(Key));
+    ASSERT_EQ(0, Cache.Take(Key));
+    ASSERT_EQ(0u, Cache.Cache.EntryCount);
+    ASSERT_EQ(0u, Cache.Cache.Size);
+}
+
+TEST(TicketCacheTest, PrefersNewestEarlyData)
+{
+    TicketCache Cache;
+    QUIC_TICKET_CACHE_KEY Key = MakeKey("example.com");
+
+    Cache.Save(Key, 1, 0, 0, TRUE);
+    Cache.Save(Key, 2, 0, 0, TRUE);
+    Cache.Save(Key, 3, 0, 0, FALSE);
+    ASSERT_EQ(1u, Cache.Cache.EntryCount);
+
+    ASSERT_EQ(2, Cache.Take(Key));
+    ASSERT_EQ(1, Cache.Take(Key));
+    ASSERT_EQ(3, Cache.Take(Key));
+    ASSERT_EQ(0, Cache.Take(Key));
+}
+
+TEST(TicketCacheTest, Expiry)
+{
+    TicketCache Cache;
+    QUIC_TICKET_CACHE_KEY Key = MakeKey("example.com");
+    uint32_t ExpiredCount;
+
+    //
+    // The server's lifetime is used, capped to the TLS maximum.
+    //
+    Cache.Save(Key, 1, 1000, 10);
+    ASSERT_EQ(0, Cache.Take(Key, 1000 + S_TO_US(10), &ExpiredCount));
+    ASSERT_EQ(1u, ExpiredCount);
+    ASSERT_EQ(0u, Cache.Cache.EntryCount);
+
+    Cache.Save(Key, 2, 1000, 10);
+    ASSERT_EQ(2, Cache.Take(Key, 1000 + S_TO_US(10) - 1, &ExpiredCount));
+    ASSERT_EQ(0u, ExpiredCount);
+
+    Cache.Save(Key, 3, 1000, UINT32_MAX);
+    Cache.Save(Key, 4, 1000, 0);
+    ASSERT_EQ(0, Cache.Take(Key, 1000 + QUIC_TICKET_CACHE_MAX_LIFETIME_US, &ExpiredCount));
+    ASSERT_EQ(2u, ExpiredCount);
+
+    //
+    // Only the expired tickets are dropped.
+    //
+    Cache.Save(Key, 5, 0, 10);
+    Cache.Save(Key, 6, S_TO_US(5), 10);
+    ASSERT_EQ(6, Cache.Take(Key, S_TO_US(12), &ExpiredCount));
+    ASSERT_EQ(1u, ExpiredCount);
+}
+
+TEST(TicketCacheTest, PerServerLimit)
+{
+    TicketCache Cache;
+    QUIC_TICKET_CACHE_KEY Key = MakeKey("example.com");
+
+    for (uint8_t i = 1; i <= QUIC_TICKET_CACHE_MAX_TICKETS_PER_SERVER; ++i) {
+        ASSERT_EQ(0u, Cache.Save(Key, i));
+    }
+    ASSERT_EQ(1u, Cache.Save(Key, QUIC_TICKET_CACHE_MAX_TICKETS_PER_SERVER + 1));
+
+    //
+    // The oldest ticket was dropped.
+    //
+    for (uint8_t i = QUIC_TICKET_CACHE_MAX_TICKETS_PER_SERVER + 1; i > 1; --i) {
+        ASSERT_EQ(i, Cache.Take(Key));
+    }
+    ASSERT_EQ(0, Cache.Take(Key));
+}
+
+TEST(TicketCacheTest, SizeLimitEvictsLeastRecentlyUsed)
+{
+    const uint32_t TicketLength = 500;
+    const uint64_t EntrySize =
+        sizeof(QUIC_TICKET_CACHE_ENTRY) + strlen("a.example") + sizeof(Alpn) +
+        sizeof(QUIC_TICKET_CACHE_TICKET) + TicketLength;
+    QUIC_TICKET_CACHE_KEY A = MakeKey("a.example");
+    QUIC_TICKET_CACHE_KEY B = MakeKey("b.example");
+    QUIC_TICKET_CACHE_KEY C = MakeKey("c.example");
+
+    {
+        //
+        // Room for three servers with one ticket each.
+        //
+        TicketCache Cache(3 * EntrySize);
+        ASSERT_EQ(0u, Cache.Save(A, 1, 0, 0, FALSE, TicketLength));
+        ASSERT_EQ(0u, Cache.Save(B, 2, 0, 0, FALSE, TicketLength));
+        ASSERT_EQ(0u, Cache.Save(C, 3, 0, 0, FALSE, TicketLength));
+        ASSERT_EQ(3 * EntrySize, Cache.Cache.Size);
+
+        //
+        // A gets a second ticket, which pushes out B, the least recently used.
+        //
+        ASSERT_EQ(1u, Cache.Save(A, 4, 0, 0, FALSE, TicketLength));
+        ASSERT_EQ(0, Cache.Take(B));
+        ASSERT_EQ(3, Cache.Take(C));
+        ASSERT_EQ(4, Cache.Take(A));
+        ASSERT_EQ(1, Cache.Take(A));
+        ASSERT_EQ(0u, Cache.Cache.Size);
+    }
+
+    {
+        //
+        // A server alone in the cache gives up its own older tickets.
+        //
+        TicketCache Cache(EntrySize + TicketLength);
+        ASSERT_EQ(0u, Cache.Save(A, 1, 0, 0, FALSE, TicketLength));
+        ASSERT_EQ(1u, Cache.Save(A, 2, 0, 0, FALSE, TicketLength));
+        ASSERT_EQ(2, Cache.Take(A));
+        ASSERT_EQ(0, Cache.Take(A));
+
+        //
+        // Tickets that could never fit aren't saved.
+        //
+        ASSERT_EQ(0u, Cache.Save(A, 3, 0, 0, FALSE, TicketLength * 2 + 1));
+        ASSERT_EQ(0u, Cache.Cache.EntryCount);
+    }
+}
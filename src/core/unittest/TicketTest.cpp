@@ -321,6 +321,29 @@ TEST(ResumptionTicketTest, ClientDecFail)
             DecodedServerTicket.reset_and_addressof(),
             &DecodedServerTicketLength,
             &DecodedQuicVersion));
+    InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_MIN_VERSION - 1;
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicCryptoDecodeClientTicket(
+            nullptr,
+            7 + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(ServerTicket),
+            InputTicketBuffer,
+            &DecodedTP,
+            DecodedServerTicket.reset_and_addressof(),
+            &DecodedServerTicketLength,
+            &DecodedQuicVersion));
+
+    // Older ticket versions are still accepted
+    InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION_V1;
+    TEST_QUIC_SUCCEEDED(
+        QuicCryptoDecodeClientTicket(
+            nullptr,
+            7 + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(ServerTicket),
+            InputTicketBuffer,
+            &DecodedTP,
+            DecodedServerTicket.reset_and_addressof(),
+            &DecodedServerTicketLength,
+            &DecodedQuicVersion));
     InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION;
 
     // Unsupported QUIC version
@@ -2178,3 +2201,133 @@ TEST(ResumptionTicketTest, QuicCryptoDecodeCRStateFailureCases)
     corruptBuf2[0] = (uint8_t)(QUIC_CR_STATE_MIN_ADDR_LENGTH); // Use the IPv4 length for IPv6
     ASSERT_FALSE(QuicCryptoDecodeCRState(&crState, corruptBuf2, (uint16_t)crLength2, nullptr));
 }
+
+//
+// Returns the PEM form of a DER encoded TLS session, the way OpenSSL wrote
+// client sessions before they were passed up DER encoded.
+//
+static
+std::vector<uint8_t>
+SessionToPem(
+    const std::vector<uint8_t>& Der
+    )
+{
+    static const char Base64[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static const char Header[] = "-----BEGIN SSL SESSION PARAMETERS-----\n";
+    static const char Footer[] = "-----END SSL SESSION PARAMETERS-----\n";
+
+    std::vector<uint8_t> Pem(Header, Header + sizeof(Header) - 1);
+    uint32_t LineLength = 0;
+    for (size_t i = 0; i < Der.size(); i += 3) {
+        uint32_t Bits = (uint32_t)Der[i] << 16;
+        if (i + 1 < Der.size()) Bits |= (uint32_t)Der[i + 1] << 8;
+        if (i + 2 < Der.size()) Bits |= Der[i + 2];
+        Pem.push_back(Base64[(Bits >> 18) & 0x3F]);
+        Pem.push_back(Base64[(Bits >> 12) & 0x3F]);
+        Pem.push_back(i + 1 < Der.size() ? Base64[(Bits >> 6) & 0x3F] : '=');
+        Pem.push_back(i + 2 < Der.size() ? Base64[Bits & 0x3F] : '=');
+        if ((LineLength += 4) == 64) {
+            Pem.push_back('\n');
+            LineLength = 0;
+        }
+    }
+    if (LineLength != 0) {
+        Pem.push_back('\n');
+    }
+    Pem.insert(Pem.end(), Footer, Footer + sizeof(Footer) - 1);
+    return Pem;
+}
+
+//
+// Encodes and decodes client tickets carrying a TLS session the size of a
+// typical OpenSSL TLS 1.3 client session (with the server's leaf certificate),
+// in its current DER form and the former PEM form.
+//
+TEST(ResumptionTicketTest, ClientTicketSessionEncodingCost)
+{
+    const uint32_t SessionLength = 1800;
+    const uint32_t Iterations = 100000;
+
+    std::vector<uint8_t> Der(SessionLength);
+    Der[0] = 0x30; // SEQUENCE
+    for (uint32_t i = 1; i < SessionLength; ++i) {
+        Der[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+    std::vector<uint8_t> Pem = SessionToPem(Der);
+    const std::vector<uint8_t>* Sessions[] = { &Pem, &Der };
+    const char* Names[] = { "PEM", "DER" };
+
+    QUIC_TRANSPORT_PARAMETERS ServerTP;
+    CxPlatZeroMemory(&ServerTP, sizeof(ServerTP));
+    ServerTP.Flags =
+        QUIC_TP_FLAG_ACTIVE_CONNECTION_ID_LIMIT |
+        QUIC_TP_FLAG_INITIAL_MAX_DATA |
+        QUIC_TP_FLAG_INITIAL_MAX_STRM_DATA_BIDI_LOCAL |
+        QUIC_TP_FLAG_INITIAL_MAX_STRM_DATA_BIDI_REMOTE |
+        QUIC_TP_FLAG_INITIAL_MAX_STRM_DATA_UNI |
+        QUIC_TP_FLAG_INITIAL_MAX_STRMS_BIDI |
+        QUIC_TP_FLAG_INITIAL_MAX_STRMS_UNI;
+    ServerTP.InitialMaxData = 16 * 1024 * 1024;
+    ServerTP.InitialMaxStreamDataBidiLocal = 1024 * 1024;
+    ServerTP.InitialMaxStreamDataBidiRemote = 1024 * 1024;
+    ServerTP.InitialMaxStreamDataUni = 1024 * 1024;
+    ServerTP.InitialMaxBidiStreams = 100;
+    ServerTP.InitialMaxUniStreams = 100;
+    ServerTP.ActiveConnectionIdLimit = QUIC_TP_ACTIVE_CONNECTION_ID_LIMIT_MIN;
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        const std::vector<uint8_t>& Session = *Sessions[i];
+        const uint8_t* ClientTicket = nullptr;
+        uint32_t ClientTicketLength = 0;
+        QUIC_TRANSPORT_PARAMETERS DecodedTP;
+        TicketScope DecodedSession;
+        uint32_t DecodedSessionLength = 0;
+        uint32_t DecodedQuicVersion = 0;
+
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t j = 0; j < Iterations; ++j) {
+            if (ClientTicket != nullptr) {
+                CXPLAT_FREE(ClientTicket, QUIC_POOL_CLIENT_CRYPTO_TICKET);
+            }
+            TEST_QUIC_SUCCEEDED(
+                QuicCryptoEncodeClientTicket(
+                    nullptr,
+                    (uint32_t)Session.size(),
+                    Session.data(),
+                    &ServerTP,
+                    QUIC_VERSION_1,
+                    &ClientTicket,
+                    &ClientTicketLength));
+        }
+        uint64_t EncodeUs = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        Start = CxPlatTimeUs64();
+        for (uint32_t j = 0; j < Iterations; ++j) {
+            CxPlatZeroMemory(&DecodedTP, sizeof(DecodedTP));
+            TEST_QUIC_SUCCEEDED(
+                QuicCryptoDecodeClientTicket(
+                    nullptr,
+                    (uint16_t)ClientTicketLength,
+                    ClientTicket,
+                    &DecodedTP,
+                    DecodedSession.reset_and_addressof(),
+                    &DecodedSessionLength,
+                    &DecodedQuicVersion));
+        }
+        uint64_t DecodeUs = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        ASSERT_EQ(CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION, ClientTicket[0]);
+        ASSERT_EQ(Session.size(), DecodedSessionLength);
+        ASSERT_EQ(0, memcmp(Session.data(), DecodedSession.p, DecodedSessionLength));
+        CompareTransportParameters(&ServerTP, &DecodedTP);
+        CXPLAT_FREE(ClientTicket, QUIC_POOL_CLIENT_CRYPTO_TICKET);
+
+        printf("%s session: %u byte session, %u byte ticket, encode %llu ns, decode %llu ns\n",
+            Names[i],
+            (uint32_t)Session.size(),
+            ClientTicketLength,
+            (unsigned long long)(EncodeUs * 1000 / Iterations),
+            (unsigned long long)(DecodeUs * 1000 / Iterations));
+    }
+}
@@ -0,0 +1,286 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_TIMER_WHEEL hierarchical timer wheel.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "TimerWheelTest.cpp.clog.h"
+#endif
+
+#include <memory>
+#include <random>
+
+//
+// Wraps a timer wheel and a set of bare connections, which are only used for
+// their timer wheel link, expiration time and ref count.
+//
+struct SmartTimerWheel {
+    QUIC_TIMER_WHEEL Wheel;
+    std::unique_ptr<QUIC_CONNECTION[]> Connections;
+    uint32_t ConnectionCount;
+    uint64_t Now;
+    SmartTimerWheel(uint32_t Count) :
+        Connections(new QUIC_CONNECTION[Count]()), ConnectionCount(Count) {
+        EXPECT_TRUE(QUIC_SUCCEEDED(QuicTimerWheelInitialize(&Wheel)));
+        //
+        // Start at the beginning of a level 0 rotation, so that the next
+        // expiration time of timers less than 64 ms out is always exact.
+        //
+        Now = MS_TO_US((Wheel.CurrentTick + QUIC_TIMER_WHEEL_LEVEL_SLOTS) & ~(uint64_t)(QUIC_TIMER_WHEEL_LEVEL_SLOTS - 1));
+        CXPLAT_LIST_ENTRY ExpiredTimers;
+        CxPlatListInitializeHead(&ExpiredTimers);
+        QuicTimerWheelGetExpired(&Wheel, Now, &ExpiredTimers);
+        for (uint32_t i = 0; i < Count; i++) {
+            QUIC_CONNECTION* Connection = &Connections[i];
+            Connection->RefCount = 1;
+#if DEBUG
+            for (uint32_t j = 0; j < QUIC_CONN_REF_COUNT; j++) {
+                Connection->RefTypeBiasedCount[j] = 1;
+            }
+#endif
+            Connection->EarliestExpirationTime = UINT64_MAX;
+        }
+    }
+    ~SmartTimerWheel() {
+        for (uint32_t i = 0; i < ConnectionCount; i++) {
+            QuicTimerWheelRemoveConnection(&Wheel, &Connections[i]);
+        }
+        QuicTimerWheelUninitialize(&Wheel);
+    }
+    void Set(uint32_t Index, uint64_t ExpirationTime) {
+        Connections[Index].EarliestExpirationTime = ExpirationTime;
+        QuicTimerWheelUpdateConnection(&Wheel, &Connections[Index]);
+    }
+    //
+    // The worker's ref is released by hand, since these connections are
+    // never freed.
+    //
+    static void ReleaseWorkerRef(QUIC_CONNECTION* Connection) {
+#if DEBUG
+        CxPlatRefDecrement(&Connection->RefTypeBiasedCount[QUIC_CONN_REF_WORKER]);
+#endif
+        ASSERT_GT(Connection->RefCount, 1);
+        Connection->RefCount--;
+    }
+    bool InWheel(uint32_t Index) const {
+        return Connections[Index].TimerLink.Flink != NULL;
+    }
+    //
+    // Expires timers up to the given time, the same way the worker does, and
+    // returns the number of connections that expired.
+    //
+    uint32_t Expire(uint64_t TimeNow) {
+        Now = TimeNow;
+        CXPLAT_LIST_ENTRY ExpiredTimers;
+        CxPlatListInitializeHead(&ExpiredTimers);
+        QuicTimerWheelGetExpired(&Wheel, TimeNow, &ExpiredTimers);
+        uint32_t Expired = 0;
+        while (!CxPlatListIsEmpty(&ExpiredTimers)) {
+            CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&ExpiredTimers);
+            Entry->Flink = NULL;
+            QUIC_CONNECTION* Connection =
+                CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+            EXPECT_LE(Connection->EarliestExpirationTime, TimeNow);
+            Connection->EarliestExpirationTime = UINT64_MAX;
+            ReleaseWorkerRef(Connection);
+            Expired++;
+        }
+        Validate();
+        return Expired;
+    }
+    //
+    // Verifies nothing expired was left behind and the next expiration time
+    // is never later than the earliest timer in the wheel.
+    //
+    void Validate() const {
+        uint64_t Earliest = UINT64_MAX;
+        uint64_t Count = 0;
+        for (uint32_t i = 0; i < ConnectionCount; i++) {
+            if (InWheel(i)) {
+                Count++;
+                ASSERT_GT(Connections[i].EarliestExpirationTime, Now);
+                Earliest = CXPLAT_MIN(Earliest, Connections[i].EarliestExpirationTime);
+            }
+        }
+        ASSERT_EQ(Count, Wheel.ConnectionCount);
+        ASSERT_LE(Wheel.NextExpirationTime, Earliest);
+        if (Count == 0) {
+            ASSERT_EQ(UINT64_MAX, Wheel.NextExpirationTime);
+        }
+    }
+};
+
+TEST(TimerWheelTest, Empty)
+{
+    SmartTimerWheel Wheel(1);
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextExpirationTime);
+    ASSERT_EQ(0u, Wheel.Expire(Wheel.Now + MS_TO_US(1000)));
+}
+
+TEST(TimerWheelTest, InsertUpdateRemove)
+{
+    SmartTimerWheel Wheel(3);
+    uint64_t Start = Wheel.Now;
+    Wheel.Set(0, Start + 5000);
+    Wheel.Set(1, Start + 2000);
+    Wheel.Set(2, Start + 9000);
+    ASSERT_EQ(3ull, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(Start + 2000, Wheel.Wheel.NextExpirationTime);
+
+    Wheel.Set(1, Start + 7000); // Move the next one later
+    ASSERT_EQ(Start + 5000, Wheel.Wheel.NextExpirationTime);
+
+    QuicTimerWheelRemoveConnection(&Wheel.Wheel, &Wheel.Connections[0]);
+    ASSERT_FALSE(Wheel.InWheel(0));
+    ASSERT_EQ(Start + 7000, Wheel.Wheel.NextExpirationTime);
+
+    Wheel.Set(2, UINT64_MAX); // Cancel
+    ASSERT_FALSE(Wheel.InWheel(2));
+    ASSERT_EQ(1ull, Wheel.Wheel.ConnectionCount);
+
+    ASSERT_EQ(0u, Wheel.Expire(Start + 6999));
+    ASSERT_EQ(1u, Wheel.Expire(Start + 7000));
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextExpirationTime);
+}
+
+TEST(TimerWheelTest, ExpireInOrder)
+{
+    const uint32_t Count = 2000;
+    SmartTimerWheel Wheel(Count);
+    uint64_t Start = Wheel.Now;
+    std::mt19937_64 Rng(42);
+    for (uint32_t i = 0; i < Count; i++) {
+        //
+        // Spread timers out over all the levels of the wheel.
+        //
+        uint64_t Delay = Rng() % (1ull << (6 + (i % 4) * 6));
+        Wheel.Set(i, Start + MS_TO_US(Delay) + Rng() % 1000);
+    }
+    Wheel.Validate();
+
+    uint32_t Expired = 0;
+    uint64_t TimeNow = Start;
+    while (Wheel.Wheel.ConnectionCount != 0) {
+        //
+        // Jump to the next expiration time, like an idle worker would.
+        //
+        ASSERT_NE(UINT64_MAX, Wheel.Wheel.NextExpirationTime);
+        ASSERT_GT(Wheel.Wheel.NextExpirationTime, TimeNow);
+        TimeNow = Wheel.Wheel.NextExpirationTime;
+        Expired += Wheel.Expire(TimeNow);
+    }
+    ASSERT_EQ(Count, Expired);
+}
+
+TEST(TimerWheelTest, ExpireInSteps)
+{
+    const uint32_t Count = 500;
+    SmartTimerWheel Wheel(Count);
+    uint64_t Start = Wheel.Now;
+    std::mt19937_64 Rng(7);
+    for (uint32_t i = 0; i < Count; i++) {
+        Wheel.Set(i, Start + Rng() % MS_TO_US(20000));
+    }
+
+    //
+    // Advance by uneven steps, rescheduling some timers along the way.
+    //
+    uint32_t Expired = 0;
+    for (uint64_t TimeNow = Start; TimeNow < Start + MS_TO_US(21000); TimeNow += 777 + Rng() % 50000) {
+        Expired += Wheel.Expire(TimeNow);
+        uint32_t Index = (uint32_t)(Rng() % Count);
+        if (Wheel.InWheel(Index)) {
+            Wheel.Set(Index, TimeNow + Rng() % MS_TO_US(1000));
+        }
+    }
+    Expired += Wheel.Expire(Start + MS_TO_US(22000));
+    ASSERT_EQ(Count, Expired);
+}
+
+TEST(TimerWheelTest, AlreadyExpired)
+{
+    SmartTimerWheel Wheel(2);
+    uint64_t Start = Wheel.Now;
+    ASSERT_EQ(0u, Wheel.Expire(Start + MS_TO_US(100)));
+    Wheel.Set(0, Start + 10); // In the past, relative to the wheel
+    ASSERT_EQ(Start + 10, Wheel.Wheel.NextExpirationTime);
+    Wheel.Set(1, Start + MS_TO_US(100) + 1);
+    ASSERT_EQ(1u, Wheel.Expire(Start + MS_TO_US(100)));
+    ASSERT_EQ(1u, Wheel.Expire(Start + MS_TO_US(100) + 1));
+}
+
+TEST(TimerWheelTest, Overflow)
+{
+    SmartTimerWheel Wheel(3);
+    uint64_t Start = Wheel.Now;
+    const uint64_t Hour = MS_TO_US(60 * 60 * 1000ull);
+    Wheel.Set(0, Start + 10 * Hour);
+    Wheel.Set(1, Start + 30 * Hour);
+    Wheel.Set(2, Start + Hour);
+    ASSERT_EQ(0u, Wheel.Expire(Start + Hour - 1));
+    ASSERT_EQ(1u, Wheel.Expire(Start + Hour));
+    ASSERT_EQ(Start + 10 * Hour, Wheel.Wheel.NextExpirationTime);
+    ASSERT_EQ(0u, Wheel.Expire(Start + 10 * Hour - 1));
+    ASSERT_EQ(1u, Wheel.Expire(Start + 10 * Hour));
+    ASSERT_EQ(1u, Wheel.Expire(Start + 100 * Hour));
+}
+
+//
+// Microbenchmark of the cost of updating a connection's timer as a function
+// of the number of connections in the wheel. Most connections sit on a long
+// idle timer while a few active ones keep rescheduling short (ACK delay,
+// pacing, loss detection) timers, and the worker expires timers as time
+// advances. The per-update cost should stay flat as connections grow.
+//
+TEST(TimerWheelTest, UpdateCostVsConnections)
+{
+    const uint32_t ConnectionCounts[] = { 10000, 100000 };
+    const uint32_t UpdateCount = 1000000;
+
+    for (auto Count : ConnectionCounts) {
+        SmartTimerWheel Wheel(Count);
+        uint64_t TimeNow = Wheel.Now;
+        std::mt19937_64 Rng(Count);
+        for (uint32_t i = 0; i < Count; i++) {
+            Wheel.Set(i, TimeNow + MS_TO_US(30000) + Rng() % MS_TO_US(30000));
+        }
+
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < UpdateCount; i++) {
+            uint32_t Index = (uint32_t)(Rng() % Count);
+            Wheel.Connections[Index].EarliestExpirationTime =
+                TimeNow + 100 + Rng() % MS_TO_US(200);
+            QuicTimerWheelUpdateConnection(&Wheel.Wheel, &Wheel.Connections[Index]);
+            if (i % 64 == 0) {
+                TimeNow += 100;
+                CXPLAT_LIST_ENTRY ExpiredTimers;
+                CxPlatListInitializeHead(&ExpiredTimers);
+                QuicTimerWheelGetExpired(&Wheel.Wheel, TimeNow, &ExpiredTimers);
+                while (!CxPlatListIsEmpty(&ExpiredTimers)) {
+                    CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&ExpiredTimers);
+                    Entry->Flink = NULL;
+                    QUIC_CONNECTION* Connection =
+                        CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+                    Connection->EarliestExpirationTime = TimeNow + MS_TO_US(30000);
+                    QuicTimerWheelUpdateConnection(&Wheel.Wheel, Connection);
+                    SmartTimerWheel::ReleaseWorkerRef(Connection);
+                }
+            }
+        }
+        uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+        ASSERT_EQ((uint64_t)Count, Wheel.Wheel.ConnectionCount);
+        printf("Connections=%u: %u updates in %llu us (%llu ns/update)\n",
+            Count,
+            UpdateCount,
+            (unsigned long long)Elapsed,
+            (unsigned long long)(Elapsed * 1000 / UpdateCount));
+    }
+}
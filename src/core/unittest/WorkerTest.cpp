@@ -0,0 +1,81 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for choosing where to move connections between workers.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "WorkerTest.cpp.clog.h"
+#endif
+
+struct WorkerRebalanceTest : public ::testing::Test {
+    static const uint16_t WorkerCount = 4;
+    alignas(QUIC_WORKER_POOL) uint8_t Buffer[sizeof(QUIC_WORKER_POOL) + WorkerCount * sizeof(QUIC_WORKER)];
+    QUIC_WORKER_POOL* Pool {(QUIC_WORKER_POOL*)Buffer};
+
+    void SetUp() override {
+        CxPlatZeroMemory(Buffer, sizeof(Buffer));
+        Pool->WorkerCount = WorkerCount;
+    }
+
+    void SetDelays(uint32_t D0, uint32_t D1, uint32_t D2, uint32_t D3) {
+        Pool->Workers[0].AverageQueueDelay = D0;
+        Pool->Workers[1].AverageQueueDelay = D1;
+        Pool->Workers[2].AverageQueueDelay = D2;
+        Pool->Workers[3].AverageQueueDelay = D3;
+    }
+
+    BOOLEAN GetTarget(uint16_t From, uint64_t TimeNow, uint16_t* Target) {
+        return QuicWorkerPoolGetRebalanceTarget(Pool, &Pool->Workers[From], TimeNow, Target);
+    }
+};
+
+TEST_F(WorkerRebalanceTest, PicksLeastLoaded)
+{
+    uint16_t Target = UINT16_MAX;
+    SetDelays(20000, 3000, 500, 4000);
+    ASSERT_TRUE(GetTarget(0, 1000000, &Target));
+    ASSERT_EQ(2, Target);
+}
+
+TEST_F(WorkerRebalanceTest, NotWhenBalanced)
+{
+    uint16_t Target;
+
+    //
+    // Too little queue delay to bother.
+    //
+    SetDelays(QUIC_WORKER_REBALANCE_MIN_DELAY_US - 1, 0, 0, 0);
+    ASSERT_FALSE(GetTarget(0, 1000000, &Target));
+
+    //
+    // Other workers aren't enough less loaded.
+    //
+    SetDelays(8000, 2000, 3000, 2500);
+    ASSERT_FALSE(GetTarget(0, 1000000, &Target));
+    Pool->Workers[1].AverageQueueDelay = 1999;
+    ASSERT_TRUE(GetTarget(0, 1000000, &Target));
+    ASSERT_EQ(1, Target);
+
+    //
+    // A single worker has nowhere to move connections to.
+    //
+    Pool->WorkerCount = 1;
+    ASSERT_FALSE(GetTarget(0, 1000000, &Target));
+}
+
+TEST_F(WorkerRebalanceTest, RateLimited)
+{
+    uint16_t Target;
+    SetDelays(0, 0, 20000, 0);
+    Pool->Workers[2].LastRebalanceTime = 1000000;
+    ASSERT_FALSE(GetTarget(2, 1000000 + QUIC_WORKER_REBALANCE_INTERVAL_US - 1, &Target));
+    ASSERT_TRUE(GetTarget(2, 1000000 + QUIC_WORKER_REBALANCE_INTERVAL_US, &Target));
+    ASSERT_NE(2, Target);
+}
@@ -97,7 +97,17 @@ QuicWorkerInitialize(
     Worker->ExecutionContext.Ready = TRUE;
 
 #ifndef _KERNEL_MODE // Not supported on kernel mode
-    if (ExecProfile != QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT) {
+#ifdef CXPLAT_USE_SIM_DATAPATH
+    //
+    // The simulated datapath's virtual clock only advances when all platform
+    // workers are idle, so every worker must run on one.
+    //
+    const BOOLEAN UsePlatformWorker = TRUE;
+#else
+    const BOOLEAN UsePlatformWorker =
+        ExecProfile != QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT;
+#endif
+    if (UsePlatformWorker) {
         Worker->IsExternal = TRUE;
         CxPlatWorkerPoolAddExecutionContext(
             MsQuicLib.WorkerPool,
@@ -587,6 +597,59 @@ QuicWorkerProcessTimers(
     }
 }
 
+//
+// Moves a connection that keeps an overloaded worker busy to a much less loaded
+// worker, the same way a connection follows its packets to a new partition:
+// the connection's partition changes, new CIDs are issued for it, and it is
+// handed over once this drain completes.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerRebalanceConnection(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_REGISTRATION* Registration = Connection->Registration;
+    if (Registration == NULL || Registration->NoPartitioning ||
+        Connection->State.Partitioned || !Connection->State.Connected ||
+        Connection->State.ShutdownComplete ||
+        Connection->Paths[0].Binding == NULL ||
+        Connection->Paths[0].Binding->Partitioned) {
+        return; // Not allowed to move.
+    }
+
+    uint16_t TargetIndex;
+    if (!QuicWorkerPoolGetRebalanceTarget(
+            Registration->WorkerPool, Worker, TimeNow, &TargetIndex)) {
+        return;
+    }
+
+    QuicTraceLogConnInfo(
+        ConnRebalanced,
+        Connection,
+        "Moving to less loaded worker (partition %hu, queue delay %u us vs %u us)",
+        TargetIndex,
+        Registration->WorkerPool->Workers[TargetIndex].AverageQueueDelay,
+        Worker->AverageQueueDelay);
+
+    Worker->LastRebalanceTime = TimeNow;
+    Connection->PartitionID = QuicPartitionIdCreate(TargetIndex);
+    QuicConnGenerateNewSourceCids(Connection, TRUE);
+
+    //
+    // Packets keep arriving on the old (RSS) partition for now. Don't let that
+    // pull the connection right back.
+    //
+    for (uint8_t i = 0; i < Connection->PathsCount; ++i) {
+        Connection->Paths[i].PartitionUpdated = TRUE;
+    }
+
+    Connection->State.UpdateWorker = TRUE;
+    QuicPerfCounterIncrement(Worker->Partition, QUIC_PERF_COUNTER_CONN_REBALANCED);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicWorkerProcessConnection(
@@ -658,6 +721,14 @@ QuicWorkerProcessConnection(
     BOOLEAN StillHasPriorityWork = FALSE;
     BOOLEAN StillHasWorkToDo =
         QuicConnDrainOperations(Connection, &StillHasPriorityWork) | Connection->State.UpdateWorker;
+    if (StillHasWorkToDo && !Connection->State.UpdateWorker &&
+        MsQuicLib.Settings.WorkerRebalancingEnabled) {
+        //
+        // The connection used up its whole drain budget, so it is one of the
+        // connections keeping this worker busy.
+        //
+        QuicWorkerRebalanceConnection(Worker, Connection, *TimeNow);
+    }
     Connection->WorkerThreadID = 0;
 
     //
@@ -1099,6 +1170,48 @@ QuicWorkerPoolGetLeastLoadedWorker(
     return MinQueueDelayWorker;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicWorkerPoolGetRebalanceTarget(
+    _In_ const QUIC_WORKER_POOL* WorkerPool,
+    _In_ const QUIC_WORKER* Worker,
+    _In_ uint64_t TimeNow,
+    _Out_ uint16_t* TargetIndex
+    )
+{
+    const uint32_t QueueDelay = Worker->AverageQueueDelay;
+    if (WorkerPool->WorkerCount < 2 ||
+        QueueDelay < QUIC_WORKER_REBALANCE_MIN_DELAY_US) {
+        return FALSE;
+    }
+
+    if (Worker->LastRebalanceTime != 0 &&
+        CxPlatTimeDiff64(Worker->LastRebalanceTime, TimeNow) < QUIC_WORKER_REBALANCE_INTERVAL_US) {
+        //
+        // Give the queue delays time to reflect the last move.
+        //
+        return FALSE;
+    }
+
+    uint16_t MinIndex = UINT16_MAX;
+    uint32_t MinQueueDelay = UINT32_MAX;
+    for (uint16_t i = 0; i < WorkerPool->WorkerCount; ++i) {
+        const QUIC_WORKER* Other = &WorkerPool->Workers[i];
+        if (Other != Worker && Other->AverageQueueDelay < MinQueueDelay) {
+            MinQueueDelay = Other->AverageQueueDelay;
+            MinIndex = i;
+        }
+    }
+
+    if ((uint64_t)MinQueueDelay * QUIC_WORKER_REBALANCE_SKEW >= QueueDelay) {
+        return FALSE; // Not skewed enough to be worth a move.
+    }
+
+    *TargetIndex = MinIndex;
+    return TRUE;
+}
+
 BOOLEAN
 QuicWorkerPoolIsInPartition(
     _In_ QUIC_WORKER_POOL* WorkerPool,
@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // A worker thread for draining queued operations on a connection.
 //
@@ -46,6 +50,11 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     //
     uint32_t AverageQueueDelay;
 
+    //
+    // The last time a connection was moved off this worker to rebalance load.
+    //
+    uint64_t LastRebalanceTime;
+
     //
     // Timers for the worker's connections.
     //
@@ -161,6 +170,20 @@ QuicWorkerPoolGetLeastLoadedWorker(
     _In_ QUIC_WORKER_POOL* WorkerPool
     );
 
+//
+// Finds a worker that the given (overloaded) worker should move a busy
+// connection to, if any.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicWorkerPoolGetRebalanceTarget(
+    _In_ const QUIC_WORKER_POOL* WorkerPool,
+    _In_ const QUIC_WORKER* Worker,
+    _In_ uint64_t TimeNow,
+    _Out_ uint16_t* TargetIndex
+    );
+
 //
 // Assigns the connection to a worker.
 //
@@ -223,3 +246,7 @@ QuicWorkerPoolIsInPartition(
     _In_ QUIC_WORKER_POOL* WorkerPool,
     _In_ uint16_t PartitionIndex
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -143,6 +143,8 @@ namespace Microsoft.Quic
     {
         FIFO = 0x0000,
         ROUND_ROBIN = 0x0001,
+        WEIGHTED_FAIR = 0x0002,
+        EXTENSIBLE_PRIORITY = 0x0003,
         COUNT,
     }
 
@@ -219,6 +221,7 @@ namespace Microsoft.Quic
         NO_IDEAL_PROC = 0x0008,
         HIGH_PRIORITY = 0x0010,
         AFFINITIZE = 0x0020,
+        BUSY_POLL = 0x0040,
     }
 
     internal unsafe partial struct QUIC_GLOBAL_EXECUTION_CONFIG
@@ -508,6 +511,8 @@ namespace Microsoft.Quic
     {
         CUBIC,
         BBR,
+        DCTCP,
+        BBR3,
         MAX,
     }
 
@@ -179,6 +179,32 @@ tracepoint(CLOG_BBR_C, ConnPersistentCongestion , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for Bbr3State
+// [conn][%p] BBRv3: Phase=%u InflightHi=%u InflightLo=%u EcnAlpha=%u
+// QuicTraceLogConnVerbose(
+            Bbr3State,
+            Connection,
+            "BBRv3: Phase=%u InflightHi=%u InflightLo=%u EcnAlpha=%u",
+            Bbr->ProbeBwPhase,
+            Bbr->InflightHi,
+            Bbr->InflightLo,
+            Bbr->EcnAlpha);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Bbr->ProbeBwPhase = arg3
+// arg4 = arg4 = Bbr->InflightHi = arg4
+// arg5 = arg5 = Bbr->InflightLo = arg5
+// arg6 = arg6 = Bbr->EcnAlpha = arg6
+----------------------------------------------------------*/
+#ifndef _clog_7_ARGS_TRACE_Bbr3State
+#define _clog_7_ARGS_TRACE_Bbr3State(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5, arg6)\
+tracepoint(CLOG_BBR_C, Bbr3State , arg1, arg3, arg4, arg5, arg6);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -204,3 +204,42 @@ TRACEPOINT_EVENT(CLOG_BBR_C, ConnPersistentCongestion,
         ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
     )
 )
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for Bbr3State
+// [conn][%p] BBRv3: Phase=%u InflightHi=%u InflightLo=%u EcnAlpha=%u
+// QuicTraceLogConnVerbose(
+            Bbr3State,
+            Connection,
+            "BBRv3: Phase=%u InflightHi=%u InflightLo=%u EcnAlpha=%u",
+            Bbr->ProbeBwPhase,
+            Bbr->InflightHi,
+            Bbr->InflightLo,
+            Bbr->EcnAlpha);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Bbr->ProbeBwPhase = arg3
+// arg4 = arg4 = Bbr->InflightHi = arg4
+// arg5 = arg5 = Bbr->InflightLo = arg5
+// arg6 = arg6 = Bbr->EcnAlpha = arg6
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_BBR_C, Bbr3State,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned int, arg4,
+        unsigned int, arg5,
+        unsigned int, arg6), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+        ctf_integer(unsigned int, arg6, arg6)
+    )
+)
+
+
+
+
@@ -0,0 +1,205 @@
+#ifndef CLOG_DO_NOT_INCLUDE_HEADER
+#include <clog.h>
+#endif
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER CLOG_CAREFUL_RESUME_C
+#undef TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#define  TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "careful_resume.c.clog.h.lttng.h"
+#if !defined(DEF_CLOG_CAREFUL_RESUME_C) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define DEF_CLOG_CAREFUL_RESUME_C
+#include <lttng/tracepoint.h>
+#define __int64 __int64_t
+#include "careful_resume.c.clog.h.lttng.h"
+#endif
+#include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogConnInfo
+#define _clog_MACRO_QuicTraceLogConnInfo  1
+#define QuicTraceLogConnInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceLogConnVerbose
+#define _clog_MACRO_QuicTraceLogConnVerbose  1
+#define QuicTraceLogConnVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceEvent
+#define _clog_MACRO_QuicTraceEvent  1
+#define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "careful resume cache entry",
+            sizeof(QUIC_CAREFUL_RESUME_CACHE_ENTRY) + ServerNameLength);
+// arg2 = arg2 = "careful resume cache entry" = arg2
+// arg3 = arg3 = sizeof(QUIC_CAREFUL_RESUME_CACHE_ENTRY) + ServerNameLength = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AllocFailure
+#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_CAREFUL_RESUME_C, AllocFailure , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeCacheHit
+// [conn][%p] Careful resume state found: SRtt=%llu CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeCacheHit,
+            Connection,
+            "Careful resume state found: SRtt=%llu CWnd=%u",
+            Saved.SmoothedRtt,
+            Saved.CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Saved.SmoothedRtt = arg3
+// arg4 = arg4 = Saved.CongestionWindow = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_CarefulResumeCacheHit
+#define _clog_5_ARGS_TRACE_CarefulResumeCacheHit(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CAREFUL_RESUME_C, CarefulResumeCacheHit , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeSaved
+// [conn][%p] Careful resume state saved: SRtt=%llu CWnd=%u
+// QuicTraceLogConnVerbose(
+            CarefulResumeSaved,
+            Connection,
+            "Careful resume state saved: SRtt=%llu CWnd=%u",
+            Saved.SmoothedRtt,
+            Saved.CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Saved.SmoothedRtt = arg3
+// arg4 = arg4 = Saved.CongestionWindow = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_CarefulResumeSaved
+#define _clog_5_ARGS_TRACE_CarefulResumeSaved(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CAREFUL_RESUME_C, CarefulResumeSaved , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeTicketState
+// [conn][%p] Careful resume state from ticket: SRtt=%llu CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeTicketState,
+            Connection,
+            "Careful resume state from ticket: SRtt=%llu CWnd=%u",
+            Saved.SmoothedRtt,
+            Saved.CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Saved.SmoothedRtt = arg3
+// arg4 = arg4 = Saved.CongestionWindow = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_CarefulResumeTicketState
+#define _clog_5_ARGS_TRACE_CarefulResumeTicketState(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CAREFUL_RESUME_C, CarefulResumeTicketState , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeAbandoned
+// [conn][%p] Careful resume not used: SRtt=%llu SavedSRtt=%llu
+// QuicTraceLogConnInfo(
+            CarefulResumeAbandoned,
+            Connection,
+            "Careful resume not used: SRtt=%llu SavedSRtt=%llu",
+            Path->SmoothedRtt,
+            CarefulResume->Saved.SmoothedRtt);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->SmoothedRtt = arg3
+// arg4 = arg4 = CarefulResume->Saved.SmoothedRtt = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_CarefulResumeAbandoned
+#define _clog_5_ARGS_TRACE_CarefulResumeAbandoned(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CAREFUL_RESUME_C, CarefulResumeAbandoned , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeJump
+// [conn][%p] Careful resume jump: CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeJump,
+            Connection,
+            "Careful resume jump: CWnd=%u",
+            JumpWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = JumpWindow = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_CarefulResumeJump
+#define _clog_4_ARGS_TRACE_CarefulResumeJump(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CAREFUL_RESUME_C, CarefulResumeJump , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeComplete
+// [conn][%p] Careful resume complete: PipeSize=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeComplete,
+            Connection,
+            "Careful resume complete: PipeSize=%u",
+            CarefulResume->PipeSize);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CarefulResume->PipeSize = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_CarefulResumeComplete
+#define _clog_4_ARGS_TRACE_CarefulResumeComplete(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CAREFUL_RESUME_C, CarefulResumeComplete , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeRetreat
+// [conn][%p] Careful resume safe retreat: CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeRetreat,
+            Connection,
+            "Careful resume safe retreat: CWnd=%u",
+            RetreatWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = RetreatWindow = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_CarefulResumeRetreat
+#define _clog_4_ARGS_TRACE_CarefulResumeRetreat(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CAREFUL_RESUME_C, CarefulResumeRetreat , arg1, arg3);\
+
+#endif
+
+
+
+
+#ifdef __cplusplus
+}
+#endif
+#ifdef CLOG_INLINE_IMPLEMENTATION
+#include "quic.clog_careful_resume.c.clog.h.c"
+#endif
@@ -0,0 +1,234 @@
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "careful resume cache entry",
+            sizeof(QUIC_CAREFUL_RESUME_CACHE_ENTRY) + ServerNameLength);
+// arg2 = arg2 = "careful resume cache entry" = arg2
+// arg3 = arg3 = sizeof(QUIC_CAREFUL_RESUME_CACHE_ENTRY) + ServerNameLength = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeCacheHit
+// [conn][%p] Careful resume state found: SRtt=%llu CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeCacheHit,
+            Connection,
+            "Careful resume state found: SRtt=%llu CWnd=%u",
+            Saved.SmoothedRtt,
+            Saved.CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Saved.SmoothedRtt = arg3
+// arg4 = arg4 = Saved.CongestionWindow = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, CarefulResumeCacheHit,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeSaved
+// [conn][%p] Careful resume state saved: SRtt=%llu CWnd=%u
+// QuicTraceLogConnVerbose(
+            CarefulResumeSaved,
+            Connection,
+            "Careful resume state saved: SRtt=%llu CWnd=%u",
+            Saved.SmoothedRtt,
+            Saved.CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Saved.SmoothedRtt = arg3
+// arg4 = arg4 = Saved.CongestionWindow = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, CarefulResumeSaved,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeTicketState
+// [conn][%p] Careful resume state from ticket: SRtt=%llu CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeTicketState,
+            Connection,
+            "Careful resume state from ticket: SRtt=%llu CWnd=%u",
+            Saved.SmoothedRtt,
+            Saved.CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Saved.SmoothedRtt = arg3
+// arg4 = arg4 = Saved.CongestionWindow = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, CarefulResumeTicketState,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeAbandoned
+// [conn][%p] Careful resume not used: SRtt=%llu SavedSRtt=%llu
+// QuicTraceLogConnInfo(
+            CarefulResumeAbandoned,
+            Connection,
+            "Careful resume not used: SRtt=%llu SavedSRtt=%llu",
+            Path->SmoothedRtt,
+            CarefulResume->Saved.SmoothedRtt);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->SmoothedRtt = arg3
+// arg4 = arg4 = CarefulResume->Saved.SmoothedRtt = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, CarefulResumeAbandoned,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned long long, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeJump
+// [conn][%p] Careful resume jump: CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeJump,
+            Connection,
+            "Careful resume jump: CWnd=%u",
+            JumpWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = JumpWindow = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, CarefulResumeJump,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeComplete
+// [conn][%p] Careful resume complete: PipeSize=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeComplete,
+            Connection,
+            "Careful resume complete: PipeSize=%u",
+            CarefulResume->PipeSize);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CarefulResume->PipeSize = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, CarefulResumeComplete,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CarefulResumeRetreat
+// [conn][%p] Careful resume safe retreat: CWnd=%u
+// QuicTraceLogConnInfo(
+            CarefulResumeRetreat,
+            Connection,
+            "Careful resume safe retreat: CWnd=%u",
+            RetreatWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = RetreatWindow = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CAREFUL_RESUME_C, CarefulResumeRetreat,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
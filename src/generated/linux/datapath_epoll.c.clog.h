@@ -83,6 +83,28 @@ tracepoint(CLOG_DATAPATH_EPOLL_C, EpollProcessorContextRelease , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for EpollProcessorContextTxBatchStats
+// [data][%p] Sent %llu batched datagrams in %llu sendmmsg calls
+// QuicTraceLogVerbose(
+            EpollProcessorContextTxBatchStats,
+            "[data][%p] Sent %llu batched datagrams in %llu sendmmsg calls",
+            DatapathPartition,
+            DatapathPartition->TxBatchDatagramCount,
+            DatapathPartition->TxBatchSyscallCount);
+// arg2 = arg2 = DatapathPartition = arg2
+// arg3 = arg3 = DatapathPartition->TxBatchDatagramCount = arg3
+// arg4 = arg4 = DatapathPartition->TxBatchSyscallCount = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_EpollProcessorContextTxBatchStats
+#define _clog_5_ARGS_TRACE_EpollProcessorContextTxBatchStats(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_DATAPATH_EPOLL_C, EpollProcessorContextTxBatchStats , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for EpollSocketRelease
 // [data][%p] Socket Freed
@@ -58,6 +58,34 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_EPOLL_C, EpollProcessorContextRelease,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for EpollProcessorContextTxBatchStats
+// [data][%p] Sent %llu batched datagrams in %llu sendmmsg calls
+// QuicTraceLogVerbose(
+            EpollProcessorContextTxBatchStats,
+            "[data][%p] Sent %llu batched datagrams in %llu sendmmsg calls",
+            DatapathPartition,
+            DatapathPartition->TxBatchDatagramCount,
+            DatapathPartition->TxBatchSyscallCount);
+// arg2 = arg2 = DatapathPartition = arg2
+// arg3 = arg3 = DatapathPartition->TxBatchDatagramCount = arg3
+// arg4 = arg4 = DatapathPartition->TxBatchSyscallCount = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_EPOLL_C, EpollProcessorContextTxBatchStats,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned long long, arg3,
+        unsigned long long, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+    )
+)
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for EpollSocketRelease
 // [data][%p] Socket Freed
@@ -43,6 +43,30 @@ tracepoint(CLOG_DATAPATH_IOURING_C, DatapathRecvEmpty , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatapathRecvBufferStall
+// [data][%p] Receive buffers exhausted (group=%hu, buffers=%u, stalls=%u)
+// QuicTraceLogWarning(
+            DatapathRecvBufferStall,
+            "[data][%p] Receive buffers exhausted (group=%hu, buffers=%u, stalls=%u)",
+            SocketContext->Binding,
+            Group->GroupId,
+            (uint32_t)Group->ChunkCount * Group->ChunkSize,
+            SocketContext->RecvBufferStallCount);
+// arg2 = arg2 = SocketContext->Binding = arg2
+// arg3 = arg3 = Group->GroupId = arg3
+// arg4 = arg4 = (uint32_t)Group->ChunkCount * Group->ChunkSize = arg4
+// arg5 = arg5 = SocketContext->RecvBufferStallCount = arg5
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_DatapathRecvBufferStall
+#define _clog_6_ARGS_TRACE_DatapathRecvBufferStall(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5)\
+tracepoint(CLOG_DATAPATH_IOURING_C, DatapathRecvBufferStall , arg2, arg3, arg4, arg5);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
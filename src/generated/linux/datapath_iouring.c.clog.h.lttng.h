@@ -20,6 +20,38 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_IOURING_C, DatapathRecvEmpty,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatapathRecvBufferStall
+// [data][%p] Receive buffers exhausted (group=%hu, buffers=%u, stalls=%u)
+// QuicTraceLogWarning(
+            DatapathRecvBufferStall,
+            "[data][%p] Receive buffers exhausted (group=%hu, buffers=%u, stalls=%u)",
+            SocketContext->Binding,
+            Group->GroupId,
+            (uint32_t)Group->ChunkCount * Group->ChunkSize,
+            SocketContext->RecvBufferStallCount);
+// arg2 = arg2 = SocketContext->Binding = arg2
+// arg3 = arg3 = Group->GroupId = arg3
+// arg4 = arg4 = (uint32_t)Group->ChunkCount * Group->ChunkSize = arg4
+// arg5 = arg5 = SocketContext->RecvBufferStallCount = arg5
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_IOURING_C, DatapathRecvBufferStall,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned short, arg3,
+        unsigned int, arg4,
+        unsigned int, arg5), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned short, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+    )
+)
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
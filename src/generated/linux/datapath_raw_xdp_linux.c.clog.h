@@ -0,0 +1,443 @@
+#ifndef CLOG_DO_NOT_INCLUDE_HEADER
+#include <clog.h>
+#endif
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER CLOG_DATAPATH_RAW_XDP_LINUX_C
+#undef TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#define  TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "datapath_raw_xdp_linux.c.clog.h.lttng.h"
+#if !defined(DEF_CLOG_DATAPATH_RAW_XDP_LINUX_C) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define DEF_CLOG_DATAPATH_RAW_XDP_LINUX_C
+#include <lttng/tracepoint.h>
+#define __int64 __int64_t
+#include "datapath_raw_xdp_linux.c.clog.h.lttng.h"
+#endif
+#include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogInfo
+#define _clog_MACRO_QuicTraceLogInfo  1
+#define QuicTraceLogInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceLogWarning
+#define _clog_MACRO_QuicTraceLogWarning  1
+#define QuicTraceLogWarning(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceLogVerbose
+#define _clog_MACRO_QuicTraceLogVerbose  1
+#define QuicTraceLogVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceEvent
+#define _clog_MACRO_QuicTraceEvent  1
+#define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*----------------------------------------------------------
+// Decoder Ring for LibraryErrorStatus
+// [ lib] ERROR, %u, %s.
+// QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_LINK_CREATE");
+// arg2 = arg2 = Status = arg2
+// arg3 = arg3 = "BPF_LINK_CREATE" = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_LibraryErrorStatus
+#define _clog_4_ARGS_TRACE_LibraryErrorStatus(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryErrorStatus , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpProgramAttached
+// [ixdp][%p] XDP program attached to interface %u
+// QuicTraceLogVerbose(
+            XdpProgramAttached,
+            "[ixdp][%p] XDP program attached to interface %u",
+            Interface,
+            Interface->ActualIfIndex);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->ActualIfIndex = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpProgramAttached
+#define _clog_4_ARGS_TRACE_XdpProgramAttached(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpProgramAttached , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP UMEM",
+            Queue->UmemSize);
+// arg2 = arg2 = "XDP UMEM" = arg2
+// arg3 = arg3 = Queue->UmemSize = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AllocFailure
+#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, AllocFailure , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInterfaceQueues
+// [ixdp][%p] Initializing %u queues on interface
+// QuicTraceLogVerbose(
+            XdpInterfaceQueues,
+            "[ixdp][%p] Initializing %u queues on interface",
+            Interface,
+            Interface->QueueCount);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->QueueCount = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpInterfaceQueues
+#define _clog_4_ARGS_TRACE_XdpInterfaceQueues(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInterfaceQueues , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInterfaceQueueTruncated
+// [ixdp][%p] Only %u queues usable on interface
+// QuicTraceLogWarning(
+            XdpInterfaceQueueTruncated,
+            "[ixdp][%p] Only %u queues usable on interface",
+            Interface,
+            i);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = i = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpInterfaceQueueTruncated
+#define _clog_4_ARGS_TRACE_XdpInterfaceQueueTruncated(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInterfaceQueueTruncated , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInterfaceInitialize
+// [ixdp][%p] Initializing interface %u
+// QuicTraceLogVerbose(
+            XdpInterfaceInitialize,
+            "[ixdp][%p] Initializing interface %u",
+            Interface,
+            Interface->ActualIfIndex);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->ActualIfIndex = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpInterfaceInitialize
+#define _clog_4_ARGS_TRACE_XdpInterfaceInitialize(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInterfaceInitialize , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryError
+// [ lib] ERROR, %s.
+// QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "XDP is not supported on this system");
+// arg2 = arg2 = "XDP is not supported on this system" = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryError
+#define _clog_3_ARGS_TRACE_LibraryError(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryError , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpQueueStart
+// [ xdp][%p] XDP queue start on partition %p
+// QuicTraceLogVerbose(
+            XdpQueueStart,
+            "[ xdp][%p] XDP queue start on partition %p",
+            Queue,
+            Partition);
+// arg2 = arg2 = Queue = arg2
+// arg3 = arg3 = Partition = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpQueueStart
+#define _clog_4_ARGS_TRACE_XdpQueueStart(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQueueStart , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpWorkerStart
+// [ xdp][%p] XDP partition start, %u queues
+// QuicTraceLogVerbose(
+            XdpWorkerStart,
+            "[ xdp][%p] XDP partition start, %u queues",
+            Partition,
+            QueueCount);
+// arg2 = arg2 = Partition = arg2
+// arg3 = arg3 = QueueCount = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpWorkerStart
+#define _clog_4_ARGS_TRACE_XdpWorkerStart(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpWorkerStart , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInitialize
+// [ xdp][%p] XDP initialized, %u procs
+// QuicTraceLogVerbose(
+            XdpInitialize,
+            "[ xdp][%p] XDP initialized, %u procs",
+            Xdp,
+            Xdp->PartitionCount);
+// arg2 = arg2 = Xdp = arg2
+// arg3 = arg3 = Xdp->PartitionCount = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpInitialize
+#define _clog_4_ARGS_TRACE_XdpInitialize(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInitialize , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpRelease
+// [ xdp][%p] XDP release
+// QuicTraceLogVerbose(
+            XdpRelease,
+            "[ xdp][%p] XDP release",
+            Xdp);
+// arg2 = arg2 = Xdp = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpRelease
+#define _clog_3_ARGS_TRACE_XdpRelease(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpRelease , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpUninitializeComplete
+// [ xdp][%p] XDP uninitialize complete
+// QuicTraceLogVerbose(
+            XdpUninitializeComplete,
+            "[ xdp][%p] XDP uninitialize complete",
+            Xdp);
+// arg2 = arg2 = Xdp = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpUninitializeComplete
+#define _clog_3_ARGS_TRACE_XdpUninitializeComplete(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpUninitializeComplete , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpUninitialize
+// [ xdp][%p] XDP uninitialize
+// QuicTraceLogVerbose(
+            XdpUninitialize,
+            "[ xdp][%p] XDP uninitialize",
+            Xdp);
+// arg2 = arg2 = Xdp = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpUninitialize
+#define _clog_3_ARGS_TRACE_XdpUninitialize(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpUninitialize , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpPartitionShutdown
+// [ xdp][%p] XDP partition shutdown
+// QuicTraceLogVerbose(
+            XdpPartitionShutdown,
+            "[ xdp][%p] XDP partition shutdown",
+            Partition);
+// arg2 = arg2 = Partition = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpPartitionShutdown
+#define _clog_3_ARGS_TRACE_XdpPartitionShutdown(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpPartitionShutdown , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpQueueAsyncIoRx
+// [ xdp][%p] XDP async IO start (RX)
+// QuicTraceLogVerbose(
+            XdpQueueAsyncIoRx,
+            "[ xdp][%p] XDP async IO start (RX)",
+            Queue);
+// arg2 = arg2 = Queue = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpQueueAsyncIoRx
+#define _clog_3_ARGS_TRACE_XdpQueueAsyncIoRx(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQueueAsyncIoRx , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpQueueAsyncIoRxComplete
+// [ xdp][%p] XDP async IO complete (RX)
+// QuicTraceLogVerbose(
+            XdpQueueAsyncIoRxComplete,
+            "[ xdp][%p] XDP async IO complete (RX)",
+            Queue);
+// arg2 = arg2 = Queue = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpQueueAsyncIoRxComplete
+#define _clog_3_ARGS_TRACE_XdpQueueAsyncIoRxComplete(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQueueAsyncIoRxComplete , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpPartitionShutdownComplete
+// [ xdp][%p] XDP partition shutdown complete
+// QuicTraceLogVerbose(
+            XdpPartitionShutdownComplete,
+            "[ xdp][%p] XDP partition shutdown complete",
+            Partition);
+// arg2 = arg2 = Partition = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpPartitionShutdownComplete
+#define _clog_3_ARGS_TRACE_XdpPartitionShutdownComplete(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpPartitionShutdownComplete , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpMapInsertFailedLinux
+// [ixdp][%p] XSKMAP insert failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u
+// QuicTraceLogVerbose(
+            XdpMapInsertFailedLinux,
+            "[ixdp][%p] XSKMAP insert failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u",
+            Interface,
+            Interface->IfIndex,
+            j,
+            XskMap,
+            Queue->Xsk,
+            Status);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->IfIndex = arg3
+// arg4 = arg4 = j = arg4
+// arg5 = arg5 = XskMap = arg5
+// arg6 = arg6 = Queue->Xsk = arg6
+// arg7 = arg7 = Status = arg7
+----------------------------------------------------------*/
+#ifndef _clog_8_ARGS_TRACE_XdpMapInsertFailedLinux
+#define _clog_8_ARGS_TRACE_XdpMapInsertFailedLinux(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5, arg6, arg7)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpMapInsertFailedLinux , arg2, arg3, arg4, arg5, arg6, arg7);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpMapDeleteFailedLinux
+// [ixdp][%p] XSKMAP delete failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u
+// QuicTraceLogVerbose(
+            XdpMapDeleteFailedLinux,
+            "[ixdp][%p] XSKMAP delete failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u",
+            Interface,
+            Interface->IfIndex,
+            j,
+            Interface->ExternalXskMapFd,
+            Interface->Queues[j].Xsk,
+            Status);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->IfIndex = arg3
+// arg4 = arg4 = j = arg4
+// arg5 = arg5 = Interface->ExternalXskMapFd = arg5
+// arg6 = arg6 = Interface->Queues[j].Xsk = arg6
+// arg7 = arg7 = Status = arg7
+----------------------------------------------------------*/
+#ifndef _clog_8_ARGS_TRACE_XdpMapDeleteFailedLinux
+#define _clog_8_ARGS_TRACE_XdpMapDeleteFailedLinux(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5, arg6, arg7)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpMapDeleteFailedLinux , arg2, arg3, arg4, arg5, arg6, arg7);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpMapModeConfiguredLinux
+// [ixdp][%p] Map mode configured for IfIndex=%u (MapFd=%d)
+// QuicTraceLogVerbose(
+            XdpMapModeConfiguredLinux,
+            "[ixdp][%p] Map mode configured for IfIndex=%u (MapFd=%d)",
+            Interface,
+            Interface->IfIndex,
+            XskMap);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->IfIndex = arg3
+// arg4 = arg4 = XskMap = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_XdpMapModeConfiguredLinux
+#define _clog_5_ARGS_TRACE_XdpMapModeConfiguredLinux(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpMapModeConfiguredLinux , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
+#ifdef __cplusplus
+}
+#endif
+#ifdef CLOG_INLINE_IMPLEMENTATION
+#include "quic.clog_datapath_raw_xdp_linux.c.clog.h.c"
+#endif
@@ -0,0 +1,547 @@
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryErrorStatus
+// [ lib] ERROR, %u, %s.
+// QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_LINK_CREATE");
+// arg2 = arg2 = Status = arg2
+// arg3 = arg3 = "BPF_LINK_CREATE" = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryErrorStatus,
+    TP_ARGS(
+        unsigned int, arg2,
+        const char *, arg3), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+        ctf_string(arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpProgramAttached
+// [ixdp][%p] XDP program attached to interface %u
+// QuicTraceLogVerbose(
+            XdpProgramAttached,
+            "[ixdp][%p] XDP program attached to interface %u",
+            Interface,
+            Interface->ActualIfIndex);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->ActualIfIndex = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpProgramAttached,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP UMEM",
+            Queue->UmemSize);
+// arg2 = arg2 = "XDP UMEM" = arg2
+// arg3 = arg3 = Queue->UmemSize = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInterfaceQueues
+// [ixdp][%p] Initializing %u queues on interface
+// QuicTraceLogVerbose(
+            XdpInterfaceQueues,
+            "[ixdp][%p] Initializing %u queues on interface",
+            Interface,
+            Interface->QueueCount);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->QueueCount = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInterfaceQueues,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInterfaceQueueTruncated
+// [ixdp][%p] Only %u queues usable on interface
+// QuicTraceLogWarning(
+            XdpInterfaceQueueTruncated,
+            "[ixdp][%p] Only %u queues usable on interface",
+            Interface,
+            i);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = i = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInterfaceQueueTruncated,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInterfaceInitialize
+// [ixdp][%p] Initializing interface %u
+// QuicTraceLogVerbose(
+            XdpInterfaceInitialize,
+            "[ixdp][%p] Initializing interface %u",
+            Interface,
+            Interface->ActualIfIndex);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->ActualIfIndex = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInterfaceInitialize,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryError
+// [ lib] ERROR, %s.
+// QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "XDP is not supported on this system");
+// arg2 = arg2 = "XDP is not supported on this system" = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryError,
+    TP_ARGS(
+        const char *, arg2), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpQueueStart
+// [ xdp][%p] XDP queue start on partition %p
+// QuicTraceLogVerbose(
+            XdpQueueStart,
+            "[ xdp][%p] XDP queue start on partition %p",
+            Queue,
+            Partition);
+// arg2 = arg2 = Queue = arg2
+// arg3 = arg3 = Partition = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQueueStart,
+    TP_ARGS(
+        const void *, arg2,
+        const void *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpWorkerStart
+// [ xdp][%p] XDP partition start, %u queues
+// QuicTraceLogVerbose(
+            XdpWorkerStart,
+            "[ xdp][%p] XDP partition start, %u queues",
+            Partition,
+            QueueCount);
+// arg2 = arg2 = Partition = arg2
+// arg3 = arg3 = QueueCount = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpWorkerStart,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpInitialize
+// [ xdp][%p] XDP initialized, %u procs
+// QuicTraceLogVerbose(
+            XdpInitialize,
+            "[ xdp][%p] XDP initialized, %u procs",
+            Xdp,
+            Xdp->PartitionCount);
+// arg2 = arg2 = Xdp = arg2
+// arg3 = arg3 = Xdp->PartitionCount = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpInitialize,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpRelease
+// [ xdp][%p] XDP release
+// QuicTraceLogVerbose(
+            XdpRelease,
+            "[ xdp][%p] XDP release",
+            Xdp);
+// arg2 = arg2 = Xdp = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpRelease,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpUninitializeComplete
+// [ xdp][%p] XDP uninitialize complete
+// QuicTraceLogVerbose(
+            XdpUninitializeComplete,
+            "[ xdp][%p] XDP uninitialize complete",
+            Xdp);
+// arg2 = arg2 = Xdp = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpUninitializeComplete,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpUninitialize
+// [ xdp][%p] XDP uninitialize
+// QuicTraceLogVerbose(
+            XdpUninitialize,
+            "[ xdp][%p] XDP uninitialize",
+            Xdp);
+// arg2 = arg2 = Xdp = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpUninitialize,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpPartitionShutdown
+// [ xdp][%p] XDP partition shutdown
+// QuicTraceLogVerbose(
+            XdpPartitionShutdown,
+            "[ xdp][%p] XDP partition shutdown",
+            Partition);
+// arg2 = arg2 = Partition = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpPartitionShutdown,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpQueueAsyncIoRx
+// [ xdp][%p] XDP async IO start (RX)
+// QuicTraceLogVerbose(
+            XdpQueueAsyncIoRx,
+            "[ xdp][%p] XDP async IO start (RX)",
+            Queue);
+// arg2 = arg2 = Queue = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQueueAsyncIoRx,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpQueueAsyncIoRxComplete
+// [ xdp][%p] XDP async IO complete (RX)
+// QuicTraceLogVerbose(
+            XdpQueueAsyncIoRxComplete,
+            "[ xdp][%p] XDP async IO complete (RX)",
+            Queue);
+// arg2 = arg2 = Queue = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQueueAsyncIoRxComplete,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpPartitionShutdownComplete
+// [ xdp][%p] XDP partition shutdown complete
+// QuicTraceLogVerbose(
+            XdpPartitionShutdownComplete,
+            "[ xdp][%p] XDP partition shutdown complete",
+            Partition);
+// arg2 = arg2 = Partition = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpPartitionShutdownComplete,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpMapInsertFailedLinux
+// [ixdp][%p] XSKMAP insert failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u
+// QuicTraceLogVerbose(
+            XdpMapInsertFailedLinux,
+            "[ixdp][%p] XSKMAP insert failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u",
+            Interface,
+            Interface->IfIndex,
+            j,
+            XskMap,
+            Queue->Xsk,
+            Status);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->IfIndex = arg3
+// arg4 = arg4 = j = arg4
+// arg5 = arg5 = XskMap = arg5
+// arg6 = arg6 = Queue->Xsk = arg6
+// arg7 = arg7 = Status = arg7
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpMapInsertFailedLinux,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        unsigned int, arg4,
+        int, arg5,
+        int, arg6,
+        unsigned int, arg7), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(int, arg5, arg5)
+        ctf_integer(int, arg6, arg6)
+        ctf_integer(unsigned int, arg7, arg7)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpMapDeleteFailedLinux
+// [ixdp][%p] XSKMAP delete failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u
+// QuicTraceLogVerbose(
+            XdpMapDeleteFailedLinux,
+            "[ixdp][%p] XSKMAP delete failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u",
+            Interface,
+            Interface->IfIndex,
+            j,
+            Interface->ExternalXskMapFd,
+            Interface->Queues[j].Xsk,
+            Status);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->IfIndex = arg3
+// arg4 = arg4 = j = arg4
+// arg5 = arg5 = Interface->ExternalXskMapFd = arg5
+// arg6 = arg6 = Interface->Queues[j].Xsk = arg6
+// arg7 = arg7 = Status = arg7
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpMapDeleteFailedLinux,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        unsigned int, arg4,
+        int, arg5,
+        int, arg6,
+        unsigned int, arg7), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(int, arg5, arg5)
+        ctf_integer(int, arg6, arg6)
+        ctf_integer(unsigned int, arg7, arg7)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpMapModeConfiguredLinux
+// [ixdp][%p] Map mode configured for IfIndex=%u (MapFd=%d)
+// QuicTraceLogVerbose(
+            XdpMapModeConfiguredLinux,
+            "[ixdp][%p] Map mode configured for IfIndex=%u (MapFd=%d)",
+            Interface,
+            Interface->IfIndex,
+            XskMap);
+// arg2 = arg2 = Interface = arg2
+// arg3 = arg3 = Interface->IfIndex = arg3
+// arg4 = arg4 = XskMap = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpMapModeConfiguredLinux,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(int, arg4, arg4)
+    )
+)
+
+
+
+
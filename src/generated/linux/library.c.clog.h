@@ -224,6 +224,42 @@ tracepoint(CLOG_LIBRARY_C, LibraryDscpRecvEnabledSet , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibrarySendZeroCopyEnabledSet
+// [ lib] Setting send zero copy = %u
+// QuicTraceLogInfo(
+            LibrarySendZeroCopyEnabledSet,
+            "[ lib] Setting send zero copy = %u",
+            MsQuicLib.EnableSendZeroCopy);
+// arg2 = arg2 = MsQuicLib.EnableSendZeroCopy = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibrarySendZeroCopyEnabledSet
+#define _clog_3_ARGS_TRACE_LibrarySendZeroCopyEnabledSet(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibrarySendZeroCopyEnabledSet , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibrarySendZeroCopyThresholdSet
+// [ lib] Setting send zero copy threshold = %u
+// QuicTraceLogInfo(
+            LibrarySendZeroCopyThresholdSet,
+            "[ lib] Setting send zero copy threshold = %u",
+            MsQuicLib.SendZeroCopyThreshold);
+// arg2 = arg2 = MsQuicLib.SendZeroCopyThreshold = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibrarySendZeroCopyThresholdSet
+#define _clog_3_ARGS_TRACE_LibrarySendZeroCopyThresholdSet(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibrarySendZeroCopyThresholdSet , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibraryInUse
 // [ lib] Now in use.
@@ -736,6 +772,26 @@ tracepoint(CLOG_LIBRARY_C, ApiExit );\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryCongestionControlProviderSet
+// [ lib] Registered congestion control provider %hu (%s)
+// QuicTraceLogInfo(
+            LibraryCongestionControlProviderSet,
+            "[ lib] Registered congestion control provider %hu (%s)",
+            Provider->Algorithm,
+            Provider->Name);
+// arg2 = arg2 = Provider->Algorithm = arg2
+// arg3 = arg3 = Provider->Name = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_LibraryCongestionControlProviderSet
+#define _clog_4_ARGS_TRACE_LibraryCongestionControlProviderSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LIBRARY_C, LibraryCongestionControlProviderSet , arg2, arg3);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -194,6 +194,46 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryDscpRecvEnabledSet,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibrarySendZeroCopyEnabledSet
+// [ lib] Setting send zero copy = %u
+// QuicTraceLogInfo(
+            LibrarySendZeroCopyEnabledSet,
+            "[ lib] Setting send zero copy = %u",
+            MsQuicLib.EnableSendZeroCopy);
+// arg2 = arg2 = MsQuicLib.EnableSendZeroCopy = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibrarySendZeroCopyEnabledSet,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibrarySendZeroCopyThresholdSet
+// [ lib] Setting send zero copy threshold = %u
+// QuicTraceLogInfo(
+            LibrarySendZeroCopyThresholdSet,
+            "[ lib] Setting send zero copy threshold = %u",
+            MsQuicLib.SendZeroCopyThreshold);
+// arg2 = arg2 = MsQuicLib.SendZeroCopyThreshold = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibrarySendZeroCopyThresholdSet,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibraryInUse
 // [ lib] Now in use.
@@ -737,3 +777,30 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, ApiExit,
     TP_FIELDS(
     )
 )
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryCongestionControlProviderSet
+// [ lib] Registered congestion control provider %hu (%s)
+// QuicTraceLogInfo(
+            LibraryCongestionControlProviderSet,
+            "[ lib] Registered congestion control provider %hu (%s)",
+            Provider->Algorithm,
+            Provider->Name);
+// arg2 = arg2 = Provider->Algorithm = arg2
+// arg3 = arg3 = Provider->Name = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryCongestionControlProviderSet,
+    TP_ARGS(
+        unsigned short, arg2,
+        const char *, arg3), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+        ctf_string(arg3, arg3)
+    )
+)
+
+
+
+
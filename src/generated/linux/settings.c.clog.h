@@ -782,6 +782,114 @@ tracepoint(CLOG_SETTINGS_C, SettingQTIPEnabled , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingCarefulResumeEnabled
+// [sett] CarefulResumeEnabled   = %hhu
+// QuicTraceLogVerbose(
+            SettingCarefulResumeEnabled,
+            "[sett] CarefulResumeEnabled   = %hhu",
+            Settings->CarefulResumeEnabled);
+// arg2 = arg2 = Settings->CarefulResumeEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingCarefulResumeEnabled
+#define _clog_3_ARGS_TRACE_SettingCarefulResumeEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingCarefulResumeEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingAdaptiveAckFrequencyEnabled
+// [sett] AdaptiveAckFreqEnabled = %hhu
+// QuicTraceLogVerbose(
+            SettingAdaptiveAckFrequencyEnabled,
+            "[sett] AdaptiveAckFreqEnabled = %hhu",
+            Settings->AdaptiveAckFrequencyEnabled);
+// arg2 = arg2 = Settings->AdaptiveAckFrequencyEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingAdaptiveAckFrequencyEnabled
+#define _clog_3_ARGS_TRACE_SettingAdaptiveAckFrequencyEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingAdaptiveAckFrequencyEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingWorkerRebalancingEnabled
+// [sett] WorkerRebalanceEnabled = %hhu
+// QuicTraceLogVerbose(
+            SettingWorkerRebalancingEnabled,
+            "[sett] WorkerRebalanceEnabled = %hhu",
+            Settings->WorkerRebalancingEnabled);
+// arg2 = arg2 = Settings->WorkerRebalancingEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingWorkerRebalancingEnabled
+#define _clog_3_ARGS_TRACE_SettingWorkerRebalancingEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingWorkerRebalancingEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingOpenAddressingLookupEnabled
+// [sett] OpenAddrLookupEnabled  = %hhu
+// QuicTraceLogVerbose(
+            SettingOpenAddressingLookupEnabled,
+            "[sett] OpenAddrLookupEnabled  = %hhu",
+            Settings->OpenAddressingLookupEnabled);
+// arg2 = arg2 = Settings->OpenAddressingLookupEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingOpenAddressingLookupEnabled
+#define _clog_3_ARGS_TRACE_SettingOpenAddressingLookupEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingOpenAddressingLookupEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingResumptionTicketCacheEnabled
+// [sett] TicketCacheEnabled     = %hhu
+// QuicTraceLogVerbose(
+            SettingResumptionTicketCacheEnabled,
+            "[sett] TicketCacheEnabled     = %hhu",
+            Settings->ResumptionTicketCacheEnabled);
+// arg2 = arg2 = Settings->ResumptionTicketCacheEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingResumptionTicketCacheEnabled
+#define _clog_3_ARGS_TRACE_SettingResumptionTicketCacheEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingResumptionTicketCacheEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingStatelessResetSipHashEnabled
+// [sett] ResetSipHashEnabled    = %hhu
+// QuicTraceLogVerbose(
+            SettingStatelessResetSipHashEnabled,
+            "[sett] ResetSipHashEnabled    = %hhu",
+            Settings->StatelessResetSipHashEnabled);
+// arg2 = arg2 = Settings->StatelessResetSipHashEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingStatelessResetSipHashEnabled
+#define _clog_3_ARGS_TRACE_SettingStatelessResetSipHashEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingStatelessResetSipHashEnabled , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingOneWayDelayEnabled
 // [sett] OneWayDelayEnabled     = %hhu
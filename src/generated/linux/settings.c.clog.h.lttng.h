@@ -810,6 +810,126 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingQTIPEnabled,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingCarefulResumeEnabled
+// [sett] CarefulResumeEnabled   = %hhu
+// QuicTraceLogVerbose(
+            SettingCarefulResumeEnabled,
+            "[sett] CarefulResumeEnabled   = %hhu",
+            Settings->CarefulResumeEnabled);
+// arg2 = arg2 = Settings->CarefulResumeEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingCarefulResumeEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingAdaptiveAckFrequencyEnabled
+// [sett] AdaptiveAckFreqEnabled = %hhu
+// QuicTraceLogVerbose(
+            SettingAdaptiveAckFrequencyEnabled,
+            "[sett] AdaptiveAckFreqEnabled = %hhu",
+            Settings->AdaptiveAckFrequencyEnabled);
+// arg2 = arg2 = Settings->AdaptiveAckFrequencyEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingAdaptiveAckFrequencyEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingWorkerRebalancingEnabled
+// [sett] WorkerRebalanceEnabled = %hhu
+// QuicTraceLogVerbose(
+            SettingWorkerRebalancingEnabled,
+            "[sett] WorkerRebalanceEnabled = %hhu",
+            Settings->WorkerRebalancingEnabled);
+// arg2 = arg2 = Settings->WorkerRebalancingEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingWorkerRebalancingEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingOpenAddressingLookupEnabled
+// [sett] OpenAddrLookupEnabled  = %hhu
+// QuicTraceLogVerbose(
+            SettingOpenAddressingLookupEnabled,
+            "[sett] OpenAddrLookupEnabled  = %hhu",
+            Settings->OpenAddressingLookupEnabled);
+// arg2 = arg2 = Settings->OpenAddressingLookupEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingOpenAddressingLookupEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingResumptionTicketCacheEnabled
+// [sett] TicketCacheEnabled     = %hhu
+// QuicTraceLogVerbose(
+            SettingResumptionTicketCacheEnabled,
+            "[sett] TicketCacheEnabled     = %hhu",
+            Settings->ResumptionTicketCacheEnabled);
+// arg2 = arg2 = Settings->ResumptionTicketCacheEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingResumptionTicketCacheEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingStatelessResetSipHashEnabled
+// [sett] ResetSipHashEnabled    = %hhu
+// QuicTraceLogVerbose(
+            SettingStatelessResetSipHashEnabled,
+            "[sett] ResetSipHashEnabled    = %hhu",
+            Settings->StatelessResetSipHashEnabled);
+// arg2 = arg2 = Settings->StatelessResetSipHashEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingStatelessResetSipHashEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingOneWayDelayEnabled
 // [sett] OneWayDelayEnabled     = %hhu
@@ -0,0 +1,99 @@
+#ifndef CLOG_DO_NOT_INCLUDE_HEADER
+#include <clog.h>
+#endif
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER CLOG_TICKET_CACHE_C
+#undef TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#define  TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "ticket_cache.c.clog.h.lttng.h"
+#if !defined(DEF_CLOG_TICKET_CACHE_C) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define DEF_CLOG_TICKET_CACHE_C
+#include <lttng/tracepoint.h>
+#define __int64 __int64_t
+#include "ticket_cache.c.clog.h.lttng.h"
+#endif
+#include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogConnInfo
+#define _clog_MACRO_QuicTraceLogConnInfo  1
+#define QuicTraceLogConnInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceLogConnVerbose
+#define _clog_MACRO_QuicTraceLogConnVerbose  1
+#define QuicTraceLogConnVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceEvent
+#define _clog_MACRO_QuicTraceEvent  1
+#define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "ticket cache ticket",
+            TicketSize);
+// arg2 = arg2 = "ticket cache ticket" = arg2
+// arg3 = arg3 = TicketSize = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AllocFailure
+#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_TICKET_CACHE_C, AllocFailure , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for TicketCacheHit
+// [conn][%p] Resuming with a cached ticket, EarlyDataAllowed=%hhu
+// QuicTraceLogConnInfo(
+            TicketCacheHit,
+            Connection,
+            "Resuming with a cached ticket, EarlyDataAllowed=%hhu",
+            EarlyDataAllowed);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = EarlyDataAllowed = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_TicketCacheHit
+#define _clog_4_ARGS_TRACE_TicketCacheHit(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_TICKET_CACHE_C, TicketCacheHit , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for TicketCacheSaved
+// [conn][%p] Resumption ticket cached, Lifetime=%u EarlyDataAllowed=%hhu
+// QuicTraceLogConnVerbose(
+            TicketCacheSaved,
+            Connection,
+            "Resumption ticket cached, Lifetime=%u EarlyDataAllowed=%hhu",
+            Lifetime,
+            EarlyDataAllowed);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Lifetime = arg3
+// arg4 = arg4 = EarlyDataAllowed = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_TicketCacheSaved
+#define _clog_5_ARGS_TRACE_TicketCacheSaved(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_TICKET_CACHE_C, TicketCacheSaved , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+#ifdef __cplusplus
+}
+#endif
+#ifdef CLOG_INLINE_IMPLEMENTATION
+#include "quic.clog_ticket_cache.c.clog.h.c"
+#endif
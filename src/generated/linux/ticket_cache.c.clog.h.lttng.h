@@ -0,0 +1,90 @@
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "ticket cache ticket",
+            TicketSize);
+// arg2 = arg2 = "ticket cache ticket" = arg2
+// arg3 = arg3 = TicketSize = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_TICKET_CACHE_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for TicketCacheHit
+// [conn][%p] Resuming with a cached ticket, EarlyDataAllowed=%hhu
+// QuicTraceLogConnInfo(
+            TicketCacheHit,
+            Connection,
+            "Resuming with a cached ticket, EarlyDataAllowed=%hhu",
+            EarlyDataAllowed);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = EarlyDataAllowed = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_TICKET_CACHE_C, TicketCacheHit,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
+
+
+
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for TicketCacheSaved
+// [conn][%p] Resumption ticket cached, Lifetime=%u EarlyDataAllowed=%hhu
+// QuicTraceLogConnVerbose(
+            TicketCacheSaved,
+            Connection,
+            "Resumption ticket cached, Lifetime=%u EarlyDataAllowed=%hhu",
+            Lifetime,
+            EarlyDataAllowed);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Lifetime = arg3
+// arg4 = arg4 = EarlyDataAllowed = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_TICKET_CACHE_C, TicketCacheSaved,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned char, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned char, arg4, arg4)
+    )
+)
+
+
+
+
@@ -29,26 +29,6 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
-/*----------------------------------------------------------
-// Decoder Ring for TimerWheelResize
-// [time][%p] Resizing timer wheel (new slot count = %u).
-// QuicTraceLogVerbose(
-        TimerWheelResize,
-        "[time][%p] Resizing timer wheel (new slot count = %u).",
-        TimerWheel,
-        NewSlotCount);
-// arg2 = arg2 = TimerWheel = arg2
-// arg3 = arg3 = NewSlotCount = arg3
-----------------------------------------------------------*/
-#ifndef _clog_4_ARGS_TRACE_TimerWheelResize
-#define _clog_4_ARGS_TRACE_TimerWheelResize(uniqueId, encoded_arg_string, arg2, arg3)\
-tracepoint(CLOG_TIMER_WHEEL_C, TimerWheelResize , arg2, arg3);\
-
-#endif
-
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for TimerWheelNextExpirationNull
 // [time][%p] Next Expiration = {NULL}.
@@ -153,9 +133,9 @@ tracepoint(CLOG_TIMER_WHEEL_C, StillInTimerWheel , arg1);\
 // QuicTraceEvent(
             AllocFailure,
             "Allocation of '%s' failed. (%llu bytes)", "timerwheel slots",
-            QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY));
+            QUIC_TIMER_WHEEL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY));
 // arg2 = arg2 = "timerwheel slots" = arg2
-// arg3 = arg3 = QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY) = arg3
+// arg3 = arg3 = QUIC_TIMER_WHEEL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY) = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_AllocFailure
 #define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
@@ -1,29 +1,6 @@
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for TimerWheelResize
-// [time][%p] Resizing timer wheel (new slot count = %u).
-// QuicTraceLogVerbose(
-        TimerWheelResize,
-        "[time][%p] Resizing timer wheel (new slot count = %u).",
-        TimerWheel,
-        NewSlotCount);
-// arg2 = arg2 = TimerWheel = arg2
-// arg3 = arg3 = NewSlotCount = arg3
-----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, TimerWheelResize,
-    TP_ARGS(
-        const void *, arg2,
-        unsigned int, arg3), 
-    TP_FIELDS(
-        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
-        ctf_integer(unsigned int, arg3, arg3)
-    )
-)
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for TimerWheelNextExpirationNull
 // [time][%p] Next Expiration = {NULL}.
@@ -141,9 +118,9 @@ TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, StillInTimerWheel,
 // QuicTraceEvent(
             AllocFailure,
             "Allocation of '%s' failed. (%llu bytes)", "timerwheel slots",
-            QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY));
+            QUIC_TIMER_WHEEL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY));
 // arg2 = arg2 = "timerwheel slots" = arg2
-// arg3 = arg3 = QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY) = arg3
+// arg3 = arg3 = QUIC_TIMER_WHEEL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY) = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, AllocFailure,
     TP_ARGS(
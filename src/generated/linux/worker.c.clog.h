@@ -47,6 +47,30 @@ tracepoint(CLOG_WORKER_C, IndicateIdealProcChanged , arg1, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ConnRebalanced
+// [conn][%p] Moving to less loaded worker (partition %hu, queue delay %u us vs %u us)
+// QuicTraceLogConnInfo(
+            ConnRebalanced,
+            Connection,
+            "Moving to less loaded worker (partition %hu, queue delay %u us vs %u us)",
+            TargetIndex,
+            Registration->WorkerPool->Workers[TargetIndex].AverageQueueDelay,
+            Worker->AverageQueueDelay);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = TargetIndex = arg3
+// arg4 = arg4 = Registration->WorkerPool->Workers[TargetIndex].AverageQueueDelay = arg4
+// arg5 = arg5 = Worker->AverageQueueDelay = arg5
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_ConnRebalanced
+#define _clog_6_ARGS_TRACE_ConnRebalanced(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5)\
+tracepoint(CLOG_WORKER_C, ConnRebalanced , arg1, arg3, arg4, arg5);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AbandonOnLibShutdown
 // [conn][%p] Abandoning on shutdown
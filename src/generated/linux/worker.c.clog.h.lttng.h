@@ -28,6 +28,38 @@ TRACEPOINT_EVENT(CLOG_WORKER_C, IndicateIdealProcChanged,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ConnRebalanced
+// [conn][%p] Moving to less loaded worker (partition %hu, queue delay %u us vs %u us)
+// QuicTraceLogConnInfo(
+            ConnRebalanced,
+            Connection,
+            "Moving to less loaded worker (partition %hu, queue delay %u us vs %u us)",
+            TargetIndex,
+            Registration->WorkerPool->Workers[TargetIndex].AverageQueueDelay,
+            Worker->AverageQueueDelay);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = TargetIndex = arg3
+// arg4 = arg4 = Registration->WorkerPool->Workers[TargetIndex].AverageQueueDelay = arg4
+// arg5 = arg5 = Worker->AverageQueueDelay = arg5
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, ConnRebalanced,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned short, arg3,
+        unsigned int, arg4,
+        unsigned int, arg5), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned short, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+    )
+)
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AbandonOnLibShutdown
 // [conn][%p] Abandoning on shutdown
@@ -190,9 +190,20 @@ DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_RESUMPTION_FLAGS)
 typedef enum QUIC_STREAM_SCHEDULING_SCHEME {
     QUIC_STREAM_SCHEDULING_SCHEME_FIFO          = 0x0000,   // Sends stream data first come, first served. (Default)
     QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN   = 0x0001,   // Sends stream data evenly multiplexed.
+    QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR = 0x0002,   // Sends stream data multiplexed in proportion to stream priority.
+    QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY = 0x0003, // Sends stream data by RFC 9218 urgency and incremental.
     QUIC_STREAM_SCHEDULING_SCHEME_COUNT,                    // The number of stream scheduling schemes.
 } QUIC_STREAM_SCHEDULING_SCHEME;
 
+//
+// Stream priorities for the QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY
+// scheme, built from an RFC 9218 urgency (0 highest to 7 lowest) and
+// incremental flag. Urgency 3, non-incremental maps to the default priority.
+//
+#define QUIC_STREAM_PRIORITY_FROM_URGENCY(Urgency, Incremental) \
+    ((uint16_t)(0x7FFF + 2 * (3 - (int)(Urgency)) - ((Incremental) ? 1 : 0)))
+#define QUIC_STREAM_PRIORITY_IS_INCREMENTAL(Priority) (((Priority) & 1) == 0)
+
 typedef enum QUIC_STREAM_OPEN_FLAGS {
     QUIC_STREAM_OPEN_FLAG_NONE              = 0x0000,
     QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL    = 0x0001,   // Indicates the stream is unidirectional.
@@ -277,6 +288,7 @@ typedef enum QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS {
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_NO_IDEAL_PROC    = 0x0008,
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_HIGH_PRIORITY    = 0x0010,
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_AFFINITIZE       = 0x0020,
+    QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_BUSY_POLL        = 0x0040, // Linux only
 } QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS)
@@ -368,6 +380,166 @@ typedef struct QUIC_XDP_MAP_CONFIG {
     QUIC_XDP_MAP_HANDLE MapHandle;  // XDP map handle.
 } QUIC_XDP_MAP_CONFIG;
 
+//
+// Application provided congestion control algorithm.
+// Passed via SetParam (QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER) after
+// MsQuicOpenVersion but before opening any registrations. Connections use it
+// by setting QUIC_SETTINGS.CongestionControlAlgorithm to its 'Algorithm'.
+//
+// MsQuic keeps track of bytes in flight, exemptions (probe packets) and the
+// congestion blocked state itself; the provider only owns the window. Each
+// connection gets 'StateSize' bytes of zeroed, pointer aligned state that is
+// passed to every callback. The state is discarded without notification, so
+// it must not own any resources. All callbacks run on the connection's worker
+// and must not block.
+//
+
+#define QUIC_CONGESTION_CONTROL_PROVIDER_MAX_STATE_SIZE 256
+
+typedef struct QUIC_CONGESTION_CONTROL_PATH_INFO {
+    uint64_t SmoothedRtt;                   // Microseconds. Zero until GotFirstRttSample.
+    uint64_t MinRtt;                        // Microseconds. UINT64_MAX until GotFirstRttSample.
+    uint32_t InitialWindowPackets;
+    uint32_t SendIdleTimeoutMs;
+    uint32_t BytesInFlight;
+    uint16_t DatagramPayloadLength;
+    BOOLEAN GotFirstRttSample;
+    BOOLEAN PacingEnabled;
+} QUIC_CONGESTION_CONTROL_PATH_INFO;
+
+typedef struct QUIC_CONGESTION_CONTROL_ACK_EVENT {
+    uint64_t TimeNow;                       // Microseconds
+    uint64_t LargestAck;
+    uint64_t LargestSentPacketNumber;
+    uint64_t NumTotalAckedRetransmittableBytes;
+    uint64_t SmoothedRtt;                   // Microseconds
+    uint64_t MinRtt;                        // Microseconds. Only valid if MinRttValid.
+    uint64_t OneWayDelay;                   // Microseconds
+    uint64_t AdjustedAckTime;               // Microseconds. Ack time minus ack delay.
+    uint32_t NumRetransmittableBytes;
+    BOOLEAN IsImplicit;
+    BOOLEAN HasLoss;
+    BOOLEAN IsLargestAckedPacketAppLimited;
+    BOOLEAN MinRttValid;
+} QUIC_CONGESTION_CONTROL_ACK_EVENT;
+
+typedef struct QUIC_CONGESTION_CONTROL_LOSS_EVENT {
+    uint64_t LargestPacketNumberLost;
+    uint64_t LargestSentPacketNumber;
+    uint32_t NumRetransmittableBytes;
+    BOOLEAN PersistentCongestion;
+} QUIC_CONGESTION_CONTROL_LOSS_EVENT;
+
+typedef struct QUIC_CONGESTION_CONTROL_ECN_EVENT {
+    uint64_t LargestPacketNumberAcked;
+    uint64_t LargestSentPacketNumber;
+    uint32_t NumCePackets;                  // Packets newly reported as CE marked.
+} QUIC_CONGESTION_CONTROL_ECN_EVENT;
+
+//
+// Called with zeroed state to initialize it, both when the connection starts
+// and whenever it resets congestion control (e.g. on a path change).
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CONGESTION_CONTROL_INITIALIZE_FN)(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path
+    );
+
+//
+// Returns the current congestion window, in bytes.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CONGESTION_CONTROL_GET_WINDOW_FN)(
+    _In_ const void* State
+    );
+
+//
+// Optional. Returns the number of bytes that may be sent now, to implement
+// pacing. Defaults to the unused part of the congestion window.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CONGESTION_CONTROL_GET_SEND_ALLOWANCE_FN)(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path,
+    _In_ uint64_t TimeSinceLastSend, // Microseconds
+    _In_ BOOLEAN TimeSinceLastSendValid
+    );
+
+//
+// Optional. Called after retransmittable bytes are sent.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CONGESTION_CONTROL_ON_DATA_SENT_FN)(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path,
+    _In_ uint32_t NumRetransmittableBytes
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CONGESTION_CONTROL_ON_DATA_ACKNOWLEDGED_FN)(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path,
+    _In_ const QUIC_CONGESTION_CONTROL_ACK_EVENT* AckEvent
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CONGESTION_CONTROL_ON_DATA_LOST_FN)(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path,
+    _In_ const QUIC_CONGESTION_CONTROL_LOSS_EVENT* LossEvent
+    );
+
+//
+// Optional. Called when the peer reports new ECN congestion experienced marks.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CONGESTION_CONTROL_ON_ECN_FN)(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path,
+    _In_ const QUIC_CONGESTION_CONTROL_ECN_EVENT* EcnEvent
+    );
+
+//
+// Optional. Called when a previously reported loss turned out to be spurious.
+// Returns TRUE if the congestion window was restored.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+(QUIC_API * QUIC_CONGESTION_CONTROL_ON_SPURIOUS_CONGESTION_FN)(
+    _Inout_ void* State,
+    _In_ const QUIC_CONGESTION_CONTROL_PATH_INFO* Path
+    );
+
+typedef struct QUIC_CONGESTION_CONTROL_PROVIDER {
+    uint16_t Algorithm;         // QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START + [0, QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_COUNT)
+    uint16_t StateSize;         // At most QUIC_CONGESTION_CONTROL_PROVIDER_MAX_STATE_SIZE
+    const char* Name;           // Must remain valid until MsQuicClose
+    QUIC_CONGESTION_CONTROL_INITIALIZE_FN Initialize;
+    QUIC_CONGESTION_CONTROL_GET_WINDOW_FN GetCongestionWindow;
+    QUIC_CONGESTION_CONTROL_GET_SEND_ALLOWANCE_FN GetSendAllowance;                 // Optional
+    QUIC_CONGESTION_CONTROL_ON_DATA_SENT_FN OnDataSent;                             // Optional
+    QUIC_CONGESTION_CONTROL_ON_DATA_ACKNOWLEDGED_FN OnDataAcknowledged;
+    QUIC_CONGESTION_CONTROL_ON_DATA_LOST_FN OnDataLost;
+    QUIC_CONGESTION_CONTROL_ON_ECN_FN OnEcn;                                        // Optional
+    QUIC_CONGESTION_CONTROL_ON_SPURIOUS_CONGESTION_FN OnSpuriousCongestionEvent;    // Optional
+} QUIC_CONGESTION_CONTROL_PROVIDER;
+
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 typedef struct QUIC_REGISTRATION_CONFIG { // All fields may be NULL/zero.
@@ -528,10 +700,21 @@ typedef enum QUIC_CONGESTION_CONTROL_ALGORITHM {
     QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC,
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
     QUIC_CONGESTION_CONTROL_ALGORITHM_BBR,
+    QUIC_CONGESTION_CONTROL_ALGORITHM_DCTCP,
+    QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3,
 #endif
     QUIC_CONGESTION_CONTROL_ALGORITHM_MAX,
 } QUIC_CONGESTION_CONTROL_ALGORITHM;
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+//
+// Range of algorithm identifiers reserved for application registered
+// congestion control providers (QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER).
+//
+#define QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_START  0x0100
+#define QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_COUNT  8
+#endif
+
 //
 // All the available information describing a handshake.
 //
@@ -735,6 +918,14 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
     QUIC_PERF_COUNTER_ENCRYPT_DURATION_US,  // Total time spent on encryption in microseconds.
     QUIC_PERF_COUNTER_DECRYPT_DURATION_US,  // Total time spent on decryption in microseconds.
+    QUIC_PERF_COUNTER_CC_CACHE_HIT,         // Total connections seeded from the congestion state cache.
+    QUIC_PERF_COUNTER_CC_CACHE_MISS,        // Total congestion state cache lookups without a usable entry.
+    QUIC_PERF_COUNTER_ACK_FRAMES_SENT,      // Total ACK frames sent.
+    QUIC_PERF_COUNTER_ACK_FRAMES_RECV,      // Total ACK frames received.
+    QUIC_PERF_COUNTER_CONN_REBALANCED,      // Total connections moved to a less loaded worker.
+    QUIC_PERF_COUNTER_TICKET_CACHE_HIT,     // Total client connections resumed from the ticket cache.
+    QUIC_PERF_COUNTER_TICKET_CACHE_MISS,    // Total ticket cache lookups without a usable ticket.
+    QUIC_PERF_COUNTER_TICKET_CACHE_EVICT,   // Total tickets dropped from the ticket cache unused.
 #endif
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
@@ -819,7 +1010,13 @@ typedef struct QUIC_SETTINGS {
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
             uint64_t ReservedRioEnabled                     : 1;
-            uint64_t RESERVED                               : 18;
+            uint64_t CarefulResumeEnabled                   : 1;
+            uint64_t AdaptiveAckFrequencyEnabled            : 1;
+            uint64_t WorkerRebalancingEnabled               : 1;
+            uint64_t OpenAddressingLookupEnabled            : 1;
+            uint64_t ResumptionTicketCacheEnabled           : 1;
+            uint64_t StatelessResetSipHashEnabled           : 1;
+            uint64_t RESERVED                               : 12;
 #else
             uint64_t RESERVED                               : 26;
 #endif
@@ -873,7 +1070,13 @@ typedef struct QUIC_SETTINGS {
             uint64_t XdpEnabled                : 1;
             uint64_t QTIPEnabled               : 1;
             uint64_t ReservedRioEnabled        : 1;
-            uint64_t ReservedFlags             : 55;
+            uint64_t CarefulResumeEnabled      : 1;
+            uint64_t AdaptiveAckFrequencyEnabled : 1;
+            uint64_t WorkerRebalancingEnabled  : 1;
+            uint64_t OpenAddressingLookupEnabled : 1;
+            uint64_t ResumptionTicketCacheEnabled : 1;
+            uint64_t StatelessResetSipHashEnabled : 1;
+            uint64_t ReservedFlags             : 49;
 #else
             uint64_t ReservedFlags             : 63;
 #endif
@@ -1008,6 +1211,7 @@ void
 #define QUIC_PARAM_GLOBAL_STATELESS_RETRY_CONFIG        0x0100000D  // QUIC_STATELESS_RETRY_CONFIG
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_GLOBAL_XDP_MAP_CONFIG                0x0100000E  // QUIC_XDP_MAP_CONFIG[]
+#define QUIC_PARAM_GLOBAL_CONGESTION_CONTROL_PROVIDER   0x0100000F  // QUIC_CONGESTION_CONTROL_PROVIDER
 #endif
 
 //
@@ -738,6 +738,11 @@ public:
     MsQuicSettings& SetOneWayDelayEnabled(bool value) { OneWayDelayEnabled = value; IsSet.OneWayDelayEnabled = TRUE; return *this; }
     MsQuicSettings& SetNetStatsEventEnabled(bool value) { NetStatsEventEnabled = value; IsSet.NetStatsEventEnabled = TRUE; return *this; }
     MsQuicSettings& SetStreamMultiReceiveEnabled(bool value) { StreamMultiReceiveEnabled = value; IsSet.StreamMultiReceiveEnabled = TRUE; return *this; }
+    MsQuicSettings& SetAdaptiveAckFrequencyEnabled(bool value) { AdaptiveAckFrequencyEnabled = value; IsSet.AdaptiveAckFrequencyEnabled = TRUE; return *this; }
+    MsQuicSettings& SetWorkerRebalancingEnabled(bool value) { WorkerRebalancingEnabled = value; IsSet.WorkerRebalancingEnabled = TRUE; return *this; }
+    MsQuicSettings& SetOpenAddressingLookupEnabled(bool value) { OpenAddressingLookupEnabled = value; IsSet.OpenAddressingLookupEnabled = TRUE; return *this; }
+    MsQuicSettings& SetResumptionTicketCacheEnabled(bool value) { ResumptionTicketCacheEnabled = value; IsSet.ResumptionTicketCacheEnabled = TRUE; return *this; }
+    MsQuicSettings& SetStatelessResetSipHashEnabled(bool value) { StatelessResetSipHashEnabled = value; IsSet.StatelessResetSipHashEnabled = TRUE; return *this; }
 #endif
 
     QUIC_STATUS
@@ -202,6 +202,14 @@ DumpMsQuicPerfCounters(
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
     printf("  ENCRYPT_DURATION_US:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_ENCRYPT_DURATION_US]);
     printf("  DECRYPT_DURATION_US:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_DECRYPT_DURATION_US]);
+    printf("  CC_CACHE_HIT:          %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CC_CACHE_HIT]);
+    printf("  CC_CACHE_MISS:         %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CC_CACHE_MISS]);
+    printf("  ACK_FRAMES_SENT:       %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_ACK_FRAMES_SENT]);
+    printf("  ACK_FRAMES_RECV:       %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_ACK_FRAMES_RECV]);
+    printf("  CONN_REBALANCED:       %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_REBALANCED]);
+    printf("  TICKET_CACHE_HIT:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_TICKET_CACHE_HIT]);
+    printf("  TICKET_CACHE_MISS:     %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_TICKET_CACHE_MISS]);
+    printf("  TICKET_CACHE_EVICT:    %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_TICKET_CACHE_EVICT]);
 #endif
 }
 
@@ -126,6 +126,22 @@ typedef struct QUIC_PRIVATE_TRANSPORT_PARAMETER {
 //
 #define QUIC_PARAM_GLOBAL_DATAPATH_DSCP_RECV_ENABLED    0x81000007 // BOOLEAN
 
+//
+// Sets whether the datapath will use zero-copy sends (io_uring SENDMSG_ZC from
+// a registered send buffer region) where supported. Zero-copy avoids the
+// kernel copy of large (GSO) sends at the cost of pinning the send buffers
+// until the kernel signals it is done with them.
+//
+#define QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_ENABLED 0x81000008 // BOOLEAN
+
+//
+// Sets the minimum size (in bytes) of a send, including all its GSO segments,
+// for the datapath to send it with zero-copy. Smaller sends are copied, as
+// pinning the buffer and handling the kernel's notification costs more than
+// the copy. Defaults to 10240 bytes.
+//
+#define QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_THRESHOLD 0x81000009 // uint32_t
+
 //
 // The different private parameters for Configuration.
 //
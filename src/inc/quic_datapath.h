@@ -481,6 +481,18 @@ typedef struct CXPLAT_DATAPATH_INIT_CONFIG {
     //
     BOOLEAN EnableDscpOnRecv;
 
+    //
+    // Whether the datapath should send from registered buffers with zero-copy
+    // sends, if the platform supports it.
+    //
+    BOOLEAN EnableSendZeroCopy;
+
+    //
+    // The minimum size (in bytes) of a send for it to be sent with zero-copy.
+    // Only used if EnableSendZeroCopy is set.
+    //
+    uint32_t SendZeroCopyThreshold;
+
     _Field_size_(XdpMapConfigCount)
     const CXPLAT_XDP_MAP_CONFIG* XdpMapConfigs;
     uint32_t XdpMapConfigCount;
@@ -988,6 +1000,78 @@ CxPlatDataPathRssConfigFree(
     _In_ CXPLAT_RSS_CONFIG* RssConfig
     );
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+
+//
+// Simulated datapath.
+//
+// Every socket is bound in a process-wide port space and datagrams are
+// delivered in-process. Each sending socket has its own egress link, modeled
+// as a drop-tail bottleneck queue followed by a propagation delay. Time is
+// virtual: CxPlatTimeUs64 returns the simulated clock, which only advances
+// when every platform worker has run out of ready work, and then jumps to the
+// next deadline.
+//
+
+typedef struct CXPLAT_SIM_NETWORK_CONFIG {
+    uint64_t BottleneckBitsPerSecond;   // 0 for unlimited.
+    uint32_t DelayUs;                   // One-way propagation delay.
+    uint32_t JitterUs;                  // Uniform, additional delay.
+    uint32_t QueueDepth;                // In packets; 0 for unlimited.
+    uint32_t EcnMarkThreshold;          // In queued packets; 0 disables CE marking.
+    uint32_t RandomLossDenominator;     // Drops 1 / N packets; 0 for no loss.
+    uint32_t RandomReorderDenominator;  // Delays 1 / N packets; 0 for no reordering.
+    uint32_t ReorderDelayDeltaUs;       // Extra delay of reordered packets.
+    uint64_t RandomSeed;
+} CXPLAT_SIM_NETWORK_CONFIG;
+
+#define CXPLAT_SIM_MAX_QUEUE_DEPTH 4096
+
+typedef struct CXPLAT_SIM_NETWORK_STATISTICS {
+    uint64_t PacketsSent;
+    uint64_t PacketsDelivered;
+    uint64_t PacketsLost;           // Random loss.
+    uint64_t PacketsQueueDropped;   // Bottleneck queue overflow.
+    uint64_t PacketsUnreachable;    // No socket bound to the destination port.
+    uint64_t PacketsReordered;
+    uint64_t PacketsEcnMarked;
+} CXPLAT_SIM_NETWORK_STATISTICS;
+
+//
+// Sets the link configuration used by all sockets. Applies to the sends that
+// follow; datagrams already in flight keep their delivery times.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSimNetworkConfigure(
+    _In_ const CXPLAT_SIM_NETWORK_CONFIG* Config
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatSimNetworkGetStatistics(
+    _Out_ CXPLAT_SIM_NETWORK_STATISTICS* Statistics
+    );
+
+//
+// Keeps the virtual clock from advancing while held. Application threads use
+// this around multi-step setup, as the clock may otherwise jump ahead (e.g.
+// to an idle timeout) while the workers wait for the application.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatSimClockHold(
+    void
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatSimClockRelease(
+    void
+    );
+
+#endif // CXPLAT_USE_SIM_DATAPATH
+
 #if defined(__cplusplus)
 }
 #endif
@@ -162,6 +162,13 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_TLS_AUX_DATA              '05cQ' // Qc50 - QUIC TLS Backing Aux data
 #define QUIC_POOL_TLS_RECORD_ENTRY          '15cQ' // Qc51 - QUIC TLS Backing Record storage
 #define QUIC_POOL_XDP_MAP_CONFIG            '25cQ' // Qc52 - QUIC XDP Map Config
+#define QUIC_POOL_SENT_PACKET_RING          '35cQ' // Qc53 - QUIC Sent Packet Ring
+#define QUIC_POOL_SEND_PRIORITY_BUCKETS     '45cQ' // Qc54 - QUIC Send Priority Buckets
+#define QUIC_POOL_CAREFUL_RESUME_ENTRY      '55cQ' // Qc55 - QUIC Careful Resume Cache Entry
+#define QUIC_POOL_LOOKUP_BUCKETS            '65cQ' // Qc56 - QUIC Lookup Hash Buckets
+#define QUIC_POOL_LOOKUP_READERS            '75cQ' // Qc57 - QUIC Lookup Reader Epochs
+#define QUIC_POOL_TLS_SESSION               '85cQ' // Qc58 - QUIC Platform TLS serialized session
+#define QUIC_POOL_TICKET_CACHE              '95cQ' // Qc59 - QUIC Resumption Ticket Cache
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
@@ -509,6 +516,7 @@ typedef enum CXPLAT_WORKER_POOL_REF {
     CXPLAT_WORKER_POOL_REF_KQUEUE,
     CXPLAT_WORKER_POOL_REF_RAW,
     CXPLAT_WORKER_POOL_REF_WINSOCK,
+    CXPLAT_WORKER_POOL_REF_SIM,
     CXPLAT_WORKER_POOL_REF_TOOL,
 
     CXPLAT_WORKER_POOL_REF_COUNT
@@ -540,6 +548,15 @@ CxPlatWorkerPoolGetCount(
     _In_ CXPLAT_WORKER_POOL* WorkerPool
     );
 
+//
+// Returns the time (in us) the kernel should busy poll for the worker pool's
+// sockets, or 0 if busy polling is not enabled.
+//
+uint32_t
+CxPlatWorkerPoolGetBusyPollUs(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool
+    );
+
 BOOLEAN
 CxPlatWorkerPoolAddRef(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
@@ -246,6 +246,17 @@ InterlockedExchangePointer(
     return __sync_lock_test_and_set(Target, Value);
 }
 
+QUIC_INLINE
+void*
+InterlockedCompareExchangePointer(
+    _Inout_ _Interlocked_operand_ void* volatile *Destination,
+    _In_opt_ void* ExChange,
+    _In_opt_ void* Comperand
+    )
+{
+    return __sync_val_compare_and_swap(Destination, Comperand, ExChange);
+}
+
 QUIC_INLINE
 void*
 InterlockedFetchAndClearPointer(
@@ -295,6 +306,20 @@ InterlockedDecrement64(
 
 #define QuicReadLongPtrNoFence(p) __atomic_load_n((p), __ATOMIC_RELAXED)
 
+#define QuicReadPtrAcquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+
+#define QuicWritePtrRelease(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#define QuicReadLongAcquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+
+#define QuicReadUShortAcquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+
+#define QuicWriteUShortRelease(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#define QuicReadLong64Acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+
+#define QuicWriteLong64Release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
 //
 // Assertion interfaces.
 //
@@ -1048,6 +1073,12 @@ Exit:
 
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
+#include <sys/ioctl.h>
+
+//
+// Lets the kernel run a busy poll thread on any processor.
+//
+#define CXPLAT_POLL_PROCESSOR_ANY UINT16_MAX
 
 #if CXPLAT_USE_IO_URING // liburing
 #define LIBURING_INTERNAL
@@ -1105,7 +1136,8 @@ typedef struct CXPLAT_SQE {
 
 typedef enum CXPLAT_IO_RING_BUF_GROUP {
     CxPlatIoRingBufGroupSend,
-    CxPlatIoRingBufGroupRecv,
+    CxPlatIoRingBufGroupRecv,           // MTU sized receive buffers
+    CxPlatIoRingBufGroupRecvCoalesced,  // GRO sized receive buffers
 } CXPLAT_IO_RING_BUF_GROUP;
 
 QUIC_INLINE
@@ -1129,6 +1161,43 @@ CxPlatEventQInitialize(
     return 0 == io_uring_queue_init_params(4096, &Queue->Ring, &params); // TODO - make size configurable
 }
 
+//
+// Initializes the event queue with a kernel submission queue polling thread,
+// so submissions don't need a syscall. The polling thread is pinned to
+// PollProcessor (unless CXPLAT_POLL_PROCESSOR_ANY), which should not be the
+// processor of the worker feeding the queue, or the two spin against each
+// other. The kernel only takes the idle time in milliseconds, so it is rounded
+// up to at least 1 ms. Falls back to the default event queue if SQPOLL isn't
+// permitted.
+//
+QUIC_INLINE
+BOOLEAN
+CxPlatEventQInitializeBusyPoll(
+    _Out_ CXPLAT_EVENTQ* Queue,
+    _In_ uint16_t PollProcessor,
+    _In_ uint32_t BusyPollUs
+    )
+{
+    CxPlatZeroMemory(Queue, sizeof(*Queue));
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_SQPOLL
+#ifdef IORING_SETUP_SUBMIT_ALL
+        | IORING_SETUP_SUBMIT_ALL
+#endif
+        ; // COOP_TASKRUN is not allowed with SQPOLL.
+    if (PollProcessor != CXPLAT_POLL_PROCESSOR_ANY) {
+        params.flags |= IORING_SETUP_SQ_AFF;
+        params.sq_thread_cpu = PollProcessor;
+    }
+    params.sq_thread_idle = CXPLAT_MAX(1, (BusyPollUs + 999) / 1000); // 0 would be the ~1 s kernel default.
+    if (0 == io_uring_queue_init_params(4096, &Queue->Ring, &params)) {
+        CxPlatLockInitialize(&Queue->Lock);
+        return TRUE;
+    }
+    return CxPlatEventQInitialize(Queue);
+}
+
 QUIC_INLINE
 void
 CxPlatEventQCleanup(
@@ -1366,6 +1435,36 @@ CxPlatEventQInitialize(
     return (*queue = epoll_create1(EPOLL_CLOEXEC)) != -1;
 }
 
+//
+// Initializes the event queue with busy polling of the NAPI contexts of the
+// sockets added to it, if the kernel supports per-epoll busy poll parameters.
+// Otherwise, busy polling follows the net.core.busy_poll sysctl.
+//
+QUIC_INLINE
+BOOLEAN
+CxPlatEventQInitializeBusyPoll(
+    _Out_ CXPLAT_EVENTQ* queue,
+    _In_ uint16_t PollProcessor,
+    _In_ uint32_t BusyPollUs
+    )
+{
+    UNREFERENCED_PARAMETER(PollProcessor);
+    if (!CxPlatEventQInitialize(queue)) {
+        return FALSE;
+    }
+#ifdef EPIOCSPARAMS
+    struct epoll_params params;
+    memset(&params, 0, sizeof(params));
+    params.busy_poll_usecs = BusyPollUs;
+    params.busy_poll_budget = 8;
+    params.prefer_busy_poll = 1;
+    (void)ioctl(*queue, EPIOCSPARAMS, &params); // Best effort
+#else
+    UNREFERENCED_PARAMETER(BusyPollUs);
+#endif
+    return TRUE;
+}
+
 QUIC_INLINE
 void
 CxPlatEventQCleanup(
@@ -408,6 +408,13 @@ typedef EX_SPIN_LOCK CXPLAT_DISPATCH_RW_LOCK;
 #define QuicReadLongPtrNoFence ReadNoFence
 #endif
 #define QuicReadPtrNoFence ReadPointerNoFence
+#define QuicReadPtrAcquire ReadPointerAcquire
+#define QuicWritePtrRelease WritePointerRelease
+#define QuicReadLongAcquire ReadAcquire
+#define QuicReadUShortAcquire ReadUShortAcquire
+#define QuicWriteUShortRelease WriteUShortRelease
+#define QuicReadLong64Acquire ReadAcquire64
+#define QuicWriteLong64Release WriteRelease64
 
 typedef LONG_PTR CXPLAT_REF_COUNT;
 
@@ -616,8 +616,22 @@ typedef SRWLOCK CXPLAT_DISPATCH_RW_LOCK;
 
 #ifdef QUIC_RESTRICTED_BUILD
 #define QuicReadPtrNoFence(p) ((void*)(*p))
+#define QuicReadPtrAcquire(p) ((void*)(*(void* const volatile*)(p)))
+#define QuicWritePtrRelease(p, v) (*(void* volatile*)(p) = (v))
+#define QuicReadLongAcquire(p) (*(LONG const volatile*)(p))
+#define QuicReadUShortAcquire(p) (*(USHORT const volatile*)(p))
+#define QuicWriteUShortRelease(p, v) (*(USHORT volatile*)(p) = (v))
+#define QuicReadLong64Acquire(p) (*(LONG64 const volatile*)(p))
+#define QuicWriteLong64Release(p, v) (*(LONG64 volatile*)(p) = (v))
 #else
 #define QuicReadPtrNoFence ReadPointerNoFence
+#define QuicReadPtrAcquire ReadPointerAcquire
+#define QuicWritePtrRelease WritePointerRelease
+#define QuicReadLongAcquire ReadAcquire
+#define QuicReadUShortAcquire ReadUShortAcquire
+#define QuicWriteUShortRelease WriteUShortRelease
+#define QuicReadLong64Acquire ReadAcquire64
+#define QuicWriteLong64Release WriteRelease64
 #endif
 
 typedef LONG_PTR CXPLAT_REF_COUNT;
@@ -87,9 +87,27 @@ BOOLEAN
 
 typedef CXPLAT_TLS_RECEIVE_TP_CALLBACK *CXPLAT_TLS_RECEIVE_TP_CALLBACK_HANDLER;
 
+//
+// What the server said about a resumption ticket it sent the client.
+//
+typedef struct CXPLAT_TLS_TICKET_INFO {
+
+    //
+    // Seconds the ticket may be used for, or zero if unknown.
+    //
+    uint32_t Lifetime;
+
+    //
+    // The ticket may be used to send 0-RTT data.
+    //
+    BOOLEAN EarlyDataAllowed;
+
+} CXPLAT_TLS_TICKET_INFO;
+
 //
 // Callback for indicating received resumption ticket. Callback always happens
 // in the context of a QuicTlsProcessData call; not on a separate thread.
+// TicketInfo is only passed to clients, and only if the TLS provider knows it.
 //
 typedef
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -97,7 +115,8 @@ BOOLEAN
 (CXPLAT_TLS_RECEIVE_TICKET_CALLBACK)(
     _In_ QUIC_CONNECTION* Connection,
     _In_ uint32_t TicketLength,
-    _In_reads_(TicketLength) const uint8_t* Ticket
+    _In_reads_(TicketLength) const uint8_t* Ticket,
+    _In_opt_ const CXPLAT_TLS_TICKET_INFO* TicketInfo
     );
 
 typedef CXPLAT_TLS_RECEIVE_TICKET_CALLBACK *CXPLAT_TLS_RECEIVE_TICKET_CALLBACK_HANDLER;
@@ -54,6 +54,21 @@ PerfClient::Init(
             RunTime = S_TO_US(20); // 20 seconds
             RepeatStreams = TRUE;
             PrintLatency = TRUE;
+        } else if (IsValue(ScenarioStr, "rps-streams")) {
+            Upload = 512;
+            Download = 16000;
+            StreamCount = 5000;
+            RunTime = S_TO_US(20); // 20 seconds
+            RepeatStreams = TRUE;
+            PrintLatency = TRUE;
+        } else if (IsValue(ScenarioStr, "rps-mixed")) {
+            Upload = 512;
+            Download = 4000;
+            MixedDownload = 1000000;
+            StreamCount = 100;
+            RunTime = S_TO_US(20); // 20 seconds
+            RepeatStreams = TRUE;
+            PrintLatency = TRUE;
         } else if (IsValue(ScenarioStr, "rps")) {
             Upload = 512;
             Download = 4000;
@@ -181,6 +196,8 @@ PerfClient::Init(
     if (TryGetVariableUnitValue(argc, argv, DownloadVarNames, &Download, &IsTimeUnit)) {
         Timed = IsTimeUnit ? 1 : 0;
     }
+    TryGetVariableUnitValue(argc, argv, "mixdown", &MixedDownload);
+    TryGetValue(argc, argv, "mixevery", &MixedInterval);
     const char* RunVarNames[] = {"runtime", "time", "run", nullptr};
     TryGetVariableUnitValue(argc, argv, RunVarNames, &RunTime, &IsTimeUnit);
     //TryGetValue(argc, argv, "inline", &SendInline);
@@ -205,6 +222,11 @@ PerfClient::Init(
         }
     }
 
+    if (MixedDownload && (Timed || !MixedInterval)) {
+        WriteOutput("'mixdown' requires length units and a non-zero 'mixevery'!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
     if ((Upload || Download) && !StreamCount) {
         StreamCount = 1; // Just up/down args imply they want a stream
     }
@@ -259,6 +281,9 @@ PerfClient::Init(
     }
 
     RequestBuffer.Init(IoSize, Timed ? UINT64_MAX : Download);
+    if (MixedDownload) {
+        MixedRequestBuffer.Init(IoSize, MixedDownload);
+    }
     if (PrintLatency) {
         if (RunTime) {
             MaxLatencyIndex = ((uint64_t)RunTime / (1000 * 1000)) * PERF_MAX_REQUESTS_PER_SECOND;
@@ -552,6 +577,20 @@ PerfClientConnection::Initialize() {
             }
         }
 
+        if (PerfDefaultStreamSchedulingScheme != QUIC_STREAM_SCHEDULING_SCHEME_FIFO) {
+            Status =
+                MsQuic->SetParam(
+                    Handle,
+                    QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                    sizeof(PerfDefaultStreamSchedulingScheme),
+                    &PerfDefaultStreamSchedulingScheme);
+            if (QUIC_FAILED(Status)) {
+                WriteOutput("SetStreamSchedulingScheme failed, 0x%x\n", Status);
+                Worker.ConnectionPool.Free(this);
+                return;
+            }
+        }
+
         if (Client.CibirIdLength) {
             Status =
                 MsQuic->SetParam(
@@ -695,6 +734,7 @@ PerfClientConnection::StartNewStream() {
     }
 
     InterlockedIncrement64((int64_t*)&Worker.StreamsStarted);
+    Stream->Mixed = Client.MixedDownload && (StreamsCreated % Client.MixedInterval) == 0;
     Stream->Send();
 }
 
@@ -865,7 +905,7 @@ PerfClientStream::Send() {
                 UINT64_MAX : // Timed sends forever
                 (Client.Upload ? (Client.Upload - BytesSent) : sizeof(uint64_t));
         uint32_t DataLength = Client.IoSize;
-        QUIC_BUFFER* Buffer = Client.RequestBuffer;
+        QUIC_BUFFER* Buffer = Mixed ? Client.MixedRequestBuffer : Client.RequestBuffer;
         QUIC_SEND_FLAGS Flags = QUIC_SEND_FLAG_START;
 
         if ((uint64_t)DataLength >= BytesLeftToSend) {
@@ -1000,7 +1040,8 @@ PerfClientStream::OnShutdown() {
     auto RecvSuccess = RecvStartTime != 0 && RecvEndTime != 0;
     if (Client.Download) {
         const auto TotalBytes = BytesReceived;
-        if (TotalBytes == 0 || (!Client.Timed && TotalBytes < Client.Download)) {
+        if (TotalBytes == 0 ||
+            (!Client.Timed && TotalBytes < (Mixed ? Client.MixedDownload : Client.Download))) {
             RecvSuccess = false;
         }
 
@@ -1023,7 +1064,7 @@ PerfClientStream::OnShutdown() {
     }
 
     if (SendSuccess && RecvSuccess) {
-        if (Client.Running) {
+        if (Client.Running && !Mixed) { // Only track latency for the regular streams
             const auto Index = (uint64_t)InterlockedIncrement64((int64_t*)&Connection.Client.CurLatencyIndex) - 1;
             if (Index < Client.MaxLatencyIndex) {
                 const auto Latency = CxPlatTimeDiff64(StartTime, RecvEndTime);
@@ -70,6 +70,7 @@ struct PerfClientStream {
     uint64_t BytesOutstanding {0};
     uint64_t BytesAcked {0};
     uint64_t BytesReceived {0};
+    bool Mixed {false}; // Uses the mixed in response length
     bool SendComplete {false};
     QUIC_BUFFER LastBuffer;
     QUIC_STATUS QuicStreamCallback(_Inout_ QUIC_STREAM_EVENT* Event);
@@ -171,7 +172,8 @@ struct PerfClient {
             .SetSendBufferingEnabled(false)
             .SetCongestionControlAlgorithm(PerfDefaultCongestionControl)
             .SetEcnEnabled(PerfDefaultEcnEnabled)
-            .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed),
+            .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed)
+            .SetAdaptiveAckFrequencyEnabled(PerfDefaultAckFrequencyEnabled),
         CredentialConfig};
     // Target parameters
     UniquePtr<char[]> Target;
@@ -204,6 +206,8 @@ struct PerfClient {
     uint32_t IoSize {PERF_DEFAULT_IO_SIZE};
     uint64_t Upload {0};
     uint64_t Download {0};
+    uint64_t MixedDownload {0};
+    uint32_t MixedInterval {10};
     uint8_t Timed {FALSE};
     //uint8_t SendInline {FALSE};
     uint8_t RepeatConnections {FALSE};
@@ -223,7 +227,7 @@ struct PerfClient {
                 Buffer->Buffer[i] = (uint8_t)i;
             }
         }
-    } RequestBuffer;
+    } RequestBuffer, MixedRequestBuffer;
 
     uint64_t GetConnectedConnections() const {
         uint64_t ConnectedConnections = 0;
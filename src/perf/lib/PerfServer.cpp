@@ -30,6 +30,7 @@ PerfServer::Init(
     }
 
     TryGetValue(argc, argv, "stats", &PrintStats);
+    TryGetVariableUnitValue(argc, argv, "bulk", &BulkResponseSize, nullptr);
 
     const char* LocalAddress = nullptr;
     uint16_t Port = 0;
@@ -199,6 +200,13 @@ PerfServer::ListenerCallback(
                 sizeof(PerfDefaultDscpValue),
                 &PerfDefaultDscpValue);
         }
+        if (PerfDefaultStreamSchedulingScheme != QUIC_STREAM_SCHEDULING_SCHEME_FIFO) {
+            MsQuic->SetParam(
+                Event->NEW_CONNECTION.Connection,
+                QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                sizeof(PerfDefaultStreamSchedulingScheme),
+                &PerfDefaultStreamSchedulingScheme);
+        }
         QUIC_CONNECTION_CALLBACK_HANDLER Handler =
             [](HQUIC Conn, void* Context, QUIC_CONNECTION_EVENT* Event) -> QUIC_STATUS {
                 return ((PerfServer*)Context)->ConnectionCallback(Conn, Event);
@@ -330,6 +338,18 @@ PerfServer::StreamCallback(
             if (Offset == sizeof(uint64_t)) {
                 Context->ResponseSize = CxPlatByteSwapUint64(Context->ResponseSize);
                 Context->ResponseSizeSet = true;
+                if (BulkResponseSize != 0 && Context->ResponseSize >= BulkResponseSize) {
+                    //
+                    // Send large responses behind the others: at a low
+                    // urgency and incrementally for the extensible priority
+                    // scheme, and at a quarter of the default priority (or
+                    // weight) otherwise.
+                    //
+                    uint16_t Priority =
+                        PerfDefaultStreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY ?
+                            QUIC_STREAM_PRIORITY_FROM_URGENCY(5, TRUE) : 0x1FFF;
+                    MsQuic->SetParam(StreamHandle, QUIC_PARAM_STREAM_PRIORITY, sizeof(Priority), &Priority);
+                }
             }
         }
         break;
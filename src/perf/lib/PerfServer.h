@@ -183,11 +183,13 @@ private:
             .SetCongestionControlAlgorithm(PerfDefaultCongestionControl)
             .SetEcnEnabled(PerfDefaultEcnEnabled)
             .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed)
+            .SetAdaptiveAckFrequencyEnabled(PerfDefaultAckFrequencyEnabled)
             .SetOneWayDelayEnabled(true)};
     MsQuicListener Listener {Registration, CleanUpManual, ListenerCallbackStatic, this};
     QUIC_ADDR LocalAddr;
     CXPLAT_EVENT* StopEvent {nullptr};
     uint8_t PrintStats {FALSE};
+    uint64_t BulkResponseSize {0};
 
     TcpEngine Engine;
     TcpConfiguration TcpConfig;
@@ -52,9 +52,11 @@ extern TCP_EXECUTION_PROFILE TcpDefaultExecutionProfile;
 extern QUIC_CONGESTION_CONTROL_ALGORITHM PerfDefaultCongestionControl;
 extern uint8_t PerfDefaultEcnEnabled;
 extern uint8_t PerfDefaultQeoAllowed;
+extern uint8_t PerfDefaultAckFrequencyEnabled;
 extern uint8_t PerfDefaultHighPriority;
 extern uint8_t PerfDefaultAffinitizeThreads;
 extern uint8_t PerfDefaultDscpValue;
+extern QUIC_STREAM_SCHEDULING_SCHEME PerfDefaultStreamSchedulingScheme;
 
 extern CXPLAT_DATAPATH* Datapath;
 
@@ -27,9 +27,11 @@ TCP_EXECUTION_PROFILE TcpDefaultExecutionProfile = TCP_EXECUTION_PROFILE_LOW_LAT
 QUIC_CONGESTION_CONTROL_ALGORITHM PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
 uint8_t PerfDefaultEcnEnabled = false;
 uint8_t PerfDefaultQeoAllowed = false;
+uint8_t PerfDefaultAckFrequencyEnabled = false;
 uint8_t PerfDefaultHighPriority = false;
 uint8_t PerfDefaultAffinitizeThreads = false;
 uint8_t PerfDefaultDscpValue = 0;
+QUIC_STREAM_SCHEDULING_SCHEME PerfDefaultStreamSchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
 
 #ifdef _KERNEL_MODE
 volatile int BufferCurrent;
@@ -80,6 +82,7 @@ PrintHelp(
         "  -port:<####>             The UDP port of the server. Ignored if \"bind\" is passed. (def:%u)\n"
         "  -serverid:<####>         The ID of the server (used for load balancing).\n"
         "  -cibir:<hex_bytes>       A CIBIR well-known idenfitier.\n"
+        "  -bulk:<####>[unit]       Responses at least this long are sent at a lower priority. (def:0)\n"
         "  -delay:<####>[unit]      Delay, with an optional unit (def unit is us), to be introduced before the server responds to a request.\n"
         "  -delayType:<fixed/variable>    Optional delay type can be specified in conjunction with the 'delay' argument.\n"
         "                                 'fixed' - introduce the specified delay for each request (default).\n"
@@ -114,11 +117,13 @@ PrintHelp(
         "\n"
         "  Scenario options:\n"
         "  -scenario:<profile>      Scenario profile to use.\n"
-        "                            - {upload, download, hps, rps, rps-multi, latency}.\n"
+        "                            - {upload, download, hps, rps, rps-multi, rps-streams, rps-mixed, latency, latency-busypoll}.\n"
         "  -conns:<####>            The number of connections to use. (def:1)\n"
         "  -streams:<####>          The number of streams to send on at a time. (def:0)\n"
         "  -upload:<####>[unit]     The length of bytes to send on each stream, with an optional (time or length) unit. (def:0)\n"
         "  -download:<####>[unit]   The length of bytes to receive on each stream, with an optional (time or length) unit. (def:0)\n"
+        "  -mixdown:<####>[unit]    The length of bytes to receive on the streams mixed in with the others. (def:0)\n"
+        "  -mixevery:<####>         Use 'mixdown' for one in this many streams. (def:10)\n"
         "  -iosize:<####>           The size of each send request queued.\n"
         //"  -inline:<0/1>            Create new streams on callbacks. (def:0)\n"
         "  -rconn:<0/1>             Repeat the scenario at the connection level. (def:0)\n"
@@ -129,13 +134,20 @@ PrintHelp(
         "  -exec:<profile>          Execution profile to use.\n"
         "                            - {lowlat, maxtput, scavenger, realtime}.\n"
         "  -cc:<algo>               Congestion control algorithm to use.\n"
-        "                            - {cubic, bbr}.\n"
+        "                            - {cubic, bbr, dctcp, bbr3}.\n"
+        "  -sched:<scheme>          Stream scheduling scheme to use.\n"
+        "                            - {fifo, rr, wfq, rfc9218}.\n"
         "  -pollidle:<time_us>      Amount of time to poll while idle before sleeping (default: 0).\n"
+        "  -busypoll:<0/1>          Enables kernel busy polling (epoll) or SQPOLL (iouring). (def:0)\n"
         "  -ecn:<0/1>               Enables/disables sender-side ECN support. (def:0)\n"
         "  -qeo:<0/1>               Allows/disallowes QUIC encryption offload. (def:0)\n"
+        "  -ackfreq:<0/1>           Enables/disables asking the peer for fewer ACKs as the congestion window grows. (def:0)\n"
+        "  -rebalance:<0/1>         Enables/disables moving busy connections off overloaded workers. (def:0)\n"
 #ifndef _KERNEL_MODE
         "  -io:<mode>               Configures a requested network IO model to be used.\n"
         "                            - {iocp, xdp, qtip, epoll, iouring, kqueue}\n"
+        "  -zerocopy:<0/1>          Enables/disables zero-copy sends (iouring only). (def:0)\n"
+        "  -zerocopymin:<bytes>     The minimum size of a zero-copy send. (def:10240)\n"
 #else
         "  -io:<mode>               Configures a requested network IO model to be used.\n"
         "                            - {wsk}\n"
@@ -196,6 +208,45 @@ QuicMainStart(
         Settings.SetGlobal();
     }
 
+    uint8_t Rebalance = false;
+    if (TryGetValue(argc, argv, "rebalance", &Rebalance)) {
+        MsQuicSettings Settings;
+        Settings.SetWorkerRebalancingEnabled(Rebalance != 0);
+        if (QUIC_FAILED(Status = Settings.SetGlobal())) {
+            WriteOutput("Failed to set worker rebalancing %d\n", Status);
+            return Status;
+        }
+    }
+
+    uint8_t ZeroCopy = false;
+    if (TryGetValue(argc, argv, "zerocopy", &ZeroCopy)) {
+        BOOLEAN Value = ZeroCopy ? TRUE : FALSE;
+        if (QUIC_FAILED(
+            Status =
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_ENABLED,
+                sizeof(Value),
+                &Value))) {
+            WriteOutput("Failed to set zero-copy send %d\n", Status);
+            return Status;
+        }
+    }
+
+    uint32_t ZeroCopyThreshold;
+    if (TryGetValue(argc, argv, "zerocopymin", &ZeroCopyThreshold)) {
+        if (QUIC_FAILED(
+            Status =
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_THRESHOLD,
+                sizeof(ZeroCopyThreshold),
+                &ZeroCopyThreshold))) {
+            WriteOutput("Failed to set zero-copy send threshold %d\n", Status);
+            return Status;
+        }
+    }
+
     const char* CpuStr;
     if ((CpuStr = GetValue(argc, argv, "cpu")) != nullptr) {
         SetConfig = true;
@@ -228,6 +279,17 @@ QuicMainStart(
         SetConfig = true;
     }
 
+    uint8_t BusyPoll = false;
+    const char* BusyPollScenario = GetValue(argc, argv, "scenario");
+    if (BusyPollScenario != nullptr && IsValue(BusyPollScenario, "latency-busypoll")) {
+        BusyPoll = true;
+    }
+    TryGetValue(argc, argv, "busypoll", &BusyPoll);
+    if (BusyPoll) {
+        Config->Flags |= QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_BUSY_POLL;
+        SetConfig = true;
+    }
+
     if (SetConfig &&
         QUIC_FAILED(
         Status =
@@ -250,6 +312,8 @@ QuicMainStart(
         } else if (
             IsValue(ScenarioStr, "rps") ||
             IsValue(ScenarioStr, "rps-multi") ||
+            IsValue(ScenarioStr, "rps-streams") ||
+            IsValue(ScenarioStr, "rps-mixed") ||
             IsValue(ScenarioStr, "latency")) {
             PerfDefaultExecutionProfile = QUIC_EXECUTION_PROFILE_LOW_LATENCY;
             TcpDefaultExecutionProfile = TCP_EXECUTION_PROFILE_LOW_LATENCY;
@@ -281,15 +345,36 @@ QuicMainStart(
     if (CcName != nullptr) {
         if (IsValue(CcName, "cubic")) {
             PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
+        } else if (IsValue(CcName, "bbr3")) { // Before "bbr", which is a prefix of it
+            PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3;
         } else if (IsValue(CcName, "bbr")) {
             PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR;
+        } else if (IsValue(CcName, "dctcp")) {
+            PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_DCTCP;
         } else {
             WriteOutput("Failed to parse congestion control algorithm[%s], use cubic as default\n", CcName);
         }
     }
 
+    const char* SchedName = GetValue(argc, argv, "sched");
+    if (SchedName != nullptr) {
+        if (IsValue(SchedName, "fifo")) {
+            PerfDefaultStreamSchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+        } else if (IsValue(SchedName, "rr")) {
+            PerfDefaultStreamSchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        } else if (IsValue(SchedName, "wfq")) {
+            PerfDefaultStreamSchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR;
+        } else if (IsValue(SchedName, "rfc9218")) {
+            PerfDefaultStreamSchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY;
+        } else {
+            WriteOutput("Failed to parse stream scheduling scheme[%s]!\n", SchedName);
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
     TryGetValue(argc, argv, "ecn", &PerfDefaultEcnEnabled);
     TryGetValue(argc, argv, "qeo", &PerfDefaultQeoAllowed);
+    TryGetValue(argc, argv, "ackfreq", &PerfDefaultAckFrequencyEnabled);
     TryGetValue(argc, argv, "dscp", &PerfDefaultDscpValue);
     if (PerfDefaultDscpValue > CXPLAT_MAX_DSCP) {
         WriteOutput("DSCP Value %u is outside the valid range (0-63). Using 0.\n", PerfDefaultDscpValue);
@@ -477,6 +562,17 @@ TryGetVariableUnitValue<uint32_t>(
     _Out_opt_ bool* isTimed
     );
 
+template
+_Success_(return != false)
+bool
+TryGetVariableUnitValue<uint64_t>(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_z_ const char* name,
+    _Out_ uint64_t * pValue,
+    _Out_opt_ bool* isTimed
+    );
+
 template
 _Success_(return != false)
 bool
@@ -599,7 +599,8 @@ BOOLEAN
 TcpConnection::TlsReceiveTicketCallback(
     _In_ QUIC_CONNECTION* /* Context */,
     _In_ uint32_t TicketLength,
-    _In_reads_(TicketLength) const uint8_t* /* Ticket */
+    _In_reads_(TicketLength) const uint8_t* /* Ticket */,
+    _In_opt_ const CXPLAT_TLS_TICKET_INFO* /* TicketInfo */
     )
 {
     UNREFERENCED_PARAMETER(TicketLength);
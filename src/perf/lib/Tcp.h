@@ -277,7 +277,8 @@ class TcpConnection {
     TlsReceiveTicketCallback(
         _In_ QUIC_CONNECTION* Connection,
         _In_ uint32_t TicketLength,
-        _In_reads_(TicketLength) const uint8_t* Ticket
+        _In_reads_(TicketLength) const uint8_t* Ticket,
+        _In_opt_ const CXPLAT_TLS_TICKET_INFO* TicketInfo
         );
     ~TcpConnection();
     bool Queue() { return Worker->QueueConnection(this); }
@@ -171,6 +171,13 @@ CXPLAT_EVENT_COMPLETION CxPlatSocketContextUninitializeEventComplete;
 CXPLAT_EVENT_COMPLETION CxPlatSocketContextFlushTxEventComplete;
 CXPLAT_EVENT_COMPLETION CxPlatSocketContextIoEventComplete;
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDataPathTxBatchExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    );
+
 void
 CxPlatProcessorContextInitialize(
     _In_ CXPLAT_DATAPATH* Datapath,
@@ -185,6 +192,19 @@ CxPlatProcessorContextInitialize(
     CxPlatRefInitialize(&DatapathPartition->RefCount);
     CxPlatPoolInitialize(TRUE, Datapath->RecvBlockSize, QUIC_POOL_DATA, &DatapathPartition->RecvBlockPool);
     CxPlatPoolInitialize(TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool);
+
+    //
+    // The TX batch execution context holds a reference on the partition until
+    // it removes itself from the worker.
+    //
+    CxPlatListInitializeHead(&DatapathPartition->TxBatchSockets);
+    DatapathPartition->TxBatchEc.Ready = FALSE;
+    DatapathPartition->TxBatchEc.NextTimeUs = UINT64_MAX;
+    DatapathPartition->TxBatchEc.Callback = CxPlatDataPathTxBatchExecute;
+    DatapathPartition->TxBatchEc.Context = DatapathPartition;
+    CxPlatRefIncrement(&DatapathPartition->RefCount);
+    CxPlatWorkerPoolAddExecutionContext(
+        Datapath->WorkerPool, &DatapathPartition->TxBatchEc, PartitionIndex);
 }
 
 QUIC_STATUS
@@ -243,6 +263,7 @@ DataPathInitialize(
         Datapath->TcpHandlers = *TcpCallbacks;
     }
     Datapath->WorkerPool = WorkerPool;
+    Datapath->BusyPollUs = CxPlatWorkerPoolGetBusyPollUs(WorkerPool);
 
     Datapath->PartitionCount = (uint16_t)CxPlatWorkerPoolGetCount(WorkerPool);
     Datapath->Features |= CXPLAT_DATAPATH_FEATURE_TCP;
@@ -332,6 +353,12 @@ CxPlatProcessorContextRelease(
             EpollProcessorContextRelease,
             "[data][%p] Processor Context Destroyed",
             DatapathPartition);
+        QuicTraceLogVerbose(
+            EpollProcessorContextTxBatchStats,
+            "[data][%p] Sent %llu batched datagrams in %llu sendmmsg calls",
+            DatapathPartition,
+            DatapathPartition->TxBatchDatagramCount,
+            DatapathPartition->TxBatchSyscallCount);
         CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool);
         CxPlatPoolUninitialize(&DatapathPartition->RecvBlockPool);
         CxPlatDataPathRelease(DatapathPartition->Datapath);
@@ -350,7 +377,11 @@ DataPathUninitialize(
 #endif
         const uint16_t PartitionCount = Datapath->PartitionCount;
         for (uint32_t i = 0; i < PartitionCount; i++) {
-            CxPlatProcessorContextRelease(&Datapath->Partitions[i]);
+            CXPLAT_DATAPATH_PARTITION* DatapathPartition = &Datapath->Partitions[i];
+            DatapathPartition->TxBatchShutdown = TRUE;
+            DatapathPartition->TxBatchEc.Ready = TRUE;
+            CxPlatWakeExecutionContext(&DatapathPartition->TxBatchEc);
+            CxPlatProcessorContextRelease(DatapathPartition);
         }
     }
 }
@@ -718,6 +749,47 @@ CxPlatSocketContextInitialize(
             goto Exit;
         }
 
+        if (SocketContext->DatapathPartition->Datapath->BusyPollUs != 0) {
+            //
+            // Busy polling requires CAP_NET_ADMIN (beyond the net.core.busy_read
+            // sysctl), so failures are traced and otherwise ignored.
+            //
+            Option = (int)SocketContext->DatapathPartition->Datapath->BusyPollUs;
+            Result =
+                setsockopt(
+                    SocketContext->SocketFd,
+                    SOL_SOCKET,
+                    SO_BUSY_POLL,
+                    (const void*)&Option,
+                    sizeof(Option));
+            if (Result == SOCKET_ERROR) {
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    Binding,
+                    errno,
+                    "setsockopt(SO_BUSY_POLL) failed");
+            }
+    #ifdef SO_PREFER_BUSY_POLL
+            Option = TRUE;
+            Result =
+                setsockopt(
+                    SocketContext->SocketFd,
+                    SOL_SOCKET,
+                    SO_PREFER_BUSY_POLL,
+                    (const void*)&Option,
+                    sizeof(Option));
+            if (Result == SOCKET_ERROR) {
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    Binding,
+                    errno,
+                    "setsockopt(SO_PREFER_BUSY_POLL) failed");
+            }
+    #endif
+        }
+
         //
         // Only set SO_REUSEPORT on a server socket, otherwise the client could be
         // assigned a server port (unless it's forcing sharing).
@@ -955,6 +1027,15 @@ CxPlatSocketContextUninitializeComplete(
     SocketContext->Freed = TRUE;
 #endif
 
+    if (SocketContext->TxBatchQueued) {
+        //
+        // Batched sends are only queued on the partition's worker thread, so
+        // this is too.
+        //
+        CxPlatListEntryRemove(&SocketContext->TxBatchEntry);
+        SocketContext->TxBatchQueued = FALSE;
+    }
+
     while (!CxPlatListIsEmpty(&SocketContext->TxQueue)) {
         CxPlatSendDataFree(
             CXPLAT_CONTAINING_RECORD(
@@ -1138,6 +1219,38 @@ SocketCreateUdp(
         CxPlatRundownInitialize(&Binding->SocketContexts[i].UpcallRundown);
     }
 
+    if (CxPlatDpRawIsRawDatapathOnly(Datapath->RawDataPath)) {
+        //
+        // There is no OS native datapath in raw-only mode. The application
+        // must specify the local port, and connected sockets must specify the
+        // local IP, as there is no OS bind to resolve either. The (single)
+        // socket context is never started, so deleting the socket releases it
+        // inline.
+        //
+        Binding->SkipCreatingOsSockets = TRUE;
+        if (Config->LocalAddress == NULL || Config->LocalAddress->Ipv4.sin_port == 0) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Binding,
+                (uint32_t)QUIC_STATUS_INVALID_PARAMETER,
+                "Raw-only datapath requires an explicit local port");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+        if (Config->RemoteAddress != NULL && QuicAddrIsWildCard(Config->LocalAddress)) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Binding,
+                (uint32_t)QUIC_STATUS_INVALID_PARAMETER,
+                "Raw-only datapath requires an explicit local IP for connected sockets");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+        goto Skip;
+    }
+
     for (uint32_t i = 0; i < SocketCount; i++) {
         Status =
             CxPlatSocketContextInitialize(
@@ -1160,6 +1273,8 @@ SocketCreateUdp(
         (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
     }
 
+Skip:
+
     CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
     Binding->LocalAddress.Ipv6.sin6_scope_id = 0;
 
@@ -1175,7 +1290,7 @@ SocketCreateUdp(
     //
     *NewBinding = Binding;
 
-    for (uint32_t i = 0; i < SocketCount; i++) {
+    for (uint32_t i = 0; i < SocketCount && !Binding->SkipCreatingOsSockets; i++) {
         CxPlatSocketContextSetEvents(&Binding->SocketContexts[i], EPOLL_CTL_ADD, EPOLLIN);
         Binding->SocketContexts[i].IoStarted = TRUE;
     }
@@ -2187,19 +2302,35 @@ SocketSend(
     SendData->LocalAddress = Route->LocalAddress;
 
     //
-    // Check to see if we need to pend because there's already queue.
+    // Check to see if we need to pend because there's already queue. UDP sends
+    // made on the socket's own worker thread are always queued, to be flushed
+    // together by the partition's TX batch execution context once the worker
+    // is done queuing sends for this iteration.
     //
-    BOOLEAN SendPending = FALSE, FlushTxQueue = FALSE;
+    BOOLEAN SendPending = FALSE, FlushTxQueue = FALSE, QueueTxBatch = FALSE;
     CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
     CxPlatLockAcquire(&SocketContext->TxQueueLock);
     if (/*SendData->Flags & CXPLAT_SEND_FLAGS_MAX_THROUGHPUT ||*/
         !CxPlatListIsEmpty(&SocketContext->TxQueue)) {
         FlushTxQueue = CxPlatListIsEmpty(&SocketContext->TxQueue);
         CxPlatListInsertTail(&SocketContext->TxQueue, &SendData->TxEntry);
         SendPending = TRUE;
+    } else if (
+        Socket->Type == CXPLAT_SOCKET_UDP &&
+        CxPlatWorkerIsThisThread(&DatapathPartition->TxBatchEc)) {
+        CxPlatListInsertTail(&SocketContext->TxQueue, &SendData->TxEntry);
+        SendPending = TRUE;
+        QueueTxBatch = TRUE;
     }
     CxPlatLockRelease(&SocketContext->TxQueueLock);
     if (SendPending) {
+        if (QueueTxBatch && !SocketContext->TxBatchQueued) {
+            SocketContext->TxBatchQueued = TRUE;
+            CxPlatListInsertTail(
+                &DatapathPartition->TxBatchSockets, &SocketContext->TxBatchEntry);
+            DatapathPartition->TxBatchEc.Ready = TRUE;
+        }
         if (FlushTxQueue) {
             CXPLAT_FRE_ASSERT(
                 CxPlatEventQEnqueue(
@@ -2502,6 +2633,160 @@ CxPlatSendDataSend(
     return Status;
 }
 
+//
+// Fills in the messages for the unsent datagrams of the send data, up to
+// MaxCount. Returns the number of messages used.
+//
+static
+uint32_t
+CxPlatSendDataPrepareMessages(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Out_writes_to_(MaxCount, return) struct mmsghdr* Mhdrs,
+    _In_ uint32_t MaxCount
+    )
+{
+    const uint16_t MessageCount =
+        SendData->SegmentationSupported ?
+            1 : (uint16_t)(SendData->BufferCount - SendData->AlreadySentCount);
+    uint32_t Count = 0;
+    for (; Count < MessageCount && Count < MaxCount; ++Count) {
+        struct msghdr* Mhdr = &Mhdrs[Count].msg_hdr;
+        Mhdrs[Count].msg_len = 0;
+        Mhdr->msg_name = (void*)&SendData->RemoteAddress;
+        Mhdr->msg_namelen = sizeof(SendData->RemoteAddress);
+        Mhdr->msg_iov = SendData->Iovs + SendData->AlreadySentCount + Count;
+        Mhdr->msg_iovlen = 1;
+        Mhdr->msg_flags = 0;
+        Mhdr->msg_control = SendData->ControlBuffer;
+        Mhdr->msg_controllen = SendData->ControlBufferLength;
+        if (SendData->ControlBufferLength == 0) {
+            CxPlatSendDataPopulateAncillaryData(SendData, Mhdr);
+        }
+    }
+    return Count;
+}
+
+//
+// Sends the queued UDP sends of the socket, packing the datagrams of as many
+// send data as possible into each sendmmsg call. Returns FALSE if the socket
+// would block with sends still queued.
+//
+static
+BOOLEAN
+CxPlatSocketContextSendTxBatch(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
+    struct mmsghdr Mhdrs[CXPLAT_MAX_TX_BATCH_SIZE];
+    CXPLAT_SEND_DATA* MhdrSendData[CXPLAT_MAX_TX_BATCH_SIZE];
+
+    while (TRUE) {
+        //
+        // Only this thread removes send data from the queue, so the entries
+        // stay valid after the lock is released.
+        //
+        uint32_t MessageCount = 0;
+        CxPlatLockAcquire(&SocketContext->TxQueueLock);
+        for (CXPLAT_LIST_ENTRY* Entry = SocketContext->TxQueue.Flink;
+             Entry != &SocketContext->TxQueue && MessageCount < CXPLAT_MAX_TX_BATCH_SIZE;
+             Entry = Entry->Flink) {
+            CXPLAT_SEND_DATA* SendData =
+                CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SEND_DATA, TxEntry);
+            const uint32_t Count =
+                CxPlatSendDataPrepareMessages(
+                    SendData,
+                    Mhdrs + MessageCount,
+                    CXPLAT_MAX_TX_BATCH_SIZE - MessageCount);
+            for (uint32_t i = 0; i < Count; ++i) {
+                MhdrSendData[MessageCount++] = SendData;
+            }
+        }
+        CxPlatLockRelease(&SocketContext->TxQueueLock);
+
+        if (MessageCount == 0) {
+            return TRUE;
+        }
+
+        int SentCount = cxplat_sendmmsg(SocketContext->SocketFd, Mhdrs, MessageCount, 0);
+        CXPLAT_FRE_ASSERT(SentCount != 0);
+        if (SentCount < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return FALSE;
+            }
+
+            //
+            // The first datagram failed. Let the regular send path retry it,
+            // and handle and report the error.
+            //
+            if (CxPlatSendDataSend(MhdrSendData[0]) == QUIC_STATUS_PENDING) {
+                return FALSE;
+            }
+            CxPlatLockAcquire(&SocketContext->TxQueueLock);
+            CxPlatListRemoveHead(&SocketContext->TxQueue);
+            CxPlatLockRelease(&SocketContext->TxQueueLock);
+            CxPlatSendDataFree(MhdrSendData[0]);
+            continue;
+        }
+
+        DatapathPartition->TxBatchSyscallCount++;
+        DatapathPartition->TxBatchDatagramCount += (uint32_t)SentCount;
+
+        for (uint32_t i = 0; i < (uint32_t)SentCount; ++i) {
+            CXPLAT_SEND_DATA* SendData = MhdrSendData[i];
+            if (!SendData->SegmentationSupported) {
+                SendData->AlreadySentCount++;
+                if (SendData->AlreadySentCount < SendData->BufferCount) {
+                    continue;
+                }
+            }
+            CxPlatLockAcquire(&SocketContext->TxQueueLock);
+            CXPLAT_DBG_ASSERT(SocketContext->TxQueue.Flink == &SendData->TxEntry);
+            CxPlatListRemoveHead(&SocketContext->TxQueue);
+            CxPlatLockRelease(&SocketContext->TxQueueLock);
+            CxPlatSendDataFree(SendData);
+        }
+    }
+}
+
+void
+CxPlatSocketContextFlushTxQueue(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ BOOLEAN SendAlreadyPending
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDataPathTxBatchExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    )
+{
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = (CXPLAT_DATAPATH_PARTITION*)Context;
+    UNREFERENCED_PARAMETER(State);
+
+    if (DatapathPartition->TxBatchShutdown) {
+        CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&DatapathPartition->TxBatchSockets));
+        CxPlatProcessorContextRelease(DatapathPartition);
+        return FALSE;
+    }
+
+    while (!CxPlatListIsEmpty(&DatapathPartition->TxBatchSockets)) {
+        CXPLAT_SOCKET_CONTEXT* SocketContext =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&DatapathPartition->TxBatchSockets),
+                CXPLAT_SOCKET_CONTEXT,
+                TxBatchEntry);
+        SocketContext->TxBatchQueued = FALSE;
+        if (CxPlatRundownAcquire(&SocketContext->UpcallRundown)) {
+            CxPlatSocketContextFlushTxQueue(SocketContext, FALSE);
+            CxPlatRundownRelease(&SocketContext->UpcallRundown);
+        }
+    }
+
+    return TRUE;
+}
+
 //
 // Returns TRUE if the queue was completely drained, and FALSE if there are
 // still pending sends.
@@ -2512,6 +2797,23 @@ CxPlatSocketContextFlushTxQueue(
     _In_ BOOLEAN SendAlreadyPending
     )
 {
+    if (SocketContext->Binding->Type == CXPLAT_SOCKET_UDP) {
+        if (!CxPlatSocketContextSendTxBatch(SocketContext)) {
+            if (!SendAlreadyPending) {
+                //
+                // Add the EPOLLOUT event since we have more pending sends.
+                //
+                CxPlatSocketContextSetEvents(SocketContext, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
+            }
+        } else if (SendAlreadyPending) {
+            //
+            // Remove the EPOLLOUT event since we don't have any more pending sends.
+            //
+            CxPlatSocketContextSetEvents(SocketContext, EPOLL_CTL_MOD, EPOLLIN);
+        }
+        return;
+    }
+
     CXPLAT_SEND_DATA* SendData = NULL;
     CxPlatLockAcquire(&SocketContext->TxQueueLock);
     if (!CxPlatListIsEmpty(&SocketContext->TxQueue)) {
@@ -160,6 +160,30 @@ typedef struct CXPLAT_SEND_DATA {
     //
     uint8_t SegmentationSupported : 1;
 
+    //
+    // Indicates the send data is a block of the partition's registered send
+    // buffer region.
+    //
+    uint8_t ZeroCopy : 1;
+
+    //
+    // Indicates the send was issued with SENDMSG_ZC, so the block stays in use
+    // until the kernel's notification.
+    //
+    uint8_t ZeroCopySent : 1;
+
+    //
+    // Indicates the zero-copy send was issued from the registered (fixed)
+    // buffer.
+    //
+    uint8_t ZeroCopyFixedBuffer : 1;
+
+    //
+    // Indicates the kernel rejected the zero-copy send (EINVAL), so the block
+    // is sent again with a copying SENDMSG once the kernel releases it.
+    //
+    uint8_t ZeroCopyRejected : 1;
+
     //
     // The message header for the send.
     //
@@ -216,7 +240,29 @@ const struct msghdr CxPlatRecvMsgHdr = {
     .msg_namelen = ALIGN_UP_BY(sizeof(QUIC_ADDR), CXPLAT_MEMORY_ALIGNMENT),
     .msg_controllen = CXPLAT_FIELD_SIZE(CXPLAT_RECV_MSG_CONTROL_BUFFER, Data),
 };
-const uint32_t RecvBufCount = 1024;
+
+//
+// The number of buffers allocated at a time for each receive buffer group.
+// Groups start with one chunk and grow, up to CXPLAT_RECV_BUFFER_GROUP_MAX_CHUNKS
+// chunks, when their rings run low.
+//
+const uint16_t RecvBufChunkSize[CxPlatRecvBufferGroupCount] = {
+    1024,   // CxPlatRecvBufferGroupMtu
+    128,    // CxPlatRecvBufferGroupCoalesced
+};
+
+//
+// Receive buffer IDs carry their group's index in the top bit.
+//
+#define RecvBufIdGroupShift 15
+
+//
+// The number of send data blocks in each partition's registered send buffer
+// region. Zero-copy sends hold their block until the kernel's notification,
+// so this bounds the zero-copy sends in flight per partition; further sends
+// fall back to the (copying) SendBlockPool.
+//
+const uint32_t SendZeroCopyBufCount = 64;
 
 void
 CxPlatSocketIoStart(
@@ -244,12 +290,17 @@ CxPlatSocketAllocSqe(
     return io_sqe;
 }
 
-uint32_t
-CxPlatGetBufferPoolBufferSize(
-    _In_ const CXPLAT_REGISTERED_BUFFER_POOL* Pool
+//
+// Sockets receive into GRO sized buffers when the datapath coalesces receives.
+//
+CXPLAT_RECV_BUFFER_GROUP_INDEX
+CxPlatDataPathDefaultRecvBufferGroup(
+    _In_ const CXPLAT_DATAPATH* Datapath
     )
 {
-    return Pool->BufferSize;
+    return
+        (Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING) ?
+            CxPlatRecvBufferGroupCoalesced : CxPlatRecvBufferGroupMtu;
 }
 
 uint8_t*
@@ -261,86 +312,252 @@ CxPlatGetBufferPoolBuffer(
     return Pool->Buffers + (Index * Pool->BufferSize);
 }
 
+DATAPATH_RX_IO_BLOCK*
+CxPlatRecvBufferGroupGetBlock(
+    _In_ const CXPLAT_DATAPATH_PARTITION* DatapathPartition,
+    _In_ uint32_t BufferId
+    )
+{
+    const CXPLAT_RECV_BUFFER_GROUP* Group =
+        &DatapathPartition->RecvBufferGroups[BufferId >> RecvBufIdGroupShift];
+    const uint32_t Index = BufferId & ((1 << RecvBufIdGroupShift) - 1);
+    CXPLAT_DBG_ASSERT(Index < (uint32_t)Group->ChunkCount * Group->ChunkSize);
+    return
+        (DATAPATH_RX_IO_BLOCK*)(
+            Group->Chunks[Index / Group->ChunkSize] +
+            (Index % Group->ChunkSize) * Group->BufferSize);
+}
+
+//
+// Adds a buffer to the ring at the given offset from the current tail. The
+// caller must hold the group's lock and advance the ring afterwards.
+//
 void
-CxPlatFreeBufferPool(
+CxPlatRecvBufferGroupAddBuffer(
+    _In_ CXPLAT_RECV_BUFFER_GROUP* Group,
+    _In_ DATAPATH_RX_IO_BLOCK* IoBlock,
+    _In_ int Offset
+    )
+{
+    io_uring_buf_ring_add(
+        Group->Ring,
+        (uint8_t*)IoBlock + Group->BufferOffset,
+        Group->BufferSize - Group->BufferOffset,
+        (unsigned short)IoBlock->BufferIndex,
+        io_uring_buf_ring_mask(Group->ChunkSize * CXPLAT_RECV_BUFFER_GROUP_MAX_CHUNKS),
+        Offset);
+}
+
+//
+// Allocates another chunk of buffers and adds them to the ring, if the group
+// still has 'ChunkCount' chunks. Growth is requested both on the partition's
+// thread, as the ring runs low, and on the thread arming a socket's first
+// receive, so the chunk count is only checked and advanced under the group's
+// lock; a request based on a stale count does nothing.
+//
+BOOLEAN
+CxPlatRecvBufferGroupGrow(
     _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition,
-    _In_ CXPLAT_IO_RING_BUF_GROUP BufferGroup,
-    _Inout_ CXPLAT_REGISTERED_BUFFER_POOL* Pool
+    _In_ CXPLAT_RECV_BUFFER_GROUP* Group,
+    _In_ uint16_t ChunkCount
     )
 {
-    if (Pool->Buffers != NULL) {
-        io_uring_unregister_buf_ring(&DatapathPartition->EventQ->Ring, BufferGroup);
-        Pool->Buffers = NULL;
+    const uint32_t GroupIndex = (uint32_t)(Group - DatapathPartition->RecvBufferGroups);
+    const size_t ChunkLength = (size_t)Group->ChunkSize * Group->BufferSize;
+    BOOLEAN Grown = FALSE;
+    void* Chunk;
+
+    CxPlatLockAcquire(&Group->Lock);
+
+    if (Group->ChunkCount != ChunkCount ||
+        Group->ChunkCount == CXPLAT_RECV_BUFFER_GROUP_MAX_CHUNKS) {
+        goto Exit;
     }
-    if (Pool->Ring != NULL) {
-        free(Pool->Ring);
-        Pool->Ring = NULL;
+
+    if (posix_memalign(&Chunk, getpagesize(), ChunkLength)) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_RECV_BUFFER_GROUP chunk",
+            ChunkLength);
+        goto Exit;
+    }
+
+    const uint32_t FirstIndex = (uint32_t)Group->ChunkCount * Group->ChunkSize;
+    Group->Chunks[Group->ChunkCount++] = (uint8_t*)Chunk;
+    for (uint32_t i = 0; i < Group->ChunkSize; i++) {
+        DATAPATH_RX_IO_BLOCK* IoBlock =
+            (DATAPATH_RX_IO_BLOCK*)((uint8_t*)Chunk + i * Group->BufferSize);
+        IoBlock->BufferIndex = (GroupIndex << RecvBufIdGroupShift) | (FirstIndex + i);
+        IoBlock->DatapathPartition = DatapathPartition;
+        CxPlatRecvBufferGroupAddBuffer(Group, IoBlock, (int)i);
+    }
+    io_uring_buf_ring_advance(Group->Ring, Group->ChunkSize);
+    InterlockedExchangeAdd64(&Group->Available, Group->ChunkSize);
+    Grown = TRUE;
+
+Exit:
+
+    CxPlatLockRelease(&Group->Lock);
+
+    return Grown;
+}
+
+void
+CxPlatRecvBufferGroupUninitialize(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition,
+    _Inout_ CXPLAT_RECV_BUFFER_GROUP* Group
+    )
+{
+    if (Group->Ring != NULL) {
+        io_uring_unregister_buf_ring(&DatapathPartition->EventQ->Ring, Group->GroupId);
+        free(Group->Ring);
+        Group->Ring = NULL;
+        for (uint16_t i = 0; i < Group->ChunkCount; i++) {
+            free(Group->Chunks[i]);
+        }
+        Group->ChunkCount = 0;
+        CxPlatLockUninitialize(&Group->Lock);
     }
 }
 
+//
+// Registers an empty buffer ring for the group, sized for all the chunks it
+// may grow to. Buffers are added by CxPlatRecvBufferGroupGrow.
+//
 QUIC_STATUS
-CxPlatCreateBufferPool(
+CxPlatRecvBufferGroupInitialize(
     _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition,
-    _In_ uint32_t BufferSize,
-    _In_ uint32_t BufferCount,
-    _In_ CXPLAT_IO_RING_BUF_GROUP BufferGroup,
-    _Out_ CXPLAT_REGISTERED_BUFFER_POOL* Pool
+    _In_ CXPLAT_RECV_BUFFER_GROUP_INDEX GroupIndex,
+    _In_ uint32_t PayloadSize,
+    _In_ uint16_t MaxPackets
     )
 {
+    CXPLAT_RECV_BUFFER_GROUP* Group = &DatapathPartition->RecvBufferGroups[GroupIndex];
+    const uint32_t RingEntries = RecvBufChunkSize[GroupIndex] * CXPLAT_RECV_BUFFER_GROUP_MAX_CHUNKS;
+    const size_t RingLength = RingEntries * sizeof(struct io_uring_buf);
+    void* Ring;
     int Result;
-    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
 
-    CXPLAT_DBG_ASSERT(BufferSize % CXPLAT_MEMORY_ALIGNMENT == 0);
+    CXPLAT_DBG_ASSERT(RingEntries <= (1u << RecvBufIdGroupShift));
 
-    CxPlatZeroMemory(Pool, sizeof(*Pool));
-    CxPlatLockInitialize(&Pool->Lock);
+    CxPlatZeroMemory(Group, sizeof(*Group));
+    Group->GroupId =
+        GroupIndex == CxPlatRecvBufferGroupMtu ?
+            CxPlatIoRingBufGroupRecv : CxPlatIoRingBufGroupRecvCoalesced;
+    Group->MaxPackets = MaxPackets;
+    Group->ChunkSize = RecvBufChunkSize[GroupIndex];
+    Group->BufferOffset =
+        sizeof(DATAPATH_RX_IO_BLOCK) + MaxPackets * DatapathPartition->Datapath->RecvBlockStride;
+    Group->BufferSize =
+        ALIGN_UP_BY(Group->BufferOffset + PayloadSize, CXPLAT_MEMORY_ALIGNMENT);
 
-    Pool->TotalSize = BufferCount * (sizeof(struct io_uring_buf) + BufferSize);
-    if (posix_memalign(&Pool->Ring, getpagesize(), Pool->TotalSize)) {
+    if (posix_memalign(&Ring, getpagesize(), RingLength)) {
         QuicTraceEvent(
             AllocFailure,
             "Allocation of '%s' failed. (%llu bytes)",
-            "CXPLAT_REGISTERED_BUFFER_POOL",
-            Pool->TotalSize);
-        Status = QUIC_STATUS_OUT_OF_MEMORY;
-        goto Exit;
+            "CXPLAT_RECV_BUFFER_GROUP",
+            RingLength);
+        return QUIC_STATUS_OUT_OF_MEMORY;
     }
 
-    io_uring_buf_ring_init(Pool->Ring);
+    io_uring_buf_ring_init(Ring);
 
     struct io_uring_buf_reg reg = (struct io_uring_buf_reg) {
-        .ring_addr = (uint64_t)Pool->Ring,
-        .ring_entries = BufferCount,
-        .bgid = (uint16_t)BufferGroup
+        .ring_addr = (uint64_t)Ring,
+        .ring_entries = RingEntries,
+        .bgid = Group->GroupId
     };
 
     Result = io_uring_register_buf_ring(&DatapathPartition->EventQ->Ring, &reg, 0);
     if (Result) {
-        Status = errno;
+        QUIC_STATUS Status = -Result;
         QuicTraceEvent(
             DatapathErrorStatus,
             "[data][%p] ERROR, %u, %s.",
             DatapathPartition,
             Status,
             "io_uring_register_buf_ring failed");
-            goto Exit;
+        free(Ring);
+        return Status;
     }
 
-    //
-    // Review: we may also want to io_uring_register_buffers for
-    // io_uring_prep_send_zc_fixed.
-    //
+    CxPlatLockInitialize(&Group->Lock);
+    Group->Ring = Ring;
 
-    Pool->Buffers = (uint8_t*)Pool->Ring + sizeof(struct io_uring_buf) * BufferCount;
-    Pool->BufferSize = BufferSize;
+    return QUIC_STATUS_SUCCESS;
+}
 
-Exit:
+void
+CxPlatFreeSendZeroCopyPool(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    CXPLAT_REGISTERED_BUFFER_POOL* Pool = &DatapathPartition->SendRegisteredBufferPool;
+    if (Pool->Buffers != NULL) {
+        if (DatapathPartition->SendZeroCopyRegistered) {
+            io_uring_unregister_buffers(&DatapathPartition->EventQ->Ring);
+            DatapathPartition->SendZeroCopyRegistered = FALSE;
+        }
+        free(Pool->Buffers);
+        Pool->Buffers = NULL;
+    }
+    CxPlatListInitializeHead(&DatapathPartition->SendZeroCopyFreeList);
+}
 
-    if (QUIC_FAILED(Status)) {
-        CxPlatFreeBufferPool(DatapathPartition, BufferGroup, Pool);
+//
+// Allocates the partition's send buffer region for zero-copy sends and
+// registers it with the io_uring as fixed buffer 0. Failure to register (for
+// instance, if the ring already has a buffer table or RLIMIT_MEMLOCK is too
+// low) only disables the use of fixed buffers on the partition; the region is
+// still used for SENDMSG_ZC. Failure to allocate leaves the partition without
+// zero-copy sends.
+//
+void
+CxPlatCreateSendZeroCopyPool(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    CXPLAT_DATAPATH* Datapath = DatapathPartition->Datapath;
+    CXPLAT_REGISTERED_BUFFER_POOL* Pool = &DatapathPartition->SendRegisteredBufferPool;
+    void* Buffers;
+
+    CxPlatZeroMemory(Pool, sizeof(*Pool));
+    CxPlatLockInitialize(&Pool->Lock);
+    CxPlatListInitializeHead(&DatapathPartition->SendZeroCopyFreeList);
+
+    Pool->BufferSize = ALIGN_UP_BY(Datapath->SendDataSize, CXPLAT_MEMORY_ALIGNMENT);
+    Pool->TotalSize = SendZeroCopyBufCount * Pool->BufferSize;
+    if (posix_memalign(&Buffers, getpagesize(), Pool->TotalSize)) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_REGISTERED_BUFFER_POOL",
+            Pool->TotalSize);
+        return;
     }
+    Pool->Buffers = (uint8_t*)Buffers;
 
-    return Status;
+    if (Datapath->SendZeroCopyFixedBuffers) {
+        const struct iovec Region = { .iov_base = Pool->Buffers, .iov_len = Pool->TotalSize };
+        int Result = io_uring_register_buffers(&DatapathPartition->EventQ->Ring, &Region, 1);
+        if (Result != 0) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                DatapathPartition,
+                -Result,
+                "io_uring_register_buffers failed");
+        } else {
+            DatapathPartition->SendZeroCopyRegistered = TRUE;
+        }
+    }
+
+    for (uint32_t i = 0; i < SendZeroCopyBufCount; i++) {
+        CXPLAT_SEND_DATA* SendData =
+            (CXPLAT_SEND_DATA*)CxPlatGetBufferPoolBuffer(Pool, i);
+        CxPlatListInsertTail(&DatapathPartition->SendZeroCopyFreeList, &SendData->TxEntry);
+    }
 }
 
 QUIC_STATUS
@@ -361,28 +578,40 @@ CxPlatProcessorContextInitialize(
     CxPlatPoolInitialize(
         TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool);
 
+    if (Datapath->SendZeroCopy) {
+        CxPlatCreateSendZeroCopyPool(DatapathPartition);
+    } else {
+        CxPlatListInitializeHead(&DatapathPartition->SendZeroCopyFreeList);
+    }
+
     Status =
-        CxPlatCreateBufferPool(
-            DatapathPartition, Datapath->RecvBlockSize, RecvBufCount,
-            CxPlatIoRingBufGroupRecv, &DatapathPartition->RecvRegisteredBufferPool);
+        CxPlatRecvBufferGroupInitialize(
+            DatapathPartition, CxPlatRecvBufferGroupMtu, CXPLAT_SMALL_IO_BUFFER_SIZE, 1);
     if (QUIC_FAILED(Status)) {
         goto Exit;
     }
 
-    for (uint32_t i = 0; i < RecvBufCount; i++) {
-        DATAPATH_RX_IO_BLOCK* IoBlock =
-            (DATAPATH_RX_IO_BLOCK*)CxPlatGetBufferPoolBuffer(
-                &DatapathPartition->RecvRegisteredBufferPool, i);
-        IoBlock->BufferIndex = i;
-        IoBlock->DatapathPartition = DatapathPartition;
-        io_uring_buf_ring_add(
-            DatapathPartition->RecvRegisteredBufferPool.Ring,
-            (uint8_t*)IoBlock + DatapathPartition->Datapath->RecvBlockBufferOffset,
-            CxPlatGetBufferPoolBufferSize(&DatapathPartition->RecvRegisteredBufferPool) -
-                DatapathPartition->Datapath->RecvBlockBufferOffset,
-            i, io_uring_buf_ring_mask(RecvBufCount), i);
+    if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING) {
+        Status =
+            CxPlatRecvBufferGroupInitialize(
+                DatapathPartition, CxPlatRecvBufferGroupCoalesced,
+                CXPLAT_LARGE_IO_BUFFER_SIZE, CXPLAT_MAX_IO_BATCH_SIZE);
+        if (QUIC_FAILED(Status)) {
+            goto Exit;
+        }
+    }
+
+    //
+    // Only the group sockets start with gets buffers up front. The MTU group
+    // of a coalescing datapath is only filled if a socket can't enable GRO.
+    //
+    if (!CxPlatRecvBufferGroupGrow(
+            DatapathPartition,
+            &DatapathPartition->RecvBufferGroups[CxPlatDataPathDefaultRecvBufferGroup(Datapath)],
+            0)) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Exit;
     }
-    io_uring_buf_ring_advance(DatapathPartition->RecvRegisteredBufferPool.Ring, RecvBufCount);
 
 Exit:
 
@@ -400,7 +629,6 @@ DataPathInitialize(
     )
 {
     UNREFERENCED_PARAMETER(TcpCallbacks);
-    UNREFERENCED_PARAMETER(InitConfig);
 
     if (NewDatapath == NULL) {
         return QUIC_STATUS_INVALID_PARAMETER;
@@ -461,24 +689,31 @@ DataPathInitialize(
         Datapath->SendIoVecCount = CXPLAT_MAX_IO_BATCH_SIZE;
     }
 
+    if (InitConfig->EnableSendZeroCopy) {
+        //
+        // SENDMSG_ZC (rather than SEND_ZC) is required to carry the GSO, ECN
+        // and source address control messages. Registered buffers are tried
+        // first and dropped if the kernel rejects them.
+        //
+        struct io_uring_probe* Probe = io_uring_get_probe();
+        if (Probe != NULL) {
+            if (io_uring_opcode_supported(Probe, IORING_OP_SENDMSG_ZC)) {
+                Datapath->SendZeroCopy = TRUE;
+                Datapath->SendZeroCopyFixedBuffers = TRUE;
+                Datapath->SendZeroCopyThreshold = InitConfig->SendZeroCopyThreshold;
+            }
+            io_uring_free_probe(Probe);
+        }
+        if (!Datapath->SendZeroCopy) {
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "Zero-copy send not supported by the kernel");
+        }
+    }
+
     Datapath->RecvBlockStride =
         ALIGN_UP_BY(sizeof(DATAPATH_RX_PACKET) + ClientRecvDataLength, CXPLAT_MEMORY_ALIGNMENT);
-    if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING) {
-        Datapath->RecvBlockBufferOffset =
-            sizeof(DATAPATH_RX_IO_BLOCK) +
-            CXPLAT_MAX_IO_BATCH_SIZE * Datapath->RecvBlockStride;
-        Datapath->RecvBlockSize =
-            ALIGN_UP_BY(
-                Datapath->RecvBlockBufferOffset + CXPLAT_LARGE_IO_BUFFER_SIZE,
-                CXPLAT_MEMORY_ALIGNMENT);
-    } else {
-        Datapath->RecvBlockBufferOffset =
-            sizeof(DATAPATH_RX_IO_BLOCK) + Datapath->RecvBlockStride;
-        Datapath->RecvBlockSize =
-            ALIGN_UP_BY(
-                Datapath->RecvBlockBufferOffset + CXPLAT_SMALL_IO_BUFFER_SIZE,
-                CXPLAT_MEMORY_ALIGNMENT);
-    }
 
     //
     // Initialize the per processor contexts.
@@ -525,9 +760,11 @@ CxPlatProcessorContextRelease(
         CXPLAT_DBG_ASSERT(!DatapathPartition->Uninitialized);
         DatapathPartition->Uninitialized = TRUE;
 #endif
-        CxPlatFreeBufferPool(
-            DatapathPartition, CxPlatIoRingBufGroupRecv,
-            &DatapathPartition->RecvRegisteredBufferPool);
+        for (uint32_t i = 0; i < CxPlatRecvBufferGroupCount; i++) {
+            CxPlatRecvBufferGroupUninitialize(
+                DatapathPartition, &DatapathPartition->RecvBufferGroups[i]);
+        }
+        CxPlatFreeSendZeroCopyPool(DatapathPartition);
         CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool);
         CxPlatDataPathRelease(DatapathPartition->Datapath);
     }
@@ -861,14 +1098,17 @@ CxPlatSocketContextInitialize(
                     (const void*)&Option,
                     sizeof(Option));
             if (Result == SOCKET_ERROR) {
-                Status = errno;
+                //
+                // Receive into MTU sized buffers instead.
+                //
                 QuicTraceEvent(
                     DatapathErrorStatus,
                     "[data][%p] ERROR, %u, %s.",
                     Binding,
-                    Status,
+                    errno,
                     "setsockopt(UDP_GRO) failed");
-                goto Exit;
+            } else {
+                SocketContext->LockedFlags.RecvBufferGroup = CxPlatRecvBufferGroupCoalesced;
             }
         }
     #endif
@@ -1202,11 +1442,20 @@ CxPlatSocketContextStartMultiRecvUnderLock(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
     )
 {
-    CXPLAT_EVENTQ* EventQ = SocketContext->DatapathPartition->EventQ;
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
+    CXPLAT_EVENTQ* EventQ = DatapathPartition->EventQ;
+    CXPLAT_RECV_BUFFER_GROUP* Group =
+        &DatapathPartition->RecvBufferGroups[SocketContext->LockedFlags.RecvBufferGroup];
 
     CXPLAT_DBG_ASSERT(!SocketContext->LockedFlags.MultiRecvStarted);
     CXPLAT_DBG_ASSERT(!SocketContext->LockedFlags.Shutdown);
 
+    //
+    // Fill the group if this is the first socket to use it. If this fails, the
+    // receive completes with ENOBUFS and growing is retried then.
+    //
+    (void)CxPlatRecvBufferGroupGrow(DatapathPartition, Group, 0);
+
     struct io_uring_sqe* Sqe = CxPlatSocketAllocSqe(SocketContext);
     if (Sqe == NULL) {
         QuicTraceEvent(
@@ -1227,7 +1476,7 @@ CxPlatSocketContextStartMultiRecvUnderLock(
     io_uring_prep_recvmsg_multishot(
         Sqe, SocketContext->SocketFd, (struct msghdr*)&CxPlatRecvMsgHdr, MSG_TRUNC);
     Sqe->flags |= IOSQE_BUFFER_SELECT;
-    Sqe->buf_group = CxPlatIoRingBufGroupRecv;
+    Sqe->buf_group = Group->GroupId;
     io_uring_sqe_set_data(Sqe, &SocketContext->IoSqe.Sqe);
     CxPlatEventQSubmit(EventQ);
 
@@ -1588,6 +1837,9 @@ CxPlatSocketContextRecvComplete(
 
         DATAPATH_RX_PACKET* Datagram = (DATAPATH_RX_PACKET*)(IoBlock + 1);
         uint8_t* RecvBuffer = Msg->msg_iov->iov_base;
+        const uint16_t MaxPackets =
+            SocketContext->DatapathPartition->RecvBufferGroups[
+                IoBlock->BufferIndex >> RecvBufIdGroupShift].MaxPackets;
         IoBlock->RefCount = 0;
 
         //
@@ -1595,7 +1847,7 @@ CxPlatSocketContextRecvComplete(
         //
         uint32_t Offset = 0;
         while (Offset < MsgLen &&
-               IoBlock->RefCount < CXPLAT_MAX_IO_BATCH_SIZE) {
+               IoBlock->RefCount < MaxPackets) {
             IoBlock->RefCount++;
             Datagram->IoBlock = IoBlock;
 
@@ -1664,11 +1916,24 @@ CxPlatSocketReceiveComplete(
     struct iovec RecvIov;
     uint32_t BufferIndex;
     struct io_uring_recvmsg_out* RecvMsgOut;
+    CXPLAT_RECV_BUFFER_GROUP* Group;
 
     if (Cqe->res == -ENOBUFS) {
         //
-        // Ignore packet loss indications for now.
+        // The ring ran dry, which ends the multishot receive. Datagrams wait
+        // in the socket's receive buffer meanwhile, so grow the group (if it
+        // still can) before the receive is re-armed below.
         //
+        Group = &DatapathPartition->RecvBufferGroups[SocketContext->LockedFlags.RecvBufferGroup];
+        SocketContext->RecvBufferStallCount++;
+        (void)CxPlatRecvBufferGroupGrow(DatapathPartition, Group, Group->ChunkCount);
+        QuicTraceLogWarning(
+            DatapathRecvBufferStall,
+            "[data][%p] Receive buffers exhausted (group=%hu, buffers=%u, stalls=%u)",
+            SocketContext->Binding,
+            Group->GroupId,
+            (uint32_t)Group->ChunkCount * Group->ChunkSize,
+            SocketContext->RecvBufferStallCount);
         goto Exit;
     }
 
@@ -1682,14 +1947,26 @@ CxPlatSocketReceiveComplete(
 
     CXPLAT_DBG_ASSERT(Cqe->flags & IORING_CQE_F_BUFFER);
 
-    BufferIndex = Cqe->flags >> 16;
-    IoBlock =
-        (DATAPATH_RX_IO_BLOCK*)CxPlatGetBufferPoolBuffer(
-            &DatapathPartition->RecvRegisteredBufferPool, BufferIndex);
-    IoPayload = (uint8_t*)IoBlock + DatapathPartition->Datapath->RecvBlockBufferOffset;
+    BufferIndex = Cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+    Group = &DatapathPartition->RecvBufferGroups[BufferIndex >> RecvBufIdGroupShift];
+    IoBlock = CxPlatRecvBufferGroupGetBlock(DatapathPartition, BufferIndex);
+    IoPayload = (uint8_t*)IoBlock + Group->BufferOffset;
     RecvMsgOut = io_uring_recvmsg_validate(IoPayload, Cqe->res, (struct msghdr*)&CxPlatRecvMsgHdr);
     CXPLAT_FRE_ASSERT(RecvMsgOut != NULL); // Review: can this legally fail?
 
+    if (InterlockedDecrement64(&Group->Available) * 8 <
+            (int64_t)Group->ChunkCount * Group->ChunkSize) {
+        //
+        // Less than an eighth of the group's buffers are left in the ring.
+        // Grow it now rather than wait for the receive to stall.
+        //
+        (void)CxPlatRecvBufferGroupGrow(DatapathPartition, Group, Group->ChunkCount);
+    }
+
+    if (RecvMsgOut->flags & MSG_TRUNC) {
+        SocketContext->RecvTruncatedCount++;
+    }
+
     CXPLAT_DBG_ASSERT((uintptr_t)IoBlock % CXPLAT_MEMORY_ALIGNMENT == 0);
 
     IoBlock->Route.State = RouteResolved;
@@ -1742,15 +2019,13 @@ RecvDataReturn(
             // Review: this is amenable to batching, but the added complexity
             // may not be worth it.
             //
-            CxPlatLockAcquire(&DatapathPartition->RecvRegisteredBufferPool.Lock);
-            io_uring_buf_ring_add(
-                DatapathPartition->RecvRegisteredBufferPool.Ring,
-                (uint8_t*)IoBlock + DatapathPartition->Datapath->RecvBlockBufferOffset,
-                CxPlatGetBufferPoolBufferSize(&DatapathPartition->RecvRegisteredBufferPool) -
-                    DatapathPartition->Datapath->RecvBlockBufferOffset,
-                IoBlock->BufferIndex, io_uring_buf_ring_mask(RecvBufCount), 0);
-            io_uring_buf_ring_advance(DatapathPartition->RecvRegisteredBufferPool.Ring, 1);
-            CxPlatLockRelease(&DatapathPartition->RecvRegisteredBufferPool.Lock);
+            CXPLAT_RECV_BUFFER_GROUP* Group =
+                &DatapathPartition->RecvBufferGroups[IoBlock->BufferIndex >> RecvBufIdGroupShift];
+            CxPlatLockAcquire(&Group->Lock);
+            CxPlatRecvBufferGroupAddBuffer(Group, IoBlock, 0);
+            io_uring_buf_ring_advance(Group->Ring, 1);
+            InterlockedIncrement64(&Group->Available);
+            CxPlatLockRelease(&Group->Lock);
         }
     }
 }
@@ -1789,9 +2064,32 @@ SendDataAlloc(
     CXPLAT_SOCKET_CONTEXT* SocketContext = (CXPLAT_SOCKET_CONTEXT*)Config->Route->Queue;
     CXPLAT_DBG_ASSERT(SocketContext->Binding == Socket);
     CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath == SocketContext->DatapathPartition->Datapath);
-    CXPLAT_SEND_DATA* SendData = CxPlatPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool);
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
+    CXPLAT_SEND_DATA* SendData = NULL;
+    BOOLEAN ZeroCopy = FALSE;
+    if (Socket->Type == CXPLAT_SOCKET_UDP &&
+        !SocketContext->SendZeroCopyDisabled &&
+        !CxPlatListIsEmpty(&DatapathPartition->SendZeroCopyFreeList)) {
+        CxPlatLockAcquire(&DatapathPartition->SendRegisteredBufferPool.Lock);
+        if (!CxPlatListIsEmpty(&DatapathPartition->SendZeroCopyFreeList)) {
+            SendData =
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(&DatapathPartition->SendZeroCopyFreeList),
+                    CXPLAT_SEND_DATA,
+                    TxEntry);
+            ZeroCopy = TRUE;
+        }
+        CxPlatLockRelease(&DatapathPartition->SendRegisteredBufferPool.Lock);
+    }
+    if (SendData == NULL) {
+        SendData = CxPlatPoolAlloc(&DatapathPartition->SendBlockPool);
+    }
     if (SendData != NULL) {
         SendData->SocketContext = SocketContext;
+        SendData->ZeroCopy = ZeroCopy;
+        SendData->ZeroCopySent = FALSE;
+        SendData->ZeroCopyFixedBuffer = FALSE;
+        SendData->ZeroCopyRejected = FALSE;
         SendData->ClientBuffer.Buffer = SendData->Buffer;
         SendData->ClientBuffer.Length = 0;
         SendData->TotalSize = 0;
@@ -1825,7 +2123,14 @@ SendDataFree(
     )
 {
     CXPLAT_DBG_ASSERT(SendDataUpdateState(SendData, SendStateFreed) != SendStateFreed);
-    CxPlatPoolFree(SendData);
+    if (SendData->ZeroCopy) {
+        CXPLAT_DATAPATH_PARTITION* DatapathPartition = SendData->SocketContext->DatapathPartition;
+        CxPlatLockAcquire(&DatapathPartition->SendRegisteredBufferPool.Lock);
+        CxPlatListInsertHead(&DatapathPartition->SendZeroCopyFreeList, &SendData->TxEntry);
+        CxPlatLockRelease(&DatapathPartition->SendRegisteredBufferPool.Lock);
+    } else {
+        CxPlatPoolFree(SendData);
+    }
 }
 
 static
@@ -2073,7 +2378,28 @@ CxPlatSendDataSendSegmented(
         SendData->MsgHdr.msg_controllen = SendData->ControlBufferLength;
     }
 
-    io_uring_prep_sendmsg(Sqe, SendData->SocketContext->SocketFd, &SendData->MsgHdr, 0);
+    SendData->ZeroCopySent =
+        SendData->ZeroCopy &&
+        !SendData->ZeroCopyRejected &&
+        SendData->TotalSize >= DatapathPartition->Datapath->SendZeroCopyThreshold;
+    SendData->ZeroCopyFixedBuffer =
+        SendData->ZeroCopySent &&
+        DatapathPartition->SendZeroCopyRegistered &&
+        DatapathPartition->Datapath->SendZeroCopyFixedBuffers;
+    if (SendData->ZeroCopySent) {
+        io_uring_prep_sendmsg_zc(Sqe, SocketContext->SocketFd, &SendData->MsgHdr, 0);
+        Sqe->ioprio |= IORING_SEND_ZC_REPORT_USAGE;
+        if (SendData->ZeroCopyFixedBuffer) {
+            //
+            // The iovecs all point into the send data block, which lies in
+            // the partition's registered buffer region.
+            //
+            Sqe->ioprio |= IORING_RECVSEND_FIXED_BUF;
+            Sqe->buf_index = 0;
+        }
+    } else {
+        io_uring_prep_sendmsg(Sqe, SocketContext->SocketFd, &SendData->MsgHdr, 0);
+    }
     io_uring_sqe_set_data(Sqe, (void*)&SendData->Sqe);
     CxPlatBatchSqeInitialize(
         DatapathPartition->EventQ, CxPlatSocketContextIoEventComplete, &SendData->Sqe.Sqe);
@@ -2178,17 +2504,83 @@ CxPlatSendDataSend(
     return Status;
 }
 
+//
+// Sends a block again with a copying SENDMSG after the kernel rejected its
+// zero-copy send and released it. Called with the partition's EventQ lock held.
+//
+void
+CxPlatSendDataResendCopied(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CXPLAT_DBG_ASSERT(SendData->ZeroCopyRejected);
+    if (SendData->SocketContext->LockedFlags.Shutdown) {
+        CxPlatSendDataFree(SendData);
+        return;
+    }
+    CXPLAT_DBG_ONLY(SendDataUpdateState(SendData, SendStateAllocated));
+    (void)CxPlatSendDataSend(SendData, TRUE, FALSE);
+}
+
 void
 CxPlatSocketContextSendComplete(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
     _In_ CXPLAT_CQE Cqe
     )
 {
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
     CXPLAT_SQE* Sqe = CxPlatCqeGetSqe(&Cqe);
     CXPLAT_SEND_DATA* SendData = CXPLAT_CONTAINING_RECORD(Sqe, CXPLAT_SEND_DATA, Sqe);
+    const BOOLEAN MoreCompletions = !!(Cqe->flags & IORING_CQE_F_MORE);
+
+    if (Cqe->flags & IORING_CQE_F_NOTIF) {
+        //
+        // The kernel is done with a zero-copy send's buffer, which the send's
+        // first completion left allocated.
+        //
+        CXPLAT_DBG_ASSERT(SendData->ZeroCopySent);
+        if (Cqe->res & IORING_NOTIF_USAGE_ZC_COPIED) {
+            //
+            // The route out of this socket (e.g. loopback) copied the data
+            // anyway, so stop paying for the notifications.
+            //
+            InterlockedFetchAndSetBoolean(&SocketContext->SendZeroCopyDisabled);
+        }
+        if (SendData->ZeroCopyRejected) {
+            CxPlatSendDataResendCopied(SendData);
+        } else {
+            CxPlatSendDataFree(SendData);
+        }
+        CxPlatSocketIoComplete(SocketContext, IoTagSend);
+        return;
+    }
 
     CXPLAT_DBG_ASSERT(SendDataUpdateState(SendData, SendStateSendComplete) == SendStateSending);
-    CxPlatSendDataFree(SendData);
+    if (SendData->ZeroCopySent && Cqe->res == -EINVAL) {
+        //
+        // The kernel rejected the zero-copy send. Older kernels support
+        // SENDMSG_ZC but not from registered buffers, so stop using those for
+        // every partition; otherwise stop using zero-copy on this socket.
+        // Either way, the datagram is sent again with a copying SENDMSG.
+        //
+        if (SendData->ZeroCopyFixedBuffer) {
+            if (InterlockedFetchAndClearBoolean(
+                    &DatapathPartition->Datapath->SendZeroCopyFixedBuffers)) {
+                QuicTraceEvent(
+                    LibraryError,
+                    "[ lib] ERROR, %s.",
+                    "Disabling registered buffers for zero-copy sends globally");
+            }
+        } else {
+            InterlockedFetchAndSetBoolean(&SocketContext->SendZeroCopyDisabled);
+        }
+        SendData->ZeroCopyRejected = TRUE;
+        if (!MoreCompletions) {
+            CxPlatSendDataResendCopied(SendData);
+        }
+    } else if (!MoreCompletions) {
+        CxPlatSendDataFree(SendData);
+    }
     SendData = NULL;
 
     if (SocketContext->LockedFlags.Shutdown) {
@@ -2227,7 +2619,9 @@ CxPlatSocketContextSendComplete(
 
 Exit:
 
-    CxPlatSocketIoComplete(SocketContext, IoTagSend);
+    if (!MoreCompletions) {
+        CxPlatSocketIoComplete(SocketContext, IoTagSend);
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
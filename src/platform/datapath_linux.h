@@ -31,6 +31,12 @@
 //
 #define CXPLAT_MAX_IO_BATCH_SIZE ((uint16_t)(CXPLAT_LARGE_IO_BUFFER_SIZE / (1280 - CXPLAT_MIN_IPV6_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE)))
 
+//
+// The maximum number of datagrams sent by a single sendmmsg call when flushing
+// a socket's queued sends.
+//
+#define CXPLAT_MAX_TX_BATCH_SIZE 64
+
 #define CXPLAT_DBG_ASSERT_CMSG(CMsg, type) \
     CXPLAT_DBG_ASSERT((CMsg)->cmsg_len >= CMSG_LEN(sizeof(type)))
 
@@ -164,7 +164,26 @@ RawSocketCreateUdp(
         goto Error;
     }
 
-    CxPlatDpRawPlumbRulesOnSocket(NewSocket, TRUE);
+    Status = CxPlatDpRawPlumbRulesOnSocket(NewSocket, TRUE);
+    if (QUIC_FAILED(Status)) {
+        //
+        // CxPlatDpRawPlumbRulesOnSocket(TRUE) stops at the first interface
+        // where rule installation fails, so roll back any interfaces that
+        // already have state. Cleanup failures are logged but do not change
+        // the returned error.
+        //
+        QUIC_STATUS CleanupStatus = CxPlatDpRawPlumbRulesOnSocket(NewSocket, FALSE);
+        if (QUIC_FAILED(CleanupStatus)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                CleanupStatus,
+                "CxPlatDpRawPlumbRulesOnSocket cleanup");
+        }
+        CxPlatRemoveSocket(&Raw->SocketPool, NewSocket);
+        goto Error;
+    }
+
 Error:
 
     if (QUIC_FAILED(Status)) {
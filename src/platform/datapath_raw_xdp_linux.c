@@ -0,0 +1,1906 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC AF_XDP Datapath Implementation (Linux User Mode)
+
+    Each interface queue gets one AF_XDP socket (XSK) with its own UMEM. The
+    UMEM is split into fixed size chunks: the first RxBufferCount chunks are
+    RX buffers and the remaining TxBufferCount chunks are TX buffers. A small
+    XDP program, attached to the interface once the first socket plumbs its
+    rules, redirects UDP (and QTIP TCP) packets destined to the plumbed ports
+    to the XSK bound to the receiving queue. Queues are distributed across
+    the worker pool partitions, which poll them from an execution context.
+
+--*/
+
+#include "datapath_raw_linux.h"
+#include "datapath_raw_xdp.h"
+#include <linux/bpf.h>
+#include <linux/ethtool.h>
+#include <linux/if_xdp.h>
+#include <linux/sockios.h>
+#include <net/if_arp.h>
+#include <netpacket/packet.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifdef QUIC_CLOG
+#include "datapath_raw_xdp_linux.c.clog.h"
+#endif
+
+#ifdef CXPLAT_USE_IO_URING
+#error "The AF_XDP datapath requires the epoll event queue"
+#endif
+
+//
+// The smallest and largest UMEM chunk sizes supported in aligned mode.
+//
+#define XDP_MIN_CHUNK_SIZE 2048
+#define XDP_MAX_CHUNK_SIZE 4096
+
+//
+// The number of entries in the per-interface port map, indexed by the UDP/TCP
+// destination port in network byte order.
+//
+#define XDP_PORT_MAP_SIZE 65536
+
+//
+// Bits in the port map values, selecting the transport protocols redirected
+// for the port.
+//
+#define XDP_PORT_FLAG_UDP 0x1
+#define XDP_PORT_FLAG_TCP 0x2
+
+//
+// How many times, and how often, to retry binding an XSK to a queue still
+// held by a previously closed XSK.
+//
+#define XDP_BIND_BUSY_RETRY_COUNT 100
+#define XDP_BIND_BUSY_RETRY_INTERVAL_MS 10
+
+//
+// How often to poll for outstanding TX completions once the partition has
+// otherwise gone idle.
+//
+#define XDP_TX_COMPLETION_POLL_US 1000
+
+typedef struct XDP_DATAPATH {
+    CXPLAT_DATAPATH_RAW;
+
+    //
+    // Currently, all XDP interfaces share the same config.
+    //
+    CXPLAT_REF_COUNT RefCount;
+    uint32_t PartitionCount;
+    uint32_t RxBufferCount;
+    uint32_t RxRingSize;
+    uint32_t TxBufferCount;
+    uint32_t TxRingSize;
+    uint32_t ChunkSize;
+    uint32_t RxHeadroom;
+    uint32_t PollingIdleTimeoutUs;
+    BOOLEAN TxAlwaysPoke;
+    BOOLEAN Running;        // Signal to stop partitions.
+
+    XDP_PARTITION Partitions[0];
+} XDP_DATAPATH;
+
+typedef struct XDP_INTERFACE {
+    XDP_INTERFACE_COMMON;
+    int XskMapFd;               // XSKMAP of this interface's XSKs, indexed by queue ID.
+    int PortMapFd;              // XDP_PORT_FLAG_* for each destination port.
+    int ProgramFd;
+    int LinkFd;                 // Attaches ProgramFd to the interface (-1 if not attached).
+    int ExternalXskMapFd;       // XSKMAP used by this interface (-1 if not using map mode).
+    uint32_t RuleCount;         // Number of ports with a non-zero entry in the port map.
+    CXPLAT_LOCK RuleLock;
+} XDP_INTERFACE;
+
+typedef struct XDP_RING {
+    uint32_t* Producer;
+    uint32_t* Consumer;
+    uint32_t* Flags;
+    uint8_t* Elements;
+    uint32_t ElementSize;
+    uint32_t Size;
+    void* Mapping;
+    size_t MappingSize;
+} XDP_RING;
+
+typedef struct CXPLAT_QUEUE {
+    XDP_QUEUE_COMMON;
+    uint32_t QueueId;
+    int Xsk;
+    uint8_t* Umem;
+    size_t UmemSize;
+    uint8_t* TxBuffers;         // Start of the TX chunks within Umem.
+    XDP_RING RxFillRing;
+    XDP_RING RxRing;
+    XDP_RING TxRing;
+    XDP_RING TxCompletionRing;
+    CXPLAT_SQE RxIoSqe;
+    BOOLEAN RxIoSqeInitialized;
+    BOOLEAN XskRegistered;
+
+    CXPLAT_LIST_ENTRY PartitionTxQueue;
+    CXPLAT_SLIST_ENTRY PartitionRxPool;
+
+    //
+    // Buffer pools shared with the threads returning RX buffers and
+    // allocating TX buffers.
+    //
+    CXPLAT_LOCK RxPoolLock;
+    CXPLAT_SLIST_ENTRY RxPool;
+    CXPLAT_LOCK TxPoolLock;
+    CXPLAT_SLIST_ENTRY TxPool;
+
+    CXPLAT_LOCK TxLock;
+    CXPLAT_LIST_ENTRY TxQueue;
+} CXPLAT_QUEUE;
+
+typedef struct XDP_RX_PACKET {
+    // N.B. This struct is also put in a SLIST while the buffer is unused.
+    CXPLAT_QUEUE* Queue;
+    CXPLAT_ROUTE RouteStorage;
+    CXPLAT_RECV_DATA RecvData;
+    // Followed by:
+    // uint8_t ClientContext[...];
+    // uint8_t KernelHeadroom[XDP_PACKET_HEADROOM];
+    // uint8_t FrameBuffer[MAX_ETH_FRAME_SIZE];
+} XDP_RX_PACKET;
+
+typedef struct XDP_TX_PACKET {
+    CXPLAT_SEND_DATA;
+    CXPLAT_QUEUE* Queue;
+    CXPLAT_LIST_ENTRY Link;
+    uint8_t FrameBuffer[MAX_ETH_FRAME_SIZE];
+} XDP_TX_PACKET;
+
+CXPLAT_EVENT_COMPLETION CxPlatIoXdpWaitRxEventComplete;
+CXPLAT_EVENT_COMPLETION CxPlatIoXdpShutdownEventComplete;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatXdpExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    );
+
+//
+// AF_XDP ring helpers. The producer and consumer indexes are free running and
+// shared with the kernel, so they are accessed with acquire/release semantics.
+//
+
+QUIC_INLINE
+uint32_t
+XdpRingConsumerReserve(
+    _In_ XDP_RING* Ring,
+    _In_ uint32_t MaxCount,
+    _Out_ uint32_t* Index
+    )
+{
+    const uint32_t Consumer = *Ring->Consumer;
+    const uint32_t Available =
+        __atomic_load_n(Ring->Producer, __ATOMIC_ACQUIRE) - Consumer;
+    *Index = Consumer;
+    return CXPLAT_MIN(Available, MaxCount);
+}
+
+QUIC_INLINE
+void
+XdpRingConsumerRelease(
+    _In_ XDP_RING* Ring,
+    _In_ uint32_t Count
+    )
+{
+    __atomic_store_n(Ring->Consumer, *Ring->Consumer + Count, __ATOMIC_RELEASE);
+}
+
+QUIC_INLINE
+uint32_t
+XdpRingProducerReserve(
+    _In_ XDP_RING* Ring,
+    _In_ uint32_t MaxCount,
+    _Out_ uint32_t* Index
+    )
+{
+    const uint32_t Producer = *Ring->Producer;
+    const uint32_t Available =
+        Ring->Size - (Producer - __atomic_load_n(Ring->Consumer, __ATOMIC_ACQUIRE));
+    *Index = Producer;
+    return CXPLAT_MIN(Available, MaxCount);
+}
+
+QUIC_INLINE
+void
+XdpRingProducerSubmit(
+    _In_ XDP_RING* Ring,
+    _In_ uint32_t Count
+    )
+{
+    __atomic_store_n(Ring->Producer, *Ring->Producer + Count, __ATOMIC_RELEASE);
+}
+
+QUIC_INLINE
+void*
+XdpRingGetElement(
+    _In_ XDP_RING* Ring,
+    _In_ uint32_t Index
+    )
+{
+    return Ring->Elements + (size_t)(Index & (Ring->Size - 1)) * Ring->ElementSize;
+}
+
+QUIC_INLINE
+BOOLEAN
+XdpRingNeedWakeup(
+    _In_ const XDP_RING* Ring
+    )
+{
+    return !!(__atomic_load_n(Ring->Flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP);
+}
+
+static
+long
+CxPlatXdpBpf(
+    _In_ int Cmd,
+    _Inout_ union bpf_attr* Attr
+    )
+{
+    return syscall(__NR_bpf, Cmd, Attr, sizeof(*Attr));
+}
+
+static
+int
+CxPlatXdpMapCreate(
+    _In_ uint32_t MapType,
+    _In_ uint32_t ValueSize,
+    _In_ uint32_t MaxEntries
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_type = MapType;
+    Attr.key_size = sizeof(uint32_t);
+    Attr.value_size = ValueSize;
+    Attr.max_entries = MaxEntries;
+    return (int)CxPlatXdpBpf(BPF_MAP_CREATE, &Attr);
+}
+
+static
+QUIC_STATUS
+CxPlatXdpMapUpdate(
+    _In_ int MapFd,
+    _In_ uint32_t Key,
+    _In_ const void* Value
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_fd = (uint32_t)MapFd;
+    Attr.key = (uint64_t)(uintptr_t)&Key;
+    Attr.value = (uint64_t)(uintptr_t)Value;
+    Attr.flags = BPF_ANY;
+    return CxPlatXdpBpf(BPF_MAP_UPDATE_ELEM, &Attr) == 0 ? QUIC_STATUS_SUCCESS : (QUIC_STATUS)errno;
+}
+
+static
+QUIC_STATUS
+CxPlatXdpMapLookup(
+    _In_ int MapFd,
+    _In_ uint32_t Key,
+    _Out_ void* Value
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_fd = (uint32_t)MapFd;
+    Attr.key = (uint64_t)(uintptr_t)&Key;
+    Attr.value = (uint64_t)(uintptr_t)Value;
+    return CxPlatXdpBpf(BPF_MAP_LOOKUP_ELEM, &Attr) == 0 ? QUIC_STATUS_SUCCESS : (QUIC_STATUS)errno;
+}
+
+static
+QUIC_STATUS
+CxPlatXdpMapDelete(
+    _In_ int MapFd,
+    _In_ uint32_t Key
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_fd = (uint32_t)MapFd;
+    Attr.key = (uint64_t)(uintptr_t)&Key;
+    return CxPlatXdpBpf(BPF_MAP_DELETE_ELEM, &Attr) == 0 ? QUIC_STATUS_SUCCESS : (QUIC_STATUS)errno;
+}
+
+#define XDP_INSN(Code, Dst, Src, Off, Imm) \
+    { .code = (Code), .dst_reg = (Dst), .src_reg = (Src), .off = (Off), .imm = (Imm) }
+
+//
+// Loads the XDP program for an interface. It is equivalent to:
+//
+//  if (eth->h_proto is IPv4 without options or IPv6 without extensions &&
+//      ip->protocol is UDP or TCP &&
+//      PortMap[l4->dest] & (UDP ? XDP_PORT_FLAG_UDP : XDP_PORT_FLAG_TCP)) {
+//      return bpf_redirect_map(&XskMap, ctx->rx_queue_index, XDP_PASS);
+//  }
+//  return XDP_PASS;
+//
+// Jump offsets are relative to the next instruction and are annotated with the
+// index of their target.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+int
+CxPlatXdpProgramLoad(
+    _In_ const XDP_INTERFACE* Interface
+    )
+{
+    const struct bpf_insn Program[] = {
+        /* 0*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0),
+        /* 1*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, data), 0),
+        /* 2*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_3, BPF_REG_6, offsetof(struct xdp_md, data_end), 0),
+        /* 3*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+        /* 4*/ XDP_INSN(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, sizeof(ETHERNET_HEADER)),
+        /* 5*/ XDP_INSN(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 36, 0),    // -> 42
+        /* 6*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_H, BPF_REG_5, BPF_REG_2, offsetof(ETHERNET_HEADER, Type), 0),
+        /* 7*/ XDP_INSN(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_5, 0, 7, ETHERNET_TYPE_IPV4), // -> 15
+        /* 8*/ XDP_INSN(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_5, 0, 33, ETHERNET_TYPE_IPV6), // -> 42
+
+        //
+        // IPv6: r7 = next header, r5 = destination port.
+        //
+        /* 9*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+        /*10*/ XDP_INSN(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, sizeof(ETHERNET_HEADER) + sizeof(IPV6_HEADER) + 4),
+        /*11*/ XDP_INSN(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 30, 0),   // -> 42
+        /*12*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, BPF_REG_7, BPF_REG_2, sizeof(ETHERNET_HEADER) + offsetof(IPV6_HEADER, NextHeader), 0),
+        /*13*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_H, BPF_REG_5, BPF_REG_2, sizeof(ETHERNET_HEADER) + sizeof(IPV6_HEADER) + 2, 0),
+        /*14*/ XDP_INSN(BPF_JMP | BPF_JA, 0, 0, 7, 0),                              // -> 22
+
+        //
+        // IPv4: r7 = protocol, r5 = destination port.
+        //
+        /*15*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+        /*16*/ XDP_INSN(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, sizeof(ETHERNET_HEADER) + sizeof(IPV4_HEADER) + 4),
+        /*17*/ XDP_INSN(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 24, 0),   // -> 42
+        /*18*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, BPF_REG_4, BPF_REG_2, sizeof(ETHERNET_HEADER), 0),
+        /*19*/ XDP_INSN(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_4, 0, 22, IPV4_DEFAULT_VERHLEN), // -> 42
+        /*20*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, BPF_REG_7, BPF_REG_2, sizeof(ETHERNET_HEADER) + offsetof(IPV4_HEADER, Protocol), 0),
+        /*21*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_H, BPF_REG_5, BPF_REG_2, sizeof(ETHERNET_HEADER) + sizeof(IPV4_HEADER) + 2, 0),
+
+        //
+        // r8 = the port flag for the transport protocol.
+        //
+        /*22*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_8, 0, 0, XDP_PORT_FLAG_UDP),
+        /*23*/ XDP_INSN(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_7, 0, 2, IPPROTO_UDP),  // -> 26
+        /*24*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_8, 0, 0, XDP_PORT_FLAG_TCP),
+        /*25*/ XDP_INSN(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_7, 0, 16, IPPROTO_TCP), // -> 42
+
+        //
+        // Look up the port's flags and redirect on a match.
+        //
+        /*26*/ XDP_INSN(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, BPF_REG_5, -4, 0),
+        /*27*/ XDP_INSN(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, Interface->PortMapFd),
+        /*28*/ XDP_INSN(0, 0, 0, 0, 0),
+        /*29*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0),
+        /*30*/ XDP_INSN(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, -4),
+        /*31*/ XDP_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem),
+        /*32*/ XDP_INSN(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 9, 0),            // -> 42
+        /*33*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, BPF_REG_5, BPF_REG_0, 0, 0),
+        /*34*/ XDP_INSN(BPF_ALU64 | BPF_AND | BPF_X, BPF_REG_5, BPF_REG_8, 0, 0),
+        /*35*/ XDP_INSN(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_5, 0, 6, 0),            // -> 42
+        /*36*/ XDP_INSN(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, rx_queue_index), 0),
+        /*37*/ XDP_INSN(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, Interface->XskMapFd),
+        /*38*/ XDP_INSN(0, 0, 0, 0, 0),
+        /*39*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS),
+        /*40*/ XDP_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+        /*41*/ XDP_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+
+        //
+        // Pass the packet up the stack.
+        //
+        /*42*/ XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS),
+        /*43*/ XDP_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+    };
+
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.prog_type = BPF_PROG_TYPE_XDP;
+    Attr.insns = (uint64_t)(uintptr_t)Program;
+    Attr.insn_cnt = ARRAYSIZE(Program);
+    Attr.license = (uint64_t)(uintptr_t)"Dual MIT/GPL";
+    memcpy(Attr.prog_name, "msquic_xdp", sizeof("msquic_xdp"));
+    return (int)CxPlatXdpBpf(BPF_PROG_LOAD, &Attr);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Requires_lock_held_(Interface->RuleLock)
+static
+QUIC_STATUS
+CxPlatXdpProgramAttach(
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    if (Interface->LinkFd != -1) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.link_create.prog_fd = (uint32_t)Interface->ProgramFd;
+    Attr.link_create.target_ifindex = Interface->ActualIfIndex;
+    Attr.link_create.attach_type = BPF_XDP;
+    Interface->LinkFd = (int)CxPlatXdpBpf(BPF_LINK_CREATE, &Attr);
+    if (Interface->LinkFd == -1) {
+        QUIC_STATUS Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_LINK_CREATE");
+        return Status;
+    }
+
+    QuicTraceLogVerbose(
+        XdpProgramAttached,
+        "[ixdp][%p] XDP program attached to interface %u",
+        Interface,
+        Interface->ActualIfIndex);
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Returns the number of RX queues of the interface, or 1 if it can't be
+// queried.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+uint16_t
+CxPlatXdpGetQueueCount(
+    _In_ uint32_t InterfaceIndex
+    )
+{
+    uint32_t QueueCount = 1;
+    struct ethtool_channels Channels;
+    struct ifreq Request;
+    CxPlatZeroMemory(&Channels, sizeof(Channels));
+    CxPlatZeroMemory(&Request, sizeof(Request));
+    Channels.cmd = ETHTOOL_GCHANNELS;
+    Request.ifr_data = (char*)&Channels;
+
+    int Socket = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (Socket == -1) {
+        return 1;
+    }
+
+    if (if_indextoname(InterfaceIndex, Request.ifr_name) != NULL &&
+        ioctl(Socket, SIOCETHTOOL, &Request) == 0 &&
+        Channels.rx_count + Channels.combined_count > 0) {
+        QueueCount = Channels.rx_count + Channels.combined_count;
+    }
+
+    close(Socket);
+    return (uint16_t)CXPLAT_MIN(QueueCount, UINT16_MAX);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+CxPlatXdpRingMap(
+    _In_ int Xsk,
+    _In_ const struct xdp_ring_offset* Offsets,
+    _In_ uint32_t Size,
+    _In_ uint32_t ElementSize,
+    _In_ off_t PageOffset,
+    _Out_ XDP_RING* Ring
+    )
+{
+    Ring->MappingSize = Offsets->desc + (size_t)Size * ElementSize;
+    Ring->Mapping =
+        mmap(
+            NULL, Ring->MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            Xsk, PageOffset);
+    if (Ring->Mapping == MAP_FAILED) {
+        Ring->Mapping = NULL;
+        return (QUIC_STATUS)errno;
+    }
+
+    Ring->Producer = (uint32_t*)((uint8_t*)Ring->Mapping + Offsets->producer);
+    Ring->Consumer = (uint32_t*)((uint8_t*)Ring->Mapping + Offsets->consumer);
+    Ring->Flags = (uint32_t*)((uint8_t*)Ring->Mapping + Offsets->flags);
+    Ring->Elements = (uint8_t*)Ring->Mapping + Offsets->desc;
+    Ring->ElementSize = ElementSize;
+    Ring->Size = Size;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+CxPlatXdpRingUnmap(
+    _Inout_ XDP_RING* Ring
+    )
+{
+    if (Ring->Mapping != NULL) {
+        munmap(Ring->Mapping, Ring->MappingSize);
+        Ring->Mapping = NULL;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawInterfaceUninitialize(
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    for (uint32_t i = 0; Interface->Queues != NULL && i < Interface->QueueCount; i++) {
+        CXPLAT_QUEUE *Queue = &Interface->Queues[i];
+
+        if (Queue->XskRegistered) {
+            CxPlatXdpMapDelete(Interface->XskMapFd, Queue->QueueId);
+        }
+
+        CxPlatXdpRingUnmap(&Queue->TxCompletionRing);
+        CxPlatXdpRingUnmap(&Queue->TxRing);
+        CxPlatXdpRingUnmap(&Queue->RxRing);
+        CxPlatXdpRingUnmap(&Queue->RxFillRing);
+
+        if (Queue->Xsk != -1) {
+            close(Queue->Xsk);
+        }
+
+        if (Queue->Umem != NULL) {
+            munmap(Queue->Umem, Queue->UmemSize);
+        }
+
+        CxPlatLockUninitialize(&Queue->TxLock);
+        CxPlatLockUninitialize(&Queue->TxPoolLock);
+        CxPlatLockUninitialize(&Queue->RxPoolLock);
+    }
+
+    if (Interface->Queues != NULL) {
+        CXPLAT_FREE(Interface->Queues, QUEUE_TAG);
+    }
+
+    if (Interface->LinkFd != -1) {
+        close(Interface->LinkFd);
+    }
+
+    if (Interface->ProgramFd != -1) {
+        close(Interface->ProgramFd);
+    }
+
+    if (Interface->PortMapFd != -1) {
+        close(Interface->PortMapFd);
+    }
+
+    if (Interface->XskMapFd != -1) {
+        close(Interface->XskMapFd);
+    }
+
+    CxPlatLockUninitialize(&Interface->RuleLock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+CxPlatDpRawQueueInitialize(
+    _In_ XDP_DATAPATH* Xdp,
+    _In_ XDP_INTERFACE* Interface,
+    _Inout_ CXPLAT_QUEUE* Queue
+    )
+{
+    QUIC_STATUS Status;
+    const uint32_t ChunkCount = Xdp->RxBufferCount + Xdp->TxBufferCount;
+
+    Queue->UmemSize = (size_t)ChunkCount * Xdp->ChunkSize;
+    Queue->Umem =
+        mmap(
+            NULL, Queue->UmemSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+            -1, 0);
+    if (Queue->Umem == MAP_FAILED) {
+        Queue->Umem = NULL;
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP UMEM",
+            Queue->UmemSize);
+        goto Error;
+    }
+    Queue->TxBuffers = Queue->Umem + (size_t)Xdp->RxBufferCount * Xdp->ChunkSize;
+
+    Queue->Xsk = socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (Queue->Xsk == -1) {
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "socket(AF_XDP)");
+        goto Error;
+    }
+
+    struct xdp_umem_reg UmemReg;
+    CxPlatZeroMemory(&UmemReg, sizeof(UmemReg));
+    UmemReg.addr = (uint64_t)(uintptr_t)Queue->Umem;
+    UmemReg.len = Queue->UmemSize;
+    UmemReg.chunk_size = Xdp->ChunkSize;
+    UmemReg.headroom = Xdp->RxHeadroom;
+    if (setsockopt(Queue->Xsk, SOL_XDP, XDP_UMEM_REG, &UmemReg, sizeof(UmemReg)) != 0) {
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "setsockopt(XDP_UMEM_REG)");
+        goto Error;
+    }
+
+    if (setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_UMEM_FILL_RING, &Xdp->RxRingSize,
+            sizeof(Xdp->RxRingSize)) != 0 ||
+        setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_RX_RING, &Xdp->RxRingSize,
+            sizeof(Xdp->RxRingSize)) != 0 ||
+        setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_UMEM_COMPLETION_RING, &Xdp->TxRingSize,
+            sizeof(Xdp->TxRingSize)) != 0 ||
+        setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_TX_RING, &Xdp->TxRingSize,
+            sizeof(Xdp->TxRingSize)) != 0) {
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "setsockopt(XDP ring size)");
+        goto Error;
+    }
+
+    struct xdp_mmap_offsets Offsets;
+    socklen_t OffsetsLength = sizeof(Offsets);
+    if (getsockopt(Queue->Xsk, SOL_XDP, XDP_MMAP_OFFSETS, &Offsets, &OffsetsLength) != 0) {
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "getsockopt(XDP_MMAP_OFFSETS)");
+        goto Error;
+    }
+
+    if (QUIC_FAILED(Status =
+            CxPlatXdpRingMap(
+                Queue->Xsk, &Offsets.fr, Xdp->RxRingSize, sizeof(uint64_t),
+                (off_t)XDP_UMEM_PGOFF_FILL_RING, &Queue->RxFillRing))    ||
+        QUIC_FAILED(Status =
+            CxPlatXdpRingMap(
+                Queue->Xsk, &Offsets.rx, Xdp->RxRingSize, sizeof(struct xdp_desc),
+                (off_t)XDP_PGOFF_RX_RING, &Queue->RxRing))               ||
+        QUIC_FAILED(Status =
+            CxPlatXdpRingMap(
+                Queue->Xsk, &Offsets.cr, Xdp->TxRingSize, sizeof(uint64_t),
+                (off_t)XDP_UMEM_PGOFF_COMPLETION_RING, &Queue->TxCompletionRing)) ||
+        QUIC_FAILED(Status =
+            CxPlatXdpRingMap(
+                Queue->Xsk, &Offsets.tx, Xdp->TxRingSize, sizeof(struct xdp_desc),
+                (off_t)XDP_PGOFF_TX_RING, &Queue->TxRing))) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(XDP ring)");
+        goto Error;
+    }
+
+    //
+    // Let the kernel fall back to copy mode if the driver doesn't support zero
+    // copy, and to always-wakeup mode if the kernel predates need_wakeup.
+    //
+    // N.B. The kernel releases a closed XSK's buffer pool asynchronously, so
+    // the queue may briefly remain busy after a previous datapath shut down.
+    //
+    struct sockaddr_xdp Address;
+    CxPlatZeroMemory(&Address, sizeof(Address));
+    Address.sxdp_family = AF_XDP;
+    Address.sxdp_ifindex = Interface->ActualIfIndex;
+    Address.sxdp_queue_id = Queue->QueueId;
+    Address.sxdp_flags = XDP_USE_NEED_WAKEUP;
+    int BindResult;
+    uint32_t BindAttempts = 0;
+    while ((BindResult = bind(Queue->Xsk, (struct sockaddr*)&Address, sizeof(Address))) != 0 &&
+           errno == EBUSY && ++BindAttempts < XDP_BIND_BUSY_RETRY_COUNT) {
+        CxPlatSleep(XDP_BIND_BUSY_RETRY_INTERVAL_MS);
+    }
+    if (BindResult != 0) {
+        Address.sxdp_flags = 0;
+        if (errno != EINVAL ||
+            bind(Queue->Xsk, (struct sockaddr*)&Address, sizeof(Address)) != 0) {
+            Status = (QUIC_STATUS)errno;
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "bind(AF_XDP)");
+            goto Error;
+        }
+        Xdp->TxAlwaysPoke = TRUE;
+    }
+
+    Status = CxPlatXdpMapUpdate(Interface->XskMapFd, Queue->QueueId, &Queue->Xsk);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_MAP_UPDATE_ELEM(XSKMAP)");
+        goto Error;
+    }
+    Queue->XskRegistered = TRUE;
+
+    for (uint32_t i = 0; i < Xdp->RxBufferCount; i++) {
+        XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)(Queue->Umem + (size_t)i * Xdp->ChunkSize);
+        CxPlatListPushEntry(&Queue->RxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+    }
+
+    for (uint32_t i = 0; i < Xdp->TxBufferCount; i++) {
+        XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)(Queue->TxBuffers + (size_t)i * Xdp->ChunkSize);
+        CxPlatListPushEntry(&Queue->TxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+    }
+
+Error:
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawInterfaceInitialize(
+    _In_ XDP_DATAPATH* Xdp,
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    QUIC_STATUS Status;
+
+    CxPlatLockInitialize(&Interface->RuleLock);
+    Interface->Xdp = Xdp;
+    Interface->XskMapFd = -1;
+    Interface->PortMapFd = -1;
+    Interface->ProgramFd = -1;
+    Interface->LinkFd = -1;
+    Interface->ExternalXskMapFd = -1;
+
+    Interface->QueueCount = CxPlatXdpGetQueueCount(Interface->ActualIfIndex);
+
+    Interface->XskMapFd =
+        CxPlatXdpMapCreate(BPF_MAP_TYPE_XSKMAP, sizeof(int), Interface->QueueCount);
+    Interface->PortMapFd =
+        CxPlatXdpMapCreate(BPF_MAP_TYPE_ARRAY, sizeof(uint8_t), XDP_PORT_MAP_SIZE);
+    if (Interface->XskMapFd == -1 || Interface->PortMapFd == -1) {
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_MAP_CREATE");
+        goto Error;
+    }
+
+    Interface->ProgramFd = CxPlatXdpProgramLoad(Interface);
+    if (Interface->ProgramFd == -1) {
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_PROG_LOAD");
+        goto Error;
+    }
+
+    QuicTraceLogVerbose(
+        XdpInterfaceQueues,
+        "[ixdp][%p] Initializing %u queues on interface",
+        Interface,
+        Interface->QueueCount);
+
+    Interface->Queues = CXPLAT_ALLOC_NONPAGED(Interface->QueueCount * sizeof(*Interface->Queues), QUEUE_TAG);
+    if (Interface->Queues == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP Queues",
+            Interface->QueueCount * sizeof(*Interface->Queues));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
+    CxPlatZeroMemory(Interface->Queues, Interface->QueueCount * sizeof(*Interface->Queues));
+
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        CXPLAT_QUEUE* Queue = &Interface->Queues[i];
+
+        Queue->QueueId = i;
+        Queue->Xsk = -1;
+        Queue->Interface = Interface;
+        CxPlatLockInitialize(&Queue->RxPoolLock);
+        CxPlatLockInitialize(&Queue->TxPoolLock);
+        CxPlatLockInitialize(&Queue->TxLock);
+        CxPlatListInitializeHead(&Queue->TxQueue);
+        CxPlatListInitializeHead(&Queue->PartitionTxQueue);
+    }
+
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        Status = CxPlatDpRawQueueInitialize(Xdp, Interface, &Interface->Queues[i]);
+        if (QUIC_FAILED(Status)) {
+            if (i > 0 && Status == EINVAL) {
+                //
+                // The interface has fewer queues than reported. Use the ones
+                // that were successfully bound.
+                //
+                QuicTraceLogWarning(
+                    XdpInterfaceQueueTruncated,
+                    "[ixdp][%p] Only %u queues usable on interface",
+                    Interface,
+                    i);
+                CXPLAT_QUEUE* Queue = &Interface->Queues[i];
+                CxPlatXdpRingUnmap(&Queue->TxCompletionRing);
+                CxPlatXdpRingUnmap(&Queue->TxRing);
+                CxPlatXdpRingUnmap(&Queue->RxRing);
+                CxPlatXdpRingUnmap(&Queue->RxFillRing);
+                if (Queue->Xsk != -1) {
+                    close(Queue->Xsk);
+                }
+                if (Queue->Umem != NULL) {
+                    munmap(Queue->Umem, Queue->UmemSize);
+                }
+                for (uint16_t j = i; j < Interface->QueueCount; j++) {
+                    CxPlatLockUninitialize(&Interface->Queues[j].TxLock);
+                    CxPlatLockUninitialize(&Interface->Queues[j].TxPoolLock);
+                    CxPlatLockUninitialize(&Interface->Queues[j].RxPoolLock);
+                }
+                Interface->QueueCount = i;
+                Status = QUIC_STATUS_SUCCESS;
+                break;
+            }
+            goto Error;
+        }
+    }
+
+    //
+    // Add each queue to a partition. Queue N is usually serviced by the Nth
+    // processor, so spread the queues in order.
+    //
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        XdpWorkerAddQueue(
+            &Xdp->Partitions[i % Xdp->PartitionCount],
+            &Interface->Queues[i]);
+    }
+
+Error:
+    if (QUIC_FAILED(Status)) {
+        CxPlatDpRawInterfaceUninitialize(Interface);
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+size_t
+CxPlatDpRawGetDatapathSize(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool
+    )
+{
+    const uint32_t PartitionCount = CxPlatWorkerPoolGetCount(WorkerPool);
+    return sizeof(XDP_DATAPATH) + (PartitionCount * sizeof(XDP_PARTITION));
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawInitialize(
+    _Inout_ CXPLAT_DATAPATH_RAW* Datapath,
+    _In_ uint32_t ClientRecvContextLength,
+    _In_ CXPLAT_WORKER_POOL* WorkerPool
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    struct ifaddrs* Addresses = NULL;
+
+    CxPlatListInitializeHead(&Xdp->Interfaces);
+    Xdp->PollingIdleTimeoutUs = 0;
+    Xdp->PartitionCount = CxPlatWorkerPoolGetCount(WorkerPool);
+    for (uint32_t i = 0; i < Xdp->PartitionCount; i++) {
+        Xdp->Partitions[i].Processor = (uint16_t)
+            CxPlatWorkerPoolGetIdealProcessor(WorkerPool, i);
+    }
+
+    //
+    // The UMEM is registered with (and pinned by) the kernel for each queue,
+    // so use fewer buffers than the Windows XDP datapath does.
+    //
+    Xdp->RxBufferCount = 2048;
+    Xdp->RxRingSize = 512;
+    Xdp->TxBufferCount = 2048;
+    Xdp->TxRingSize = 512;
+    Xdp->TxAlwaysPoke = FALSE;
+
+    //
+    // RX chunks start with the packet metadata and client context, followed by
+    // the headroom the kernel reserves for XDP programs and then the frame.
+    //
+    Xdp->RxHeadroom =
+        (uint32_t)ALIGN_UP(
+            sizeof(XDP_RX_PACKET) + ALIGN_UP(ClientRecvContextLength, uint32_t),
+            uint64_t);
+    const uint32_t ChunkSize =
+        CXPLAT_MAX(
+            Xdp->RxHeadroom + XDP_PACKET_HEADROOM + MAX_ETH_FRAME_SIZE,
+            (uint32_t)sizeof(XDP_TX_PACKET));
+    Xdp->ChunkSize = XDP_MIN_CHUNK_SIZE;
+    while (Xdp->ChunkSize < ChunkSize) {
+        Xdp->ChunkSize <<= 1;
+    }
+    if (Xdp->ChunkSize > XDP_MAX_CHUNK_SIZE) {
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            ChunkSize,
+            "XDP RX headroom too large");
+        goto Error;
+    }
+
+    if (getifaddrs(&Addresses) != 0) {
+        Status = (QUIC_STATUS)errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "getifaddrs");
+        goto Error;
+    }
+
+    for (struct ifaddrs* Address = Addresses; Address != NULL; Address = Address->ifa_next) {
+        const struct sockaddr_ll* LinkAddress = (const struct sockaddr_ll*)Address->ifa_addr;
+        if (LinkAddress == NULL ||
+            LinkAddress->sll_family != AF_PACKET ||
+            LinkAddress->sll_hatype != ARPHRD_ETHER ||
+            LinkAddress->sll_halen != ETH_MAC_ADDR_LEN ||
+            !(Address->ifa_flags & IFF_UP) ||
+            (Address->ifa_flags & IFF_LOOPBACK)) {
+            continue;
+        }
+
+        XDP_INTERFACE* Interface = CXPLAT_ALLOC_NONPAGED(sizeof(XDP_INTERFACE), IF_TAG);
+        if (Interface == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "XDP interface",
+                sizeof(*Interface));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        CxPlatZeroMemory(Interface, sizeof(*Interface));
+        Interface->ActualIfIndex = Interface->IfIndex = (uint32_t)LinkAddress->sll_ifindex;
+        memcpy(
+            Interface->PhysicalAddress, LinkAddress->sll_addr,
+            sizeof(Interface->PhysicalAddress));
+
+        QuicTraceLogVerbose(
+            XdpInterfaceInitialize,
+            "[ixdp][%p] Initializing interface %u",
+            Interface,
+            Interface->ActualIfIndex);
+
+        Status = CxPlatDpRawInterfaceInitialize(Xdp, Interface);
+        if ((Status == EPERM || Status == EAFNOSUPPORT) && CxPlatListIsEmpty(&Xdp->Interfaces)) {
+            //
+            // Missing privileges or kernel support for the first interface
+            // means that XDP is not available to this process.
+            //
+            CXPLAT_FREE(Interface, IF_TAG);
+            Status = QUIC_STATUS_NOT_SUPPORTED;
+            break;
+        } else if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "CxPlatDpRawInterfaceInitialize");
+            CXPLAT_FREE(Interface, IF_TAG);
+            continue;
+        }
+        CxPlatListInsertTail(&Xdp->Interfaces, &Interface->Link);
+    }
+
+    if (CxPlatListIsEmpty(&Xdp->Interfaces)) {
+        if (Status == QUIC_STATUS_NOT_SUPPORTED) {
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "XDP is not supported on this system");
+        } else {
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "no XDP capable interface");
+            Status = QUIC_STATUS_NOT_FOUND;
+        }
+        goto Error;
+    }
+
+    Xdp->Running = TRUE;
+    CxPlatRefInitialize(&Xdp->RefCount);
+    for (uint32_t i = 0; i < Xdp->PartitionCount; i++) {
+
+        XDP_PARTITION* Partition = &Xdp->Partitions[i];
+        if (Partition->Queues == NULL) { continue; } // No queues for this partition.
+
+        Partition->Xdp = Xdp;
+        Partition->PartitionIndex = (uint16_t)i;
+        Partition->Ec.Ready = TRUE;
+        Partition->Ec.NextTimeUs = UINT64_MAX;
+        Partition->Ec.Callback = CxPlatXdpExecute;
+        Partition->Ec.Context = &Xdp->Partitions[i];
+        Partition->EventQ = CxPlatWorkerPoolGetEventQ(WorkerPool, (uint16_t)i);
+        CXPLAT_FRE_ASSERT(
+            CxPlatSqeInitialize(
+                Partition->EventQ, CxPlatIoXdpShutdownEventComplete, &Partition->ShutdownSqe));
+        CxPlatRefIncrement(&Xdp->RefCount);
+
+        uint32_t QueueCount = 0;
+        CXPLAT_QUEUE* Queue = Partition->Queues;
+        while (Queue) {
+            //
+            // The XSK is registered disarmed and only armed (one shot) once the
+            // partition stops polling.
+            //
+            if (CxPlatSqeInitialize(
+                    Partition->EventQ, CxPlatIoXdpWaitRxEventComplete, &Queue->RxIoSqe)) {
+                struct epoll_event Event = {
+                    .events = EPOLLONESHOT, .data = { .ptr = &Queue->RxIoSqe } };
+                Queue->RxIoSqeInitialized = TRUE;
+                if (epoll_ctl(*Partition->EventQ, EPOLL_CTL_ADD, Queue->Xsk, &Event) != 0) {
+                    QuicTraceEvent(
+                        LibraryErrorStatus,
+                        "[ lib] ERROR, %u, %s.",
+                        errno,
+                        "epoll_ctl(XSK)");
+                }
+            } else {
+                QuicTraceEvent(
+                    LibraryErrorStatus,
+                    "[ lib] ERROR, %u, %s.",
+                    errno,
+                    "CxPlatSqeInitialize(RX)");
+            }
+            QuicTraceLogVerbose(
+                XdpQueueStart,
+                "[ xdp][%p] XDP queue start on partition %p",
+                Queue,
+                Partition);
+            ++QueueCount;
+            Queue = Queue->Next;
+        }
+
+        QuicTraceLogVerbose(
+            XdpWorkerStart,
+            "[ xdp][%p] XDP partition start, %u queues",
+            Partition,
+            QueueCount);
+        UNREFERENCED_PARAMETER(QueueCount);
+
+        CxPlatWorkerPoolAddExecutionContext(
+            WorkerPool, &Partition->Ec, Partition->PartitionIndex);
+    }
+    Status = QUIC_STATUS_SUCCESS;
+
+    QuicTraceLogVerbose(
+        XdpInitialize,
+        "[ xdp][%p] XDP initialized, %u procs",
+        Xdp,
+        Xdp->PartitionCount);
+
+Error:
+    if (Addresses != NULL) {
+        freeifaddrs(Addresses);
+    }
+
+    if (QUIC_FAILED(Status)) {
+        while (!CxPlatListIsEmpty(&Xdp->Interfaces)) {
+            XDP_INTERFACE* Interface =
+                CXPLAT_CONTAINING_RECORD(CxPlatListRemoveHead(&Xdp->Interfaces), XDP_INTERFACE, Link);
+            CxPlatDpRawInterfaceUninitialize(Interface);
+            CXPLAT_FREE(Interface, IF_TAG);
+        }
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawRelease(
+    _In_ XDP_DATAPATH* Xdp
+    )
+{
+    QuicTraceLogVerbose(
+        XdpRelease,
+        "[ xdp][%p] XDP release",
+        Xdp);
+    if (CxPlatRefDecrement(&Xdp->RefCount)) {
+        QuicTraceLogVerbose(
+            XdpUninitializeComplete,
+            "[ xdp][%p] XDP uninitialize complete",
+            Xdp);
+        while (!CxPlatListIsEmpty(&Xdp->Interfaces)) {
+            XDP_INTERFACE* Interface =
+                CXPLAT_CONTAINING_RECORD(CxPlatListRemoveHead(&Xdp->Interfaces), XDP_INTERFACE, Link);
+            CxPlatDpRawInterfaceUninitialize(Interface);
+            CXPLAT_FREE(Interface, IF_TAG);
+        }
+        CxPlatDataPathUninitializeComplete((CXPLAT_DATAPATH_RAW*)Xdp);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawUninitialize(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    QuicTraceLogVerbose(
+        XdpUninitialize,
+        "[ xdp][%p] XDP uninitialize",
+        Xdp);
+    Xdp->Running = FALSE;
+    for (uint32_t i = 0; i < Xdp->PartitionCount; i++) {
+        if (Xdp->Partitions[i].Queues != NULL) {
+            Xdp->Partitions[i].Ec.Ready = TRUE;
+            CxPlatWakeExecutionContext(&Xdp->Partitions[i].Ec);
+        }
+    }
+    CxPlatDpRawRelease(Xdp);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawUpdatePollingIdleTimeout(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _In_ uint32_t PollingIdleTimeoutUs
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    Xdp->PollingIdleTimeoutUs = PollingIdleTimeoutUs;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+RawSocketUpdateQeo(
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _In_reads_(OffloadCount)
+        const CXPLAT_QEO_CONNECTION* Offloads,
+    _In_ uint32_t OffloadCount
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Offloads);
+    UNREFERENCED_PARAMETER(OffloadCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+//
+// Sets (IsCreated) or clears the given port flags in the interface's port map,
+// attaching the XDP program on first use.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+CxPlatDpRawInterfaceUpdatePort(
+    _Inout_ XDP_INTERFACE* Interface,
+    _In_ uint16_t Port,
+    _In_ uint8_t PortFlags,
+    _In_ BOOLEAN IsCreated
+    )
+{
+    QUIC_STATUS Status;
+    uint8_t OldFlags = 0;
+    uint8_t NewFlags;
+
+    CxPlatLockAcquire(&Interface->RuleLock);
+
+    if (IsCreated) {
+        Status = CxPlatXdpProgramAttach(Interface);
+        if (QUIC_FAILED(Status)) {
+            goto Exit;
+        }
+    }
+
+    Status = CxPlatXdpMapLookup(Interface->PortMapFd, Port, &OldFlags);
+    if (QUIC_FAILED(Status)) {
+        goto Exit;
+    }
+
+    NewFlags = IsCreated ? (OldFlags | PortFlags) : (OldFlags & ~PortFlags);
+    if (NewFlags == OldFlags) {
+        goto Exit;
+    }
+
+    Status = CxPlatXdpMapUpdate(Interface->PortMapFd, Port, &NewFlags);
+    if (QUIC_FAILED(Status)) {
+        goto Exit;
+    }
+
+    if (OldFlags == 0) {
+        Interface->RuleCount++;
+    } else if (NewFlags == 0) {
+        Interface->RuleCount--;
+    }
+
+Exit:
+
+    CxPlatLockRelease(&Interface->RuleLock);
+
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "CxPlatDpRawInterfaceUpdatePort");
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawPlumbRulesOnSocket(
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _In_ BOOLEAN IsCreated
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Socket->RawDatapath;
+
+    //
+    // In map mode, the application manages XDP rules.
+    //
+    if (CxPlatDpRawIsRawDatapathOnly((CXPLAT_DATAPATH_RAW*)Xdp)) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    //
+    // The port map is indexed by the port in network byte order, which is how
+    // the XDP program reads it from the packet. Connected QTIP sockets only
+    // receive TCP, while listeners receive QUIC over both.
+    //
+    // N.B. The XDP program matches on port only, so CIBIR sockets redirect all
+    // traffic to their port and local addresses aren't matched.
+    //
+    const uint16_t Port = Socket->LocalAddress.Ipv4.sin_port;
+    uint8_t PortFlags;
+    if (Socket->Wildcard) {
+        PortFlags = XDP_PORT_FLAG_UDP;
+        if (Socket->ReserveAuxTcpSockForQtip) {
+            PortFlags |= XDP_PORT_FLAG_TCP;
+        }
+    } else {
+        PortFlags = Socket->ReserveAuxTcpSockForQtip ? XDP_PORT_FLAG_TCP : XDP_PORT_FLAG_UDP;
+    }
+
+    //
+    // TODO - Optimization: apply only to the correct interface.
+    //
+    CXPLAT_LIST_ENTRY* Entry;
+    for (Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        QUIC_STATUS UpdateStatus =
+            CxPlatDpRawInterfaceUpdatePort(Interface, Port, PortFlags, IsCreated);
+        if (QUIC_FAILED(UpdateStatus)) {
+            Status = UpdateStatus;
+            if (IsCreated) {
+                //
+                // Stop on first failure and propagate. The caller is
+                // responsible for invoking this function again with
+                // IsCreated=FALSE to roll back any ports already set on
+                // previous interfaces.
+                //
+                break;
+            }
+        }
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatDpRawIsL3TxXsumOffloadedOnQueue(
+    _In_ const CXPLAT_QUEUE* Queue
+    )
+{
+    UNREFERENCED_PARAMETER(Queue);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatDpRawIsL4TxXsumOffloadedOnQueue(
+    _In_ const CXPLAT_QUEUE* Queue
+    )
+{
+    UNREFERENCED_PARAMETER(Queue);
+    return FALSE;
+}
+
+static
+BOOLEAN // Did work?
+CxPlatXdpRx(
+    _In_ const XDP_DATAPATH* Xdp,
+    _In_ CXPLAT_QUEUE* Queue,
+    _In_ uint16_t PartitionIndex
+    )
+{
+    CXPLAT_RECV_DATA* Buffers[RX_BATCH_SIZE];
+    uint32_t RxIndex;
+    uint32_t FillIndex;
+    uint32_t ProdCount = 0;
+    uint32_t PacketCount = 0;
+    const uint32_t BuffersCount = XdpRingConsumerReserve(&Queue->RxRing, RX_BATCH_SIZE, &RxIndex);
+
+    for (uint32_t i = 0; i < BuffersCount; i++) {
+        const struct xdp_desc* Buffer = XdpRingGetElement(&Queue->RxRing, RxIndex++);
+        XDP_RX_PACKET* Packet =
+            (XDP_RX_PACKET*)(Queue->Umem + ALIGN_DOWN_BY(Buffer->addr, Xdp->ChunkSize));
+        uint8_t* FrameBuffer = Queue->Umem + Buffer->addr;
+
+        CxPlatZeroMemory(Packet, sizeof(XDP_RX_PACKET));
+        Packet->Queue = Queue;
+        Packet->RouteStorage.Queue = Queue;
+        Packet->RecvData.Route = &Packet->RouteStorage;
+        Packet->RecvData.Route->DatapathType = Packet->RecvData.DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
+        Packet->RecvData.PartitionIndex = PartitionIndex;
+
+        CxPlatDpRawParseEthernet(
+            (CXPLAT_DATAPATH*)Xdp,
+            &Packet->RecvData,
+            FrameBuffer,
+            (uint16_t)Buffer->len);
+
+        //
+        // The route has been filled in with the packet's src/dst IP and ETH addresses, so
+        // mark it resolved. This allows stateless sends to be issued without performing
+        // a route lookup.
+        //
+        Packet->RecvData.Route->State = RouteResolved;
+        CXPLAT_DBG_ASSERT(Packet->RecvData.Route->Queue != NULL);
+
+        if (Packet->RecvData.Buffer) {
+            Packet->RecvData.Allocated = TRUE;
+            Buffers[PacketCount++] = &Packet->RecvData;
+        } else {
+            CxPlatListPushEntry(&Queue->PartitionRxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+        }
+    }
+
+    if (BuffersCount > 0) {
+        XdpRingConsumerRelease(&Queue->RxRing, BuffersCount);
+    }
+
+    uint32_t FillAvailable = XdpRingProducerReserve(&Queue->RxFillRing, UINT32_MAX, &FillIndex);
+    while (FillAvailable-- > 0) {
+        if (Queue->PartitionRxPool.Next == NULL) {
+            CxPlatLockAcquire(&Queue->RxPoolLock);
+            Queue->PartitionRxPool.Next = Queue->RxPool.Next;
+            Queue->RxPool.Next = NULL;
+            CxPlatLockRelease(&Queue->RxPoolLock);
+        }
+
+        XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)CxPlatListPopEntry(&Queue->PartitionRxPool);
+        if (Packet == NULL) {
+            break;
+        }
+
+        uint64_t* FillDesc = XdpRingGetElement(&Queue->RxFillRing, FillIndex++);
+        *FillDesc = (uint64_t)((uint8_t*)Packet - Queue->Umem);
+        ProdCount++;
+    }
+
+    if (ProdCount > 0) {
+        XdpRingProducerSubmit(&Queue->RxFillRing, ProdCount);
+        if (XdpRingNeedWakeup(&Queue->RxFillRing)) {
+            (void)recvfrom(Queue->Xsk, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+        }
+    }
+
+    if (PacketCount > 0) {
+        CxPlatDpRawRxEthernet((CXPLAT_DATAPATH_RAW*)Xdp, Buffers, (uint16_t)PacketCount);
+    }
+
+    return ProdCount > 0 || PacketCount > 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawRxFree(
+    _In_opt_ const CXPLAT_RECV_DATA* PacketChain
+    )
+{
+    CXPLAT_SLIST_ENTRY* Head = NULL;
+    CXPLAT_SLIST_ENTRY** Tail = &Head;
+    CXPLAT_QUEUE* Queue = NULL;
+
+    while (PacketChain) {
+        const XDP_RX_PACKET* Packet =
+            CXPLAT_CONTAINING_RECORD(PacketChain, XDP_RX_PACKET, RecvData);
+        PacketChain = PacketChain->Next;
+        // Packet->Allocated = FALSE; (other data paths don't clear this flag?)
+
+        if (Queue != Packet->Queue) {
+            if (Head != NULL) {
+                CxPlatLockAcquire(&Queue->RxPoolLock);
+                *Tail = Queue->RxPool.Next;
+                Queue->RxPool.Next = Head;
+                CxPlatLockRelease(&Queue->RxPoolLock);
+                Head = NULL;
+                Tail = &Head;
+            }
+
+            Queue = Packet->Queue;
+        }
+
+        *Tail = (CXPLAT_SLIST_ENTRY*)Packet;
+        Tail = &((CXPLAT_SLIST_ENTRY*)Packet)->Next;
+    }
+
+    if (Head != NULL) {
+        CxPlatLockAcquire(&Queue->RxPoolLock);
+        *Tail = Queue->RxPool.Next;
+        Queue->RxPool.Next = Head;
+        CxPlatLockRelease(&Queue->RxPoolLock);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+CXPLAT_SEND_DATA*
+CxPlatDpRawTxAlloc(
+    _Inout_ CXPLAT_SEND_CONFIG* Config
+    )
+{
+    CXPLAT_QUEUE* Queue = Config->Route->Queue;
+    CXPLAT_DBG_ASSERT(Queue != NULL);
+
+    CxPlatLockAcquire(&Queue->TxPoolLock);
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)CxPlatListPopEntry(&Queue->TxPool);
+    CxPlatLockRelease(&Queue->TxPoolLock);
+
+    if (Packet) {
+        HEADER_BACKFILL HeaderBackfill = CxPlatDpRawCalculateHeaderBackFill(Config->Route); // TODO - Cache in Route?
+        CXPLAT_DBG_ASSERT(Config->MaxPacketSize <= sizeof(Packet->FrameBuffer) - HeaderBackfill.AllLayer);
+        Packet->Queue = Queue;
+        Packet->Buffer.Length = Config->MaxPacketSize;
+        Packet->Buffer.Buffer = &Packet->FrameBuffer[HeaderBackfill.AllLayer];
+        Packet->ECN = Config->ECN;
+        Packet->DSCP = Config->DSCP;
+        Packet->DatapathType = Config->Route->DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
+    }
+
+    return (CXPLAT_SEND_DATA*)Packet;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxFree(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)SendData;
+    CXPLAT_QUEUE* Queue = Packet->Queue;
+    CxPlatLockAcquire(&Queue->TxPoolLock);
+    CxPlatListPushEntry(&Queue->TxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+    CxPlatLockRelease(&Queue->TxPoolLock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxEnqueue(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)SendData;
+    XDP_PARTITION* Partition = Packet->Queue->Partition;
+
+    CxPlatLockAcquire(&Packet->Queue->TxLock);
+    CxPlatListInsertTail(&Packet->Queue->TxQueue, &Packet->Link);
+    CxPlatLockRelease(&Packet->Queue->TxLock);
+
+    Partition->Ec.Ready = TRUE;
+    CxPlatWakeExecutionContext(&Partition->Ec);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxSetL3ChecksumOffload(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    //
+    // Checksum offload is never reported for AF_XDP queues.
+    //
+    UNREFERENCED_PARAMETER(SendData);
+    CXPLAT_DBG_ASSERT(FALSE);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxSetL4ChecksumOffload(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ BOOLEAN IsIpv6,
+    _In_ BOOLEAN IsTcp,
+    _In_ uint8_t L4HeaderLength
+    )
+{
+    //
+    // Checksum offload is never reported for AF_XDP queues.
+    //
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(IsIpv6);
+    UNREFERENCED_PARAMETER(IsTcp);
+    UNREFERENCED_PARAMETER(L4HeaderLength);
+    CXPLAT_DBG_ASSERT(FALSE);
+}
+
+static
+BOOLEAN // Did work?
+CxPlatXdpTx(
+    _In_ const XDP_DATAPATH* Xdp,
+    _In_ CXPLAT_QUEUE* Queue
+    )
+{
+    uint32_t ProdCount = 0;
+    uint32_t CompCount = 0;
+    CXPLAT_SLIST_ENTRY* TxCompleteHead = NULL;
+    CXPLAT_SLIST_ENTRY** TxCompleteTail = &TxCompleteHead;
+
+    if (CxPlatListIsEmpty(&Queue->PartitionTxQueue) &&
+        !CxPlatListIsEmptyNoFence(&Queue->TxQueue)) {
+        CxPlatLockAcquire(&Queue->TxLock);
+        CxPlatListMoveItems(&Queue->TxQueue, &Queue->PartitionTxQueue);
+        CxPlatLockRelease(&Queue->TxLock);
+    }
+
+    uint32_t CompIndex;
+    uint32_t CompAvailable =
+        XdpRingConsumerReserve(&Queue->TxCompletionRing, UINT32_MAX, &CompIndex);
+    while (CompAvailable-- > 0) {
+        uint64_t* CompDesc = XdpRingGetElement(&Queue->TxCompletionRing, CompIndex++);
+        XDP_TX_PACKET* Packet =
+            (XDP_TX_PACKET*)(Queue->Umem + ALIGN_DOWN_BY(*CompDesc, Xdp->ChunkSize));
+        *TxCompleteTail = (CXPLAT_SLIST_ENTRY*)Packet;
+        TxCompleteTail = &((CXPLAT_SLIST_ENTRY*)Packet)->Next;
+        CompCount++;
+    }
+
+    if (CompCount > 0) {
+        XdpRingConsumerRelease(&Queue->TxCompletionRing, CompCount);
+        CxPlatLockAcquire(&Queue->TxPoolLock);
+        *TxCompleteTail = Queue->TxPool.Next;
+        Queue->TxPool.Next = TxCompleteHead;
+        CxPlatLockRelease(&Queue->TxPoolLock);
+    }
+
+    uint32_t TxIndex;
+    uint32_t TxAvailable = XdpRingProducerReserve(&Queue->TxRing, UINT32_MAX, &TxIndex);
+    while (TxAvailable-- > 0 && !CxPlatListIsEmpty(&Queue->PartitionTxQueue)) {
+        struct xdp_desc* Buffer = XdpRingGetElement(&Queue->TxRing, TxIndex++);
+        CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&Queue->PartitionTxQueue);
+        XDP_TX_PACKET* Packet = CXPLAT_CONTAINING_RECORD(Entry, XDP_TX_PACKET, Link);
+
+        Buffer->addr = (uint64_t)(Packet->FrameBuffer - Queue->Umem);
+        Buffer->len = Packet->Buffer.Length;
+        Buffer->options = 0;
+
+        ProdCount++;
+    }
+
+    if ((ProdCount > 0 && (XdpRingProducerSubmit(&Queue->TxRing, ProdCount), TRUE)) ||
+        (CompCount > 0 && XdpRingProducerReserve(&Queue->TxRing, UINT32_MAX, &TxIndex) != Queue->TxRing.Size)) {
+        if (Xdp->TxAlwaysPoke || XdpRingNeedWakeup(&Queue->TxRing)) {
+            if (sendto(Queue->Xsk, NULL, 0, MSG_DONTWAIT, NULL, 0) < 0 &&
+                errno != EAGAIN && errno != EBUSY && errno != ENOBUFS && !Queue->Error) {
+                QuicTraceEvent(
+                    LibraryErrorStatus,
+                    "[ lib] ERROR, %u, %s.",
+                    errno,
+                    "sendto(AF_XDP)");
+                Queue->Error = TRUE;
+            }
+        }
+    }
+
+    return ProdCount > 0 || CompCount > 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatXdpExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    )
+{
+    XDP_PARTITION* Partition = (XDP_PARTITION*)Context;
+    const XDP_DATAPATH* Xdp = Partition->Xdp;
+
+    if (!Xdp->Running) {
+        QuicTraceLogVerbose(
+            XdpPartitionShutdown,
+            "[ xdp][%p] XDP partition shutdown",
+            Partition);
+        CXPLAT_QUEUE* Queue = Partition->Queues;
+        while (Queue) {
+            if (Queue->RxIoSqeInitialized) {
+                epoll_ctl(*Partition->EventQ, EPOLL_CTL_DEL, Queue->Xsk, NULL);
+                CxPlatSqeCleanup(Partition->EventQ, &Queue->RxIoSqe);
+                Queue->RxIoSqeInitialized = FALSE;
+            }
+            Queue = Queue->Next;
+        }
+        CxPlatEventQEnqueue(Partition->EventQ, &Partition->ShutdownSqe);
+        return FALSE;
+    }
+
+    const BOOLEAN PollingExpired =
+        CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow) >= Xdp->PollingIdleTimeoutUs;
+
+    BOOLEAN DidWork = FALSE;
+    CXPLAT_QUEUE* Queue = Partition->Queues;
+    while (Queue) {
+        DidWork |= CxPlatXdpRx(Xdp, Queue, Partition->PartitionIndex);
+        DidWork |= CxPlatXdpTx(Xdp, Queue);
+        Queue = Queue->Next;
+    }
+
+    Partition->Ec.NextTimeUs = UINT64_MAX;
+    if (DidWork) {
+        Partition->Ec.Ready = TRUE;
+        State->NoWorkCount = 0;
+    } else if (!PollingExpired) {
+        Partition->Ec.Ready = TRUE;
+    } else {
+        Queue = Partition->Queues;
+        while (Queue) {
+            if (!Queue->RxQueued && Queue->RxIoSqeInitialized) {
+                QuicTraceLogVerbose(
+                    XdpQueueAsyncIoRx,
+                    "[ xdp][%p] XDP async IO start (RX)",
+                    Queue);
+                struct epoll_event Event = {
+                    .events = EPOLLIN | EPOLLONESHOT, .data = { .ptr = &Queue->RxIoSqe } };
+                if (epoll_ctl(*Partition->EventQ, EPOLL_CTL_MOD, Queue->Xsk, &Event) == 0) {
+                    Queue->RxQueued = TRUE;
+                } else {
+                    QuicTraceEvent(
+                        LibraryErrorStatus,
+                        "[ lib] ERROR, %u, %s.",
+                        errno,
+                        "epoll_ctl(RX)");
+                    Partition->Ec.Ready = TRUE;
+                }
+            }
+
+            //
+            // There is no readiness notification for TX completions, so
+            // check back on any outstanding sends periodically.
+            //
+            uint32_t TxIndex;
+            if (XdpRingProducerReserve(&Queue->TxRing, UINT32_MAX, &TxIndex) != Queue->TxRing.Size) {
+                Partition->Ec.NextTimeUs = State->TimeNow + XDP_TX_COMPLETION_POLL_US;
+            }
+            Queue = Queue->Next;
+        }
+    }
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatIoXdpWaitRxEventComplete(
+    _In_ CXPLAT_CQE* Cqe
+    )
+{
+    CXPLAT_SQE* Sqe = CxPlatCqeGetSqe(Cqe);
+    CXPLAT_QUEUE* Queue = CXPLAT_CONTAINING_RECORD(Sqe, CXPLAT_QUEUE, RxIoSqe);
+    QuicTraceLogVerbose(
+        XdpQueueAsyncIoRxComplete,
+        "[ xdp][%p] XDP async IO complete (RX)",
+        Queue);
+    Queue->RxQueued = FALSE;
+    Queue->Partition->Ec.Ready = TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatIoXdpShutdownEventComplete(
+    _In_ CXPLAT_CQE* Cqe
+    )
+{
+    CXPLAT_SQE* Sqe = CxPlatCqeGetSqe(Cqe);
+    XDP_PARTITION* Partition =
+        CXPLAT_CONTAINING_RECORD(Sqe, XDP_PARTITION, ShutdownSqe);
+    QuicTraceLogVerbose(
+        XdpPartitionShutdownComplete,
+        "[ xdp][%p] XDP partition shutdown complete",
+        Partition);
+    CxPlatSqeCleanup(Partition->EventQ, &Partition->ShutdownSqe);
+    CxPlatDpRawRelease((XDP_DATAPATH*)Partition->Xdp);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDataPathRssConfigGet(
+    _In_ uint32_t InterfaceIndex,
+    _Outptr_ _At_(*RssConfig, __drv_allocatesMem(Mem))
+        CXPLAT_RSS_CONFIG** RssConfig
+    )
+{
+    UNREFERENCED_PARAMETER(InterfaceIndex);
+    UNREFERENCED_PARAMETER(RssConfig);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDataPathRssConfigFree(
+    _In_ CXPLAT_RSS_CONFIG* RssConfig
+    )
+{
+    UNREFERENCED_PARAMETER(RssConfig);
+    CXPLAT_FRE_ASSERTMSG(FALSE, "CxPlatDataPathRssConfigFree not supported");
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+CxPlatDpRawInsertXskInMap(
+    _In_ XDP_INTERFACE* Interface,
+    _In_ int XskMap
+    )
+{
+    for (uint32_t j = 0; j < Interface->QueueCount; j++) {
+        CXPLAT_QUEUE* Queue = &Interface->Queues[j];
+        QUIC_STATUS Status = CxPlatXdpMapUpdate(XskMap, Queue->QueueId, &Queue->Xsk);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceLogVerbose(
+                XdpMapInsertFailedLinux,
+                "[ixdp][%p] XSKMAP insert failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u",
+                Interface,
+                Interface->IfIndex,
+                j,
+                XskMap,
+                Queue->Xsk,
+                Status);
+            //
+            // On failure, best-effort removal of XSKs already inserted for this interface.
+            //
+            for (uint32_t k = 0; k < j; k++) {
+                CxPlatXdpMapDelete(XskMap, Interface->Queues[k].QueueId);
+            }
+            return Status;
+        }
+    }
+    Interface->ExternalXskMapFd = XskMap;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+CxPlatDpRawRemoveXskFromMap(
+    _In_ XDP_INTERFACE* Interface
+    )
+{
+    if (Interface->ExternalXskMapFd == -1) {
+        return;
+    }
+    for (uint32_t j = 0; j < Interface->QueueCount; j++) {
+        QUIC_STATUS Status =
+            CxPlatXdpMapDelete(Interface->ExternalXskMapFd, Interface->Queues[j].QueueId);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceLogVerbose(
+                XdpMapDeleteFailedLinux,
+                "[ixdp][%p] XSKMAP delete failed for IfIndex=%u, QueueId=%u, XskMap=%d, Xsk=%d, Status=%u",
+                Interface,
+                Interface->IfIndex,
+                j,
+                Interface->ExternalXskMapFd,
+                Interface->Queues[j].Xsk,
+                Status);
+        }
+    }
+    Interface->ExternalXskMapFd = -1;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawApplyMapConfigs(
+    _In_ CXPLAT_DATAPATH_RAW* RawDataPath,
+    _In_reads_(MapConfigCount) const CXPLAT_XDP_MAP_CONFIG* MapConfigs,
+    _In_ uint32_t MapConfigCount
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)RawDataPath;
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    for (CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+
+        int XskMap = -1;
+        for (uint32_t i = 0; i < MapConfigCount; i++) {
+            if (MapConfigs[i].InterfaceIndex == Interface->IfIndex) {
+                XskMap = MapConfigs[i].MapHandle;
+                break;
+            }
+        }
+
+        if (XskMap == -1) {
+            continue;
+        }
+
+        Status = CxPlatDpRawInsertXskInMap(Interface, XskMap);
+        if (QUIC_FAILED(Status)) {
+            //
+            // On failure, best-effort removal of all XSKs on all interfaces.
+            //
+            CxPlatDpRawCleanupMapConfigs(RawDataPath);
+            goto Exit;
+        }
+        QuicTraceLogVerbose(
+            XdpMapModeConfiguredLinux,
+            "[ixdp][%p] Map mode configured for IfIndex=%u (MapFd=%d)",
+            Interface,
+            Interface->IfIndex,
+            XskMap);
+    }
+
+Exit:
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawCleanupMapConfigs(
+    _In_ CXPLAT_DATAPATH_RAW* RawDataPath
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)RawDataPath;
+
+    for (CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        CxPlatDpRawRemoveXskFromMap(Interface);
+    }
+}
+
+uint32_t
+CxPlatDpRawGetTotalRuleCount(
+    _In_ const CXPLAT_DATAPATH_RAW* RawDataPath
+    )
+{
+    const XDP_DATAPATH* Xdp = (const XDP_DATAPATH*)RawDataPath;
+    uint32_t TotalRuleCount = 0;
+    for (const CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        const XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        TotalRuleCount += Interface->RuleCount;
+    }
+    return TotalRuleCount;
+}
@@ -0,0 +1,1380 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC Simulated Datapath Implementation (User Mode)
+
+    Replaces the OS sockets with an in-process network, so that transport
+    behavior (congestion control, loss recovery, pacing, flow control) can be
+    measured deterministically, without a network and independent of the
+    speed of the machine running it.
+
+    Every UDP socket is bound in a process-wide port space. Datagrams sent on
+    a socket go through that socket's egress link: a drop-tail bottleneck
+    queue, followed by a propagation delay with optional jitter, random loss
+    and reordering. They are then queued on the receiving socket until the
+    virtual clock reaches their arrival time, when the receiving socket's
+    execution context indicates them on its partition's worker.
+
+    The virtual clock (CxPlatTimeUs64) only advances when all the platform
+    workers are idle. See CxPlatSimClockTryAdvance in platform_worker.c.
+
+    TCP sockets are not supported.
+
+--*/
+
+#include "platform_internal.h"
+#include "datapath_linux.h"
+
+#ifdef QUIC_CLOG
+#include "datapath_sim.c.clog.h"
+#endif
+
+//
+// The first port handed out to sockets bound to port zero.
+//
+#define CXPLAT_SIM_EPHEMERAL_PORT_START 49152
+
+//
+// The hop limit (TTL) reported for all received datagrams.
+//
+#define CXPLAT_SIM_HOP_LIMIT 64
+
+//
+// A single received datagram, with its metadata. Unlike the socket datapaths,
+// datagrams are never coalesced, so each block holds exactly one.
+//
+typedef struct __attribute__((aligned(16))) DATAPATH_RX_IO_BLOCK {
+    //
+    // Represents the network route.
+    //
+    CXPLAT_ROUTE Route;
+
+    //
+    // The entry in the receiving socket context's RecvQueue.
+    //
+    CXPLAT_LIST_ENTRY Link;
+
+    //
+    // The virtual time the datagram arrives at the receiving socket.
+    //
+    uint64_t ArrivalTimeUs;
+
+    //
+    // The packet returned to the app.
+    //
+    //DATAPATH_RX_PACKET Packet;
+
+    //
+    // Buffer that actually stores the UDP payload.
+    //
+    //uint8_t Buffer[]; // CXPLAT_SMALL_IO_BUFFER_SIZE
+
+} DATAPATH_RX_IO_BLOCK;
+
+typedef struct __attribute__((aligned(16))) DATAPATH_RX_PACKET {
+    //
+    // The IO block that owns the packet.
+    //
+    DATAPATH_RX_IO_BLOCK* IoBlock;
+
+    //
+    // Publicly visible receive data.
+    //
+    CXPLAT_RECV_DATA Data;
+
+} DATAPATH_RX_PACKET;
+
+//
+// Send context.
+//
+typedef struct CXPLAT_SEND_DATA {
+    CXPLAT_SEND_DATA_COMMON;
+
+    //
+    // The socket context owning this send.
+    //
+    CXPLAT_SOCKET_CONTEXT* SocketContext;
+
+    //
+    // The current QUIC_BUFFER returned to the client for segmented sends.
+    //
+    QUIC_BUFFER ClientBuffer;
+
+    //
+    // Total number of packet buffers allocated.
+    //
+    uint16_t BufferCount;
+
+    //
+    // Space for all the packet buffers.
+    //
+    uint8_t Buffer[CXPLAT_LARGE_IO_BUFFER_SIZE];
+
+} CXPLAT_SEND_DATA;
+
+//
+// The egress link of a socket.
+//
+typedef struct CXPLAT_SIM_LINK {
+
+    //
+    // Serializes sends on the link.
+    //
+    CXPLAT_LOCK Lock;
+
+    //
+    // The CXPLAT_SIM_NETWORK::ConfigGeneration the random generator was last
+    // seeded for.
+    //
+    uint32_t ConfigGeneration;
+
+    //
+    // The index in DepartureTimesUs for the next accepted datagram.
+    //
+    uint32_t QueueHead;
+
+    //
+    // The state of the link's random generator.
+    //
+    uint64_t RandomState;
+
+    //
+    // The time the bottleneck finishes transmitting all queued datagrams.
+    //
+    uint64_t BusyUntilUs;
+
+    //
+    // The times the most recently accepted datagrams leave the bottleneck
+    // queue. Datagrams are transmitted in order, so the Nth most recent one
+    // still being queued means at least N are queued.
+    //
+    uint64_t DepartureTimesUs[CXPLAT_SIM_MAX_QUEUE_DEPTH];
+
+} CXPLAT_SIM_LINK;
+
+//
+// The process-wide state of the simulated network.
+//
+typedef struct CXPLAT_SIM_NETWORK {
+
+    //
+    // Protects the sockets list, the configuration and the port allocator.
+    //
+    CXPLAT_LOCK Lock;
+
+    //
+    // All bound sockets (CXPLAT_SOCKET::SimEntry), across all datapaths.
+    //
+    CXPLAT_LIST_ENTRY Sockets;
+
+    //
+    // The next port to try handing out for sockets bound to port zero.
+    //
+    uint16_t NextEphemeralPort;
+
+    //
+    // Incremented on every configuration change, so the links reseed.
+    //
+    uint32_t ConfigGeneration;
+
+    CXPLAT_SIM_NETWORK_CONFIG Config;
+
+    //
+    // Statistics, updated with interlocked operations.
+    //
+    CXPLAT_SIM_NETWORK_STATISTICS Stats;
+
+} CXPLAT_SIM_NETWORK;
+
+static CXPLAT_SIM_NETWORK CxPlatSimNetwork = {
+    { PTHREAD_MUTEX_INITIALIZER },
+    { &CxPlatSimNetwork.Sockets, &CxPlatSimNetwork.Sockets },
+    CXPLAT_SIM_EPHEMERAL_PORT_START,
+    0,
+    { 0 },
+    { 0 }
+};
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSimNetworkConfigure(
+    _In_ const CXPLAT_SIM_NETWORK_CONFIG* Config
+    )
+{
+    if (Config->QueueDepth > CXPLAT_SIM_MAX_QUEUE_DEPTH ||
+        Config->EcnMarkThreshold > CXPLAT_SIM_MAX_QUEUE_DEPTH) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    CxPlatLockAcquire(&CxPlatSimNetwork.Lock);
+    CxPlatSimNetwork.Config = *Config;
+    CxPlatSimNetwork.ConfigGeneration++;
+    CxPlatLockRelease(&CxPlatSimNetwork.Lock);
+
+    QuicTraceLogInfo(
+        SimNetworkConfigured,
+        "[ sim] Configured: bw=%llu bps, delay=%u us, jitter=%u us, queue=%u",
+        Config->BottleneckBitsPerSecond,
+        Config->DelayUs,
+        Config->JitterUs,
+        Config->QueueDepth);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatSimNetworkGetStatistics(
+    _Out_ CXPLAT_SIM_NETWORK_STATISTICS* Statistics
+    )
+{
+    CXPLAT_SIM_NETWORK_STATISTICS* Stats = &CxPlatSimNetwork.Stats;
+    Statistics->PacketsSent = QuicReadLongPtrNoFence(&Stats->PacketsSent);
+    Statistics->PacketsDelivered = QuicReadLongPtrNoFence(&Stats->PacketsDelivered);
+    Statistics->PacketsLost = QuicReadLongPtrNoFence(&Stats->PacketsLost);
+    Statistics->PacketsQueueDropped = QuicReadLongPtrNoFence(&Stats->PacketsQueueDropped);
+    Statistics->PacketsUnreachable = QuicReadLongPtrNoFence(&Stats->PacketsUnreachable);
+    Statistics->PacketsReordered = QuicReadLongPtrNoFence(&Stats->PacketsReordered);
+    Statistics->PacketsEcnMarked = QuicReadLongPtrNoFence(&Stats->PacketsEcnMarked);
+}
+
+//
+// splitmix64; good enough for picking packet fates, and trivially seeded.
+//
+static
+uint64_t
+CxPlatSimLinkRandom(
+    _Inout_ CXPLAT_SIM_LINK* Link
+    )
+{
+    uint64_t Z = (Link->RandomState += 0x9E3779B97F4A7C15ull);
+    Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+    return Z ^ (Z >> 31);
+}
+
+static
+BOOLEAN
+CxPlatSimLinkQueueHolds(
+    _In_ const CXPLAT_SIM_LINK* Link,
+    _In_ uint32_t Count,
+    _In_ uint64_t TimeNow
+    )
+{
+    CXPLAT_DBG_ASSERT(Count > 0 && Count <= CXPLAT_SIM_MAX_QUEUE_DEPTH);
+    const uint32_t Index =
+        (Link->QueueHead + CXPLAT_SIM_MAX_QUEUE_DEPTH - Count) % CXPLAT_SIM_MAX_QUEUE_DEPTH;
+    return Link->DepartureTimesUs[Index] > TimeNow;
+}
+
+typedef enum CXPLAT_SIM_FATE {
+    CxPlatSimFateDeliver,
+    CxPlatSimFateLost,
+    CxPlatSimFateQueueDropped
+} CXPLAT_SIM_FATE;
+
+//
+// Runs a datagram of WireLength bytes through the link, returning whether it
+// makes it and, if so, when it arrives.
+//
+static
+CXPLAT_SIM_FATE
+CxPlatSimLinkTransmit(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const CXPLAT_SIM_NETWORK_CONFIG* Config,
+    _In_ uint32_t ConfigGeneration,
+    _In_ uint64_t TimeNow,
+    _In_ uint32_t WireLength,
+    _Inout_ uint8_t* TypeOfService,
+    _Out_ uint64_t* ArrivalTimeUs
+    )
+{
+    CXPLAT_SIM_LINK* Link = SocketContext->Link;
+    CXPLAT_SIM_FATE Fate = CxPlatSimFateDeliver;
+
+    CxPlatLockAcquire(&Link->Lock);
+
+    if (Link->ConfigGeneration != ConfigGeneration) {
+        //
+        // Clients and servers draw different sequences from the same seed, so
+        // that the two directions are not correlated.
+        //
+        Link->ConfigGeneration = ConfigGeneration;
+        Link->RandomState =
+            Config->RandomSeed ^
+            (SocketContext->Binding->HasFixedRemoteAddress ? 0x5851F42D4C957F2Dull : 0);
+    }
+
+    if (Config->RandomLossDenominator != 0 &&
+        CxPlatSimLinkRandom(Link) % Config->RandomLossDenominator == 0) {
+        Fate = CxPlatSimFateLost;
+        goto Exit;
+    }
+
+    uint64_t DepartureTimeUs = TimeNow;
+    if (Config->BottleneckBitsPerSecond != 0) {
+        if (Config->QueueDepth != 0 &&
+            CxPlatSimLinkQueueHolds(Link, Config->QueueDepth, TimeNow)) {
+            Fate = CxPlatSimFateQueueDropped;
+            goto Exit;
+        }
+
+        if (Config->EcnMarkThreshold != 0 &&
+            (*TypeOfService & CXPLAT_ECN_CE) != CXPLAT_ECN_NON_ECT &&
+            CxPlatSimLinkQueueHolds(Link, Config->EcnMarkThreshold, TimeNow)) {
+            *TypeOfService |= CXPLAT_ECN_CE;
+            InterlockedIncrement64((int64_t*)&CxPlatSimNetwork.Stats.PacketsEcnMarked);
+        }
+
+        const uint64_t TransmitTimeUs =
+            ((uint64_t)WireLength * 8 * CXPLAT_MICROSEC_PER_SEC +
+                Config->BottleneckBitsPerSecond - 1) / Config->BottleneckBitsPerSecond;
+        DepartureTimeUs = CXPLAT_MAX(TimeNow, Link->BusyUntilUs) + TransmitTimeUs;
+        Link->BusyUntilUs = DepartureTimeUs;
+        Link->DepartureTimesUs[Link->QueueHead] = DepartureTimeUs;
+        Link->QueueHead = (Link->QueueHead + 1) % CXPLAT_SIM_MAX_QUEUE_DEPTH;
+    }
+
+    *ArrivalTimeUs = DepartureTimeUs + Config->DelayUs;
+    if (Config->JitterUs != 0) {
+        *ArrivalTimeUs += CxPlatSimLinkRandom(Link) % ((uint64_t)Config->JitterUs + 1);
+    }
+    if (Config->RandomReorderDenominator != 0 &&
+        CxPlatSimLinkRandom(Link) % Config->RandomReorderDenominator == 0) {
+        *ArrivalTimeUs += Config->ReorderDelayDeltaUs;
+        InterlockedIncrement64((int64_t*)&CxPlatSimNetwork.Stats.PacketsReordered);
+    }
+
+Exit:
+
+    CxPlatLockRelease(&Link->Lock);
+
+    return Fate;
+}
+
+//
+// Looks up the socket context bound to the address. Must be called with the
+// network lock held.
+//
+static
+CXPLAT_SOCKET_CONTEXT*
+CxPlatSimNetworkLookup(
+    _In_ const QUIC_ADDR* Address
+    )
+{
+    const uint16_t Port = QuicAddrGetPort(Address);
+    for (CXPLAT_LIST_ENTRY* Entry = CxPlatSimNetwork.Sockets.Flink;
+         Entry != &CxPlatSimNetwork.Sockets;
+         Entry = Entry->Flink) {
+        CXPLAT_SOCKET* Socket = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SOCKET, SimEntry);
+        if (QuicAddrGetPort(&Socket->LocalAddress) == Port &&
+            (QuicAddrIsWildCard(&Socket->LocalAddress) ||
+             (QuicAddrGetFamily(&Socket->LocalAddress) == QuicAddrGetFamily(Address) &&
+              QuicAddrCompareIp(&Socket->LocalAddress, Address)))) {
+            return &Socket->SocketContexts[0];
+        }
+    }
+    return NULL;
+}
+
+//
+// Returns TRUE if binding the address would conflict with a bound socket. Must
+// be called with the network lock held.
+//
+static
+BOOLEAN
+CxPlatSimNetworkIsBound(
+    _In_ const QUIC_ADDR* Address,
+    _In_ uint16_t Port
+    )
+{
+    for (CXPLAT_LIST_ENTRY* Entry = CxPlatSimNetwork.Sockets.Flink;
+         Entry != &CxPlatSimNetwork.Sockets;
+         Entry = Entry->Flink) {
+        CXPLAT_SOCKET* Socket = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SOCKET, SimEntry);
+        if (QuicAddrGetPort(&Socket->LocalAddress) == Port &&
+            (QuicAddrIsWildCard(&Socket->LocalAddress) ||
+             QuicAddrIsWildCard(Address) ||
+             (QuicAddrGetFamily(&Socket->LocalAddress) == QuicAddrGetFamily(Address) &&
+              QuicAddrCompareIp(&Socket->LocalAddress, Address)))) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static
+QUIC_STATUS
+CxPlatSimNetworkBind(
+    _In_ CXPLAT_SOCKET* Socket
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    CxPlatLockAcquire(&CxPlatSimNetwork.Lock);
+
+    uint16_t Port = QuicAddrGetPort(&Socket->LocalAddress);
+    if (Port == 0) {
+        for (uint32_t i = CXPLAT_SIM_EPHEMERAL_PORT_START; i <= UINT16_MAX; ++i) {
+            const uint16_t Candidate = CxPlatSimNetwork.NextEphemeralPort;
+            CxPlatSimNetwork.NextEphemeralPort =
+                Candidate == UINT16_MAX ?
+                    CXPLAT_SIM_EPHEMERAL_PORT_START : (uint16_t)(Candidate + 1);
+            if (!CxPlatSimNetworkIsBound(&Socket->LocalAddress, Candidate)) {
+                Port = Candidate;
+                break;
+            }
+        }
+        if (Port == 0) {
+            Status = QUIC_STATUS_ADDRESS_IN_USE;
+            goto Exit;
+        }
+    } else if (CxPlatSimNetworkIsBound(&Socket->LocalAddress, Port)) {
+        Status = QUIC_STATUS_ADDRESS_IN_USE;
+        goto Exit;
+    }
+
+    QuicAddrSetPort(&Socket->LocalAddress, Port);
+    CxPlatListInsertTail(&CxPlatSimNetwork.Sockets, &Socket->SimEntry);
+
+Exit:
+
+    CxPlatLockRelease(&CxPlatSimNetwork.Lock);
+    return Status;
+}
+
+//
+// Datapath.
+//
+
+void
+CxPlatProcessorContextInitialize(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ uint16_t PartitionIndex,
+    _Out_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    CXPLAT_DBG_ASSERT(Datapath != NULL);
+    DatapathPartition->Datapath = Datapath;
+    DatapathPartition->PartitionIndex = PartitionIndex;
+    DatapathPartition->EventQ = CxPlatWorkerPoolGetEventQ(Datapath->WorkerPool, PartitionIndex);
+    CxPlatRefInitialize(&DatapathPartition->RefCount);
+    CxPlatPoolInitialize(TRUE, Datapath->RecvBlockSize, QUIC_POOL_DATA, &DatapathPartition->RecvBlockPool);
+    CxPlatPoolInitialize(TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool);
+}
+
+QUIC_STATUS
+DataPathInitialize(
+    _In_ uint32_t ClientRecvDataLength,
+    _In_opt_ const CXPLAT_UDP_DATAPATH_CALLBACKS* UdpCallbacks,
+    _In_opt_ const CXPLAT_TCP_DATAPATH_CALLBACKS* TcpCallbacks,
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ CXPLAT_DATAPATH_INIT_CONFIG* InitConfig,
+    _Out_ CXPLAT_DATAPATH** NewDatapath
+    )
+{
+    UNREFERENCED_PARAMETER(TcpCallbacks);
+    UNREFERENCED_PARAMETER(InitConfig);
+
+    if (NewDatapath == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+    if (UdpCallbacks != NULL) {
+        if (UdpCallbacks->Receive == NULL || UdpCallbacks->Unreachable == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+    if (WorkerPool == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    const size_t DatapathLength =
+        sizeof(CXPLAT_DATAPATH) +
+        CxPlatWorkerPoolGetCount(WorkerPool) * sizeof(CXPLAT_DATAPATH_PARTITION);
+
+    CXPLAT_DATAPATH* Datapath =
+        (CXPLAT_DATAPATH*)CXPLAT_ALLOC_PAGED(DatapathLength, QUIC_POOL_DATAPATH);
+    if (Datapath == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_DATAPATH",
+            DatapathLength);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(Datapath, DatapathLength);
+    if (UdpCallbacks) {
+        Datapath->UdpHandlers = *UdpCallbacks;
+    }
+    Datapath->WorkerPool = WorkerPool;
+    Datapath->PartitionCount = (uint16_t)CxPlatWorkerPoolGetCount(WorkerPool);
+    Datapath->Features =
+        CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION |
+        CXPLAT_DATAPATH_FEATURE_TTL |
+        CXPLAT_DATAPATH_FEATURE_SEND_DSCP |
+        CXPLAT_DATAPATH_FEATURE_RECV_DSCP;
+    CxPlatRefInitializeEx(&Datapath->RefCount, Datapath->PartitionCount);
+
+    Datapath->SendDataSize = sizeof(CXPLAT_SEND_DATA);
+    Datapath->SendIoVecCount = 1;
+    Datapath->RecvBlockStride =
+        ALIGN_UP_BY(sizeof(DATAPATH_RX_PACKET) + ClientRecvDataLength, CXPLAT_MEMORY_ALIGNMENT);
+    Datapath->RecvBlockBufferOffset =
+        ALIGN_UP_BY(
+            sizeof(DATAPATH_RX_IO_BLOCK) + Datapath->RecvBlockStride, CXPLAT_MEMORY_ALIGNMENT);
+    Datapath->RecvBlockSize =
+        ALIGN_UP_BY(
+            Datapath->RecvBlockBufferOffset + CXPLAT_SMALL_IO_BUFFER_SIZE,
+            CXPLAT_MEMORY_ALIGNMENT);
+
+    for (uint32_t i = 0; i < Datapath->PartitionCount; i++) {
+        CxPlatProcessorContextInitialize(
+            Datapath, (uint16_t)i, &Datapath->Partitions[i]);
+    }
+
+    CXPLAT_FRE_ASSERT(CxPlatWorkerPoolAddRef(WorkerPool, CXPLAT_WORKER_POOL_REF_SIM));
+    *NewDatapath = Datapath;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDataPathRelease(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    if (CxPlatRefDecrement(&Datapath->RefCount)) {
+#if DEBUG
+        CXPLAT_DBG_ASSERT(!Datapath->Freed);
+        CXPLAT_DBG_ASSERT(Datapath->Uninitialized);
+        Datapath->Freed = TRUE;
+#endif
+        CxPlatWorkerPoolRelease(Datapath->WorkerPool, CXPLAT_WORKER_POOL_REF_SIM);
+        CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatProcessorContextRelease(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    if (CxPlatRefDecrement(&DatapathPartition->RefCount)) {
+#if DEBUG
+        CXPLAT_DBG_ASSERT(!DatapathPartition->Uninitialized);
+        DatapathPartition->Uninitialized = TRUE;
+#endif
+        CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool);
+        CxPlatPoolUninitialize(&DatapathPartition->RecvBlockPool);
+        CxPlatDataPathRelease(DatapathPartition->Datapath);
+    }
+}
+
+void
+DataPathUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    if (Datapath != NULL) {
+#if DEBUG
+        CXPLAT_DBG_ASSERT(!Datapath->Uninitialized);
+        Datapath->Uninitialized = TRUE;
+#endif
+        const uint16_t PartitionCount = (uint16_t)Datapath->PartitionCount;
+        for (uint32_t i = 0; i < PartitionCount; i++) {
+            CxPlatProcessorContextRelease(&Datapath->Partitions[i]);
+        }
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+DataPathUpdateConfig(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ QUIC_GLOBAL_EXECUTION_CONFIG* Config
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(Config);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+CXPLAT_DATAPATH_FEATURES
+DataPathGetSupportedFeatures(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    return Datapath->Features;
+}
+
+BOOLEAN
+DataPathIsPaddingPreferred(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    return !!(Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+DataPathUpdatePollingIdleTimeout(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ uint32_t PollingIdleTimeoutUs
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(PollingIdleTimeoutUs);
+}
+
+//
+// Socket context.
+//
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatSocketRelease(
+    _In_ CXPLAT_SOCKET* Socket
+    )
+{
+    if (CxPlatRefDecrement(&Socket->RefCount)) {
+#if DEBUG
+        CXPLAT_DBG_ASSERT(!Socket->Freed);
+        CXPLAT_DBG_ASSERT(Socket->Uninitialized);
+        Socket->Freed = TRUE;
+#endif
+        CXPLAT_FREE(CxPlatSocketToRaw(Socket), QUIC_POOL_SOCKET);
+    }
+}
+
+static
+void
+CxPlatSocketContextUninitializeComplete(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+#if DEBUG
+    CXPLAT_DBG_ASSERT(!SocketContext->Freed);
+    SocketContext->Freed = TRUE;
+#endif
+
+    while (!CxPlatListIsEmpty(&SocketContext->RecvQueue)) {
+        CxPlatPoolFree(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&SocketContext->RecvQueue),
+                DATAPATH_RX_IO_BLOCK,
+                Link));
+    }
+
+    if (SocketContext->Link != NULL) {
+        CxPlatLockUninitialize(&SocketContext->Link->Lock);
+        CXPLAT_FREE(SocketContext->Link, QUIC_POOL_SOCKET);
+    }
+
+    CxPlatLockUninitialize(&SocketContext->RecvQueueLock);
+    CxPlatLockUninitialize(&SocketContext->TxQueueLock);
+    CxPlatRundownUninitialize(&SocketContext->UpcallRundown);
+
+    if (SocketContext->DatapathPartition) {
+        CxPlatProcessorContextRelease(SocketContext->DatapathPartition);
+    }
+    CxPlatSocketRelease(SocketContext->Binding);
+}
+
+//
+// Indicates the received datagrams that have arrived by now, and schedules the
+// execution context for the next arrival.
+//
+static
+BOOLEAN
+CxPlatSocketContextRecvExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    )
+{
+    CXPLAT_SOCKET_CONTEXT* SocketContext = (CXPLAT_SOCKET_CONTEXT*)Context;
+    CXPLAT_SOCKET* Binding = SocketContext->Binding;
+    CXPLAT_RECV_DATA* DatagramHead = NULL;
+    CXPLAT_RECV_DATA** DatagramTail = &DatagramHead;
+    uint32_t DatagramCount = 0;
+
+    CxPlatLockAcquire(&SocketContext->RecvQueueLock);
+    if (SocketContext->RecvShutdown) {
+        CxPlatLockRelease(&SocketContext->RecvQueueLock);
+        CxPlatSocketContextUninitializeComplete(SocketContext);
+        return FALSE;
+    }
+    while (!CxPlatListIsEmpty(&SocketContext->RecvQueue)) {
+        DATAPATH_RX_IO_BLOCK* IoBlock =
+            CXPLAT_CONTAINING_RECORD(
+                SocketContext->RecvQueue.Flink, DATAPATH_RX_IO_BLOCK, Link);
+        if (IoBlock->ArrivalTimeUs > State->TimeNow) {
+            break;
+        }
+        CxPlatListEntryRemove(&IoBlock->Link);
+        DATAPATH_RX_PACKET* Datagram = (DATAPATH_RX_PACKET*)(IoBlock + 1);
+        *DatagramTail = &Datagram->Data;
+        DatagramTail = &Datagram->Data.Next;
+        DatagramCount++;
+    }
+    SocketContext->RecvEc.NextTimeUs =
+        CxPlatListIsEmpty(&SocketContext->RecvQueue) ?
+            UINT64_MAX :
+            CXPLAT_CONTAINING_RECORD(
+                SocketContext->RecvQueue.Flink, DATAPATH_RX_IO_BLOCK, Link)->ArrivalTimeUs;
+    CxPlatLockRelease(&SocketContext->RecvQueueLock);
+
+    if (DatagramHead == NULL) {
+        return TRUE;
+    }
+
+    if (!CxPlatRundownAcquire(&SocketContext->UpcallRundown)) {
+        RecvDataReturn(DatagramHead);
+        return TRUE;
+    }
+
+    if (!Binding->PcpBinding) {
+        CXPLAT_DBG_ASSERT(Binding->Datapath->UdpHandlers.Receive);
+        Binding->Datapath->UdpHandlers.Receive(
+            Binding,
+            Binding->ClientContext,
+            DatagramHead);
+    } else {
+        CxPlatPcpRecvCallback(
+            Binding,
+            Binding->ClientContext,
+            DatagramHead);
+    }
+
+    CxPlatRundownRelease(&SocketContext->UpcallRundown);
+
+    //
+    // Counted after the upcall, so a harness that sees all its datagrams
+    // accounted for also sees them indicated.
+    //
+    InterlockedExchangeAdd64(
+        (int64_t*)&CxPlatSimNetwork.Stats.PacketsDelivered, (int64_t)DatagramCount);
+
+    return TRUE;
+}
+
+static
+QUIC_STATUS
+CxPlatSocketContextInitialize(
+    _Inout_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ uint16_t PartitionIndex
+    )
+{
+    CXPLAT_DATAPATH* Datapath = SocketContext->Binding->Datapath;
+
+    SocketContext->Link =
+        (CXPLAT_SIM_LINK*)CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_SIM_LINK), QUIC_POOL_SOCKET);
+    if (SocketContext->Link == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_SIM_LINK",
+            sizeof(CXPLAT_SIM_LINK));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(SocketContext->Link, sizeof(CXPLAT_SIM_LINK));
+    CxPlatLockInitialize(&SocketContext->Link->Lock);
+    SocketContext->Link->ConfigGeneration = UINT32_MAX; // Seeded on first send.
+
+    SocketContext->DatapathPartition = &Datapath->Partitions[PartitionIndex];
+    CxPlatRefIncrement(&SocketContext->DatapathPartition->RefCount);
+
+    SocketContext->RecvEc.Ready = FALSE;
+    SocketContext->RecvEc.NextTimeUs = UINT64_MAX;
+    SocketContext->RecvEc.Callback = CxPlatSocketContextRecvExecute;
+    SocketContext->RecvEc.Context = SocketContext;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+static
+void
+CxPlatSocketContextUninitialize(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+#if DEBUG
+    CXPLAT_DBG_ASSERT(!SocketContext->Uninitialized);
+    SocketContext->Uninitialized = TRUE;
+#endif
+
+    if (!SocketContext->IoStarted) {
+        CxPlatSocketContextUninitializeComplete(SocketContext);
+    } else {
+        CxPlatRundownReleaseAndWait(&SocketContext->UpcallRundown); // Block until all upcalls complete.
+
+        //
+        // The receive execution context cleans up on the worker, as it may be
+        // running right now. Hold a reference so it can't free the socket
+        // before it has been woken up.
+        //
+        CXPLAT_SOCKET* Binding = SocketContext->Binding;
+        CxPlatRefIncrement(&Binding->RefCount);
+        CxPlatLockAcquire(&SocketContext->RecvQueueLock);
+        SocketContext->RecvShutdown = TRUE;
+        CxPlatLockRelease(&SocketContext->RecvQueueLock);
+        SocketContext->RecvEc.Ready = TRUE;
+        CxPlatWakeExecutionContext(&SocketContext->RecvEc);
+        CxPlatSocketRelease(Binding);
+    }
+}
+
+//
+// Socket.
+//
+
+QUIC_STATUS
+SocketCreateUdp(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ const CXPLAT_UDP_CONFIG* Config,
+    _Out_ CXPLAT_SOCKET** NewBinding
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    const BOOLEAN IsPartitioned =
+        Config->Flags & CXPLAT_SOCKET_FLAG_PARTITIONED || Config->RemoteAddress != NULL;
+
+    CXPLAT_DBG_ASSERT(Datapath->UdpHandlers.Receive != NULL || Config->Flags & CXPLAT_SOCKET_FLAG_PCP);
+
+    //
+    // There is no RSS to spread datagrams, so every socket has a single
+    // context.
+    //
+    const size_t RawBindingLength =
+        CxPlatGetRawSocketSize() + sizeof(CXPLAT_SOCKET_CONTEXT);
+    CXPLAT_SOCKET_RAW* RawBinding =
+        (CXPLAT_SOCKET_RAW*)CXPLAT_ALLOC_PAGED(RawBindingLength, QUIC_POOL_SOCKET);
+    if (RawBinding == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_SOCKET",
+            RawBindingLength);
+        goto Exit;
+    }
+    CXPLAT_SOCKET* Binding = CxPlatRawToSocket(RawBinding);
+
+    QuicTraceEvent(
+        DatapathCreated,
+        "[data][%p] Created, local=%!ADDR!, remote=%!ADDR!",
+        Binding,
+        CASTED_CLOG_BYTEARRAY(Config->LocalAddress ? sizeof(*Config->LocalAddress) : 0, Config->LocalAddress),
+        CASTED_CLOG_BYTEARRAY(Config->RemoteAddress ? sizeof(*Config->RemoteAddress) : 0, Config->RemoteAddress));
+
+    CxPlatZeroMemory(RawBinding, RawBindingLength);
+    Binding->Datapath = Datapath;
+    Binding->ClientContext = Config->CallbackContext;
+    Binding->Connected = (Config->RemoteAddress != NULL);
+    Binding->HasFixedRemoteAddress = (Config->RemoteAddress != NULL);
+    Binding->Mtu = CXPLAT_MAX_MTU;
+    Binding->Type = CXPLAT_SOCKET_UDP;
+    CxPlatRefInitialize(&Binding->RefCount);
+    if (Config->Flags & CXPLAT_SOCKET_FLAG_PCP) {
+        Binding->PcpBinding = TRUE;
+    }
+
+    CXPLAT_SOCKET_CONTEXT* SocketContext = &Binding->SocketContexts[0];
+    SocketContext->Binding = Binding;
+    SocketContext->SocketFd = INVALID_SOCKET;
+    CxPlatListInitializeHead(&SocketContext->TxQueue);
+    CxPlatLockInitialize(&SocketContext->TxQueueLock);
+    CxPlatListInitializeHead(&SocketContext->RecvQueue);
+    CxPlatLockInitialize(&SocketContext->RecvQueueLock);
+    CxPlatRundownInitialize(&SocketContext->UpcallRundown);
+
+    if (Config->LocalAddress != NULL) {
+        Binding->LocalAddress = *Config->LocalAddress;
+        if (QuicAddrGetFamily(&Binding->LocalAddress) == QUIC_ADDRESS_FAMILY_UNSPEC) {
+            QuicAddrSetFamily(&Binding->LocalAddress, QUIC_ADDRESS_FAMILY_INET6);
+        }
+    } else {
+        QuicAddrSetFamily(&Binding->LocalAddress, QUIC_ADDRESS_FAMILY_INET6);
+    }
+    Binding->LocalAddress.Ipv6.sin6_scope_id = 0;
+
+    if (Config->RemoteAddress != NULL) {
+        Binding->RemoteAddress = *Config->RemoteAddress;
+        if (QuicAddrIsWildCard(&Binding->LocalAddress)) {
+            //
+            // What the OS would pick as the source address: the loopback
+            // address of the remote's family, as everything is local.
+            //
+            const uint16_t Port = QuicAddrGetPort(&Binding->LocalAddress);
+            CxPlatZeroMemory(&Binding->LocalAddress, sizeof(Binding->LocalAddress));
+            QuicAddrSetFamily(
+                &Binding->LocalAddress, QuicAddrGetFamily(Config->RemoteAddress));
+            QuicAddrSetToLoopback(&Binding->LocalAddress);
+            QuicAddrSetPort(&Binding->LocalAddress, Port);
+        }
+    }
+
+    Status =
+        CxPlatSocketContextInitialize(
+            SocketContext,
+            IsPartitioned ? Config->PartitionIndex : 0);
+    if (QUIC_FAILED(Status)) {
+        goto Exit;
+    }
+
+    Status = CxPlatSimNetworkBind(Binding);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "bind");
+        goto Exit;
+    }
+
+    *NewBinding = Binding;
+
+    CxPlatWorkerPoolAddExecutionContext(
+        Datapath->WorkerPool,
+        &SocketContext->RecvEc,
+        SocketContext->DatapathPartition->PartitionIndex);
+    SocketContext->IoStarted = TRUE;
+
+    Binding = NULL;
+    RawBinding = NULL;
+
+Exit:
+
+    if (RawBinding != NULL) {
+        SocketDelete(CxPlatRawToSocket(RawBinding));
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+SocketCreateTcp(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_opt_ void* CallbackContext,
+    _Out_ CXPLAT_SOCKET** Socket
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(RemoteAddress);
+    UNREFERENCED_PARAMETER(CallbackContext);
+    UNREFERENCED_PARAMETER(Socket);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+SocketCreateTcpListener(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_ADDR* LocalAddress,
+    _In_opt_ void* RecvCallbackContext,
+    _Out_ CXPLAT_SOCKET** NewSocket
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(RecvCallbackContext);
+    UNREFERENCED_PARAMETER(NewSocket);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+void
+SocketDelete(
+    _In_ CXPLAT_SOCKET* Socket
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    QuicTraceEvent(
+        DatapathDestroyed,
+        "[data][%p] Destroyed",
+        Socket);
+
+#if DEBUG
+    CXPLAT_DBG_ASSERT(!Socket->Uninitialized);
+    Socket->Uninitialized = TRUE;
+#endif
+
+    //
+    // Unbind first, so no more datagrams are queued to the socket.
+    //
+    CxPlatLockAcquire(&CxPlatSimNetwork.Lock);
+    if (Socket->SimEntry.Flink != NULL) {
+        CxPlatListEntryRemove(&Socket->SimEntry);
+    }
+    CxPlatLockRelease(&CxPlatSimNetwork.Lock);
+
+    CxPlatSocketContextUninitialize(&Socket->SocketContexts[0]);
+}
+
+QUIC_STATUS
+CxPlatSocketUpdateQeo(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_reads_(OffloadCount)
+        const CXPLAT_QEO_CONNECTION* Offloads,
+    _In_ uint32_t OffloadCount
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Offloads);
+    UNREFERENCED_PARAMETER(OffloadCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatUpdateRoute(
+    _Inout_ CXPLAT_ROUTE* DstRoute,
+    _In_ CXPLAT_ROUTE* SrcRoute
+    )
+{
+    UNREFERENCED_PARAMETER(DstRoute);
+    UNREFERENCED_PARAMETER(SrcRoute);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetTcpStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ CXPLAT_TCP_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Statistics);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+//
+// Receive Path
+//
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+RecvDataReturn(
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    CXPLAT_RECV_DATA* Datagram;
+    while ((Datagram = RecvDataChain) != NULL) {
+        RecvDataChain = RecvDataChain->Next;
+        DATAPATH_RX_PACKET* Packet =
+            CXPLAT_CONTAINING_RECORD(Datagram, DATAPATH_RX_PACKET, Data);
+        CxPlatPoolFree(Packet->IoBlock);
+    }
+}
+
+//
+// Send Path
+//
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+CXPLAT_SEND_DATA*
+SendDataAlloc(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Inout_ CXPLAT_SEND_CONFIG* Config
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    CXPLAT_DBG_ASSERT(Config->MaxPacketSize <= MAX_UDP_PAYLOAD_LENGTH);
+    if (Config->Route->Queue == NULL) {
+        Config->Route->Queue = (CXPLAT_QUEUE*)&Socket->SocketContexts[0];
+    }
+
+    CXPLAT_SOCKET_CONTEXT* SocketContext = (CXPLAT_SOCKET_CONTEXT*)Config->Route->Queue;
+    CXPLAT_DBG_ASSERT(SocketContext->Binding == Socket);
+    CXPLAT_SEND_DATA* SendData = CxPlatPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool);
+    if (SendData != NULL) {
+        SendData->SocketContext = SocketContext;
+        SendData->ClientBuffer.Buffer = SendData->Buffer;
+        SendData->ClientBuffer.Length = 0;
+        SendData->TotalSize = 0;
+        SendData->SegmentSize = Config->MaxPacketSize;
+        SendData->BufferCount = 0;
+        SendData->ECN = Config->ECN;
+        SendData->DSCP = Config->DSCP;
+        SendData->DatapathType = Config->Route->DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
+    }
+
+    return SendData;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SendDataFree(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CxPlatPoolFree(SendData);
+}
+
+static
+void
+CxPlatSendDataFinalizeSendBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    if (SendData->ClientBuffer.Length == 0) { // No buffer to finalize.
+        return;
+    }
+
+    CXPLAT_DBG_ASSERT(SendData->SegmentSize == 0 || SendData->ClientBuffer.Length <= SendData->SegmentSize);
+    CXPLAT_DBG_ASSERT(SendData->TotalSize + SendData->ClientBuffer.Length <= sizeof(SendData->Buffer));
+
+    SendData->BufferCount++;
+    SendData->TotalSize += SendData->ClientBuffer.Length;
+    if (SendData->SegmentSize == 0 ||
+        SendData->ClientBuffer.Length < SendData->SegmentSize ||
+        SendData->TotalSize + SendData->SegmentSize > sizeof(SendData->Buffer)) {
+        SendData->ClientBuffer.Buffer = NULL;
+    } else {
+        SendData->ClientBuffer.Buffer += SendData->SegmentSize;
+    }
+    SendData->ClientBuffer.Length = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+QUIC_BUFFER*
+SendDataAllocBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t MaxBufferLength
+    )
+{
+    CXPLAT_DBG_ASSERT(SendData != NULL);
+    CXPLAT_DBG_ASSERT(MaxBufferLength > 0);
+    CxPlatSendDataFinalizeSendBuffer(SendData);
+    CXPLAT_DBG_ASSERT(SendData->SegmentSize == 0 || SendData->SegmentSize >= MaxBufferLength);
+    CXPLAT_DBG_ASSERT(SendData->TotalSize + MaxBufferLength <= sizeof(SendData->Buffer));
+    if (SendData->ClientBuffer.Buffer == NULL) {
+        return NULL;
+    }
+    SendData->ClientBuffer.Length = MaxBufferLength;
+    return &SendData->ClientBuffer;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SendDataFreeBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ QUIC_BUFFER* Buffer
+    )
+{
+    //
+    // This must be the final send buffer; intermediate buffers cannot be freed.
+    //
+    CXPLAT_DBG_ASSERT(Buffer == &SendData->ClientBuffer);
+    Buffer->Length = 0;
+    UNREFERENCED_PARAMETER(SendData);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+SendDataIsFull(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CxPlatSendDataFinalizeSendBuffer(SendData);
+    return SendData->ClientBuffer.Buffer == NULL;
+}
+
+//
+// Sends a single datagram over the socket's link, and queues it on the
+// destination socket if it survives.
+//
+static
+void
+CxPlatSocketContextSendDatagram(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_reads_bytes_(Length) const uint8_t* Buffer,
+    _In_ uint16_t Length,
+    _In_ uint8_t TypeOfService
+    )
+{
+    CXPLAT_SIM_NETWORK_STATISTICS* Stats = &CxPlatSimNetwork.Stats;
+    InterlockedIncrement64((int64_t*)&Stats->PacketsSent);
+
+    if (Length > CXPLAT_SMALL_IO_BUFFER_SIZE) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            Length,
+            "Datagram larger than the simulated MTU");
+        InterlockedIncrement64((int64_t*)&Stats->PacketsLost);
+        return;
+    }
+
+    //
+    // Snapshot the configuration and find (and hold) the destination, in one
+    // go under the network lock.
+    //
+    CXPLAT_SIM_NETWORK_CONFIG Config;
+    CxPlatLockAcquire(&CxPlatSimNetwork.Lock);
+    Config = CxPlatSimNetwork.Config;
+    const uint32_t ConfigGeneration = CxPlatSimNetwork.ConfigGeneration;
+    CXPLAT_SOCKET_CONTEXT* Destination = CxPlatSimNetworkLookup(&Route->RemoteAddress);
+    if (Destination != NULL && !CxPlatRundownAcquire(&Destination->UpcallRundown)) {
+        Destination = NULL;
+    }
+    CxPlatLockRelease(&CxPlatSimNetwork.Lock);
+
+    const uint32_t WireLength =
+        Length + CXPLAT_UDP_HEADER_SIZE +
+        (QuicAddrGetFamily(&Route->RemoteAddress) == QUIC_ADDRESS_FAMILY_INET ?
+            CXPLAT_MIN_IPV4_HEADER_SIZE : CXPLAT_MIN_IPV6_HEADER_SIZE);
+    uint64_t ArrivalTimeUs = 0;
+    const CXPLAT_SIM_FATE Fate =
+        CxPlatSimLinkTransmit(
+            SocketContext,
+            &Config,
+            ConfigGeneration,
+            CxPlatTimeUs64(),
+            WireLength,
+            &TypeOfService,
+            &ArrivalTimeUs);
+
+    if (Fate != CxPlatSimFateDeliver) {
+        InterlockedIncrement64(
+            (int64_t*)(Fate == CxPlatSimFateLost ?
+                &Stats->PacketsLost : &Stats->PacketsQueueDropped));
+        QuicTraceLogVerbose(
+            SimDatagramDropped,
+            "[ sim][%p] Dropped %hu bytes (%s)",
+            SocketContext->Binding,
+            Length,
+            Fate == CxPlatSimFateLost ? "random loss" : "queue full");
+        goto Exit;
+    }
+
+    if (Destination == NULL) {
+        InterlockedIncrement64((int64_t*)&Stats->PacketsUnreachable);
+        goto Exit;
+    }
+
+    CXPLAT_DATAPATH* DestinationDatapath = Destination->Binding->Datapath;
+    DATAPATH_RX_IO_BLOCK* IoBlock =
+        CxPlatPoolAlloc(&Destination->DatapathPartition->RecvBlockPool);
+    if (IoBlock == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "DATAPATH_RX_IO_BLOCK",
+            DestinationDatapath->RecvBlockSize);
+        InterlockedIncrement64((int64_t*)&Stats->PacketsLost);
+        goto Exit;
+    }
+
+    //
+    // The destination sees the sender's source address as the remote, and the
+    // address the datagram was sent to as the local.
+    //
+    IoBlock->Route.LocalAddress = Route->RemoteAddress;
+    IoBlock->Route.RemoteAddress = Route->LocalAddress;
+    if (QuicAddrIsWildCard(&IoBlock->Route.RemoteAddress) ||
+        QuicAddrGetPort(&IoBlock->Route.RemoteAddress) == 0) {
+        IoBlock->Route.RemoteAddress = SocketContext->Binding->LocalAddress;
+    }
+    IoBlock->Route.Queue = (CXPLAT_QUEUE*)Destination;
+    IoBlock->Route.DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
+    IoBlock->ArrivalTimeUs = ArrivalTimeUs;
+
+    DATAPATH_RX_PACKET* Datagram = (DATAPATH_RX_PACKET*)(IoBlock + 1);
+    uint8_t* RecvBuffer = (uint8_t*)IoBlock + DestinationDatapath->RecvBlockBufferOffset;
+    CxPlatCopyMemory(RecvBuffer, Buffer, Length);
+    Datagram->IoBlock = IoBlock;
+    Datagram->Data.Next = NULL;
+    Datagram->Data.Route = &IoBlock->Route;
+    Datagram->Data.Buffer = RecvBuffer;
+    Datagram->Data.BufferLength = Length;
+    Datagram->Data.PartitionIndex = Destination->DatapathPartition->PartitionIndex;
+    Datagram->Data.TypeOfService = TypeOfService;
+    Datagram->Data.HopLimitTTL = CXPLAT_SIM_HOP_LIMIT;
+    Datagram->Data.Allocated = TRUE;
+    Datagram->Data.DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
+    Datagram->Data.QueuedOnConnection = FALSE;
+    Datagram->Data.Reserved = FALSE;
+
+    //
+    // Keep the queue in arrival order. Reordering and jitter aside, datagrams
+    // arrive in the order they were sent, so this is usually an append.
+    //
+    CxPlatLockAcquire(&Destination->RecvQueueLock);
+    CXPLAT_LIST_ENTRY* Entry = Destination->RecvQueue.Blink;
+    while (Entry != &Destination->RecvQueue &&
+           CXPLAT_CONTAINING_RECORD(Entry, DATAPATH_RX_IO_BLOCK, Link)->ArrivalTimeUs > ArrivalTimeUs) {
+        Entry = Entry->Blink;
+    }
+    CxPlatListInsertHead(Entry, &IoBlock->Link);
+    const BOOLEAN NewHead = Destination->RecvQueue.Flink == &IoBlock->Link;
+    CxPlatLockRelease(&Destination->RecvQueueLock);
+
+    if (NewHead) {
+        //
+        // The receive execution context recalculates its next time when it
+        // runs.
+        //
+        Destination->RecvEc.Ready = TRUE;
+        CxPlatWakeExecutionContext(&Destination->RecvEc);
+    }
+
+Exit:
+
+    if (Destination != NULL) {
+        CxPlatRundownRelease(&Destination->UpcallRundown);
+    }
+}
+
+void
+SocketSend(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+
+    CxPlatSendDataFinalizeSendBuffer(SendData);
+    QuicTraceEvent(
+        DatapathSend,
+        "[data][%p] Send %u bytes in %hhu buffers (segment=%hu) Dst=%!ADDR!, Src=%!ADDR!",
+        Socket,
+        SendData->TotalSize,
+        SendData->BufferCount,
+        SendData->SegmentSize,
+        CASTED_CLOG_BYTEARRAY(sizeof(Route->RemoteAddress), &Route->RemoteAddress),
+        CASTED_CLOG_BYTEARRAY(sizeof(Route->LocalAddress), &Route->LocalAddress));
+
+    //
+    // A zero segment size means the send is a single datagram.
+    //
+    const uint32_t SegmentSize =
+        SendData->SegmentSize == 0 ? SendData->TotalSize : SendData->SegmentSize;
+    const uint8_t TypeOfService = (uint8_t)(SendData->ECN | (SendData->DSCP << 2));
+    for (uint32_t Offset = 0; Offset < SendData->TotalSize; Offset += SegmentSize) {
+        const uint16_t Length =
+            (uint16_t)CXPLAT_MIN(SegmentSize, SendData->TotalSize - Offset);
+        CxPlatSocketContextSendDatagram(
+            SendData->SocketContext,
+            Route,
+            SendData->Buffer + Offset,
+            Length,
+            TypeOfService);
+    }
+
+    CxPlatSendDataFree(SendData);
+}
@@ -735,6 +735,20 @@ CxPlatDpRawGetDatapathSize(
 
 #if defined(CX_PLATFORM_LINUX)
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+
+//
+// The virtual clock (in us) of the simulated datapath, returned by
+// CxPlatTimeUs64. Starts at a non-zero time, as some code treats zero as unset.
+//
+#define CXPLAT_SIM_CLOCK_START_US 1000000
+
+extern uint64_t CxPlatSimTimeUs;
+
+typedef struct CXPLAT_SIM_LINK CXPLAT_SIM_LINK;
+
+#endif // CXPLAT_USE_SIM_DATAPATH
+
 typedef struct CXPLAT_DATAPATH_PARTITION CXPLAT_DATAPATH_PARTITION;
 
 typedef struct CXPLAT_SOCKET_SQE {
@@ -824,6 +838,18 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
     //
     BOOLEAN IoStarted : 1;
 
+#ifndef CXPLAT_USE_IO_URING
+    //
+    // Indicates the socket is in the partition's TxBatchSockets list.
+    //
+    BOOLEAN TxBatchQueued : 1;
+
+    //
+    // The entry in the partition's TxBatchSockets list.
+    //
+    CXPLAT_LIST_ENTRY TxBatchEntry;
+#endif
+
 #ifdef CXPLAT_USE_IO_URING
     struct {
         //
@@ -831,6 +857,13 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
         //
         BOOLEAN Shutdown : 1;
 
+        //
+        // The receive buffer group (CXPLAT_RECV_BUFFER_GROUP_INDEX) the
+        // multishot receive is armed with. Only changes when the receive is
+        // re-armed.
+        //
+        uint8_t RecvBufferGroup : 1;
+
 #if DEBUG
         //
         // Indicates if the socket socket has a multi recv outstanding.
@@ -838,8 +871,56 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
         BOOLEAN MultiRecvStarted : 1;
 #endif // DEBUG
     } LockedFlags;
+
+    //
+    // Indicates the kernel copied or rejected a zero-copy send on this socket,
+    // so zero-copy only adds overhead here. Set atomically from completions and
+    // read without a lock when a send is allocated.
+    //
+    BOOLEAN SendZeroCopyDisabled;
+
+    //
+    // The number of times the multishot receive stopped because its buffer
+    // group was empty (ENOBUFS).
+    //
+    uint32_t RecvBufferStallCount;
+
+    //
+    // The number of receives truncated because the buffer was too small.
+    //
+    uint32_t RecvTruncatedCount;
 #endif // CXPLAT_USE_IO_URING
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+    //
+    // Execution context on the partition's worker that indicates received
+    // datagrams once the virtual clock reaches their arrival time.
+    //
+    CXPLAT_EXECUTION_CONTEXT RecvEc;
+
+    //
+    // Received datagrams (DATAPATH_RX_IO_BLOCK) waiting for their arrival
+    // time, in arrival order.
+    //
+    CXPLAT_LIST_ENTRY RecvQueue;
+
+    //
+    // Lock around RecvQueue and RecvShutdown.
+    //
+    CXPLAT_LOCK RecvQueueLock;
+
+    //
+    // The simulated egress link for datagrams sent on this socket.
+    //
+    CXPLAT_SIM_LINK* Link;
+
+    //
+    // Indicates the socket is uninitializing, so RecvEc should clean up and
+    // remove itself from the worker.
+    //
+    BOOLEAN RecvShutdown;
+#endif // CXPLAT_USE_SIM_DATAPATH
+
 #if DEBUG
     uint8_t Uninitialized : 1;
     uint8_t Freed : 1;
@@ -907,6 +988,13 @@ typedef struct CXPLAT_SOCKET {
 
     uint8_t SkipCreatingOsSockets : 1;
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+    //
+    // The entry in the simulated network's list of bound sockets.
+    //
+    CXPLAT_LIST_ENTRY SimEntry;
+#endif
+
     //
     // Set of socket contexts one per proc.
     //
@@ -922,6 +1010,84 @@ typedef struct CXPLAT_REGISTERED_BUFFER_POOL {
     CXPLAT_LOCK Lock;
 } CXPLAT_REGISTERED_BUFFER_POOL;
 
+#ifdef CXPLAT_USE_IO_URING
+
+//
+// The receive buffer groups of a partition, in order of buffer size. There is
+// no group of buffers smaller than the MTU: a multishot receive takes every
+// buffer from the one group it is armed with, before the datagram's length is
+// known, so such a group would truncate any full-sized datagram.
+//
+typedef enum CXPLAT_RECV_BUFFER_GROUP_INDEX {
+    CxPlatRecvBufferGroupMtu,
+    CxPlatRecvBufferGroupCoalesced,
+    CxPlatRecvBufferGroupCount
+} CXPLAT_RECV_BUFFER_GROUP_INDEX;
+
+#define CXPLAT_RECV_BUFFER_GROUP_MAX_CHUNKS 8
+
+//
+// A provided buffer ring for multishot receives. The ring is registered at its
+// full size, but its buffers are allocated in chunks: the first when the group
+// is first used and the rest as the ring runs low, up to the ring's capacity.
+//
+typedef struct CXPLAT_RECV_BUFFER_GROUP {
+
+    //
+    // The io_uring_buf_ring shared with the kernel.
+    //
+    void* Ring;
+
+    //
+    // The buffer chunks allocated so far.
+    //
+    uint8_t* Chunks[CXPLAT_RECV_BUFFER_GROUP_MAX_CHUNKS];
+
+    //
+    // The size of each buffer, including its DATAPATH_RX_IO_BLOCK header.
+    //
+    uint32_t BufferSize;
+
+    //
+    // The offset of the datagram payload in each buffer.
+    //
+    uint32_t BufferOffset;
+
+    //
+    // The maximum number of (coalesced) datagrams a buffer can hold.
+    //
+    uint16_t MaxPackets;
+
+    //
+    // The number of buffers in each chunk.
+    //
+    uint16_t ChunkSize;
+
+    //
+    // The number of chunks allocated.
+    //
+    uint16_t ChunkCount;
+
+    //
+    // The io_uring buffer group ID (CXPLAT_IO_RING_BUF_GROUP).
+    //
+    uint16_t GroupId;
+
+    //
+    // The number of buffers currently in the ring (not yet filled by the
+    // kernel or given back since).
+    //
+    int64_t Available;
+
+    //
+    // Protects adding buffers to the ring.
+    //
+    CXPLAT_LOCK Lock;
+
+} CXPLAT_RECV_BUFFER_GROUP;
+
+#endif // CXPLAT_USE_IO_URING
+
 //
 // A per processor datapath context.
 //
@@ -959,9 +1125,9 @@ typedef struct QUIC_CACHEALIGN CXPLAT_DATAPATH_PARTITION {
 
 #ifdef CXPLAT_USE_IO_URING
     //
-    // Backing pool of registered buffers for the RecvBlockPool.
+    // Provided buffer groups for multishot receives.
     //
-    CXPLAT_REGISTERED_BUFFER_POOL RecvRegisteredBufferPool;
+    CXPLAT_RECV_BUFFER_GROUP RecvBufferGroups[CxPlatRecvBufferGroupCount];
 #endif
 
     //
@@ -972,9 +1138,50 @@ typedef struct QUIC_CACHEALIGN CXPLAT_DATAPATH_PARTITION {
 
 #ifdef CXPLAT_USE_IO_URING
     //
-    // Backing pool of registered buffers for the SendBlockPool.
+    // Registered buffer region for zero-copy sends. It is carved into send
+    // data blocks, used in place of SendBlockPool while any are available.
     //
     CXPLAT_REGISTERED_BUFFER_POOL SendRegisteredBufferPool;
+
+    //
+    // The unused send data blocks in SendRegisteredBufferPool. Protected by
+    // SendRegisteredBufferPool.Lock.
+    //
+    CXPLAT_LIST_ENTRY SendZeroCopyFreeList;
+
+    //
+    // Indicates SendRegisteredBufferPool is registered with the io_uring as
+    // fixed buffer 0.
+    //
+    BOOLEAN SendZeroCopyRegistered;
+#endif
+
+#ifndef CXPLAT_USE_IO_URING
+    //
+    // Execution context on the partition's worker that flushes the sends
+    // batched on TxBatchSockets, after the worker's other execution contexts
+    // have queued them.
+    //
+    CXPLAT_EXECUTION_CONTEXT TxBatchEc;
+
+    //
+    // The socket contexts with batched sends. Only accessed on the partition's
+    // worker thread.
+    //
+    CXPLAT_LIST_ENTRY TxBatchSockets;
+
+    //
+    // The number of sendmmsg calls made to flush batched sends, and the number
+    // of datagrams they sent.
+    //
+    uint64_t TxBatchSyscallCount;
+    uint64_t TxBatchDatagramCount;
+
+    //
+    // Indicates the datapath is uninitializing, so TxBatchEc should remove
+    // itself from the worker.
+    //
+    BOOLEAN TxBatchShutdown;
 #endif
 
     //
@@ -1032,6 +1239,32 @@ typedef struct CXPLAT_DATAPATH {
     //
     uint32_t RecvBlockSize;
 
+    //
+    // The time (in us) for the kernel to busy poll the sockets. 0 if busy
+    // polling is disabled.
+    //
+    uint32_t BusyPollUs;
+
+#ifdef CXPLAT_USE_IO_URING
+    //
+    // Indicates UDP sends use SENDMSG_ZC from the registered send buffers.
+    //
+    BOOLEAN SendZeroCopy;
+
+    //
+    // Indicates the kernel accepts registered buffers for SENDMSG_ZC. Cleared
+    // atomically, by whichever partition first has a registered buffer send
+    // rejected.
+    //
+    BOOLEAN SendZeroCopyFixedBuffers;
+
+    //
+    // The minimum size (in bytes) of a send for it to use SENDMSG_ZC. Smaller
+    // sends from the registered send buffers are copied with SENDMSG.
+    //
+    uint32_t SendZeroCopyThreshold;
+#endif
+
 #if DEBUG
     uint8_t Uninitialized : 1;
     uint8_t Freed : 1;
@@ -487,11 +487,15 @@ CxPlatTimeUs64(
     void
     )
 {
+#ifdef CXPLAT_USE_SIM_DATAPATH
+    return QuicReadLongPtrNoFence(&CxPlatSimTimeUs);
+#else
     struct timespec CurrTime = {0};
     int ErrorCode = clock_gettime(CLOCK_MONOTONIC, &CurrTime);
     CXPLAT_DBG_ASSERT(ErrorCode == 0);
     UNREFERENCED_PARAMETER(ErrorCode);
     return CxPlatTimespecToUs(&CurrTime);
+#endif
 }
 
 void
@@ -15,6 +15,12 @@ Abstract:
 #include "platform_worker.c.clog.h"
 #endif
 
+//
+// The default time (in us) for the kernel to busy poll, if busy polling is
+// enabled without a polling idle timeout.
+//
+#define CXPLAT_DEFAULT_BUSY_POLL_US 50
+
 typedef struct QUIC_CACHEALIGN CXPLAT_WORKER {
 
     //
@@ -102,6 +108,36 @@ typedef struct QUIC_CACHEALIGN CXPLAT_WORKER {
     //
     BOOLEAN Running;
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+    //
+    // The entry in the virtual clock's list of workers.
+    //
+    CXPLAT_LIST_ENTRY SimClockEntry;
+
+    //
+    // The earliest execution context deadline, as of the last time the worker
+    // ran them.
+    //
+    uint64_t NextTimeUs;
+
+    //
+    // The deadline the worker is waiting for, while idle.
+    //
+    uint64_t SimDeadlineUs;
+
+    //
+    // Indicates the worker is blocked waiting for virtual time to advance.
+    // Protected by the virtual clock's lock.
+    //
+    BOOLEAN SimIdle;
+
+    //
+    // Indicates the worker was woken before it went idle, so it must not.
+    // Protected by the virtual clock's lock.
+    //
+    BOOLEAN SimWakePending;
+#endif
+
 } CXPLAT_WORKER;
 
 typedef struct CXPLAT_WORKER_POOL {
@@ -109,6 +145,12 @@ typedef struct CXPLAT_WORKER_POOL {
     CXPLAT_RUNDOWN_REF Rundown;
     uint32_t WorkerCount;
 
+    //
+    // The time (in us) for the kernel to busy poll. 0 if busy polling is not
+    // enabled.
+    //
+    uint32_t BusyPollUs;
+
 #if DEBUG
     //
     // Detailed ref counts.
@@ -124,6 +166,208 @@ typedef struct CXPLAT_WORKER_POOL {
 
 CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context);
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+
+//
+// The virtual clock for the simulated datapath. Execution contexts run in zero
+// virtual time; the clock only advances once every internal worker is idle
+// (and no application thread holds it), and then jumps to the earliest
+// deadline any of them waits for. Wakes go through CxPlatSimClockWake before
+// the worker's event queue, so a pending wake always keeps the clock still.
+//
+// Externally driven workers (CxPlatWorkerPoolCreateExternal) are not tracked.
+//
+typedef struct CXPLAT_SIM_CLOCK {
+
+    CXPLAT_LOCK Lock;
+
+    //
+    // The internal workers that are running, and how many of them are idle.
+    //
+    CXPLAT_LIST_ENTRY Workers;
+    uint32_t WorkerCount;
+    uint32_t IdleCount;
+
+    //
+    // The number of outstanding CxPlatSimClockHold calls.
+    //
+    uint32_t HoldCount;
+
+} CXPLAT_SIM_CLOCK;
+
+static CXPLAT_SIM_CLOCK CxPlatSimClock = {
+    { PTHREAD_MUTEX_INITIALIZER },
+    { &CxPlatSimClock.Workers, &CxPlatSimClock.Workers },
+    0, 0, 0
+};
+
+uint64_t CxPlatSimTimeUs = CXPLAT_SIM_CLOCK_START_US;
+
+//
+// Advances the clock if everything is idle, and wakes the workers whose
+// deadlines have been reached. Returns with the caller's worker (if any) no
+// longer idle if its deadline was reached, instead of waking it.
+//
+static
+void
+CxPlatSimClockTryAdvance(
+    _In_opt_ CXPLAT_WORKER* Self
+    )
+{
+    if (CxPlatSimClock.HoldCount != 0 ||
+        CxPlatSimClock.WorkerCount == 0 ||
+        CxPlatSimClock.IdleCount != CxPlatSimClock.WorkerCount) {
+        return;
+    }
+
+    uint64_t NextTimeUs = UINT64_MAX;
+    for (CXPLAT_LIST_ENTRY* Entry = CxPlatSimClock.Workers.Flink;
+         Entry != &CxPlatSimClock.Workers;
+         Entry = Entry->Flink) {
+        CXPLAT_WORKER* Worker = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_WORKER, SimClockEntry);
+        if (Worker->SimDeadlineUs < NextTimeUs) {
+            NextTimeUs = Worker->SimDeadlineUs;
+        }
+    }
+    if (NextTimeUs == UINT64_MAX) {
+        return; // Nothing to do until something external happens.
+    }
+
+    if (NextTimeUs > CxPlatSimTimeUs) {
+        InterlockedExchange64((int64_t*)&CxPlatSimTimeUs, (int64_t)NextTimeUs);
+    }
+
+    for (CXPLAT_LIST_ENTRY* Entry = CxPlatSimClock.Workers.Flink;
+         Entry != &CxPlatSimClock.Workers;
+         Entry = Entry->Flink) {
+        CXPLAT_WORKER* Worker = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_WORKER, SimClockEntry);
+        if (Worker->SimDeadlineUs <= CxPlatSimTimeUs) {
+            Worker->SimIdle = FALSE;
+            CxPlatSimClock.IdleCount--;
+            if (Worker != Self) {
+                CxPlatEventQEnqueue(&Worker->EventQ, &Worker->WakeSqe);
+            }
+        }
+    }
+}
+
+static
+void
+CxPlatSimClockAddWorker(
+    _In_ CXPLAT_WORKER* Worker
+    )
+{
+    Worker->NextTimeUs = UINT64_MAX;
+    CxPlatLockAcquire(&CxPlatSimClock.Lock);
+    CxPlatListInsertTail(&CxPlatSimClock.Workers, &Worker->SimClockEntry);
+    CxPlatSimClock.WorkerCount++;
+    CxPlatLockRelease(&CxPlatSimClock.Lock);
+}
+
+static
+void
+CxPlatSimClockRemoveWorker(
+    _In_ CXPLAT_WORKER* Worker
+    )
+{
+    CxPlatLockAcquire(&CxPlatSimClock.Lock);
+    if (Worker->SimIdle) {
+        Worker->SimIdle = FALSE;
+        CxPlatSimClock.IdleCount--;
+    }
+    CxPlatListEntryRemove(&Worker->SimClockEntry);
+    CxPlatSimClock.WorkerCount--;
+    CxPlatSimClockTryAdvance(NULL);
+    CxPlatLockRelease(&CxPlatSimClock.Lock);
+}
+
+//
+// Must be called before queuing any event to wake the worker.
+//
+static
+void
+CxPlatSimClockWake(
+    _In_ CXPLAT_WORKER* Worker
+    )
+{
+    CxPlatLockAcquire(&CxPlatSimClock.Lock);
+    if (Worker->SimIdle) {
+        Worker->SimIdle = FALSE;
+        CxPlatSimClock.IdleCount--;
+    } else {
+        Worker->SimWakePending = TRUE;
+    }
+    CxPlatLockRelease(&CxPlatSimClock.Lock);
+}
+
+//
+// Marks the worker idle until its next deadline. Returns TRUE if the worker
+// should block until woken, or FALSE if it should run again right away.
+//
+static
+BOOLEAN
+CxPlatSimClockWait(
+    _In_ CXPLAT_WORKER* Worker
+    )
+{
+    BOOLEAN Block;
+    CxPlatLockAcquire(&CxPlatSimClock.Lock);
+    if (Worker->SimWakePending) {
+        Worker->SimWakePending = FALSE;
+        Block = FALSE;
+    } else {
+        CXPLAT_DBG_ASSERT(!Worker->SimIdle);
+        Worker->SimIdle = TRUE;
+        Worker->SimDeadlineUs = Worker->NextTimeUs;
+        CxPlatSimClock.IdleCount++;
+        CxPlatSimClockTryAdvance(Worker);
+        Block = Worker->SimIdle;
+    }
+    CxPlatLockRelease(&CxPlatSimClock.Lock);
+    return Block;
+}
+
+static
+void
+CxPlatSimClockResume(
+    _In_ CXPLAT_WORKER* Worker
+    )
+{
+    CxPlatLockAcquire(&CxPlatSimClock.Lock);
+    if (Worker->SimIdle) {
+        Worker->SimIdle = FALSE;
+        CxPlatSimClock.IdleCount--;
+    }
+    CxPlatLockRelease(&CxPlatSimClock.Lock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatSimClockHold(
+    void
+    )
+{
+    CxPlatLockAcquire(&CxPlatSimClock.Lock);
+    CxPlatSimClock.HoldCount++;
+    CxPlatLockRelease(&CxPlatSimClock.Lock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatSimClockRelease(
+    void
+    )
+{
+    CxPlatLockAcquire(&CxPlatSimClock.Lock);
+    CXPLAT_DBG_ASSERT(CxPlatSimClock.HoldCount > 0);
+    if (--CxPlatSimClock.HoldCount == 0) {
+        CxPlatSimClockTryAdvance(NULL);
+    }
+    CxPlatLockRelease(&CxPlatSimClock.Lock);
+}
+
+#endif // CXPLAT_USE_SIM_DATAPATH
+
 static void
 ShutdownCompletion(
     _In_ CXPLAT_CQE* Cqe
@@ -165,7 +409,9 @@ CxPlatWorkerPoolInitWorker(
     _Inout_ CXPLAT_WORKER* Worker,
     _In_ uint16_t IdealProcessor,
     _In_opt_ CXPLAT_EVENTQ* EventQ, // Only for external workers
-    _In_opt_ CXPLAT_THREAD_CONFIG* ThreadConfig // Only for internal workers
+    _In_opt_ CXPLAT_THREAD_CONFIG* ThreadConfig, // Only for internal workers
+    _In_ uint32_t BusyPollUs, // Only for internal workers
+    _In_ uint16_t PollProcessor // Only with busy polling
     )
 {
     CxPlatLockInitialize(&Worker->ECLock);
@@ -178,7 +424,17 @@ CxPlatWorkerPoolInitWorker(
     if (EventQ != NULL) {
         Worker->EventQ = *EventQ;
     } else {
-        if (!CxPlatEventQInitialize(&Worker->EventQ)) {
+#if defined(CX_PLATFORM_LINUX)
+        const BOOLEAN EventQInitialized =
+            BusyPollUs != 0 ?
+                CxPlatEventQInitializeBusyPoll(&Worker->EventQ, PollProcessor, BusyPollUs) :
+                CxPlatEventQInitialize(&Worker->EventQ);
+#else
+        UNREFERENCED_PARAMETER(BusyPollUs);
+        UNREFERENCED_PARAMETER(PollProcessor);
+        const BOOLEAN EventQInitialized = CxPlatEventQInitialize(&Worker->EventQ);
+#endif
+        if (!EventQInitialized) {
             QuicTraceEvent(
                 LibraryError,
                 "[ lib] ERROR, %s.",
@@ -218,8 +474,14 @@ CxPlatWorkerPoolInitWorker(
     if (ThreadConfig != NULL) {
         ThreadConfig->IdealProcessor = IdealProcessor;
         ThreadConfig->Context = Worker;
+#ifdef CXPLAT_USE_SIM_DATAPATH
+        CxPlatSimClockAddWorker(Worker);
+#endif
         if (QUIC_FAILED(
             CxPlatThreadCreate(ThreadConfig, &Worker->Thread))) {
+#ifdef CXPLAT_USE_SIM_DATAPATH
+            CxPlatSimClockRemoveWorker(Worker);
+#endif
             return FALSE;
         }
         Worker->InitializedThread = TRUE;
@@ -235,6 +497,9 @@ CxPlatWorkerPoolDestroyWorker(
 {
     if (Worker->InitializedThread) {
         Worker->StoppingThread = TRUE;
+#ifdef CXPLAT_USE_SIM_DATAPATH
+        CxPlatSimClockWake(Worker);
+#endif
         CxPlatEventQEnqueue(&Worker->EventQ, &Worker->ShutdownSqe);
         CxPlatThreadWait(&Worker->Thread);
         CxPlatThreadDelete(&Worker->Thread);
@@ -263,6 +528,65 @@ CxPlatWorkerPoolDestroyWorker(
     }
 }
 
+#if defined(CX_PLATFORM_LINUX)
+static
+BOOLEAN
+CxPlatProcessorListContains(
+    _In_reads_(ProcessorCount) const uint16_t* ProcessorList,
+    _In_ uint32_t ProcessorCount,
+    _In_ uint32_t Processor
+    )
+{
+    for (uint32_t i = 0; i < ProcessorCount; ++i) {
+        if (ProcessorList[i] == Processor) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+//
+// Picks the processor for a worker's kernel busy poll thread. It must not be
+// the worker's own processor, or the worker and the poller spin against each
+// other. Processors without a worker are used first, spread across the
+// workers. Otherwise, the next processor is used.
+//
+static
+uint16_t
+CxPlatWorkerPoolGetPollProcessor(
+    _In_reads_opt_(ProcessorCount) const uint16_t* ProcessorList,
+    _In_ uint32_t ProcessorCount,
+    _In_ uint32_t WorkerIndex,
+    _In_ uint16_t IdealProcessor
+    )
+{
+    const uint32_t SystemProcessorCount = CxPlatProcCount();
+    if (SystemProcessorCount < 2) {
+        return CXPLAT_POLL_PROCESSOR_ANY;
+    }
+
+    if (ProcessorList != NULL) {
+        uint32_t UnusedCount = 0;
+        for (uint32_t Processor = 0; Processor < SystemProcessorCount; ++Processor) {
+            if (!CxPlatProcessorListContains(ProcessorList, ProcessorCount, Processor)) {
+                ++UnusedCount;
+            }
+        }
+        if (UnusedCount != 0) {
+            uint32_t Unused = WorkerIndex % UnusedCount;
+            for (uint32_t Processor = 0; Processor < SystemProcessorCount; ++Processor) {
+                if (!CxPlatProcessorListContains(ProcessorList, ProcessorCount, Processor) &&
+                    Unused-- == 0) {
+                    return (uint16_t)Processor;
+                }
+            }
+        }
+    }
+
+    return (uint16_t)((IdealProcessor + 1) % SystemProcessorCount);
+}
+#endif
+
 CXPLAT_WORKER_POOL*
 CxPlatWorkerPoolCreate(
     _In_opt_ QUIC_GLOBAL_EXECUTION_CONFIG* Config,
@@ -317,6 +641,11 @@ CxPlatWorkerPoolCreate(
         if (Config->Flags & QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_AFFINITIZE) {
             ThreadFlags |= CXPLAT_THREAD_FLAG_SET_AFFINITIZE;
         }
+        if (Config->Flags & QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_BUSY_POLL) {
+            WorkerPool->BusyPollUs =
+                Config->PollingIdleTimeoutUs != 0 ?
+                    Config->PollingIdleTimeoutUs : CXPLAT_DEFAULT_BUSY_POLL_US;
+        }
     }
 
     CXPLAT_THREAD_CONFIG ThreadConfig = {
@@ -336,9 +665,18 @@ CxPlatWorkerPoolCreate(
         const uint16_t IdealProcessor = ProcessorList ? ProcessorList[i] : (uint16_t)i;
         CXPLAT_DBG_ASSERT(IdealProcessor < CxPlatProcCount());
 
+#if defined(CX_PLATFORM_LINUX)
+        const uint16_t PollProcessor =
+            WorkerPool->BusyPollUs != 0 ?
+                CxPlatWorkerPoolGetPollProcessor(ProcessorList, ProcessorCount, i, IdealProcessor) :
+                0;
+#else
+        const uint16_t PollProcessor = 0;
+#endif
+
         CXPLAT_WORKER* Worker = &WorkerPool->Workers[i];
         if (!CxPlatWorkerPoolInitWorker(
-                Worker, IdealProcessor, NULL, &ThreadConfig)) {
+                Worker, IdealProcessor, NULL, &ThreadConfig, WorkerPool->BusyPollUs, PollProcessor)) {
             goto Error;
         }
     }
@@ -407,7 +745,7 @@ CxPlatWorkerPoolCreateExternal(
 
         CXPLAT_WORKER* Worker = &WorkerPool->Workers[i];
         if (!CxPlatWorkerPoolInitWorker(
-                Worker, IdealProcessor, Configs[i].EventQ, NULL)) {
+                Worker, IdealProcessor, Configs[i].EventQ, NULL, 0, 0)) {
             goto Error;
         }
         Executions[i] = (QUIC_EXECUTION*)Worker;
@@ -475,6 +813,14 @@ CxPlatWorkerPoolGetCount(
     return WorkerPool->WorkerCount;
 }
 
+uint32_t
+CxPlatWorkerPoolGetBusyPollUs(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool
+    )
+{
+    return WorkerPool->BusyPollUs;
+}
+
 BOOLEAN
 CxPlatWorkerPoolAddRef(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
@@ -547,6 +893,9 @@ CxPlatWorkerPoolAddExecutionContext(
     CxPlatLockRelease(&Worker->ECLock);
 
     if (QueueEvent) {
+#ifdef CXPLAT_USE_SIM_DATAPATH
+        CxPlatSimClockWake(Worker);
+#endif
         CxPlatEventQEnqueue(&Worker->EventQ, &Worker->UpdatePollSqe);
     }
 }
@@ -558,6 +907,9 @@ CxPlatWakeExecutionContext(
 {
     CXPLAT_WORKER* Worker = (CXPLAT_WORKER*)Context->CxPlatContext;
     if (!InterlockedFetchAndSetBoolean(&Worker->Running)) {
+#ifdef CXPLAT_USE_SIM_DATAPATH
+        CxPlatSimClockWake(Worker);
+#endif
         CxPlatEventQEnqueue(&Worker->EventQ, &Worker->WakeSqe);
     }
 }
@@ -599,6 +951,9 @@ CxPlatRunExecutionContexts(
 {
     if (Worker->ExecutionContexts == NULL) {
         Worker->State.WaitTime = UINT32_MAX;
+#ifdef CXPLAT_USE_SIM_DATAPATH
+        Worker->NextTimeUs = UINT64_MAX;
+#endif
         return;
     }
 
@@ -631,6 +986,10 @@ CxPlatRunExecutionContexts(
         EC = &Context->Entry.Next;
     } while (*EC != NULL);
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+    Worker->NextTimeUs = NextTime;
+#endif
+
     if (NextTime == 0) {
         Worker->State.WaitTime = 0;
     } else if (NextTime != UINT64_MAX) {
@@ -811,8 +1170,22 @@ CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context)
             CxPlatRunExecutionContexts(Worker); // Run once more to handle race conditions
         }
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+        //
+        // Never block on a real timeout; deadlines are reached by advancing
+        // the virtual clock, which wakes the worker.
+        //
+        if (Worker->State.WaitTime != 0) {
+            Worker->State.WaitTime = CxPlatSimClockWait(Worker) ? UINT32_MAX : 0;
+        }
+#endif
+
         CxPlatProcessEvents(Worker);
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+        CxPlatSimClockResume(Worker);
+#endif
+
         if (Worker->State.NoWorkCount == 0) {
             Worker->State.LastWorkTime = Worker->State.TimeNow;
         } else if (Worker->State.NoWorkCount > CXPLAT_WORKER_IDLE_WORK_THRESHOLD_COUNT) {
@@ -828,6 +1201,10 @@ CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context)
 
     Worker->Running = FALSE;
 
+#ifdef CXPLAT_USE_SIM_DATAPATH
+    CxPlatSimClockRemoveWorker(Worker);
+#endif
+
 #if DEBUG
     Worker->ThreadFinished = TRUE;
 #endif
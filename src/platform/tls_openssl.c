@@ -1215,7 +1215,7 @@ CxPlatTlsClientHelloCallback(
 // @brief Callback invoked when a TLS session ticket is received by the client.
 //
 // This function is called by OpenSSL when the server issues a session
-// ticket to the client. It serializes the session into PEM format and
+// ticket to the client. It serializes the session into DER format and
 // passes the data to the QUIC layer using the registered
 // @c ReceiveTicket callback.
 //
@@ -1237,51 +1237,140 @@ CxPlatTlsOnClientSessionTicketReceived(
 {
     CXPLAT_TLS* TlsContext = SSL_get_app_data(Ssl);
 
-    BIO* Bio = BIO_new(BIO_s_mem());
-    if (Bio) {
-        if (PEM_write_bio_SSL_SESSION(Bio, Session) == 1) {
-            uint8_t* Data = NULL;
-            long Length = BIO_get_mem_data(Bio, &Data);
-            if (Length < UINT16_MAX) {
+    //
+    // The session is passed up DER encoded, which is about 3/4 the size of
+    // PEM and takes no base64 or BIO buffering to write or read back.
+    //
+    int Length = i2d_SSL_SESSION(Session, NULL);
+    if (Length <= 0) {
+        QuicTraceEvent(
+            TlsErrorStatus,
+            "[ tls][%p] ERROR, %u, %s.",
+            TlsContext->Connection,
+            ERR_get_error(),
+            "i2d_SSL_SESSION failed");
+    } else if (Length >= UINT16_MAX) {
+        QuicTraceEvent(
+            TlsError,
+            "[ tls][%p] ERROR, %s.",
+            TlsContext->Connection,
+            "Session data too big");
+    } else {
+        uint8_t* Data = CXPLAT_ALLOC_NONPAGED((uint32_t)Length, QUIC_POOL_TLS_SESSION);
+        if (Data == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Session data",
+                (uint64_t)Length);
+        } else {
+            uint8_t* Cursor = Data;
+            if (i2d_SSL_SESSION(Session, &Cursor) == Length) {
                 QuicTraceLogConnInfo(
                     OpenSslOnRecvTicket,
                     TlsContext->Connection,
                     "Received session ticket, %u bytes",
                     (uint32_t)Length);
+                //
+                // QUIC only allows 0-RTT if the server said it would take any
+                // amount of early data (RFC 9001, section 4.6.1).
+                //
+                const unsigned long Lifetime =
+                    SSL_SESSION_get_ticket_lifetime_hint(Session);
+                CXPLAT_TLS_TICKET_INFO TicketInfo = {
+                    .Lifetime = Lifetime > UINT32_MAX ? UINT32_MAX : (uint32_t)Lifetime,
+                    .EarlyDataAllowed =
+                        SSL_SESSION_get_max_early_data(Session) == 0xFFFFFFFF
+                };
                 TlsContext->SecConfig->Callbacks.ReceiveTicket(
                     TlsContext->Connection,
                     (uint32_t)Length,
-                    Data);
+                    Data,
+                    &TicketInfo);
             } else {
                 QuicTraceEvent(
-                    TlsError,
-                    "[ tls][%p] ERROR, %s.",
+                    TlsErrorStatus,
+                    "[ tls][%p] ERROR, %u, %s.",
+                    TlsContext->Connection,
+                    ERR_get_error(),
+                    "i2d_SSL_SESSION failed");
+            }
+            CXPLAT_FREE(Data, QUIC_POOL_TLS_SESSION);
+        }
+    }
+
+    //
+    // We always return a "fail" response so that the session gets freed again
+    // because we haven't used the reference.
+    // 
+    return 0;
+}
+
+//
+// @brief Decodes a session ticket saved by the client.
+//
+// The session is DER encoded, as passed up by
+// CxPlatTlsOnClientSessionTicketReceived, or PEM if it was saved by an older
+// version.
+//
+// @param[in] TlsContext
+//     The TLS context the session is for, used for logging.
+// @param[in] Length
+//     Length of the encoded session in bytes.
+// @param[in] Buffer
+//     The encoded session.
+//
+// @return The session, which the caller must free, or NULL on failure.
+//
+static
+SSL_SESSION*
+CxPlatTlsDecodeSession(
+    _In_ CXPLAT_TLS* TlsContext,
+    _In_ uint32_t Length,
+    _In_reads_bytes_(Length)
+        const uint8_t* Buffer
+    )
+{
+    static const char PemHeader[] = "-----BEGIN";
+    SSL_SESSION* Session = NULL;
+
+    if (Length >= sizeof(PemHeader) - 1 &&
+        memcmp(Buffer, PemHeader, sizeof(PemHeader) - 1) == 0) {
+        BIO* Bio = BIO_new_mem_buf(Buffer, (int)Length);
+        if (Bio) {
+            Session = PEM_read_bio_SSL_SESSION(Bio, NULL, 0, NULL);
+            if (Session == NULL) {
+                QuicTraceEvent(
+                    TlsErrorStatus,
+                    "[ tls][%p] ERROR, %u, %s.",
                     TlsContext->Connection,
-                    "Session data too big");
+                    ERR_get_error(),
+                    "PEM_read_bio_SSL_SESSION failed");
             }
+            BIO_free(Bio);
         } else {
             QuicTraceEvent(
                 TlsErrorStatus,
                 "[ tls][%p] ERROR, %u, %s.",
                 TlsContext->Connection,
                 ERR_get_error(),
-                "PEM_write_bio_SSL_SESSION failed");
+                "BIO_new_mem_buf failed");
         }
-        BIO_free(Bio);
+
     } else {
-        QuicTraceEvent(
-            TlsErrorStatus,
-            "[ tls][%p] ERROR, %u, %s.",
-            TlsContext->Connection,
-            ERR_get_error(),
-            "BIO_new_mem_buf failed");
+        const unsigned char* Cursor = Buffer;
+        Session = d2i_SSL_SESSION(NULL, &Cursor, (long)Length);
+        if (Session == NULL) {
+            QuicTraceEvent(
+                TlsErrorStatus,
+                "[ tls][%p] ERROR, %u, %s.",
+                TlsContext->Connection,
+                ERR_get_error(),
+                "d2i_SSL_SESSION failed");
+        }
     }
 
-    //
-    // We always return a "fail" response so that the session gets freed again
-    // because we haven't used the reference.
-    // 
-    return 0;
+    return Session;
 }
 
 //
@@ -1514,7 +1603,8 @@ CxPlatTlsOnServerSessionTicketDecrypted(
         if (!TlsContext->SecConfig->Callbacks.ReceiveTicket(
                 TlsContext->Connection,
                 (uint32_t)Length,
-                Buffer)) {
+                Buffer,
+                NULL)) {
             QuicTraceEvent(
                 TlsError,
                 "[ tls][%p] ERROR, %s.",
@@ -2626,38 +2716,21 @@ CxPlatTlsInitialize(
                 TlsContext->Connection,
                 "Setting session ticket, %u bytes",
                 Config->ResumptionTicketLength);
-            BIO* Bio =
-                BIO_new_mem_buf(
-                    Config->ResumptionTicketBuffer,
-                    (int)Config->ResumptionTicketLength);
-            if (Bio) {
-                SSL_SESSION* Session = PEM_read_bio_SSL_SESSION(Bio, NULL, 0, NULL);
-                if (Session) {
-                    if (!SSL_set_session(TlsContext->Ssl, Session)) {
-                        QuicTraceEvent(
-                            TlsErrorStatus,
-                            "[ tls][%p] ERROR, %u, %s.",
-                            TlsContext->Connection,
-                            ERR_get_error(),
-                            "SSL_set_session failed");
-                    }
-                    SSL_SESSION_free(Session);
-                } else {
+            SSL_SESSION* Session =
+                CxPlatTlsDecodeSession(
+                    TlsContext,
+                    Config->ResumptionTicketLength,
+                    Config->ResumptionTicketBuffer);
+            if (Session) {
+                if (!SSL_set_session(TlsContext->Ssl, Session)) {
                     QuicTraceEvent(
                         TlsErrorStatus,
                         "[ tls][%p] ERROR, %u, %s.",
                         TlsContext->Connection,
                         ERR_get_error(),
-                        "PEM_read_bio_SSL_SESSION failed");
+                        "SSL_set_session failed");
                 }
-                BIO_free(Bio);
-            } else {
-                QuicTraceEvent(
-                    TlsErrorStatus,
-                    "[ tls][%p] ERROR, %u, %s.",
-                    TlsContext->Connection,
-                    ERR_get_error(),
-                    "BIO_new_mem_buf failed");
+                SSL_SESSION_free(Session);
             }
         }
 
@@ -2857,6 +2857,7 @@ CxPlatTlsProcessData(
         (void)TlsContext->SecConfig->Callbacks.ReceiveTicket(
             TlsContext->Connection,
             0,
+            NULL,
             NULL);
     }
 
@@ -0,0 +1,336 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC Simulated Datapath Unit test
+
+    Sends bursts of datagrams over the simulated network and checks the
+    (virtual) arrival time and fate of each one against the configured link.
+
+--*/
+
+#include "main.h"
+#include "quic_datapath.h"
+
+#include "msquic.h"
+#include <vector>
+
+#ifdef QUIC_CLOG
+#include "DataPathSimTest.cpp.clog.h"
+#endif
+
+//
+// 1472 byte payloads are exactly 1500 bytes (12000 bits) on the wire over
+// IPv4, so they take 1 ms at 12 Mbps.
+//
+#define SIM_TEST_PAYLOAD_LENGTH 1472
+#define SIM_TEST_BITS_PER_SECOND (12 * 1000 * 1000)
+#define SIM_TEST_TRANSMIT_TIME_US 1000
+
+struct SimArrival {
+    uint32_t Index;
+    uint64_t TimeUs; // Relative to the send
+    uint8_t Ecn;
+    bool operator==(const SimArrival& Other) const {
+        return Index == Other.Index && TimeUs == Other.TimeUs && Ecn == Other.Ecn;
+    }
+};
+
+struct DataPathSimTest : public ::testing::Test
+{
+    CXPLAT_WORKER_POOL* WorkerPool {nullptr};
+    CXPLAT_DATAPATH* Datapath {nullptr};
+    CXPLAT_SOCKET* Server {nullptr};
+    CXPLAT_SOCKET* Client {nullptr};
+    CXPLAT_ROUTE Route;
+    CXPLAT_LOCK Lock;
+    std::vector<SimArrival> Arrivals;
+    uint64_t SendTimeUs {0};
+    CXPLAT_SIM_NETWORK_STATISTICS BaseStats;
+
+    static void
+    RecvCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* Context,
+        _In_ CXPLAT_RECV_DATA* RecvDataChain
+        )
+    {
+        auto Test = (DataPathSimTest*)Context;
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        CxPlatLockAcquire(&Test->Lock);
+        for (auto RecvData = RecvDataChain; RecvData != nullptr; RecvData = RecvData->Next) {
+            SimArrival Arrival;
+            CxPlatCopyMemory(&Arrival.Index, RecvData->Buffer, sizeof(Arrival.Index));
+            Arrival.TimeUs = TimeNow - Test->SendTimeUs;
+            Arrival.Ecn = CXPLAT_ECN_FROM_TOS(RecvData->TypeOfService);
+            Test->Arrivals.push_back(Arrival);
+        }
+        CxPlatLockRelease(&Test->Lock);
+        CxPlatRecvDataReturn(RecvDataChain);
+    }
+
+    static void
+    UnreachableCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* /* Context */,
+        _In_ const QUIC_ADDR* /* RemoteAddress */
+        )
+    {
+    }
+
+    void SetUp() override {
+        CxPlatLockInitialize(&Lock);
+        const CXPLAT_UDP_DATAPATH_CALLBACKS Callbacks = {
+            RecvCallback,
+            UnreachableCallback,
+        };
+        WorkerPool = CxPlatWorkerPoolCreate(nullptr, CXPLAT_WORKER_POOL_REF_TOOL);
+        ASSERT_NE(nullptr, WorkerPool);
+        CXPLAT_DATAPATH_INIT_CONFIG InitConfig = {0};
+        VERIFY_QUIC_SUCCESS(
+            CxPlatDataPathInitialize(
+                0, &Callbacks, nullptr, WorkerPool, &InitConfig, &Datapath));
+    }
+
+    void TearDown() override {
+        if (Client) {
+            CxPlatSocketDelete(Client);
+        }
+        if (Server) {
+            CxPlatSocketDelete(Server);
+        }
+        if (Datapath) {
+            CxPlatDataPathUninitialize(Datapath);
+        }
+        if (WorkerPool) {
+            CxPlatWorkerPoolDelete(WorkerPool, CXPLAT_WORKER_POOL_REF_TOOL);
+        }
+        CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+        CxPlatSimNetworkConfigure(&Config);
+        CxPlatLockUninitialize(&Lock);
+    }
+
+    //
+    // Configures the network, and creates a fresh pair of sockets, so no
+    // state carries over from a previous run.
+    //
+    void Start(const CXPLAT_SIM_NETWORK_CONFIG& Config) {
+        VERIFY_QUIC_SUCCESS(CxPlatSimNetworkConfigure(&Config));
+        if (Client) {
+            CxPlatSocketDelete(Client);
+            Client = nullptr;
+        }
+        if (Server) {
+            CxPlatSocketDelete(Server);
+            Server = nullptr;
+        }
+        Arrivals.clear();
+
+        QUIC_ADDR ServerAddress = {0};
+        QuicAddrSetFamily(&ServerAddress, QUIC_ADDRESS_FAMILY_INET);
+        QuicAddrSetToLoopback(&ServerAddress);
+        CXPLAT_UDP_CONFIG UdpConfig = {0};
+        UdpConfig.LocalAddress = &ServerAddress;
+        UdpConfig.CallbackContext = this;
+        VERIFY_QUIC_SUCCESS(CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server));
+        CxPlatSocketGetLocalAddress(Server, &ServerAddress);
+        ASSERT_NE(0, QuicAddrGetPort(&ServerAddress));
+
+        UdpConfig.LocalAddress = nullptr;
+        UdpConfig.RemoteAddress = &ServerAddress;
+        VERIFY_QUIC_SUCCESS(CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Client));
+        CxPlatZeroMemory(&Route, sizeof(Route));
+        CxPlatSocketGetLocalAddress(Client, &Route.LocalAddress);
+        CxPlatSocketGetRemoteAddress(Client, &Route.RemoteAddress);
+
+        CxPlatSimNetworkGetStatistics(&BaseStats);
+    }
+
+    //
+    // Sends Count datagrams, all at the same virtual time, and waits for them
+    // to be delivered or dropped.
+    //
+    void SendBurst(uint32_t Count, uint16_t Length, CXPLAT_ECN_TYPE Ecn = CXPLAT_ECN_NON_ECT) {
+        CxPlatSimClockHold();
+        SendTimeUs = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < Count; ++i) {
+            CXPLAT_SEND_CONFIG SendConfig = { &Route, 0, (uint8_t)Ecn, 0, CXPLAT_DSCP_CS0 };
+            CXPLAT_SEND_DATA* SendData = CxPlatSendDataAlloc(Client, &SendConfig);
+            ASSERT_NE(nullptr, SendData);
+            QUIC_BUFFER* Buffer = CxPlatSendDataAllocBuffer(SendData, Length);
+            ASSERT_NE(nullptr, Buffer);
+            CxPlatZeroMemory(Buffer->Buffer, Length);
+            CxPlatCopyMemory(Buffer->Buffer, &i, sizeof(i));
+            CxPlatSocketSend(Client, &Route, SendData);
+        }
+        CxPlatSimClockRelease();
+
+        for (uint32_t Waited = 0; Waited < 5000; Waited += 10) {
+            CXPLAT_SIM_NETWORK_STATISTICS Stats;
+            CxPlatSimNetworkGetStatistics(&Stats);
+            if (Stats.PacketsSent - BaseStats.PacketsSent == Count &&
+                Stats.PacketsDelivered + Stats.PacketsLost + Stats.PacketsQueueDropped -
+                    (BaseStats.PacketsDelivered + BaseStats.PacketsLost + BaseStats.PacketsQueueDropped) == Count) {
+                break;
+            }
+            CxPlatSleep(10);
+        }
+    }
+
+    CXPLAT_SIM_NETWORK_STATISTICS GetStats() {
+        CXPLAT_SIM_NETWORK_STATISTICS Stats;
+        CxPlatSimNetworkGetStatistics(&Stats);
+        Stats.PacketsSent -= BaseStats.PacketsSent;
+        Stats.PacketsDelivered -= BaseStats.PacketsDelivered;
+        Stats.PacketsLost -= BaseStats.PacketsLost;
+        Stats.PacketsQueueDropped -= BaseStats.PacketsQueueDropped;
+        Stats.PacketsUnreachable -= BaseStats.PacketsUnreachable;
+        Stats.PacketsReordered -= BaseStats.PacketsReordered;
+        Stats.PacketsEcnMarked -= BaseStats.PacketsEcnMarked;
+        return Stats;
+    }
+
+    std::vector<SimArrival> GetArrivals() {
+        CxPlatLockAcquire(&Lock);
+        auto Copy = Arrivals;
+        CxPlatLockRelease(&Lock);
+        return Copy;
+    }
+};
+
+TEST_F(DataPathSimTest, ConfigureInvalid)
+{
+    CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+    Config.QueueDepth = CXPLAT_SIM_MAX_QUEUE_DEPTH + 1;
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER, CxPlatSimNetworkConfigure(&Config));
+    Config.QueueDepth = 0;
+    Config.EcnMarkThreshold = CXPLAT_SIM_MAX_QUEUE_DEPTH + 1;
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER, CxPlatSimNetworkConfigure(&Config));
+}
+
+TEST_F(DataPathSimTest, PropagationDelay)
+{
+    CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+    Config.DelayUs = 25000;
+    Start(Config);
+    SendBurst(3, 100);
+
+    auto Arrivals = GetArrivals();
+    ASSERT_EQ(3u, Arrivals.size());
+    for (uint32_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(i, Arrivals[i].Index);
+        ASSERT_EQ(25000u, Arrivals[i].TimeUs);
+    }
+}
+
+TEST_F(DataPathSimTest, Serialization)
+{
+    CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+    Config.BottleneckBitsPerSecond = SIM_TEST_BITS_PER_SECOND;
+    Config.DelayUs = 5000;
+    Start(Config);
+    SendBurst(10, SIM_TEST_PAYLOAD_LENGTH);
+
+    auto Arrivals = GetArrivals();
+    ASSERT_EQ(10u, Arrivals.size());
+    for (uint32_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, Arrivals[i].Index);
+        ASSERT_EQ(5000u + (i + 1) * SIM_TEST_TRANSMIT_TIME_US, Arrivals[i].TimeUs);
+    }
+}
+
+TEST_F(DataPathSimTest, QueueDrop)
+{
+    CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+    Config.BottleneckBitsPerSecond = SIM_TEST_BITS_PER_SECOND;
+    Config.QueueDepth = 4;
+    Start(Config);
+    SendBurst(10, SIM_TEST_PAYLOAD_LENGTH);
+
+    auto Arrivals = GetArrivals();
+    ASSERT_EQ(4u, Arrivals.size());
+    auto Stats = GetStats();
+    ASSERT_EQ(10u, Stats.PacketsSent);
+    ASSERT_EQ(4u, Stats.PacketsDelivered);
+    ASSERT_EQ(6u, Stats.PacketsQueueDropped);
+}
+
+TEST_F(DataPathSimTest, EcnMarking)
+{
+    CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+    Config.BottleneckBitsPerSecond = SIM_TEST_BITS_PER_SECOND;
+    Config.EcnMarkThreshold = 2;
+    Start(Config);
+    SendBurst(5, SIM_TEST_PAYLOAD_LENGTH, CXPLAT_ECN_ECT_0);
+
+    auto Arrivals = GetArrivals();
+    ASSERT_EQ(5u, Arrivals.size());
+    for (uint32_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(i < 2 ? CXPLAT_ECN_ECT_0 : CXPLAT_ECN_CE, Arrivals[i].Ecn);
+    }
+    ASSERT_EQ(3u, GetStats().PacketsEcnMarked);
+
+    //
+    // Not-ECT traffic is never marked.
+    //
+    Start(Config);
+    SendBurst(5, SIM_TEST_PAYLOAD_LENGTH);
+    for (auto& Arrival : GetArrivals()) {
+        ASSERT_EQ(CXPLAT_ECN_NON_ECT, Arrival.Ecn);
+    }
+}
+
+TEST_F(DataPathSimTest, RandomLoss)
+{
+    CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+    Config.RandomLossDenominator = 4;
+    Config.RandomSeed = 1;
+    Start(Config);
+    SendBurst(400, 100);
+
+    auto Stats = GetStats();
+    ASSERT_EQ(400u, Stats.PacketsSent);
+    ASSERT_EQ(400u, Stats.PacketsDelivered + Stats.PacketsLost);
+    ASSERT_EQ(Stats.PacketsDelivered, (uint64_t)GetArrivals().size());
+    ASSERT_GT(Stats.PacketsLost, 50u);
+    ASSERT_LT(Stats.PacketsLost, 150u);
+}
+
+TEST_F(DataPathSimTest, Deterministic)
+{
+    CXPLAT_SIM_NETWORK_CONFIG Config = {0};
+    Config.BottleneckBitsPerSecond = SIM_TEST_BITS_PER_SECOND;
+    Config.DelayUs = 10000;
+    Config.JitterUs = 2000;
+    Config.RandomLossDenominator = 10;
+    Config.RandomReorderDenominator = 5;
+    Config.ReorderDelayDeltaUs = 3000;
+    Config.RandomSeed = 0x1234;
+
+    Start(Config);
+    SendBurst(100, SIM_TEST_PAYLOAD_LENGTH);
+    auto First = GetArrivals();
+    ASSERT_GT(GetStats().PacketsReordered, 0u);
+
+    bool Reordered = false;
+    for (size_t i = 1; i < First.size(); ++i) {
+        if (First[i].Index < First[i - 1].Index) {
+            Reordered = true;
+        }
+        ASSERT_GE(First[i].TimeUs, First[i - 1].TimeUs);
+    }
+    ASSERT_TRUE(Reordered);
+
+    Start(Config);
+    SendBurst(100, SIM_TEST_PAYLOAD_LENGTH);
+    auto Second = GetArrivals();
+    ASSERT_TRUE(First == Second);
+
+    Config.RandomSeed++;
+    Start(Config);
+    SendBurst(100, SIM_TEST_PAYLOAD_LENGTH);
+    ASSERT_FALSE(First == GetArrivals());
+}
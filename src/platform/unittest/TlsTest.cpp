@@ -586,9 +586,11 @@ protected:
         OnSessionTicketReceived(
             _In_ QUIC_CONNECTION* Connection,
             _In_ uint32_t TicketLength,
-            _In_reads_(TicketLength) const uint8_t* Ticket
+            _In_reads_(TicketLength) const uint8_t* Ticket,
+            _In_opt_ const CXPLAT_TLS_TICKET_INFO* TicketInfo
             )
         {
+            UNREFERENCED_PARAMETER(TicketInfo);
             //std::cout << "==RecvTicket==" << std::endl;
             auto Context = (TlsContext*)Connection;
             if (Context->ReceivedSessionTicket.Buffer == nullptr) {
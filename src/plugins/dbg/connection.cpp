@@ -118,32 +118,43 @@ EXT_COMMAND(
         Conn.HasQueuedWork() ? "TRUE" : "FALSE",
         Conn.HasPriorityWork() ? "TRUE" : "FALSE");
 
-    auto Operations = Conn.GetOperQueue().GetOperations();
-    if (Operations.IsEmpty()) {
+    auto OperQ = Conn.GetOperQueue();
+    auto PriorityOperations = OperQ.GetPriorityOperations();
+    auto Operations = OperQ.GetOperations();
+    ULONG64 PendingLinkAddr = OperQ.GetPendingHead();
+    if (PriorityOperations.IsEmpty() && Operations.IsEmpty() && PendingLinkAddr == 0) {
         Dml("\t\tNo Operations Queued\n");
     } else {
-        bool IsHighPriority = true;
-        bool IsFirstOperation = true;
-        UINT64 PriorityTail;
-        ReadPointerAtAddr(Conn.GetOperQueue().GetPriorityTail(), &PriorityTail);
-        while (!CheckControlC()) {
-            auto OperLinkAddr = Operations.Next();
-            if (OperLinkAddr == 0) {
-                break;
+        if (!PriorityOperations.IsEmpty()) {
+            Dml("\n\tHIGH PRIORITY:\n\n");
+            while (!CheckControlC()) {
+                auto OperLinkAddr = PriorityOperations.Next();
+                if (OperLinkAddr == 0) {
+                    break;
+                }
+                Dml("\t\t%s\n", Operation::FromLink(OperLinkAddr).TypeStr());
             }
+        }
 
-            if (PriorityTail == OperLinkAddr) {
-                IsHighPriority = false;
-                Dml("\n\tNORMAL PRIORITY:\n\n");
+        if (!Operations.IsEmpty()) {
+            Dml("\n\tNORMAL PRIORITY:\n\n");
+            while (!CheckControlC()) {
+                auto OperLinkAddr = Operations.Next();
+                if (OperLinkAddr == 0) {
+                    break;
+                }
+                Dml("\t\t%s\n", Operation::FromLink(OperLinkAddr).TypeStr());
             }
+        }
 
-            if (IsFirstOperation && IsHighPriority) {
-                Dml("\n\tHIGH PRIORITY:\n\n");
+        if (PendingLinkAddr != 0) {
+            Dml("\n\tNORMAL PRIORITY (PENDING, NEWEST FIRST):\n\n");
+            while (PendingLinkAddr != 0 && !CheckControlC()) {
+                Dml("\t\t%s\n", Operation::FromLink(PendingLinkAddr).TypeStr());
+                if (!ReadPointerAtAddr(PendingLinkAddr, &PendingLinkAddr)) {
+                    break;
+                }
             }
-
-            auto Operation = Operation::FromLink(OperLinkAddr);
-            Dml("\t\t%s\n", Operation.TypeStr());
-            IsFirstOperation = false;
         }
     }
 
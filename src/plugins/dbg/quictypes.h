@@ -192,12 +192,6 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN TestTransportParameterSet : 1;
 
-        //
-        // Indicates the connection is using the round robin stream scheduling
-        // scheme.
-        //
-        BOOLEAN UseRoundRobinStreamScheduling : 1;
-
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -415,6 +409,105 @@ struct HashTable : Struct {
 
 // End of magic
 
+struct LookupTable : Struct {
+
+    ULONG64 Heads;
+    ULONG BucketCount;
+    ULONG Bucket;
+    ULONG64 Entry;
+
+    //
+    // Open addressing tables have groups of slots instead of chains.
+    //
+    bool OpenAddressing;
+    ULONG GroupSize;
+    ULONG ControlOffset;
+    ULONG SlotsOffset;
+
+    LookupTable(ULONG64 addr) : Struct("msquic!QUIC_LOOKUP_TABLE", addr) {
+        OpenAddressing = ReadType<UCHAR>("OpenAddressing") != 0;
+        ULONG64 Buckets = ReadPointer("Buckets"); // Or Groups
+        ULONG HeadsOffset = 0;
+        ULONG Mask = 0;
+        if (OpenAddressing) {
+            GetFieldOffset("msquic!QUIC_LOOKUP_GROUPS", "Groups", &HeadsOffset);
+            GetFieldOffset("msquic!QUIC_LOOKUP_GROUP", "Control", &ControlOffset);
+            GetFieldOffset("msquic!QUIC_LOOKUP_GROUP", "Slots", &SlotsOffset);
+            GroupSize = GetTypeSize("msquic!QUIC_LOOKUP_GROUP");
+        } else {
+            GetFieldOffset("msquic!QUIC_LOOKUP_BUCKETS", "Heads", &HeadsOffset);
+            GroupSize = ControlOffset = SlotsOffset = 0;
+        }
+        Heads = Buckets + HeadsOffset;
+        BucketCount =
+            (Buckets != 0 &&
+             ReadTypeAtAddr(Buckets, &Mask)) ? Mask + 1 : 0;
+        if (OpenAddressing) {
+            BucketCount *= 8; // Walked slot by slot.
+        }
+        Bucket = 0;
+        Entry = 0;
+    }
+
+    ULONG NumEntries() {
+        return ReadType<ULONG>("NumEntries");
+    }
+
+    bool GetNextSlot(ULONG64* EntryAddress) {
+        while (Bucket < BucketCount) {
+            ULONG64 Group = Heads + (Bucket / 8) * GroupSize;
+            ULONG Slot = Bucket % 8;
+            UINT64 Control = 0;
+            Bucket++;
+            if (!ReadTypeAtAddr(Group + ControlOffset, &Control)) {
+                return false;
+            }
+            if (((Control >> (8 * Slot)) & 0x80) != 0) {
+                continue; // Empty or deleted.
+            }
+            if (!ReadPointerAtAddr(
+                    Group + SlotsOffset + Slot * g_ExtInstance.m_PtrSize,
+                    EntryAddress)) {
+                dprintf("Failed to read slot %08lx\n", Bucket - 1);
+                return false;
+            }
+            if (*EntryAddress != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GetNextEntry(ULONG64* EntryAddress) {
+        if (OpenAddressing) {
+            return GetNextSlot(EntryAddress);
+        }
+        while (Entry == 0) {
+            if (Bucket == BucketCount) {
+                return false;
+            }
+            if (!ReadPointerAtAddr(
+                    Heads + Bucket * g_ExtInstance.m_PtrSize,
+                    &Entry)) {
+                dprintf("Failed to read bucket %08lx\n", Bucket);
+                return false;
+            }
+            Bucket++;
+        }
+
+        *EntryAddress = Entry;
+        if (!ReadPointerFromStructAddr(
+                Entry,
+                "msquic!QUIC_LOOKUP_LINK",
+                "Next",
+                &Entry)) {
+            dprintf("Failed to walk bucket %08lx\n", Bucket - 1);
+            return false;
+        }
+        return true;
+    }
+};
+
 inline char QuicHalfByteToStr(UCHAR b)
 {
     return b < 10 ? ('0' + b) : ('A' + b - 10);
@@ -1155,12 +1248,20 @@ struct OperQueue : Struct {
 
     OperQueue(ULONG64 Addr) : Struct("msquic!QUIC_OPERATION_QUEUE", Addr) { }
 
+    LinkedList GetPriorityOperations() {
+        return LinkedList(AddrOf("PriorityList"));
+    }
+
     LinkedList GetOperations() {
         return LinkedList(AddrOf("List"));
     }
 
-    ULONG64 GetPriorityTail() {
-        return ReadPointer("PriorityTail");
+    //
+    // Most recently pushed operation not yet moved to the list, linked through
+    // Flink and terminated by NULL.
+    //
+    ULONG64 GetPendingHead() {
+        return ReadPointer("PendingHead");
     }
 };
 
@@ -377,8 +377,12 @@ pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_FIFO:
     QUIC_STREAM_SCHEDULING_SCHEME = 0;
 pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN:
     QUIC_STREAM_SCHEDULING_SCHEME = 1;
-pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_COUNT:
+pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR:
     QUIC_STREAM_SCHEDULING_SCHEME = 2;
+pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY:
+    QUIC_STREAM_SCHEDULING_SCHEME = 3;
+pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_COUNT:
+    QUIC_STREAM_SCHEDULING_SCHEME = 4;
 pub type QUIC_STREAM_SCHEDULING_SCHEME = ::std::os::raw::c_int;
 pub const QUIC_STREAM_OPEN_FLAGS_QUIC_STREAM_OPEN_FLAG_NONE: QUIC_STREAM_OPEN_FLAGS = 0;
 pub const QUIC_STREAM_OPEN_FLAGS_QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL: QUIC_STREAM_OPEN_FLAGS = 1;
@@ -443,6 +447,8 @@ pub const QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS_QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_H
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = 16;
 pub const QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS_QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_AFFINITIZE:
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = 32;
+pub const QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS_QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_BUSY_POLL:
+    QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = 64;
 pub type QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = ::std::os::raw::c_int;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -801,8 +807,12 @@ pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_CU
     QUIC_CONGESTION_CONTROL_ALGORITHM = 0;
 pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_BBR:
     QUIC_CONGESTION_CONTROL_ALGORITHM = 1;
-pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_MAX:
+pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_DCTCP:
     QUIC_CONGESTION_CONTROL_ALGORITHM = 2;
+pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3:
+    QUIC_CONGESTION_CONTROL_ALGORITHM = 3;
+pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_MAX:
+    QUIC_CONGESTION_CONTROL_ALGORITHM = 4;
 pub type QUIC_CONGESTION_CONTROL_ALGORITHM = ::std::os::raw::c_int;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -1715,7 +1725,22 @@ pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_ENCRYPT_DURATION_US:
     QUIC_PERFORMANCE_COUNTERS = 33;
 pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DECRYPT_DURATION_US:
     QUIC_PERFORMANCE_COUNTERS = 34;
-pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 35;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CC_CACHE_HIT: QUIC_PERFORMANCE_COUNTERS = 35;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CC_CACHE_MISS: QUIC_PERFORMANCE_COUNTERS =
+    36;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_ACK_FRAMES_SENT: QUIC_PERFORMANCE_COUNTERS =
+    37;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_ACK_FRAMES_RECV: QUIC_PERFORMANCE_COUNTERS =
+    38;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_REBALANCED: QUIC_PERFORMANCE_COUNTERS =
+    39;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_TICKET_CACHE_HIT: QUIC_PERFORMANCE_COUNTERS =
+    40;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_TICKET_CACHE_MISS:
+    QUIC_PERFORMANCE_COUNTERS = 41;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_TICKET_CACHE_EVICT:
+    QUIC_PERFORMANCE_COUNTERS = 42;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 43;
 pub type QUIC_PERFORMANCE_COUNTERS = ::std::os::raw::c_int;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -164,7 +164,9 @@ pub const SEND_RESUMPTION_FLAG_FINAL: SendResumptionFlags = 1;
 pub type StreamSchedulingScheme = u32;
 pub const STREAM_SCHEDULING_SCHEME_FIFO: StreamSchedulingScheme = 0;
 pub const STREAM_SCHEDULING_SCHEME_ROUND_ROBIN: StreamSchedulingScheme = 1;
-pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY: StreamSchedulingScheme = 3;
+pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 4;
 
 /// Key information for TLS session ticket encryption.
 #[repr(C)]
@@ -262,6 +264,22 @@ pub struct QuicPerformanceCounters {
     pub encrypt_duration_us: i64,
     #[cfg(feature = "preview-api")]
     pub decrypt_duration_us: i64,
+    #[cfg(feature = "preview-api")]
+    pub cc_cache_hit: i64,
+    #[cfg(feature = "preview-api")]
+    pub cc_cache_miss: i64,
+    #[cfg(feature = "preview-api")]
+    pub ack_frames_sent: i64,
+    #[cfg(feature = "preview-api")]
+    pub ack_frames_recv: i64,
+    #[cfg(feature = "preview-api")]
+    pub conn_rebalanced: i64,
+    #[cfg(feature = "preview-api")]
+    pub ticket_cache_hit: i64,
+    #[cfg(feature = "preview-api")]
+    pub ticket_cache_miss: i64,
+    #[cfg(feature = "preview-api")]
+    pub ticket_cache_evict: i64,
 }
 
 pub const QUIC_TLS_SECRETS_MAX_SECRET_LEN: usize = 64;
@@ -540,6 +558,30 @@ impl From<QuicPerformanceCountersParam> for QuicPerformanceCounters {
             decrypt_duration_us: value
                 [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DECRYPT_DURATION_US
                     as usize],
+            #[cfg(feature = "preview-api")]
+            cc_cache_hit: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CC_CACHE_HIT as usize],
+            #[cfg(feature = "preview-api")]
+            cc_cache_miss: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CC_CACHE_MISS as usize],
+            #[cfg(feature = "preview-api")]
+            ack_frames_sent: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_ACK_FRAMES_SENT as usize],
+            #[cfg(feature = "preview-api")]
+            ack_frames_recv: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_ACK_FRAMES_RECV as usize],
+            #[cfg(feature = "preview-api")]
+            conn_rebalanced: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_REBALANCED as usize],
+            #[cfg(feature = "preview-api")]
+            ticket_cache_hit: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_TICKET_CACHE_HIT as usize],
+            #[cfg(feature = "preview-api")]
+            ticket_cache_miss: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_TICKET_CACHE_MISS as usize],
+            #[cfg(feature = "preview-api")]
+            ticket_cache_evict: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_TICKET_CACHE_EVICT as usize],
         }
     }
 }
@@ -320,6 +320,30 @@ QuicTraceGlobalEvent(
             case QUIC_PERF_COUNTER_DECRYPT_DURATION_US:
                 printf("    Total decryption duration (us):                     ");
                 break;
+            case QUIC_PERF_COUNTER_CC_CACHE_HIT:
+                printf("    Total congestion state cache hits:                  ");
+                break;
+            case QUIC_PERF_COUNTER_CC_CACHE_MISS:
+                printf("    Total congestion state cache misses:                ");
+                break;
+            case QUIC_PERF_COUNTER_ACK_FRAMES_SENT:
+                printf("    Total ACK frames sent:                              ");
+                break;
+            case QUIC_PERF_COUNTER_ACK_FRAMES_RECV:
+                printf("    Total ACK frames received:                          ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_REBALANCED:
+                printf("    Total connections moved to a less loaded worker:    ");
+                break;
+            case QUIC_PERF_COUNTER_TICKET_CACHE_HIT:
+                printf("    Total resumption ticket cache hits:                 ");
+                break;
+            case QUIC_PERF_COUNTER_TICKET_CACHE_MISS:
+                printf("    Total resumption ticket cache misses:               ");
+                break;
+            case QUIC_PERF_COUNTER_TICKET_CACHE_EVICT:
+                printf("    Total resumption tickets evicted unused:            ");
+                break;
             default:
                 printf("    Unknown:                                            ");
                 break;